@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include <doca_log.h>
+
+#include "bench_common.h"
+
+DOCA_LOG_REGISTER(BENCH::COMMON);
+
+#define SYSFS_PATH_LEN (256) /* Maximum length of a sysfs path */
+#define SYSFS_LINE_LEN (4096) /* Maximum length of a sysfs line */
+
+uint64_t bench_get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * BENCH_NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+doca_error_t bench_pin_thread_to_cpu(uint32_t cpu)
+{
+	cpu_set_t cpuset;
+	int ret;
+
+	if (cpu >= CPU_SETSIZE) {
+		DOCA_LOG_ERR("CPU index %u exceeds the maximum of %d", cpu, CPU_SETSIZE - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	CPU_ZERO(&cpuset);
+	CPU_SET(cpu, &cpuset);
+	ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+	if (ret != 0) {
+		DOCA_LOG_ERR("Failed to pin thread to CPU %u: %s", cpu, strerror(ret));
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Read the first line of a sysfs file
+ *
+ * @path [in]: file path
+ * @line [out]: buffer to read the line into
+ * @line_len [in]: buffer length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t read_sysfs_line(const char *path, char *line, size_t line_len)
+{
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (fp == NULL)
+		return DOCA_ERROR_NOT_FOUND;
+
+	if (fgets(line, line_len, fp) == NULL) {
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	fclose(fp);
+
+	line[strcspn(line, "\n")] = '\0';
+	return DOCA_SUCCESS;
+}
+
+uint64_t bench_get_cpu_max_khz(uint32_t cpu)
+{
+	char path[SYSFS_PATH_LEN];
+	char line[SYSFS_LINE_LEN];
+
+	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq", cpu);
+	if (read_sysfs_line(path, line, sizeof(line)) != DOCA_SUCCESS)
+		return 0;
+
+	return strtoull(line, NULL, 10);
+}
+
+int bench_get_ibdev_numa_node(const char *ibdev_name)
+{
+	char path[SYSFS_PATH_LEN];
+	char line[SYSFS_LINE_LEN];
+
+	if (ibdev_name == NULL || ibdev_name[0] == '\0')
+		return -1;
+
+	snprintf(path, sizeof(path), "/sys/class/infiniband/%s/device/numa_node", ibdev_name);
+	if (read_sysfs_line(path, line, sizeof(line)) != DOCA_SUCCESS)
+		return -1;
+
+	return atoi(line);
+}
+
+doca_error_t bench_parse_cpu_list(const char *cpu_list, uint32_t *cpus, uint32_t max_cpus, uint32_t *num_cpus)
+{
+	const char *pos = cpu_list;
+	char *end;
+	unsigned long first, last, cpu;
+
+	*num_cpus = 0;
+	while (*pos != '\0') {
+		if (!isdigit((unsigned char)*pos)) {
+			DOCA_LOG_ERR("Invalid CPU list \"%s\"", cpu_list);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		first = strtoul(pos, &end, 10);
+		last = first;
+		if (*end == '-') {
+			pos = end + 1;
+			if (!isdigit((unsigned char)*pos)) {
+				DOCA_LOG_ERR("Invalid CPU list \"%s\"", cpu_list);
+				return DOCA_ERROR_INVALID_VALUE;
+			}
+			last = strtoul(pos, &end, 10);
+		}
+		if (last < first) {
+			DOCA_LOG_ERR("Invalid CPU range %lu-%lu", first, last);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		for (cpu = first; cpu <= last; cpu++) {
+			if (*num_cpus == max_cpus) {
+				DOCA_LOG_ERR("CPU list exceeds the maximum of %u CPUs", max_cpus);
+				return DOCA_ERROR_INVALID_VALUE;
+			}
+			cpus[(*num_cpus)++] = (uint32_t)cpu;
+		}
+		if (*end == ',')
+			end++;
+		pos = end;
+	}
+
+	if (*num_cpus == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t bench_get_numa_node_cpus(int numa_node, uint32_t *cpus, uint32_t max_cpus, uint32_t *num_cpus)
+{
+	char path[SYSFS_PATH_LEN];
+	char line[SYSFS_LINE_LEN];
+	long num_online;
+	uint32_t i;
+
+	if (numa_node >= 0) {
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", numa_node);
+		if (read_sysfs_line(path, line, sizeof(line)) == DOCA_SUCCESS &&
+		    bench_parse_cpu_list(line, cpus, max_cpus, num_cpus) == DOCA_SUCCESS)
+			return DOCA_SUCCESS;
+		DOCA_LOG_WARN("Failed to read CPU list of NUMA node %d, using all online CPUs", numa_node);
+	}
+
+	num_online = sysconf(_SC_NPROCESSORS_ONLN);
+	if (num_online <= 0)
+		return DOCA_ERROR_OPERATING_SYSTEM;
+
+	*num_cpus = 0;
+	for (i = 0; i < (uint32_t)num_online && i < max_cpus; i++)
+		cpus[(*num_cpus)++] = i;
+
+	return DOCA_SUCCESS;
+}
+
+void *bench_alloc_numa(size_t len, int numa_node)
+{
+	unsigned long nodemask;
+	void *addr;
+
+	addr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (addr == MAP_FAILED)
+		return NULL;
+
+	/* Best effort, if the policy can't be applied first-touch below places the pages on the local node */
+	if (numa_node >= 0 && numa_node < (int)(8 * sizeof(nodemask))) {
+		nodemask = 1UL << numa_node;
+		if (syscall(SYS_mbind, addr, len, MPOL_PREFERRED, &nodemask, 8 * sizeof(nodemask), 0) != 0)
+			DOCA_LOG_DBG("mbind() to NUMA node %d failed, relying on first-touch placement", numa_node);
+	}
+
+	/* Fault the pages in now so that registration and the timed region do not pay for it */
+	memset(addr, 0, len);
+
+	return addr;
+}
+
+void bench_free_numa(void *addr, size_t len)
+{
+	if (addr != NULL)
+		munmap(addr, len);
+}
+
+doca_error_t bench_get_mem_usage(struct bench_mem_usage *usage)
+{
+	char line[SYSFS_LINE_LEN];
+	unsigned long value;
+	FILE *fp;
+
+	memset(usage, 0, sizeof(*usage));
+
+	fp = fopen("/proc/self/status", "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open /proc/self/status");
+		return DOCA_ERROR_NOT_FOUND;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (sscanf(line, "VmRSS: %lu kB", &value) == 1)
+			usage->rss_kb = value;
+		else if (sscanf(line, "VmPin: %lu kB", &value) == 1)
+			usage->pinned_kb = value;
+	}
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t bench_parse_verify_mode(const char *name, enum bench_verify_mode *mode)
+{
+	if (strcmp(name, "none") == 0)
+		*mode = BENCH_VERIFY_NONE;
+	else if (strcmp(name, "sampled") == 0)
+		*mode = BENCH_VERIFY_SAMPLED;
+	else if (strcmp(name, "full") == 0)
+		*mode = BENCH_VERIFY_FULL;
+	else
+		return DOCA_ERROR_INVALID_VALUE;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Compare one cache line of the destination with the source
+ *
+ * @dst [in]: destination
+ * @src [in]: source
+ * @len [in]: length of both buffers
+ * @line [in]: index of the cache line
+ * @return: DOCA_SUCCESS if the line matches and DOCA_ERROR_UNEXPECTED otherwise
+ */
+static doca_error_t verify_line(const uint8_t *dst, const uint8_t *src, size_t len, size_t line)
+{
+	const size_t offset = line * BENCH_CACHE_LINE_SIZE;
+	const size_t line_len = len - offset < BENCH_CACHE_LINE_SIZE ? len - offset : BENCH_CACHE_LINE_SIZE;
+
+	if (memcmp(dst + offset, src + offset, line_len) != 0) {
+		DOCA_LOG_ERR("Copy is corrupted in the cache line at offset %zu", offset);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t bench_verify_copy(enum bench_verify_mode mode,
+			       uint32_t num_lines,
+			       const void *dst,
+			       const void *src,
+			       size_t len)
+{
+	const size_t total_lines = (len + BENCH_CACHE_LINE_SIZE - 1) / BENCH_CACHE_LINE_SIZE;
+	uint64_t seed;
+	uint32_t i;
+
+	if (mode == BENCH_VERIFY_NONE || len == 0)
+		return DOCA_SUCCESS;
+
+	if (mode == BENCH_VERIFY_FULL || total_lines <= (size_t)num_lines + 2) {
+		if (memcmp(dst, src, len) != 0) {
+			DOCA_LOG_ERR("Copy of %zu bytes is corrupted", len);
+			return DOCA_ERROR_UNEXPECTED;
+		}
+		return DOCA_SUCCESS;
+	}
+
+	/* The edges are where a short or misplaced copy shows first */
+	if (verify_line(dst, src, len, 0) != DOCA_SUCCESS)
+		return DOCA_ERROR_UNEXPECTED;
+	if (verify_line(dst, src, len, total_lines - 1) != DOCA_SUCCESS)
+		return DOCA_ERROR_UNEXPECTED;
+
+	/* xorshift64, seeded per call so that repeated runs check different lines */
+	seed = bench_get_time_ns() | 1;
+	for (i = 0; i < num_lines; i++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		if (verify_line(dst, src, len, seed % total_lines) != DOCA_SUCCESS)
+			return DOCA_ERROR_UNEXPECTED;
+	}
+
+	return DOCA_SUCCESS;
+}
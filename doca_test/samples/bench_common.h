@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_NSEC_PER_SEC (1000000000ULL) /* Nanoseconds in one second */
+#define BENCH_MAX_CPUS (1024)		   /* Maximum number of CPUs handled by the benchmark helpers */
+#define BENCH_CACHE_LINE_SIZE (64)	   /* Granularity of the sampled verification */
+#define BENCH_DEFAULT_VERIFY_LINES (64)	   /* Default number of random lines of the sampled verification */
+
+/* How a benchmark checks the data it copied, always outside of the timed region */
+enum bench_verify_mode {
+	BENCH_VERIFY_NONE,    /* No check */
+	BENCH_VERIFY_SAMPLED, /* Compare a number of random cache lines, plus the first and the last one */
+	BENCH_VERIFY_FULL,    /* Compare every byte */
+};
+
+/*
+ * Get a monotonic timestamp
+ *
+ * @return: current CLOCK_MONOTONIC time in nanoseconds
+ */
+uint64_t bench_get_time_ns(void);
+
+/*
+ * Pin the calling thread to a single CPU
+ *
+ * @cpu [in]: CPU index to pin to
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t bench_pin_thread_to_cpu(uint32_t cpu);
+
+/*
+ * Get the nominal maximum frequency of a CPU, used to express a time as CPU cycles
+ *
+ * @cpu [in]: CPU index
+ * @return: frequency in kHz from cpufreq, or 0 if it is unknown
+ */
+uint64_t bench_get_cpu_max_khz(uint32_t cpu);
+
+/*
+ * Get the NUMA node an IB device is attached to
+ *
+ * @ibdev_name [in]: IB device name, e.g. mlx5_0
+ * @return: NUMA node index, or -1 if it is unknown
+ */
+int bench_get_ibdev_numa_node(const char *ibdev_name);
+
+/*
+ * Get the list of CPUs that belong to a NUMA node
+ * If the node is unknown (negative) all online CPUs are returned
+ *
+ * @numa_node [in]: NUMA node index
+ * @cpus [out]: array to fill with CPU indexes
+ * @max_cpus [in]: capacity of the cpus array
+ * @num_cpus [out]: number of CPUs written to the array
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t bench_get_numa_node_cpus(int numa_node, uint32_t *cpus, uint32_t max_cpus, uint32_t *num_cpus);
+
+/*
+ * Parse a CPU list string such as "0-3,8,10-11"
+ *
+ * @cpu_list [in]: CPU list string
+ * @cpus [out]: array to fill with CPU indexes
+ * @max_cpus [in]: capacity of the cpus array
+ * @num_cpus [out]: number of CPUs written to the array
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t bench_parse_cpu_list(const char *cpu_list, uint32_t *cpus, uint32_t max_cpus, uint32_t *num_cpus);
+
+/*
+ * Allocate page aligned memory that is preferably placed on a given NUMA node
+ * The memory is touched by the calling thread so that it is faulted in before it is registered, which also places
+ * it on the local node under the default first-touch policy when the node preference can not be applied
+ *
+ * @len [in]: allocation length in bytes
+ * @numa_node [in]: preferred NUMA node, or -1 to use the local node of the calling thread
+ * @return: pointer to the allocated memory, or NULL on failure
+ */
+void *bench_alloc_numa(size_t len, int numa_node);
+
+/*
+ * Free memory allocated by bench_alloc_numa()
+ *
+ * @addr [in]: memory address
+ * @len [in]: allocation length in bytes, as passed to bench_alloc_numa()
+ */
+void bench_free_numa(void *addr, size_t len);
+
+/* Memory used by the calling process */
+struct bench_mem_usage {
+	uint64_t rss_kb;    /* Resident set size (VmRSS) */
+	uint64_t pinned_kb; /* Pinned memory (VmPin), 0 when the kernel does not report it */
+};
+
+/*
+ * Get the memory used by the calling process from /proc/self/status
+ *
+ * @usage [out]: memory usage
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t bench_get_mem_usage(struct bench_mem_usage *usage);
+
+/*
+ * Parse a verification mode name
+ *
+ * @name [in]: "none", "sampled" or "full"
+ * @mode [out]: verification mode
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR_INVALID_VALUE if the name is unknown
+ */
+doca_error_t bench_parse_verify_mode(const char *name, enum bench_verify_mode *mode);
+
+/*
+ * Check that a destination holds a copy of a source
+ * The sampled mode reads num_lines + 2 cache lines of each buffer whatever their size, so that multi-GB copies can be
+ * checked at a cost that does not skew the benchmark; the lines are drawn at random on every call
+ *
+ * @mode [in]: verification mode
+ * @num_lines [in]: number of random cache lines to compare in sampled mode
+ * @dst [in]: destination
+ * @src [in]: source
+ * @len [in]: length of both buffers
+ * @return: DOCA_SUCCESS if the checked bytes match and DOCA_ERROR_UNEXPECTED otherwise
+ */
+doca_error_t bench_verify_copy(enum bench_verify_mode mode,
+			       uint32_t num_lines,
+			       const void *dst,
+			       const void *src,
+			       size_t len);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* BENCH_COMMON_H_ */
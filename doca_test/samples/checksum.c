@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <endian.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#endif
+
+#include <doca_log.h>
+
+#include "checksum.h"
+
+DOCA_LOG_REGISTER(CHECKSUM);
+
+#define CRC32C_POLY (0x82F63B78U) /* Reflected Castagnoli polynomial */
+
+#define XXH_PRIME64_1 (0x9E3779B185EBCA87ULL) /* xxHash64 primes */
+#define XXH_PRIME64_2 (0xC2B2AE3D27D4EB4FULL)
+#define XXH_PRIME64_3 (0x165667B19E3779F9ULL)
+#define XXH_PRIME64_4 (0x85EBCA77C2B2AE63ULL)
+#define XXH_PRIME64_5 (0x27D4EB2F165667C5ULL)
+
+#if defined(__aarch64__) && !defined(HWCAP_CRC32)
+#define HWCAP_CRC32 (1 << 7) /* AT_HWCAP bit of the ARMv8 CRC32 instructions */
+#endif
+
+/* CRC32C of a buffer, on the raw (not inverted) register */
+typedef uint32_t (*crc32c_fn)(uint32_t crc, const uint8_t *data, size_t len);
+
+static uint32_t crc32c_table[8][256];			/* Slicing-by-8 tables */
+static crc32c_fn crc32c_selected;			/* Implementation selected for this CPU */
+static const char *crc32c_selected_name;		/* Name of crc32c_selected */
+static pthread_once_t crc32c_once = PTHREAD_ONCE_INIT; /* Guards the table and the selection */
+
+static const char *const algo_names[CHECKSUM_ALGO_NUM] = {"crc32c", "xxh64"};
+
+/*
+ * Read a little endian 64-bit value from unaligned memory
+ *
+ * @data [in]: memory
+ * @return: the value
+ */
+static inline uint64_t read_le64(const uint8_t *data)
+{
+	uint64_t value;
+
+	memcpy(&value, data, sizeof(value));
+	return le64toh(value);
+}
+
+/*
+ * Read a little endian 32-bit value from unaligned memory
+ *
+ * @data [in]: memory
+ * @return: the value
+ */
+static inline uint32_t read_le32(const uint8_t *data)
+{
+	uint32_t value;
+
+	memcpy(&value, data, sizeof(value));
+	return le32toh(value);
+}
+
+/*
+ * CRC32C with the slicing-by-8 tables, 8 bytes per step
+ *
+ * @crc [in]: raw CRC register
+ * @data [in]: data
+ * @len [in]: data length
+ * @return: raw CRC register after data
+ */
+static uint32_t crc32c_table_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	uint32_t high;
+
+	for (; len >= 8; data += 8, len -= 8) {
+		crc ^= read_le32(data);
+		high = read_le32(data + 4);
+		crc = crc32c_table[7][crc & 0xFF] ^ crc32c_table[6][(crc >> 8) & 0xFF] ^
+		      crc32c_table[5][(crc >> 16) & 0xFF] ^ crc32c_table[4][crc >> 24] ^ crc32c_table[3][high & 0xFF] ^
+		      crc32c_table[2][(high >> 8) & 0xFF] ^ crc32c_table[1][(high >> 16) & 0xFF] ^
+		      crc32c_table[0][high >> 24];
+	}
+	while (len-- > 0)
+		crc = crc32c_table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+	return crc;
+}
+
+#if defined(__x86_64__)
+/*
+ * CRC32C with the SSE4.2 crc32 instruction, 8 bytes per instruction
+ *
+ * @crc [in]: raw CRC register
+ * @data [in]: data
+ * @len [in]: data length
+ * @return: raw CRC register after data
+ */
+__attribute__((target("sse4.2"))) static uint32_t
+crc32c_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	uint64_t crc64 = crc;
+	uint64_t value;
+
+	for (; len >= 8; data += 8, len -= 8) {
+		memcpy(&value, data, sizeof(value));
+		crc64 = _mm_crc32_u64(crc64, value);
+	}
+	crc = (uint32_t)crc64;
+	while (len-- > 0)
+		crc = _mm_crc32_u8(crc, *data++);
+
+	return crc;
+}
+
+/*
+ * Check whether the CPU has the CRC32C instructions
+ *
+ * @return: true if crc32c_hw_update() can run
+ */
+static bool crc32c_hw_supported(void)
+{
+	return __builtin_cpu_supports("sse4.2");
+}
+
+#define CRC32C_HW_NAME "sse4.2"
+#elif defined(__aarch64__)
+/*
+ * CRC32C with the ARMv8 crc32c instructions, 8 bytes per instruction
+ *
+ * @crc [in]: raw CRC register
+ * @data [in]: data
+ * @len [in]: data length
+ * @return: raw CRC register after data
+ */
+__attribute__((target("+crc"))) static uint32_t crc32c_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	uint64_t value;
+
+	for (; len >= 8; data += 8, len -= 8) {
+		memcpy(&value, data, sizeof(value));
+		crc = __crc32cd(crc, value);
+	}
+	while (len-- > 0)
+		crc = __crc32cb(crc, *data++);
+
+	return crc;
+}
+
+/*
+ * Check whether the CPU has the CRC32C instructions
+ *
+ * @return: true if crc32c_hw_update() can run
+ */
+static bool crc32c_hw_supported(void)
+{
+	return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+#define CRC32C_HW_NAME "armv8-crc"
+#endif
+
+/*
+ * Build the slicing-by-8 tables and select the CRC32C implementation, runs once
+ */
+static void crc32c_init(void)
+{
+	uint32_t crc, i, j;
+
+	for (i = 0; i < 256; i++) {
+		crc = i;
+		for (j = 0; j < 8; j++)
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+		crc32c_table[0][i] = crc;
+	}
+	for (i = 0; i < 256; i++)
+		for (j = 1; j < 8; j++)
+			crc32c_table[j][i] = (crc32c_table[j - 1][i] >> 8) ^
+					     crc32c_table[0][crc32c_table[j - 1][i] & 0xFF];
+
+	crc32c_selected = crc32c_table_update;
+	crc32c_selected_name = "table";
+#ifdef CRC32C_HW_NAME
+	if (crc32c_hw_supported()) {
+		crc32c_selected = crc32c_hw_update;
+		crc32c_selected_name = CRC32C_HW_NAME;
+	}
+#endif
+}
+
+uint32_t checksum_crc32c(uint32_t crc, const void *data, size_t len)
+{
+	(void)pthread_once(&crc32c_once, crc32c_init);
+	return ~crc32c_selected(~crc, (const uint8_t *)data, len);
+}
+
+const char *checksum_crc32c_impl_name(void)
+{
+	(void)pthread_once(&crc32c_once, crc32c_init);
+	return crc32c_selected_name;
+}
+
+/*
+ * Rotate a 64-bit value left
+ *
+ * @value [in]: value
+ * @bits [in]: rotation, between 1 and 63
+ * @return: rotated value
+ */
+static inline uint64_t rotl64(uint64_t value, unsigned int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+/*
+ * Mix one 64-bit input into an xxHash64 lane
+ *
+ * @acc [in]: lane accumulator
+ * @input [in]: input value
+ * @return: new accumulator
+ */
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input)
+{
+	acc += input * XXH_PRIME64_2;
+	acc = rotl64(acc, 31);
+	return acc * XXH_PRIME64_1;
+}
+
+/*
+ * Merge a lane into the xxHash64 result
+ *
+ * @acc [in]: result
+ * @lane [in]: lane accumulator
+ * @return: new result
+ */
+static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t lane)
+{
+	acc ^= xxh64_round(0, lane);
+	return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+uint64_t checksum_xxh64(const void *data, size_t len, uint64_t seed)
+{
+	const uint8_t *p = (const uint8_t *)data;
+	const uint8_t *end = p + len;
+	uint64_t v1, v2, v3, v4, hash;
+
+	if (len >= 32) {
+		v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+		v2 = seed + XXH_PRIME64_2;
+		v3 = seed;
+		v4 = seed - XXH_PRIME64_1;
+		/* Four independent lanes, the compiler interleaves their multiplications */
+		for (; end - p >= 32; p += 32) {
+			v1 = xxh64_round(v1, read_le64(p));
+			v2 = xxh64_round(v2, read_le64(p + 8));
+			v3 = xxh64_round(v3, read_le64(p + 16));
+			v4 = xxh64_round(v4, read_le64(p + 24));
+		}
+		hash = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+		hash = xxh64_merge_round(hash, v1);
+		hash = xxh64_merge_round(hash, v2);
+		hash = xxh64_merge_round(hash, v3);
+		hash = xxh64_merge_round(hash, v4);
+	} else
+		hash = seed + XXH_PRIME64_5;
+
+	hash += len;
+	for (; end - p >= 8; p += 8) {
+		hash ^= xxh64_round(0, read_le64(p));
+		hash = rotl64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+	}
+	if (end - p >= 4) {
+		hash ^= (uint64_t)read_le32(p) * XXH_PRIME64_1;
+		hash = rotl64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		p += 4;
+	}
+	for (; p < end; p++) {
+		hash ^= *p * XXH_PRIME64_5;
+		hash = rotl64(hash, 11) * XXH_PRIME64_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= XXH_PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= XXH_PRIME64_3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+uint64_t checksum_compute(enum checksum_algo algo, const void *data, size_t len)
+{
+	if (algo == CHECKSUM_ALGO_XXH64)
+		return checksum_xxh64(data, len, 0);
+	return checksum_crc32c(0, data, len);
+}
+
+const char *checksum_algo_name(enum checksum_algo algo)
+{
+	return algo < CHECKSUM_ALGO_NUM ? algo_names[algo] : "unknown";
+}
+
+doca_error_t checksum_self_test(void)
+{
+	static const char check[] = "123456789";
+	static const char long_input[] = "Nobody inspects the spammish repetition";
+	uint8_t buf[1031];
+	uint32_t crc;
+	size_t i;
+
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = (uint8_t)(i * 131 + 7);
+
+	crc = checksum_crc32c(checksum_crc32c(0, check, 4), check + 4, sizeof(check) - 1 - 4);
+	if (checksum_crc32c(0, check, sizeof(check) - 1) != 0xE3069283U || crc != 0xE3069283U ||
+	    ~crc32c_table_update(~0U, (const uint8_t *)check, sizeof(check) - 1) != 0xE3069283U) {
+		DOCA_LOG_ERR("CRC32C check value mismatch");
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	/* Unaligned start and odd length, the selected implementation must agree with the tables */
+	if (checksum_crc32c(0, buf + 1, sizeof(buf) - 1) != ~crc32c_table_update(~0U, buf + 1, sizeof(buf) - 1)) {
+		DOCA_LOG_ERR("CRC32C %s implementation differs from the table implementation", crc32c_selected_name);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	if (checksum_xxh64("", 0, 0) != 0xEF46DB3751D8E999ULL || checksum_xxh64("abc", 3, 0) != 0x44BC2CF5AD770999ULL ||
+	    checksum_xxh64(long_input, sizeof(long_input) - 1, 0) != 0xFBCEA83C8A378BF1ULL) {
+		DOCA_LOG_ERR("xxHash64 test vector mismatch");
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	return DOCA_SUCCESS;
+}
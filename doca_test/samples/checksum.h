@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef CHECKSUM_H_
+#define CHECKSUM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Data integrity checksums for verifying bulk transfers.
+ *
+ * CRC32C runs on the CPU CRC instructions when they are available: SSE4.2 on x86-64 and the ARMv8 CRC extension on
+ * the BlueField Arm cores, selected at run time so that no special build flags are needed. Other CPUs fall back to
+ * a slicing-by-8 table. XXH64 is portable C, it processes four independent 64-bit lanes so the multiplications of
+ * one lane overlap the others.
+ */
+
+/* Available checksum algorithms */
+enum checksum_algo {
+	CHECKSUM_ALGO_CRC32C, /* CRC-32C (Castagnoli), as used by iSCSI and NVMe over Fabrics */
+	CHECKSUM_ALGO_XXH64,  /* xxHash64, seed 0 */
+	CHECKSUM_ALGO_NUM,
+};
+
+/*
+ * Update a CRC32C with more data
+ *
+ * @crc [in]: CRC32C of the preceding data, 0 for the first call
+ * @data [in]: data
+ * @len [in]: data length
+ * @return: CRC32C of the preceding data followed by data
+ */
+uint32_t checksum_crc32c(uint32_t crc, const void *data, size_t len);
+
+/*
+ * Compute the xxHash64 of a buffer
+ *
+ * @data [in]: data
+ * @len [in]: data length
+ * @seed [in]: hash seed
+ * @return: hash value
+ */
+uint64_t checksum_xxh64(const void *data, size_t len, uint64_t seed);
+
+/*
+ * Compute the checksum of a buffer with an algorithm, CRC32C values are zero extended
+ *
+ * @algo [in]: algorithm
+ * @data [in]: data
+ * @len [in]: data length
+ * @return: checksum value
+ */
+uint64_t checksum_compute(enum checksum_algo algo, const void *data, size_t len);
+
+/*
+ * Get the name of an algorithm
+ *
+ * @algo [in]: algorithm
+ * @return: algorithm name
+ */
+const char *checksum_algo_name(enum checksum_algo algo);
+
+/*
+ * Get the name of the CRC32C implementation selected for this CPU
+ *
+ * @return: "sse4.2", "armv8-crc" or "table"
+ */
+const char *checksum_crc32c_impl_name(void);
+
+/*
+ * Check every algorithm, and the CRC32C table fallback, against known test vectors
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR_UNEXPECTED if a value is wrong
+ */
+doca_error_t checksum_self_test(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CHECKSUM_H_ */
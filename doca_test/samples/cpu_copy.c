@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+#include "cpu_copy.h"
+
+#define NT_ALIGN (16) /* Alignment of the destination of a non-temporal store */
+
+#if defined(__x86_64__)
+#define CPU_COPY_NT_NAME "nt-store (sse2)"
+
+/*
+ * Copy with streaming stores, the destination is 16 bytes aligned and len a multiple of 64
+ *
+ * @dst [in]: destination
+ * @src [in]: source
+ * @len [in]: number of bytes to copy
+ */
+static void copy_nt_aligned(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	__m128i a, b, c, d;
+	size_t i;
+
+	for (i = 0; i < len; i += 64) {
+		a = _mm_loadu_si128((const __m128i *)(src + i));
+		b = _mm_loadu_si128((const __m128i *)(src + i + 16));
+		c = _mm_loadu_si128((const __m128i *)(src + i + 32));
+		d = _mm_loadu_si128((const __m128i *)(src + i + 48));
+		_mm_stream_si128((__m128i *)(dst + i), a);
+		_mm_stream_si128((__m128i *)(dst + i + 16), b);
+		_mm_stream_si128((__m128i *)(dst + i + 32), c);
+		_mm_stream_si128((__m128i *)(dst + i + 48), d);
+	}
+	/* Streaming stores are weakly ordered, make them visible before anything that follows the copy */
+	_mm_sfence();
+}
+#elif defined(__aarch64__)
+#define CPU_COPY_NT_NAME "nt-store (stnp)"
+
+/*
+ * Copy with non-temporal store pairs, the destination is 16 bytes aligned and len a multiple of 64
+ *
+ * @dst [in]: destination
+ * @src [in]: source
+ * @len [in]: number of bytes to copy
+ */
+static void copy_nt_aligned(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	uint64_t a, b, c, d;
+	size_t i, j;
+
+	for (i = 0; i < len; i += 64) {
+		for (j = 0; j < 64; j += 32) {
+			memcpy(&a, src + i + j, sizeof(a));
+			memcpy(&b, src + i + j + 8, sizeof(b));
+			memcpy(&c, src + i + j + 16, sizeof(c));
+			memcpy(&d, src + i + j + 24, sizeof(d));
+			__asm__ volatile("stnp %1, %2, [%0]\n\t"
+					 "stnp %3, %4, [%0, #16]"
+					 :
+					 : "r"(dst + i + j), "r"(a), "r"(b), "r"(c), "r"(d)
+					 : "memory");
+		}
+	}
+	/* stnp only hints the stores, order them before anything that follows the copy as on x86 */
+	__asm__ volatile("dmb ishst" ::: "memory");
+}
+#endif
+
+void cpu_copy_nt(void *dst, const void *src, size_t len)
+{
+#ifdef CPU_COPY_NT_NAME
+	uint8_t *d = (uint8_t *)dst;
+	const uint8_t *s = (const uint8_t *)src;
+	size_t head, body;
+
+	/* Cached stores for the unaligned head and the tail, streaming stores for the aligned body */
+	head = (NT_ALIGN - ((uintptr_t)d & (NT_ALIGN - 1))) & (NT_ALIGN - 1);
+	if (head > len)
+		head = len;
+	memcpy(d, s, head);
+	d += head;
+	s += head;
+	len -= head;
+
+	body = len & ~(size_t)63;
+	if (body > 0)
+		copy_nt_aligned(d, s, body);
+	memcpy(d + body, s + body, len - body);
+#else
+	memcpy(dst, src, len);
+#endif
+}
+
+void cpu_copy(enum cpu_copy_method method, void *dst, const void *src, size_t len)
+{
+	if (method == CPU_COPY_NT)
+		cpu_copy_nt(dst, src, len);
+	else
+		memcpy(dst, src, len);
+}
+
+const char *cpu_copy_method_name(enum cpu_copy_method method)
+{
+	switch (method) {
+	case CPU_COPY_MEMCPY:
+		return "memcpy";
+	case CPU_COPY_NT:
+#ifdef CPU_COPY_NT_NAME
+		return CPU_COPY_NT_NAME;
+#else
+		return "nt-store (memcpy)";
+#endif
+	default:
+		return "unknown";
+	}
+}
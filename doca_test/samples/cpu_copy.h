@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef CPU_COPY_H_
+#define CPU_COPY_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * CPU copies the DMA engine is measured against.
+ *
+ * The non-temporal copy writes the destination with streaming stores that bypass the caches: SSE2 movntdq on
+ * x86-64 and stnp on the BlueField Arm cores, both part of the base instruction sets so no special build flags are
+ * needed. It does not pull the destination into the caches or evict the working set, which is how the DMA engine
+ * writes too. Other CPUs fall back to memcpy.
+ */
+
+/* Available CPU copy methods */
+enum cpu_copy_method {
+	CPU_COPY_MEMCPY, /* libc memcpy */
+	CPU_COPY_NT,	 /* Non-temporal stores */
+	CPU_COPY_NUM,
+};
+
+/*
+ * Copy a buffer with non-temporal stores, the stores are ordered before the function returns
+ *
+ * @dst [in]: destination
+ * @src [in]: source
+ * @len [in]: number of bytes to copy
+ */
+void cpu_copy_nt(void *dst, const void *src, size_t len);
+
+/*
+ * Copy a buffer with a method
+ *
+ * @method [in]: copy method
+ * @dst [in]: destination
+ * @src [in]: source
+ * @len [in]: number of bytes to copy
+ */
+void cpu_copy(enum cpu_copy_method method, void *dst, const void *src, size_t len);
+
+/*
+ * Get the name of a copy method
+ *
+ * @method [in]: copy method
+ * @return: method name, includes the instructions of the non-temporal copy
+ */
+const char *cpu_copy_method_name(enum cpu_copy_method method);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CPU_COPY_H_ */
@@ -40,6 +40,8 @@
 
 DOCA_LOG_REGISTER(PE::COMMON);
 
+#define PE_VERIFY_LINE_SIZE (64) /* Granularity of the sampled verification */
+
 /**
  * This macro is used to minimize code size.
  * The macro runs an expression and returns error if the expression status is not DOCA_SUCCESS
@@ -54,6 +56,29 @@ DOCA_LOG_REGISTER(PE::COMMON);
 		} \
 	}
 
+/*
+ * Check that a range of the destination holds the expected value
+ *
+ * @dst [in]: destination data
+ * @offset [in]: start of the range
+ * @len [in]: length of the range
+ * @expected_value [in]: Expected value in the destination.
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR_INVALID_VALUE otherwise
+ */
+static doca_error_t verify_dma_destination_range(const uint8_t *dst, size_t offset, size_t len, uint8_t expected_value)
+{
+	size_t i = 0;
+
+	for (i = offset; i < offset + len; i++) {
+		if (dst[i] != expected_value) {
+			DOCA_LOG_ERR("Memcpy failed: Expected %d, received %d at index %zu", expected_value, dst[i], i);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * Process completed task
  *
@@ -64,20 +89,53 @@ DOCA_LOG_REGISTER(PE::COMMON);
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 doca_error_t process_completed_dma_memcpy_task(struct doca_dma_task_memcpy *dma_task, uint8_t expected_value)
+{
+	return verify_dma_memcpy_task_sampled(dma_task, expected_value, 0);
+}
+
+/*
+ * Verify a completed task on a sample of the destination
+ *
+ * @details This function checks the first and the last cache lines and num_lines random ones, so that the cost of
+ * the check does not grow with the buffer size.
+ *
+ * @dma_task [in]: Completed task
+ * @expected_value [in]: Expected value in the destination.
+ * @num_lines [in]: Number of random cache lines to check, 0 checks the whole destination
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t verify_dma_memcpy_task_sampled(struct doca_dma_task_memcpy *dma_task,
+					    uint8_t expected_value,
+					    uint32_t num_lines)
 {
 	const struct doca_buf *dest = doca_dma_task_memcpy_get_dst(dma_task);
 	uint8_t *dst = NULL;
 	size_t dst_len = 0;
-	size_t i = 0;
+	size_t total_lines, line, offset, len;
+	uint64_t seed;
+	uint32_t i;
 
 	EXIT_ON_FAILURE(doca_buf_get_data(dest, (void **)&dst));
 	EXIT_ON_FAILURE(doca_buf_get_len(dest, &dst_len));
 
-	for (i = 0; i < dst_len; i++) {
-		if (dst[i] != expected_value) {
-			DOCA_LOG_ERR("Memcpy failed: Expected %d, received %d at index %zu", expected_value, dst[i], i);
-			return DOCA_ERROR_INVALID_VALUE;
-		}
+	total_lines = (dst_len + PE_VERIFY_LINE_SIZE - 1) / PE_VERIFY_LINE_SIZE;
+	if (num_lines == 0 || total_lines <= (size_t)num_lines + 2)
+		return verify_dma_destination_range(dst, 0, dst_len, expected_value);
+
+	EXIT_ON_FAILURE(verify_dma_destination_range(dst, 0, PE_VERIFY_LINE_SIZE, expected_value));
+	offset = (total_lines - 1) * PE_VERIFY_LINE_SIZE;
+	EXIT_ON_FAILURE(verify_dma_destination_range(dst, offset, dst_len - offset, expected_value));
+
+	/* xorshift64, the lines only have to differ between tasks and runs */
+	seed = ((uint64_t)(uintptr_t)dst ^ (uint64_t)time(NULL)) | 1;
+	for (i = 0; i < num_lines; i++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		line = seed % total_lines;
+		offset = line * PE_VERIFY_LINE_SIZE;
+		len = line == total_lines - 1 ? dst_len - offset : PE_VERIFY_LINE_SIZE;
+		EXIT_ON_FAILURE(verify_dma_destination_range(dst, offset, len, expected_value));
 	}
 
 	return DOCA_SUCCESS;
@@ -144,6 +202,7 @@ doca_error_t allocate_buffer(struct pe_sample_state_base *state)
 /**
  * This method allocate the DMA tasks but does not submit them.
  * This is a sample choice. A task can be submitted immediately after it is allocated.
+ * The buffers are not initialized (@see init_dma_task_buffers).
  *
  * @state [in]: sample state
  * @dma [in] DMA context to allocate the tasks from.
@@ -177,7 +236,6 @@ doca_error_t allocate_dma_tasks(struct pe_sample_state_base *state,
 								   dma_buffer_size,
 								   &source));
 
-		memset(state->available_buffer, (task_id + 1), dma_buffer_size);
 		state->available_buffer += dma_buffer_size;
 
 		/**
@@ -190,7 +248,6 @@ doca_error_t allocate_dma_tasks(struct pe_sample_state_base *state,
 								   dma_buffer_size,
 								   &destination));
 
-		memset(state->available_buffer, 0, dma_buffer_size);
 		state->available_buffer += dma_buffer_size;
 
 		EXIT_ON_FAILURE(doca_dma_task_memcpy_alloc_init(dma, source, destination, user_data, &tasks[task_id]));
@@ -199,6 +256,40 @@ doca_error_t allocate_dma_tasks(struct pe_sample_state_base *state,
 	return DOCA_SUCCESS;
 }
 
+/**
+ * This method fills the source of every task with the value its completion is verified against and clears the
+ * destination. It is optional and is meant to run before the timed region.
+ *
+ * @num_tasks [in]: Number of tasks per group
+ * @tasks [in]: tasks to initialize (@see allocate_dma_tasks)
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t init_dma_task_buffers(uint32_t num_tasks, struct doca_dma_task_memcpy **tasks)
+{
+	uint32_t task_id = 0;
+
+	for (task_id = 0; task_id < num_tasks; task_id++) {
+		const struct doca_buf *source = doca_dma_task_memcpy_get_src(tasks[task_id]);
+		const struct doca_buf *destination = doca_dma_task_memcpy_get_dst(tasks[task_id]);
+		union doca_data user_data = doca_task_get_user_data(doca_dma_task_memcpy_as_task(tasks[task_id]));
+		void *src = NULL;
+		void *dst = NULL;
+		size_t src_len = 0;
+		size_t dst_len = 0;
+
+		EXIT_ON_FAILURE(doca_buf_get_data(source, &src));
+		EXIT_ON_FAILURE(doca_buf_get_data_len(source, &src_len));
+		/* The destination has no data yet, clear all of it */
+		EXIT_ON_FAILURE(doca_buf_get_head(destination, &dst));
+		EXIT_ON_FAILURE(doca_buf_get_len(destination, &dst_len));
+
+		memset(src, (uint8_t)user_data.u64, src_len);
+		memset(dst, 0, dst_len);
+	}
+
+	return DOCA_SUCCESS;
+}
+
 /**
  * This method submits all the tasks (@see allocate_dma_tasks).
  *
@@ -220,6 +311,56 @@ doca_error_t submit_dma_tasks(uint32_t num_tasks, struct doca_dma_task_memcpy **
 	return DOCA_SUCCESS;
 }
 
+/**
+ * This method submits all the tasks in batches (@see allocate_dma_tasks).
+ * Only the last task of every batch is submitted with DOCA_TASK_SUBMIT_FLAG_FLUSH, so the context can hand the whole
+ * batch to the HW at once instead of ringing the doorbell per task. A batch size of 1 submits every task with
+ * doca_task_submit(), like submit_dma_tasks(). Unlike submit_dma_tasks(), this method does not log, so that it can be
+ * used in a timed loop.
+ * If a submission fails, the tasks submitted before it are flushed and stay in flight.
+ *
+ * @dma [in]: DMA context of the tasks
+ * @num_tasks [in]: Number of tasks per group
+ * @batch_size [in]: Number of tasks per flush
+ * @tasks [in]: tasks to submit
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t submit_dma_tasks_batched(struct doca_dma *dma,
+				     uint32_t num_tasks,
+				     uint32_t batch_size,
+				     struct doca_dma_task_memcpy **tasks)
+{
+	struct doca_task *task;
+	uint32_t task_id = 0;
+	uint32_t flags;
+	doca_error_t status;
+
+	if (batch_size <= 1) {
+		for (task_id = 0; task_id < num_tasks; task_id++)
+			EXIT_ON_FAILURE(doca_task_submit(doca_dma_task_memcpy_as_task(tasks[task_id])));
+		return DOCA_SUCCESS;
+	}
+
+	for (task_id = 0; task_id < num_tasks; task_id++) {
+		task = doca_dma_task_memcpy_as_task(tasks[task_id]);
+		flags = DOCA_TASK_SUBMIT_FLAG_NONE;
+		/* The last task of a batch, or of the group, flushes the tasks submitted before it */
+		if ((task_id + 1) % batch_size == 0 || task_id + 1 == num_tasks)
+			flags = DOCA_TASK_SUBMIT_FLAG_FLUSH;
+
+		status = doca_task_submit_ex(task, flags);
+		if (status != DOCA_SUCCESS) {
+			/* Do not leave the start of the batch waiting for a flush that will not come */
+			if (task_id % batch_size != 0)
+				doca_ctx_flush_tasks(doca_dma_as_ctx(dma));
+			DOCA_LOG_ERR("Failed to submit task %u: %s", task_id, doca_error_get_descr(status));
+			return status;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * Check if DOCA device is DMA capable
  *
@@ -354,3 +495,250 @@ doca_error_t poll_for_completion(struct pe_sample_state_base *state, uint32_t nu
 
 	return DOCA_SUCCESS;
 }
+
+/**
+ * This struct defines a rotating buffer of a DMA pipeline and the task that fills it.
+ */
+struct pe_pipeline_slot {
+	struct doca_dma_task_memcpy *task; /* Task that copies a chunk into the buffer */
+	uint8_t *buffer;		   /* Destination buffer */
+	uint32_t chunk_id;		   /* Chunk that is copied, or was last copied, into the buffer */
+	bool in_flight;			   /* The task was submitted and did not complete yet */
+	doca_error_t status;		   /* Status of the last completed task */
+};
+
+/**
+ * Get a monotonic timestamp
+ *
+ * @return: CLOCK_MONOTONIC time in nanoseconds
+ */
+static uint64_t pipeline_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * DMA memcpy task completion callback of a DMA pipeline
+ *
+ * @details This function hands the chunk to the pipeline, the task is reused for a later chunk.
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+void pe_pipeline_memcpy_completed_callback(struct doca_dma_task_memcpy *dma_task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data)
+{
+	struct pe_pipeline_slot *slot = (struct pe_pipeline_slot *)task_user_data.ptr;
+
+	(void)dma_task;
+	(void)ctx_user_data;
+
+	slot->status = DOCA_SUCCESS;
+	slot->in_flight = false;
+}
+
+/*
+ * DMA memcpy task error callback of a DMA pipeline
+ *
+ * @details This function records the failure, the pipeline stops when it reaches the chunk.
+ *
+ * @dma_task [in]: Failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+void pe_pipeline_memcpy_error_callback(struct doca_dma_task_memcpy *dma_task,
+				       union doca_data task_user_data,
+				       union doca_data ctx_user_data)
+{
+	struct pe_pipeline_slot *slot = (struct pe_pipeline_slot *)task_user_data.ptr;
+
+	(void)ctx_user_data;
+
+	slot->status = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+	slot->in_flight = false;
+}
+
+/**
+ * Point the task of a rotating buffer at a chunk and submit it.
+ * The task is reused, only the source data and the destination length change between chunks.
+ *
+ * @slot [in]: rotating buffer
+ * @cfg [in]: pipeline configuration
+ * @chunk_id [in]: chunk to copy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t submit_pipeline_chunk(struct pe_pipeline_slot *slot,
+					  const struct pe_pipeline_cfg *cfg,
+					  uint32_t chunk_id)
+{
+	/* The pipeline owns the source buffer, it only moves its data window over the source */
+	struct doca_buf *src = (struct doca_buf *)doca_dma_task_memcpy_get_src(slot->task);
+	struct doca_buf *dst = doca_dma_task_memcpy_get_dst(slot->task);
+	doca_error_t status;
+
+	EXIT_ON_FAILURE(doca_buf_set_data(src, cfg->src + (size_t)chunk_id * cfg->chunk_size, cfg->chunk_size));
+	EXIT_ON_FAILURE(doca_buf_reset_data_len(dst));
+
+	slot->chunk_id = chunk_id;
+	slot->in_flight = true;
+	status = doca_task_submit(doca_dma_task_memcpy_as_task(slot->task));
+	if (status != DOCA_SUCCESS) {
+		slot->in_flight = false;
+		DOCA_LOG_ERR("Failed to submit the copy of chunk %u: %s", chunk_id, doca_error_get_descr(status));
+	}
+
+	return status;
+}
+
+/**
+ * Allocate the tasks of the rotating buffers.
+ * Every task gets a source buffer over the whole source and a destination buffer over its rotating buffer.
+ *
+ * @state [in]: sample state
+ * @dma [in]: DMA context to allocate the tasks from
+ * @cfg [in]: pipeline configuration
+ * @slots [in]: rotating buffers
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t allocate_pipeline_tasks(struct pe_sample_state_base *state,
+					    struct doca_dma *dma,
+					    const struct pe_pipeline_cfg *cfg,
+					    struct pe_pipeline_slot *slots)
+{
+	uint32_t i;
+
+	for (i = 0; i < cfg->num_buffers; i++) {
+		struct doca_buf *source = NULL;
+		struct doca_buf *destination = NULL;
+		union doca_data user_data = {0};
+		doca_error_t status;
+
+		slots[i].buffer = cfg->dst + (size_t)i * cfg->chunk_size;
+		user_data.ptr = &slots[i];
+
+		EXIT_ON_FAILURE(doca_buf_inventory_buf_get_by_data(state->inventory,
+								   state->mmap,
+								   cfg->src,
+								   (size_t)cfg->num_chunks * cfg->chunk_size,
+								   &source));
+
+		status = doca_buf_inventory_buf_get_by_addr(state->inventory,
+							    state->mmap,
+							    slots[i].buffer,
+							    cfg->chunk_size,
+							    &destination);
+		if (status != DOCA_SUCCESS) {
+			(void)doca_buf_dec_refcount(source, NULL);
+			DOCA_LOG_ERR("Failed to get a destination buffer: %s", doca_error_get_descr(status));
+			return status;
+		}
+
+		status = doca_dma_task_memcpy_alloc_init(dma, source, destination, user_data, &slots[i].task);
+		if (status != DOCA_SUCCESS) {
+			(void)doca_buf_dec_refcount(destination, NULL);
+			(void)doca_buf_dec_refcount(source, NULL);
+			DOCA_LOG_ERR("Failed to allocate a pipeline task: %s", doca_error_get_descr(status));
+			return status;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/**
+ * Run a DMA pipeline: the compute callback processes chunk N while the copies of the following chunks, up to
+ * num_buffers - 1 of them, are in flight.
+ *
+ * @state [in]: sample state
+ * @dma [in]: DMA context to allocate the tasks from
+ * @cfg [in]: pipeline configuration
+ * @stats [out]: pipeline timings
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t run_dma_pipeline(struct pe_sample_state_base *state,
+			      struct doca_dma *dma,
+			      const struct pe_pipeline_cfg *cfg,
+			      struct pe_pipeline_stats *stats)
+{
+	struct pe_pipeline_slot slots[PE_PIPELINE_MAX_BUFFERS] = {0};
+	struct pe_pipeline_slot *slot;
+	uint64_t start, wait_start, compute_start;
+	doca_error_t status, tmp_status;
+	uint32_t chunk_id, i;
+
+	if (cfg->num_buffers == 0 || cfg->num_buffers > PE_PIPELINE_MAX_BUFFERS) {
+		DOCA_LOG_ERR("A pipeline uses between 1 and %d buffers", PE_PIPELINE_MAX_BUFFERS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (cfg->num_chunks == 0 || cfg->chunk_size == 0 || cfg->compute_cb == NULL) {
+		DOCA_LOG_ERR("A pipeline needs at least one chunk and a compute callback");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+
+	status = allocate_pipeline_tasks(state, dma, cfg, slots);
+	if (status != DOCA_SUCCESS)
+		goto free_tasks;
+
+	start = pipeline_time_ns();
+
+	/* Fill the pipeline, every buffer gets a chunk before the first compute */
+	for (i = 0; i < cfg->num_buffers && i < cfg->num_chunks; i++) {
+		status = submit_pipeline_chunk(&slots[i], cfg, i);
+		if (status != DOCA_SUCCESS)
+			goto free_tasks;
+	}
+
+	for (chunk_id = 0; chunk_id < cfg->num_chunks; chunk_id++) {
+		slot = &slots[chunk_id % cfg->num_buffers];
+
+		/* Progress only when the chunk is not there yet, this is the copy time the compute did not hide */
+		wait_start = pipeline_time_ns();
+		while (slot->in_flight)
+			(void)doca_pe_progress(state->pe);
+		compute_start = pipeline_time_ns();
+		stats->stall_ns += compute_start - wait_start;
+
+		if (slot->status != DOCA_SUCCESS) {
+			status = slot->status;
+			DOCA_LOG_ERR("Copy of chunk %u failed: %s", chunk_id, doca_error_get_descr(status));
+			goto free_tasks;
+		}
+
+		/* Completions of the other buffers are collected by the next wait, the compute is not interrupted */
+		status = cfg->compute_cb(slot->buffer, cfg->chunk_size, chunk_id, cfg->user_data);
+		stats->compute_ns += pipeline_time_ns() - compute_start;
+		if (status != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Compute of chunk %u failed: %s", chunk_id, doca_error_get_descr(status));
+			goto free_tasks;
+		}
+
+		/* The buffer is free again, refill it with the chunk that is num_buffers ahead */
+		if (chunk_id + cfg->num_buffers < cfg->num_chunks) {
+			status = submit_pipeline_chunk(slot, cfg, chunk_id + cfg->num_buffers);
+			if (status != DOCA_SUCCESS)
+				goto free_tasks;
+		}
+	}
+
+	stats->total_ns = pipeline_time_ns() - start;
+
+free_tasks:
+	for (i = 0; i < cfg->num_buffers; i++) {
+		if (slots[i].task == NULL)
+			continue;
+		/* A task can only be freed once it completed */
+		while (slots[i].in_flight)
+			(void)doca_pe_progress(state->pe);
+		tmp_status = dma_task_free(slots[i].task);
+		DOCA_ERROR_PROPAGATE(status, tmp_status);
+	}
+
+	return status;
+}
@@ -26,9 +26,13 @@
 #ifndef PE_COMMON_H_
 #define PE_COMMON_H_
 
+#include <stdbool.h>
+
 #include <doca_ctx.h>
 #include <doca_dma.h>
 
+#define PE_PIPELINE_MAX_BUFFERS (4) /* Maximum number of rotating destination buffers of a DMA pipeline */
+
 /**
  * This struct defines the program context.
  */
@@ -65,6 +69,18 @@ struct pe_sample_state_base {
  */
 doca_error_t process_completed_dma_memcpy_task(struct doca_dma_task_memcpy *dma_task, uint8_t expected_value);
 
+/*
+ * Verify a completed task on a sample of the destination
+ *
+ * @dma_task [in]: Completed task
+ * @expected_value [in]: Expected value in the destination.
+ * @num_lines [in]: Number of random cache lines to check besides the first and the last, 0 checks all of them
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t verify_dma_memcpy_task_sampled(struct doca_dma_task_memcpy *dma_task,
+					    uint8_t expected_value,
+					    uint32_t num_lines);
+
 /*
  * Free task buffers
  *
@@ -92,6 +108,7 @@ doca_error_t allocate_buffer(struct pe_sample_state_base *state);
 /**
  * This method allocate the DMA tasks but does not submit them.
  * This is a sample choice. A task can be submitted immediately after it is allocated.
+ * The buffers are not initialized (@see init_dma_task_buffers).
  *
  * @state [in]: sample state
  * @dma [in]: DMA context to allocate the tasks from
@@ -106,6 +123,16 @@ doca_error_t allocate_dma_tasks(struct pe_sample_state_base *state,
 				size_t dma_buffer_size,
 				struct doca_dma_task_memcpy **tasks);
 
+/**
+ * This method fills the source of every task with the value its completion is verified against and clears the
+ * destination. It is optional and is meant to run before the timed region.
+ *
+ * @num_tasks [in]: Number of tasks per group
+ * @tasks [in]: tasks to initialize (@see allocate_dma_tasks)
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t init_dma_task_buffers(uint32_t num_tasks, struct doca_dma_task_memcpy **tasks);
+
 /**
  * This method submits all the tasks (@see allocate_dma_tasks).
  *
@@ -115,6 +142,25 @@ doca_error_t allocate_dma_tasks(struct pe_sample_state_base *state,
  */
 doca_error_t submit_dma_tasks(uint32_t num_tasks, struct doca_dma_task_memcpy **tasks);
 
+/**
+ * This method submits all the tasks in batches (@see allocate_dma_tasks).
+ * Only the last task of every batch is submitted with DOCA_TASK_SUBMIT_FLAG_FLUSH, so the context can hand the whole
+ * batch to the HW at once instead of ringing the doorbell per task. A batch size of 1 submits every task with
+ * doca_task_submit(), like submit_dma_tasks(). Unlike submit_dma_tasks(), this method does not log, so that it can be
+ * used in a timed loop.
+ * If a submission fails, the tasks submitted before it are flushed and stay in flight.
+ *
+ * @dma [in]: DMA context of the tasks
+ * @num_tasks [in]: Number of tasks per group
+ * @batch_size [in]: Number of tasks per flush
+ * @tasks [in]: tasks to submit
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t submit_dma_tasks_batched(struct doca_dma *dma,
+				     uint32_t num_tasks,
+				     uint32_t batch_size,
+				     struct doca_dma_task_memcpy **tasks);
+
 /**
  * Opens a device that supports SHA and DMA
  *
@@ -156,6 +202,80 @@ doca_error_t create_buf_inventory(struct pe_sample_state_base *state);
  */
 doca_error_t poll_for_completion(struct pe_sample_state_base *state, uint32_t num_tasks);
 
+/**
+ * Compute callback of a DMA pipeline, called on every chunk once it was copied to its destination buffer.
+ * The buffer is handed back to the pipeline, and reused for a later chunk, when the callback returns.
+ *
+ * @chunk [in]: destination buffer that holds the chunk
+ * @chunk_size [in]: chunk size
+ * @chunk_id [in]: chunk index in the source
+ * @user_data [in]: user data of the pipeline
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise, an error stops the pipeline
+ */
+typedef doca_error_t (*pe_pipeline_compute_cb_t)(uint8_t *chunk, size_t chunk_size, uint32_t chunk_id, void *user_data);
+
+/**
+ * This struct defines a DMA pipeline.
+ * Both the source and the destination buffers must be part of the state MMAP.
+ */
+struct pe_pipeline_cfg {
+	uint8_t *src;			     /* Source, num_chunks * chunk_size bytes */
+	uint8_t *dst;			     /* Rotating destination buffers, num_buffers * chunk_size bytes */
+	size_t chunk_size;		     /* Size of one chunk */
+	uint32_t num_chunks;		     /* Number of chunks in the source */
+	uint32_t num_buffers;		     /* Number of rotating buffers, 1 copies and computes serially */
+	pe_pipeline_compute_cb_t compute_cb; /* Called on every copied chunk */
+	void *user_data;		     /* Passed to the compute callback */
+};
+
+/**
+ * This struct holds the timings of a DMA pipeline run.
+ */
+struct pe_pipeline_stats {
+	uint64_t total_ns;   /* From the first submission to the last compute */
+	uint64_t compute_ns; /* Time spent in the compute callback */
+	uint64_t stall_ns;   /* Time spent waiting for a copy with nothing to compute */
+};
+
+/*
+ * DMA memcpy task completion callback of a DMA pipeline
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+void pe_pipeline_memcpy_completed_callback(struct doca_dma_task_memcpy *dma_task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data);
+
+/*
+ * DMA memcpy task error callback of a DMA pipeline
+ *
+ * @dma_task [in]: Failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+void pe_pipeline_memcpy_error_callback(struct doca_dma_task_memcpy *dma_task,
+				       union doca_data task_user_data,
+				       union doca_data ctx_user_data);
+
+/**
+ * Run a DMA pipeline: the compute callback processes chunk N while the copies of the following chunks, up to
+ * num_buffers - 1 of them, are in flight.
+ * The DMA context must be started with the pipeline callbacks (@see pe_pipeline_memcpy_completed_callback) and at
+ * least num_buffers memcpy tasks. The pipeline takes two buffers per rotating buffer from the inventory.
+ *
+ * @state [in]: sample state
+ * @dma [in]: DMA context to allocate the tasks from
+ * @cfg [in]: pipeline configuration
+ * @stats [out]: pipeline timings
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t run_dma_pipeline(struct pe_sample_state_base *state,
+			      struct doca_dma *dma,
+			      const struct pe_pipeline_cfg *cfg,
+			      struct pe_pipeline_stats *stats);
+
 /**
  * This method cleans up the sample resources in reverse order of their creation.
  * This method does not check for destroy return values for simplify.
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <doca_argp.h>
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "pe_common.h"
+
+DOCA_LOG_REGISTER(PE_PIPELINE::MAIN);
+
+/* Sample's Logic */
+doca_error_t run_pe_pipeline_sample(uint32_t chunk_size, uint32_t num_chunks, uint32_t max_buffers);
+
+#define DEFAULT_CHUNK_SIZE (65536) /* Default chunk size */
+#define DEFAULT_NUM_CHUNKS (1024)  /* Default number of chunks */
+#define MAX_CHUNK_SIZE (1 << 26)   /* Largest chunk the sample copies */
+#define MAX_NUM_CHUNKS (1 << 20)   /* Largest number of chunks the sample copies */
+#define MIN_PIPELINE_BUFFERS (2)   /* Fewest rotating buffers that overlap a copy with a compute */
+
+/* Sample configuration */
+struct pe_pipeline_config {
+	uint32_t chunk_size;  /* Size of one chunk */
+	uint32_t num_chunks;  /* Number of chunks copied by every run */
+	uint32_t max_buffers; /* Largest number of rotating buffers to measure */
+};
+
+/*
+ * ARGP Callback - Handle chunk size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunk_size_callback(void *param, void *config)
+{
+	struct pe_pipeline_config *cfg = (struct pe_pipeline_config *)config;
+	const int chunk_size = *(int *)param;
+
+	if (chunk_size <= 0 || chunk_size > MAX_CHUNK_SIZE) {
+		DOCA_LOG_ERR("Chunk size must be between 1 and %d bytes", MAX_CHUNK_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->chunk_size = (uint32_t)chunk_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of chunks parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_chunks_callback(void *param, void *config)
+{
+	struct pe_pipeline_config *cfg = (struct pe_pipeline_config *)config;
+	const int num_chunks = *(int *)param;
+
+	if (num_chunks <= 0 || num_chunks > MAX_NUM_CHUNKS) {
+		DOCA_LOG_ERR("Number of chunks must be between 1 and %d", MAX_NUM_CHUNKS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->num_chunks = (uint32_t)num_chunks;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of buffers parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t buffers_callback(void *param, void *config)
+{
+	struct pe_pipeline_config *cfg = (struct pe_pipeline_config *)config;
+	const int buffers = *(int *)param;
+
+	if (buffers < MIN_PIPELINE_BUFFERS || buffers > PE_PIPELINE_MAX_BUFFERS) {
+		DOCA_LOG_ERR("Number of buffers must be between %d and %d",
+			     MIN_PIPELINE_BUFFERS,
+			     PE_PIPELINE_MAX_BUFFERS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->max_buffers = (uint32_t)buffers;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the pipeline parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_pe_pipeline_params(void)
+{
+	struct doca_argp_param *chunk_size_param, *num_chunks_param, *buffers_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&chunk_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(chunk_size_param, "s");
+	doca_argp_param_set_long_name(chunk_size_param, "chunk-size");
+	doca_argp_param_set_arguments(chunk_size_param, "<bytes>");
+	doca_argp_param_set_description(chunk_size_param, "Size of the chunk copied per DMA task (optional)");
+	doca_argp_param_set_callback(chunk_size_param, chunk_size_callback);
+	doca_argp_param_set_type(chunk_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(chunk_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&num_chunks_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(num_chunks_param, "n");
+	doca_argp_param_set_long_name(num_chunks_param, "num-chunks");
+	doca_argp_param_set_arguments(num_chunks_param, "<num>");
+	doca_argp_param_set_description(num_chunks_param, "Number of chunks copied and computed per run (optional)");
+	doca_argp_param_set_callback(num_chunks_param, num_chunks_callback);
+	doca_argp_param_set_type(num_chunks_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(num_chunks_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&buffers_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(buffers_param, "b");
+	doca_argp_param_set_long_name(buffers_param, "buffers");
+	doca_argp_param_set_arguments(buffers_param, "<2-4>");
+	doca_argp_param_set_description(buffers_param,
+					"Largest number of rotating buffers to measure, from 2 up (optional)");
+	doca_argp_param_set_callback(buffers_param, buffers_callback);
+	doca_argp_param_set_type(buffers_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(buffers_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct pe_pipeline_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	cfg.chunk_size = DEFAULT_CHUNK_SIZE;
+	cfg.num_chunks = DEFAULT_NUM_CHUNKS;
+	cfg.max_buffers = PE_PIPELINE_MAX_BUFFERS;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_pe_pipeline", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register pipeline params */
+	result = register_pe_pipeline_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register pipeline parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Run the sample's core function */
+	result = run_pe_pipeline_sample(cfg.chunk_size, cfg.num_chunks, cfg.max_buffers);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("run_pe_pipeline_sample() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
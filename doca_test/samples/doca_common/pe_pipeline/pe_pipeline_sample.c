@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <doca_mmap.h>
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_pe.h>
+#include <doca_dma.h>
+#include <doca_types.h>
+#include <doca_log.h>
+
+#include <samples/common.h>
+#include <bench_common.h>
+#include "pe_common.h"
+
+DOCA_LOG_REGISTER(PE_PIPELINE::SAMPLE);
+
+/**
+ * This sample overlaps DMA copies with the processing of the copied data.
+ *
+ *   copy    | chunk 0 | chunk 1 | chunk 2 | ...
+ *   compute           | chunk 0 | chunk 1 | chunk 2 | ...
+ *
+ * The compute callback processes chunk N from one of 2 to 4 rotating buffers while the copies of the following
+ * chunks fill the other buffers. A run with a single buffer copies and computes serially, and the copy time that the
+ * pipeline hides is measured against it, for compute times from 0 to 4 times the copy time of a chunk.
+ * With two buffers at most min(compute, copy) of every copy can be hidden; more buffers keep several copies in flight
+ * and absorb the jitter of both sides.
+ */
+
+/* Compute time per chunk, in percent of the copy time of a chunk */
+static const uint32_t compute_percents[] = {0, 25, 50, 100, 200, 400};
+
+/**
+ * This struct defines the program context.
+ */
+struct pipeline_sample_state {
+	struct pe_sample_state_base base;
+
+	struct doca_dma *dma;
+	struct doca_ctx *dma_ctx;
+	bool dma_started;
+};
+
+/**
+ * This struct defines the stand-in compute of the sample.
+ */
+struct pipeline_compute {
+	uint64_t compute_ns; /* Time the compute spends on every chunk */
+};
+
+/*
+ * Get the value a chunk is filled with
+ *
+ * @chunk_id [in]: chunk index
+ * @return: value of every byte of the chunk
+ */
+static inline uint8_t chunk_value(uint32_t chunk_id)
+{
+	return (uint8_t)(chunk_id % UINT8_MAX + 1);
+}
+
+/*
+ * Compute callback of the pipeline
+ *
+ * @details This function checks a few bytes of the chunk and then busy waits for the configured compute time, as a
+ * stand-in for the real processing of the chunk.
+ *
+ * @chunk [in]: destination buffer that holds the chunk
+ * @chunk_size [in]: chunk size
+ * @chunk_id [in]: chunk index in the source
+ * @user_data [in]: compute configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t compute_chunk(uint8_t *chunk, size_t chunk_size, uint32_t chunk_id, void *user_data)
+{
+	const struct pipeline_compute *compute = (struct pipeline_compute *)user_data;
+	const uint8_t expected = chunk_value(chunk_id);
+	const uint64_t start = bench_get_time_ns();
+
+	/* Only sample the chunk so that a zero compute time stays close to zero */
+	if (chunk[0] != expected || chunk[chunk_size / 2] != expected || chunk[chunk_size - 1] != expected) {
+		DOCA_LOG_ERR("Chunk %u holds unexpected data, expected %u", chunk_id, expected);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	while (bench_get_time_ns() - start < compute->compute_ns)
+		continue;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Create the DMA context, connect it to the PE and start it
+ *
+ * @state [in]: sample state
+ * @chunk_size [in]: chunk size
+ * @max_buffers [in]: largest number of rotating buffers
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t create_pipeline_dma(struct pipeline_sample_state *state, uint32_t chunk_size, uint32_t max_buffers)
+{
+	uint64_t max_buf_size = 0;
+	doca_error_t status;
+
+	status = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->base.device), &max_buf_size);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get the maximum DMA buffer size: %s", doca_error_get_descr(status));
+		return status;
+	}
+	if (chunk_size > max_buf_size) {
+		DOCA_LOG_ERR("Chunk size %u exceeds the maximum DMA buffer size %lu", chunk_size, max_buf_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	status = doca_dma_create(state->base.device, &state->dma);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context: %s", doca_error_get_descr(status));
+		return status;
+	}
+	state->dma_ctx = doca_dma_as_ctx(state->dma);
+
+	status = doca_pe_connect_ctx(state->base.pe, state->dma_ctx);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect DMA context to the PE: %s", doca_error_get_descr(status));
+		return status;
+	}
+
+	status = doca_dma_task_memcpy_set_conf(state->dma,
+					       pe_pipeline_memcpy_completed_callback,
+					       pe_pipeline_memcpy_error_callback,
+					       max_buffers);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DMA memcpy task configuration: %s", doca_error_get_descr(status));
+		return status;
+	}
+
+	status = doca_ctx_start(state->dma_ctx);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(status));
+		return status;
+	}
+	state->dma_started = true;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Destroy the DMA context and the base resources
+ *
+ * @state [in]: sample state
+ */
+static void pipeline_sample_cleanup(struct pipeline_sample_state *state)
+{
+	if (state->dma_started)
+		(void)doca_ctx_stop(state->dma_ctx);
+
+	if (state->dma != NULL)
+		(void)doca_dma_destroy(state->dma);
+
+	pe_sample_base_cleanup(&state->base);
+}
+
+/*
+ * Measure the pipeline for every compute time and every number of rotating buffers
+ *
+ * @state [in]: sample state
+ * @cfg [in]: pipeline configuration, the number of buffers and the compute are set per run
+ * @compute [in]: compute configuration of the pipeline
+ * @max_buffers [in]: largest number of rotating buffers
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t measure_pipeline(struct pipeline_sample_state *state,
+				     struct pe_pipeline_cfg *cfg,
+				     struct pipeline_compute *compute,
+				     uint32_t max_buffers)
+{
+	struct pe_pipeline_stats serial, pipelined;
+	uint64_t copy_ns;
+	double hidden;
+	doca_error_t status;
+	uint32_t i, num_buffers;
+
+	/* Copy and compute serially without compute, the stall time is the copy time */
+	cfg->num_buffers = 1;
+	compute->compute_ns = 0;
+	status = run_dma_pipeline(&state->base, state->dma, cfg, &serial);
+	if (status != DOCA_SUCCESS)
+		return status;
+	copy_ns = serial.stall_ns / cfg->num_chunks;
+	DOCA_LOG_INFO("Copy time of a %zu byte chunk: %.2f us", cfg->chunk_size, copy_ns / 1e3);
+
+	for (i = 0; i < sizeof(compute_percents) / sizeof(compute_percents[0]); i++) {
+		compute->compute_ns = copy_ns * compute_percents[i] / 100;
+
+		cfg->num_buffers = 1;
+		status = run_dma_pipeline(&state->base, state->dma, cfg, &serial);
+		if (status != DOCA_SUCCESS)
+			return status;
+		DOCA_LOG_INFO("Compute %8.2f us per chunk (%3u%% of the copy): serial %9.3f ms",
+			      compute->compute_ns / 1e3,
+			      compute_percents[i],
+			      serial.total_ns / 1e6);
+
+		for (num_buffers = 2; num_buffers <= max_buffers; num_buffers++) {
+			cfg->num_buffers = num_buffers;
+			status = run_dma_pipeline(&state->base, state->dma, cfg, &pipelined);
+			if (status != DOCA_SUCCESS)
+				return status;
+
+			/* The copy time that is still waited for, relative to the serial run */
+			hidden = 0;
+			if (serial.stall_ns > 0 && pipelined.stall_ns < serial.stall_ns)
+				hidden = 100.0 * (serial.stall_ns - pipelined.stall_ns) / serial.stall_ns;
+
+			DOCA_LOG_INFO("    %u buffers: %9.3f ms, %5.1f%% of the copy time hidden, %.2fx serial",
+				      num_buffers,
+				      pipelined.total_ns / 1e6,
+				      hidden,
+				      pipelined.total_ns > 0 ? (double)serial.total_ns / pipelined.total_ns : 0);
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the pipeline sample
+ *
+ * @chunk_size [in]: size of the chunk copied per DMA task
+ * @num_chunks [in]: number of chunks copied and computed per run
+ * @max_buffers [in]: largest number of rotating buffers to measure
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t run_pe_pipeline_sample(uint32_t chunk_size, uint32_t num_chunks, uint32_t max_buffers)
+{
+	struct pipeline_sample_state state = {0};
+	struct pipeline_compute compute = {0};
+	struct pe_pipeline_cfg cfg = {0};
+	const size_t src_size = (size_t)num_chunks * chunk_size;
+	doca_error_t status;
+	uint32_t i;
+
+	/* The source, followed by the rotating buffers */
+	state.base.buffer_size = src_size + (size_t)max_buffers * chunk_size;
+	/* A source and a destination per rotating buffer */
+	state.base.buf_inventory_size = 2 * max_buffers;
+
+	status = allocate_buffer(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	/* Initialize the data outside of the measured runs */
+	for (i = 0; i < num_chunks; i++)
+		memset(state.base.buffer + (size_t)i * chunk_size, chunk_value(i), chunk_size);
+	memset(state.base.buffer + src_size, 0, (size_t)max_buffers * chunk_size);
+
+	status = open_device(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_mmap(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_buf_inventory(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_pe(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_pipeline_dma(&state, chunk_size, max_buffers);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	cfg.src = state.base.buffer;
+	cfg.dst = state.base.buffer + src_size;
+	cfg.chunk_size = chunk_size;
+	cfg.num_chunks = num_chunks;
+	cfg.compute_cb = compute_chunk;
+	cfg.user_data = &compute;
+
+	status = measure_pipeline(&state, &cfg, &compute, max_buffers);
+
+cleanup:
+	pipeline_sample_cleanup(&state);
+
+	return status;
+}
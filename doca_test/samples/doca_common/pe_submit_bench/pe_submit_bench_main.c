@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <doca_argp.h>
+#include <doca_error.h>
+#include <doca_log.h>
+
+DOCA_LOG_REGISTER(PE_SUBMIT_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t run_pe_submit_bench(uint32_t num_tasks, uint32_t duration_sec);
+
+#define DEFAULT_NUM_TASKS (64)	 /* Default number of tasks submitted per round */
+#define MAX_NUM_TASKS (4096)	 /* Largest number of tasks submitted per round */
+#define DEFAULT_DURATION_SEC (1) /* Default duration of every measurement */
+#define MAX_DURATION_SEC (60)	 /* Longest duration of every measurement */
+
+/* Sample configuration */
+struct pe_submit_bench_config {
+	uint32_t num_tasks;    /* Number of tasks submitted per round */
+	uint32_t duration_sec; /* Duration of every measurement */
+};
+
+/*
+ * ARGP Callback - Handle number of tasks parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_tasks_callback(void *param, void *config)
+{
+	struct pe_submit_bench_config *cfg = (struct pe_submit_bench_config *)config;
+	const int num_tasks = *(int *)param;
+
+	if (num_tasks <= 0 || num_tasks > MAX_NUM_TASKS) {
+		DOCA_LOG_ERR("Number of tasks must be between 1 and %d", MAX_NUM_TASKS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->num_tasks = (uint32_t)num_tasks;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t duration_callback(void *param, void *config)
+{
+	struct pe_submit_bench_config *cfg = (struct pe_submit_bench_config *)config;
+	const int duration = *(int *)param;
+
+	if (duration <= 0 || duration > MAX_DURATION_SEC) {
+		DOCA_LOG_ERR("Duration must be between 1 and %d seconds", MAX_DURATION_SEC);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->duration_sec = (uint32_t)duration;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the benchmark parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_pe_submit_bench_params(void)
+{
+	struct doca_argp_param *num_tasks_param, *duration_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&num_tasks_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(num_tasks_param, "n");
+	doca_argp_param_set_long_name(num_tasks_param, "num-tasks");
+	doca_argp_param_set_arguments(num_tasks_param, "<num>");
+	doca_argp_param_set_description(num_tasks_param, "Number of tasks submitted per round (optional)");
+	doca_argp_param_set_callback(num_tasks_param, num_tasks_callback);
+	doca_argp_param_set_type(num_tasks_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(num_tasks_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&duration_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(duration_param, "d");
+	doca_argp_param_set_long_name(duration_param, "duration");
+	doca_argp_param_set_arguments(duration_param, "<seconds>");
+	doca_argp_param_set_description(duration_param, "Duration of every measurement in seconds (optional)");
+	doca_argp_param_set_callback(duration_param, duration_callback);
+	doca_argp_param_set_type(duration_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(duration_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct pe_submit_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	cfg.num_tasks = DEFAULT_NUM_TASKS;
+	cfg.duration_sec = DEFAULT_DURATION_SEC;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_pe_submit_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register benchmark params */
+	result = register_pe_submit_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Run the sample's core function */
+	result = run_pe_submit_bench(cfg.num_tasks, cfg.duration_sec);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("run_pe_submit_bench() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
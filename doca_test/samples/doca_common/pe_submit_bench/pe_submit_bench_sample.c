@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <doca_buf.h>
+#include <doca_ctx.h>
+#include <doca_pe.h>
+#include <doca_dma.h>
+#include <doca_types.h>
+#include <doca_log.h>
+
+#include <samples/common.h>
+#include <bench_common.h>
+#include "pe_common.h"
+
+DOCA_LOG_REGISTER(PE_SUBMIT_BENCH::SAMPLE);
+
+/**
+ * This sample measures the submit side of small DMA copies.
+ *
+ * Every round submits the same group of tasks and polls until all of them completed. The group is submitted either
+ * with doca_task_submit() per task, which flushes every task to the HW on its own, or in batches in which only the
+ * last task is submitted with DOCA_TASK_SUBMIT_FLAG_FLUSH (@see submit_dma_tasks_batched). The sample reports the
+ * time spent in the submit call per task and the message rate of the rounds. The cycles per task are an estimate,
+ * the time multiplied by the nominal maximum frequency of the CPU, not a cycle count: they are off whenever the CPU
+ * runs at another frequency.
+ */
+
+#define MIN_MSG_SIZE (64)	  /* Smallest copy size */
+#define MAX_MSG_SIZE (4096)	  /* Largest copy size */
+#define MIN_BATCH_SIZE (4)	  /* Smallest batch after the per task loop, every next one is 4 times larger */
+#define VERIFY_LINES_PER_TASK (2) /* Random cache lines checked per task after every measurement */
+
+/**
+ * This struct defines the program context.
+ */
+struct submit_bench_state {
+	struct pe_sample_state_base base;
+
+	struct doca_dma *dma;
+	struct doca_ctx *dma_ctx;
+	bool dma_started;
+
+	doca_error_t task_result; /* First task failure */
+};
+
+/* Result of one measurement */
+struct submit_bench_result {
+	uint64_t num_tasks; /* Completed tasks */
+	uint64_t submit_ns; /* Time spent in the submit call */
+	uint64_t total_ns;  /* Duration of the measurement */
+};
+
+/*
+ * DMA memcpy task completion callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void submit_bench_completed_callback(struct doca_dma_task_memcpy *dma_task,
+					    union doca_data task_user_data,
+					    union doca_data ctx_user_data)
+{
+	struct submit_bench_state *state = (struct submit_bench_state *)ctx_user_data.ptr;
+
+	(void)dma_task;
+	(void)task_user_data;
+
+	state->base.num_completed_tasks++;
+}
+
+/*
+ * DMA memcpy task error callback
+ *
+ * @dma_task [in]: Failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void submit_bench_error_callback(struct doca_dma_task_memcpy *dma_task,
+					union doca_data task_user_data,
+					union doca_data ctx_user_data)
+{
+	struct submit_bench_state *state = (struct submit_bench_state *)ctx_user_data.ptr;
+
+	(void)task_user_data;
+
+	if (state->task_result == DOCA_SUCCESS)
+		state->task_result = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+	state->base.num_completed_tasks++;
+}
+
+/*
+ * Create the DMA context, connect it to the PE and start it
+ *
+ * @state [in]: sample state
+ * @num_tasks [in]: number of tasks submitted per round
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t create_submit_bench_dma(struct submit_bench_state *state, uint32_t num_tasks)
+{
+	union doca_data ctx_user_data = {0};
+	doca_error_t status;
+
+	status = doca_dma_create(state->base.device, &state->dma);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context: %s", doca_error_get_descr(status));
+		return status;
+	}
+	state->dma_ctx = doca_dma_as_ctx(state->dma);
+
+	status = doca_pe_connect_ctx(state->base.pe, state->dma_ctx);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect DMA context to the PE: %s", doca_error_get_descr(status));
+		return status;
+	}
+
+	status = doca_dma_task_memcpy_set_conf(state->dma,
+					       submit_bench_completed_callback,
+					       submit_bench_error_callback,
+					       num_tasks);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DMA memcpy task configuration: %s", doca_error_get_descr(status));
+		return status;
+	}
+
+	ctx_user_data.ptr = state;
+	status = doca_ctx_set_user_data(state->dma_ctx, ctx_user_data);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DMA context user data: %s", doca_error_get_descr(status));
+		return status;
+	}
+
+	status = doca_ctx_start(state->dma_ctx);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(status));
+		return status;
+	}
+	state->dma_started = true;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Destroy the DMA context and the base resources
+ *
+ * @state [in]: sample state
+ */
+static void submit_bench_cleanup(struct submit_bench_state *state)
+{
+	if (state->dma_started)
+		(void)doca_ctx_stop(state->dma_ctx);
+
+	if (state->dma != NULL)
+		(void)doca_dma_destroy(state->dma);
+
+	pe_sample_base_cleanup(&state->base);
+}
+
+/*
+ * Free the tasks of a message size, and give their memory back to the state buffer
+ *
+ * @state [in]: sample state
+ * @tasks [in]: tasks, freed entries are set to NULL
+ * @num_tasks [in]: number of tasks
+ */
+static void free_submit_bench_tasks(struct submit_bench_state *state,
+				    struct doca_dma_task_memcpy **tasks,
+				    uint32_t num_tasks)
+{
+	uint32_t i;
+
+	for (i = 0; i < num_tasks; i++) {
+		if (tasks[i] == NULL)
+			continue;
+		(void)dma_task_free(tasks[i]);
+		tasks[i] = NULL;
+	}
+	state->base.available_buffer = state->base.buffer;
+}
+
+/*
+ * Submit the tasks round after round for a duration
+ *
+ * @state [in]: sample state
+ * @tasks [in]: tasks to submit every round
+ * @num_tasks [in]: number of tasks
+ * @batch_size [in]: number of tasks per flush, 1 submits every task with doca_task_submit()
+ * @duration_ns [in]: duration of the measurement
+ * @result [out]: measurement result
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t measure_submit(struct submit_bench_state *state,
+				  struct doca_dma_task_memcpy **tasks,
+				  uint32_t num_tasks,
+				  uint32_t batch_size,
+				  uint64_t duration_ns,
+				  struct submit_bench_result *result)
+{
+	uint64_t start, submit_start;
+	size_t num_inflight;
+	doca_error_t status;
+	uint32_t i;
+
+	result->num_tasks = 0;
+	result->submit_ns = 0;
+	start = bench_get_time_ns();
+
+	do {
+		/* The destinations are filled by the previous round, the copies append to their data */
+		for (i = 0; i < num_tasks; i++)
+			(void)doca_buf_reset_data_len(doca_dma_task_memcpy_get_dst(tasks[i]));
+		state->base.num_completed_tasks = 0;
+
+		submit_start = bench_get_time_ns();
+		status = submit_dma_tasks_batched(state->dma, num_tasks, batch_size, tasks);
+		result->submit_ns += bench_get_time_ns() - submit_start;
+		if (status != DOCA_SUCCESS) {
+			/* Drain the tasks that made it in before they are freed */
+			do {
+				(void)doca_pe_progress(state->base.pe);
+				(void)doca_pe_get_num_inflight_tasks(state->base.pe, &num_inflight);
+			} while (num_inflight > 0);
+			return status;
+		}
+
+		while (state->base.num_completed_tasks < num_tasks)
+			(void)doca_pe_progress(state->base.pe);
+
+		if (state->task_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("DMA memcpy task failed: %s", doca_error_get_descr(state->task_result));
+			return state->task_result;
+		}
+		result->num_tasks += num_tasks;
+		result->total_ns = bench_get_time_ns() - start;
+	} while (result->total_ns < duration_ns);
+
+	/* Outside of the timed region */
+	for (i = 0; i < num_tasks; i++) {
+		status = verify_dma_memcpy_task_sampled(tasks[i], (uint8_t)(i + 1), VERIFY_LINES_PER_TASK);
+		if (status != DOCA_SUCCESS)
+			return status;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the submit benchmark
+ *
+ * @num_tasks [in]: number of tasks submitted per round
+ * @duration_sec [in]: duration of every measurement
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t run_pe_submit_bench(uint32_t num_tasks, uint32_t duration_sec)
+{
+	struct submit_bench_state state = {0};
+	struct submit_bench_result loop, batched;
+	struct doca_dma_task_memcpy **tasks;
+	const uint64_t duration_ns = duration_sec * BENCH_NSEC_PER_SEC;
+	uint64_t cpu_khz = 0;
+	double loop_ns, batched_ns;
+	uint32_t msg_size, batch_size;
+	int cpu;
+	doca_error_t status;
+
+	tasks = (struct doca_dma_task_memcpy **)calloc(num_tasks, sizeof(*tasks));
+	if (tasks == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the task array");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	/* A source and a destination per task, at the largest message size */
+	state.base.buffer_size = 2 * (size_t)num_tasks * MAX_MSG_SIZE;
+	state.base.buf_inventory_size = 2 * num_tasks;
+
+	/* Stay on one CPU so that the cycle estimate uses the nominal frequency of the CPU that submits */
+	cpu = sched_getcpu();
+	if (cpu >= 0 && bench_pin_thread_to_cpu(cpu) == DOCA_SUCCESS)
+		cpu_khz = bench_get_cpu_max_khz(cpu);
+	if (cpu_khz == 0)
+		DOCA_LOG_WARN("CPU frequency is unknown, only the time per task is reported");
+
+	status = allocate_buffer(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = open_device(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_mmap(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_buf_inventory(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_pe(&state.base);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	status = create_submit_bench_dma(&state, num_tasks);
+	if (status != DOCA_SUCCESS)
+		goto cleanup;
+
+	DOCA_LOG_INFO("%u tasks per round, submit cost and message rate of per task submits -> batched submits",
+		      num_tasks);
+
+	for (msg_size = MIN_MSG_SIZE; msg_size <= MAX_MSG_SIZE; msg_size *= 2) {
+		status = allocate_dma_tasks(&state.base, state.dma, num_tasks, msg_size, tasks);
+		if (status != DOCA_SUCCESS)
+			goto free_tasks;
+		status = init_dma_task_buffers(num_tasks, tasks);
+		if (status != DOCA_SUCCESS)
+			goto free_tasks;
+
+		status = measure_submit(&state, tasks, num_tasks, 1, duration_ns, &loop);
+		if (status != DOCA_SUCCESS)
+			goto free_tasks;
+
+		/* A group smaller than the first batch is submitted as a single batch */
+		batch_size = num_tasks < MIN_BATCH_SIZE ? num_tasks : MIN_BATCH_SIZE;
+		for (; batch_size < num_tasks * 4; batch_size *= 4) {
+			/* The last batch size flushes once per round */
+			if (batch_size > num_tasks)
+				batch_size = num_tasks;
+
+			status = measure_submit(&state, tasks, num_tasks, batch_size, duration_ns, &batched);
+			if (status != DOCA_SUCCESS)
+				goto free_tasks;
+
+			loop_ns = (double)loop.submit_ns / loop.num_tasks;
+			batched_ns = (double)batched.submit_ns / batched.num_tasks;
+			if (cpu_khz != 0)
+				DOCA_LOG_INFO("%4u B, batch %4u: %6.1f -> %6.1f ns/task, "
+					      "%5.0f -> %5.0f est. cycles/task, %6.3f -> %6.3f Mtasks/s",
+					      msg_size,
+					      batch_size,
+					      loop_ns,
+					      batched_ns,
+					      loop_ns * cpu_khz / 1e6,
+					      batched_ns * cpu_khz / 1e6,
+					      loop.num_tasks * 1e3 / loop.total_ns,
+					      batched.num_tasks * 1e3 / batched.total_ns);
+			else
+				DOCA_LOG_INFO("%4u B, batch %4u: %6.1f -> %6.1f ns/task, %6.3f -> %6.3f Mtasks/s",
+					      msg_size,
+					      batch_size,
+					      loop_ns,
+					      batched_ns,
+					      loop.num_tasks * 1e3 / loop.total_ns,
+					      batched.num_tasks * 1e3 / batched.total_ns);
+			if (batch_size == num_tasks)
+				break;
+		}
+
+		free_submit_bench_tasks(&state, tasks, num_tasks);
+	}
+
+free_tasks:
+	free_submit_bench_tasks(&state, tasks, num_tasks);
+cleanup:
+	submit_bench_cleanup(&state);
+	free(tasks);
+
+	return status;
+}
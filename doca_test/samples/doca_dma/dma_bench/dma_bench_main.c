@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "dma_bench_common.h"
+
+DOCA_LOG_REGISTER(DMA_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t dma_bench(struct dma_bench_config *cfg,
+		       uint64_t max_size,
+		       uint32_t size_factor,
+		       uint32_t num_ctxs,
+		       uint32_t num_threads);
+
+#define DEFAULT_MIN_SIZE (64)	    /* Default smallest copy size */
+#define DEFAULT_MAX_SIZE (1U << 30) /* Default largest copy size, 1 GB */
+#define DEFAULT_SIZE_FACTOR (2)	    /* Default ratio between two consecutive copy sizes */
+#define DEFAULT_DURATION_SEC (1)    /* Default duration of every point, the sweep has three per size */
+#define MAX_SIZE_FACTOR (16)	    /* Largest ratio between two consecutive copy sizes */
+#define MAX_THREADS (64)	    /* Most worker threads */
+#define MAX_CTXS (256)		    /* Most DMA contexts */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct dma_sweep_config {
+	struct dma_bench_config bench; /* Benchmark configuration, msg_size is the smallest copy size */
+	uint64_t max_size;	       /* Largest copy size */
+	uint32_t size_factor;	       /* Ratio between two consecutive copy sizes */
+	uint32_t num_ctxs;	       /* Number of DMA contexts */
+	uint32_t num_threads;	       /* Number of threads */
+};
+
+/*
+ * ARGP Callback - Handle largest copy size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t max_size_callback(void *param, void *config)
+{
+	struct dma_sweep_config *cfg = (struct dma_sweep_config *)config;
+	const int max_size = *(int *)param;
+
+	if (max_size <= 0 || (uint64_t)max_size > DEFAULT_MAX_SIZE) {
+		DOCA_LOG_ERR("Largest copy size must be between 1 and %u bytes", DEFAULT_MAX_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->max_size = (uint64_t)max_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle size factor parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t size_factor_callback(void *param, void *config)
+{
+	struct dma_sweep_config *cfg = (struct dma_sweep_config *)config;
+	const int size_factor = *(int *)param;
+
+	if (size_factor < 2 || size_factor > MAX_SIZE_FACTOR) {
+		DOCA_LOG_ERR("Size factor must be between 2 and %d", MAX_SIZE_FACTOR);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->size_factor = (uint32_t)size_factor;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of DMA contexts parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_ctxs_callback(void *param, void *config)
+{
+	struct dma_sweep_config *cfg = (struct dma_sweep_config *)config;
+	const int num_ctxs = *(int *)param;
+
+	if (num_ctxs <= 0 || num_ctxs > MAX_CTXS) {
+		DOCA_LOG_ERR("Number of DMA contexts must be between 1 and %d", MAX_CTXS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->num_ctxs = (uint32_t)num_ctxs;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of threads parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_threads_callback(void *param, void *config)
+{
+	struct dma_sweep_config *cfg = (struct dma_sweep_config *)config;
+	const int num_threads = *(int *)param;
+
+	if (num_threads <= 0 || num_threads > MAX_THREADS) {
+		DOCA_LOG_ERR("Number of threads must be between 1 and %d", MAX_THREADS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->num_threads = (uint32_t)num_threads;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Create and register a single ARGP param
+ *
+ * @short_name [in]: param short name
+ * @long_name [in]: param long name
+ * @arguments [in]: param arguments description
+ * @description [in]: param description
+ * @callback [in]: param callback
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_int_param(const char *short_name,
+				       const char *long_name,
+				       const char *arguments,
+				       const char *description,
+				       doca_argp_param_cb_t callback)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	doca_argp_param_set_arguments(param, arguments);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the sweep parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_sweep_params(void)
+{
+	doca_error_t result;
+
+	result = register_int_param("mx",
+				    "max-size",
+				    "<bytes>",
+				    "Largest copy size, the sweep starts at --msg-size (optional)",
+				    max_size_callback);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_int_param("sf",
+				    "size-factor",
+				    "<num>",
+				    "Ratio between two consecutive copy sizes (optional)",
+				    size_factor_callback);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_int_param("nc",
+				    "num-ctxs",
+				    "<num>",
+				    "Number of DMA contexts, spread over the threads (optional)",
+				    num_ctxs_callback);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return register_int_param("nt",
+				  "num-threads",
+				  "<num>",
+				  "Number of threads, each with its own PE, also used for the CPU copies (optional)",
+				  num_threads_callback);
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct dma_sweep_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_dma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = DEFAULT_MIN_SIZE;
+	cfg.bench.duration_sec = DEFAULT_DURATION_SEC;
+	cfg.max_size = DEFAULT_MAX_SIZE;
+	cfg.size_factor = DEFAULT_SIZE_FACTOR;
+	cfg.num_ctxs = 1;
+	cfg.num_threads = 1;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_dma_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register benchmark params */
+	result = register_dma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register sweep params */
+	result = register_sweep_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sweep parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = dma_bench(&cfg.bench, cfg.max_size, cfg.size_factor, cfg.num_ctxs, cfg.num_threads);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,932 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "bench_common.h"
+#include "cpu_copy.h"
+#include "dma_bench_common.h"
+#include "dma_bulk_copy.h"
+#include "latency_hist.h"
+
+DOCA_LOG_REGISTER(DMA_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024)			     /* PE progress calls between two deadline checks */
+#define MMAP_PERMISSIONS (DOCA_ACCESS_FLAG_LOCAL_READ_WRITE) /* Access flags of the source and destination */
+#define SLOT_ALIGN (64)					     /* Alignment of the copy slots, a cache line */
+#define MAX_INFLIGHT_BYTES (256ULL << 20)		     /* Most bytes a worker keeps in flight at once */
+#define MIN_COPIES (16)					     /* Fewest copies a worker completes per point */
+#define CPU_BATCH_BYTES (65536)				     /* Bytes copied by the CPU between two timestamps */
+#define MAX_SWEEP_POINTS (64)				     /* Most sizes a sweep measures */
+
+/* What copies the data */
+enum sweep_mode {
+	SWEEP_MODE_DMA,	       /* DMA engine memcpy tasks */
+	SWEEP_MODE_CPU_MEMCPY, /* CPU memcpy */
+	SWEEP_MODE_CPU_NT,     /* CPU non-temporal stores */
+	SWEEP_NUM_MODES,
+};
+
+/* Result of one mode at one size */
+struct sweep_result {
+	double gbps;		  /* Throughput in GB/s */
+	struct latency_hist hist; /* Latency of every copy */
+};
+
+struct sweep_bench;
+struct sweep_worker;
+
+/* A slot of a worker, the user data of the bulk copies */
+struct sweep_slot {
+	struct sweep_worker *worker; /* Worker of the slot */
+	uint32_t index;		     /* Slot index */
+};
+
+/* A thread with its own PE, DMA contexts and memory */
+struct sweep_worker {
+	struct sweep_bench *bench;	      /* Benchmark state */
+	pthread_t thread;		      /* Thread measuring the current point */
+	uint32_t num_ctxs;		      /* Number of DMA contexts of the worker */
+	struct doca_pe *pe;		      /* Progress engine of the contexts */
+	struct doca_dma **dmas;		      /* DMA contexts */
+	struct doca_buf_inventory *inventory; /* Inventory for the task buffers */
+	char *src_region;		      /* Sources of the copies */
+	char *dst_region;		      /* Destinations of the copies */
+	struct doca_mmap *src_mmap;	      /* Registration of the sources */
+	struct doca_mmap *dst_mmap;	      /* Registration of the destinations */
+	struct doca_dma_task_memcpy **tasks;  /* Memcpy tasks, num_ctxs * queue depth */
+	struct dma_bulk_copy *copier;	      /* Segmenting copier, NULL when no copy exceeds a task */
+	struct sweep_slot *slots;	      /* Slots of the bulk copies */
+	uint64_t *submit_ns;		      /* Submission time of every task */
+	uint32_t num_inflight;		      /* Number of submitted tasks that have not completed yet */
+	bool running;			      /* Whether completed tasks should be resubmitted */
+	uint64_t completed_ops;		      /* Number of copies completed in the timed window */
+	uint64_t start_ns;		      /* Start of the timed window */
+	uint64_t end_ns;		      /* End of the timed window */
+	struct latency_hist hist;	      /* Latency of the copies in the timed window */
+	doca_error_t result;		      /* First error encountered by the worker */
+};
+
+/* Benchmark state */
+struct sweep_bench {
+	struct dma_bench_config *cfg; /* Benchmark configuration */
+	struct doca_dev *dev;	      /* DOCA device */
+	uint64_t max_buf_size;	      /* Largest memcpy task the device accepts */
+	uint64_t max_size;	      /* Largest copy size of the sweep */
+	size_t region_size;	      /* Size of the source and of the destination region of a worker */
+	uint32_t num_workers;	      /* Number of worker threads */
+	struct sweep_worker *workers; /* Worker threads */
+	enum sweep_mode mode;	      /* Mode of the current point */
+	uint64_t size;		      /* Copy size of the current point */
+	uint64_t stride;	      /* Distance between two slots of the current point */
+	uint32_t num_positions;	      /* Number of slots the regions hold at the current point */
+	uint32_t depth;		      /* Outstanding tasks of every context at the current point */
+};
+
+/*
+ * Get the offset of a slot in the source and destination regions
+ * Slots wrap around when the regions can't hold all of them, concurrent copies to the same destination are fine for
+ * a benchmark
+ *
+ * @bench [in]: benchmark state
+ * @slot [in]: slot index
+ * @return: offset in bytes
+ */
+static inline size_t slot_offset(const struct sweep_bench *bench, uint32_t slot)
+{
+	return (size_t)(slot % bench->num_positions) * bench->stride;
+}
+
+/*
+ * Release a memcpy task and its buffers
+ *
+ * @worker [in]: worker
+ * @task_idx [in]: task index
+ */
+static void release_copy_task(struct sweep_worker *worker, uint32_t task_idx)
+{
+	struct doca_dma_task_memcpy *task = worker->tasks[task_idx];
+	struct doca_buf *src_buf, *dst_buf;
+
+	if (task == NULL)
+		return;
+
+	src_buf = (struct doca_buf *)doca_dma_task_memcpy_get_src(task);
+	dst_buf = doca_dma_task_memcpy_get_dst(task);
+	doca_task_free(doca_dma_task_memcpy_as_task(task));
+	if (src_buf != NULL)
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+	if (dst_buf != NULL)
+		(void)doca_buf_dec_refcount(dst_buf, NULL);
+	worker->tasks[task_idx] = NULL;
+}
+
+/*
+ * DMA memcpy task completed callback, records the latency and resubmits the task on the same slot while the run is
+ * active
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void sweep_copy_completed_callback(struct doca_dma_task_memcpy *dma_task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	struct sweep_worker *worker = (struct sweep_worker *)ctx_user_data.ptr;
+	uint32_t task_idx = (uint32_t)task_user_data.u64;
+	uint64_t now_ns;
+	doca_error_t result;
+
+	/* Copies that complete while draining are outside of the timed window */
+	if (!worker->running) {
+		worker->num_inflight--;
+		return;
+	}
+
+	now_ns = bench_get_time_ns();
+	latency_hist_record(&worker->hist, now_ns - worker->submit_ns[task_idx]);
+	worker->completed_ops++;
+
+	worker->submit_ns[task_idx] = now_ns;
+	result = doca_task_submit(doca_dma_task_memcpy_as_task(dma_task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to resubmit DMA memcpy task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(worker->result, result);
+		worker->running = false;
+		worker->num_inflight--;
+	}
+}
+
+/*
+ * DMA memcpy task error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void sweep_copy_error_callback(struct doca_dma_task_memcpy *dma_task,
+				      union doca_data task_user_data,
+				      union doca_data ctx_user_data)
+{
+	struct sweep_worker *worker = (struct sweep_worker *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+
+	(void)task_user_data;
+
+	DOCA_LOG_ERR("DMA memcpy task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(worker->result, result);
+	worker->running = false;
+	worker->num_inflight--;
+}
+
+/*
+ * Register a region with a started mmap
+ *
+ * @dev [in]: DOCA device
+ * @region [in]: region start
+ * @len [in]: region length
+ * @mmap [out]: started mmap
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_region(struct doca_dev *dev, char *region, size_t len, struct doca_mmap **mmap)
+{
+	doca_error_t result;
+
+	result = doca_mmap_create(mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_set_permissions(*mmap, MMAP_PERMISSIONS);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(*mmap, region, len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(*mmap, dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(*mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register a region of %zu bytes: %s", len, doca_error_get_descr(result));
+		(void)doca_mmap_destroy(*mmap);
+		*mmap = NULL;
+	}
+
+	return result;
+}
+
+/*
+ * Allocate the tasks of the current point, each on its own slot
+ *
+ * @worker [in]: worker
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_tasks(struct sweep_worker *worker)
+{
+	struct sweep_bench *bench = worker->bench;
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf, *dst_buf;
+	uint32_t ctx_idx, i, task_idx;
+	size_t offset;
+	doca_error_t result;
+
+	for (ctx_idx = 0; ctx_idx < worker->num_ctxs; ctx_idx++) {
+		for (i = 0; i < bench->depth; i++) {
+			task_idx = ctx_idx * bench->depth + i;
+			offset = slot_offset(bench, task_idx);
+
+			result = doca_buf_inventory_buf_get_by_data(worker->inventory,
+								    worker->src_mmap,
+								    worker->src_region + offset,
+								    bench->size,
+								    &src_buf);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to allocate source buffer: %s", doca_error_get_descr(result));
+				return result;
+			}
+
+			result = doca_buf_inventory_buf_get_by_addr(worker->inventory,
+								    worker->dst_mmap,
+								    worker->dst_region + offset,
+								    bench->size,
+								    &dst_buf);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to allocate destination buffer: %s", doca_error_get_descr(result));
+				(void)doca_buf_dec_refcount(src_buf, NULL);
+				return result;
+			}
+
+			task_user_data.u64 = task_idx;
+			result = doca_dma_task_memcpy_alloc_init(worker->dmas[ctx_idx],
+								 src_buf,
+								 dst_buf,
+								 task_user_data,
+								 &worker->tasks[task_idx]);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+				(void)doca_buf_dec_refcount(dst_buf, NULL);
+				(void)doca_buf_dec_refcount(src_buf, NULL);
+				return result;
+			}
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Keep depth copies in flight on every context of a worker for the configured duration
+ *
+ * @worker [in]: worker, the tasks are prepared
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_dma_copies(struct sweep_worker *worker)
+{
+	struct sweep_bench *bench = worker->bench;
+	uint32_t num_tasks = worker->num_ctxs * bench->depth;
+	uint64_t deadline_ns, num_polls = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	worker->running = true;
+	worker->start_ns = bench_get_time_ns();
+	deadline_ns = worker->start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < num_tasks; i++) {
+		worker->submit_ns[i] = bench_get_time_ns();
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(worker->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA memcpy task: %s", doca_error_get_descr(result));
+			worker->running = false;
+			break;
+		}
+		worker->num_inflight++;
+	}
+
+	while (worker->running) {
+		(void)doca_pe_progress(worker->pe);
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && worker->completed_ops >= MIN_COPIES &&
+		    bench_get_time_ns() >= deadline_ns)
+			worker->running = false;
+	}
+	worker->end_ns = bench_get_time_ns();
+
+	/* Drain, the tasks stay allocated until the point is over */
+	while (worker->num_inflight > 0)
+		(void)doca_pe_progress(worker->pe);
+
+	return result;
+}
+
+/*
+ * Bulk copy completion callback, records the latency and copies the same slot again while the run is active
+ *
+ * @status [in]: status of the copy
+ * @user_data [in]: slot of the copy
+ */
+static void sweep_bulk_copy_done_callback(doca_error_t status, void *user_data)
+{
+	struct sweep_slot *slot = (struct sweep_slot *)user_data;
+	struct sweep_worker *worker = slot->worker;
+	struct sweep_bench *bench = worker->bench;
+	size_t offset = slot_offset(bench, slot->index);
+	uint64_t now_ns;
+
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("DMA bulk copy failed: %s", doca_error_get_descr(status));
+		DOCA_ERROR_PROPAGATE(worker->result, status);
+		worker->running = false;
+	}
+
+	if (!worker->running) {
+		worker->num_inflight--;
+		return;
+	}
+
+	now_ns = bench_get_time_ns();
+	latency_hist_record(&worker->hist, now_ns - worker->submit_ns[slot->index]);
+	worker->completed_ops++;
+
+	worker->submit_ns[slot->index] = now_ns;
+	status = dma_bulk_copy_submit(worker->copier,
+				      worker->src_mmap,
+				      worker->src_region + offset,
+				      worker->dst_mmap,
+				      worker->dst_region + offset,
+				      bench->size,
+				      sweep_bulk_copy_done_callback,
+				      slot);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to resubmit DMA bulk copy: %s", doca_error_get_descr(status));
+		DOCA_ERROR_PROPAGATE(worker->result, status);
+		worker->running = false;
+		worker->num_inflight--;
+	}
+}
+
+/*
+ * Keep depth copies larger than a memcpy task in flight per context for the configured duration, every copy is split
+ * into segments that are all in flight together
+ *
+ * @worker [in]: worker
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_bulk_copies(struct sweep_worker *worker)
+{
+	struct sweep_bench *bench = worker->bench;
+	uint32_t num_slots = worker->num_ctxs * bench->depth;
+	uint64_t deadline_ns, num_polls = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	size_t offset;
+	uint32_t i;
+
+	worker->running = true;
+	worker->start_ns = bench_get_time_ns();
+	deadline_ns = worker->start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < num_slots; i++) {
+		offset = slot_offset(bench, i);
+		worker->submit_ns[i] = bench_get_time_ns();
+		result = dma_bulk_copy_submit(worker->copier,
+					      worker->src_mmap,
+					      worker->src_region + offset,
+					      worker->dst_mmap,
+					      worker->dst_region + offset,
+					      bench->size,
+					      sweep_bulk_copy_done_callback,
+					      &worker->slots[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA bulk copy: %s", doca_error_get_descr(result));
+			worker->running = false;
+			break;
+		}
+		worker->num_inflight++;
+	}
+
+	while (worker->running) {
+		(void)doca_pe_progress(worker->pe);
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && worker->completed_ops >= MIN_COPIES &&
+		    bench_get_time_ns() >= deadline_ns)
+			worker->running = false;
+	}
+	worker->end_ns = bench_get_time_ns();
+
+	while (worker->num_inflight > 0)
+		(void)doca_pe_progress(worker->pe);
+
+	DOCA_ERROR_PROPAGATE(result, worker->result);
+	return result;
+}
+
+/*
+ * Copy with the CPU over the same slots as the DMA tasks for the configured duration
+ * Copies are timed in batches of CPU_BATCH_BYTES, as reading the clock costs more than a small copy, and every batch
+ * records its mean copy latency
+ *
+ * @worker [in]: worker
+ * @method [in]: CPU copy method
+ */
+static void run_cpu_copies(struct sweep_worker *worker, enum cpu_copy_method method)
+{
+	struct sweep_bench *bench = worker->bench;
+	uint32_t num_slots = worker->num_ctxs * bench->depth;
+	uint32_t batch = bench->size >= CPU_BATCH_BYTES ? 1 : (uint32_t)(CPU_BATCH_BYTES / bench->size);
+	uint64_t deadline_ns, batch_start_ns, now_ns;
+	uint32_t slot = 0, i;
+	size_t offset;
+
+	worker->start_ns = bench_get_time_ns();
+	deadline_ns = worker->start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+	now_ns = worker->start_ns;
+
+	do {
+		batch_start_ns = now_ns;
+		for (i = 0; i < batch; i++) {
+			offset = slot_offset(bench, slot);
+			cpu_copy(method, worker->dst_region + offset, worker->src_region + offset, bench->size);
+			if (++slot == num_slots)
+				slot = 0;
+		}
+		now_ns = bench_get_time_ns();
+		latency_hist_record(&worker->hist, (now_ns - batch_start_ns) / batch);
+		worker->completed_ops += batch;
+	} while (now_ns < deadline_ns || worker->completed_ops < MIN_COPIES);
+
+	worker->end_ns = now_ns;
+}
+
+/*
+ * Measure the current point on a worker
+ *
+ * @worker [in]: worker
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_point(struct sweep_worker *worker)
+{
+	struct sweep_bench *bench = worker->bench;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	worker->completed_ops = 0;
+	latency_hist_init(&worker->hist);
+
+	switch (bench->mode) {
+	case SWEEP_MODE_DMA:
+		if (bench->size > bench->max_buf_size) {
+			result = run_bulk_copies(worker);
+			break;
+		}
+		result = prepare_tasks(worker);
+		if (result == DOCA_SUCCESS)
+			result = run_dma_copies(worker);
+		DOCA_ERROR_PROPAGATE(result, worker->result);
+		for (i = 0; i < worker->num_ctxs * bench->depth; i++)
+			release_copy_task(worker, i);
+		break;
+	case SWEEP_MODE_CPU_MEMCPY:
+		run_cpu_copies(worker, CPU_COPY_MEMCPY);
+		break;
+	case SWEEP_MODE_CPU_NT:
+		run_cpu_copies(worker, CPU_COPY_NT);
+		break;
+	default:
+		result = DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return result;
+}
+
+/*
+ * Worker thread, measures the current point
+ *
+ * @arg [in]: worker
+ * @return: NULL
+ */
+static void *sweep_worker_main(void *arg)
+{
+	struct sweep_worker *worker = (struct sweep_worker *)arg;
+	doca_error_t result;
+
+	result = run_point(worker);
+	DOCA_ERROR_PROPAGATE(worker->result, result);
+	return NULL;
+}
+
+/*
+ * Create the PE, DMA contexts, memory and inventory of a worker
+ *
+ * @bench [in]: benchmark state
+ * @worker [in/out]: worker, bench and num_ctxs set
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t setup_worker(struct sweep_bench *bench, struct sweep_worker *worker)
+{
+	uint32_t num_tasks = worker->num_ctxs * bench->cfg->queue_depth;
+	doca_error_t result;
+	uint32_t i;
+
+	worker->dmas = calloc(worker->num_ctxs, sizeof(*worker->dmas));
+	worker->tasks = calloc(num_tasks, sizeof(*worker->tasks));
+	worker->submit_ns = calloc(num_tasks, sizeof(*worker->submit_ns));
+	worker->slots = calloc(num_tasks, sizeof(*worker->slots));
+	if (worker->dmas == NULL || worker->tasks == NULL || worker->submit_ns == NULL || worker->slots == NULL) {
+		DOCA_LOG_ERR("Failed to allocate worker arrays of %u tasks", num_tasks);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	for (i = 0; i < num_tasks; i++) {
+		worker->slots[i].worker = worker;
+		worker->slots[i].index = i;
+	}
+
+	/* Faulted in here so that neither the DMA engine nor the CPU copies pay for it */
+	worker->src_region = bench_alloc_numa(bench->region_size, -1);
+	worker->dst_region = bench_alloc_numa(bench->region_size, -1);
+	if (worker->src_region == NULL || worker->dst_region == NULL) {
+		DOCA_LOG_ERR("Failed to allocate two regions of %zu bytes", bench->region_size);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = register_region(bench->dev, worker->src_region, bench->region_size, &worker->src_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_region(bench->dev, worker->dst_region, bench->region_size, &worker->dst_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_pe_create(&worker->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (i = 0; i < worker->num_ctxs; i++) {
+		result = dma_bench_ctx_create(bench->dev,
+					      worker->pe,
+					      bench->cfg->queue_depth,
+					      sweep_copy_completed_callback,
+					      sweep_copy_error_callback,
+					      worker,
+					      &worker->dmas[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	/* Copies above the device limit are segmented, with the same task budget as the contexts */
+	if (bench->max_size > bench->max_buf_size) {
+		result = dma_bulk_copy_create(bench->dev, worker->pe, num_tasks, 0, 0, &worker->copier);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	result = doca_buf_inventory_create(2 * num_tasks, &worker->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(worker->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Destroy whatever setup_worker() created, in reverse order
+ *
+ * @bench [in]: benchmark state
+ * @worker [in]: worker
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_worker(struct sweep_bench *bench, struct sweep_worker *worker)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint32_t i;
+
+	if (worker->inventory != NULL) {
+		tmp_result = doca_buf_inventory_stop(worker->inventory);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_buf_inventory_destroy(worker->inventory);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	tmp_result = dma_bulk_copy_destroy(worker->copier);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+
+	for (i = 0; worker->dmas != NULL && i < worker->num_ctxs; i++) {
+		tmp_result = dma_bench_ctx_destroy(worker->pe, worker->dmas[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	if (worker->pe != NULL) {
+		tmp_result = doca_pe_destroy(worker->pe);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (worker->dst_mmap != NULL) {
+		(void)doca_mmap_stop(worker->dst_mmap);
+		(void)doca_mmap_destroy(worker->dst_mmap);
+	}
+	if (worker->src_mmap != NULL) {
+		(void)doca_mmap_stop(worker->src_mmap);
+		(void)doca_mmap_destroy(worker->src_mmap);
+	}
+	bench_free_numa(worker->dst_region, bench->region_size);
+	bench_free_numa(worker->src_region, bench->region_size);
+
+	free(worker->slots);
+	free(worker->submit_ns);
+	free(worker->tasks);
+	free(worker->dmas);
+	return result;
+}
+
+/*
+ * Measure one mode at one size on all workers and gather their results
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: what copies the data
+ * @size [in]: copy size
+ * @res [out]: result of the point
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t measure_point(struct sweep_bench *bench,
+				  enum sweep_mode mode,
+				  uint64_t size,
+				  struct sweep_result *res)
+{
+	uint32_t i, num_started, max_ctxs = bench->workers[0].num_ctxs;
+	struct sweep_worker *worker;
+	doca_error_t result = DOCA_SUCCESS;
+	uint64_t inflight_depth;
+	int ret;
+
+	latency_hist_init(&res->hist);
+	res->gbps = 0.0;
+	/* Large copies keep fewer tasks in flight so that the first of them completes well within the duration */
+	inflight_depth = MAX_INFLIGHT_BYTES / (size * max_ctxs);
+	if (inflight_depth == 0)
+		inflight_depth = 1;
+	bench->depth = inflight_depth < bench->cfg->queue_depth ? (uint32_t)inflight_depth : bench->cfg->queue_depth;
+	bench->mode = mode;
+	bench->size = size;
+	bench->stride = (size + SLOT_ALIGN - 1) & ~(uint64_t)(SLOT_ALIGN - 1);
+	bench->num_positions = (uint32_t)(bench->region_size / bench->stride);
+
+	/* Every worker times its own window, so the thread start skew does not count */
+	for (num_started = 0; num_started < bench->num_workers; num_started++) {
+		worker = &bench->workers[num_started];
+		ret = pthread_create(&worker->thread, NULL, sweep_worker_main, worker);
+		if (ret != 0) {
+			DOCA_LOG_ERR("Failed to create worker thread: %s", strerror(ret));
+			result = DOCA_ERROR_OPERATING_SYSTEM;
+			break;
+		}
+	}
+
+	for (i = 0; i < num_started; i++) {
+		worker = &bench->workers[i];
+		pthread_join(worker->thread, NULL);
+		DOCA_ERROR_PROPAGATE(result, worker->result);
+		if (worker->end_ns > worker->start_ns)
+			res->gbps += (double)worker->completed_ops * (double)size /
+				     (double)(worker->end_ns - worker->start_ns);
+		latency_hist_merge(&res->hist, &worker->hist);
+	}
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Get the best CPU throughput of a point
+ *
+ * @results [in]: results of the point, one per mode
+ * @return: throughput in GB/s
+ */
+static double best_cpu_gbps(const struct sweep_result *results)
+{
+	return results[SWEEP_MODE_CPU_NT].gbps > results[SWEEP_MODE_CPU_MEMCPY].gbps ?
+		       results[SWEEP_MODE_CPU_NT].gbps :
+		       results[SWEEP_MODE_CPU_MEMCPY].gbps;
+}
+
+/*
+ * Print the tables of a sweep and the size from which the DMA engine beats the CPU
+ *
+ * @sizes [in]: copy sizes
+ * @results [in]: results, SWEEP_NUM_MODES per size
+ * @num_points [in]: number of sizes
+ */
+static void report_sweep(const uint64_t *sizes, const struct sweep_result *results, uint32_t num_points)
+{
+	static const char *const mode_names[SWEEP_NUM_MODES] = {"dma", "memcpy", "nt-store"};
+	const struct sweep_result *point, *res;
+	int32_t crossover = -1;
+	uint32_t i, mode;
+
+	DOCA_LOG_INFO("%s is %s", mode_names[SWEEP_MODE_CPU_NT], cpu_copy_method_name(CPU_COPY_NT));
+	DOCA_LOG_INFO("      bytes |   dma GB/s | memcpy GB/s | nt-store GB/s | dma vs best cpu");
+	for (i = 0; i < num_points; i++) {
+		point = &results[i * SWEEP_NUM_MODES];
+		DOCA_LOG_INFO("%11lu | %10.3f | %11.3f | %13.3f | %14.2fx",
+			      sizes[i],
+			      point[SWEEP_MODE_DMA].gbps,
+			      point[SWEEP_MODE_CPU_MEMCPY].gbps,
+			      point[SWEEP_MODE_CPU_NT].gbps,
+			      best_cpu_gbps(point) == 0.0 ? 0.0 : point[SWEEP_MODE_DMA].gbps / best_cpu_gbps(point));
+	}
+
+	DOCA_LOG_INFO("      bytes |     mode |    p50 us |    p99 us |  p99.9 us |    max us");
+	for (i = 0; i < num_points; i++) {
+		for (mode = 0; mode < SWEEP_NUM_MODES; mode++) {
+			res = &results[i * SWEEP_NUM_MODES + mode];
+			DOCA_LOG_INFO("%11lu | %8s | %9.3f | %9.3f | %9.3f | %9.3f",
+				      sizes[i],
+				      mode_names[mode],
+				      latency_hist_percentile(&res->hist, 50.0) / 1e3,
+				      latency_hist_percentile(&res->hist, 99.0) / 1e3,
+				      latency_hist_percentile(&res->hist, 99.9) / 1e3,
+				      res->hist.max / 1e3);
+		}
+	}
+
+	/* The smallest size from which the DMA engine is at least as fast as the CPU at every measured size */
+	for (i = num_points; i > 0; i--) {
+		point = &results[(i - 1) * SWEEP_NUM_MODES];
+		if (point[SWEEP_MODE_DMA].gbps < best_cpu_gbps(point))
+			break;
+		crossover = (int32_t)(i - 1);
+	}
+
+	if (crossover < 0)
+		DOCA_LOG_INFO("Crossover: the CPU copies faster than the DMA engine at every measured size");
+	else if (crossover == 0)
+		DOCA_LOG_INFO("Crossover: the DMA engine copies as fast as the CPU at every measured size");
+	else
+		DOCA_LOG_INFO("Crossover: offloading to the DMA engine beats the CPU from %lu bytes (%.2fx), "
+			      "the CPU wins at %lu bytes",
+			      sizes[crossover],
+			      results[crossover * SWEEP_NUM_MODES + SWEEP_MODE_DMA].gbps /
+				      best_cpu_gbps(&results[crossover * SWEEP_NUM_MODES]),
+			      sizes[crossover - 1]);
+}
+
+/*
+ * Sweep copy sizes and measure the DMA engine against CPU memcpy and non-temporal stores at each of them, with the
+ * same threads and over the same buffers
+ *
+ * @cfg [in]: Configuration parameters, msg_size is the smallest copy size
+ * @max_size [in]: largest copy size
+ * @size_factor [in]: ratio between two consecutive copy sizes
+ * @num_ctxs [in]: number of DMA contexts, spread over the threads
+ * @num_threads [in]: number of threads
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_bench(struct dma_bench_config *cfg,
+		       uint64_t max_size,
+		       uint32_t size_factor,
+		       uint32_t num_ctxs,
+		       uint32_t num_threads)
+{
+	uint64_t sizes[MAX_SWEEP_POINTS], size, max_stride, working_set;
+	struct sweep_result *results = NULL;
+	struct sweep_bench bench = {0};
+	uint32_t num_points = 0, i, mode;
+	doca_error_t result, tmp_result;
+
+	if (num_ctxs < num_threads) {
+		DOCA_LOG_ERR("Every one of the %u threads needs a DMA context, only %u requested",
+			     num_threads,
+			     num_ctxs);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (size = cfg->msg_size; size <= max_size && num_points < MAX_SWEEP_POINTS; size *= size_factor)
+		sizes[num_points++] = size;
+	if (num_points == 0) {
+		DOCA_LOG_ERR("Smallest copy size %u is larger than the largest %lu", cfg->msg_size, max_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	bench.cfg = cfg;
+	bench.num_workers = num_threads;
+	/* Enough room for the largest copy and for the in flight copies of the largest contexts */
+	max_stride = (sizes[num_points - 1] + SLOT_ALIGN - 1) & ~(uint64_t)(SLOT_ALIGN - 1);
+	working_set = max_stride * cfg->queue_depth * ((num_ctxs + num_threads - 1) / num_threads);
+	if (working_set > MAX_INFLIGHT_BYTES)
+		working_set = MAX_INFLIGHT_BYTES;
+	bench.region_size = working_set > max_stride ? working_set : max_stride;
+
+	results = calloc((size_t)num_points * SWEEP_NUM_MODES, sizeof(*results));
+	bench.workers = calloc(num_threads, sizeof(*bench.workers));
+	if (results == NULL || bench.workers == NULL) {
+		DOCA_LOG_ERR("Failed to allocate benchmark state");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_state;
+	}
+
+	result = dma_bench_open_device(cfg, &bench.dev);
+	if (result != DOCA_SUCCESS)
+		goto free_state;
+
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(bench.dev), &bench.max_buf_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get the maximum DMA memcpy size: %s", doca_error_get_descr(result));
+		goto destroy_workers;
+	}
+	bench.max_size = sizes[num_points - 1];
+	if (bench.max_size > bench.max_buf_size)
+		DOCA_LOG_INFO("Copies above %lu bytes exceed a single DMA memcpy task, they are segmented",
+			      bench.max_buf_size);
+
+	for (i = 0; i < num_threads; i++) {
+		bench.workers[i].bench = &bench;
+		bench.workers[i].num_ctxs = num_ctxs / num_threads + (i < num_ctxs % num_threads ? 1 : 0);
+		result = setup_worker(&bench, &bench.workers[i]);
+		if (result != DOCA_SUCCESS)
+			goto destroy_workers;
+	}
+
+	DOCA_LOG_INFO("Sweeping %lu to %lu bytes with %u threads, %u DMA contexts, %u outstanding tasks per context",
+		      sizes[0],
+		      sizes[num_points - 1],
+		      num_threads,
+		      num_ctxs,
+		      cfg->queue_depth);
+
+	for (i = 0; i < num_points; i++) {
+		for (mode = 0; mode < SWEEP_NUM_MODES; mode++) {
+			result = measure_point(&bench, mode, sizes[i], &results[i * SWEEP_NUM_MODES + mode]);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to measure %lu bytes copies: %s",
+					     sizes[i],
+					     doca_error_get_descr(result));
+				goto destroy_workers;
+			}
+		}
+		DOCA_LOG_INFO("%lu bytes: dma %.3f GB/s, memcpy %.3f GB/s, nt-store %.3f GB/s",
+			      sizes[i],
+			      results[i * SWEEP_NUM_MODES + SWEEP_MODE_DMA].gbps,
+			      results[i * SWEEP_NUM_MODES + SWEEP_MODE_CPU_MEMCPY].gbps,
+			      results[i * SWEEP_NUM_MODES + SWEEP_MODE_CPU_NT].gbps);
+	}
+
+	report_sweep(sizes, results, num_points);
+
+destroy_workers:
+	for (i = 0; i < num_threads; i++) {
+		tmp_result = destroy_worker(&bench, &bench.workers[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_state:
+	free(bench.workers);
+	free(results);
+	return result;
+}
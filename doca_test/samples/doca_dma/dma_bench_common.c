@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+
+#include "common.h"
+#include "dma_bench_common.h"
+
+DOCA_LOG_REGISTER(DMA::BENCH_COMMON);
+
+/*
+ * ARGP Callback - Handle PCI device address parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t pci_address_param_callback(void *param, void *config)
+{
+	struct dma_bench_config *cfg = (struct dma_bench_config *)config;
+	const char *addr = (char *)param;
+	int addr_len = strnlen(addr, DOCA_DEVINFO_PCI_ADDR_SIZE);
+
+	if (addr_len == DOCA_DEVINFO_PCI_ADDR_SIZE) {
+		DOCA_LOG_ERR("Entered device PCI address exceeding the maximum size of %d",
+			     DOCA_DEVINFO_PCI_ADDR_SIZE - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strncpy(cfg->pci_address, addr, addr_len + 1);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle copy size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t msg_size_param_callback(void *param, void *config)
+{
+	struct dma_bench_config *cfg = (struct dma_bench_config *)config;
+	const int msg_size = *(int *)param;
+
+	if (msg_size <= 0) {
+		DOCA_LOG_ERR("Copy size must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->msg_size = (uint32_t)msg_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle queue depth parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t queue_depth_param_callback(void *param, void *config)
+{
+	struct dma_bench_config *cfg = (struct dma_bench_config *)config;
+	const int queue_depth = *(int *)param;
+
+	if (queue_depth <= 0) {
+		DOCA_LOG_ERR("Queue depth must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->queue_depth = (uint32_t)queue_depth;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t duration_param_callback(void *param, void *config)
+{
+	struct dma_bench_config *cfg = (struct dma_bench_config *)config;
+	const int duration = *(int *)param;
+
+	if (duration <= 0) {
+		DOCA_LOG_ERR("Duration must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->duration_sec = (uint32_t)duration;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Create and register a single ARGP param
+ *
+ * @short_name [in]: param short name
+ * @long_name [in]: param long name
+ * @arguments [in]: param arguments description, NULL if none
+ * @description [in]: param description
+ * @callback [in]: param callback
+ * @type [in]: param type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_param(const char *short_name,
+					 const char *long_name,
+					 const char *arguments,
+					 const char *description,
+					 doca_argp_param_cb_t callback,
+					 enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	if (arguments != NULL)
+		doca_argp_param_set_arguments(param, arguments);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t set_default_dma_bench_config(struct dma_bench_config *cfg)
+{
+	if (cfg == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	strcpy(cfg->pci_address, DMA_BENCH_DEFAULT_PCI_ADDR);
+	cfg->msg_size = DMA_BENCH_DEFAULT_MSG_SIZE;
+	cfg->queue_depth = DMA_BENCH_DEFAULT_QUEUE_DEPTH;
+	cfg->duration_sec = DMA_BENCH_DEFAULT_DURATION_SEC;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t register_dma_bench_params(void)
+{
+	doca_error_t result;
+
+	result = register_bench_param("p",
+				      "pci-addr",
+				      NULL,
+				      "DOCA DMA device PCI address",
+				      pci_address_param_callback,
+				      DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_bench_param("ms",
+				      "msg-size",
+				      "<bytes>",
+				      "Copy size in bytes (optional)",
+				      msg_size_param_callback,
+				      DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_bench_param("qd",
+				      "queue-depth",
+				      "<num>",
+				      "Number of outstanding memcpy tasks (optional)",
+				      queue_depth_param_callback,
+				      DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return register_bench_param("du",
+				    "duration",
+				    "<seconds>",
+				    "Duration of every benchmark run in seconds (optional)",
+				    duration_param_callback,
+				    DOCA_ARGP_TYPE_INT);
+}
+
+doca_error_t dma_bench_open_device(const struct dma_bench_config *cfg, struct doca_dev **dev)
+{
+	doca_error_t result;
+
+	result = open_doca_device_with_pci(cfg->pci_address, &dma_task_is_supported, dev);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to open DOCA DMA device %s: %s", cfg->pci_address, doca_error_get_descr(result));
+
+	return result;
+}
+
+doca_error_t dma_bench_ctx_create(struct doca_dev *dev,
+				  struct doca_pe *pe,
+				  uint32_t num_tasks,
+				  doca_dma_task_memcpy_completion_cb_t completed_cb,
+				  doca_dma_task_memcpy_completion_cb_t error_cb,
+				  void *user_data,
+				  struct doca_dma **dma)
+{
+	union doca_data ctx_user_data = {0};
+	struct doca_ctx *ctx;
+	doca_error_t result, tmp_result;
+
+	result = doca_dma_create(dev, dma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+	ctx = doca_dma_as_ctx(*dma);
+
+	result = doca_dma_task_memcpy_set_conf(*dma, completed_cb, error_cb, num_tasks);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set configurations for DMA memcpy task: %s", doca_error_get_descr(result));
+		goto destroy_dma;
+	}
+
+	ctx_user_data.ptr = user_data;
+	result = doca_ctx_set_user_data(ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DMA context user data: %s", doca_error_get_descr(result));
+		goto destroy_dma;
+	}
+
+	result = doca_pe_connect_ctx(pe, ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect DMA context to PE: %s", doca_error_get_descr(result));
+		goto destroy_dma;
+	}
+
+	result = doca_ctx_start(ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		goto destroy_dma;
+	}
+
+	return DOCA_SUCCESS;
+
+destroy_dma:
+	tmp_result = doca_dma_destroy(*dma);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DMA context: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	*dma = NULL;
+	return result;
+}
+
+doca_error_t dma_bench_ctx_destroy(struct doca_pe *pe, struct doca_dma *dma)
+{
+	enum doca_ctx_states state;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (dma == NULL)
+		return DOCA_SUCCESS;
+
+	tmp_result = doca_ctx_get_state(doca_dma_as_ctx(dma), &state);
+	if (tmp_result == DOCA_SUCCESS && state != DOCA_CTX_STATE_IDLE)
+		result = request_stop_ctx(pe, doca_dma_as_ctx(dma));
+
+	tmp_result = doca_dma_destroy(dma);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DMA context: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	return result;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DMA_BENCH_COMMON_H_
+#define DMA_BENCH_COMMON_H_
+
+#include <stdint.h>
+
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+
+#define DMA_BENCH_DEFAULT_DURATION_SEC (5)    /* Default duration of a single benchmark run */
+#define DMA_BENCH_DEFAULT_MSG_SIZE (65536)    /* Default copy size in bytes */
+#define DMA_BENCH_DEFAULT_QUEUE_DEPTH (32)    /* Default number of outstanding memcpy tasks */
+#define DMA_BENCH_DEFAULT_PCI_ADDR "03:00.0" /* Default DMA device, as in the other DMA samples */
+
+/* Configuration shared by the DMA benchmarks, must be the first member of a benchmark configuration */
+struct dma_bench_config {
+	char pci_address[DOCA_DEVINFO_PCI_ADDR_SIZE]; /* PCI address of the DMA device */
+	uint32_t msg_size;			      /* Copy size in bytes */
+	uint32_t queue_depth;			      /* Number of outstanding memcpy tasks */
+	uint32_t duration_sec;			      /* Duration of every benchmark run in seconds */
+};
+
+/*
+ * Set the default values of the benchmark configuration
+ *
+ * @cfg [in]: The benchmark configuration instance
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t set_default_dma_bench_config(struct dma_bench_config *cfg);
+
+/*
+ * Register the ARGP params shared by all DMA benchmarks: PCI address, copy size, queue depth and duration
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t register_dma_bench_params(void);
+
+/*
+ * Open the DMA device of the benchmark configuration
+ *
+ * @cfg [in]: The benchmark configuration
+ * @dev [out]: opened device
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_bench_open_device(const struct dma_bench_config *cfg, struct doca_dev **dev);
+
+/*
+ * Create a DMA context, configure its memcpy tasks, connect it to a PE and start it
+ *
+ * @dev [in]: DOCA device
+ * @pe [in]: DOCA progress engine
+ * @num_tasks [in]: number of memcpy tasks the context may have allocated at once
+ * @completed_cb [in]: memcpy task completion callback
+ * @error_cb [in]: memcpy task error callback
+ * @user_data [in]: context user data passed to the callbacks
+ * @dma [out]: the running DMA context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_bench_ctx_create(struct doca_dev *dev,
+				  struct doca_pe *pe,
+				  uint32_t num_tasks,
+				  doca_dma_task_memcpy_completion_cb_t completed_cb,
+				  doca_dma_task_memcpy_completion_cb_t error_cb,
+				  void *user_data,
+				  struct doca_dma **dma);
+
+/*
+ * Stop (if running) and destroy a DMA context
+ * All its tasks must have completed and been freed
+ *
+ * @pe [in]: DOCA progress engine the context is connected to
+ * @dma [in]: DMA context to destroy, may be NULL
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_bench_ctx_destroy(struct doca_pe *pe, struct doca_dma *dma);
+
+#endif /* DMA_BENCH_COMMON_H_ */
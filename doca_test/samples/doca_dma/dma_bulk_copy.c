@@ -0,0 +1,685 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dma.h>
+#include <doca_log.h>
+
+#include "common.h"
+#include "dma_bulk_copy.h"
+
+DOCA_LOG_REGISTER(DMA::BULK_COPY);
+
+/* One side of a copy and the next byte a segment takes from it */
+struct bulk_copy_side {
+	struct doca_mmap *mmap;	 /* Mmap all extents belong to */
+	const struct iovec *iov; /* Extents */
+	uint32_t cnt;		 /* Number of extents */
+	uint32_t idx;		 /* Extent of the next byte */
+	uint64_t off;		 /* Offset of the next byte in its extent */
+};
+
+/* A submitted copy */
+struct bulk_copy_op {
+	struct bulk_copy_op *next;	 /* Next copy waiting for tasks */
+	struct bulk_copy_side src;	 /* Source extents */
+	struct bulk_copy_side dst;	 /* Destination extents */
+	struct iovec extents[2];	 /* Source and destination of a contiguous copy */
+	uint64_t len;			 /* Copy length */
+	uint64_t issued;		 /* Bytes handed to segment tasks so far */
+	uint32_t num_inflight;		 /* Segments of the copy that have not completed yet */
+	doca_error_t status;		 /* First error of the copy */
+	dma_bulk_copy_done_cb_t done_cb; /* Completion callback */
+	void *user_data;		 /* User data of the completion callback */
+};
+
+/* Copier state */
+struct dma_bulk_copy {
+	struct doca_pe *pe;		      /* Progress engine of the DMA context */
+	struct doca_dma *dma;		      /* DMA context */
+	struct doca_buf_inventory *inventory; /* Two chains of max_list_len buffers per segment task */
+	uint64_t segment_size;		      /* Largest segment */
+	uint32_t max_list_len;		      /* Most extents a segment chains on each side */
+	uint64_t num_segments;		      /* Number of segment tasks submitted */
+	uint32_t max_segments;		      /* Number of segment tasks that may be in flight */
+	uint32_t num_inflight;		      /* Number of segment tasks in flight */
+	uint32_t num_pending;		      /* Number of copies that have not completed */
+	bool stopping;			      /* Whether the copier is being destroyed */
+	struct bulk_copy_op *queue_head;      /* Oldest copy with bytes left to issue, the only one partly issued */
+	struct bulk_copy_op *queue_tail;      /* Newest copy with bytes left to issue */
+};
+
+/*
+ * Append a copy to the issue queue
+ *
+ * @copier [in]: the copier
+ * @op [in]: copy to append
+ */
+static void queue_push(struct dma_bulk_copy *copier, struct bulk_copy_op *op)
+{
+	op->next = NULL;
+	if (copier->queue_tail == NULL)
+		copier->queue_head = op;
+	else
+		copier->queue_tail->next = op;
+	copier->queue_tail = op;
+}
+
+/*
+ * Remove the oldest copy from the issue queue
+ *
+ * @copier [in]: the copier, the queue is not empty
+ */
+static void queue_pop(struct dma_bulk_copy *copier)
+{
+	copier->queue_head = copier->queue_head->next;
+	if (copier->queue_head == NULL)
+		copier->queue_tail = NULL;
+}
+
+/*
+ * Complete a copy and free it
+ *
+ * @copier [in]: the copier
+ * @op [in]: copy with no segment in flight and out of the issue queue
+ */
+static void finish_op(struct dma_bulk_copy *copier, struct bulk_copy_op *op)
+{
+	dma_bulk_copy_done_cb_t done_cb = op->done_cb;
+	doca_error_t status = op->status;
+	void *user_data = op->user_data;
+
+	copier->num_pending--;
+	free(op);
+	done_cb(status, user_data);
+}
+
+/*
+ * Move a side past the extents it has exhausted and past empty ones
+ *
+ * @side [in/out]: side of a copy
+ */
+static void side_skip_exhausted(struct bulk_copy_side *side)
+{
+	while (side->idx < side->cnt && side->off == side->iov[side->idx].iov_len) {
+		side->idx++;
+		side->off = 0;
+	}
+}
+
+/*
+ * Get the length of the next segment of a copy: as many bytes as the segment size allows without chaining more than
+ * max_list_len extents on either side. Taking the longest segment every time gives the fewest segments.
+ *
+ * @copier [in]: the copier
+ * @op [in]: copy with bytes left to issue
+ * @return: segment length
+ */
+static uint64_t next_segment_len(const struct dma_bulk_copy *copier, const struct bulk_copy_op *op)
+{
+	struct bulk_copy_side src = op->src, dst = op->dst;
+	uint64_t limit = op->len - op->issued, seg_len = 0, step;
+	uint32_t num_src = 1, num_dst = 1;
+	bool next_src, next_dst;
+
+	if (limit > copier->segment_size)
+		limit = copier->segment_size;
+
+	side_skip_exhausted(&src);
+	side_skip_exhausted(&dst);
+	for (;;) {
+		step = limit - seg_len;
+		if (step > src.iov[src.idx].iov_len - src.off)
+			step = src.iov[src.idx].iov_len - src.off;
+		if (step > dst.iov[dst.idx].iov_len - dst.off)
+			step = dst.iov[dst.idx].iov_len - dst.off;
+		seg_len += step;
+		src.off += step;
+		dst.off += step;
+		if (seg_len == limit)
+			break;
+
+		/* Bytes are left, so at least one side ended an extent and has another one */
+		next_src = src.off == src.iov[src.idx].iov_len;
+		next_dst = dst.off == dst.iov[dst.idx].iov_len;
+		if ((next_src && num_src == copier->max_list_len) || (next_dst && num_dst == copier->max_list_len))
+			break;
+		if (next_src) {
+			side_skip_exhausted(&src);
+			num_src++;
+		}
+		if (next_dst) {
+			side_skip_exhausted(&dst);
+			num_dst++;
+		}
+	}
+
+	return seg_len;
+}
+
+/*
+ * Chain a buffer for every extent the next len bytes of a side touch
+ *
+ * @copier [in]: the copier
+ * @side [in/out]: side of a copy, moved past the bytes
+ * @len [in]: number of bytes
+ * @is_src [in]: whether the buffers hold data to read or room to write
+ * @chain [out]: head of the chain
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t build_chain(struct dma_bulk_copy *copier,
+				struct bulk_copy_side *side,
+				uint64_t len,
+				bool is_src,
+				struct doca_buf **chain)
+{
+	struct doca_buf *head = NULL, *tail = NULL, *buf;
+	uint64_t piece;
+	char *addr;
+	doca_error_t result;
+
+	while (len > 0) {
+		side_skip_exhausted(side);
+		piece = side->iov[side->idx].iov_len - side->off;
+		if (piece > len)
+			piece = len;
+		addr = (char *)side->iov[side->idx].iov_base + side->off;
+
+		if (is_src)
+			result = doca_buf_inventory_buf_get_by_data(copier->inventory, side->mmap, addr, piece, &buf);
+		else
+			result = doca_buf_inventory_buf_get_by_addr(copier->inventory, side->mmap, addr, piece, &buf);
+		if (result != DOCA_SUCCESS)
+			goto release_chain;
+
+		if (head == NULL) {
+			head = buf;
+		} else {
+			result = doca_buf_chain_list_tail(head, tail, buf);
+			if (result != DOCA_SUCCESS) {
+				(void)doca_buf_dec_refcount(buf, NULL);
+				goto release_chain;
+			}
+		}
+		tail = buf;
+
+		side->off += piece;
+		len -= piece;
+	}
+
+	*chain = head;
+	return DOCA_SUCCESS;
+
+release_chain:
+	/* Releasing the head releases the whole chain */
+	if (head != NULL)
+		(void)doca_buf_dec_refcount(head, NULL);
+	return result;
+}
+
+/*
+ * Submit the next segment of a copy
+ *
+ * @copier [in]: the copier, has a free task
+ * @op [in]: copy
+ * @seg_len [in]: segment length, from next_segment_len()
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t submit_segment(struct dma_bulk_copy *copier, struct bulk_copy_op *op, uint64_t seg_len)
+{
+	union doca_data task_user_data = {0};
+	struct doca_dma_task_memcpy *task;
+	struct doca_buf *src_buf, *dst_buf;
+	doca_error_t result;
+
+	result = build_chain(copier, &op->src, seg_len, true, &src_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = build_chain(copier, &op->dst, seg_len, false, &dst_buf);
+	if (result != DOCA_SUCCESS)
+		goto release_src;
+
+	task_user_data.ptr = op;
+	result = doca_dma_task_memcpy_alloc_init(copier->dma, src_buf, dst_buf, task_user_data, &task);
+	if (result != DOCA_SUCCESS)
+		goto release_dst;
+
+	result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+	if (result != DOCA_SUCCESS) {
+		doca_task_free(doca_dma_task_memcpy_as_task(task));
+		goto release_dst;
+	}
+
+	op->num_inflight++;
+	copier->num_inflight++;
+	copier->num_segments++;
+	return DOCA_SUCCESS;
+
+release_dst:
+	(void)doca_buf_dec_refcount(dst_buf, NULL);
+release_src:
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	return result;
+}
+
+/*
+ * Hand the free tasks to the next segments, oldest copy first
+ *
+ * @copier [in]: the copier
+ */
+static void issue_segments(struct dma_bulk_copy *copier)
+{
+	struct bulk_copy_op *op;
+	uint64_t seg_len;
+	doca_error_t result;
+
+	while (!copier->stopping && copier->queue_head != NULL && copier->num_inflight < copier->max_segments) {
+		op = copier->queue_head;
+		seg_len = next_segment_len(copier, op);
+		result = submit_segment(copier, op, seg_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA memcpy segment: %s", doca_error_get_descr(result));
+			DOCA_ERROR_PROPAGATE(op->status, result);
+			/* Abandon the rest of the copy, it completes with the error once its segments are done */
+			queue_pop(copier);
+			op->issued = op->len;
+			if (op->num_inflight == 0)
+				finish_op(copier, op);
+			continue;
+		}
+
+		op->issued += seg_len;
+		if (op->issued == op->len)
+			queue_pop(copier);
+	}
+}
+
+/*
+ * Release a segment task and its buffer chains
+ *
+ * @task [in]: segment task
+ */
+static void release_segment(struct doca_dma_task_memcpy *task)
+{
+	struct doca_buf *src_buf = (struct doca_buf *)doca_dma_task_memcpy_get_src(task);
+	struct doca_buf *dst_buf = doca_dma_task_memcpy_get_dst(task);
+
+	doca_task_free(doca_dma_task_memcpy_as_task(task));
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	(void)doca_buf_dec_refcount(dst_buf, NULL);
+}
+
+/*
+ * Account for a segment that is done, complete its copy if it was the last one and reuse its task
+ *
+ * @copier [in]: the copier
+ * @op [in]: copy the segment belongs to
+ * @status [in]: status of the segment
+ */
+static void segment_done(struct dma_bulk_copy *copier, struct bulk_copy_op *op, doca_error_t status)
+{
+	copier->num_inflight--;
+	op->num_inflight--;
+
+	if (status != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(op->status, status);
+		/* Only the head of the queue can have bytes left, don't issue them */
+		if (copier->queue_head == op) {
+			queue_pop(copier);
+			op->issued = op->len;
+		}
+	}
+
+	if (op->num_inflight == 0 && op->issued == op->len)
+		finish_op(copier, op);
+
+	issue_segments(copier);
+}
+
+/*
+ * DMA memcpy segment completed callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void bulk_copy_segment_completed_callback(struct doca_dma_task_memcpy *dma_task,
+						 union doca_data task_user_data,
+						 union doca_data ctx_user_data)
+{
+	struct dma_bulk_copy *copier = (struct dma_bulk_copy *)ctx_user_data.ptr;
+
+	release_segment(dma_task);
+	segment_done(copier, (struct bulk_copy_op *)task_user_data.ptr, DOCA_SUCCESS);
+}
+
+/*
+ * DMA memcpy segment error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void bulk_copy_segment_error_callback(struct doca_dma_task_memcpy *dma_task,
+					     union doca_data task_user_data,
+					     union doca_data ctx_user_data)
+{
+	struct dma_bulk_copy *copier = (struct dma_bulk_copy *)ctx_user_data.ptr;
+	doca_error_t status = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+
+	/* Flushed tasks are expected while the copier is destroyed */
+	if (!copier->stopping)
+		DOCA_LOG_ERR("DMA memcpy segment failed: %s", doca_error_get_descr(status));
+
+	release_segment(dma_task);
+	segment_done(copier, (struct bulk_copy_op *)task_user_data.ptr, status);
+}
+
+doca_error_t dma_bulk_copy_create(struct doca_dev *dev,
+				  struct doca_pe *pe,
+				  uint32_t max_segments,
+				  uint64_t segment_size,
+				  uint32_t max_list_len,
+				  struct dma_bulk_copy **copier)
+{
+	union doca_data ctx_user_data = {0};
+	struct dma_bulk_copy *new_copier;
+	uint64_t max_buf_size;
+	uint32_t dev_max_list_len;
+	doca_error_t result;
+
+	if (dev == NULL || pe == NULL || max_segments == 0 || copier == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(dev), &max_buf_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get the maximum DMA memcpy size: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_dma_cap_task_memcpy_get_max_buf_list_len(doca_dev_as_devinfo(dev), &dev_max_list_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get the maximum DMA memcpy buffer list length: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	new_copier = calloc(1, sizeof(*new_copier));
+	if (new_copier == NULL) {
+		DOCA_LOG_ERR("Failed to allocate DMA bulk copier");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_copier->pe = pe;
+	new_copier->max_segments = max_segments;
+	new_copier->segment_size = (segment_size == 0 || segment_size > max_buf_size) ? max_buf_size : segment_size;
+	new_copier->max_list_len = max_list_len;
+	if (max_list_len == 0 || max_list_len > dev_max_list_len)
+		new_copier->max_list_len = dev_max_list_len;
+
+	result = doca_buf_inventory_create(2 * max_segments * new_copier->max_list_len, &new_copier->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	result = doca_buf_inventory_start(new_copier->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	result = doca_dma_create(dev, &new_copier->dma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	result = doca_dma_task_memcpy_set_conf(new_copier->dma,
+					       bulk_copy_segment_completed_callback,
+					       bulk_copy_segment_error_callback,
+					       max_segments);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set configurations for DMA memcpy task: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	ctx_user_data.ptr = new_copier;
+	result = doca_ctx_set_user_data(doca_dma_as_ctx(new_copier->dma), ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DMA context user data: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	result = doca_pe_connect_ctx(pe, doca_dma_as_ctx(new_copier->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect DMA context to PE: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	result = doca_ctx_start(doca_dma_as_ctx(new_copier->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
+
+	*copier = new_copier;
+	return DOCA_SUCCESS;
+
+destroy_copier:
+	(void)dma_bulk_copy_destroy(new_copier);
+	return result;
+}
+
+/*
+ * Queue a copy and start issuing its segments
+ *
+ * @copier [in]: the copier
+ * @op [in]: copy, everything but the queue link set
+ */
+static void enqueue_op(struct dma_bulk_copy *copier, struct bulk_copy_op *op)
+{
+	op->status = DOCA_SUCCESS;
+	copier->num_pending++;
+	queue_push(copier, op);
+	issue_segments(copier);
+}
+
+/*
+ * Get the number of bytes of a list of extents
+ *
+ * @iov [in]: extents
+ * @cnt [in]: number of extents
+ * @return: number of bytes
+ */
+static uint64_t extents_len(const struct iovec *iov, uint32_t cnt)
+{
+	uint64_t len = 0;
+	uint32_t i;
+
+	for (i = 0; i < cnt; i++)
+		len += iov[i].iov_len;
+	return len;
+}
+
+doca_error_t dma_bulk_copy_submit(struct dma_bulk_copy *copier,
+				  struct doca_mmap *src_mmap,
+				  const void *src,
+				  struct doca_mmap *dst_mmap,
+				  void *dst,
+				  uint64_t len,
+				  dma_bulk_copy_done_cb_t done_cb,
+				  void *user_data)
+{
+	struct bulk_copy_op *op;
+
+	if (copier == NULL || src_mmap == NULL || src == NULL || dst_mmap == NULL || dst == NULL || len == 0 ||
+	    done_cb == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+	if (copier->stopping)
+		return DOCA_ERROR_BAD_STATE;
+
+	op = calloc(1, sizeof(*op));
+	if (op == NULL) {
+		DOCA_LOG_ERR("Failed to allocate DMA bulk copy");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	op->extents[0].iov_base = (void *)src;
+	op->extents[0].iov_len = len;
+	op->extents[1].iov_base = dst;
+	op->extents[1].iov_len = len;
+	op->src.mmap = src_mmap;
+	op->src.iov = &op->extents[0];
+	op->src.cnt = 1;
+	op->dst.mmap = dst_mmap;
+	op->dst.iov = &op->extents[1];
+	op->dst.cnt = 1;
+	op->len = len;
+	op->done_cb = done_cb;
+	op->user_data = user_data;
+
+	enqueue_op(copier, op);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t dma_bulk_copy_submit_sg(struct dma_bulk_copy *copier,
+				     struct doca_mmap *src_mmap,
+				     const struct iovec *src_iov,
+				     uint32_t src_cnt,
+				     struct doca_mmap *dst_mmap,
+				     const struct iovec *dst_iov,
+				     uint32_t dst_cnt,
+				     dma_bulk_copy_done_cb_t done_cb,
+				     void *user_data)
+{
+	struct bulk_copy_op *op;
+	uint64_t len;
+
+	if (copier == NULL || src_mmap == NULL || src_iov == NULL || src_cnt == 0 || dst_mmap == NULL ||
+	    dst_iov == NULL || dst_cnt == 0 || done_cb == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+	if (copier->stopping)
+		return DOCA_ERROR_BAD_STATE;
+
+	len = extents_len(src_iov, src_cnt);
+	if (len == 0 || len != extents_len(dst_iov, dst_cnt)) {
+		DOCA_LOG_ERR("Scatter-gather copy of %lu source bytes to %lu destination bytes",
+			     len,
+			     extents_len(dst_iov, dst_cnt));
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	op = calloc(1, sizeof(*op));
+	if (op == NULL) {
+		DOCA_LOG_ERR("Failed to allocate DMA bulk copy");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	op->src.mmap = src_mmap;
+	op->src.iov = src_iov;
+	op->src.cnt = src_cnt;
+	op->dst.mmap = dst_mmap;
+	op->dst.iov = dst_iov;
+	op->dst.cnt = dst_cnt;
+	op->len = len;
+	op->done_cb = done_cb;
+	op->user_data = user_data;
+
+	enqueue_op(copier, op);
+	return DOCA_SUCCESS;
+}
+
+uint64_t dma_bulk_copy_get_segment_size(const struct dma_bulk_copy *copier)
+{
+	return copier->segment_size;
+}
+
+uint32_t dma_bulk_copy_get_max_list_len(const struct dma_bulk_copy *copier)
+{
+	return copier->max_list_len;
+}
+
+uint64_t dma_bulk_copy_get_num_segments(const struct dma_bulk_copy *copier)
+{
+	return copier->num_segments;
+}
+
+uint32_t dma_bulk_copy_get_num_pending(const struct dma_bulk_copy *copier)
+{
+	return copier->num_pending;
+}
+
+doca_error_t dma_bulk_copy_destroy(struct dma_bulk_copy *copier)
+{
+	enum doca_ctx_states state;
+	struct bulk_copy_op *op;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (copier == NULL)
+		return DOCA_SUCCESS;
+
+	copier->stopping = true;
+
+	if (copier->dma != NULL) {
+		/* Flushes the segments in flight, their copies complete from the error callback */
+		tmp_result = doca_ctx_get_state(doca_dma_as_ctx(copier->dma), &state);
+		if (tmp_result == DOCA_SUCCESS && state != DOCA_CTX_STATE_IDLE) {
+			tmp_result = request_stop_ctx(copier->pe, doca_dma_as_ctx(copier->dma));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	/* Copies that never got a task */
+	while (copier->queue_head != NULL) {
+		op = copier->queue_head;
+		queue_pop(copier);
+		DOCA_ERROR_PROPAGATE(op->status, DOCA_ERROR_BAD_STATE);
+		finish_op(copier, op);
+	}
+
+	if (copier->dma != NULL) {
+		tmp_result = doca_dma_destroy(copier->dma);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DMA context: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (copier->inventory != NULL) {
+		(void)doca_buf_inventory_stop(copier->inventory);
+		tmp_result = doca_buf_inventory_destroy(copier->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(copier);
+	return result;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DMA_BULK_COPY_H_
+#define DMA_BULK_COPY_H_
+
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+/*
+ * DMA copies of any length.
+ *
+ * A memcpy task can't exceed doca_dma_cap_task_memcpy_get_max_buf_size(), so a copy is split into segments of at
+ * most that size. The segments of all submitted copies share a window of tasks: every free task takes the next
+ * segment, copies are served in submission order, and a copy completes once, through its callback, when its last
+ * segment is done. Everything runs from the callbacks of the PE the copier is connected to, the caller only needs
+ * to progress it.
+ *
+ * Scatter-gather copies take iovec lists on both sides. A segment chains one doca_buf per extent it touches on each
+ * side, up to doca_dma_cap_task_memcpy_get_max_buf_list_len() of them, so it covers as many extents as the device
+ * allows and a copy takes the fewest tasks. A contiguous copy is the one extent case.
+ */
+
+struct dma_bulk_copy;
+
+/*
+ * Completion callback of a copy, called once all of its segments are done
+ *
+ * @status [in]: DOCA_SUCCESS, or the error of the first segment that failed
+ * @user_data [in]: user data passed to dma_bulk_copy_submit()
+ */
+typedef void (*dma_bulk_copy_done_cb_t)(doca_error_t status, void *user_data);
+
+/*
+ * Create a copier with its own DMA context and buffer inventory, connected to a PE and started
+ *
+ * @dev [in]: DOCA device, must support DMA memcpy tasks
+ * @pe [in]: progress engine the callbacks run from
+ * @max_segments [in]: number of segment tasks that may be in flight at once
+ * @segment_size [in]: largest segment in bytes, 0 or anything above the device limit for the device limit
+ * @max_list_len [in]: most extents a segment chains on each side, 0 or anything above the device limit for the
+ * device limit, 1 for a task per extent
+ * @copier [out]: the copier
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_bulk_copy_create(struct doca_dev *dev,
+				  struct doca_pe *pe,
+				  uint32_t max_segments,
+				  uint64_t segment_size,
+				  uint32_t max_list_len,
+				  struct dma_bulk_copy **copier);
+
+/*
+ * Submit a copy, it starts as soon as the copies submitted before it leave tasks free
+ * Source and destination must not overlap and must stay registered until the callback is called
+ *
+ * @copier [in]: the copier
+ * @src_mmap [in]: started mmap the source belongs to
+ * @src [in]: source address
+ * @dst_mmap [in]: started mmap the destination belongs to
+ * @dst [in]: destination address
+ * @len [in]: number of bytes to copy, positive
+ * @done_cb [in]: called once the copy is complete, may submit more copies
+ * @user_data [in]: passed to done_cb
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise, done_cb is called only on success
+ */
+doca_error_t dma_bulk_copy_submit(struct dma_bulk_copy *copier,
+				  struct doca_mmap *src_mmap,
+				  const void *src,
+				  struct doca_mmap *dst_mmap,
+				  void *dst,
+				  uint64_t len,
+				  dma_bulk_copy_done_cb_t done_cb,
+				  void *user_data);
+
+/*
+ * Submit a scatter-gather copy, the bytes of the source extents in order go to the destination extents in order
+ * Both sides must hold the same number of bytes, empty extents are skipped. The extents must not overlap and, with
+ * the iovec arrays themselves, must stay valid until the callback is called.
+ *
+ * @copier [in]: the copier
+ * @src_mmap [in]: started mmap all source extents belong to
+ * @src_iov [in]: source extents
+ * @src_cnt [in]: number of source extents
+ * @dst_mmap [in]: started mmap all destination extents belong to
+ * @dst_iov [in]: destination extents
+ * @dst_cnt [in]: number of destination extents
+ * @done_cb [in]: called once the copy is complete, may submit more copies
+ * @user_data [in]: passed to done_cb
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise, done_cb is called only on success
+ */
+doca_error_t dma_bulk_copy_submit_sg(struct dma_bulk_copy *copier,
+				     struct doca_mmap *src_mmap,
+				     const struct iovec *src_iov,
+				     uint32_t src_cnt,
+				     struct doca_mmap *dst_mmap,
+				     const struct iovec *dst_iov,
+				     uint32_t dst_cnt,
+				     dma_bulk_copy_done_cb_t done_cb,
+				     void *user_data);
+
+/*
+ * Get the largest segment of a copier
+ *
+ * @copier [in]: the copier
+ * @return: segment size in bytes
+ */
+uint64_t dma_bulk_copy_get_segment_size(const struct dma_bulk_copy *copier);
+
+/*
+ * Get the most extents a segment of a copier chains on each side
+ *
+ * @copier [in]: the copier
+ * @return: number of extents
+ */
+uint32_t dma_bulk_copy_get_max_list_len(const struct dma_bulk_copy *copier);
+
+/*
+ * Get the number of segment tasks a copier submitted since it was created
+ *
+ * @copier [in]: the copier
+ * @return: number of tasks
+ */
+uint64_t dma_bulk_copy_get_num_segments(const struct dma_bulk_copy *copier);
+
+/*
+ * Get the number of copies that were submitted and have not completed yet
+ *
+ * @copier [in]: the copier
+ * @return: number of copies
+ */
+uint32_t dma_bulk_copy_get_num_pending(const struct dma_bulk_copy *copier);
+
+/*
+ * Stop and destroy a copier, copies still pending complete with an error first
+ *
+ * @copier [in]: the copier, may be NULL
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_bulk_copy_destroy(struct dma_bulk_copy *copier);
+
+#endif /* DMA_BULK_COPY_H_ */
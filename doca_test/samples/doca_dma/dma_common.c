@@ -37,6 +37,7 @@
 #include <doca_argp.h>
 
 #include "dma_common.h"
+#include "dma_stream_ring.h"
 
 DOCA_LOG_REGISTER(DMA_COMMON);
 
@@ -155,10 +156,221 @@ static doca_error_t buf_info_path_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle number of ring slots parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_slots_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const int num_slots = *(int *)param;
+
+	if (num_slots <= 0 || num_slots > MAX_STREAM_SLOTS) {
+		DOCA_LOG_ERR("Number of ring slots must be between 1 and %d", MAX_STREAM_SLOTS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->num_slots = (uint32_t)num_slots;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle ring slot size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t slot_size_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const int slot_size = *(int *)param;
+
+	/* Slots stay cache line aligned so that no two of them share a line */
+	if (slot_size < 2 * DMA_STREAM_LINE_SIZE || slot_size > MAX_STREAM_SLOT_SIZE ||
+	    slot_size % DMA_STREAM_LINE_SIZE != 0) {
+		DOCA_LOG_ERR("Slot size must be a multiple of %d between %d and %d bytes",
+			     DMA_STREAM_LINE_SIZE,
+			     2 * DMA_STREAM_LINE_SIZE,
+			     MAX_STREAM_SLOT_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->slot_size = (uint32_t)slot_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle streaming run time parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_time_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const int run_time_sec = *(int *)param;
+
+	if (run_time_sec <= 0) {
+		DOCA_LOG_ERR("Run time must be a positive number of seconds");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->run_time_sec = (uint32_t)run_time_sec;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle DPU queue depth parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t queue_depth_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const int queue_depth = *(int *)param;
+
+	if (queue_depth <= 0 || queue_depth > MAX_STREAM_QUEUE_DEPTH) {
+		DOCA_LOG_ERR("Queue depth must be between 1 and %d", MAX_STREAM_QUEUE_DEPTH);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->queue_depth = (uint32_t)queue_depth;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle streaming direction parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t direction_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const char *direction = (char *)param;
+
+	if (strcmp(direction, "pull") == 0) {
+		conf->stream_pull = true;
+		conf->stream_push = false;
+	} else if (strcmp(direction, "push") == 0) {
+		conf->stream_pull = false;
+		conf->stream_push = true;
+	} else if (strcmp(direction, "both") == 0) {
+		conf->stream_pull = true;
+		conf->stream_push = true;
+	} else {
+		DOCA_LOG_ERR("Direction must be one of pull, push or both");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle file path parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_path_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const char *path = (char *)param;
+	int path_len = strnlen(path, MAX_ARG_SIZE);
+
+	/* Check using >= to make static code analysis satisfied */
+	if (path_len >= MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Entered path exceeded buffer size: %d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+#ifndef DOCA_ARCH_DPU
+	if (access(path, F_OK | R_OK) != 0) {
+		DOCA_LOG_ERR("Failed to find file to export: %s", path);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+#endif
+
+	/* The string will be '\0' terminated due to the strnlen check above */
+	strncpy(conf->file_path, path, path_len + 1);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle file export mode parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_mode_callback(void *param, void *config)
+{
+	struct dma_config *conf = (struct dma_config *)config;
+	const char *mode = (char *)param;
+
+	if (strcmp(mode, "mmap") == 0)
+		conf->file_zero_copy = true;
+	else if (strcmp(mode, "read") == 0)
+		conf->file_zero_copy = false;
+	else {
+		DOCA_LOG_ERR("File mode must be one of mmap or read");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register an integer ARGP param
+ *
+ * @short_name [in]: short name
+ * @long_name [in]: long name
+ * @description [in]: description
+ * @callback [in]: ARGP callback
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_int_param(const char *short_name,
+				       const char *long_name,
+				       const char *description,
+				       doca_argp_param_cb_t callback)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
 doca_error_t register_dma_params(bool is_remote)
 {
 	doca_error_t result;
 	struct doca_argp_param *pci_address_param, *cpy_txt_param, *export_desc_path_param, *buf_info_path_param;
+	struct doca_argp_param *direction_param, *file_path_param, *file_mode_param;
 
 	/* Create and register PCI address param */
 	result = doca_argp_param_create(&pci_address_param);
@@ -231,6 +443,90 @@ doca_error_t register_dma_params(bool is_remote)
 			DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
 			return result;
 		}
+
+		/* Streaming ring params */
+		result = register_int_param("n",
+					    "num-slots",
+					    "Number of slots of the streaming ring (relevant only on the Host side)",
+					    num_slots_callback);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = register_int_param("s",
+					    "slot-size",
+					    "Size of a ring slot in bytes (relevant only on the Host side)",
+					    slot_size_callback);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = register_int_param("r",
+					    "run-time",
+					    "Seconds to stream for, or with --file seconds the DPU has to pull each "
+					    "window once attached (relevant only on the Host side)",
+					    run_time_callback);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = register_int_param("q",
+					    "queue-depth",
+					    "Slot reads and slot writes kept in flight (relevant only on the DPU side)",
+					    queue_depth_callback);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		result = doca_argp_param_create(&direction_param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+			return result;
+		}
+		doca_argp_param_set_short_name(direction_param, "dir");
+		doca_argp_param_set_long_name(direction_param, "direction");
+		doca_argp_param_set_arguments(direction_param, "<pull|push|both>");
+		doca_argp_param_set_description(direction_param,
+						"Stream from the Host to the DPU (pull), back (push) or both at once "
+						"(relevant only on the Host side)");
+		doca_argp_param_set_callback(direction_param, direction_callback);
+		doca_argp_param_set_type(direction_param, DOCA_ARGP_TYPE_STRING);
+		result = doca_argp_register_param(direction_param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		/* File transfer params */
+		result = doca_argp_param_create(&file_path_param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+			return result;
+		}
+		doca_argp_param_set_short_name(file_path_param, "f");
+		doca_argp_param_set_long_name(file_path_param, "file");
+		doca_argp_param_set_arguments(file_path_param, "<path>");
+		doca_argp_param_set_description(file_path_param,
+						"File the Host exports, or the DPU writes it to, instead of streaming");
+		doca_argp_param_set_callback(file_path_param, file_path_callback);
+		doca_argp_param_set_type(file_path_param, DOCA_ARGP_TYPE_STRING);
+		result = doca_argp_register_param(file_path_param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_argp_param_create(&file_mode_param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+			return result;
+		}
+		doca_argp_param_set_short_name(file_mode_param, "fm");
+		doca_argp_param_set_long_name(file_mode_param, "file-mode");
+		doca_argp_param_set_arguments(file_mode_param, "<mmap|read>");
+		doca_argp_param_set_description(file_mode_param,
+						"Export a mapping of the file (mmap) or a copy read into memory (read) "
+						"(relevant only on the Host side)");
+		doca_argp_param_set_callback(file_mode_param, file_mode_callback);
+		doca_argp_param_set_type(file_mode_param, DOCA_ARGP_TYPE_STRING);
+		result = doca_argp_register_param(file_mode_param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+			return result;
+		}
 	}
 
 	return DOCA_SUCCESS;
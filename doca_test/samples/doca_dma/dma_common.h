@@ -40,6 +40,9 @@
 #define MAX_TXT_SIZE (MAX_USER_TXT_SIZE + 1) /* Maximum size of input text */
 #define PAGE_SIZE sysconf(_SC_PAGESIZE)	     /* Page size */
 #define NUM_DMA_TASKS (1)		     /* DMA tasks number */
+#define MAX_STREAM_SLOTS (65536)	     /* Most slots of the streaming ring */
+#define MAX_STREAM_SLOT_SIZE (1 << 30)	     /* Largest slot of the streaming ring */
+#define MAX_STREAM_QUEUE_DEPTH (1024)	     /* Most slot reads or writes the DPU keeps in flight */
 
 /* Configuration struct */
 struct dma_config {
@@ -47,6 +50,14 @@ struct dma_config {
 	char cpy_txt[MAX_TXT_SIZE];		      /* Text to copy between the two local buffers */
 	char export_desc_path[MAX_ARG_SIZE];	      /* Path to save/read the exported descriptor file */
 	char buf_info_path[MAX_ARG_SIZE];	      /* Path to save/read the buffer information file */
+	uint32_t num_slots;			      /* Number of slots of the streaming ring */
+	uint32_t slot_size;			      /* Size of a slot of the streaming ring */
+	uint32_t run_time_sec;			      /* Time the host streams for, or waits for a file window */
+	uint32_t queue_depth;			      /* Number of slot reads or writes the DPU keeps in flight */
+	bool stream_pull;			      /* Whether the host streams messages to the DPU */
+	bool stream_push;			      /* Whether the DPU streams messages to the host */
+	char file_path[MAX_ARG_SIZE];		      /* File the Host exports or the DPU writes, or empty */
+	bool file_zero_copy;			      /* Whether the Host exports a mapping of the file */
 };
 
 struct dma_resources {
@@ -35,7 +35,13 @@
 DOCA_LOG_REGISTER(DMA_COPY_DPU::MAIN);
 
 /* Sample's Logic */
-doca_error_t dma_copy_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr);
+doca_error_t dma_copy_dpu(const char *export_desc_file_path,
+			  const char *buffer_info_file_path,
+			  const char *pcie_addr,
+			  uint32_t queue_depth,
+			  const char *file_path);
+
+#define DEFAULT_QUEUE_DEPTH (16) /* Default number of slot reads kept in flight */
 
 /*
  * Sample main function
@@ -57,6 +63,8 @@ int main(int argc, char **argv)
 	strcpy(dma_conf.buf_info_path, "/tmp/buffer_info.txt");
 	/* No need to set cpy_txt because we get it from the host */
 	dma_conf.cpy_txt[0] = '\0';
+	dma_conf.queue_depth = DEFAULT_QUEUE_DEPTH;
+	dma_conf.file_path[0] = '\0';
 
 	/* Register a logger backend */
 	result = doca_log_backend_create_standard();
@@ -95,7 +103,11 @@ int main(int argc, char **argv)
 		goto argp_cleanup;
 	}
 
-	result = dma_copy_dpu(dma_conf.export_desc_path, dma_conf.buf_info_path, dma_conf.pci_address);
+	result = dma_copy_dpu(dma_conf.export_desc_path,
+			      dma_conf.buf_info_path,
+			      dma_conf.pci_address,
+			      dma_conf.queue_depth,
+			      dma_conf.file_path);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("dma_copy_dpu() encountered an error: %s", doca_error_get_descr(result));
 		goto argp_cleanup;
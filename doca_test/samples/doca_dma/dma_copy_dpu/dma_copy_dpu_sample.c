@@ -23,15 +23,17 @@
  *
  */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <limits.h>
+#include <unistd.h>
 
-#include <doca_buf.h>
-#include <doca_buf_inventory.h>
-#include <doca_ctx.h>
 #include <doca_dev.h>
 #include <doca_dma.h>
 #include <doca_error.h>
@@ -39,12 +41,18 @@
 #include <doca_mmap.h>
 #include <doca_pe.h>
 
+#include "bench_common.h"
+#include "checksum.h"
+#include "dma_bulk_copy.h"
 #include "dma_common.h"
+#include "dma_file_window.h"
+#include "dma_stream_ring.h"
 
 DOCA_LOG_REGISTER(DMA_COPY_DPU);
 
-#define SLEEP_IN_NANOS (10 * 1000) /* Sample the task every 10 microseconds  */
-#define RECV_BUF_SIZE (512)	   /* Buffer which contains config information */
+#define SLEEP_IN_NANOS (10 * 1000)    /* Sample the task every 10 microseconds  */
+#define RECV_BUF_SIZE (512)	      /* Buffer which contains config information */
+#define FILE_CHUNK_SIZE (1024 * 1024) /* Bytes of the file each read of a file pull takes */
 
 /*
  * Saves export descriptor and buffer information content into memory buffers
@@ -149,229 +157,1207 @@ static doca_error_t save_config_info_to_buffers(const char *export_desc_file_pat
 	return DOCA_SUCCESS;
 }
 
+/* A slot read or write in flight */
+struct stream_slot_op {
+	struct dpu_stream *stream; /* Stream the operation belongs to */
+	uint64_t idx;		   /* Message index */
+	bool done;		   /* Whether the operation completed, and a read was checked */
+};
+
+/* DPU side of the streaming rings */
+struct dpu_stream {
+	struct dma_bulk_copy *copier;	 /* Copier of every read and write to the region */
+	struct doca_mmap *remote_mmap;	 /* Host region, from the export */
+	char *remote_region;		 /* Host address of the region */
+	struct doca_mmap *ctrl_mmap;	 /* Local copies of the control lines */
+	struct dma_stream_region *ctrl;	 /* Polled lines and lines to write */
+	struct doca_mmap *data_mmap;	 /* Local slots */
+	char *data;			 /* queue_depth local slots to pull into, then queue_depth to push from */
+	struct stream_slot_op *reads;	 /* Read of every local pull slot */
+	struct stream_slot_op *writes;	 /* Write of every local push slot */
+	uint32_t num_slots;		 /* Number of slots of each host ring */
+	uint32_t slot_size;		 /* Size of a slot */
+	uint32_t queue_depth;		 /* Number of local slots of each direction, the operations in flight */
+	bool push;			 /* Whether the host has a push ring */
+	uint64_t prod_idx;		 /* Last pull producer index read */
+	bool closed;			 /* Whether prod_idx is final, which also ends the push ring */
+	uint64_t issued_idx;		 /* Messages read or being read */
+	uint64_t cons_idx;		 /* Messages consumed */
+	uint64_t acked_idx;		 /* Pull consumer index last written to the host */
+	bool attached;			 /* Whether the local slots are set up */
+	bool poll_inflight;		 /* Whether a read of the pull producer line is in flight */
+	bool ack_inflight;		 /* Whether a write of the pull consumer line is in flight */
+	bool detached;			 /* Whether the final acknowledgment is done */
+	uint64_t num_polls;		 /* Reads of the pull producer line */
+	uint64_t num_bytes;		 /* Payload bytes consumed */
+	uint64_t first_msg_ns;		 /* Arrival of the first message */
+	uint64_t push_issued;		 /* Messages written or being written */
+	uint64_t push_done;		 /* Messages written, in order */
+	uint64_t push_rung;		 /* Push producer index last written to the host */
+	uint64_t push_host_cons;	 /* Last push consumer index read */
+	bool doorbell_inflight;		 /* Whether a write of the push producer index is in flight */
+	bool credit_inflight;		 /* Whether a read of the push consumer line is in flight */
+	bool push_closed;		 /* Whether the final push producer index was written */
+	bool push_finished;		 /* Whether the host consumed every pushed message */
+	uint64_t num_credit_polls;	 /* Reads of the push consumer line */
+	uint64_t push_bytes;		 /* Payload bytes pushed */
+	doca_error_t result;		 /* First error */
+};
+
+static void stream_advance(struct dpu_stream *stream);
+
 /*
- * Run DOCA DMA DPU copy sample
+ * Record the first error of the stream, the DPU stops issuing new operations
  *
- * @export_desc_file_path [in]: Export descriptor file path
- * @buffer_info_file_path [in]: Buffer info file path
- * @pcie_addr [in]: Device PCI address
+ * @stream [in]: stream
+ * @result [in]: error
+ */
+static void stream_fail(struct dpu_stream *stream, doca_error_t result)
+{
+	DOCA_ERROR_PROPAGATE(stream->result, result);
+}
+
+/*
+ * Get a local slot
+ *
+ * @stream [in]: stream
+ * @dir [in]: ring the slot serves
+ * @idx [in]: message index
+ * @return: header of the slot
+ */
+static struct dma_stream_slot_hdr *stream_local_slot(struct dpu_stream *stream, enum dma_stream_dir dir, uint64_t idx)
+{
+	size_t slot = (size_t)dir * stream->queue_depth + (size_t)(idx % stream->queue_depth);
+
+	return (struct dma_stream_slot_hdr *)(stream->data + slot * stream->slot_size);
+}
+
+/*
+ * Pull producer line read callback
+ *
+ * @status [in]: status of the read
+ * @user_data [in]: stream
+ */
+static void stream_poll_done_callback(doca_error_t status, void *user_data)
+{
+	struct dpu_stream *stream = (struct dpu_stream *)user_data;
+	uint64_t prod_idx;
+
+	stream->poll_inflight = false;
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read the producer index: %s", doca_error_get_descr(status));
+		stream_fail(stream, status);
+		return;
+	}
+
+	prod_idx = stream->ctrl->rings[DMA_STREAM_PULL].prod.prod_idx;
+	stream->closed = (prod_idx & DMA_STREAM_IDX_FLAG) != 0;
+	stream->prod_idx = prod_idx & DMA_STREAM_IDX_MASK;
+	if (stream->attached)
+		stream_advance(stream);
+}
+
+/*
+ * Slot read callback, checks the message and consumes every message that arrived in order
+ *
+ * @status [in]: status of the read
+ * @user_data [in]: read of the slot
+ */
+static void stream_read_done_callback(doca_error_t status, void *user_data)
+{
+	struct stream_slot_op *read = (struct stream_slot_op *)user_data;
+	struct dpu_stream *stream = read->stream;
+	const struct dma_stream_slot_hdr *hdr;
+
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read message %lu: %s", read->idx, doca_error_get_descr(status));
+		stream_fail(stream, status);
+		return;
+	}
+
+	hdr = stream_local_slot(stream, DMA_STREAM_PULL, read->idx);
+	if (hdr->seq != read->idx || hdr->len > stream->slot_size - sizeof(*hdr) ||
+	    checksum_crc32c(0, hdr + 1, hdr->len) != hdr->crc) {
+		DOCA_LOG_ERR("Message %lu is corrupted", read->idx);
+		stream_fail(stream, DOCA_ERROR_UNEXPECTED);
+		return;
+	}
+	if (read->idx == 0) {
+		stream->first_msg_ns = bench_get_time_ns();
+		DOCA_LOG_INFO("Memory content: %.*s",
+			      (int)strnlen((const char *)(hdr + 1), hdr->len),
+			      (const char *)(hdr + 1));
+	}
+	read->done = true;
+
+	/* The host gets its slots back in order */
+	while (stream->cons_idx < stream->issued_idx) {
+		read = &stream->reads[stream->cons_idx % stream->queue_depth];
+		if (!read->done)
+			break;
+		hdr = stream_local_slot(stream, DMA_STREAM_PULL, stream->cons_idx);
+		stream->num_bytes += hdr->len;
+		read->done = false;
+		stream->cons_idx++;
+	}
+
+	stream_advance(stream);
+}
+
+/*
+ * Pull consumer line write callback
+ *
+ * @status [in]: status of the write
+ * @user_data [in]: stream
+ */
+static void stream_ack_done_callback(doca_error_t status, void *user_data)
+{
+	struct dpu_stream *stream = (struct dpu_stream *)user_data;
+
+	stream->ack_inflight = false;
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to write the consumer index: %s", doca_error_get_descr(status));
+		stream_fail(stream, status);
+		return;
+	}
+
+	if (stream->ctrl->rings[DMA_STREAM_PULL].cons.cons_idx & DMA_STREAM_IDX_FLAG)
+		stream->detached = true;
+	else
+		stream_advance(stream);
+}
+
+/*
+ * Slot write callback, counts every message written in order
+ *
+ * @status [in]: status of the write
+ * @user_data [in]: write of the slot
+ */
+static void stream_write_done_callback(doca_error_t status, void *user_data)
+{
+	struct stream_slot_op *write = (struct stream_slot_op *)user_data;
+	struct dpu_stream *stream = write->stream;
+
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to write message %lu: %s", write->idx, doca_error_get_descr(status));
+		stream_fail(stream, status);
+		return;
+	}
+	write->done = true;
+
+	/* The doorbell only covers a prefix of completed writes */
+	while (stream->push_done < stream->push_issued) {
+		write = &stream->writes[stream->push_done % stream->queue_depth];
+		if (!write->done)
+			break;
+		stream->push_bytes += stream_local_slot(stream, DMA_STREAM_PUSH, stream->push_done)->len;
+		write->done = false;
+		stream->push_done++;
+	}
+
+	stream_advance(stream);
+}
+
+/*
+ * Push producer index write callback
+ *
+ * @status [in]: status of the write
+ * @user_data [in]: stream
+ */
+static void stream_doorbell_done_callback(doca_error_t status, void *user_data)
+{
+	struct dpu_stream *stream = (struct dpu_stream *)user_data;
+
+	stream->doorbell_inflight = false;
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to write the push producer index: %s", doca_error_get_descr(status));
+		stream_fail(stream, status);
+		return;
+	}
+
+	stream_advance(stream);
+}
+
+/*
+ * Push consumer line read callback
+ *
+ * @status [in]: status of the read
+ * @user_data [in]: stream
+ */
+static void stream_credit_done_callback(doca_error_t status, void *user_data)
+{
+	struct dpu_stream *stream = (struct dpu_stream *)user_data;
+
+	stream->credit_inflight = false;
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read the push consumer index: %s", doca_error_get_descr(status));
+		stream_fail(stream, status);
+		return;
+	}
+
+	stream->push_host_cons = stream->ctrl->rings[DMA_STREAM_PUSH].cons.cons_idx & DMA_STREAM_IDX_MASK;
+	stream_advance(stream);
+}
+
+/*
+ * Copy a word or a line between the local control lines and the host region
+ *
+ * @stream [in]: stream
+ * @offset [in]: offset of the word or line in both
+ * @len [in]: number of bytes
+ * @to_host [in]: whether to write the host copy, or else to read it
+ * @done_cb [in]: called once the copy is complete
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-doca_error_t dma_copy_dpu(char *export_desc_file_path, char *buffer_info_file_path, const char *pcie_addr)
+static doca_error_t stream_submit_ctrl(struct dpu_stream *stream,
+				       size_t offset,
+				       size_t len,
+				       bool to_host,
+				       dma_bulk_copy_done_cb_t done_cb)
 {
-	struct dma_resources resources;
-	struct program_core_objects *state = &resources.state;
-	struct doca_dma_task_memcpy *dma_task = NULL;
-	struct doca_task *task = NULL;
-	union doca_data task_user_data = {0};
-	struct doca_buf *src_doca_buf = NULL;
-	struct doca_buf *dst_doca_buf = NULL;
-	struct doca_mmap *remote_mmap = NULL;
-	char export_desc[1024] = {0};
-	char *remote_addr = NULL;
-	char *dpu_buffer;
-	size_t dst_buffer_size, remote_addr_len = 0, export_desc_len = 0;
-	size_t max_buffer_size;
+	char *local = (char *)stream->ctrl + offset;
+	char *remote = stream->remote_region + offset;
+
+	if (to_host)
+		return dma_bulk_copy_submit(stream->copier,
+					    stream->ctrl_mmap,
+					    local,
+					    stream->remote_mmap,
+					    remote,
+					    len,
+					    done_cb,
+					    stream);
+	return dma_bulk_copy_submit(stream->copier,
+				    stream->remote_mmap,
+				    remote,
+				    stream->ctrl_mmap,
+				    local,
+				    len,
+				    done_cb,
+				    stream);
+}
+
+/*
+ * Read the pull producer line of the host region
+ *
+ * @stream [in]: stream
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t stream_submit_poll(struct dpu_stream *stream)
+{
+	doca_error_t result;
+
+	result = stream_submit_ctrl(stream,
+				    offsetof(struct dma_stream_region, rings[DMA_STREAM_PULL].prod),
+				    sizeof(struct dma_stream_prod_line),
+				    false,
+				    stream_poll_done_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit read of the producer index: %s", doca_error_get_descr(result));
+		return result;
+	}
+	stream->poll_inflight = true;
+	stream->num_polls++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Issue whatever the push ring state allows: writes of messages while the host has free slots and local slots are
+ * free, the doorbell once more writes completed and a read of the push consumer line when the host ring is full.
+ * Once the pull ring is closed and every write completed, the final doorbell closes the push ring and the push side
+ * finishes when the host consumed all of it.
+ *
+ * @stream [in]: stream
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t stream_advance_push(struct dpu_stream *stream)
+{
+	struct stream_slot_op *write;
+	struct dma_stream_slot_hdr *hdr;
+	size_t remote_off;
+	bool final;
+	doca_error_t result;
+
+	if (!stream->push || stream->push_finished)
+		return DOCA_SUCCESS;
+
+	while (!stream->closed && stream->push_issued - stream->push_host_cons < stream->num_slots &&
+	       stream->push_issued - stream->push_done < stream->queue_depth) {
+		write = &stream->writes[stream->push_issued % stream->queue_depth];
+		write->idx = stream->push_issued;
+		hdr = stream_local_slot(stream, DMA_STREAM_PUSH, write->idx);
+		hdr->seq = write->idx;
+		remote_off = dma_stream_slot_offset(DMA_STREAM_PUSH, write->idx, stream->num_slots, stream->slot_size);
+		result = dma_bulk_copy_submit(stream->copier,
+					      stream->data_mmap,
+					      hdr,
+					      stream->remote_mmap,
+					      stream->remote_region + remote_off,
+					      sizeof(*hdr) + hdr->len,
+					      stream_write_done_callback,
+					      write);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit write of message %lu: %s",
+				     write->idx,
+				     doca_error_get_descr(result));
+			return result;
+		}
+		stream->push_issued++;
+	}
+
+	/* Only completed writes are published, the host may read their slots as soon as it sees the index */
+	final = stream->closed && stream->push_done == stream->push_issued;
+	if (!stream->doorbell_inflight && !stream->push_closed && (final || stream->push_rung != stream->push_done)) {
+		stream->ctrl->rings[DMA_STREAM_PUSH].prod.prod_idx = stream->push_done;
+		if (final)
+			stream->ctrl->rings[DMA_STREAM_PUSH].prod.prod_idx |= DMA_STREAM_IDX_FLAG;
+		result = stream_submit_ctrl(stream,
+					    offsetof(struct dma_stream_region, rings[DMA_STREAM_PUSH].prod.prod_idx),
+					    sizeof(uint64_t),
+					    true,
+					    stream_doorbell_done_callback);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit write of the push producer index: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+		stream->push_rung = stream->push_done;
+		stream->push_closed = final;
+		stream->doorbell_inflight = true;
+	}
+
+	if (stream->push_closed && !stream->doorbell_inflight && stream->push_host_cons == stream->push_done) {
+		stream->push_finished = true;
+		return DOCA_SUCCESS;
+	}
+
+	/* The host returns slots through its consumer line, which is only worth reading when the DPU waits for it */
+	if (stream->credit_inflight)
+		return DOCA_SUCCESS;
+	if (stream->push_issued - stream->push_host_cons < stream->num_slots &&
+	    !(stream->push_closed && !stream->doorbell_inflight))
+		return DOCA_SUCCESS;
+	result = stream_submit_ctrl(stream,
+				    offsetof(struct dma_stream_region, rings[DMA_STREAM_PUSH].cons),
+				    sizeof(uint64_t),
+				    false,
+				    stream_credit_done_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit read of the push consumer index: %s", doca_error_get_descr(result));
+		return result;
+	}
+	stream->credit_inflight = true;
+	stream->num_credit_polls++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Issue whatever the rings state allows: reads of the published slots while local slots are free, the next read of
+ * the pull producer line, the push side, and a write of the pull consumer index when it moved, the first write tells
+ * the host that the DPU attached. Once the pull ring is closed and drained, with no read of it left in flight, and
+ * the push side finished, the final acknowledgment detaches the DPU.
+ *
+ * @stream [in]: stream
+ */
+static void stream_advance(struct dpu_stream *stream)
+{
+	struct stream_slot_op *read;
+	size_t remote_off;
+	doca_error_t result;
+
+	if (stream->result != DOCA_SUCCESS)
+		return;
+
+	while (stream->issued_idx < stream->prod_idx && stream->issued_idx - stream->cons_idx < stream->queue_depth) {
+		read = &stream->reads[stream->issued_idx % stream->queue_depth];
+		read->idx = stream->issued_idx;
+		remote_off = dma_stream_slot_offset(DMA_STREAM_PULL, read->idx, stream->num_slots, stream->slot_size);
+		result = dma_bulk_copy_submit(stream->copier,
+					      stream->remote_mmap,
+					      stream->remote_region + remote_off,
+					      stream->data_mmap,
+					      stream_local_slot(stream, DMA_STREAM_PULL, read->idx),
+					      stream->slot_size,
+					      stream_read_done_callback,
+					      read);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit read of message %lu: %s",
+				     read->idx,
+				     doca_error_get_descr(result));
+			stream_fail(stream, result);
+			return;
+		}
+		stream->issued_idx++;
+	}
+
+	if (!stream->poll_inflight && !stream->closed) {
+		result = stream_submit_poll(stream);
+		if (result != DOCA_SUCCESS) {
+			stream_fail(stream, result);
+			return;
+		}
+	}
+
+	result = stream_advance_push(stream);
+	if (result != DOCA_SUCCESS) {
+		stream_fail(stream, result);
+		return;
+	}
+
+	if (stream->ack_inflight)
+		return;
+
+	if (stream->closed && !stream->poll_inflight && stream->cons_idx == stream->prod_idx &&
+	    (!stream->push || stream->push_finished))
+		stream->ctrl->rings[DMA_STREAM_PULL].cons.cons_idx = stream->cons_idx | DMA_STREAM_IDX_FLAG;
+	else if (stream->cons_idx != stream->acked_idx)
+		stream->ctrl->rings[DMA_STREAM_PULL].cons.cons_idx = stream->cons_idx;
+	else
+		return;
+
+	/* The index only covers messages whose reads completed, the host can overwrite their slots */
+	result = stream_submit_ctrl(stream,
+				    offsetof(struct dma_stream_region, rings[DMA_STREAM_PULL].cons),
+				    sizeof(uint64_t),
+				    true,
+				    stream_ack_done_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit write of the consumer index: %s", doca_error_get_descr(result));
+		stream_fail(stream, result);
+		return;
+	}
+	stream->acked_idx = stream->cons_idx;
+	stream->ack_inflight = true;
+}
+
+/*
+ * Fill the local push slots with their message, only the sequence number changes from one message to the next
+ *
+ * @stream [in]: stream
+ */
+static void stream_fill_push_slots(struct dpu_stream *stream)
+{
+	struct dma_stream_slot_hdr *hdr;
+	uint32_t payload_len = stream->slot_size - sizeof(*hdr), i, j;
+	char *payload;
+
+	for (i = 0; i < stream->queue_depth; i++) {
+		hdr = stream_local_slot(stream, DMA_STREAM_PUSH, i);
+		payload = (char *)(hdr + 1);
+		for (j = 0; j < payload_len; j++)
+			payload[j] = (char)('a' + j % 26);
+		hdr->len = payload_len;
+		hdr->crc = checksum_crc32c(0, payload, payload_len);
+	}
+}
+
+/* A chunk of the file being read */
+struct file_chunk_op {
+	struct dpu_file *file; /* File pull the chunk belongs to */
+	char *local;	       /* Local buffer the chunk is read into */
+	uint64_t offset;       /* Offset of the chunk in the file */
+	uint64_t len;	       /* Length of the chunk */
+};
+
+/* DPU side of a file pull */
+struct dpu_file {
+	struct dma_bulk_copy *copier;	    /* Copier of every chunk read and control region access */
+	struct doca_pe *pe;		    /* PE the copier is connected to */
+	struct doca_dev *dev;		    /* Device the windows are imported to */
+	struct doca_mmap *ctrl_remote_mmap; /* Host control region, from the export */
+	char *ctrl_remote;		    /* Host address of the control region */
+	struct doca_mmap *ctrl_mmap;	    /* Local copy of the control region */
+	struct dma_file_ctrl *ctrl;	    /* Lines read from and written to the host */
+	bool ctrl_inflight;		    /* Whether a control region access is in flight */
+	struct doca_mmap *remote_mmap;	    /* Current window, from its export */
+	char *remote_addr;		    /* Host address of the current window */
+	uint64_t window_offset;		    /* Offset of the current window in the file */
+	uint64_t window_end;		    /* End of the current window in the file */
+	uint64_t file_size;		    /* Size of the file */
+	struct doca_mmap *local_mmap;	    /* Local chunk buffers */
+	int out_fd;			    /* File the chunks are written to */
+	uint64_t issued;		    /* Bytes read or being read */
+	uint64_t done;			    /* Bytes read and written */
+	uint32_t inflight;		    /* Chunk reads in flight */
+	uint64_t first_submit_ns;	    /* Submission of the first chunk */
+	uint64_t first_byte_ns;		    /* Arrival of the first chunk */
+	uint64_t write_ns;		    /* Time spent writing chunks out */
+	doca_error_t result;		    /* First error */
+};
+
+static void file_chunk_done_callback(doca_error_t status, void *user_data);
+
+/*
+ * Read the next chunk of the current window into a local buffer, if any is left
+ *
+ * @chunk [in]: chunk whose local buffer is free
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_submit_chunk(struct file_chunk_op *chunk)
+{
+	struct dpu_file *file = chunk->file;
+	doca_error_t result;
+
+	if (file->issued == file->window_end || file->result != DOCA_SUCCESS)
+		return DOCA_SUCCESS;
+
+	chunk->offset = file->issued;
+	chunk->len = file->window_end - file->issued;
+	if (chunk->len > FILE_CHUNK_SIZE)
+		chunk->len = FILE_CHUNK_SIZE;
+	result = dma_bulk_copy_submit(file->copier,
+				      file->remote_mmap,
+				      file->remote_addr + (chunk->offset - file->window_offset),
+				      file->local_mmap,
+				      chunk->local,
+				      chunk->len,
+				      file_chunk_done_callback,
+				      chunk);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit read of the file at offset %lu: %s",
+			     chunk->offset,
+			     doca_error_get_descr(result));
+		return result;
+	}
+	file->issued += chunk->len;
+	file->inflight++;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Chunk read callback, writes the chunk out at its offset and reads the next one into the same buffer
+ *
+ * @status [in]: status of the read
+ * @user_data [in]: chunk
+ */
+static void file_chunk_done_callback(doca_error_t status, void *user_data)
+{
+	struct file_chunk_op *chunk = (struct file_chunk_op *)user_data;
+	struct dpu_file *file = chunk->file;
+	uint64_t written = 0, start_ns;
+	ssize_t ret;
+
+	file->inflight--;
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read the file at offset %lu: %s", chunk->offset, doca_error_get_descr(status));
+		DOCA_ERROR_PROPAGATE(file->result, status);
+		return;
+	}
+	if (file->first_byte_ns == 0)
+		file->first_byte_ns = bench_get_time_ns();
+
+	start_ns = bench_get_time_ns();
+	while (written < chunk->len) {
+		ret = pwrite(file->out_fd, chunk->local + written, chunk->len - written, chunk->offset + written);
+		if (ret < 0 && errno == EINTR)
+			continue;
+		if (ret <= 0) {
+			DOCA_LOG_ERR("Failed to write the file at offset %lu: %s",
+				     chunk->offset + written,
+				     ret < 0 ? strerror(errno) : "no progress");
+			DOCA_ERROR_PROPAGATE(file->result, DOCA_ERROR_IO_FAILED);
+			return;
+		}
+		written += ret;
+	}
+	file->write_ns += bench_get_time_ns() - start_ns;
+	file->done += chunk->len;
+
+	DOCA_ERROR_PROPAGATE(file->result, file_submit_chunk(chunk));
+}
+
+/*
+ * Control region access callback
+ *
+ * @status [in]: status of the access
+ * @user_data [in]: file pull
+ */
+static void file_ctrl_done_callback(doca_error_t status, void *user_data)
+{
+	struct dpu_file *file = (struct dpu_file *)user_data;
+
+	file->ctrl_inflight = false;
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to access the control region: %s", doca_error_get_descr(status));
+		DOCA_ERROR_PROPAGATE(file->result, status);
+	}
+}
+
+/*
+ * Copy lines of the control region between the host and the local copy, and wait until the copy is done
+ *
+ * @file [in]: file pull, with no chunk read in flight
+ * @offset [in]: offset of the lines in both
+ * @len [in]: number of bytes
+ * @to_host [in]: whether to write the host copy, or else to read it
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_ctrl_copy(struct dpu_file *file, size_t offset, size_t len, bool to_host)
+{
+	char *local = (char *)file->ctrl + offset;
+	char *remote = file->ctrl_remote + offset;
+	doca_error_t result;
+
+	if (to_host)
+		result = dma_bulk_copy_submit(file->copier,
+					      file->ctrl_mmap,
+					      local,
+					      file->ctrl_remote_mmap,
+					      remote,
+					      len,
+					      file_ctrl_done_callback,
+					      file);
+	else
+		result = dma_bulk_copy_submit(file->copier,
+					      file->ctrl_remote_mmap,
+					      remote,
+					      file->ctrl_mmap,
+					      local,
+					      len,
+					      file_ctrl_done_callback,
+					      file);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit access to the control region: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	file->ctrl_inflight = true;
+	while (file->ctrl_inflight)
+		(void)doca_pe_progress(file->pe);
+
+	return file->result;
+}
+
+/*
+ * Acknowledge a window to the host, after which the host releases it
+ *
+ * @file [in]: file pull, with no chunk read in flight
+ * @seq [in]: number of the window, 0 to attach
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_ack_window(struct dpu_file *file, uint64_t seq)
+{
+	file->ctrl->ack.seq = seq;
+	return file_ctrl_copy(file, offsetof(struct dma_file_ctrl, ack), sizeof(struct dma_file_seq_line), true);
+}
+
+/*
+ * Wait until the host publishes a window, then read it and import its export
+ *
+ * @file [in]: file pull, with no window imported
+ * @seq [in]: number of the window
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_import_window(struct dpu_file *file, uint64_t seq)
+{
+	const struct dma_file_window *window = &file->ctrl->window;
 	struct timespec ts = {
 		.tv_sec = 0,
 		.tv_nsec = SLEEP_IN_NANOS,
 	};
-	doca_error_t result, tmp_result, task_result;
+	doca_error_t result;
 
-	/* Allocate resources */
-	result = allocate_dma_resources(pcie_addr, &resources);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+	for (;;) {
+		result = file_ctrl_copy(file,
+					offsetof(struct dma_file_ctrl, publish),
+					sizeof(struct dma_file_seq_line),
+					false);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if (file->ctrl->publish.seq == seq)
+			break;
+		nanosleep(&ts, NULL);
+	}
+
+	/* The host rewrites the window line only after the acknowledgment of the previous window */
+	result = file_ctrl_copy(file, offsetof(struct dma_file_ctrl, window), sizeof(*window), false);
+	if (result != DOCA_SUCCESS)
 		return result;
+
+	if (seq == 1)
+		file->file_size = window->file_size;
+	if (window->file_size != file->file_size || window->offset != file->done || window->len == 0 ||
+	    window->len > window->file_size - window->offset || window->desc_len > DMA_FILE_DESC_MAX_LEN) {
+		DOCA_LOG_ERR("Window %lu of the control region is corrupted", seq);
+		return DOCA_ERROR_BAD_STATE;
 	}
 
-	/* Connect context to progress engine */
-	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	result = doca_mmap_create_from_export(NULL,
+					      (const void *)window->desc,
+					      window->desc_len,
+					      file->dev,
+					      &file->remote_mmap);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
-		goto destroy_resources;
+		DOCA_LOG_ERR("Failed to create mmap from the export of window %lu: %s",
+			     seq,
+			     doca_error_get_descr(result));
+		return result;
 	}
+	file->remote_addr = (char *)(uintptr_t)window->addr;
+	file->window_offset = window->offset;
+	file->window_end = window->offset + window->len;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Release the export of the current window, if any
+ *
+ * @file [in]: file pull, with no chunk read in flight
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_release_window(struct dpu_file *file)
+{
+	doca_error_t result;
+
+	if (file->remote_mmap == NULL)
+		return DOCA_SUCCESS;
+
+	result = doca_mmap_destroy(file->remote_mmap);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to destroy window mmap: %s", doca_error_get_descr(result));
+	file->remote_mmap = NULL;
+
+	return result;
+}
+
+/*
+ * Pull a file the host exported window by window and write it to a local file
+ *
+ * The DPU attaches to the host control region, then for every window the host publishes keeps queue_depth chunk
+ * reads in flight straight from the window export, a mapping of the page cache of the file or a copy of it depending
+ * on the host file mode, and acknowledges the window once all of it is written out (@see dma_file_window.h). The
+ * time-to-first-byte is reported from the start of the sample, which includes attaching and waiting for the first
+ * window, and from the submission of the first read.
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @queue_depth [in]: Number of chunk reads kept in flight
+ * @file_path [in]: File to write the pulled file to
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t dma_copy_dpu_file(const char *export_desc_file_path,
+				      const char *buffer_info_file_path,
+				      const char *pcie_addr,
+				      uint32_t queue_depth,
+				      const char *file_path)
+{
+	struct program_core_objects state = {0};
+	struct dpu_file file = {.out_fd = -1};
+	struct file_chunk_op *chunks = NULL;
+	char export_desc[1024] = {0};
+	char *local = NULL;
+	size_t remote_addr_len = 0, export_desc_len = 0, local_size;
+	uint64_t start_ns, end_ns, total_chunks, seq = 1;
+	double elapsed_ns;
+	uint32_t num_chunks, i;
+	struct timespec ts = {
+		.tv_sec = 0,
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	doca_error_t result, tmp_result;
+
+	start_ns = bench_get_time_ns();
 
-	result = doca_ctx_start(state->ctx);
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &state.dev);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
-		goto destroy_resources;
+		DOCA_LOG_ERR("Failed to open DOCA device for DMA: %s", doca_error_get_descr(result));
+		return result;
 	}
 
-	/* Get maximum buffer size allowed */
-	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->dev), &max_buffer_size);
+	/* The copier brings its own inventory */
+	result = create_core_objects(&state, 0);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to get max buffer size: %s", doca_error_get_descr(result));
-		goto stop_dma;
+		DOCA_LOG_ERR("Failed to create DOCA core objects: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
+	file.pe = state.pe;
+	file.dev = state.dev;
+	file.ctrl_mmap = state.src_mmap;
+	file.local_mmap = state.dst_mmap;
 
-	/* Copy all relevant information into local buffers */
 	result = save_config_info_to_buffers(export_desc_file_path,
 					     buffer_info_file_path,
 					     export_desc,
 					     &export_desc_len,
-					     &remote_addr,
+					     &file.ctrl_remote,
 					     &remote_addr_len);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
-		goto stop_dma;
+		goto destroy_core_objects;
 	}
-
-	if (remote_addr_len == 0) {
-		result = DOCA_ERROR_EMPTY;
-		DOCA_LOG_ERR("Remote buffer from host is zero: failed to parse the buffer information file");
-		goto stop_dma;
-	} else if (remote_addr_len > max_buffer_size) {
-		result = DOCA_ERROR_TOO_BIG;
-		DOCA_LOG_ERR("Remote buffer from Host exceeds max allowed buffer: %zu > %zu",
-			     remote_addr_len,
-			     max_buffer_size);
-		goto stop_dma;
+	if (remote_addr_len < sizeof(struct dma_file_ctrl)) {
+		result = DOCA_ERROR_INVALID_VALUE;
+		DOCA_LOG_ERR("Remote buffer of %zu bytes can't hold a file control region", remote_addr_len);
+		goto destroy_core_objects;
 	}
 
-	/* Copy the entire host buffer */
-	dst_buffer_size = remote_addr_len;
-	dpu_buffer = (char *)malloc(dst_buffer_size);
-	if (dpu_buffer == NULL) {
+	file.ctrl = aligned_alloc(DMA_FILE_LINE_SIZE, sizeof(*file.ctrl));
+	if (file.ctrl == NULL) {
 		result = DOCA_ERROR_NO_MEMORY;
-		DOCA_LOG_ERR("Failed to allocate buffer memory: %s", doca_error_get_descr(result));
-		goto stop_dma;
+		DOCA_LOG_ERR("Failed to allocate the control region copy");
+		goto destroy_core_objects;
 	}
+	memset(file.ctrl, 0, sizeof(*file.ctrl));
 
-	result = doca_mmap_set_memrange(state->dst_mmap, dpu_buffer, dst_buffer_size);
+	result = doca_mmap_set_memrange(file.ctrl_mmap, file.ctrl, sizeof(*file.ctrl));
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(file.ctrl_mmap);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to set memory range for destination mmap: %s", doca_error_get_descr(result));
-		goto free_dpu_buffer;
+		DOCA_LOG_ERR("Failed to register the control region copy: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
 
-	result = doca_mmap_start(state->dst_mmap);
+	result = doca_mmap_create_from_export(NULL,
+					      (const void *)export_desc,
+					      export_desc_len,
+					      state.dev,
+					      &file.ctrl_remote_mmap);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to start destination mmap: %s", doca_error_get_descr(result));
-		goto free_dpu_buffer;
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
 
-	/* Create a local DOCA mmap from exported data */
-	result =
-		doca_mmap_create_from_export(NULL, (const void *)export_desc, export_desc_len, state->dev, &remote_mmap);
+	/* Control region accesses are only issued while no chunk read is in flight */
+	result = dma_bulk_copy_create(state.dev, state.pe, queue_depth, 0, 0, &file.copier);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ctrl_mmap;
+
+	result = file_ack_window(&file, 0);
+	if (result != DOCA_SUCCESS)
+		goto destroy_copier;
+	result = file_import_window(&file, seq);
+	if (result != DOCA_SUCCESS)
+		goto destroy_copier;
+
+	/* No more local buffers than chunks in the file */
+	total_chunks = (file.file_size + FILE_CHUNK_SIZE - 1) / FILE_CHUNK_SIZE;
+	num_chunks = total_chunks < queue_depth ? total_chunks : queue_depth;
+	local_size = (size_t)num_chunks * FILE_CHUNK_SIZE;
+	local = aligned_alloc(PAGE_SIZE, local_size);
+	chunks = calloc(num_chunks, sizeof(*chunks));
+	if (local == NULL || chunks == NULL) {
+		result = DOCA_ERROR_NO_MEMORY;
+		DOCA_LOG_ERR("Failed to allocate %u chunks of %u bytes", num_chunks, FILE_CHUNK_SIZE);
+		goto destroy_copier;
+	}
+	for (i = 0; i < num_chunks; i++) {
+		chunks[i].file = &file;
+		chunks[i].local = local + (size_t)i * FILE_CHUNK_SIZE;
+	}
+
+	result = doca_mmap_set_memrange(file.local_mmap, local, local_size);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(file.local_mmap);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
-		goto free_dpu_buffer;
+		DOCA_LOG_ERR("Failed to register the chunk buffers: %s", doca_error_get_descr(result));
+		goto destroy_copier;
 	}
 
-	/* Construct DOCA buffer for each address range */
-	result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
-						    remote_mmap,
-						    remote_addr,
-						    remote_addr_len,
-						    &src_doca_buf);
+	file.out_fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file.out_fd < 0) {
+		result = DOCA_ERROR_IO_FAILED;
+		DOCA_LOG_ERR("Failed to create %s: %s", file_path, strerror(errno));
+		goto destroy_copier;
+	}
+
+	file.first_submit_ns = bench_get_time_ns();
+	for (;;) {
+		for (i = 0; i < num_chunks && file.result == DOCA_SUCCESS; i++)
+			DOCA_ERROR_PROPAGATE(file.result, file_submit_chunk(&chunks[i]));
+		while (file.inflight != 0) {
+			if (doca_pe_progress(state.pe) == 0)
+				nanosleep(&ts, &ts);
+		}
+		result = file.result;
+		if (result != DOCA_SUCCESS)
+			break;
+
+		/* Every chunk of the window is written out, the host can release it */
+		result = file_release_window(&file);
+		if (result != DOCA_SUCCESS)
+			break;
+		result = file_ack_window(&file, seq);
+		if (result != DOCA_SUCCESS || file.done == file.file_size)
+			break;
+
+		result = file_import_window(&file, ++seq);
+		if (result != DOCA_SUCCESS)
+			break;
+	}
+	end_ns = bench_get_time_ns();
+
+	if (result == DOCA_SUCCESS) {
+		elapsed_ns = (double)(end_ns - file.first_submit_ns);
+		DOCA_LOG_INFO("First byte after %.3f ms from the start, %.3f us from the first read",
+			      (double)(file.first_byte_ns - start_ns) / 1e6,
+			      (double)(file.first_byte_ns - file.first_submit_ns) / 1e3);
+		DOCA_LOG_INFO("Pulled %lu bytes in %lu windows in %.3f s: %.3f GB/s, %.3f s of which writing %s",
+			      file.done,
+			      seq,
+			      elapsed_ns / 1e9,
+			      (double)file.done / elapsed_ns,
+			      (double)file.write_ns / 1e9,
+			      file_path);
+	}
+
+destroy_copier:
+	/* Flushes whatever is still in flight before the memory it targets goes away */
+	tmp_result = dma_bulk_copy_destroy(file.copier);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA bulk copier: %s", doca_error_get_descr(tmp_result));
+	}
+	tmp_result = file_release_window(&file);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	if (file.out_fd >= 0 && close(file.out_fd) != 0 && result == DOCA_SUCCESS) {
+		result = DOCA_ERROR_IO_FAILED;
+		DOCA_LOG_ERR("Failed to close %s: %s", file_path, strerror(errno));
+	}
+destroy_ctrl_mmap:
+	tmp_result = doca_mmap_destroy(file.ctrl_remote_mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy remote mmap: %s", doca_error_get_descr(tmp_result));
+	}
+destroy_core_objects:
+	/* Also closes the device */
+	tmp_result = destroy_core_objects(&state);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DOCA core objects: %s", doca_error_get_descr(tmp_result));
+	}
+	free(chunks);
+	free(local);
+	free(file.ctrl);
+
+	return result;
+}
+
+/*
+ * Run DOCA DMA DPU copy sample
+ *
+ * The host exports its streaming region once, the DPU attaches to it, then keeps queue_depth slot reads in flight and
+ * acknowledges every message it consumed until the host closes the pull ring. When the host set up a push ring the
+ * DPU also keeps queue_depth slot writes in flight towards it and publishes them through its doorbell, both
+ * directions share the progress engine so they run concurrently.
+ * When a file is given the host exported a file instead, see dma_copy_dpu_file().
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @queue_depth [in]: Number of slot reads, and of slot writes, kept in flight
+ * @file_path [in]: File to write a pulled file to, empty to stream messages
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_copy_dpu(const char *export_desc_file_path,
+			  const char *buffer_info_file_path,
+			  const char *pcie_addr,
+			  uint32_t queue_depth,
+			  const char *file_path)
+{
+	struct program_core_objects state = {0};
+	struct dpu_stream stream = {0};
+	struct dma_stream_prod_line *push_prod;
+	char export_desc[1024] = {0};
+	size_t remote_addr_len = 0, export_desc_len = 0, data_size = 0;
+	uint64_t start_ns, attach_ns, end_ns;
+	double elapsed_ns;
+	uint32_t i;
+	struct timespec ts = {
+		.tv_sec = 0,
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	doca_error_t result, tmp_result;
+
+	if (file_path[0] != '\0')
+		return dma_copy_dpu_file(export_desc_file_path,
+					 buffer_info_file_path,
+					 pcie_addr,
+					 queue_depth,
+					 file_path);
+
+	start_ns = bench_get_time_ns();
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &state.dev);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to acquire DOCA buffer representing remote buffer: %s",
-			     doca_error_get_descr(result));
-		goto destroy_remote_mmap;
+		DOCA_LOG_ERR("Failed to open DOCA device for DMA: %s", doca_error_get_descr(result));
+		return result;
 	}
 
-	/* Construct DOCA buffer for each address range */
-	result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
-						    state->dst_mmap,
-						    dpu_buffer,
-						    dst_buffer_size,
-						    &dst_doca_buf);
+	/* The copier brings its own inventory */
+	result = create_core_objects(&state, 0);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to acquire DOCA buffer representing destination buffer: %s",
-			     doca_error_get_descr(result));
-		goto destroy_src_buf;
+		DOCA_LOG_ERR("Failed to create DOCA core objects: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
+	stream.ctrl_mmap = state.src_mmap;
+	stream.data_mmap = state.dst_mmap;
+	stream.queue_depth = queue_depth;
 
-	/* Set data position in src_buff */
-	result = doca_buf_set_data(src_doca_buf, remote_addr, dst_buffer_size);
+	/* Copy all relevant information into local buffers */
+	result = save_config_info_to_buffers(export_desc_file_path,
+					     buffer_info_file_path,
+					     export_desc,
+					     &export_desc_len,
+					     &stream.remote_region,
+					     &remote_addr_len);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to set data for DOCA source buffer: %s", doca_error_get_descr(result));
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
+	}
+
+	if (remote_addr_len < sizeof(struct dma_stream_region)) {
+		result = DOCA_ERROR_INVALID_VALUE;
+		DOCA_LOG_ERR("Remote buffer of %zu bytes can't hold a streaming region", remote_addr_len);
+		goto destroy_core_objects;
+	}
 
-		goto destroy_dst_buf;
+	stream.ctrl = aligned_alloc(DMA_STREAM_LINE_SIZE, sizeof(*stream.ctrl));
+	if (stream.ctrl == NULL) {
+		result = DOCA_ERROR_NO_MEMORY;
+		DOCA_LOG_ERR("Failed to allocate the ring control lines");
+		goto destroy_core_objects;
 	}
+	memset(stream.ctrl, 0, sizeof(*stream.ctrl));
 
-	/* Include result in user data of task to be used in the callbacks */
-	task_user_data.ptr = &task_result;
+	result = doca_mmap_set_memrange(stream.ctrl_mmap, stream.ctrl, sizeof(*stream.ctrl));
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(stream.ctrl_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register the ring control lines: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
+	}
 
-	/* Allocate and construct DMA task */
-	result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx,
-						 src_doca_buf,
-						 dst_doca_buf,
-						 task_user_data,
-						 &dma_task);
+	/* Create a local DOCA mmap from exported data, once for the whole stream */
+	result = doca_mmap_create_from_export(NULL,
+					      (const void *)export_desc,
+					      export_desc_len,
+					      state.dev,
+					      &stream.remote_mmap);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
-		goto destroy_dst_buf;
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
-	/* Number of tasks submitted to progress engine */
-	resources.num_remaining_tasks = 1;
 
-	task = doca_dma_task_memcpy_as_task(dma_task);
+	/* Room for the reads and writes in flight, both index writes and both index reads */
+	result = dma_bulk_copy_create(state.dev, state.pe, 2 * queue_depth + 4, 0, 0, &stream.copier);
+	if (result != DOCA_SUCCESS)
+		goto destroy_remote_mmap;
 
-	/* Submit DMA task */
-	result = doca_task_submit(task);
+	/* The first read takes every control line, which gives the geometry of both rings */
+	result = stream_submit_ctrl(&stream, 0, sizeof(*stream.ctrl), false, stream_poll_done_callback);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
-		doca_task_free(task);
-		goto destroy_dst_buf;
+		DOCA_LOG_ERR("Failed to submit read of the control lines: %s", doca_error_get_descr(result));
+		goto destroy_copier;
 	}
+	stream.poll_inflight = true;
+	while (stream.poll_inflight)
+		(void)doca_pe_progress(state.pe);
+	result = stream.result;
+	if (result != DOCA_SUCCESS)
+		goto destroy_copier;
 
-	resources.run_pe_progress = true;
+	stream.num_slots = stream.ctrl->rings[DMA_STREAM_PULL].prod.num_slots;
+	stream.slot_size = stream.ctrl->rings[DMA_STREAM_PULL].prod.slot_size;
+	push_prod = &stream.ctrl->rings[DMA_STREAM_PUSH].prod;
+	stream.push = push_prod->magic == DMA_STREAM_MAGIC && push_prod->num_slots != 0;
+	if (stream.ctrl->rings[DMA_STREAM_PULL].prod.magic != DMA_STREAM_MAGIC || stream.num_slots == 0 ||
+	    stream.slot_size <= sizeof(struct dma_stream_slot_hdr) ||
+	    (stream.push && (push_prod->num_slots != stream.num_slots || push_prod->slot_size != stream.slot_size)) ||
+	    dma_stream_region_size(stream.num_slots, stream.slot_size, stream.push) > remote_addr_len) {
+		result = DOCA_ERROR_INVALID_VALUE;
+		DOCA_LOG_ERR("Remote buffer does not hold a streaming region");
+		goto destroy_copier;
+	}
 
-	/* Wait for all tasks to be completed and context stopped */
-	while (resources.run_pe_progress) {
-		if (doca_pe_progress(state->pe) == 0)
-			nanosleep(&ts, &ts);
+	data_size = (stream.push ? 2 : 1) * (size_t)queue_depth * stream.slot_size;
+	stream.data = aligned_alloc(DMA_STREAM_LINE_SIZE, data_size);
+	stream.reads = calloc(queue_depth, sizeof(*stream.reads));
+	stream.writes = calloc(queue_depth, sizeof(*stream.writes));
+	if (stream.data == NULL || stream.reads == NULL || stream.writes == NULL) {
+		result = DOCA_ERROR_NO_MEMORY;
+		DOCA_LOG_ERR("Failed to allocate %u local slots of %u bytes", queue_depth, stream.slot_size);
+		goto destroy_copier;
+	}
+	for (i = 0; i < queue_depth; i++) {
+		stream.reads[i].stream = &stream;
+		stream.writes[i].stream = &stream;
 	}
+	if (stream.push)
+		stream_fill_push_slots(&stream);
 
-	/* Check result of task according to the result we update in the callbacks */
-	if (task_result == DOCA_SUCCESS) {
-		DOCA_LOG_INFO("Remote DMA copy was done Successfully");
-		dpu_buffer[dst_buffer_size - 1] = '\0';
-		DOCA_LOG_INFO("Memory content: %s", dpu_buffer);
-	} else
-		DOCA_LOG_ERR("DMA memcpy task failed: %s", doca_error_get_descr(task_result));
+	result = doca_mmap_set_memrange(stream.data_mmap, stream.data, data_size);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(stream.data_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register the local slots: %s", doca_error_get_descr(result));
+		goto destroy_copier;
+	}
 
-	result = task_result;
+	attach_ns = bench_get_time_ns();
+	DOCA_LOG_INFO("Attached to %s of %u slots of %u bytes after %.3f ms, %u operations in flight per direction",
+		      stream.push ? "pull and push rings" : "a pull ring",
+		      stream.num_slots,
+		      stream.slot_size,
+		      (double)(attach_ns - start_ns) / 1e6,
+		      queue_depth);
 
-	/* Inform host that DMA operation is done */
-	DOCA_LOG_INFO("Host sample can be closed, DMA copy ended");
+	/* The first acknowledgment tells the host the DPU attached */
+	stream.attached = true;
+	stream.acked_idx = DMA_STREAM_IDX_NONE;
+	stream_advance(&stream);
+	while (!stream.detached && stream.result == DOCA_SUCCESS) {
+		if (doca_pe_progress(state.pe) == 0)
+			nanosleep(&ts, &ts);
+	}
+	end_ns = bench_get_time_ns();
+	result = stream.result;
 
-destroy_dst_buf:
-	tmp_result = doca_buf_dec_refcount(dst_doca_buf, NULL);
-	if (tmp_result != DOCA_SUCCESS) {
-		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to decrease DOCA destination buffer reference count: %s",
-			     doca_error_get_descr(tmp_result));
+	if (result == DOCA_SUCCESS) {
+		elapsed_ns = (double)(end_ns - attach_ns);
+		DOCA_LOG_INFO("Pulled %lu messages, %lu bytes in %.3f s: %.3f GB/s, %.2f producer polls per message",
+			      stream.cons_idx,
+			      stream.num_bytes,
+			      elapsed_ns / 1e9,
+			      (double)stream.num_bytes / elapsed_ns,
+			      stream.cons_idx == 0 ? 0.0 : (double)stream.num_polls / (double)stream.cons_idx);
+		if (stream.push)
+			DOCA_LOG_INFO("Pushed %lu messages, %lu bytes in %.3f s: %.3f GB/s, %lu consumer polls",
+				      stream.push_done,
+				      stream.push_bytes,
+				      elapsed_ns / 1e9,
+				      (double)stream.push_bytes / elapsed_ns,
+				      stream.num_credit_polls);
+		DOCA_LOG_INFO("Host sample can be closed, DMA stream ended");
 	}
-destroy_src_buf:
-	tmp_result = doca_buf_dec_refcount(src_doca_buf, NULL);
+
+destroy_copier:
+	/* Flushes whatever is still in flight before the memory it targets goes away */
+	tmp_result = dma_bulk_copy_destroy(stream.copier);
 	if (tmp_result != DOCA_SUCCESS) {
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to decrease DOCA source buffer reference count: %s",
-			     doca_error_get_descr(tmp_result));
+		DOCA_LOG_ERR("Failed to destroy DMA bulk copier: %s", doca_error_get_descr(tmp_result));
 	}
 destroy_remote_mmap:
-	tmp_result = doca_mmap_destroy(remote_mmap);
-	if (tmp_result != DOCA_SUCCESS) {
-		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to decrease remote mmap: %s", doca_error_get_descr(tmp_result));
-	}
-free_dpu_buffer:
-	free(dpu_buffer);
-stop_dma:
-	tmp_result = doca_ctx_stop(state->ctx);
+	tmp_result = doca_mmap_destroy(stream.remote_mmap);
 	if (tmp_result != DOCA_SUCCESS) {
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+		DOCA_LOG_ERR("Failed to destroy remote mmap: %s", doca_error_get_descr(tmp_result));
 	}
-	state->ctx = NULL;
-destroy_resources:
-	tmp_result = destroy_dma_resources(&resources);
+destroy_core_objects:
+	/* Also closes the device */
+	tmp_result = destroy_core_objects(&state);
 	if (tmp_result != DOCA_SUCCESS) {
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+		DOCA_LOG_ERR("Failed to destroy DOCA core objects: %s", doca_error_get_descr(tmp_result));
 	}
+	free(stream.writes);
+	free(stream.reads);
+	free(stream.data);
+	free(stream.ctrl);
 
 	return result;
 }
@@ -35,11 +35,11 @@
 DOCA_LOG_REGISTER(DMA_COPY_HOST::MAIN);
 
 /* Sample's Logic */
-doca_error_t dma_copy_host(const char *pcie_addr,
-			   char *src_buffer,
-			   size_t src_buffer_size,
-			   char *export_desc_file_path,
-			   char *buffer_info_file_path);
+doca_error_t dma_copy_host(const struct dma_config *cfg);
+
+#define DEFAULT_NUM_SLOTS (64)	  /* Default number of slots of the streaming ring */
+#define DEFAULT_SLOT_SIZE (65536) /* Default size of a slot of the streaming ring */
+#define DEFAULT_RUN_TIME_SEC (10) /* Default time to stream for */
 
 /*
  * Sample main function
@@ -51,8 +51,6 @@ doca_error_t dma_copy_host(const char *pcie_addr,
 int main(int argc, char **argv)
 {
 	struct dma_config dma_conf;
-	char *src_buffer;
-	size_t length;
 	doca_error_t result;
 	struct doca_log_backend *sdk_log;
 	int exit_status = EXIT_FAILURE;
@@ -62,6 +60,13 @@ int main(int argc, char **argv)
 	strcpy(dma_conf.cpy_txt, "This is a sample piece of text");
 	strcpy(dma_conf.export_desc_path, "/tmp/export_desc.txt");
 	strcpy(dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+	dma_conf.num_slots = DEFAULT_NUM_SLOTS;
+	dma_conf.slot_size = DEFAULT_SLOT_SIZE;
+	dma_conf.run_time_sec = DEFAULT_RUN_TIME_SEC;
+	dma_conf.stream_pull = true;
+	dma_conf.stream_push = false;
+	dma_conf.file_path[0] = '\0';
+	dma_conf.file_zero_copy = true;
 
 	/* Register a logger backend */
 	result = doca_log_backend_create_standard();
@@ -99,30 +104,14 @@ int main(int argc, char **argv)
 		goto argp_cleanup;
 	}
 
-	length = strlen(dma_conf.cpy_txt) + 1;
-	src_buffer = (char *)malloc(length);
-	if (src_buffer == NULL) {
-		DOCA_LOG_ERR("Source buffer allocation failed");
-		goto argp_cleanup;
-	}
-
-	memcpy(src_buffer, dma_conf.cpy_txt, length);
-
-	result = dma_copy_host(dma_conf.pci_address,
-			       src_buffer,
-			       length,
-			       dma_conf.export_desc_path,
-			       dma_conf.buf_info_path);
+	result = dma_copy_host(&dma_conf);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("dma_copy_host() encountered an error: %s", doca_error_get_descr(result));
-		goto src_buf_cleanup;
+		goto argp_cleanup;
 	}
 
 	exit_status = EXIT_SUCCESS;
 
-src_buf_cleanup:
-	if (src_buffer != NULL)
-		free(src_buffer);
 argp_cleanup:
 	doca_argp_destroy();
 sample_exit:
@@ -23,22 +23,36 @@
  *
  */
 
+#include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
 
 #include <doca_dma.h>
 #include <doca_error.h>
 #include <doca_log.h>
 #include <doca_mmap.h>
 
+#include "bench_common.h"
+#include "checksum.h"
 #include "dma_common.h"
+#include "dma_file_window.h"
+#include "dma_stream_ring.h"
 
 DOCA_LOG_REGISTER(DMA_COPY_HOST);
 
+#define SLEEP_IN_NANOS (10 * 1000)		/* Check whether the DPU attached or detached every 10 microseconds */
+#define FILE_WINDOW_SIZE (1024UL * 1024 * 1024)	/* Largest part of a file pinned and exported at once */
+
 /*
  * Saves export descriptor and buffer information into two separate files
  *
@@ -89,44 +103,748 @@ static doca_error_t save_config_info_to_files(const void *export_desc,
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Fill the payload every message carries: the text to copy, NUL terminated and repeated over the whole payload so
+ * that the DPU can print it from any message
+ *
+ * @payload [out]: payload
+ * @payload_len [in]: payload length
+ * @text [in]: text to copy
+ */
+static void fill_payload(char *payload, size_t payload_len, const char *text)
+{
+	size_t text_len = strlen(text) + 1, off, len;
+
+	for (off = 0; off < payload_len; off += len) {
+		len = payload_len - off < text_len ? payload_len - off : text_len;
+		memcpy(payload + off, text, len);
+	}
+}
+
+/* Host side of a stream */
+struct host_stream {
+	struct dma_stream_region *region; /* Exported region */
+	uint32_t num_slots;		  /* Number of slots of each ring */
+	uint32_t slot_size;		  /* Size of a slot, header included */
+	const char *payload;		  /* Payload of every pulled message */
+	uint32_t payload_len;		  /* Payload length */
+	uint32_t payload_crc;		  /* CRC32C of the payload */
+	uint64_t pull_prod;		  /* Number of messages published into the pull ring */
+	uint64_t pull_cons;		  /* Last pull consumer index read */
+	uint64_t num_full;		  /* Number of times the pull ring was found full */
+	uint64_t push_cons;		  /* Number of messages consumed from the push ring */
+	uint64_t push_bytes;		  /* Payload bytes consumed from the push ring */
+	bool push_closed;		  /* Whether the DPU closed the push ring */
+};
+
+/*
+ * Wait until the DPU attaches to the region, i.e. replaces DMA_STREAM_IDX_NONE by its first pull consumer index
+ *
+ * @region [in]: region
+ */
+static void wait_for_consumer(struct dma_stream_region *region)
+{
+	struct timespec ts = {
+		.tv_sec = 0,
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+
+	while (__atomic_load_n(&region->rings[DMA_STREAM_PULL].cons.cons_idx, __ATOMIC_ACQUIRE) == DMA_STREAM_IDX_NONE)
+		nanosleep(&ts, NULL);
+}
+
+/*
+ * Get the slot of a message
+ *
+ * @stream [in]: stream
+ * @dir [in]: ring of the message
+ * @idx [in]: message index
+ * @return: header of the slot
+ */
+static struct dma_stream_slot_hdr *get_slot(struct host_stream *stream, enum dma_stream_dir dir, uint64_t idx)
+{
+	return (struct dma_stream_slot_hdr *)((char *)stream->region +
+					      dma_stream_slot_offset(dir, idx, stream->num_slots, stream->slot_size));
+}
+
+/*
+ * Publish one message into the pull ring if it has a free slot
+ *
+ * @stream [in]: stream
+ */
+static void produce_message(struct host_stream *stream)
+{
+	struct dma_stream_ring *ring = &stream->region->rings[DMA_STREAM_PULL];
+	struct dma_stream_slot_hdr *hdr;
+
+	/* Each slot is freed by the acknowledgment of its previous message */
+	if (stream->pull_prod - stream->pull_cons == stream->num_slots) {
+		stream->pull_cons = __atomic_load_n(&ring->cons.cons_idx, __ATOMIC_ACQUIRE) & DMA_STREAM_IDX_MASK;
+		if (stream->pull_prod - stream->pull_cons == stream->num_slots) {
+			stream->num_full++;
+			return;
+		}
+	}
+
+	hdr = get_slot(stream, DMA_STREAM_PULL, stream->pull_prod);
+	hdr->seq = stream->pull_prod;
+	hdr->len = stream->payload_len;
+	hdr->crc = stream->payload_crc;
+	memcpy(hdr + 1, stream->payload, stream->payload_len);
+
+	/* The slot is written before the index that publishes it */
+	__atomic_store_n(&ring->prod.prod_idx, ++stream->pull_prod, __ATOMIC_RELEASE);
+}
+
+/*
+ * Consume the messages the DPU pushed since the last call and return their slots
+ *
+ * The DPU rings the doorbell only once the DMA writes of the slots completed, so the slots are complete once their
+ * producer index is seen.
+ *
+ * @stream [in]: stream
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t consume_pushed(struct host_stream *stream)
+{
+	struct dma_stream_ring *ring = &stream->region->rings[DMA_STREAM_PUSH];
+	const struct dma_stream_slot_hdr *hdr;
+	uint64_t prod_word, prod_idx;
+
+	prod_word = __atomic_load_n(&ring->prod.prod_idx, __ATOMIC_ACQUIRE);
+	prod_idx = prod_word & DMA_STREAM_IDX_MASK;
+	if (prod_idx != stream->push_cons) {
+		for (; stream->push_cons != prod_idx; stream->push_cons++) {
+			hdr = get_slot(stream, DMA_STREAM_PUSH, stream->push_cons);
+			if (hdr->seq != stream->push_cons || hdr->len > stream->slot_size - sizeof(*hdr) ||
+			    checksum_crc32c(0, hdr + 1, hdr->len) != hdr->crc) {
+				DOCA_LOG_ERR("Pushed message %lu is corrupted", stream->push_cons);
+				return DOCA_ERROR_BAD_STATE;
+			}
+			stream->push_bytes += hdr->len;
+		}
+
+		/* The slots are read before they are returned */
+		__atomic_store_n(&ring->cons.cons_idx, stream->push_cons, __ATOMIC_RELEASE);
+	}
+	if (prod_word & DMA_STREAM_IDX_FLAG)
+		stream->push_closed = true;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stream in the enabled directions for run_time_sec seconds, then close the pull ring and wait until the DPU has
+ * drained both rings and detached
+ *
+ * Both directions are served by the same loop so that they run concurrently and their throughputs are measured over
+ * the same window, which exposes any asymmetry between PCIe reads and writes of the DPU.
+ *
+ * @stream [in]: stream, attached by the DPU
+ * @pull [in]: whether to publish messages into the pull ring
+ * @push [in]: whether the region holds a push ring
+ * @run_time_sec [in]: time to stream for
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t stream_messages(struct host_stream *stream, bool pull, bool push, uint32_t run_time_sec)
+{
+	struct dma_stream_region *region = stream->region;
+	struct timespec ts = {
+		.tv_sec = 0,
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	uint64_t start_ns, deadline_ns, elapsed_ns, pulled, push_bytes;
+	double pull_rate, push_rate;
+	doca_error_t result;
+
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)run_time_sec * BENCH_NSEC_PER_SEC;
+	while (bench_get_time_ns() < deadline_ns) {
+		if (pull)
+			produce_message(stream);
+		if (push) {
+			result = consume_pushed(stream);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+	}
+	elapsed_ns = bench_get_time_ns() - start_ns;
+
+	/* Only what completed within the window counts towards the throughput */
+	pulled = __atomic_load_n(&region->rings[DMA_STREAM_PULL].cons.cons_idx, __ATOMIC_ACQUIRE) & DMA_STREAM_IDX_MASK;
+	push_bytes = stream->push_bytes;
+
+	__atomic_store_n(&region->rings[DMA_STREAM_PULL].prod.prod_idx,
+			 stream->pull_prod | DMA_STREAM_IDX_FLAG,
+			 __ATOMIC_RELEASE);
+	DOCA_LOG_INFO("Pull ring closed after %lu messages, waiting for the DPU to drain the rings", stream->pull_prod);
+	while ((__atomic_load_n(&region->rings[DMA_STREAM_PULL].cons.cons_idx, __ATOMIC_ACQUIRE) &
+		DMA_STREAM_IDX_FLAG) == 0) {
+		if (!push) {
+			nanosleep(&ts, NULL);
+			continue;
+		}
+		result = consume_pushed(stream);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	if (push && !stream->push_closed) {
+		result = consume_pushed(stream);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if (!stream->push_closed) {
+			DOCA_LOG_ERR("DPU detached without closing the push ring");
+			return DOCA_ERROR_BAD_STATE;
+		}
+	}
+
+	pull_rate = (double)pulled * stream->payload_len / (double)elapsed_ns;
+	push_rate = (double)push_bytes / (double)elapsed_ns;
+	if (pull)
+		DOCA_LOG_INFO("Pull, Host to DPU: %lu messages of %u bytes in %.3f s: %.3f GB/s, ring full %lu times",
+			      pulled,
+			      stream->payload_len,
+			      (double)elapsed_ns / 1e9,
+			      pull_rate,
+			      stream->num_full);
+	if (push)
+		DOCA_LOG_INFO("Push, DPU to Host: %lu bytes in %.3f s: %.3f GB/s, %lu messages in total",
+			      push_bytes,
+			      (double)elapsed_ns / 1e9,
+			      push_rate,
+			      stream->push_cons);
+	if (pull && push && pull_rate > 0)
+		DOCA_LOG_INFO("Concurrent push to pull throughput ratio: %.3f", push_rate / pull_rate);
+
+	return DOCA_SUCCESS;
+}
+
+/* A file exported window by window, each window either mapped from the page cache or read into a buffer */
+struct host_file {
+	int fd;			/* File descriptor, kept open while the file is exported */
+	size_t file_size;	/* Size of the file, the number of bytes the DPU pulls */
+	size_t window_size;	/* Largest window, whole pages */
+	bool zero_copy;		/* Whether the windows are mappings of the file, or else copies in buf */
+	char *buf;		/* Buffer the windows are read into without zero copy */
+	void *addr;		/* Start of the current window, NULL when none is staged */
+	size_t len;		/* Length of the current window */
+	size_t map_len;		/* Exported length of the current window, rounded up to whole pages */
+	struct doca_mmap *mmap;	/* Export of the current window */
+	uint64_t num_windows;	/* Number of windows published */
+	uint64_t stage_ns;	/* Time spent mapping or reading the windows */
+	uint64_t pin_ns;	/* Time spent pinning the windows */
+	uint64_t export_ns;	/* Time spent exporting the windows */
+};
+
+/*
+ * Warn when the pages the export pins exceed the locked memory limit of the process
+ *
+ * @len [in]: number of bytes to pin
+ */
+static void check_memlock_limit(size_t len)
+{
+	struct rlimit limit;
+
+	if (geteuid() == 0 || getrlimit(RLIMIT_MEMLOCK, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY)
+		return;
+	if (limit.rlim_cur < len)
+		DOCA_LOG_WARN("Exporting %zu bytes exceeds the locked memory limit of %lu bytes, pinning may fail",
+			      len,
+			      (uint64_t)limit.rlim_cur);
+}
+
+/*
+ * Open a file and prepare it for a windowed export
+ *
+ * An advisory shared lock is taken, so writers that lock the file exclusively with flock() wait until the export
+ * ends. It does not stop anyone from truncating or rewriting the file: a mapped window truncated under the export
+ * stays pinned, and the DPU reads pages that are no longer part of the file.
+ *
+ * @path [in]: file path
+ * @zero_copy [in]: whether to map the windows instead of reading them into a buffer
+ * @file [out]: file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t stage_host_file(const char *path, bool zero_copy, struct host_file *file)
+{
+	const size_t page_size = PAGE_SIZE;
+	struct stat st;
+	doca_error_t result;
+
+	memset(file, 0, sizeof(*file));
+	file->zero_copy = zero_copy;
+	file->fd = open(path, O_RDONLY);
+	if (file->fd < 0) {
+		DOCA_LOG_ERR("Failed to open %s: %s", path, strerror(errno));
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fstat(file->fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+	    (uint64_t)st.st_size > SIZE_MAX - page_size) {
+		DOCA_LOG_ERR("%s is not a non-empty regular file", path);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto close_file;
+	}
+	file->file_size = st.st_size;
+	file->window_size = (file->file_size + page_size - 1) / page_size * page_size;
+	if (file->window_size > FILE_WINDOW_SIZE)
+		file->window_size = FILE_WINDOW_SIZE;
+
+	if (flock(file->fd, LOCK_SH | LOCK_NB) != 0)
+		DOCA_LOG_WARN("Failed to take an advisory lock on %s, "
+			      "writers that lock it will not wait for the export",
+			      path);
+	check_memlock_limit(file->window_size);
+
+	if (!zero_copy) {
+		file->buf = aligned_alloc(page_size, file->window_size);
+		if (file->buf == NULL) {
+			DOCA_LOG_ERR("Failed to allocate a buffer of %zu bytes", file->window_size);
+			result = DOCA_ERROR_NO_MEMORY;
+			goto close_file;
+		}
+	}
+
+	return DOCA_SUCCESS;
+
+close_file:
+	close(file->fd);
+	return result;
+}
+
+/*
+ * Release a file prepared with stage_host_file(), no window may be staged
+ *
+ * @file [in]: file
+ */
+static void unstage_host_file(struct host_file *file)
+{
+	free(file->buf);
+	close(file->fd);
+}
+
+/*
+ * Map or read a window of the file
+ *
+ * With zero copy the window is mapped read-only and shared, so the DPU reads the page cache pages themselves: the
+ * export pins them without write access, which leaves them shared with the page cache instead of breaking them into
+ * private copies. The last page of the file is only partially backed by it, the kernel zero fills it past the end
+ * of the file and the DPU is told the window length so that it never reads the fill. The pages are populated here
+ * so that faulting the file in is not accounted to pinning.
+ *
+ * @file [in/out]: file
+ * @offset [in]: offset of the window, a multiple of the window size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t stage_host_window(struct host_file *file, size_t offset)
+{
+	const size_t page_size = PAGE_SIZE;
+	size_t done = 0;
+	ssize_t ret;
+
+	file->len = file->file_size - offset < file->window_size ? file->file_size - offset : file->window_size;
+	file->map_len = (file->len + page_size - 1) / page_size * page_size;
+
+	if (file->zero_copy) {
+		file->addr = mmap(NULL, file->map_len, PROT_READ, MAP_SHARED | MAP_POPULATE, file->fd, offset);
+		if (file->addr == MAP_FAILED) {
+			DOCA_LOG_ERR("Failed to map %zu bytes at offset %zu: %s",
+				     file->map_len,
+				     offset,
+				     strerror(errno));
+			file->addr = NULL;
+			return DOCA_ERROR_IO_FAILED;
+		}
+		return DOCA_SUCCESS;
+	}
+
+	while (done < file->len) {
+		ret = pread(file->fd, file->buf + done, file->len - done, offset + done);
+		if (ret < 0 && errno == EINTR)
+			continue;
+		if (ret <= 0) {
+			DOCA_LOG_ERR("Failed to read the file at offset %zu: %s",
+				     offset + done,
+				     ret < 0 ? strerror(errno) : "unexpected end of file");
+			return DOCA_ERROR_IO_FAILED;
+		}
+		done += ret;
+	}
+	memset(file->buf + file->len, 0, file->map_len - file->len);
+
+	file->addr = file->buf;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Pin and export the staged window, read-only
+ *
+ * @file [in/out]: file, with a staged window
+ * @dev [in]: device to export to
+ * @export_desc [out]: export descriptor
+ * @export_desc_len [out]: export descriptor length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t export_host_window(struct host_file *file,
+				       struct doca_dev *dev,
+				       const void **export_desc,
+				       size_t *export_desc_len)
+{
+	uint64_t start_ns;
+	doca_error_t result;
+
+	result = doca_mmap_create(&file->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create window mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_add_dev(file->mmap, dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to add device to window mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* The DPU only reads the file, a read-only pin keeps mapped pages shared with the page cache */
+	result = doca_mmap_set_permissions(file->mmap, DOCA_ACCESS_FLAG_PCI_READ_ONLY);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set window mmap permissions: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_set_memrange(file->mmap, file->addr, file->map_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for window mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	start_ns = bench_get_time_ns();
+	result = doca_mmap_start(file->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start window mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+	file->pin_ns += bench_get_time_ns() - start_ns;
+
+	start_ns = bench_get_time_ns();
+	result = doca_mmap_export_pci(file->mmap, dev, export_desc, export_desc_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to export window mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+	file->export_ns += bench_get_time_ns() - start_ns;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Unexport and unmap the current window, if any
+ *
+ * @file [in/out]: file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t release_host_window(struct host_file *file)
+{
+	doca_error_t result = DOCA_SUCCESS;
+
+	if (file->mmap != NULL) {
+		result = doca_mmap_destroy(file->mmap);
+		if (result != DOCA_SUCCESS)
+			DOCA_LOG_ERR("Failed to destroy window mmap: %s", doca_error_get_descr(result));
+		file->mmap = NULL;
+	}
+	if (file->zero_copy && file->addr != NULL)
+		munmap(file->addr, file->map_len);
+	file->addr = NULL;
+
+	return result;
+}
+
+/*
+ * Wait until the DPU acknowledged a window
+ *
+ * The DPU may attach at any time, as in the streaming mode. Once it did, it has timeout_sec seconds to pull the
+ * window, after which the host gives up so that the window does not stay pinned for a DPU that went away.
+ *
+ * @ctrl [in]: control region
+ * @seq [in]: number of the published window
+ * @timeout_sec [in]: time the DPU has to pull the window once attached
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t wait_for_window_ack(struct dma_file_ctrl *ctrl, uint64_t seq, uint32_t timeout_sec)
+{
+	struct timespec ts = {
+		.tv_sec = 0,
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	uint64_t deadline_ns = 0, ack;
+
+	while ((ack = __atomic_load_n(&ctrl->ack.seq, __ATOMIC_ACQUIRE)) != seq) {
+		if (ack != DMA_FILE_SEQ_NONE && deadline_ns == 0)
+			deadline_ns = bench_get_time_ns() + (uint64_t)timeout_sec * BENCH_NSEC_PER_SEC;
+		if (deadline_ns != 0 && bench_get_time_ns() >= deadline_ns) {
+			DOCA_LOG_ERR("DPU did not pull window %lu within %u s", seq, timeout_sec);
+			return DOCA_ERROR_TIME_OUT;
+		}
+		nanosleep(&ts, NULL);
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stage, export and publish the window at an offset, wait until the DPU pulled it and release it
+ *
+ * @file [in/out]: file
+ * @ctrl [in]: control region
+ * @dev [in]: device to export to
+ * @offset [in]: offset of the window
+ * @timeout_sec [in]: time the DPU has to pull the window once attached
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t publish_host_window(struct host_file *file,
+					struct dma_file_ctrl *ctrl,
+					struct doca_dev *dev,
+					size_t offset,
+					uint32_t timeout_sec)
+{
+	struct dma_file_window *window = &ctrl->window;
+	struct bench_mem_usage usage = {0};
+	const void *export_desc;
+	size_t export_desc_len;
+	uint64_t start_ns;
+	doca_error_t result, tmp_result;
+
+	start_ns = bench_get_time_ns();
+	result = stage_host_window(file, offset);
+	if (result != DOCA_SUCCESS)
+		return result;
+	file->stage_ns += bench_get_time_ns() - start_ns;
+
+	result = export_host_window(file, dev, &export_desc, &export_desc_len);
+	if (result != DOCA_SUCCESS)
+		goto release_window;
+	if (export_desc_len > DMA_FILE_DESC_MAX_LEN) {
+		DOCA_LOG_ERR("Export descriptor of %zu bytes exceeds the %u bytes of the control region",
+			     export_desc_len,
+			     DMA_FILE_DESC_MAX_LEN);
+		result = DOCA_ERROR_TOO_BIG;
+		goto release_window;
+	}
+
+	/* The DPU acknowledged the previous window, so it no longer reads the window line */
+	window->file_size = file->file_size;
+	window->offset = offset;
+	window->len = file->len;
+	window->addr = (uintptr_t)file->addr;
+	window->desc_len = export_desc_len;
+	memcpy(window->desc, export_desc, export_desc_len);
+	__atomic_store_n(&ctrl->publish.seq, ++file->num_windows, __ATOMIC_RELEASE);
+
+	if (file->num_windows == 1) {
+		(void)bench_get_mem_usage(&usage);
+		DOCA_LOG_INFO("First window of %zu bytes published, resident %lu KB, pinned %lu KB",
+			      file->len,
+			      usage.rss_kb,
+			      usage.pinned_kb);
+	}
+
+	result = wait_for_window_ack(ctrl, file->num_windows, timeout_sec);
+
+release_window:
+	tmp_result = release_host_window(file);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+/*
+ * Export a file for the DPU sample to pull
+ *
+ * The host exports a read-write control region, then maps or reads the file one window of at most FILE_WINDOW_SIZE
+ * bytes at a time and exports each window read-only through the control region (@see dma_file_window.h), so that
+ * files larger than what can be pinned at once are supported and every window is released as soon as the DPU
+ * acknowledged it. The staging, pinning and exporting times are the part of the time-to-first-byte of the DPU that
+ * the Host controls, they show the copy the read mode pays against the mmap mode.
+ *
+ * @cfg [in]: Sample configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t dma_copy_host_file(const struct dma_config *cfg)
+{
+	const size_t ctrl_len = (sizeof(struct dma_file_ctrl) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+	struct program_core_objects state = {0};
+	struct dma_file_ctrl *ctrl;
+	struct host_file file;
+	uint64_t start_ns, end_ns;
+	const void *export_desc;
+	size_t export_desc_len, offset;
+	doca_error_t result, tmp_result;
+
+	result = stage_host_file(cfg->file_path, cfg->file_zero_copy, &file);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	ctrl = aligned_alloc(PAGE_SIZE, ctrl_len);
+	if (ctrl == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the control region");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto unstage_file;
+	}
+	memset(ctrl, 0, ctrl_len);
+	ctrl->ack.seq = DMA_FILE_SEQ_NONE;
+
+	result = allocate_dma_host_resources(cfg->pci_address, &state);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA host resources: %s", doca_error_get_descr(result));
+		goto free_ctrl;
+	}
+
+	/* The DPU writes its acknowledgments into the control region */
+	result = doca_mmap_set_permissions(state.src_mmap, DOCA_ACCESS_FLAG_PCI_READ_WRITE);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set mmap permissions: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_mmap_set_memrange(state.src_mmap, ctrl, ctrl_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for source mmap: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_mmap_start(state.src_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start source mmap: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_mmap_export_pci(state.src_mmap, state.dev, &export_desc, &export_desc_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start export source mmap: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = save_config_info_to_files(export_desc,
+					   export_desc_len,
+					   (const char *)ctrl,
+					   sizeof(*ctrl),
+					   (char *)cfg->export_desc_path,
+					   (char *)cfg->buf_info_path);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to save configurations information: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	DOCA_LOG_INFO("Please copy %s and %s to the DPU and run DMA Copy DPU sample with --file",
+		      cfg->export_desc_path,
+		      cfg->buf_info_path);
+
+	start_ns = bench_get_time_ns();
+	for (offset = 0; offset < file.file_size; offset += file.len) {
+		result = publish_host_window(&file, ctrl, state.dev, offset, cfg->run_time_sec);
+		if (result != DOCA_SUCCESS)
+			goto destroy_resources;
+	}
+	end_ns = bench_get_time_ns();
+
+	DOCA_LOG_INFO("%s: %zu bytes in %lu windows, %s in %.3f ms, pinned in %.3f ms, exported in %.3f ms",
+		      cfg->file_path,
+		      file.file_size,
+		      file.num_windows,
+		      file.zero_copy ? "mapped" : "read",
+		      (double)file.stage_ns / 1e6,
+		      (double)file.pin_ns / 1e6,
+		      (double)file.export_ns / 1e6);
+	DOCA_LOG_INFO("DPU pulled the file %.3f s after the first window was staged%s",
+		      (double)(end_ns - start_ns) / 1e9,
+		      file.zero_copy ? "" : ", run with --file-mode mmap to save the copy of the file");
+
+destroy_resources:
+	tmp_result = destroy_dma_host_resources(&state);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA host resources: %s", doca_error_get_descr(tmp_result));
+	}
+free_ctrl:
+	free(ctrl);
+unstage_file:
+	unstage_host_file(&file);
+	return result;
+}
+
 /*
  * Run DOCA DMA Host copy sample
  *
- * @pcie_addr [in]: Device PCI address
- * @src_buffer [in]: Source buffer to copy
- * @src_buffer_size [in]: Buffer size
- * @export_desc_file_path [in]: Export descriptor file path
- * @buffer_info_file_name [in]: Buffer info file path
+ * The host exports a region once, the DPU sample pulls the messages the host publishes into its pull ring with DMA
+ * reads and, when enabled, pushes its own messages into the push ring with DMA writes, so the export and the
+ * exchange of its descriptor are paid once for the whole stream.
+ * When a file is given the host exports the file instead, see dma_copy_host_file().
+ *
+ * @cfg [in]: Sample configuration
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-doca_error_t dma_copy_host(const char *pcie_addr,
-			   char *src_buffer,
-			   size_t src_buffer_size,
-			   char *export_desc_file_path,
-			   char *buffer_info_file_name)
+doca_error_t dma_copy_host(const struct dma_config *cfg)
 {
 	struct program_core_objects state = {0};
+	struct host_stream stream = {0};
+	struct dma_stream_region *region;
+	struct dma_stream_ring *ring;
+	const uint32_t payload_len = cfg->slot_size - sizeof(struct dma_stream_slot_hdr);
+	const size_t page_size = PAGE_SIZE;
+	size_t region_size;
 	const void *export_desc;
 	size_t export_desc_len;
-	int enter = 0;
+	char *payload;
 	doca_error_t result, tmp_result;
 
+	if (cfg->file_path[0] != '\0')
+		return dma_copy_host_file(cfg);
+
+	/* Whole pages, aligned_alloc() takes a multiple of the alignment */
+	region_size = dma_stream_region_size(cfg->num_slots, cfg->slot_size, cfg->stream_push);
+	region_size = (region_size + page_size - 1) / page_size * page_size;
+	region = aligned_alloc(page_size, region_size);
+	payload = malloc(payload_len);
+	if (region == NULL || payload == NULL) {
+		DOCA_LOG_ERR("Failed to allocate a region of %zu bytes", region_size);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_region;
+	}
+	memset(region, 0, region_size);
+	ring = &region->rings[DMA_STREAM_PULL];
+	ring->prod.magic = DMA_STREAM_MAGIC;
+	ring->prod.num_slots = cfg->num_slots;
+	ring->prod.slot_size = cfg->slot_size;
+	ring->cons.cons_idx = DMA_STREAM_IDX_NONE;
+	ring = &region->rings[DMA_STREAM_PUSH];
+	ring->prod.magic = DMA_STREAM_MAGIC;
+	ring->prod.num_slots = cfg->stream_push ? cfg->num_slots : 0;
+	ring->prod.slot_size = cfg->slot_size;
+	fill_payload(payload, payload_len, cfg->cpy_txt);
+
+	stream.region = region;
+	stream.num_slots = cfg->num_slots;
+	stream.slot_size = cfg->slot_size;
+	stream.payload = payload;
+	stream.payload_len = payload_len;
+	stream.payload_crc = checksum_crc32c(0, payload, payload_len);
+
 	/* Allocate resources */
-	result = allocate_dma_host_resources(pcie_addr, &state);
+	result = allocate_dma_host_resources(cfg->pci_address, &state);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to allocate DMA host resources: %s", doca_error_get_descr(result));
-		return result;
+		goto free_region;
 	}
 
-	/* Allow exporting the mmap to DPU for read only operations */
-	result = doca_mmap_set_permissions(state.src_mmap, DOCA_ACCESS_FLAG_PCI_READ_ONLY);
+	/* Allow exporting the mmap to DPU, which reads and writes the slots and the indexes */
+	result = doca_mmap_set_permissions(state.src_mmap, DOCA_ACCESS_FLAG_PCI_READ_WRITE);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to set mmap permissions: %s", doca_error_get_descr(result));
 		goto destroy_resources;
 	}
 
-	/* Populate the memory map with the allocated memory */
-	result = doca_mmap_set_memrange(state.src_mmap, src_buffer, src_buffer_size);
+	/* Populate the memory map with the region */
+	result = doca_mmap_set_memrange(state.src_mmap, region, region_size);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to set memory range for source mmap: %s", doca_error_get_descr(result));
 		goto destroy_resources;
@@ -146,25 +864,30 @@ doca_error_t dma_copy_host(const char *pcie_addr,
 	}
 
 	DOCA_LOG_INFO("Please copy %s and %s to the DPU and run DMA Copy DPU sample",
-		      export_desc_file_path,
-		      buffer_info_file_name);
+		      cfg->export_desc_path,
+		      cfg->buf_info_path);
 
 	/* Saves the export desc and buffer info to files, it is the user responsibility to transfer them to the dpu */
 	result = save_config_info_to_files(export_desc,
 					   export_desc_len,
-					   src_buffer,
-					   src_buffer_size,
-					   export_desc_file_path,
-					   buffer_info_file_name);
+					   (const char *)region,
+					   region_size,
+					   (char *)cfg->export_desc_path,
+					   (char *)cfg->buf_info_path);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to save configurations information: %s", doca_error_get_descr(result));
 		goto destroy_resources;
 	}
 
-	/* Wait for enter which means that the requester has finished reading */
-	DOCA_LOG_INFO("Wait till the DPU has finished and press enter");
-	while (enter != '\r' && enter != '\n')
-		enter = getchar();
+	DOCA_LOG_INFO("Waiting for the DPU to attach to the rings of %u slots of %u bytes",
+		      cfg->num_slots,
+		      cfg->slot_size);
+	wait_for_consumer(region);
+	DOCA_LOG_INFO("DPU attached, streaming%s%s for %u seconds",
+		      cfg->stream_pull ? " to the DPU" : "",
+		      cfg->stream_push ? " from the DPU" : "",
+		      cfg->run_time_sec);
+	result = stream_messages(&stream, cfg->stream_pull, cfg->stream_push, cfg->run_time_sec);
 
 destroy_resources:
 	tmp_result = destroy_dma_host_resources(&state);
@@ -172,6 +895,8 @@ destroy_resources:
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
 		DOCA_LOG_ERR("Failed to destroy DMA host resources: %s", doca_error_get_descr(tmp_result));
 	}
-
+free_region:
+	free(payload);
+	free(region);
 	return result;
 }
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DMA_FILE_WINDOW_H_
+#define DMA_FILE_WINDOW_H_
+
+#include <stdint.h>
+
+/*
+ * Host and DPU file windows.
+ *
+ * The host exports a small read-write control region once, and the file itself one window at a time, each window a
+ * separate read-only export of at most a fixed number of bytes. This bounds the memory the host pins at once and
+ * lets the host release every window as soon as the DPU is done with it.
+ *
+ * The DPU attaches by DMA writing 0 into the acknowledgment line. The host then fills the window line, with the
+ * export descriptor of the window, and publishes it by storing its number, from 1, into the publish line with
+ * release semantics. The DPU polls the publish line with DMA reads, reads the window line once the number changed,
+ * pulls the window and DMA writes its number into the acknowledgment line. Only then does the host unpin and unmap
+ * the window and publish the next one; the DPU is done after acknowledging the window that ends the file.
+ *
+ * The sequence numbers are single aligned 64-bit words so that a DMA access never sees half of an update, and the
+ * window line is only rewritten once the DPU acknowledged it, so reading it after the publish line is consistent.
+ */
+
+#define DMA_FILE_LINE_SIZE (64)	       /* Publish and acknowledgment words are on separate cache lines */
+#define DMA_FILE_DESC_MAX_LEN (1024)   /* Largest export descriptor of a window */
+#define DMA_FILE_SEQ_NONE (UINT64_MAX) /* Acknowledged window before the DPU attaches */
+
+/* A sequence number line */
+struct dma_file_seq_line {
+	uint64_t seq; /* Window number */
+} __attribute__((aligned(DMA_FILE_LINE_SIZE)));
+
+/* A window of the file, written by the host before it publishes it */
+struct dma_file_window {
+	uint64_t file_size;		     /* Size of the whole file */
+	uint64_t offset;		     /* Offset of the window in the file */
+	uint64_t len;			     /* Length of the window, the export may extend to a page end */
+	uint64_t addr;			     /* Host address of the window start */
+	uint64_t desc_len;		     /* Length of the export descriptor */
+	uint8_t desc[DMA_FILE_DESC_MAX_LEN]; /* Export descriptor of the window */
+} __attribute__((aligned(DMA_FILE_LINE_SIZE)));
+
+/* The exported control region */
+struct dma_file_ctrl {
+	struct dma_file_seq_line publish; /* Written by the host, the number of the published window */
+	struct dma_file_seq_line ack;	  /* Written by the DPU, the number of the last window it pulled */
+	struct dma_file_window window;	  /* Written by the host, the published window */
+};
+
+#endif /* DMA_FILE_WINDOW_H_ */
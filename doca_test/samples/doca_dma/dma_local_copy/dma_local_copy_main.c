@@ -31,12 +31,77 @@
 #include <doca_dev.h>
 #include <doca_log.h>
 
+#include "bench_common.h"
 #include "dma_common.h"
 
 DOCA_LOG_REGISTER(DPU_LOCAL_DMA_COPY::MAIN);
 
 /* Sample's Logic */
-doca_error_t dma_local_copy(const char *pcie_addr, char *dst_buffer, const char *src_buffer, size_t length);
+doca_error_t dma_local_copy(const char *pcie_addr,
+			    char *dst_buffer,
+			    char *src_buffer,
+			    size_t length,
+			    enum bench_verify_mode verify_mode);
+
+#define MAX_VERIFY_MODE_NAME_LEN (8) /* Longest verification mode name */
+
+/* Sample configuration, the DMA configuration must be the first member for the common ARGP callbacks */
+struct local_copy_config {
+	struct dma_config dma;		    /* DMA configuration */
+	enum bench_verify_mode verify_mode; /* How the copy is checked */
+};
+
+/*
+ * ARGP Callback - Handle verification mode parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t verify_callback(void *param, void *config)
+{
+	struct local_copy_config *cfg = (struct local_copy_config *)config;
+	const char *verify = (char *)param;
+
+	if (strnlen(verify, MAX_VERIFY_MODE_NAME_LEN) == MAX_VERIFY_MODE_NAME_LEN ||
+	    bench_parse_verify_mode(verify, &cfg->verify_mode) != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Verification mode must be one of none, sampled or full");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the local copy parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_local_copy_params(void)
+{
+	struct doca_argp_param *verify_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&verify_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(verify_param, "vf");
+	doca_argp_param_set_long_name(verify_param, "verify");
+	doca_argp_param_set_arguments(verify_param, "<none|sampled|full>");
+	doca_argp_param_set_description(verify_param,
+					"How the copy is checked, sampled compares random cache lines (optional)");
+	doca_argp_param_set_callback(verify_param, verify_callback);
+	doca_argp_param_set_type(verify_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(verify_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
 
 /*
  * Sample main function
@@ -47,7 +112,8 @@ doca_error_t dma_local_copy(const char *pcie_addr, char *dst_buffer, const char
  */
 int main(int argc, char **argv)
 {
-	struct dma_config dma_conf;
+	struct local_copy_config cfg;
+	struct dma_config *dma_conf = &cfg.dma;
 	char *dst_buffer = NULL, *src_buffer = NULL;
 	size_t length;
 	doca_error_t result;
@@ -55,8 +121,9 @@ int main(int argc, char **argv)
 	int exit_status = EXIT_FAILURE;
 
 	/* Set the default configuration values (Example values) */
-	strcpy(dma_conf.pci_address, "03:00.0");
-	strcpy(dma_conf.cpy_txt, "This is a sample piece of text");
+	strcpy(dma_conf->pci_address, "03:00.0");
+	strcpy(dma_conf->cpy_txt, "This is a sample piece of text");
+	cfg.verify_mode = BENCH_VERIFY_SAMPLED;
 	/* No need to set export_desc_path and buf_info_path which are only needed for DMA across devices */
 
 	/* Register a logger backend */
@@ -79,7 +146,7 @@ int main(int argc, char **argv)
 	goto sample_exit;
 #endif
 
-	result = doca_argp_init("doca_dma_local_copy", &dma_conf);
+	result = doca_argp_init("doca_dma_local_copy", &cfg);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
 		goto sample_exit;
@@ -89,13 +156,18 @@ int main(int argc, char **argv)
 		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
 		goto argp_cleanup;
 	}
+	result = register_local_copy_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register local copy parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
 	result = doca_argp_start(argc, argv);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
 		goto argp_cleanup;
 	}
 
-	length = strlen(dma_conf.cpy_txt) + 1;
+	length = strlen(dma_conf->cpy_txt) + 1;
 	dst_buffer = (char *)calloc(1, length);
 	if (dst_buffer == NULL) {
 		DOCA_LOG_ERR("Destination buffer allocation failed");
@@ -108,9 +180,9 @@ int main(int argc, char **argv)
 		goto dst_buffer_cleanup;
 	}
 
-	memcpy(src_buffer, dma_conf.cpy_txt, length);
+	memcpy(src_buffer, dma_conf->cpy_txt, length);
 
-	result = dma_local_copy(dma_conf.pci_address, dst_buffer, src_buffer, length);
+	result = dma_local_copy(dma_conf->pci_address, dst_buffer, src_buffer, length, cfg.verify_mode);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("dma_local_copy() encountered an error: %s", doca_error_get_descr(result));
 		goto src_buffer_cleanup;
@@ -23,8 +23,8 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
-#include <string.h>
 #include <time.h>
 
 #include <doca_buf.h>
@@ -36,11 +36,20 @@
 #include <doca_mmap.h>
 #include <doca_pe.h>
 
+#include "bench_common.h"
+#include "dma_bulk_copy.h"
 #include "dma_common.h"
 
 DOCA_LOG_REGISTER(DPU_LOCAL_DMA_COPY);
 
 #define SLEEP_IN_NANOS (10 * 1000) /* Sample the task every 10 microseconds  */
+#define MAX_INFLIGHT_SEGMENTS (16) /* Segments of the copy that may be in flight at once */
+
+/* State of the copy, updated by the completion callback */
+struct local_copy_state {
+	bool done;	     /* Whether the copy completed */
+	doca_error_t result; /* Result of the copy */
+};
 
 /*
  * Checks that the two buffers are not overlap each other
@@ -82,6 +91,20 @@ static doca_error_t register_memory_range_and_start_mmap(struct doca_mmap *mmap,
 	return doca_mmap_start(mmap);
 }
 
+/*
+ * Bulk copy completion callback
+ *
+ * @status [in]: status of the copy
+ * @user_data [in]: the local copy state
+ */
+static void local_copy_done_callback(doca_error_t status, void *user_data)
+{
+	struct local_copy_state *copy = (struct local_copy_state *)user_data;
+
+	copy->result = status;
+	copy->done = true;
+}
+
 /*
  * Run DOCA DMA local copy sample
  *
@@ -89,22 +112,24 @@ static doca_error_t register_memory_range_and_start_mmap(struct doca_mmap *mmap,
  * @dst_buffer [in]: Destination buffer
  * @src_buffer [in]: Source buffer to copy
  * @length [in]: Buffer's size
+ * @verify_mode [in]: How the copy is checked once it completed
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-doca_error_t dma_local_copy(const char *pcie_addr, char *dst_buffer, char *src_buffer, size_t length)
+doca_error_t dma_local_copy(const char *pcie_addr,
+			    char *dst_buffer,
+			    char *src_buffer,
+			    size_t length,
+			    enum bench_verify_mode verify_mode)
 {
-	struct dma_resources resources;
-	struct program_core_objects *state = &resources.state;
-	struct doca_dma_task_memcpy *dma_task = NULL;
-	struct doca_task *task = NULL;
-	union doca_data task_user_data = {0};
-	struct doca_buf *src_doca_buf = NULL;
-	struct doca_buf *dst_doca_buf = NULL;
+	struct program_core_objects state = {0};
+	struct dma_bulk_copy *copier = NULL;
+	struct local_copy_state copy = {0};
 	struct timespec ts = {
 		.tv_sec = 0,
 		.tv_nsec = SLEEP_IN_NANOS,
 	};
-	doca_error_t result, tmp_result, task_result;
+	uint64_t segment_size, start_ns, copy_ns;
+	doca_error_t result, tmp_result;
 
 	if (dst_buffer == NULL || src_buffer == NULL || length == 0) {
 		DOCA_LOG_ERR("Invalid input values, addresses and sizes must not be 0");
@@ -117,132 +142,92 @@ doca_error_t dma_local_copy(const char *pcie_addr, char *dst_buffer, char *src_b
 		return result;
 	}
 
-	/* Allocate resources */
-	result = allocate_dma_resources(pcie_addr, &resources);
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &state.dev);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+		DOCA_LOG_ERR("Failed to open DOCA device for DMA: %s", doca_error_get_descr(result));
 		return result;
 	}
 
-	/* Connect context to progress engine */
-	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	/* Source and destination mmaps and the PE, the copier has its own buffer inventory */
+	result = create_core_objects(&state, 0);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
-		goto destroy_resources;
+		DOCA_LOG_ERR("Failed to create DOCA core objects: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
 
-	result = doca_ctx_start(state->ctx);
+	result = register_memory_range_and_start_mmap(state.dst_mmap, dst_buffer, length);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
-		goto destroy_resources;
+		DOCA_LOG_ERR("Failed to create and start destination mmap: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
 	}
 
-	result = register_memory_range_and_start_mmap(state->dst_mmap, dst_buffer, length);
+	result = register_memory_range_and_start_mmap(state.src_mmap, src_buffer, length);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to create and start source mmap: %s", doca_error_get_descr(result));
-		goto stop_dma;
+		goto destroy_core_objects;
 	}
 
-	result = register_memory_range_and_start_mmap(state->src_mmap, src_buffer, length);
+	result = dma_bulk_copy_create(state.dev, state.pe, MAX_INFLIGHT_SEGMENTS, 0, 0, &copier);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to create and start destination mmap: %s", doca_error_get_descr(result));
-		goto stop_dma;
-	}
-
-	/* Clear destination memory buffer */
-	memset(dst_buffer, 0, length);
-
-	/* Construct DOCA buffer for each address range */
-	result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->src_mmap, src_buffer, length, &src_doca_buf);
+		DOCA_LOG_ERR("Failed to create DMA bulk copier: %s", doca_error_get_descr(result));
+		goto destroy_core_objects;
+	}
+	segment_size = dma_bulk_copy_get_segment_size(copier);
+
+	/* The destination is not cleared here, at multi-GB sizes that costs more than the copy itself */
+	start_ns = bench_get_time_ns();
+
+	/* Copies longer than a memcpy task are split into segments that are all in flight together */
+	result = dma_bulk_copy_submit(copier,
+				      state.src_mmap,
+				      src_buffer,
+				      state.dst_mmap,
+				      dst_buffer,
+				      length,
+				      local_copy_done_callback,
+				      &copy);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to acquire DOCA buffer representing source buffer: %s",
-			     doca_error_get_descr(result));
-		goto stop_dma;
+		DOCA_LOG_ERR("Failed to submit DMA copy: %s", doca_error_get_descr(result));
+		goto destroy_copier;
 	}
 
-	/* Construct DOCA buffer for each address range */
-	result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->dst_mmap, dst_buffer, length, &dst_doca_buf);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to acquire DOCA buffer representing destination buffer: %s",
-			     doca_error_get_descr(result));
-		goto destroy_src_buf;
-	}
-
-	/* Include result in user data of task to be used in the callbacks */
-	task_user_data.ptr = &task_result;
-	/* Allocate and construct DMA task */
-	result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx,
-						 src_doca_buf,
-						 dst_doca_buf,
-						 task_user_data,
-						 &dma_task);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
-		goto destroy_dst_buf;
-	}
-	/* Number of tasks submitted to progress engine */
-	resources.num_remaining_tasks = 1;
-
-	task = doca_dma_task_memcpy_as_task(dma_task);
-
-	/* Set data position in src_buff */
-	result = doca_buf_set_data(src_doca_buf, src_buffer, length);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to set data for DOCA buffer: %s", doca_error_get_descr(result));
-		doca_task_free(task);
-		goto destroy_dst_buf;
+	/* Wait for the last segment to complete */
+	while (!copy.done) {
+		if (doca_pe_progress(state.pe) == 0)
+			nanosleep(&ts, &ts);
 	}
+	copy_ns = bench_get_time_ns() - start_ns;
 
-	/* Submit DMA task */
-	result = doca_task_submit(task);
+	/* Check result of the copy according to the result we update in the callback */
+	result = copy.result;
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
-		doca_task_free(task);
-		goto destroy_dst_buf;
-	}
-
-	resources.run_pe_progress = true;
-
-	/* Wait for all tasks to be completed and context stopped */
-	while (resources.run_pe_progress) {
-		if (doca_pe_progress(state->pe) == 0)
-			nanosleep(&ts, &ts);
+		DOCA_LOG_ERR("DMA copy failed: %s", doca_error_get_descr(result));
+		goto destroy_copier;
 	}
 
-	/* Check result of task according to the result we update in the callbacks */
-	if (task_result == DOCA_SUCCESS)
-		DOCA_LOG_INFO("Success, memory copied and verified as correct");
-	else
-		DOCA_LOG_ERR("DMA memcpy task failed: %s", doca_error_get_descr(task_result));
+	/* Verification is outside of the timed region */
+	result = bench_verify_copy(verify_mode, BENCH_DEFAULT_VERIFY_LINES, dst_buffer, src_buffer, length);
+	if (result != DOCA_SUCCESS)
+		goto destroy_copier;
 
-	result = task_result;
+	DOCA_LOG_INFO("Success, memory copied%s in %lu segments of up to %lu bytes, %.3f ms",
+		      verify_mode == BENCH_VERIFY_NONE ? "" : " and verified as correct",
+		      (uint64_t)((length + segment_size - 1) / segment_size),
+		      segment_size,
+		      copy_ns / 1e6);
 
-destroy_dst_buf:
-	tmp_result = doca_buf_dec_refcount(dst_doca_buf, NULL);
-	if (tmp_result != DOCA_SUCCESS) {
-		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to decrease DOCA destination buffer reference count: %s",
-			     doca_error_get_descr(tmp_result));
-	}
-destroy_src_buf:
-	tmp_result = doca_buf_dec_refcount(src_doca_buf, NULL);
-	if (tmp_result != DOCA_SUCCESS) {
-		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to decrease DOCA source buffer reference count: %s",
-			     doca_error_get_descr(tmp_result));
-	}
-stop_dma:
-	tmp_result = doca_ctx_stop(state->ctx);
+destroy_copier:
+	tmp_result = dma_bulk_copy_destroy(copier);
 	if (tmp_result != DOCA_SUCCESS) {
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+		DOCA_LOG_ERR("Failed to destroy DMA bulk copier: %s", doca_error_get_descr(tmp_result));
 	}
-	state->ctx = NULL;
-destroy_resources:
-	tmp_result = destroy_dma_resources(&resources);
+destroy_core_objects:
+	/* Also closes the device */
+	tmp_result = destroy_core_objects(&state);
 	if (tmp_result != DOCA_SUCCESS) {
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
-		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+		DOCA_LOG_ERR("Failed to destroy DOCA core objects: %s", doca_error_get_descr(tmp_result));
 	}
 
 	return result;
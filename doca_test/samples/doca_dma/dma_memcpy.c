@@ -0,0 +1,711 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "bench_common.h"
+#include "cpu_copy.h"
+#include "dma_bulk_copy.h"
+#include "dma_memcpy.h"
+#include "mmap_cache.h"
+
+DOCA_LOG_REGISTER(DMA::MEMCPY);
+
+#define DEFAULT_MAX_BATCH (32)		       /* Default number of small copies in a batch */
+#define DEFAULT_MAX_INFLIGHT (64)	       /* Default number of DMA tasks in flight */
+#define CPU_ONLY_THRESHOLD (64 * 1024)	       /* Threshold without a device */
+#define CALIBRATION_MIN_SIZE (256)	       /* Smallest size the calibration tries */
+#define CALIBRATION_MAX_SIZE (4 * 1024 * 1024) /* Largest size the calibration tries */
+#define CALIBRATION_REPS (16)		       /* Copies of each size, the fastest one counts */
+#define CALIBRATION_ALIGN (4096)	       /* Alignment of the calibration buffers */
+
+/* A copy */
+struct memcpy_req {
+	void *dst;			    /* Destination */
+	const void *src;		    /* Source */
+	size_t len;			    /* Number of bytes */
+	dma_memcpy_done_cb_t done_cb;	    /* Completion callback */
+	void *user_data;		    /* User data of the completion callback */
+	struct mmap_cache_entry *src_entry; /* Registration of the source, while on the DMA engine */
+	struct mmap_cache_entry *dst_entry; /* Registration of the destination, while on the DMA engine */
+};
+
+/* A dispatched unit of work: one large copy or a batch of small ones */
+struct memcpy_op {
+	struct dma_memcpy *engine; /* Engine the op belongs to */
+	struct memcpy_op *next;	   /* Next op the CPU runs */
+	uint64_t len;		   /* Bytes of all copies */
+	uint32_t num_reqs;	   /* Number of copies */
+	struct iovec *iov;	   /* Source then destination extents of a scatter-gather copy */
+	struct memcpy_req reqs[];  /* Copies */
+};
+
+/* A range kept registered until the engine is destroyed */
+struct memcpy_registration {
+	struct memcpy_registration *next; /* Next range */
+	struct mmap_cache_entry *entry;	  /* Registration of the range */
+};
+
+/* Engine state */
+struct dma_memcpy {
+	struct doca_pe *pe;		  /* Progress engine of the DMA engine, NULL without a device */
+	struct mmap_cache *cache;	  /* Registrations of the copied buffers */
+	struct dma_bulk_copy *copier;	  /* DMA copies, NULL without a device */
+	uint64_t threshold;		  /* Smallest copy sent to the DMA engine */
+	uint32_t max_batch;		  /* Most small copies in a batch */
+	struct memcpy_op *batch;	  /* Batch being filled, NULL if empty */
+	struct memcpy_op *cpu_head;	  /* Oldest op the CPU runs at the next progress */
+	struct memcpy_op *cpu_tail;	  /* Newest op the CPU runs at the next progress */
+	struct memcpy_registration *regs; /* Ranges kept registered */
+	uint64_t num_pending;		  /* Copies started and not completed */
+	uint64_t num_completed;		  /* Copies completed */
+	struct dma_memcpy_stats stats;	  /* Counters */
+};
+
+/*
+ * Allocate an op
+ *
+ * @engine [in]: the engine
+ * @max_reqs [in]: number of copies the op can hold
+ * @return: the op, NULL on failure
+ */
+static struct memcpy_op *alloc_op(struct dma_memcpy *engine, uint32_t max_reqs)
+{
+	struct memcpy_op *op;
+
+	op = malloc(sizeof(*op) + (size_t)max_reqs * sizeof(op->reqs[0]) + 2 * (size_t)max_reqs * sizeof(struct iovec));
+	if (op == NULL)
+		return NULL;
+	op->engine = engine;
+	op->next = NULL;
+	op->len = 0;
+	op->num_reqs = 0;
+	op->iov = (struct iovec *)&op->reqs[max_reqs];
+	return op;
+}
+
+/*
+ * Release the registrations of the copies of an op
+ *
+ * @op [in]: the op
+ */
+static void release_entries(struct memcpy_op *op)
+{
+	struct memcpy_req *req;
+	uint32_t i;
+
+	for (i = 0; i < op->num_reqs; i++) {
+		req = &op->reqs[i];
+		if (req->src_entry != NULL)
+			(void)mmap_cache_release(op->engine->cache, req->src_entry);
+		if (req->dst_entry != NULL)
+			(void)mmap_cache_release(op->engine->cache, req->dst_entry);
+		req->src_entry = NULL;
+		req->dst_entry = NULL;
+	}
+}
+
+/*
+ * Complete the copies of an op and free it
+ *
+ * @op [in]: the op
+ * @status [in]: status of the copies
+ */
+static void complete_op(struct memcpy_op *op, doca_error_t status)
+{
+	struct dma_memcpy *engine = op->engine;
+	uint32_t i;
+
+	release_entries(op);
+	engine->num_pending -= op->num_reqs;
+	engine->num_completed += op->num_reqs;
+	for (i = 0; i < op->num_reqs; i++)
+		op->reqs[i].done_cb(status, op->reqs[i].user_data);
+	free(op);
+}
+
+/*
+ * Queue an op for the CPU, it runs at the next progress
+ *
+ * @engine [in]: the engine
+ * @op [in]: the op
+ */
+static void queue_cpu_op(struct dma_memcpy *engine, struct memcpy_op *op)
+{
+	op->next = NULL;
+	if (engine->cpu_tail == NULL)
+		engine->cpu_head = op;
+	else
+		engine->cpu_tail->next = op;
+	engine->cpu_tail = op;
+}
+
+/*
+ * Copy completion callback of the DMA engine
+ *
+ * @status [in]: status of the copy
+ * @user_data [in]: the op
+ */
+static void dma_op_done_callback(doca_error_t status, void *user_data)
+{
+	struct memcpy_op *op = (struct memcpy_op *)user_data;
+
+	if (status != DOCA_SUCCESS)
+		DOCA_LOG_ERR("DMA copy of %lu bytes failed: %s", op->len, doca_error_get_descr(status));
+	complete_op(op, status);
+}
+
+/*
+ * Register both buffers of every copy of an op
+ *
+ * @op [in]: the op
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise, nothing stays registered on failure
+ */
+static doca_error_t acquire_entries(struct memcpy_op *op)
+{
+	struct memcpy_req *req;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	for (i = 0; i < op->num_reqs && result == DOCA_SUCCESS; i++) {
+		req = &op->reqs[i];
+		result = mmap_cache_acquire(op->engine->cache, (void *)req->src, req->len, &req->src_entry);
+		if (result == DOCA_SUCCESS)
+			result = mmap_cache_acquire(op->engine->cache, req->dst, req->len, &req->dst_entry);
+	}
+	if (result != DOCA_SUCCESS)
+		release_entries(op);
+	return result;
+}
+
+/*
+ * Submit an op to the DMA engine, a batch as one scatter-gather copy
+ *
+ * @op [in]: the op, its buffers registered
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_NOT_SUPPORTED if the batch spans several registrations and
+ * DOCA_ERROR otherwise
+ */
+static doca_error_t submit_dma_op(struct memcpy_op *op)
+{
+	struct dma_memcpy *engine = op->engine;
+	struct doca_mmap *src_mmap = mmap_cache_entry_get_mmap(op->reqs[0].src_entry);
+	struct doca_mmap *dst_mmap = mmap_cache_entry_get_mmap(op->reqs[0].dst_entry);
+	struct iovec *src_iov = op->iov, *dst_iov = op->iov + op->num_reqs;
+	uint32_t i;
+
+	if (op->num_reqs == 1)
+		return dma_bulk_copy_submit(engine->copier,
+					    src_mmap,
+					    op->reqs[0].src,
+					    dst_mmap,
+					    op->reqs[0].dst,
+					    op->len,
+					    dma_op_done_callback,
+					    op);
+
+	for (i = 0; i < op->num_reqs; i++) {
+		if (mmap_cache_entry_get_mmap(op->reqs[i].src_entry) != src_mmap ||
+		    mmap_cache_entry_get_mmap(op->reqs[i].dst_entry) != dst_mmap)
+			return DOCA_ERROR_NOT_SUPPORTED;
+		src_iov[i].iov_base = (void *)op->reqs[i].src;
+		src_iov[i].iov_len = op->reqs[i].len;
+		dst_iov[i].iov_base = op->reqs[i].dst;
+		dst_iov[i].iov_len = op->reqs[i].len;
+	}
+	return dma_bulk_copy_submit_sg(engine->copier,
+				       src_mmap,
+				       src_iov,
+				       op->num_reqs,
+				       dst_mmap,
+				       dst_iov,
+				       op->num_reqs,
+				       dma_op_done_callback,
+				       op);
+}
+
+/*
+ * Send an op to the DMA engine, or to the CPU if its buffers don't allow it
+ *
+ * @engine [in]: the engine
+ * @op [in]: the op
+ */
+static void dispatch_dma_op(struct dma_memcpy *engine, struct memcpy_op *op)
+{
+	doca_error_t result;
+
+	/* Without a device the op is deferred like a DMA copy, but the CPU runs it */
+	if (engine->copier == NULL) {
+		engine->stats.dma_copies += op->num_reqs;
+		engine->stats.dma_bytes += op->len;
+		if (op->num_reqs > 1)
+			engine->stats.dma_batches++;
+		queue_cpu_op(engine, op);
+		return;
+	}
+
+	result = acquire_entries(op);
+	if (result == DOCA_SUCCESS) {
+		result = submit_dma_op(op);
+		if (result != DOCA_SUCCESS)
+			release_entries(op);
+	}
+	if (result == DOCA_SUCCESS) {
+		engine->stats.dma_copies += op->num_reqs;
+		engine->stats.dma_bytes += op->len;
+		if (op->num_reqs > 1)
+			engine->stats.dma_batches++;
+		return;
+	}
+
+	/* A batch spread over several registrations is still a batch of small copies, not a fallback */
+	if (result != DOCA_ERROR_NOT_SUPPORTED) {
+		DOCA_LOG_DBG("DMA copy of %lu bytes falls back to the CPU: %s", op->len, doca_error_get_descr(result));
+		engine->stats.fallbacks += op->num_reqs;
+	}
+	engine->stats.cpu_copies += op->num_reqs;
+	engine->stats.cpu_bytes += op->len;
+	queue_cpu_op(engine, op);
+}
+
+/*
+ * Dispatch the batch being filled, to the DMA engine if it reached the threshold and to the CPU otherwise
+ *
+ * @engine [in]: the engine
+ */
+static void dispatch_batch(struct dma_memcpy *engine)
+{
+	struct memcpy_op *op = engine->batch;
+
+	if (op == NULL)
+		return;
+
+	engine->batch = NULL;
+	engine->stats.batches++;
+	if (op->len >= engine->threshold) {
+		dispatch_dma_op(engine, op);
+		return;
+	}
+	engine->stats.cpu_copies += op->num_reqs;
+	engine->stats.cpu_bytes += op->len;
+	queue_cpu_op(engine, op);
+}
+
+/*
+ * Copy completion callback of a future
+ *
+ * @status [in]: status of the copy
+ * @user_data [in]: the future
+ */
+static void dma_memcpy_future_callback(doca_error_t status, void *user_data)
+{
+	struct dma_memcpy_future *future = (struct dma_memcpy_future *)user_data;
+
+	future->status = status;
+	future->done = true;
+}
+
+/*
+ * Time the fastest of a few copies of one size, by the CPU and by the DMA engine
+ *
+ * @engine [in]: the engine
+ * @src_mmap [in]: mmap of the source
+ * @src [in]: source
+ * @dst_mmap [in]: mmap of the destination
+ * @dst [in]: destination
+ * @len [in]: number of bytes to copy
+ * @cpu_ns [out]: fastest CPU copy
+ * @dma_ns [out]: fastest DMA copy, submission to completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t time_copies(struct dma_memcpy *engine,
+				struct doca_mmap *src_mmap,
+				void *src,
+				struct doca_mmap *dst_mmap,
+				void *dst,
+				size_t len,
+				uint64_t *cpu_ns,
+				uint64_t *dma_ns)
+{
+	struct dma_memcpy_future future;
+	uint64_t start_ns, elapsed_ns;
+	doca_error_t result;
+	uint32_t i;
+
+	*cpu_ns = UINT64_MAX;
+	*dma_ns = UINT64_MAX;
+	for (i = 0; i < CALIBRATION_REPS; i++) {
+		start_ns = bench_get_time_ns();
+		cpu_copy(CPU_COPY_MEMCPY, dst, src, len);
+		elapsed_ns = bench_get_time_ns() - start_ns;
+		if (elapsed_ns < *cpu_ns)
+			*cpu_ns = elapsed_ns;
+
+		future.done = false;
+		start_ns = bench_get_time_ns();
+		result = dma_bulk_copy_submit(engine->copier,
+					      src_mmap,
+					      src,
+					      dst_mmap,
+					      dst,
+					      len,
+					      dma_memcpy_future_callback,
+					      &future);
+		if (result != DOCA_SUCCESS)
+			return result;
+		while (!future.done)
+			(void)doca_pe_progress(engine->pe);
+		elapsed_ns = bench_get_time_ns() - start_ns;
+		if (future.status != DOCA_SUCCESS)
+			return future.status;
+		if (elapsed_ns < *dma_ns)
+			*dma_ns = elapsed_ns;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Find the smallest size at which a DMA copy completes sooner than memcpy, doubling from CALIBRATION_MIN_SIZE
+ *
+ * Both copies run back to back on warm buffers, which favors memcpy for the sizes that fit in the caches, the
+ * threshold errs on the side of the CPU.
+ *
+ * @engine [in]: the engine, its copier created
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t calibrate_threshold(struct dma_memcpy *engine)
+{
+	struct mmap_cache_entry *src_entry = NULL, *dst_entry = NULL;
+	uint64_t cpu_ns, dma_ns;
+	size_t len;
+	char *src, *dst;
+	doca_error_t result, tmp_result;
+
+	src = aligned_alloc(CALIBRATION_ALIGN, CALIBRATION_MAX_SIZE);
+	dst = aligned_alloc(CALIBRATION_ALIGN, CALIBRATION_MAX_SIZE);
+	if (src == NULL || dst == NULL) {
+		DOCA_LOG_ERR("Failed to allocate calibration buffers");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_buffers;
+	}
+	memset(src, 0x5a, CALIBRATION_MAX_SIZE);
+	memset(dst, 0, CALIBRATION_MAX_SIZE);
+
+	result = mmap_cache_acquire(engine->cache, src, CALIBRATION_MAX_SIZE, &src_entry);
+	if (result == DOCA_SUCCESS)
+		result = mmap_cache_acquire(engine->cache, dst, CALIBRATION_MAX_SIZE, &dst_entry);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register calibration buffers: %s", doca_error_get_descr(result));
+		goto release_entries;
+	}
+
+	engine->threshold = UINT64_MAX;
+	for (len = CALIBRATION_MIN_SIZE; len <= CALIBRATION_MAX_SIZE; len *= 2) {
+		result = time_copies(engine,
+				     mmap_cache_entry_get_mmap(src_entry),
+				     src,
+				     mmap_cache_entry_get_mmap(dst_entry),
+				     dst,
+				     len,
+				     &cpu_ns,
+				     &dma_ns);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to time copies of %zu bytes: %s", len, doca_error_get_descr(result));
+			goto release_entries;
+		}
+		DOCA_LOG_DBG("Copy of %zu bytes: memcpy %lu ns, DMA %lu ns", len, cpu_ns, dma_ns);
+		if (dma_ns < cpu_ns) {
+			engine->threshold = len;
+			break;
+		}
+	}
+
+	if (engine->threshold == UINT64_MAX)
+		DOCA_LOG_WARN("DMA never beat memcpy up to %d bytes, every copy goes to the CPU", CALIBRATION_MAX_SIZE);
+	else
+		DOCA_LOG_INFO("Copies of %lu bytes and more go to the DMA engine", engine->threshold);
+
+release_entries:
+	if (src_entry != NULL)
+		(void)mmap_cache_release(engine->cache, src_entry);
+	if (dst_entry != NULL)
+		(void)mmap_cache_release(engine->cache, dst_entry);
+	/* The buffers are returned to the system, their registrations must not be hit again */
+	if (src != NULL) {
+		tmp_result = mmap_cache_invalidate(engine->cache, src, CALIBRATION_MAX_SIZE);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (dst != NULL) {
+		tmp_result = mmap_cache_invalidate(engine->cache, dst, CALIBRATION_MAX_SIZE);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_buffers:
+	free(src);
+	free(dst);
+	return result;
+}
+
+doca_error_t dma_memcpy_create(const struct dma_memcpy_attr *attr, struct dma_memcpy **engine)
+{
+	struct mmap_cache_attr cache_attr = {
+		.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+		.max_idle_entries = MMAP_CACHE_DEFAULT_MAX_IDLE_ENTRIES,
+		.max_idle_bytes = MMAP_CACHE_DEFAULT_MAX_IDLE_BYTES,
+	};
+	struct dma_memcpy *new_engine;
+	uint32_t max_inflight;
+	doca_error_t result;
+
+	if (attr == NULL || engine == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	new_engine = calloc(1, sizeof(*new_engine));
+	if (new_engine == NULL) {
+		DOCA_LOG_ERR("Failed to allocate DMA memcpy engine");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_engine->threshold = attr->threshold;
+	new_engine->max_batch = attr->max_batch == 0 ? DEFAULT_MAX_BATCH : attr->max_batch;
+	max_inflight = attr->max_inflight == 0 ? DEFAULT_MAX_INFLIGHT : attr->max_inflight;
+
+	if (attr->dev == NULL) {
+		if (new_engine->threshold == 0)
+			new_engine->threshold = CPU_ONLY_THRESHOLD;
+		DOCA_LOG_INFO("No device, copies of %lu bytes and more are deferred as DMA copies run by the CPU",
+			      new_engine->threshold);
+		*engine = new_engine;
+		return DOCA_SUCCESS;
+	}
+
+	result = doca_pe_create(&new_engine->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+
+	cache_attr.dev = attr->dev;
+	result = mmap_cache_create(&cache_attr, &new_engine->cache);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create registration cache: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+
+	result = dma_bulk_copy_create(attr->dev, new_engine->pe, max_inflight, 0, 0, &new_engine->copier);
+	if (result != DOCA_SUCCESS)
+		goto destroy_engine;
+
+	if (new_engine->threshold == 0) {
+		result = calibrate_threshold(new_engine);
+		if (result != DOCA_SUCCESS)
+			goto destroy_engine;
+	}
+
+	*engine = new_engine;
+	return DOCA_SUCCESS;
+
+destroy_engine:
+	(void)dma_memcpy_destroy(new_engine);
+	return result;
+}
+
+doca_error_t dma_memcpy_async(struct dma_memcpy *engine,
+			      void *dst,
+			      const void *src,
+			      size_t len,
+			      dma_memcpy_done_cb_t done_cb,
+			      void *user_data)
+{
+	struct memcpy_req req = {
+		.dst = dst,
+		.src = src,
+		.len = len,
+		.done_cb = done_cb,
+		.user_data = user_data,
+	};
+	struct memcpy_op *op;
+
+	if (engine == NULL || dst == NULL || src == NULL || len == 0 || done_cb == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	if (len >= engine->threshold) {
+		op = alloc_op(engine, 1);
+		if (op == NULL)
+			return DOCA_ERROR_NO_MEMORY;
+		op->reqs[op->num_reqs++] = req;
+		op->len = len;
+		engine->num_pending++;
+		dispatch_dma_op(engine, op);
+		return DOCA_SUCCESS;
+	}
+
+	if (engine->batch == NULL) {
+		engine->batch = alloc_op(engine, engine->max_batch);
+		if (engine->batch == NULL)
+			return DOCA_ERROR_NO_MEMORY;
+	}
+	op = engine->batch;
+	op->reqs[op->num_reqs++] = req;
+	op->len += len;
+	engine->num_pending++;
+	if (op->num_reqs == engine->max_batch || op->len >= engine->threshold)
+		dispatch_batch(engine);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t dma_memcpy_async_future(struct dma_memcpy *engine,
+				     void *dst,
+				     const void *src,
+				     size_t len,
+				     struct dma_memcpy_future *future)
+{
+	if (future == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	future->done = false;
+	future->status = DOCA_SUCCESS;
+	return dma_memcpy_async(engine, dst, src, len, dma_memcpy_future_callback, future);
+}
+
+doca_error_t dma_memcpy_register(struct dma_memcpy *engine, void *addr, size_t len)
+{
+	struct memcpy_registration *reg;
+	doca_error_t result;
+
+	if (engine == NULL || addr == NULL || len == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+	if (engine->cache == NULL)
+		return DOCA_SUCCESS;
+
+	reg = calloc(1, sizeof(*reg));
+	if (reg == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+
+	result = mmap_cache_acquire(engine->cache, addr, len, &reg->entry);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register %zu bytes: %s", len, doca_error_get_descr(result));
+		free(reg);
+		return result;
+	}
+	reg->next = engine->regs;
+	engine->regs = reg;
+	return DOCA_SUCCESS;
+}
+
+uint32_t dma_memcpy_progress(struct dma_memcpy *engine)
+{
+	uint64_t num_completed = engine->num_completed;
+	struct memcpy_op *op, *next;
+	uint32_t i;
+
+	dispatch_batch(engine);
+
+	/* Ops queued by the callbacks run at the next progress */
+	op = engine->cpu_head;
+	engine->cpu_head = NULL;
+	engine->cpu_tail = NULL;
+	for (; op != NULL; op = next) {
+		next = op->next;
+		for (i = 0; i < op->num_reqs; i++)
+			memcpy(op->reqs[i].dst, op->reqs[i].src, op->reqs[i].len);
+		complete_op(op, DOCA_SUCCESS);
+	}
+
+	if (engine->pe != NULL) {
+		while (doca_pe_progress(engine->pe) != 0)
+			continue;
+	}
+
+	return (uint32_t)(engine->num_completed - num_completed);
+}
+
+doca_error_t dma_memcpy_wait(struct dma_memcpy *engine, struct dma_memcpy_future *future)
+{
+	while (!future->done)
+		(void)dma_memcpy_progress(engine);
+	return future->status;
+}
+
+void dma_memcpy_flush(struct dma_memcpy *engine)
+{
+	while (engine->num_pending != 0)
+		(void)dma_memcpy_progress(engine);
+}
+
+uint64_t dma_memcpy_get_threshold(const struct dma_memcpy *engine)
+{
+	return engine->threshold;
+}
+
+void dma_memcpy_get_stats(const struct dma_memcpy *engine, struct dma_memcpy_stats *stats)
+{
+	*stats = engine->stats;
+}
+
+doca_error_t dma_memcpy_destroy(struct dma_memcpy *engine)
+{
+	struct memcpy_registration *reg;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (engine == NULL)
+		return DOCA_SUCCESS;
+
+	dma_memcpy_flush(engine);
+
+	while (engine->regs != NULL) {
+		reg = engine->regs;
+		engine->regs = reg->next;
+		tmp_result = mmap_cache_release(engine->cache, reg->entry);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		free(reg);
+	}
+
+	tmp_result = dma_bulk_copy_destroy(engine->copier);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+
+	if (engine->cache != NULL) {
+		tmp_result = mmap_cache_destroy(engine->cache);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy registration cache: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (engine->pe != NULL) {
+		tmp_result = doca_pe_destroy(engine->pe);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy progress engine: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(engine);
+	return result;
+}
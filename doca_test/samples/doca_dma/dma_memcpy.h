@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DMA_MEMCPY_H_
+#define DMA_MEMCPY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+
+/*
+ * Asynchronous memcpy offloaded to the DMA engine.
+ *
+ * A copy of at least the threshold goes to the DMA engine, a smaller one is done by the CPU because the DMA round
+ * trip costs more than it saves. Unless it is given, the threshold is calibrated when the engine is created: it is
+ * the smallest size at which a DMA copy beats memcpy. Buffers are registered on first use through an mmap
+ * registration cache, a copy whose buffers can't be registered falls back to the CPU.
+ *
+ * Small copies are batched until the batch holds max_batch copies or reaches the threshold in total, or until the
+ * engine is progressed. A batch that reached the threshold and whose sources share one registration, as do its
+ * destinations, goes to the DMA engine as a single scatter-gather copy, any other batch is run by the CPU in one go.
+ * Registering a pool that the buffers are carved from with dma_memcpy_register() lets its batches share one.
+ *
+ * Without a device the engine runs every copy on the CPU but keeps the same dispatch, batching and completion
+ * paths, what would go to the DMA engine is deferred to dma_memcpy_progress() instead. The dispatch logic can so be
+ * exercised on any machine.
+ *
+ * Completions are only reported from dma_memcpy_progress() and the functions that wait, never from within
+ * dma_memcpy_async(). The engine is not thread safe, callers sharing it between threads must serialize the calls.
+ */
+
+struct dma_memcpy;
+
+/*
+ * Completion callback of a copy
+ *
+ * @status [in]: DOCA_SUCCESS, or the error of the copy
+ * @user_data [in]: user data passed to dma_memcpy_async()
+ */
+typedef void (*dma_memcpy_done_cb_t)(doca_error_t status, void *user_data);
+
+/* Completion of a copy, for callers that wait for it rather than take a callback */
+struct dma_memcpy_future {
+	bool done;	     /* Whether the copy completed */
+	doca_error_t status; /* Status of the copy, valid once done */
+};
+
+/* Engine configuration */
+struct dma_memcpy_attr {
+	struct doca_dev *dev;  /* Device of the DMA engine, NULL for the CPU only fallback */
+	uint64_t threshold;    /* Smallest copy sent to the DMA engine, 0 to calibrate it */
+	uint32_t max_batch;    /* Most small copies in a batch, 0 for the default, 1 disables batching */
+	uint32_t max_inflight; /* Most DMA tasks in flight, 0 for the default */
+};
+
+/* Engine counters */
+struct dma_memcpy_stats {
+	uint64_t cpu_copies;  /* Copies run by the CPU */
+	uint64_t cpu_bytes;   /* Bytes copied by the CPU */
+	uint64_t dma_copies;  /* Copies run by the DMA engine, deferred ones without a device */
+	uint64_t dma_bytes;   /* Bytes copied by the DMA engine, deferred ones without a device */
+	uint64_t batches;     /* Batches of small copies dispatched */
+	uint64_t dma_batches; /* Batches sent to the DMA engine as one scatter-gather copy */
+	uint64_t fallbacks;   /* Copies meant for the DMA engine that the CPU ran */
+};
+
+/*
+ * Create an engine, calibrating its threshold if needed
+ *
+ * @attr [in]: engine configuration
+ * @engine [out]: the engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_memcpy_create(const struct dma_memcpy_attr *attr, struct dma_memcpy **engine);
+
+/*
+ * Start a copy
+ *
+ * @engine [in]: the engine
+ * @dst [in]: destination, must not overlap the source
+ * @src [in]: source
+ * @len [in]: number of bytes to copy, positive
+ * @done_cb [in]: called from dma_memcpy_progress() once the copy is complete, may start more copies
+ * @user_data [in]: passed to done_cb
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise, done_cb is called only on success
+ */
+doca_error_t dma_memcpy_async(struct dma_memcpy *engine,
+			      void *dst,
+			      const void *src,
+			      size_t len,
+			      dma_memcpy_done_cb_t done_cb,
+			      void *user_data);
+
+/*
+ * Start a copy that completes a future
+ *
+ * @engine [in]: the engine
+ * @dst [in]: destination, must not overlap the source
+ * @src [in]: source
+ * @len [in]: number of bytes to copy, positive
+ * @future [out]: completed once the copy is, must stay valid until then
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_memcpy_async_future(struct dma_memcpy *engine,
+				     void *dst,
+				     const void *src,
+				     size_t len,
+				     struct dma_memcpy_future *future);
+
+/*
+ * Keep a range registered until the engine is destroyed, so that every buffer carved from it shares one registration
+ * Does nothing without a device
+ *
+ * @engine [in]: the engine
+ * @addr [in]: range start address
+ * @len [in]: range length in bytes
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_memcpy_register(struct dma_memcpy *engine, void *addr, size_t len);
+
+/*
+ * Dispatch the pending batch, run the copies queued for the CPU and progress the DMA engine
+ *
+ * @engine [in]: the engine
+ * @return: number of copies that completed
+ */
+uint32_t dma_memcpy_progress(struct dma_memcpy *engine);
+
+/*
+ * Progress the engine until a copy completes
+ *
+ * @engine [in]: the engine
+ * @future [in]: future of the copy
+ * @return: status of the copy
+ */
+doca_error_t dma_memcpy_wait(struct dma_memcpy *engine, struct dma_memcpy_future *future);
+
+/*
+ * Progress the engine until every copy completes
+ *
+ * @engine [in]: the engine
+ */
+void dma_memcpy_flush(struct dma_memcpy *engine);
+
+/*
+ * Get the size from which copies go to the DMA engine
+ *
+ * @engine [in]: the engine
+ * @return: threshold in bytes, UINT64_MAX if the DMA engine never beat memcpy
+ */
+uint64_t dma_memcpy_get_threshold(const struct dma_memcpy *engine);
+
+/*
+ * Get a snapshot of the engine counters
+ *
+ * @engine [in]: the engine
+ * @stats [out]: counters
+ */
+void dma_memcpy_get_stats(const struct dma_memcpy *engine, struct dma_memcpy_stats *stats);
+
+/*
+ * Complete every copy and destroy an engine
+ *
+ * @engine [in]: the engine, may be NULL
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_memcpy_destroy(struct dma_memcpy *engine);
+
+#endif /* DMA_MEMCPY_H_ */
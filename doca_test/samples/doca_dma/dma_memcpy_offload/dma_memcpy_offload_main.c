@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "dma_bench_common.h"
+
+DOCA_LOG_REGISTER(DMA_MEMCPY_OFFLOAD::MAIN);
+
+/* Sample's Logic */
+doca_error_t dma_memcpy_offload(const struct dma_bench_config *cfg,
+				bool cpu_only,
+				uint32_t threshold,
+				uint32_t max_batch);
+
+#define DEFAULT_MSG_SIZE (1048576) /* Default largest copy */
+#define MAX_BATCH (4096)	   /* Most small copies in a batch */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct memcpy_offload_config {
+	struct dma_bench_config bench; /* Benchmark configuration, msg_size is the largest copy */
+	bool cpu_only;		       /* Whether to run the engine without a device */
+	uint32_t threshold;	       /* Smallest copy sent to the DMA engine, 0 to calibrate it */
+	uint32_t max_batch;	       /* Most small copies in a batch, 0 for the default */
+};
+
+/*
+ * ARGP Callback - Handle CPU only parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t cpu_only_callback(void *param, void *config)
+{
+	struct memcpy_offload_config *cfg = (struct memcpy_offload_config *)config;
+
+	cfg->cpu_only = *(bool *)param;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle threshold parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t threshold_callback(void *param, void *config)
+{
+	struct memcpy_offload_config *cfg = (struct memcpy_offload_config *)config;
+	const int threshold = *(int *)param;
+
+	if (threshold < 0) {
+		DOCA_LOG_ERR("Threshold can't be negative");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->threshold = (uint32_t)threshold;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle batch size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t max_batch_callback(void *param, void *config)
+{
+	struct memcpy_offload_config *cfg = (struct memcpy_offload_config *)config;
+	const int max_batch = *(int *)param;
+
+	if (max_batch <= 0 || max_batch > MAX_BATCH) {
+		DOCA_LOG_ERR("Batch size must be between 1 and %d", MAX_BATCH);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->max_batch = (uint32_t)max_batch;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register an ARGP param of the offload sample
+ *
+ * @short_name [in]: short name
+ * @long_name [in]: long name
+ * @arguments [in]: arguments shown in the usage, NULL for a flag
+ * @description [in]: description
+ * @callback [in]: callback
+ * @type [in]: param type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_param(const char *short_name,
+				   const char *long_name,
+				   const char *arguments,
+				   const char *description,
+				   doca_argp_param_cb_t callback,
+				   enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	if (arguments != NULL)
+		doca_argp_param_set_arguments(param, arguments);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the offload sample parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_memcpy_offload_params(void)
+{
+	doca_error_t result;
+
+	result = register_param("co",
+				"cpu-only",
+				NULL,
+				"Run the engine without a device, DMA copies are deferred to the CPU (optional)",
+				cpu_only_callback,
+				DOCA_ARGP_TYPE_BOOLEAN);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_param("th",
+				"threshold",
+				"<bytes>",
+				"Smallest copy sent to the DMA engine, calibrated at startup when 0 (optional)",
+				threshold_callback,
+				DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return register_param("mb",
+			      "max-batch",
+			      "<copies>",
+			      "Most small copies batched together, 1 disables batching (optional)",
+			      max_batch_callback,
+			      DOCA_ARGP_TYPE_INT);
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct memcpy_offload_config cfg = {0};
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_dma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = DEFAULT_MSG_SIZE;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_dma_memcpy_offload", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register benchmark params */
+	result = register_dma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = register_memcpy_offload_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register offload parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = dma_memcpy_offload(&cfg.bench, cfg.cpu_only, cfg.threshold, cfg.max_batch);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_memcpy_offload() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "bench_common.h"
+#include "dma_bench_common.h"
+#include "dma_memcpy.h"
+
+DOCA_LOG_REGISTER(DMA_MEMCPY_OFFLOAD::SAMPLE);
+
+#define MIN_COPY_SIZE_LOG (6) /* Smallest copies are 64 bytes */
+
+/* A slot of the pools and the copy in flight on it */
+struct offload_copy {
+	struct offload_bench *bench; /* Benchmark the copy belongs to */
+	size_t off;		     /* Offset of the slot in both pools */
+	size_t len;		     /* Length of the copy in flight */
+};
+
+/* Benchmark state */
+struct offload_bench {
+	struct dma_memcpy *engine;    /* Offload engine */
+	char *src;		      /* Source pool */
+	char *dst;		      /* Destination pool */
+	size_t pool_size;	      /* Size of each pool */
+	uint32_t max_size_log;	      /* Largest copies are 1 << max_size_log bytes, capped by the slot size */
+	uint32_t slot_size;	      /* Largest copy */
+	unsigned int seed;	      /* Random copy sizes */
+	uint64_t deadline_ns;	      /* No copy starts after this time */
+	uint64_t num_copies;	      /* Copies completed and checked */
+	uint64_t num_bytes;	      /* Bytes of the completed copies */
+	uint32_t num_inflight;	      /* Copies in flight */
+	doca_error_t result;	      /* First error */
+};
+
+/*
+ * Pick the size of the next copy, log-uniform so that small and large copies are as frequent
+ *
+ * @bench [in]: benchmark state
+ * @return: copy size in bytes
+ */
+static size_t next_copy_size(struct offload_bench *bench)
+{
+	uint32_t size_log = MIN_COPY_SIZE_LOG + rand_r(&bench->seed) % (bench->max_size_log - MIN_COPY_SIZE_LOG + 1);
+	size_t len = ((size_t)1 << size_log) + rand_r(&bench->seed) % ((size_t)1 << size_log);
+
+	return len > bench->slot_size ? bench->slot_size : len;
+}
+
+static void copy_done_callback(doca_error_t status, void *user_data);
+
+/*
+ * Start a copy on a slot
+ *
+ * @copy [in]: the slot
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t start_copy(struct offload_copy *copy)
+{
+	struct offload_bench *bench = copy->bench;
+	doca_error_t result;
+
+	copy->len = next_copy_size(bench);
+	result = dma_memcpy_async(bench->engine,
+				  bench->dst + copy->off,
+				  bench->src + copy->off,
+				  copy->len,
+				  copy_done_callback,
+				  copy);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start a copy of %zu bytes: %s", copy->len, doca_error_get_descr(result));
+		return result;
+	}
+	bench->num_inflight++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Copy completion callback, checks the copy and starts the next one on the slot until the deadline
+ *
+ * @status [in]: status of the copy
+ * @user_data [in]: the slot
+ */
+static void copy_done_callback(doca_error_t status, void *user_data)
+{
+	struct offload_copy *copy = (struct offload_copy *)user_data;
+	struct offload_bench *bench = copy->bench;
+	doca_error_t result;
+
+	bench->num_inflight--;
+	if (status != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(bench->result, status);
+		return;
+	}
+	if (memcmp(bench->dst + copy->off, bench->src + copy->off, copy->len) != 0) {
+		DOCA_LOG_ERR("Copy of %zu bytes at offset %zu is corrupted", copy->len, copy->off);
+		DOCA_ERROR_PROPAGATE(bench->result, DOCA_ERROR_UNEXPECTED);
+		return;
+	}
+	/* The next copy to the slot must not pass the check by chance */
+	memset(bench->dst + copy->off, 0, copy->len);
+	bench->num_copies++;
+	bench->num_bytes += copy->len;
+
+	if (bench->result != DOCA_SUCCESS || bench_get_time_ns() >= bench->deadline_ns)
+		return;
+	result = start_copy(copy);
+	if (result != DOCA_SUCCESS)
+		DOCA_ERROR_PROPAGATE(bench->result, result);
+}
+
+/*
+ * Log the results and how the engine dispatched the copies
+ *
+ * @bench [in]: benchmark state
+ * @elapsed_ns [in]: duration of the run
+ */
+static void report(const struct offload_bench *bench, uint64_t elapsed_ns)
+{
+	struct dma_memcpy_stats stats;
+	uint64_t threshold = dma_memcpy_get_threshold(bench->engine);
+
+	dma_memcpy_get_stats(bench->engine, &stats);
+	DOCA_LOG_INFO("Copied and checked %lu copies of 64 to %u bytes in %.3f s: %.3f GB/s",
+		      bench->num_copies,
+		      bench->slot_size,
+		      (double)elapsed_ns / 1e9,
+		      (double)bench->num_bytes / (double)elapsed_ns);
+	if (threshold == UINT64_MAX)
+		DOCA_LOG_INFO("Threshold: none, every copy goes to the CPU");
+	else
+		DOCA_LOG_INFO("Threshold: %lu bytes", threshold);
+	DOCA_LOG_INFO("CPU: %lu copies, %lu bytes, %lu of them fell back from the DMA engine",
+		      stats.cpu_copies,
+		      stats.cpu_bytes,
+		      stats.fallbacks);
+	DOCA_LOG_INFO("DMA: %lu copies, %lu bytes", stats.dma_copies, stats.dma_bytes);
+	DOCA_LOG_INFO("Batches: %lu, %lu of them sent to the DMA engine as one scatter-gather copy",
+		      stats.batches,
+		      stats.dma_batches);
+}
+
+/*
+ * Run DOCA DMA memcpy offload sample
+ *
+ * Keeps queue_depth copies of random sizes in flight through the offload engine for the configured duration,
+ * checking every copy, then logs how the engine dispatched them.
+ *
+ * @cfg [in]: benchmark configuration, msg_size is the largest copy
+ * @cpu_only [in]: whether to run the engine without a device
+ * @threshold [in]: smallest copy sent to the DMA engine, 0 to calibrate it
+ * @max_batch [in]: most small copies in a batch, 0 for the default
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_memcpy_offload(const struct dma_bench_config *cfg,
+				bool cpu_only,
+				uint32_t threshold,
+				uint32_t max_batch)
+{
+	struct offload_bench bench = {0};
+	struct dma_memcpy_attr attr = {
+		.threshold = threshold,
+		.max_batch = max_batch,
+	};
+	struct offload_copy *copies;
+	struct doca_dev *dev = NULL;
+	uint64_t start_ns;
+	uint32_t i;
+	doca_error_t result, tmp_result;
+
+	bench.slot_size = cfg->msg_size;
+	bench.pool_size = (size_t)cfg->queue_depth * cfg->msg_size;
+	bench.seed = 1;
+	for (bench.max_size_log = MIN_COPY_SIZE_LOG; ((size_t)1 << bench.max_size_log) < bench.slot_size;)
+		bench.max_size_log++;
+
+	copies = calloc(cfg->queue_depth, sizeof(*copies));
+	bench.src = bench_alloc_numa(bench.pool_size, -1);
+	bench.dst = bench_alloc_numa(bench.pool_size, -1);
+	if (copies == NULL || bench.src == NULL || bench.dst == NULL) {
+		DOCA_LOG_ERR("Failed to allocate two pools of %zu bytes", bench.pool_size);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_pools;
+	}
+	for (i = 0; i < bench.pool_size; i++)
+		bench.src[i] = (char)rand_r(&bench.seed);
+
+	if (!cpu_only) {
+		result = dma_bench_open_device(cfg, &dev);
+		if (result != DOCA_SUCCESS)
+			goto free_pools;
+	}
+
+	attr.dev = dev;
+	result = dma_memcpy_create(&attr, &bench.engine);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA memcpy engine: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	/* Small copies carved from the pools can share a registration and be batched into scatter-gather copies */
+	result = dma_memcpy_register(bench.engine, bench.src, bench.pool_size);
+	if (result == DOCA_SUCCESS)
+		result = dma_memcpy_register(bench.engine, bench.dst, bench.pool_size);
+	if (result != DOCA_SUCCESS)
+		goto destroy_engine;
+
+	DOCA_LOG_INFO("Running %u copies at once for %u seconds", cfg->queue_depth, cfg->duration_sec);
+	start_ns = bench_get_time_ns();
+	bench.deadline_ns = start_ns + (uint64_t)cfg->duration_sec * BENCH_NSEC_PER_SEC;
+	for (i = 0; i < cfg->queue_depth; i++) {
+		copies[i].bench = &bench;
+		copies[i].off = (size_t)i * bench.slot_size;
+		result = start_copy(&copies[i]);
+		if (result != DOCA_SUCCESS) {
+			bench.result = result;
+			break;
+		}
+	}
+	while (bench.num_inflight != 0)
+		(void)dma_memcpy_progress(bench.engine);
+	result = bench.result;
+	if (result == DOCA_SUCCESS)
+		report(&bench, bench_get_time_ns() - start_ns);
+
+destroy_engine:
+	tmp_result = dma_memcpy_destroy(bench.engine);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DMA memcpy engine: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	if (dev != NULL) {
+		tmp_result = doca_dev_close(dev);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+free_pools:
+	bench_free_numa(bench.dst, bench.pool_size);
+	bench_free_numa(bench.src, bench.pool_size);
+	free(copies);
+	return result;
+}
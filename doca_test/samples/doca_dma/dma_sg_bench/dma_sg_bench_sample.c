@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "bench_common.h"
+#include "dma_bench_common.h"
+#include "dma_bulk_copy.h"
+
+DOCA_LOG_REGISTER(DMA_SG_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024)			     /* PE progress calls between two deadline checks */
+#define MMAP_PERMISSIONS (DOCA_ACCESS_FLAG_LOCAL_READ_WRITE) /* Access flags of the source and destination */
+#define MIN_EXTENT_SIZE (512)				     /* Smallest extent of the sweep */
+#define MAX_EXTENT_SIZE (1048576)			     /* Largest extent of the sweep */
+#define MAX_SWEEP_POINTS (12)				     /* Extent sizes from MIN to MAX_EXTENT_SIZE */
+
+/* How the extents of a copy are mapped to memcpy tasks */
+enum sg_mode {
+	SG_MODE_CHAINED,    /* As many extents per task as the device chains */
+	SG_MODE_PER_EXTENT, /* One task per extent */
+	SG_MODE_NUM,	    /* Number of modes */
+};
+
+/* Measurements of one extent size */
+struct sg_result {
+	uint64_t extent_size;		   /* Size of every extent */
+	uint32_t num_extents;		   /* Extents per copy on each side */
+	double tasks_per_copy[SG_MODE_NUM]; /* Memcpy tasks a copy took */
+	double gbps[SG_MODE_NUM];	   /* Achieved bandwidth in Gbit/s */
+};
+
+/* Benchmark state */
+struct sg_bench {
+	struct dma_bench_config *cfg; /* Benchmark configuration, msg_size is the length of a copy */
+	struct doca_dev *dev;	      /* DOCA device */
+	struct doca_pe *pe;	      /* Progress engine */
+	size_t region_size;	      /* Size of the source and of the destination region */
+	char *src_region;	      /* Source memory */
+	char *dst_region;	      /* Destination memory */
+	struct doca_mmap *src_mmap;   /* Registration of the source */
+	struct doca_mmap *dst_mmap;   /* Registration of the destination */
+	struct iovec *src_iov;	      /* Source extents of the current point */
+	struct iovec *dst_iov;	      /* Destination extents of the current point */
+	uint32_t num_extents;	      /* Extents per copy of the current point */
+	struct dma_bulk_copy *copier; /* Copier of the current mode */
+	bool running;		      /* Whether completed copies should be resubmitted */
+	uint32_t num_inflight;	      /* Number of submitted copies that have not completed yet */
+	uint64_t completed_ops;	      /* Number of completed copies */
+	doca_error_t result;	      /* First error encountered by the callbacks */
+};
+
+/*
+ * Register a region with a started mmap
+ *
+ * @dev [in]: DOCA device
+ * @region [in]: region start
+ * @len [in]: region length
+ * @mmap [out]: started mmap
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_region(struct doca_dev *dev, char *region, size_t len, struct doca_mmap **mmap)
+{
+	doca_error_t result;
+
+	result = doca_mmap_create(mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_set_permissions(*mmap, MMAP_PERMISSIONS);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(*mmap, region, len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(*mmap, dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(*mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register a region of %zu bytes: %s", len, doca_error_get_descr(result));
+		(void)doca_mmap_destroy(*mmap);
+		*mmap = NULL;
+	}
+
+	return result;
+}
+
+/*
+ * Lay the extents of a point out, every extent is followed by a gap of its size so that neither side is contiguous.
+ * The destination extents sit in the gaps of the source pattern, so no two extents of a side are adjacent in either
+ * region.
+ *
+ * @bench [in]: benchmark state
+ * @extent_size [in]: size of every extent
+ */
+static void layout_extents(struct sg_bench *bench, uint64_t extent_size)
+{
+	uint32_t i;
+
+	bench->num_extents = (uint32_t)(bench->cfg->msg_size / extent_size);
+	for (i = 0; i < bench->num_extents; i++) {
+		bench->src_iov[i].iov_base = bench->src_region + 2 * i * extent_size;
+		bench->src_iov[i].iov_len = extent_size;
+		bench->dst_iov[i].iov_base = bench->dst_region + (2 * i + 1) * extent_size;
+		bench->dst_iov[i].iov_len = extent_size;
+	}
+}
+
+/*
+ * Copy completion callback, copies the same extents again while the run is active
+ *
+ * @status [in]: status of the copy
+ * @user_data [in]: benchmark state
+ */
+static void sg_copy_done_callback(doca_error_t status, void *user_data)
+{
+	struct sg_bench *bench = (struct sg_bench *)user_data;
+
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("DMA scatter-gather copy failed: %s", doca_error_get_descr(status));
+		DOCA_ERROR_PROPAGATE(bench->result, status);
+		bench->running = false;
+	} else {
+		bench->completed_ops++;
+	}
+
+	if (!bench->running) {
+		bench->num_inflight--;
+		return;
+	}
+
+	status = dma_bulk_copy_submit_sg(bench->copier,
+					 bench->src_mmap,
+					 bench->src_iov,
+					 bench->num_extents,
+					 bench->dst_mmap,
+					 bench->dst_iov,
+					 bench->num_extents,
+					 sg_copy_done_callback,
+					 bench);
+	if (status != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to resubmit DMA scatter-gather copy: %s", doca_error_get_descr(status));
+		DOCA_ERROR_PROPAGATE(bench->result, status);
+		bench->running = false;
+		bench->num_inflight--;
+	}
+}
+
+/*
+ * Keep queue_depth copies of the current extents in flight for the configured duration, with a copier that chains
+ * up to max_list_len extents per task
+ *
+ * @bench [in]: benchmark state
+ * @max_list_len [in]: extents per task and side, 0 for the device limit
+ * @tasks_per_copy [out]: memcpy tasks a copy took
+ * @gbps [out]: achieved bandwidth in Gbit/s
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_mode(struct sg_bench *bench, uint32_t max_list_len, double *tasks_per_copy, double *gbps)
+{
+	uint64_t start_ns, deadline_ns, elapsed_ns, timed_ops, num_polls = 0;
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	/* Same task budget for both modes, only the number of extents a task carries differs */
+	result = dma_bulk_copy_create(bench->dev, bench->pe, bench->cfg->queue_depth, 0, max_list_len, &bench->copier);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	bench->completed_ops = 0;
+	bench->result = DOCA_SUCCESS;
+	bench->running = true;
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < bench->cfg->queue_depth; i++) {
+		result = dma_bulk_copy_submit_sg(bench->copier,
+						 bench->src_mmap,
+						 bench->src_iov,
+						 bench->num_extents,
+						 bench->dst_mmap,
+						 bench->dst_iov,
+						 bench->num_extents,
+						 sg_copy_done_callback,
+						 bench);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA scatter-gather copy: %s", doca_error_get_descr(result));
+			bench->running = false;
+			break;
+		}
+		bench->num_inflight++;
+	}
+
+	while (bench->running) {
+		(void)doca_pe_progress(bench->pe);
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && bench_get_time_ns() >= deadline_ns)
+			bench->running = false;
+	}
+	elapsed_ns = bench_get_time_ns() - start_ns;
+	timed_ops = bench->completed_ops;
+
+	while (bench->num_inflight > 0)
+		(void)doca_pe_progress(bench->pe);
+
+	*gbps = (double)timed_ops * bench->cfg->msg_size * 8.0 / (double)elapsed_ns;
+	*tasks_per_copy = 0.0;
+	if (bench->completed_ops > 0)
+		*tasks_per_copy = (double)dma_bulk_copy_get_num_segments(bench->copier) / (double)bench->completed_ops;
+
+	DOCA_ERROR_PROPAGATE(result, bench->result);
+	tmp_result = dma_bulk_copy_destroy(bench->copier);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	bench->copier = NULL;
+	return result;
+}
+
+/*
+ * Print the sweep results
+ *
+ * @results [in]: results of every extent size
+ * @num_points [in]: number of extent sizes
+ * @msg_size [in]: length of a copy
+ */
+static void report_sweep(const struct sg_result *results, uint32_t num_points, uint32_t msg_size)
+{
+	const struct sg_result *res;
+	uint32_t i;
+
+	DOCA_LOG_INFO("Scatter-gather copies of %u bytes, chained extents vs one task per extent", msg_size);
+	DOCA_LOG_INFO("    extent | extents | tasks chained | tasks per-extent | Gbit/s chained | Gbit/s per-extent");
+	for (i = 0; i < num_points; i++) {
+		res = &results[i];
+		DOCA_LOG_INFO("%10lu | %7u | %13.1f | %16.1f | %14.3f | %17.3f (%.2fx)",
+			      res->extent_size,
+			      res->num_extents,
+			      res->tasks_per_copy[SG_MODE_CHAINED],
+			      res->tasks_per_copy[SG_MODE_PER_EXTENT],
+			      res->gbps[SG_MODE_CHAINED],
+			      res->gbps[SG_MODE_PER_EXTENT],
+			      res->gbps[SG_MODE_PER_EXTENT] == 0.0 ?
+				      0.0 :
+				      res->gbps[SG_MODE_CHAINED] / res->gbps[SG_MODE_PER_EXTENT]);
+	}
+}
+
+/*
+ * Sweep the extent size of scatter-gather copies from MIN_EXTENT_SIZE to MAX_EXTENT_SIZE, every copy moves msg_size
+ * bytes between discontiguous extents. Each size is measured with a copier that chains the extents into as few tasks
+ * as the device allows and with one that issues a task per extent.
+ *
+ * @cfg [in]: Configuration parameters, msg_size is the length of a copy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_sg_bench(struct dma_bench_config *cfg)
+{
+	struct sg_result results[MAX_SWEEP_POINTS] = {0};
+	struct sg_bench bench = {0};
+	uint32_t max_list_lens[SG_MODE_NUM] = {0, 1};
+	uint32_t num_points = 0, mode;
+	uint64_t extent_size;
+	doca_error_t result, tmp_result;
+
+	if (cfg->msg_size < MIN_EXTENT_SIZE) {
+		DOCA_LOG_ERR("Copy size must be at least the smallest extent, %u bytes", MIN_EXTENT_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	bench.cfg = cfg;
+	bench.region_size = 2 * (size_t)cfg->msg_size;
+	bench.src_iov = calloc(cfg->msg_size / MIN_EXTENT_SIZE, sizeof(*bench.src_iov));
+	bench.dst_iov = calloc(cfg->msg_size / MIN_EXTENT_SIZE, sizeof(*bench.dst_iov));
+	if (bench.src_iov == NULL || bench.dst_iov == NULL) {
+		DOCA_LOG_ERR("Failed to allocate extent arrays");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_iovs;
+	}
+
+	bench.src_region = bench_alloc_numa(bench.region_size, -1);
+	bench.dst_region = bench_alloc_numa(bench.region_size, -1);
+	if (bench.src_region == NULL || bench.dst_region == NULL) {
+		DOCA_LOG_ERR("Failed to allocate two regions of %zu bytes", bench.region_size);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_regions;
+	}
+
+	result = dma_bench_open_device(cfg, &bench.dev);
+	if (result != DOCA_SUCCESS)
+		goto free_regions;
+
+	result = register_region(bench.dev, bench.src_region, bench.region_size, &bench.src_mmap);
+	if (result != DOCA_SUCCESS)
+		goto close_dev;
+
+	result = register_region(bench.dev, bench.dst_region, bench.region_size, &bench.dst_mmap);
+	if (result != DOCA_SUCCESS)
+		goto destroy_src_mmap;
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto destroy_dst_mmap;
+	}
+
+	for (extent_size = MIN_EXTENT_SIZE; extent_size <= MAX_EXTENT_SIZE && extent_size <= cfg->msg_size;
+	     extent_size *= 2) {
+		layout_extents(&bench, extent_size);
+		results[num_points].extent_size = extent_size;
+		results[num_points].num_extents = bench.num_extents;
+		for (mode = 0; mode < SG_MODE_NUM; mode++) {
+			result = run_mode(&bench,
+					  max_list_lens[mode],
+					  &results[num_points].tasks_per_copy[mode],
+					  &results[num_points].gbps[mode]);
+			if (result != DOCA_SUCCESS)
+				goto destroy_pe;
+		}
+		num_points++;
+	}
+
+	report_sweep(results, num_points, cfg->msg_size);
+
+destroy_pe:
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+destroy_dst_mmap:
+	(void)doca_mmap_stop(bench.dst_mmap);
+	(void)doca_mmap_destroy(bench.dst_mmap);
+destroy_src_mmap:
+	(void)doca_mmap_stop(bench.src_mmap);
+	(void)doca_mmap_destroy(bench.src_mmap);
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_regions:
+	bench_free_numa(bench.dst_region, bench.region_size);
+	bench_free_numa(bench.src_region, bench.region_size);
+free_iovs:
+	free(bench.dst_iov);
+	free(bench.src_iov);
+	return result;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DMA_STREAM_RING_H_
+#define DMA_STREAM_RING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Host and DPU streaming rings.
+ *
+ * The host exports one region, once, that holds a pull ring and optionally a push ring. Each ring has a producer
+ * line, a consumer line and num_slots slots of slot_size bytes. Message i lives in slot i % num_slots and starts with
+ * a dma_stream_slot_hdr.
+ *
+ * Pull ring, host to DPU: the host fills a slot and then publishes it by storing the new producer index with release
+ * semantics. The DPU polls the producer line with DMA reads, pulls the published slots with pipelined DMA reads and
+ * acknowledges them by DMA writing the number of consumed messages into the consumer line, which frees their slots
+ * for the host.
+ *
+ * Push ring, DPU to host: the DPU DMA writes its messages into the host slots and, once the writes completed, rings
+ * the doorbell by DMA writing the producer index. The host polls that word, consumes the messages and returns the
+ * slots by storing the consumer index, which the DPU reads when it runs out of free slots.
+ *
+ * Every index is a single aligned 64-bit word so that a DMA access never sees half of an update. The top bit of a
+ * producer index is set together with the final index once its producer stops. The host closes the pull ring when it
+ * is done, which also ends the push ring. The top bit of the pull consumer index is set by the last acknowledgment,
+ * once both rings are drained, after which the DPU no longer touches the region.
+ */
+
+#define DMA_STREAM_MAGIC (0x31474e4952414d44ULL)      /* "DMARING1" */
+#define DMA_STREAM_LINE_SIZE (64)		      /* Producer and consumer lines are on separate cache lines */
+#define DMA_STREAM_IDX_FLAG (1ULL << 63)	      /* Producer closed / consumer detached */
+#define DMA_STREAM_IDX_MASK (DMA_STREAM_IDX_FLAG - 1) /* Index part of an index word */
+#define DMA_STREAM_IDX_NONE (UINT64_MAX)	      /* Pull consumer index before the DPU attaches */
+
+/* Producer line, written by the producer: the host for the pull ring and the DPU for the push ring */
+struct dma_stream_prod_line {
+	uint64_t magic;	    /* DMA_STREAM_MAGIC, set by the host */
+	uint32_t num_slots; /* Number of slots, set by the host */
+	uint32_t slot_size; /* Size of a slot, header included, set by the host */
+	uint64_t prod_idx;  /* Number of published messages, DMA_STREAM_IDX_FLAG once closed */
+} __attribute__((aligned(DMA_STREAM_LINE_SIZE)));
+
+/* Consumer line, written by the consumer */
+struct dma_stream_cons_line {
+	uint64_t cons_idx; /* Number of consumed messages, DMA_STREAM_IDX_FLAG once detached */
+} __attribute__((aligned(DMA_STREAM_LINE_SIZE)));
+
+/* Control lines of a ring */
+struct dma_stream_ring {
+	struct dma_stream_prod_line prod; /* Producer line */
+	struct dma_stream_cons_line cons; /* Consumer line */
+};
+
+/* Rings of a region */
+enum dma_stream_dir {
+	DMA_STREAM_PULL,     /* Host to DPU, the DPU reads the messages */
+	DMA_STREAM_PUSH,     /* DPU to host, the DPU writes the messages */
+	DMA_STREAM_NUM_DIRS, /* Number of rings */
+};
+
+/* Start of the exported region, the slots of the pull ring follow, then those of the push ring */
+struct dma_stream_region {
+	struct dma_stream_ring rings[DMA_STREAM_NUM_DIRS]; /* Control lines, a push ring of 0 slots is disabled */
+};
+
+/* Header of every message */
+struct dma_stream_slot_hdr {
+	uint64_t seq; /* Message index */
+	uint32_t len; /* Payload length, the payload follows the header */
+	uint32_t crc; /* CRC32C of the payload */
+};
+
+/*
+ * Get the size of a region
+ *
+ * @num_slots [in]: number of slots of each ring
+ * @slot_size [in]: size of a slot
+ * @push [in]: whether the region holds a push ring
+ * @return: region size in bytes
+ */
+static inline size_t dma_stream_region_size(uint32_t num_slots, uint32_t slot_size, bool push)
+{
+	return sizeof(struct dma_stream_region) + (push ? 2 : 1) * (size_t)num_slots * slot_size;
+}
+
+/*
+ * Get the offset of the slot of a message in a region
+ *
+ * @dir [in]: ring of the message
+ * @idx [in]: message index
+ * @num_slots [in]: number of slots of each ring
+ * @slot_size [in]: size of a slot
+ * @return: slot offset in bytes
+ */
+static inline size_t dma_stream_slot_offset(enum dma_stream_dir dir,
+					    uint64_t idx,
+					    uint32_t num_slots,
+					    uint32_t slot_size)
+{
+	return sizeof(struct dma_stream_region) + ((size_t)dir * num_slots + (size_t)(idx % num_slots)) * slot_size;
+}
+
+#endif /* DMA_STREAM_RING_H_ */
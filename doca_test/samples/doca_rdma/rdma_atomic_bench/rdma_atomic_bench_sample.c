@@ -0,0 +1,1022 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_ATOMIC_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024)	  /* Number of PE progress calls between two deadline checks */
+#define SWEEP_FACTOR (4)		  /* Ratio between two consecutive steps of the depth and connections sweeps */
+#define MAX_SWEEP_STEPS (8)		  /* Enough steps to sweep up to RDMA_BENCH_MAX_CONNECTIONS */
+#define MAX_SLOTS (65536)		  /* Maximum number of connections times depth */
+#define COUNTER_STRIDE (64)		  /* Distance between two counters, so that they never share a cache line */
+#define LOCK_OFFSET (0)			  /* Offset of the lock word in the target region */
+#define PROTECTED_OFFSET (COUNTER_STRIDE) /* Offset of the counter protected by the lock */
+#define LOCK_FREE (0)			  /* Value of the lock word when no contender holds it */
+#define NUM_COUNTER_MODES (2)		  /* Fetch and add and compare and swap */
+
+/* What every outstanding operation does */
+enum atomic_bench_mode {
+	ATOMIC_BENCH_FETCH_ADD, /* Add one to a counter */
+	ATOMIC_BENCH_CMP_SWP,	/* Increment a counter with compare and swap, retrying with the returned value */
+	ATOMIC_BENCH_LOCK,	/* Take a CAS lock, increment a plain counter with read and write, release the lock */
+};
+
+static const char *const mode_names[] = {"fetch-add", "cmp-swap", "cas-lock"};
+
+/* Stage of a lock contender */
+enum lock_stage {
+	LOCK_STAGE_ACQUIRE, /* Compare and swap from free to the contender id */
+	LOCK_STAGE_READ,    /* Read of the protected counter */
+	LOCK_STAGE_WRITE,   /* Write of the incremented protected counter */
+	LOCK_STAGE_RELEASE, /* Compare and swap from the contender id to free */
+};
+
+struct atomic_bench;
+
+/* One outstanding operation, or one lock contender */
+struct atomic_slot {
+	struct atomic_bench *bench;			    /* Benchmark the slot belongs to */
+	uint64_t owner_id;				    /* Lock word value while this contender holds the lock */
+	volatile uint64_t *result;			    /* Original remote value returned by the atomics */
+	uint64_t *value;				    /* Protected counter value, used under the lock */
+	uint64_t expected;				    /* Value the counter should hold, for compare and swap */
+	enum lock_stage stage;				    /* Stage of a lock contender */
+	struct doca_buf *target_buf;			    /* Remote counter or lock word */
+	struct doca_buf *result_buf;			    /* Local buffer for the original remote value */
+	struct doca_buf *protected_src_buf;		    /* Remote protected counter, source of the read */
+	struct doca_buf *protected_dst_buf;		    /* Remote protected counter, target of the write */
+	struct doca_buf *value_dst_buf;			    /* Local counter value, target of the read */
+	struct doca_buf *value_src_buf;			    /* Local counter value, source of the write */
+	struct doca_rdma_task_atomic_fetch_add *fetch_add; /* Fetch and add task */
+	struct doca_rdma_task_atomic_cmp_swp *cmp_swp;	    /* Compare and swap task */
+	struct doca_rdma_task_read *read;		    /* Read task of a lock contender */
+	struct doca_rdma_task_write *write;		    /* Write task of a lock contender */
+};
+
+/* Result of one run */
+struct atomic_result {
+	double mops;		 /* Million successful operations (increments or lock acquisitions) per second */
+	double attempts_per_op;	 /* Atomic operations per successful operation */
+	bool verified;		 /* Whether the final counter matches the number of successful operations */
+};
+
+/* Benchmark state */
+struct atomic_bench {
+	struct rdma_bench_config *cfg;		/* Benchmark configuration */
+	struct doca_dev *dev;			/* DOCA device */
+	struct doca_pe *pe;			/* Progress engine driving both endpoints */
+	struct rdma_bench_endpoint requester;	/* Endpoint issuing the operations */
+	struct rdma_bench_endpoint responder;	/* Endpoint owning the counters */
+	int numa_node;				/* NUMA node of the device */
+	uint32_t max_slots;			/* Number of slots at the largest depth and number of connections */
+	size_t region_len;			/* Length of the local and of the target region */
+	char *local;				/* Result and protected counter value of every slot */
+	char *target;				/* Counters and lock word */
+	struct doca_mmap *local_mmap;		/* Registration of local */
+	struct doca_mmap *target_mmap;		/* Registration of target */
+	struct doca_mmap *target_view_mmap;	/* target as seen by the requester */
+	struct doca_buf_inventory *inventory;	/* Inventory for the slot buffers */
+	struct atomic_slot *slots;		/* Slots of the current run */
+	uint32_t num_slots;			/* Number of slots of the current run */
+	uint32_t num_active;			/* Number of slots with a task in flight */
+	enum atomic_bench_mode mode;		/* Mode of the current run */
+	bool running;				/* Whether slots should keep going */
+	uint64_t completed_ops;			/* Number of successful operations */
+	uint64_t attempts;			/* Number of submitted atomic operations */
+	doca_error_t result;			/* First error encountered by the callbacks */
+};
+
+/*
+ * Free the tasks of a slot
+ *
+ * @slot [in]: slot with no task in flight
+ */
+static void slot_free_tasks(struct atomic_slot *slot)
+{
+	if (slot->fetch_add != NULL)
+		doca_task_free(doca_rdma_task_atomic_fetch_add_as_task(slot->fetch_add));
+	if (slot->cmp_swp != NULL)
+		doca_task_free(doca_rdma_task_atomic_cmp_swp_as_task(slot->cmp_swp));
+	if (slot->read != NULL)
+		doca_task_free(doca_rdma_task_read_as_task(slot->read));
+	if (slot->write != NULL)
+		doca_task_free(doca_rdma_task_write_as_task(slot->write));
+	slot->fetch_add = NULL;
+	slot->cmp_swp = NULL;
+	slot->read = NULL;
+	slot->write = NULL;
+}
+
+/*
+ * Retire a slot that has nothing in flight anymore
+ *
+ * @slot [in]: slot to finish
+ */
+static void slot_finish(struct atomic_slot *slot)
+{
+	slot_free_tasks(slot);
+	slot->bench->num_active--;
+}
+
+/*
+ * Record an error and stop all the slots
+ *
+ * @bench [in]: benchmark state
+ * @result [in]: error to record
+ */
+static void bench_fail(struct atomic_bench *bench, doca_error_t result)
+{
+	DOCA_ERROR_PROPAGATE(bench->result, result);
+	bench->running = false;
+}
+
+/*
+ * Submit the next task of a slot, the slot is finished if the submission fails
+ *
+ * @slot [in]: slot the task belongs to
+ * @task [in]: task to submit
+ */
+static void slot_submit(struct atomic_slot *slot, struct doca_task *task)
+{
+	doca_error_t result;
+
+	result = doca_task_submit(task);
+	if (result == DOCA_SUCCESS)
+		return;
+
+	DOCA_LOG_ERR("Failed to submit RDMA task: %s", doca_error_get_descr(result));
+	bench_fail(slot->bench, result);
+	slot_finish(slot);
+}
+
+/*
+ * Submit an atomic task of a slot, its result buffer must be emptied first since the previous operation filled it
+ *
+ * @slot [in]: slot the task belongs to
+ * @task [in]: fetch and add or compare and swap task
+ */
+static void slot_submit_atomic(struct atomic_slot *slot, struct doca_task *task)
+{
+	(void)doca_buf_reset_data_len(slot->result_buf);
+	slot->bench->attempts++;
+	slot_submit(slot, task);
+}
+
+/*
+ * Submit the compare and swap task of a slot with new operands
+ *
+ * @slot [in]: slot the task belongs to
+ * @cmp_data [in]: value the remote word is expected to hold
+ * @swap_data [in]: value to store if it does
+ */
+static void slot_submit_cmp_swp(struct atomic_slot *slot, uint64_t cmp_data, uint64_t swap_data)
+{
+	doca_rdma_task_atomic_cmp_swp_set_cmp_data(slot->cmp_swp, cmp_data);
+	doca_rdma_task_atomic_cmp_swp_set_swap_data(slot->cmp_swp, swap_data);
+	slot_submit_atomic(slot, doca_rdma_task_atomic_cmp_swp_as_task(slot->cmp_swp));
+}
+
+/*
+ * RDMA fetch and add task completed callback, every completion is one increment
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_fetch_add_completed_callback(struct doca_rdma_task_atomic_fetch_add *task,
+						union doca_data task_user_data,
+						union doca_data ctx_user_data)
+{
+	struct atomic_slot *slot = (struct atomic_slot *)task_user_data.ptr;
+	struct atomic_bench *bench = (struct atomic_bench *)ctx_user_data.ptr;
+
+	bench->completed_ops++;
+	if (!bench->running) {
+		slot_finish(slot);
+		return;
+	}
+	slot_submit_atomic(slot, doca_rdma_task_atomic_fetch_add_as_task(task));
+}
+
+/*
+ * Compare and swap completion of a lock contender, either acquires or releases the lock
+ *
+ * @slot [in]: lock contender
+ */
+static void lock_cmp_swp_completed(struct atomic_slot *slot)
+{
+	struct atomic_bench *bench = slot->bench;
+	const uint64_t original = *slot->result;
+
+	if (slot->stage == LOCK_STAGE_ACQUIRE) {
+		if (original != LOCK_FREE) {
+			/* Held by another contender, spin */
+			if (!bench->running)
+				slot_finish(slot);
+			else
+				slot_submit_atomic(slot, doca_rdma_task_atomic_cmp_swp_as_task(slot->cmp_swp));
+			return;
+		}
+
+		/* Once acquired the critical section always runs to the release, so the final counter is exact */
+		slot->stage = LOCK_STAGE_READ;
+		(void)doca_buf_reset_data_len(slot->value_dst_buf);
+		slot_submit(slot, doca_rdma_task_read_as_task(slot->read));
+		return;
+	}
+
+	if (original != slot->owner_id) {
+		DOCA_LOG_ERR("Lock word held %lu instead of %lu on release", original, slot->owner_id);
+		bench_fail(bench, DOCA_ERROR_UNEXPECTED);
+	} else
+		bench->completed_ops++;
+
+	if (!bench->running) {
+		slot_finish(slot);
+		return;
+	}
+	slot->stage = LOCK_STAGE_ACQUIRE;
+	slot_submit_cmp_swp(slot, LOCK_FREE, slot->owner_id);
+}
+
+/*
+ * RDMA compare and swap task completed callback
+ * For counters a swap is one increment and the next attempt compares with the value the counter now holds
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_cmp_swp_completed_callback(struct doca_rdma_task_atomic_cmp_swp *task,
+					      union doca_data task_user_data,
+					      union doca_data ctx_user_data)
+{
+	struct atomic_slot *slot = (struct atomic_slot *)task_user_data.ptr;
+	struct atomic_bench *bench = (struct atomic_bench *)ctx_user_data.ptr;
+	uint64_t original;
+	(void)task;
+
+	if (bench->mode == ATOMIC_BENCH_LOCK) {
+		lock_cmp_swp_completed(slot);
+		return;
+	}
+
+	original = *slot->result;
+	if (original == slot->expected) {
+		bench->completed_ops++;
+		slot->expected = original + 1;
+	} else
+		slot->expected = original;
+
+	if (!bench->running) {
+		slot_finish(slot);
+		return;
+	}
+	slot_submit_cmp_swp(slot, slot->expected, slot->expected + 1);
+}
+
+/*
+ * RDMA read task completed callback, increments the protected counter value under the lock
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_read_completed_callback(struct doca_rdma_task_read *task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data)
+{
+	struct atomic_slot *slot = (struct atomic_slot *)task_user_data.ptr;
+	(void)task;
+	(void)ctx_user_data;
+
+	(*slot->value)++;
+	slot->stage = LOCK_STAGE_WRITE;
+	slot_submit(slot, doca_rdma_task_write_as_task(slot->write));
+}
+
+/*
+ * RDMA write task completed callback, releases the lock
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_write_completed_callback(struct doca_rdma_task_write *task,
+					    union doca_data task_user_data,
+					    union doca_data ctx_user_data)
+{
+	struct atomic_slot *slot = (struct atomic_slot *)task_user_data.ptr;
+	(void)task;
+	(void)ctx_user_data;
+
+	/* The write completion means it was executed by the responder, so the next holder reads the new value */
+	slot->stage = LOCK_STAGE_RELEASE;
+	slot_submit_cmp_swp(slot, slot->owner_id, LOCK_FREE);
+}
+
+/*
+ * Common error handling of all the task types
+ *
+ * @task [in]: failed task
+ * @slot [in]: slot the task belongs to
+ */
+static void atomic_task_error(struct doca_task *task, struct atomic_slot *slot)
+{
+	doca_error_t result = doca_task_get_status(task);
+
+	DOCA_LOG_ERR("RDMA task failed: %s", doca_error_get_descr(result));
+	bench_fail(slot->bench, result);
+	slot_finish(slot);
+}
+
+/*
+ * RDMA fetch and add task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_fetch_add_error_callback(struct doca_rdma_task_atomic_fetch_add *task,
+					    union doca_data task_user_data,
+					    union doca_data ctx_user_data)
+{
+	(void)ctx_user_data;
+	atomic_task_error(doca_rdma_task_atomic_fetch_add_as_task(task), (struct atomic_slot *)task_user_data.ptr);
+}
+
+/*
+ * RDMA compare and swap task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_cmp_swp_error_callback(struct doca_rdma_task_atomic_cmp_swp *task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	(void)ctx_user_data;
+	atomic_task_error(doca_rdma_task_atomic_cmp_swp_as_task(task), (struct atomic_slot *)task_user_data.ptr);
+}
+
+/*
+ * RDMA read task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_read_error_callback(struct doca_rdma_task_read *task,
+				       union doca_data task_user_data,
+				       union doca_data ctx_user_data)
+{
+	(void)ctx_user_data;
+	atomic_task_error(doca_rdma_task_read_as_task(task), (struct atomic_slot *)task_user_data.ptr);
+}
+
+/*
+ * RDMA write task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void atomic_write_error_callback(struct doca_rdma_task_write *task,
+					union doca_data task_user_data,
+					union doca_data ctx_user_data)
+{
+	(void)ctx_user_data;
+	atomic_task_error(doca_rdma_task_write_as_task(task), (struct atomic_slot *)task_user_data.ptr);
+}
+
+/*
+ * Get an 8-byte buffer from the inventory
+ *
+ * @bench [in]: benchmark state
+ * @mmap [in]: mmap the address belongs to
+ * @addr [in]: buffer address
+ * @with_data [in]: whether the 8 bytes are the buffer data, or only its capacity
+ * @buf [out]: buffer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t get_word_buf(struct atomic_bench *bench,
+				 struct doca_mmap *mmap,
+				 void *addr,
+				 bool with_data,
+				 struct doca_buf **buf)
+{
+	doca_error_t result;
+
+	if (with_data)
+		result = doca_buf_inventory_buf_get_by_data(bench->inventory, mmap, addr, sizeof(uint64_t), buf);
+	else
+		result = doca_buf_inventory_buf_get_by_addr(bench->inventory, mmap, addr, sizeof(uint64_t), buf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to allocate DOCA buffer: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Prepare the buffers and tasks of a slot
+ *
+ * @bench [in]: benchmark state
+ * @slot_idx [in]: slot index
+ * @contended [in]: whether all the counter slots target the same counter
+ * @num_connections [in]: number of connections the slots are spread over
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_slot(struct atomic_bench *bench,
+				 uint32_t slot_idx,
+				 bool contended,
+				 uint32_t num_connections)
+{
+	struct atomic_slot *slot = &bench->slots[slot_idx];
+	struct doca_rdma_connection *connection = bench->requester.connections[slot_idx % num_connections];
+	char *local = bench->local + (size_t)slot_idx * COUNTER_STRIDE;
+	union doca_data task_user_data = {.ptr = slot};
+	char *target;
+	doca_error_t result;
+
+	if (bench->mode == ATOMIC_BENCH_LOCK)
+		target = bench->target + LOCK_OFFSET;
+	else if (contended)
+		target = bench->target;
+	else
+		target = bench->target + (size_t)slot_idx * COUNTER_STRIDE;
+
+	slot->bench = bench;
+	slot->owner_id = slot_idx + 1;
+	slot->result = (volatile uint64_t *)local;
+	slot->value = (uint64_t *)(local + sizeof(uint64_t));
+	slot->stage = LOCK_STAGE_ACQUIRE;
+
+	result = get_word_buf(bench, bench->target_view_mmap, target, true, &slot->target_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = get_word_buf(bench, bench->local_mmap, local, false, &slot->result_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	switch (bench->mode) {
+	case ATOMIC_BENCH_FETCH_ADD:
+		result = doca_rdma_task_atomic_fetch_add_allocate_init(bench->requester.rdma,
+								       connection,
+								       slot->target_buf,
+								       slot->result_buf,
+								       1,
+								       task_user_data,
+								       &slot->fetch_add);
+		break;
+	case ATOMIC_BENCH_CMP_SWP:
+		result = doca_rdma_task_atomic_cmp_swp_allocate_init(bench->requester.rdma,
+								     connection,
+								     slot->target_buf,
+								     slot->result_buf,
+								     0,
+								     1,
+								     task_user_data,
+								     &slot->cmp_swp);
+		break;
+	case ATOMIC_BENCH_LOCK:
+		result = get_word_buf(bench,
+				      bench->target_view_mmap,
+				      bench->target + PROTECTED_OFFSET,
+				      true,
+				      &slot->protected_src_buf);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = get_word_buf(bench,
+				      bench->target_view_mmap,
+				      bench->target + PROTECTED_OFFSET,
+				      false,
+				      &slot->protected_dst_buf);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = get_word_buf(bench, bench->local_mmap, slot->value, false, &slot->value_dst_buf);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = get_word_buf(bench, bench->local_mmap, slot->value, true, &slot->value_src_buf);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		result = doca_rdma_task_atomic_cmp_swp_allocate_init(bench->requester.rdma,
+								     connection,
+								     slot->target_buf,
+								     slot->result_buf,
+								     LOCK_FREE,
+								     slot->owner_id,
+								     task_user_data,
+								     &slot->cmp_swp);
+		if (result != DOCA_SUCCESS)
+			break;
+		result = doca_rdma_task_read_allocate_init(bench->requester.rdma,
+							   connection,
+							   slot->protected_src_buf,
+							   slot->value_dst_buf,
+							   task_user_data,
+							   &slot->read);
+		if (result != DOCA_SUCCESS)
+			break;
+		result = doca_rdma_task_write_allocate_init(bench->requester.rdma,
+							    connection,
+							    slot->value_src_buf,
+							    slot->protected_dst_buf,
+							    task_user_data,
+							    &slot->write);
+		break;
+	}
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to allocate RDMA task: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Release the tasks and buffers of all the slots of the current run
+ *
+ * @bench [in]: benchmark state
+ */
+static void release_slots(struct atomic_bench *bench)
+{
+	uint32_t i, j;
+
+	for (i = 0; i < bench->num_slots; i++) {
+		struct atomic_slot *slot = &bench->slots[i];
+		struct doca_buf *bufs[] = {slot->target_buf,
+					   slot->result_buf,
+					   slot->protected_src_buf,
+					   slot->protected_dst_buf,
+					   slot->value_dst_buf,
+					   slot->value_src_buf};
+
+		/* Slots that were never submitted still hold their tasks */
+		slot_free_tasks(slot);
+		for (j = 0; j < sizeof(bufs) / sizeof(bufs[0]); j++)
+			if (bufs[j] != NULL)
+				(void)doca_buf_dec_refcount(bufs[j], NULL);
+	}
+	memset(bench->slots, 0, bench->num_slots * sizeof(*bench->slots));
+	bench->num_slots = 0;
+}
+
+/*
+ * Check the final value of the counters against the number of successful operations
+ *
+ * @bench [in]: benchmark state
+ * @contended [in]: whether all the counter slots targeted the same counter
+ * @return: true if they match
+ */
+static bool verify_counters(struct atomic_bench *bench, bool contended)
+{
+	uint64_t total = 0;
+	uint32_t i;
+
+	if (bench->mode == ATOMIC_BENCH_LOCK)
+		return *(volatile uint64_t *)(bench->target + LOCK_OFFSET) == LOCK_FREE &&
+		       *(volatile uint64_t *)(bench->target + PROTECTED_OFFSET) == bench->completed_ops;
+
+	if (contended)
+		return *(volatile uint64_t *)bench->target == bench->completed_ops;
+
+	for (i = 0; i < bench->num_slots; i++)
+		total += *(volatile uint64_t *)(bench->target + (size_t)i * COUNTER_STRIDE);
+
+	return total == bench->completed_ops;
+}
+
+/*
+ * Run one mode at one depth and number of connections
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: what every slot does
+ * @contended [in]: whether all the counter slots target the same counter, ignored by the lock
+ * @num_connections [in]: number of connections
+ * @depth [in]: outstanding operations per connection, ignored by the lock which has one contender per connection
+ * @res [out]: result of the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_atomic(struct atomic_bench *bench,
+			       enum atomic_bench_mode mode,
+			       bool contended,
+			       uint32_t num_connections,
+			       uint32_t depth,
+			       struct atomic_result *res)
+{
+	uint64_t start_ns, deadline_ns, elapsed_ns, num_polls = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	bench->mode = mode;
+	bench->num_slots = mode == ATOMIC_BENCH_LOCK ? num_connections : num_connections * depth;
+	bench->completed_ops = 0;
+	bench->attempts = 0;
+	bench->result = DOCA_SUCCESS;
+	memset(bench->target, 0, bench->region_len);
+	memset(bench->local, 0, bench->region_len);
+
+	for (i = 0; i < bench->num_slots; i++) {
+		result = prepare_slot(bench, i, contended, num_connections);
+		if (result != DOCA_SUCCESS)
+			goto release;
+	}
+
+	bench->running = true;
+	bench->num_active = bench->num_slots;
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < bench->num_slots && bench->running; i++) {
+		struct atomic_slot *slot = &bench->slots[i];
+
+		if (mode == ATOMIC_BENCH_FETCH_ADD)
+			slot_submit_atomic(slot, doca_rdma_task_atomic_fetch_add_as_task(slot->fetch_add));
+		else
+			slot_submit_atomic(slot, doca_rdma_task_atomic_cmp_swp_as_task(slot->cmp_swp));
+	}
+	/* Slots left unsubmitted after a failure are released below */
+	bench->num_active -= bench->num_slots - i;
+
+	while (bench->running) {
+		(void)doca_pe_progress(bench->pe);
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && bench_get_time_ns() >= deadline_ns)
+			bench->running = false;
+	}
+	elapsed_ns = bench_get_time_ns() - start_ns;
+
+	/* Drain, the completion callbacks finish the slots */
+	while (bench->num_active > 0)
+		(void)doca_pe_progress(bench->pe);
+	result = bench->result;
+
+	res->mops = (double)bench->completed_ops * 1000.0 / (double)elapsed_ns;
+	res->attempts_per_op = bench->completed_ops == 0 ? 0.0 : (double)bench->attempts / (double)bench->completed_ops;
+	res->verified = verify_counters(bench, contended);
+	if (!res->verified) {
+		DOCA_LOG_ERR("%s with %u connections: counter does not match %lu successful operations",
+			     mode_names[mode],
+			     num_connections,
+			     bench->completed_ops);
+		DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_UNEXPECTED);
+	}
+
+release:
+	release_slots(bench);
+	return result;
+}
+
+/*
+ * Register the local and target regions, shared by all the runs
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_memory(struct atomic_bench *bench)
+{
+	const uint32_t target_permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_ATOMIC |
+					    DOCA_ACCESS_FLAG_RDMA_READ | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	doca_error_t result;
+
+	/* The lock needs two words in separate cache lines even with a single slot */
+	bench->region_len = (size_t)(bench->max_slots < 2 ? 2 : bench->max_slots) * COUNTER_STRIDE;
+	bench->local = bench_alloc_numa(bench->region_len, bench->numa_node);
+	bench->target = bench_alloc_numa(bench->region_len, bench->numa_node);
+	if (bench->local == NULL || bench->target == NULL) {
+		DOCA_LOG_ERR("Failed to allocate two regions of %zu bytes", bench->region_len);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = create_local_mmap(&bench->local_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   bench->local,
+				   bench->region_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = create_local_mmap(&bench->target_mmap,
+				   target_permissions,
+				   bench->target,
+				   bench->region_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_import_mmap(bench->target_mmap, bench->dev, &bench->target_view_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* Up to six buffers per lock contender, two per counter slot */
+	result = doca_buf_inventory_create(6 * bench->max_slots, &bench->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(bench->inventory);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Release the memory of prepare_memory()
+ *
+ * @bench [in]: benchmark state
+ */
+static void destroy_memory(struct atomic_bench *bench)
+{
+	if (bench->inventory != NULL) {
+		(void)doca_buf_inventory_stop(bench->inventory);
+		(void)doca_buf_inventory_destroy(bench->inventory);
+	}
+	if (bench->target_view_mmap != NULL)
+		(void)doca_mmap_destroy(bench->target_view_mmap);
+	if (bench->target_mmap != NULL) {
+		(void)doca_mmap_stop(bench->target_mmap);
+		(void)doca_mmap_destroy(bench->target_mmap);
+	}
+	if (bench->local_mmap != NULL) {
+		(void)doca_mmap_stop(bench->local_mmap);
+		(void)doca_mmap_destroy(bench->local_mmap);
+	}
+	bench_free_numa(bench->target, bench->region_len);
+	bench_free_numa(bench->local, bench->region_len);
+}
+
+/*
+ * Fill a sweep from 1 to max, multiplying by SWEEP_FACTOR, max is always the last step
+ *
+ * @max [in]: last step
+ * @steps [out]: steps of the sweep
+ * @return: number of steps
+ */
+static uint32_t build_sweep(uint32_t max, uint32_t *steps)
+{
+	uint32_t num_steps = 0, value;
+
+	for (value = 1; value < max && num_steps < MAX_SWEEP_STEPS - 1; value *= SWEEP_FACTOR)
+		steps[num_steps++] = value;
+	steps[num_steps++] = max;
+
+	return num_steps;
+}
+
+/*
+ * Create, start and connect the two endpoints
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_endpoints(struct atomic_bench *bench)
+{
+	struct rdma_bench_config *cfg = bench->cfg;
+	struct rdma_bench_endpoint_attr attr = {0};
+	union doca_data ctx_user_data = {0};
+	doca_error_t result;
+
+	attr.num_connections = cfg->rdma.num_connections;
+	attr.send_queue_size = cfg->queue_depth;
+	attr.transport_type = cfg->rdma.transport_type;
+	attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	attr.gid_index = cfg->rdma.gid_index;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->requester);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_ATOMIC |
+			   DOCA_ACCESS_FLAG_RDMA_READ | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->responder);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_task_atomic_fetch_add_set_conf(bench->requester.rdma,
+							  atomic_fetch_add_completed_callback,
+							  atomic_fetch_add_error_callback,
+							  bench->max_slots);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA fetch and add task: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_atomic_cmp_swp_set_conf(bench->requester.rdma,
+							atomic_cmp_swp_completed_callback,
+							atomic_cmp_swp_error_callback,
+							bench->max_slots);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA compare and swap task: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_read_set_conf(bench->requester.rdma,
+					      atomic_read_completed_callback,
+					      atomic_read_error_callback,
+					      cfg->rdma.num_connections);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA read task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_write_set_conf(bench->requester.rdma,
+					       atomic_write_completed_callback,
+					       atomic_write_error_callback,
+					       cfg->rdma.num_connections);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	ctx_user_data.ptr = bench;
+	result = doca_ctx_set_user_data(bench->requester.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->requester);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->responder);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return rdma_bench_connect_loopback(&bench->requester, &bench->responder, cfg->rdma.num_connections);
+}
+
+/*
+ * Measure remote fetch and add and compare and swap on uncontended counters (one per outstanding operation) and on a
+ * single contended counter, sweeping the depth up to queue_depth and the connections up to num_connections, then a
+ * CAS lock with one contender per connection that increments a plain remote counter under the lock.
+ * Atomics are 8 bytes, the message size is not used.
+ *
+ * @cfg [in]: Configuration parameters
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_atomic_bench(struct rdma_bench_config *cfg)
+{
+	struct atomic_result counter_results[NUM_COUNTER_MODES][2][MAX_SWEEP_STEPS][MAX_SWEEP_STEPS] = {0};
+	struct atomic_result lock_results[MAX_SWEEP_STEPS] = {0};
+	uint32_t conn_steps[MAX_SWEEP_STEPS], depth_steps[MAX_SWEEP_STEPS];
+	uint32_t num_conn_steps, num_depth_steps, c, d, m, contended;
+	struct atomic_bench bench = {0};
+	double best[NUM_COUNTER_MODES] = {0};
+	doca_error_t result, tmp_result;
+
+	bench.cfg = cfg;
+	bench.max_slots = cfg->rdma.num_connections * cfg->queue_depth;
+	if (bench.max_slots > MAX_SLOTS) {
+		DOCA_LOG_ERR("Connections times queue depth must be <= %d", MAX_SLOTS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	num_conn_steps = build_sweep(cfg->rdma.num_connections, conn_steps);
+	num_depth_steps = build_sweep(cfg->queue_depth, depth_steps);
+
+	bench.slots = calloc(bench.max_slots, sizeof(*bench.slots));
+	if (bench.slots == NULL) {
+		DOCA_LOG_ERR("Failed to allocate slot array");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_atomic_cmp_swp_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		goto free_slots;
+	}
+	bench.numa_node = bench_get_ibdev_numa_node(cfg->rdma.device_name);
+
+	result = doca_rdma_cap_task_atomic_fetch_add_is_supported(doca_dev_as_devinfo(bench.dev));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Device does not support RDMA fetch and add task: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	result = prepare_endpoints(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = prepare_memory(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_memory;
+
+	for (m = 0; m < NUM_COUNTER_MODES; m++)
+		for (contended = 0; contended < 2; contended++)
+			for (c = 0; c < num_conn_steps; c++)
+				for (d = 0; d < num_depth_steps; d++) {
+					result = run_atomic(&bench,
+							    (enum atomic_bench_mode)m,
+							    contended,
+							    conn_steps[c],
+							    depth_steps[d],
+							    &counter_results[m][contended][c][d]);
+					if (result != DOCA_SUCCESS)
+						goto destroy_memory;
+				}
+
+	for (c = 0; c < num_conn_steps; c++) {
+		result = run_atomic(&bench, ATOMIC_BENCH_LOCK, true, conn_steps[c], 1, &lock_results[c]);
+		if (result != DOCA_SUCCESS)
+			goto destroy_memory;
+	}
+
+	DOCA_LOG_INFO("Remote counter increments, uncontended: one counter per outstanding operation");
+	DOCA_LOG_INFO(" operation |   counter   | conns | depth |     Mops/s | attempts/op");
+	for (m = 0; m < NUM_COUNTER_MODES; m++)
+		for (contended = 0; contended < 2; contended++)
+			for (c = 0; c < num_conn_steps; c++)
+				for (d = 0; d < num_depth_steps; d++) {
+					const struct atomic_result *res = &counter_results[m][contended][c][d];
+
+					DOCA_LOG_INFO("%10s | %11s | %5u | %5u | %10.3f | %11.2f",
+						      mode_names[m],
+						      contended ? "contended" : "uncontended",
+						      conn_steps[c],
+						      depth_steps[d],
+						      res->mops,
+						      res->attempts_per_op);
+					if (contended && res->mops > best[m])
+						best[m] = res->mops;
+				}
+
+	DOCA_LOG_INFO("CAS lock, one contender per connection, plain read and write under the lock");
+	DOCA_LOG_INFO("contenders | Macquire/s | CAS/acquire");
+	for (c = 0; c < num_conn_steps; c++)
+		DOCA_LOG_INFO("%10u | %10.3f | %11.2f",
+			      conn_steps[c],
+			      lock_results[c].mops,
+			      lock_results[c].attempts_per_op);
+
+	DOCA_LOG_INFO("Shared sequencer peak: fetch-add %.3f Mops/s, cmp-swap %.3f Mops/s, all counters verified",
+		      best[ATOMIC_BENCH_FETCH_ADD],
+		      best[ATOMIC_BENCH_CMP_SWP]);
+
+destroy_memory:
+	destroy_memory(&bench);
+destroy_endpoints:
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.requester);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.responder);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_slots:
+	free(bench.slots);
+	return result;
+}
@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2023 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <inttypes.h>
+
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_buf_inventory.h>
+#include <doca_buf.h>
+#include <doca_ctx.h>
+
+#include "rdma_common.h"
+
+DOCA_LOG_REGISTER(RDMA_ATOMIC_REQUESTER::SAMPLE);
+
+#define FETCH_ADD_VALUE (1)	/* Value added to the responder's counter */
+#define COUNTER_RESET_VALUE (0) /* Value the compare and swap writes to the responder's counter */
+
+/*
+ * Write the connection details for the responder to read,
+ * and read the connection details and the remote mmap string of the responder
+ * In DC transport mode it is only needed to read the remote connection details
+ *
+ * @cfg [in]: Configuration parameters
+ * @resources [in/out]: RDMA resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t write_read_connection(struct rdma_config *cfg, struct rdma_resources *resources)
+{
+	doca_error_t result = DOCA_SUCCESS;
+
+	if (cfg->transport_type == DOCA_RDMA_TRANSPORT_TYPE_RC) {
+		/* Write the RDMA connection details */
+		result = write_file(cfg->local_connection_desc_path,
+				    (char *)resources->rdma_conn_descriptor,
+				    resources->rdma_conn_descriptor_size);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to write the RDMA connection details: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		DOCA_LOG_INFO("You can now copy %s to the responder", cfg->local_connection_desc_path);
+	}
+
+	DOCA_LOG_INFO(
+		"Please copy %s and %s from the responder and then press enter after pressing enter in the responder side",
+		cfg->remote_connection_desc_path,
+		cfg->remote_resource_desc_path);
+
+	/* Wait for enter */
+	wait_for_enter();
+
+	/* Read the remote RDMA connection details */
+	result = read_file(cfg->remote_connection_desc_path,
+			   (char **)&resources->remote_rdma_conn_descriptor,
+			   &resources->remote_rdma_conn_descriptor_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read the remote RDMA connection details: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Read the remote mmap connection details */
+	result = read_file(cfg->remote_resource_desc_path,
+			   (char **)&resources->remote_mmap_descriptor,
+			   &resources->remote_mmap_descriptor_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read the remote RDMA mmap connection details: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	return result;
+}
+
+/*
+ * Release the buffers shared by the atomic tasks, and stop the context once all tasks are completed
+ *
+ * @resources [in]: RDMA resources
+ */
+static void rdma_atomic_requester_finish(struct rdma_resources *resources)
+{
+	doca_error_t result;
+
+	result = doca_buf_dec_refcount(resources->dst_buf, NULL);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decrease dst_buf count: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
+	}
+	result = doca_buf_dec_refcount(resources->src_buf, NULL);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decrease src_buf count: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
+	}
+
+	resources->num_remaining_tasks--;
+	/* Stop context once all tasks are completed */
+	if (resources->num_remaining_tasks == 0) {
+		if (resources->cfg->use_rdma_cm == true)
+			(void)rdma_cm_disconnect(resources);
+		(void)doca_ctx_stop(resources->rdma_ctx);
+	}
+}
+
+/*
+ * Prepare and submit the RDMA compare and swap task that resets the counter, unless it changed after the fetch and add
+ *
+ * @resources [in]: RDMA resources
+ * @cmp_data [in]: value the counter is expected to hold
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rdma_cmp_swp_prepare_and_submit_task(struct rdma_resources *resources, uint64_t cmp_data)
+{
+	struct doca_rdma_task_atomic_cmp_swp *rdma_cmp_swp_task = NULL;
+	union doca_data task_user_data = {0};
+	doca_error_t result;
+
+	/* The result buffer still holds the value returned by the fetch and add */
+	result = doca_buf_reset_data_len(resources->src_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to reset result buffer: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Include first_encountered_error in user data of task to be used in the callbacks */
+	task_user_data.ptr = &(resources->first_encountered_error);
+	/* Allocate and construct RDMA compare and swap task */
+	result = doca_rdma_task_atomic_cmp_swp_allocate_init(resources->rdma,
+							     resources->connections[0],
+							     resources->dst_buf,
+							     resources->src_buf,
+							     cmp_data,
+							     COUNTER_RESET_VALUE,
+							     task_user_data,
+							     &rdma_cmp_swp_task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate RDMA compare and swap task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Submit RDMA compare and swap task */
+	DOCA_LOG_INFO("Submitting RDMA compare and swap task that resets the counter if it still holds %" PRIu64,
+		      cmp_data);
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task));
+	result = doca_task_submit(doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit RDMA compare and swap task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task));
+		doca_task_free(doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task));
+	}
+
+	return result;
+}
+
+/*
+ * RDMA fetch and add task completed callback, continues with the compare and swap task
+ *
+ * @rdma_fetch_add_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void rdma_fetch_add_completed_callback(struct doca_rdma_task_atomic_fetch_add *rdma_fetch_add_task,
+					      union doca_data task_user_data,
+					      union doca_data ctx_user_data)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
+	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
+	const uint64_t ticket = *(volatile uint64_t *)resources->mmap_memrange;
+	doca_error_t result;
+
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task),
+				    RDMA_LATENCY_TASK_ATOMIC_FETCH_ADD,
+				    doca_rdma_task_atomic_fetch_add_get_rdma_connection(rdma_fetch_add_task),
+				    sizeof(uint64_t));
+
+	DOCA_LOG_INFO("RDMA fetch and add task was done Successfully");
+	DOCA_LOG_INFO("Took ticket %" PRIu64 " from the responder's counter", ticket);
+
+	doca_task_free(doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task));
+
+	/* The buffers are reused by the compare and swap task, which takes over the remaining task */
+	result = rdma_cmp_swp_prepare_and_submit_task(resources, ticket + FETCH_ADD_VALUE);
+	if (result == DOCA_SUCCESS)
+		return;
+
+	/* Update that an error was encountered */
+	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
+	rdma_atomic_requester_finish(resources);
+}
+
+/*
+ * RDMA fetch and add task error callback
+ *
+ * @rdma_fetch_add_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void rdma_fetch_add_error_callback(struct doca_rdma_task_atomic_fetch_add *rdma_fetch_add_task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
+	struct doca_task *task = doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task);
+	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
+	doca_error_t result;
+
+	/* Update that an error was encountered */
+	result = doca_task_get_status(task);
+	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
+	DOCA_LOG_ERR("RDMA fetch and add task failed: %s", doca_error_get_descr(result));
+
+	rdma_latency_task_failed(resources->latency, task);
+	doca_task_free(task);
+	rdma_atomic_requester_finish(resources);
+}
+
+/*
+ * RDMA compare and swap task completed callback
+ *
+ * @rdma_cmp_swp_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void rdma_cmp_swp_completed_callback(struct doca_rdma_task_atomic_cmp_swp *rdma_cmp_swp_task,
+					    union doca_data task_user_data,
+					    union doca_data ctx_user_data)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
+	const uint64_t cmp_data = doca_rdma_task_atomic_cmp_swp_get_cmp_data(rdma_cmp_swp_task);
+	const uint64_t original = *(volatile uint64_t *)resources->mmap_memrange;
+	(void)task_user_data;
+
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task),
+				    RDMA_LATENCY_TASK_ATOMIC_CMP_SWP,
+				    doca_rdma_task_atomic_cmp_swp_get_rdma_connection(rdma_cmp_swp_task),
+				    sizeof(uint64_t));
+
+	DOCA_LOG_INFO("RDMA compare and swap task was done Successfully");
+	if (original == cmp_data)
+		DOCA_LOG_INFO("Counter was reset to %d", COUNTER_RESET_VALUE);
+	else
+		DOCA_LOG_INFO("Counter holds %" PRIu64 " instead of %" PRIu64 ", another requester took a ticket",
+			      original,
+			      cmp_data);
+
+	doca_task_free(doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task));
+	rdma_atomic_requester_finish(resources);
+}
+
+/*
+ * RDMA compare and swap task error callback
+ *
+ * @rdma_cmp_swp_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void rdma_cmp_swp_error_callback(struct doca_rdma_task_atomic_cmp_swp *rdma_cmp_swp_task,
+					union doca_data task_user_data,
+					union doca_data ctx_user_data)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
+	struct doca_task *task = doca_rdma_task_atomic_cmp_swp_as_task(rdma_cmp_swp_task);
+	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
+	doca_error_t result;
+
+	/* Update that an error was encountered */
+	result = doca_task_get_status(task);
+	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
+	DOCA_LOG_ERR("RDMA compare and swap task failed: %s", doca_error_get_descr(result));
+
+	rdma_latency_task_failed(resources->latency, task);
+	doca_task_free(task);
+	rdma_atomic_requester_finish(resources);
+}
+
+/*
+ * Export and receive connection details, and connect to the remote RDMA
+ *
+ * @resources [in]: RDMA resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rdma_atomic_requester_export_and_connect(struct rdma_resources *resources)
+{
+	doca_error_t result;
+
+	if (resources->cfg->use_rdma_cm == true)
+		return rdma_cm_connect(resources);
+
+	/* Export RDMA connection details */
+	result = doca_rdma_export(resources->rdma,
+				  &(resources->rdma_conn_descriptor),
+				  &(resources->rdma_conn_descriptor_size),
+				  &(resources->connections[0]));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to export RDMA: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* write and read connection details to the responder */
+	result = write_read_connection(resources->cfg, resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to write and read connection details from responder: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Connect RDMA */
+	result = doca_rdma_connect(resources->rdma,
+				   resources->remote_rdma_conn_descriptor,
+				   resources->remote_rdma_conn_descriptor_size,
+				   resources->connections[0]);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to connect the requester's RDMA to the responder's RDMA: %s",
+			     doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Prepare and submit RDMA fetch and add task, the compare and swap task is submitted once it completes
+ *
+ * @resources [in]: RDMA resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rdma_atomic_prepare_and_submit_task(struct rdma_resources *resources)
+{
+	struct doca_rdma_task_atomic_fetch_add *rdma_fetch_add_task = NULL;
+	union doca_data task_user_data = {0};
+	char *remote_mmap_range;
+	size_t remote_mmap_range_len;
+	doca_error_t result, tmp_result;
+
+	/* Create remote mmap */
+	result = doca_mmap_create_from_export(NULL,
+					      resources->remote_mmap_descriptor,
+					      resources->remote_mmap_descriptor_size,
+					      resources->doca_device,
+					      &(resources->remote_mmap));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Get the remote mmap memory range */
+	result = doca_mmap_get_memrange(resources->remote_mmap, (void **)&remote_mmap_range, &remote_mmap_range_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get DOCA memory map range: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	if (remote_mmap_range_len < sizeof(uint64_t)) {
+		DOCA_LOG_ERR("Remote memory range of %zu bytes can't hold the counter", remote_mmap_range_len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	/* Add dst buffer to DOCA buffer inventory, the counter is the first 8 bytes of the remote mmap */
+	result = doca_buf_inventory_buf_get_by_data(resources->buf_inventory,
+						    resources->remote_mmap,
+						    remote_mmap_range,
+						    sizeof(uint64_t),
+						    &resources->dst_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DOCA buffer to DOCA buffer inventory: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Add src buffer to DOCA buffer inventory, it receives the original value of the counter */
+	result = doca_buf_inventory_buf_get_by_addr(resources->buf_inventory,
+						    resources->mmap,
+						    resources->mmap_memrange,
+						    sizeof(uint64_t),
+						    &resources->src_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DOCA buffer to DOCA buffer inventory: %s",
+			     doca_error_get_descr(result));
+		goto destroy_dst_buf;
+	}
+
+	/* Include first_encountered_error in user data of task to be used in the callbacks */
+	task_user_data.ptr = &(resources->first_encountered_error);
+	/* Allocate and construct RDMA fetch and add task */
+	result = doca_rdma_task_atomic_fetch_add_allocate_init(resources->rdma,
+							       resources->connections[0],
+							       resources->dst_buf,
+							       resources->src_buf,
+							       FETCH_ADD_VALUE,
+							       task_user_data,
+							       &rdma_fetch_add_task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate RDMA fetch and add task: %s", doca_error_get_descr(result));
+		goto destroy_src_buf;
+	}
+
+	/* Submit RDMA fetch and add task */
+	DOCA_LOG_INFO("Submitting RDMA fetch and add task that adds %d to the responder's counter", FETCH_ADD_VALUE);
+	resources->num_remaining_tasks++;
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task));
+	result = doca_task_submit(doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit RDMA fetch and add task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency,
+					 doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task));
+		resources->num_remaining_tasks--;
+		goto free_task;
+	}
+
+	return result;
+
+free_task:
+	doca_task_free(doca_rdma_task_atomic_fetch_add_as_task(rdma_fetch_add_task));
+destroy_src_buf:
+	tmp_result = doca_buf_dec_refcount(resources->src_buf, NULL);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decrease src_buf count: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+destroy_dst_buf:
+	tmp_result = doca_buf_dec_refcount(resources->dst_buf, NULL);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decrease dst_buf count: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
+
+/*
+ * RDMA atomic requester state change callback
+ * This function represents the state machine for this RDMA program
+ *
+ * @user_data [in]: doca_data from the context
+ * @ctx [in]: DOCA context
+ * @prev_state [in]: Previous DOCA context state
+ * @next_state [in]: Next DOCA context state
+ */
+static void rdma_atomic_requester_state_change_callback(const union doca_data user_data,
+							struct doca_ctx *ctx,
+							enum doca_ctx_states prev_state,
+							enum doca_ctx_states next_state)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)user_data.ptr;
+	struct rdma_config *cfg = resources->cfg;
+	doca_error_t result = DOCA_SUCCESS;
+	(void)prev_state;
+	(void)ctx;
+
+	switch (next_state) {
+	case DOCA_CTX_STATE_STARTING:
+		DOCA_LOG_INFO("RDMA context entered starting state");
+		break;
+	case DOCA_CTX_STATE_RUNNING:
+		DOCA_LOG_INFO("RDMA context is running");
+
+		result = rdma_atomic_requester_export_and_connect(resources);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("rdma_atomic_requester_export_and_connect() failed: %s",
+				     doca_error_get_descr(result));
+			break;
+		} else
+			DOCA_LOG_INFO("RDMA context finished initialization");
+
+		if (cfg->use_rdma_cm == true)
+			break;
+
+		result = rdma_atomic_prepare_and_submit_task(resources);
+		if (result != DOCA_SUCCESS)
+			DOCA_LOG_ERR("rdma_atomic_prepare_and_submit_task() failed: %s", doca_error_get_descr(result));
+		break;
+	case DOCA_CTX_STATE_STOPPING:
+		/**
+		 * doca_ctx_stop() has been called.
+		 * In this sample, this happens either due to a failure encountered, in which case doca_pe_progress()
+		 * will cause any inflight task to be flushed, or due to the successful compilation of the sample flow.
+		 * In both cases, in this sample, doca_pe_progress() will eventually transition the context to idle
+		 * state.
+		 */
+		DOCA_LOG_INFO("RDMA context entered into stopping state. Any inflight tasks will be flushed");
+		break;
+	case DOCA_CTX_STATE_IDLE:
+		DOCA_LOG_INFO("RDMA context has been stopped");
+
+		/* We can stop progressing the PE */
+		resources->run_pe_progress = false;
+		break;
+	default:
+		break;
+	}
+
+	/* If something failed - update that an error was encountered and stop the ctx */
+	if (result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
+		(void)doca_ctx_stop(ctx);
+	}
+}
+
+/*
+ * Requester side of the RDMA atomic operations, takes a ticket from the responder's counter with fetch and add
+ * and resets the counter with compare and swap, unless another requester took a ticket in between
+ *
+ * @cfg [in]: Configuration parameters
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_atomic_requester(struct rdma_config *cfg)
+{
+	struct rdma_resources resources = {0};
+	union doca_data ctx_user_data = {0};
+	const uint32_t mmap_permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	const uint32_t rdma_permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	struct timespec ts = {
+		.tv_sec = 0,
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	doca_error_t result, tmp_result;
+
+	/* Allocating resources */
+	result = allocate_rdma_resources(cfg,
+					 mmap_permissions,
+					 rdma_permissions,
+					 doca_rdma_cap_task_atomic_fetch_add_is_supported,
+					 &resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate RDMA Resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_cap_task_atomic_cmp_swp_is_supported(doca_dev_as_devinfo(resources.doca_device));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Device does not support RDMA compare and swap task: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_rdma_task_atomic_fetch_add_set_conf(resources.rdma,
+							  rdma_fetch_add_completed_callback,
+							  rdma_fetch_add_error_callback,
+							  NUM_RDMA_TASKS);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA fetch and add task: %s",
+			     doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_rdma_task_atomic_cmp_swp_set_conf(resources.rdma,
+							rdma_cmp_swp_completed_callback,
+							rdma_cmp_swp_error_callback,
+							NUM_RDMA_TASKS);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA compare and swap task: %s",
+			     doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_ctx_set_state_changed_cb(resources.rdma_ctx, rdma_atomic_requester_state_change_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set state change callback for RDMA context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Create DOCA buffer inventory */
+	result = doca_buf_inventory_create(INVENTORY_NUM_INITIAL_ELEMENTS, &resources.buf_inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Start DOCA buffer inventory */
+	result = doca_buf_inventory_start(resources.buf_inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_buf_inventory;
+	}
+
+	if (cfg->use_rdma_cm == true) {
+		resources.is_requester = true;
+		resources.require_remote_mmap = true;
+		/* Exchange the descriptors in one message on a control buffer registered before connecting */
+		resources.negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP;
+		resources.task_fn = rdma_atomic_prepare_and_submit_task;
+		result = config_rdma_cm_callback_and_negotiation_task(&resources,
+								      /* need_send_mmap_info */ false,
+								      /* need_recv_mmap_info */ true);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to config RDMA CM callbacks and negotiation functions: %s",
+				     doca_error_get_descr(result));
+			goto destroy_buf_inventory;
+		}
+	}
+
+	/* Include the program's resources in user data of context to be used in callbacks */
+	ctx_user_data.ptr = &(resources);
+	result = doca_ctx_set_user_data(resources.rdma_ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Start RDMA context */
+	result = doca_ctx_start(resources.rdma_ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start RDMA context: %s", doca_error_get_descr(result));
+		goto stop_buf_inventory;
+	}
+
+	/*
+	 * Run the progress engine which will run the state machine defined in
+	 * rdma_atomic_requester_state_change_callback() When the context moves to idle, the context change callback
+	 * call will signal to stop running the progress engine.
+	 */
+	while (resources.run_pe_progress) {
+		if (doca_pe_progress(resources.pe) == 0)
+			nanosleep(&ts, &ts);
+	}
+
+	/* Assign the result we update in the callbacks */
+	result = resources.first_encountered_error;
+
+stop_buf_inventory:
+	tmp_result = doca_buf_inventory_stop(resources.buf_inventory);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to stop DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+destroy_buf_inventory:
+	tmp_result = doca_buf_inventory_destroy(resources.buf_inventory);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+destroy_resources:
+	tmp_result = destroy_rdma_resources(&resources, cfg);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA RDMA resources: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
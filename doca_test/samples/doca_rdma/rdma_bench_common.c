@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA::BENCH_COMMON);
+
+/*
+ * ARGP Callback - Handle message size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t msg_size_param_callback(void *param, void *config)
+{
+	struct rdma_bench_config *cfg = (struct rdma_bench_config *)config;
+	const int msg_size = *(int *)param;
+
+	if (msg_size <= 0) {
+		DOCA_LOG_ERR("Message size must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->msg_size = (uint32_t)msg_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle queue depth parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t queue_depth_param_callback(void *param, void *config)
+{
+	struct rdma_bench_config *cfg = (struct rdma_bench_config *)config;
+	const int queue_depth = *(int *)param;
+
+	if (queue_depth <= 0) {
+		DOCA_LOG_ERR("Queue depth must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->queue_depth = (uint32_t)queue_depth;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t duration_param_callback(void *param, void *config)
+{
+	struct rdma_bench_config *cfg = (struct rdma_bench_config *)config;
+	const int duration = *(int *)param;
+
+	if (duration <= 0) {
+		DOCA_LOG_ERR("Duration must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->duration_sec = (uint32_t)duration;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of threads parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_threads_param_callback(void *param, void *config)
+{
+	struct rdma_bench_config *cfg = (struct rdma_bench_config *)config;
+	const int num_threads = *(int *)param;
+
+	if (num_threads <= 0 || num_threads > RDMA_BENCH_MAX_THREADS) {
+		DOCA_LOG_ERR("Number of threads must be in the range [1, %d]", RDMA_BENCH_MAX_THREADS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->num_threads = (uint32_t)num_threads;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of connections parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t num_connections_param_callback(void *param, void *config)
+{
+	struct rdma_bench_config *cfg = (struct rdma_bench_config *)config;
+	const int num_connections = *(int *)param;
+
+	if (num_connections <= 0 || num_connections > RDMA_BENCH_MAX_CONNECTIONS) {
+		DOCA_LOG_ERR("Number of connections must be in the range [1, %d]", RDMA_BENCH_MAX_CONNECTIONS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->rdma.num_connections = (uint32_t)num_connections;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle CPU list parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t cpu_list_param_callback(void *param, void *config)
+{
+	struct rdma_bench_config *cfg = (struct rdma_bench_config *)config;
+	const char *cpu_list = (char *)param;
+	int len;
+
+	len = strnlen(cpu_list, MAX_ARG_SIZE);
+	if (len == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Entered CPU list exceeded buffer size: %d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	/* The string will be '\0' terminated due to the strnlen check above */
+	strncpy(cfg->cpu_list, cpu_list, len + 1);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Create and register a single ARGP param
+ *
+ * @short_name [in]: param short name
+ * @long_name [in]: param long name
+ * @arguments [in]: param arguments description, NULL if none
+ * @description [in]: param description
+ * @callback [in]: param callback
+ * @type [in]: param type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_param(const char *short_name,
+					 const char *long_name,
+					 const char *arguments,
+					 const char *description,
+					 doca_argp_param_cb_t callback,
+					 enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	if (arguments != NULL)
+		doca_argp_param_set_arguments(param, arguments);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t set_default_rdma_bench_config(struct rdma_bench_config *cfg)
+{
+	doca_error_t result;
+
+	if (cfg == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	result = set_default_config_value(&cfg->rdma);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	cfg->msg_size = RDMA_BENCH_DEFAULT_MSG_SIZE;
+	cfg->queue_depth = RDMA_BENCH_DEFAULT_QUEUE_DEPTH;
+	cfg->duration_sec = RDMA_BENCH_DEFAULT_DURATION_SEC;
+	cfg->num_threads = 1;
+	memset(cfg->cpu_list, 0, sizeof(cfg->cpu_list));
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t register_rdma_bench_params(void)
+{
+	doca_error_t result;
+
+	result = register_bench_param("ms",
+				      "msg-size",
+				      "<bytes>",
+				      "Message size in bytes (optional)",
+				      msg_size_param_callback,
+				      DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = register_bench_param("qd",
+				      "queue-depth",
+				      "<num>",
+				      "Number of outstanding tasks per connection (optional)",
+				      queue_depth_param_callback,
+				      DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return register_bench_param("du",
+				    "duration",
+				    "<seconds>",
+				    "Duration of every benchmark run in seconds (optional)",
+				    duration_param_callback,
+				    DOCA_ARGP_TYPE_INT);
+}
+
+doca_error_t register_rdma_bench_connections_param(void)
+{
+	return register_bench_param("nc",
+				    "num-connections",
+				    "<num>",
+				    "Total number of connections, must be <= " RDMA_BENCH_MAX_CONNECTIONS_STR " (optional)",
+				    num_connections_param_callback,
+				    DOCA_ARGP_TYPE_INT);
+}
+
+doca_error_t register_rdma_bench_thread_params(void)
+{
+	doca_error_t result;
+
+	result = register_bench_param("th",
+				      "threads",
+				      "<num>",
+				      "Maximum number of worker threads, each owning a PE and RDMA contexts (optional)",
+				      num_threads_param_callback,
+				      DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return register_bench_param(
+		"cl",
+		"cpu-list",
+		"<cpu list>",
+		"CPUs to pin the worker threads to, e.g. 0-3,8 (optional). Defaults to the CPUs of the device NUMA node",
+		cpu_list_param_callback,
+		DOCA_ARGP_TYPE_STRING);
+}
+
+doca_error_t rdma_bench_endpoint_create(struct doca_dev *dev,
+					struct doca_pe *pe,
+					const struct rdma_bench_endpoint_attr *attr,
+					struct rdma_bench_endpoint *endpoint)
+{
+	doca_error_t result, tmp_result;
+
+	if (attr->num_connections == 0 || attr->num_connections > RDMA_BENCH_MAX_CONNECTIONS) {
+		DOCA_LOG_ERR("Number of connections must be in the range [1, %d]", RDMA_BENCH_MAX_CONNECTIONS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	memset(endpoint, 0, sizeof(*endpoint));
+
+	endpoint->connections = calloc(attr->num_connections, sizeof(*endpoint->connections));
+	if (endpoint->connections == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the slots of %u connections", attr->num_connections);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	endpoint->max_connections = attr->num_connections;
+
+	result = doca_rdma_create(dev, &endpoint->rdma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA RDMA: %s", doca_error_get_descr(result));
+		goto free_connections;
+	}
+
+	endpoint->ctx = doca_rdma_as_ctx(endpoint->rdma);
+	if (endpoint->ctx == NULL) {
+		result = DOCA_ERROR_UNEXPECTED;
+		DOCA_LOG_ERR("Failed to convert DOCA RDMA to DOCA context: %s", doca_error_get_descr(result));
+		goto destroy_rdma;
+	}
+
+	result = doca_rdma_set_permissions(endpoint->rdma, attr->permissions);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set permissions to DOCA RDMA: %s", doca_error_get_descr(result));
+		goto destroy_rdma;
+	}
+
+	if (attr->is_gid_index_set) {
+		result = doca_rdma_set_gid_index(endpoint->rdma, attr->gid_index);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set gid_index to DOCA RDMA: %s", doca_error_get_descr(result));
+			goto destroy_rdma;
+		}
+	}
+
+	result = doca_rdma_set_max_num_connections(endpoint->rdma, attr->num_connections);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set max_num_connections to DOCA RDMA: %s", doca_error_get_descr(result));
+		goto destroy_rdma;
+	}
+
+	result = doca_rdma_set_transport_type(endpoint->rdma, attr->transport_type);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set RDMA transport type: %s", doca_error_get_descr(result));
+		goto destroy_rdma;
+	}
+
+	if (attr->send_queue_size != 0) {
+		result = doca_rdma_set_send_queue_size(endpoint->rdma, attr->send_queue_size);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set RDMA send queue size: %s", doca_error_get_descr(result));
+			goto destroy_rdma;
+		}
+	}
+
+	if (attr->recv_queue_size != 0) {
+		result = doca_rdma_set_recv_queue_size(endpoint->rdma, attr->recv_queue_size);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set RDMA receive queue size: %s", doca_error_get_descr(result));
+			goto destroy_rdma;
+		}
+	}
+
+	result = doca_pe_connect_ctx(pe, endpoint->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set progress engine for RDMA: %s", doca_error_get_descr(result));
+		goto destroy_rdma;
+	}
+
+	return DOCA_SUCCESS;
+
+destroy_rdma:
+	tmp_result = doca_rdma_destroy(endpoint->rdma);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA RDMA: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	endpoint->rdma = NULL;
+	endpoint->ctx = NULL;
+free_connections:
+	free(endpoint->connections);
+	endpoint->connections = NULL;
+	endpoint->max_connections = 0;
+	return result;
+}
+
+doca_error_t rdma_bench_endpoint_start(struct doca_pe *pe, struct rdma_bench_endpoint *endpoint)
+{
+	enum doca_ctx_states ctx_state;
+	doca_error_t result;
+
+	result = doca_ctx_start(endpoint->ctx);
+	if (result != DOCA_SUCCESS && result != DOCA_ERROR_IN_PROGRESS) {
+		DOCA_LOG_ERR("Failed to start RDMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	do {
+		(void)doca_pe_progress(pe);
+		result = doca_ctx_get_state(endpoint->ctx, &ctx_state);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to get RDMA context state: %s", doca_error_get_descr(result));
+			return result;
+		}
+		if (ctx_state == DOCA_CTX_STATE_IDLE) {
+			DOCA_LOG_ERR("RDMA context moved to idle state while starting");
+			return DOCA_ERROR_BAD_STATE;
+		}
+	} while (ctx_state != DOCA_CTX_STATE_RUNNING);
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_bench_endpoint_destroy(struct doca_pe *pe, struct rdma_bench_endpoint *endpoint)
+{
+	enum doca_ctx_states ctx_state = DOCA_CTX_STATE_IDLE;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (endpoint->rdma == NULL)
+		return DOCA_SUCCESS;
+
+	(void)doca_ctx_get_state(endpoint->ctx, &ctx_state);
+	if (ctx_state != DOCA_CTX_STATE_IDLE) {
+		tmp_result = request_stop_ctx(pe, endpoint->ctx);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop RDMA context: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	tmp_result = doca_rdma_destroy(endpoint->rdma);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA RDMA: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	free(endpoint->connections);
+	endpoint->rdma = NULL;
+	endpoint->ctx = NULL;
+	endpoint->connections = NULL;
+	endpoint->num_connections = 0;
+	endpoint->max_connections = 0;
+	return result;
+}
+
+doca_error_t rdma_bench_connect_loopback(struct rdma_bench_endpoint *first,
+					 struct rdma_bench_endpoint *second,
+					 uint32_t num_connections)
+{
+	const void *first_desc, *second_desc;
+	size_t first_desc_size, second_desc_size;
+	void *first_desc_copy;
+	doca_error_t result;
+	uint32_t i;
+
+	if (num_connections > first->max_connections || num_connections > second->max_connections) {
+		DOCA_LOG_ERR("Number of connections must be <= the connections both endpoints were created with");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (i = 0; i < num_connections; i++) {
+		result = doca_rdma_export(first->rdma, &first_desc, &first_desc_size, &first->connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to export RDMA connection [%u]: %s", i, doca_error_get_descr(result));
+			return result;
+		}
+
+		/* The descriptor is only guaranteed to be valid until the next export on the same context */
+		first_desc_copy = malloc(first_desc_size);
+		if (first_desc_copy == NULL) {
+			DOCA_LOG_ERR("Failed to allocate memory for RDMA connection descriptor");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		memcpy(first_desc_copy, first_desc, first_desc_size);
+
+		result = doca_rdma_export(second->rdma, &second_desc, &second_desc_size, &second->connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to export RDMA connection [%u]: %s", i, doca_error_get_descr(result));
+			free(first_desc_copy);
+			return result;
+		}
+
+		result = doca_rdma_connect(first->rdma, second_desc, second_desc_size, first->connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to connect RDMA connection [%u]: %s", i, doca_error_get_descr(result));
+			free(first_desc_copy);
+			return result;
+		}
+
+		result = doca_rdma_connect(second->rdma, first_desc_copy, first_desc_size, second->connections[i]);
+		free(first_desc_copy);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to connect RDMA connection [%u]: %s", i, doca_error_get_descr(result));
+			return result;
+		}
+
+		first->num_connections++;
+		second->num_connections++;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_bench_import_mmap(struct doca_mmap *local_mmap, struct doca_dev *dev, struct doca_mmap **remote_mmap)
+{
+	const void *mmap_desc;
+	size_t mmap_desc_size;
+	doca_error_t result;
+
+	result = doca_mmap_export_rdma(local_mmap, dev, &mmap_desc, &mmap_desc_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to export DOCA mmap for RDMA: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_create_from_export(NULL, mmap_desc, mmap_desc_size, dev, remote_mmap);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+
+	return result;
+}
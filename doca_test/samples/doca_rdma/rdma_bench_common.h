@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_BENCH_COMMON_H_
+#define RDMA_BENCH_COMMON_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "rdma_common.h"
+
+#define RDMA_BENCH_MAX_CONNECTIONS (UINT16_MAX) /* Maximum number of connections of a DOCA RDMA context */
+#define RDMA_BENCH_MAX_CONNECTIONS_STR "65535" /* RDMA_BENCH_MAX_CONNECTIONS as a string, for ARGP descriptions */
+#define RDMA_BENCH_DEFAULT_DURATION_SEC (5) /* Default duration of a single benchmark run */
+#define RDMA_BENCH_DEFAULT_MSG_SIZE (4096)   /* Default message size in bytes */
+#define RDMA_BENCH_DEFAULT_QUEUE_DEPTH (32)  /* Default number of outstanding tasks per connection */
+#define RDMA_BENCH_MAX_THREADS (64)	     /* Maximum number of benchmark worker threads */
+
+/* Benchmark configuration, the common RDMA configuration is embedded so the common RDMA ARGP params still apply */
+struct rdma_bench_config {
+	struct rdma_config rdma;     /* Common RDMA configuration, must be the first member */
+	uint32_t msg_size;	     /* Message size in bytes */
+	uint32_t queue_depth;	     /* Number of outstanding tasks per connection */
+	uint32_t duration_sec;	     /* Duration of every benchmark run in seconds */
+	uint32_t num_threads;	     /* Number of worker threads, each with its own PE */
+	char cpu_list[MAX_ARG_SIZE]; /* CPUs to pin the worker threads to, empty to select by device NUMA node */
+};
+
+/*
+ * A DOCA RDMA context used by the benchmarks, together with the connections it owns.
+ * Benchmarks create two endpoints on the same device and progress engine and connect them to each other
+ * (NIC loopback), so that a single process drives both sides without any out-of-band descriptor exchange.
+ */
+struct rdma_bench_endpoint {
+	struct doca_rdma *rdma;			   /* DOCA RDMA instance */
+	struct doca_ctx *ctx;			   /* DOCA RDMA as a DOCA context */
+	struct doca_rdma_connection **connections; /* Connections of this endpoint, one slot per allowed connection */
+	uint32_t num_connections;		   /* Number of connections */
+	uint32_t max_connections;		   /* Number of slots in connections */
+};
+
+/* Attributes used to create a benchmark endpoint */
+struct rdma_bench_endpoint_attr {
+	uint32_t permissions;			      /* Access permission flags for DOCA RDMA */
+	uint32_t num_connections;		      /* Number of connections the endpoint will own */
+	uint32_t send_queue_size;		      /* Send queue size, 0 keeps the DOCA default */
+	uint32_t recv_queue_size;		      /* Receive queue size, 0 keeps the DOCA default */
+	enum doca_rdma_transport_type transport_type; /* RC or DC */
+	bool is_gid_index_set;			      /* Whether gid_index should be applied */
+	uint32_t gid_index;			      /* GID index for DOCA RDMA */
+};
+
+/*
+ * Set the default values of the benchmark configuration, including the common RDMA configuration
+ *
+ * @cfg [in]: The benchmark configuration instance
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t set_default_rdma_bench_config(struct rdma_bench_config *cfg);
+
+/*
+ * Register the ARGP params shared by all RDMA benchmarks: message size, queue depth and duration
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t register_rdma_bench_params(void);
+
+/*
+ * Register the ARGP number of connections param of the benchmarks
+ * Replaces register_rdma_num_connections_param(), which is limited to MAX_NUM_CONNECTIONS
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t register_rdma_bench_connections_param(void);
+
+/*
+ * Register the ARGP params of multi-threaded RDMA benchmarks: number of threads and CPU list
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t register_rdma_bench_thread_params(void);
+
+/*
+ * Create a benchmark endpoint and connect it to the progress engine
+ * Task configurations and context user data should be set by the caller before rdma_bench_endpoint_start()
+ *
+ * @dev [in]: DOCA device
+ * @pe [in]: DOCA progress engine
+ * @attr [in]: endpoint attributes
+ * @endpoint [out]: endpoint to create
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_bench_endpoint_create(struct doca_dev *dev,
+					struct doca_pe *pe,
+					const struct rdma_bench_endpoint_attr *attr,
+					struct rdma_bench_endpoint *endpoint);
+
+/*
+ * Start the endpoint context and progress the PE until it is running
+ *
+ * @pe [in]: DOCA progress engine the endpoint is connected to
+ * @endpoint [in]: endpoint to start
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_bench_endpoint_start(struct doca_pe *pe, struct rdma_bench_endpoint *endpoint);
+
+/*
+ * Stop (if running) and destroy a benchmark endpoint
+ *
+ * @pe [in]: DOCA progress engine the endpoint is connected to
+ * @endpoint [in]: endpoint to destroy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_bench_endpoint_destroy(struct doca_pe *pe, struct rdma_bench_endpoint *endpoint);
+
+/*
+ * Create num_connections connections on each of the two running endpoints and connect them to each other
+ * Connection i of the first endpoint is the peer of connection i of the second endpoint
+ *
+ * @first [in]: first endpoint
+ * @second [in]: second endpoint
+ * @num_connections [in]: number of connection pairs to create
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_bench_connect_loopback(struct rdma_bench_endpoint *first,
+					 struct rdma_bench_endpoint *second,
+					 uint32_t num_connections);
+
+/*
+ * Export a local mmap for RDMA and import it back as a remote mmap, for use by the peer endpoint of a loopback pair
+ *
+ * @local_mmap [in]: started local mmap with remote access permissions
+ * @dev [in]: DOCA device
+ * @remote_mmap [out]: remote mmap created from the export descriptor
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_bench_import_mmap(struct doca_mmap *local_mmap, struct doca_dev *dev, struct doca_mmap **remote_mmap);
+
+#endif /* RDMA_BENCH_COMMON_H_ */
@@ -33,10 +33,25 @@
 #include <doca_error.h>
 #include <doca_log.h>
 
+#include "bench_common.h"
 #include "rdma_common.h"
 
 DOCA_LOG_REGISTER(RDMA::COMMON);
 
+#define NEGOTIATION_MSG_MAGIC (0x4e45474fU) /* "NEGO", marks a batched negotiation message */
+
+/* Header of a batched negotiation message, followed by num_descs descriptors */
+struct negotiation_msg_hdr {
+	uint32_t magic;	    /* NEGOTIATION_MSG_MAGIC */
+	uint32_t num_descs; /* Number of descriptors that follow the header */
+};
+
+/* Header of a descriptor in a batched negotiation message, followed by the descriptor itself */
+struct negotiation_desc_hdr {
+	uint32_t type; /* One bit of enum rdma_negotiation_desc */
+	uint32_t len;  /* Length of the descriptor in bytes */
+};
+
 /*
  * ARGP Callback - Handle IB device name parameter
  *
@@ -206,6 +221,31 @@ static doca_error_t mmap_descriptor_path_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle latency histograms file path parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t latency_json_path_callback(void *param, void *config)
+{
+	struct rdma_config *rdma_cfg = (struct rdma_config *)config;
+	const char *path = (char *)param;
+	int path_len;
+
+	path_len = strnlen(path, MAX_ARG_SIZE);
+	if (path_len == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Entered path exceeded buffer size: %d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	/* The string will be '\0' terminated due to the strnlen check above */
+	strncpy(rdma_cfg->latency_json_path, path, path_len + 1);
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * ARGP Callback - Handle gid_index parameter
  *
@@ -490,6 +530,23 @@ static doca_error_t cm_addr_type_param_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle cm_parallel_connect parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t cm_parallel_connect_param_callback(void *param, void *config)
+{
+	(void)param;
+	struct rdma_config *rdma_cfg = (struct rdma_config *)config;
+
+	rdma_cfg->cm_parallel_connect = true;
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * A wrapper for handling rdma_cm related cmdline parameters
  *
@@ -502,6 +559,7 @@ static doca_error_t register_rdma_cm_params(void)
 	struct doca_argp_param *cm_port_param;
 	struct doca_argp_param *cm_addr_param;
 	struct doca_argp_param *cm_addr_type_param;
+	struct doca_argp_param *cm_parallel_connect_param;
 
 	/* Create and register user_rdma_cm param */
 	result = doca_argp_param_create(&use_rdma_cm_param);
@@ -574,6 +632,25 @@ static doca_error_t register_rdma_cm_params(void)
 		return result;
 	}
 
+	/* Create and register cm_parallel_connect_param */
+	result = doca_argp_param_create(&cm_parallel_connect_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(cm_parallel_connect_param, "cmp");
+	doca_argp_param_set_long_name(cm_parallel_connect_param, "cm-parallel");
+	doca_argp_param_set_description(
+		cm_parallel_connect_param,
+		"Pipeline rdma-cm connection requests and negotiation without waiting for enter, set on both sides");
+	doca_argp_param_set_callback(cm_parallel_connect_param, cm_parallel_connect_param_callback);
+	doca_argp_param_set_type(cm_parallel_connect_param, DOCA_ARGP_TYPE_BOOLEAN);
+	result = doca_argp_register_param(cm_parallel_connect_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	return DOCA_SUCCESS;
 }
 
@@ -586,6 +663,7 @@ doca_error_t register_rdma_common_params(void)
 	struct doca_argp_param *remote_resource_desc_path;
 	struct doca_argp_param *gid_index_param;
 	struct doca_argp_param *transport_type_param;
+	struct doca_argp_param *latency_json_path_param;
 
 	/* Create and register device param */
 	result = doca_argp_param_create(&device_param);
@@ -693,7 +771,7 @@ doca_error_t register_rdma_common_params(void)
 	doca_argp_param_set_long_name(transport_type_param, "transport-type");
 	doca_argp_param_set_description(
 		transport_type_param,
-		"transport_type for DOCA RDMA (RC or DC, optional), only useful for single connection out-of-band RDMA for now");
+		"transport_type for DOCA RDMA (RC or DC, optional), DC is only supported for out-of-band connections");
 	doca_argp_param_set_callback(transport_type_param, transport_type_param_callback);
 	doca_argp_param_set_type(transport_type_param, DOCA_ARGP_TYPE_STRING);
 	result = doca_argp_register_param(transport_type_param);
@@ -702,18 +780,31 @@ doca_error_t register_rdma_common_params(void)
 		return result;
 	}
 
+	/* Create and register latency histograms file path param */
+	result = doca_argp_param_create(&latency_json_path_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(latency_json_path_param, "lj");
+	doca_argp_param_set_long_name(latency_json_path_param, "latency-json");
+	doca_argp_param_set_arguments(latency_json_path_param, "<path>");
+	doca_argp_param_set_description(
+		latency_json_path_param,
+		"Record the latency of every task per task type, connection and size, and write the histograms to this "
+		"file in the schema of rdma_results.json (optional)");
+	doca_argp_param_set_callback(latency_json_path_param, latency_json_path_callback);
+	doca_argp_param_set_type(latency_json_path_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(latency_json_path_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	return register_rdma_cm_params();
 }
 
-/*
- * Open DOCA device
- *
- * @device_name [in]: The name of the wanted IB device (could be empty string)
- * @func [in]: Function to check if a given device is capable of executing some task
- * @doca_device [out]: An allocated DOCA device on success and NULL otherwise
- * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
- */
-static doca_error_t open_doca_device(const char *device_name, task_check func, struct doca_dev **doca_device)
+doca_error_t open_doca_device(const char *device_name, task_check func, struct doca_dev **doca_device)
 {
 	struct doca_devinfo **dev_list;
 	uint32_t nb_devs = 0;
@@ -721,6 +812,8 @@ static doca_error_t open_doca_device(const char *device_name, task_check func, s
 	char ibdev_name[DOCA_DEVINFO_IBDEV_NAME_SIZE] = {0};
 	uint32_t i = 0;
 
+	*doca_device = NULL;
+
 	result = doca_devinfo_create_list(&dev_list, &nb_devs);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to load DOCA devices list: %s", doca_error_get_descr(result));
@@ -767,20 +860,30 @@ doca_error_t allocate_rdma_resources(struct rdma_config *cfg,
 	resources->first_encountered_error = DOCA_SUCCESS;
 	resources->run_pe_progress = true;
 	resources->num_remaining_tasks = 0;
+	resources->latency = NULL;
 
-	/* Check configuration correctness, for now, DC is only supported for out-of-band single connection sample */
-	if (((cfg->num_connections > 1) || (cfg->use_rdma_cm == true)) &&
-	    (cfg->transport_type == DOCA_RDMA_TRANSPORT_TYPE_DC)) {
+	/* Check configuration correctness, DC is only supported by the out-of-band (export/connect) flow */
+	if ((cfg->use_rdma_cm == true) && (cfg->transport_type == DOCA_RDMA_TRANSPORT_TYPE_DC)) {
 		DOCA_LOG_ERR(
-			"Failed to allocate RDMA resources: due to DOCA_RDMA_TRANSPORT_TYPE_DC is only supported for out-of-band single connection case for now");
+			"Failed to allocate RDMA resources: due to DOCA_RDMA_TRANSPORT_TYPE_DC is only supported for out-of-band connections");
 		return DOCA_ERROR_INVALID_VALUE;
 	}
 
+	/* Allocate the rdma-cm connection slots, a server may accept up to num_connections of them */
+	resources->connections = calloc(MAX(cfg->num_connections, 1), sizeof(*resources->connections));
+	resources->connection_established = calloc(MAX(cfg->num_connections, 1),
+						   sizeof(*resources->connection_established));
+	if (resources->connections == NULL || resources->connection_established == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the state of %u connections", cfg->num_connections);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_connections;
+	}
+
 	/* Open DOCA device */
 	result = open_doca_device(cfg->device_name, func, &(resources->doca_device));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
-		return result;
+		goto free_connections;
 	}
 
 	/* Allocate memory for memory range */
@@ -860,6 +963,17 @@ doca_error_t allocate_rdma_resources(struct rdma_config *cfg,
 		goto destroy_doca_rdma;
 	}
 
+	/* Record the task latencies only when they are exported */
+	if (cfg->latency_json_path[0] != '\0') {
+		result = rdma_latency_recorder_create(RDMA_LATENCY_DEFAULT_MAX_SERIES,
+						      RDMA_LATENCY_DEFAULT_MAX_INFLIGHT,
+						      &resources->latency);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create task latency recorder: %s", doca_error_get_descr(result));
+			goto destroy_doca_rdma;
+		}
+	}
+
 	return result;
 
 destroy_doca_rdma:
@@ -893,6 +1007,11 @@ close_doca_dev:
 		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
 	}
+free_connections:
+	free(resources->connection_established);
+	free(resources->connections);
+	resources->connection_established = NULL;
+	resources->connections = NULL;
 	return result;
 }
 
@@ -955,42 +1074,193 @@ static doca_error_t clean_up_files(struct rdma_config *cfg)
 }
 
 /*
- * Destroy DOCA RDMA-CM related resources
+ * Get a registration of a negotiation buffer from the descriptor registration cache, creating the cache on first
+ * use
  *
- * @resources [in]: DOCA RDMA-CM related resources to destroy
+ * @resources [in]: DOCA RDMA resources
+ * @descriptor [in]: negotiation buffer
+ * @descriptor_size [in]: negotiation buffer size
+ * @entry [out]: acquired registration, to release with mmap_cache_release()
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static doca_error_t destroy_rdma_cm_resources(struct rdma_resources *resources)
+static doca_error_t acquire_descriptor_mmap(struct rdma_resources *resources,
+					    void *descriptor,
+					    size_t descriptor_size,
+					    struct mmap_cache_entry **entry)
 {
-	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	struct mmap_cache_attr attr = {
+		.dev = resources->doca_device,
+		.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+		.max_idle_entries = MMAP_CACHE_DEFAULT_MAX_IDLE_ENTRIES,
+		.max_idle_bytes = MMAP_CACHE_DEFAULT_MAX_IDLE_BYTES,
+	};
+	doca_error_t result;
 
-	if (resources->cm_addr != NULL) {
-		result = doca_rdma_addr_destroy(resources->cm_addr);
+	if (resources->descriptor_mmap_cache == NULL) {
+		result = mmap_cache_create(&attr, &resources->descriptor_mmap_cache);
 		if (result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to destroy DOCA rdma cm address: %s", doca_error_get_descr(result));
+			DOCA_LOG_ERR("Failed to create descriptor registration cache: %s",
+				     doca_error_get_descr(result));
 			return result;
 		}
 	}
-	if (resources->mmap_descriptor_mmap != NULL) {
-		tmp_result = doca_mmap_destroy(resources->mmap_descriptor_mmap);
+
+	return mmap_cache_acquire(resources->descriptor_mmap_cache, descriptor, descriptor_size, entry);
+}
+
+/*
+ * Allocate and register the control buffer of the batched negotiation, along with the inventory of its tasks. The
+ * registration is left idle in the descriptor registration cache, so that every negotiation task that follows takes
+ * a reference on it instead of registering the buffer again.
+ *
+ * @resources [in/out]: DOCA RDMA resources
+ * @num_tasks [in]: number of negotiation tasks that may be in flight at once
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t create_negotiation_ctrl(struct rdma_resources *resources, uint32_t num_tasks)
+{
+	struct mmap_cache_entry *ctrl_entry;
+	doca_error_t result;
+
+	resources->ctrl_buf = calloc(1, NEGOTIATION_CTRL_BUF_LEN);
+	if (resources->ctrl_buf == NULL) {
+		DOCA_LOG_ERR("Failed to allocate negotiation control buffer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	resources->ctrl_msg_len = 0;
+
+	result = acquire_descriptor_mmap(resources, resources->ctrl_buf, NEGOTIATION_CTRL_BUF_LEN, &ctrl_entry);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register negotiation control buffer: %s", doca_error_get_descr(result));
+		goto free_ctrl_buf;
+	}
+	(void)mmap_cache_release(resources->descriptor_mmap_cache, ctrl_entry);
+
+	result = doca_buf_inventory_create(num_tasks, &resources->ctrl_inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create negotiation buffer inventory: %s", doca_error_get_descr(result));
+		goto invalidate_ctrl_buf;
+	}
+
+	result = doca_buf_inventory_start(resources->ctrl_inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start negotiation buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_ctrl_inventory;
+	}
+
+	return DOCA_SUCCESS;
+
+destroy_ctrl_inventory:
+	(void)doca_buf_inventory_destroy(resources->ctrl_inventory);
+	resources->ctrl_inventory = NULL;
+invalidate_ctrl_buf:
+	(void)mmap_cache_invalidate(resources->descriptor_mmap_cache, resources->ctrl_buf, NEGOTIATION_CTRL_BUF_LEN);
+free_ctrl_buf:
+	free(resources->ctrl_buf);
+	resources->ctrl_buf = NULL;
+	return result;
+}
+
+/*
+ * Take a reference on the cached registration of the negotiation control buffer for one send or receive task, the
+ * task callbacks return it through release_negotiation_ctrl()
+ *
+ * @resources [in]: DOCA RDMA resources
+ * @ctrl_entry [out]: acquired registration, passed as the task user data
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t acquire_negotiation_ctrl(struct rdma_resources *resources, struct mmap_cache_entry **ctrl_entry)
+{
+	doca_error_t result;
+
+	result = mmap_cache_acquire(resources->descriptor_mmap_cache,
+				    resources->ctrl_buf,
+				    NEGOTIATION_CTRL_BUF_LEN,
+				    ctrl_entry);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to get negotiation control buffer mmap: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Return the control buffer registration a negotiation task was submitted with, if any
+ *
+ * @resources [in]: DOCA RDMA resources
+ * @task_user_data [in]: user data of the completed negotiation task
+ */
+static void release_negotiation_ctrl(struct rdma_resources *resources, union doca_data task_user_data)
+{
+	if (task_user_data.ptr != NULL)
+		(void)mmap_cache_release(resources->descriptor_mmap_cache, task_user_data.ptr);
+}
+
+/*
+ * Destroy the control buffer of the batched negotiation, if it was created
+ *
+ * @resources [in/out]: DOCA RDMA resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_negotiation_ctrl(struct rdma_resources *resources)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (resources->ctrl_inventory != NULL) {
+		tmp_result = doca_buf_inventory_stop(resources->ctrl_inventory);
 		if (tmp_result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to destroy DOCA local mmap descriptor mmap: %s",
+			DOCA_LOG_ERR("Failed to stop negotiation buffer inventory: %s",
 				     doca_error_get_descr(tmp_result));
 			DOCA_ERROR_PROPAGATE(result, tmp_result);
 		}
+		tmp_result = doca_buf_inventory_destroy(resources->ctrl_inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy negotiation buffer inventory: %s",
+				     doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+		resources->ctrl_inventory = NULL;
 	}
-	if (resources->remote_mmap_descriptor_mmap != NULL) {
-		tmp_result = doca_mmap_destroy(resources->remote_mmap_descriptor_mmap);
+
+	if (resources->ctrl_buf != NULL) {
+		tmp_result = mmap_cache_invalidate(resources->descriptor_mmap_cache,
+						   resources->ctrl_buf,
+						   NEGOTIATION_CTRL_BUF_LEN);
 		if (tmp_result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to destroy DOCA remote mmap descriptor mmap: %s",
+			DOCA_LOG_ERR("Failed to deregister negotiation control buffer: %s",
 				     doca_error_get_descr(tmp_result));
 			DOCA_ERROR_PROPAGATE(result, tmp_result);
 		}
+		free(resources->ctrl_buf);
+		resources->ctrl_buf = NULL;
 	}
-	if (resources->sync_event_descriptor_mmap != NULL) {
-		tmp_result = doca_mmap_destroy(resources->sync_event_descriptor_mmap);
+
+	return result;
+}
+
+/*
+ * Destroy DOCA RDMA-CM related resources
+ *
+ * @resources [in]: DOCA RDMA-CM related resources to destroy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_rdma_cm_resources(struct rdma_resources *resources)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (resources->cm_addr != NULL) {
+		result = doca_rdma_addr_destroy(resources->cm_addr);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA rdma cm address: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+	tmp_result = destroy_negotiation_ctrl(resources);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	if (resources->descriptor_mmap_cache != NULL) {
+		mmap_cache_log_stats(resources->descriptor_mmap_cache, resources->self_name);
+		tmp_result = mmap_cache_destroy(resources->descriptor_mmap_cache);
 		if (tmp_result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to destroy DOCA local sync_event descriptor mmap: %s",
+			DOCA_LOG_ERR("Failed to destroy descriptor registration cache: %s",
 				     doca_error_get_descr(tmp_result));
 			DOCA_ERROR_PROPAGATE(result, tmp_result);
 		}
@@ -1003,11 +1273,21 @@ doca_error_t destroy_rdma_resources(struct rdma_resources *resources, struct rdm
 {
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	/* Report and export the task latencies, no task is in flight anymore */
+	if (resources->latency != NULL) {
+		rdma_latency_report(resources->latency);
+		result = rdma_latency_export_json(resources->latency, cfg->latency_json_path);
+		rdma_latency_recorder_destroy(resources->latency);
+		resources->latency = NULL;
+	}
+
 	/* Stop and destroy remote mmap if exists */
 	if (resources->remote_mmap != NULL) {
-		result = doca_mmap_stop(resources->remote_mmap);
-		if (result != DOCA_SUCCESS)
-			DOCA_LOG_ERR("Failed to stop DOCA remote mmap: %s", doca_error_get_descr(result));
+		tmp_result = doca_mmap_stop(resources->remote_mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA remote mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
 
 		tmp_result = doca_mmap_destroy(resources->remote_mmap);
 		if (tmp_result != DOCA_SUCCESS) {
@@ -1074,6 +1354,12 @@ doca_error_t destroy_rdma_resources(struct rdma_resources *resources, struct rdm
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
 	}
 
+	/* Free the rdma-cm connection slots */
+	free(resources->connection_established);
+	free(resources->connections);
+	resources->connection_established = NULL;
+	resources->connections = NULL;
+
 	/* Delete description files that we created */
 	tmp_result = clean_up_files(cfg);
 	if (tmp_result != DOCA_SUCCESS) {
@@ -1200,11 +1486,26 @@ doca_error_t rdma_cm_connect(struct rdma_resources *resources)
 	DOCA_LOG_INFO("-- Addr: %s", (cfg->cm_addr[0] == '\0') ? "NULL" : cfg->cm_addr);
 	DOCA_LOG_INFO("-- Port: %u", cfg->cm_port);
 	DOCA_LOG_INFO("-- Num_connections: %u", cfg->num_connections);
+	DOCA_LOG_INFO("-- Parallel: %s", cfg->cm_parallel_connect ? "true" : "false");
 	DOCA_LOG_INFO("-----------------------------------------------");
 
 	resources->cm_addr = NULL;
 	resources->num_connection_established = 0;
 
+	/*
+	 * In parallel mode the responder sends its descriptor as soon as a connection is established, so the receive
+	 * must already be posted, before any connection can exist
+	 */
+	if (cfg->use_rdma_cm == true && cfg->cm_parallel_connect == true && resources->require_remote_mmap == true &&
+	    resources->is_requester == true) {
+		result = rdma_requester_recv_data_from_rdma_responder(resources);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to post negotiation receive before connecting: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+
 	if (resources->is_client == false) {
 		DOCA_LOG_INFO("Server calling doca_rdma_start_listen_to_port");
 		result = doca_rdma_start_listen_to_port(resources->rdma, cfg->cm_port);
@@ -1265,7 +1566,8 @@ doca_error_t send_msg(struct doca_rdma *rdma,
 		      struct doca_buf_inventory *buf_inv,
 		      void *msg,
 		      uint32_t msg_len,
-		      void *user_data)
+		      void *user_data,
+		      struct rdma_latency_recorder *latency)
 {
 	doca_error_t result;
 	struct doca_buf *src_buf;
@@ -1285,9 +1587,11 @@ doca_error_t send_msg(struct doca_rdma *rdma,
 		return result;
 	}
 
+	rdma_latency_task_submitted(latency, doca_rdma_task_send_as_task(rdma_send_task));
 	result = doca_task_submit(doca_rdma_task_send_as_task(rdma_send_task));
 	if (DOCA_IS_ERROR(result)) {
 		DOCA_LOG_ERR("Failed to submit a send task, with error: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(latency, doca_rdma_task_send_as_task(rdma_send_task));
 		return result;
 	}
 
@@ -1299,7 +1603,8 @@ doca_error_t recv_msg(struct doca_rdma *rdma,
 		      struct doca_buf_inventory *buf_inv,
 		      void *msg,
 		      uint32_t msg_len,
-		      void *user_data)
+		      void *user_data,
+		      struct rdma_latency_recorder *latency)
 {
 	doca_error_t result;
 	struct doca_buf *dst_buf;
@@ -1319,9 +1624,11 @@ doca_error_t recv_msg(struct doca_rdma *rdma,
 		return result;
 	}
 
+	rdma_latency_task_submitted(latency, doca_rdma_task_receive_as_task(rdma_recv_task));
 	result = doca_task_submit(doca_rdma_task_receive_as_task(rdma_recv_task));
 	if (DOCA_IS_ERROR(result)) {
 		DOCA_LOG_ERR("Failed to submit a receive task, with error: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(latency, doca_rdma_task_receive_as_task(rdma_recv_task));
 		return result;
 	}
 	DOCA_LOG_INFO("Negotiation receive task submission completed\n");
@@ -1329,148 +1636,263 @@ doca_error_t recv_msg(struct doca_rdma *rdma,
 	return result;
 }
 
-doca_error_t rdma_requester_recv_data_from_rdma_responder(struct rdma_resources *resources)
+/*
+ * Append a descriptor to the batched negotiation message in the control buffer
+ *
+ * @resources [in/out]: DOCA RDMA resources
+ * @type [in]: descriptor type
+ * @desc [in]: descriptor
+ * @desc_len [in]: descriptor length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t append_negotiation_desc(struct rdma_resources *resources,
+					    enum rdma_negotiation_desc type,
+					    const void *desc,
+					    size_t desc_len)
 {
-	doca_error_t result = DOCA_SUCCESS;
-	struct doca_mmap *recv_descriptor_mmap = NULL;
-	void *recv_descriptor = NULL;
-	size_t recv_descriptor_size = MEM_RANGE_LEN;
-
-	DOCA_LOG_INFO("Start to exchange data resource between client and server");
+	struct negotiation_msg_hdr *msg = (struct negotiation_msg_hdr *)resources->ctrl_buf;
+	struct negotiation_desc_hdr desc_hdr = {.type = type, .len = (uint32_t)desc_len};
+	char *pos = (char *)resources->ctrl_buf + resources->ctrl_msg_len;
 
-	/* Create receive descriptor buffer  */
-	recv_descriptor = malloc(sizeof(uint8_t) * recv_descriptor_size);
-	if (recv_descriptor == NULL) {
-		DOCA_LOG_ERR("Failed to allocate buffer for receive descriptor: %s", doca_error_get_descr(result));
+	if (resources->ctrl_msg_len + sizeof(desc_hdr) + desc_len > NEGOTIATION_CTRL_BUF_LEN) {
+		DOCA_LOG_ERR("Negotiation descriptors exceed the control buffer of %d bytes", NEGOTIATION_CTRL_BUF_LEN);
 		return DOCA_ERROR_NO_MEMORY;
 	}
 
-	/* Create receive descriptor's mmap  */
-	result = create_local_mmap(&recv_descriptor_mmap,
-				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
-				   recv_descriptor,
-				   recv_descriptor_size,
-				   resources->doca_device);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to create receive descriptor's mmap: %s", doca_error_get_descr(result));
-		goto free_recv_descriptor;
-	}
+	memcpy(pos, &desc_hdr, sizeof(desc_hdr));
+	memcpy(pos + sizeof(desc_hdr), desc, desc_len);
+	resources->ctrl_msg_len += sizeof(desc_hdr) + desc_len;
+	msg->num_descs++;
 
-	result = recv_msg(resources->rdma,
-			  recv_descriptor_mmap,
-			  resources->buf_inventory,
-			  recv_descriptor,
-			  recv_descriptor_size,
-			  resources);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to recvd responder's data to requester: %s", doca_error_get_descr(result));
-		goto destroy_recv_descriptor_mmap;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Export every descriptor selected by resources->negotiation_descs into one message in the control buffer
+ *
+ * @resources [in/out]: DOCA RDMA resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t build_negotiation_msg(struct rdma_resources *resources)
+{
+	struct negotiation_msg_hdr *msg = (struct negotiation_msg_hdr *)resources->ctrl_buf;
+	const void *mmap_desc;
+	const uint8_t *sync_event_desc;
+	size_t desc_len;
+	doca_error_t result;
+
+	msg->magic = NEGOTIATION_MSG_MAGIC;
+	msg->num_descs = 0;
+	resources->ctrl_msg_len = sizeof(*msg);
+
+	if (resources->negotiation_descs & RDMA_NEGOTIATION_DESC_MMAP) {
+		result = doca_mmap_export_rdma(resources->mmap, resources->doca_device, &mmap_desc, &desc_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to export DOCA mmap for RDMA: %s", doca_error_get_descr(result));
+			goto reset_msg;
+		}
+		result = append_negotiation_desc(resources, RDMA_NEGOTIATION_DESC_MMAP, mmap_desc, desc_len);
+		if (result != DOCA_SUCCESS)
+			goto reset_msg;
 	}
 
-	if (resources->recv_sync_event_desc == true) {
-		resources->sync_event_descriptor_mmap = recv_descriptor_mmap;
-		resources->sync_event_descriptor = recv_descriptor;
-	} else {
-		resources->remote_mmap_descriptor_mmap = recv_descriptor_mmap;
-		resources->remote_mmap_descriptor = recv_descriptor;
+	if (resources->negotiation_descs & RDMA_NEGOTIATION_DESC_SYNC_EVENT) {
+		result = doca_sync_event_export_to_remote_net(resources->sync_event, &sync_event_desc, &desc_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to export DOCA sync event for RDMA: %s", doca_error_get_descr(result));
+			goto reset_msg;
+		}
+		result = append_negotiation_desc(resources,
+						 RDMA_NEGOTIATION_DESC_SYNC_EVENT,
+						 sync_event_desc,
+						 desc_len);
+		if (result != DOCA_SUCCESS)
+			goto reset_msg;
 	}
 
 	return DOCA_SUCCESS;
 
-destroy_recv_descriptor_mmap:
-	doca_mmap_destroy(recv_descriptor_mmap);
-free_recv_descriptor:
-	free(recv_descriptor);
+reset_msg:
+	resources->ctrl_msg_len = 0;
 	return result;
 }
 
-doca_error_t rdma_responder_send_data_to_rdma_requester(struct rdma_resources *resources)
+/*
+ * Copy a received descriptor out of the control buffer
+ *
+ * @desc [in]: descriptor in the control buffer
+ * @desc_len [in]: descriptor length
+ * @copy [out]: allocated copy, freed by destroy_rdma_resources()
+ * @copy_len [out]: descriptor length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t copy_negotiation_desc(const char *desc, size_t desc_len, void **copy, size_t *copy_len)
 {
-	doca_error_t result = DOCA_SUCCESS;
-	struct doca_mmap *send_descriptor_mmap = NULL;
-	void *send_descriptor = NULL;
-	size_t send_descriptor_size = 0;
+	free(*copy);
+	*copy = malloc(desc_len);
+	if (*copy == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %zu bytes for a negotiation descriptor", desc_len);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memcpy(*copy, desc, desc_len);
+	*copy_len = desc_len;
 
-	DOCA_LOG_INFO("Start to exchange data resource between client and server");
+	return DOCA_SUCCESS;
+}
 
-	if (resources->recv_sync_event_desc == true) {
-		/* Export RDMA sync event */
-		result = doca_sync_event_export_to_remote_net(resources->sync_event,
-							      (const uint8_t **)&(resources->sync_event_descriptor),
-							      &(resources->sync_event_descriptor_size));
-		if (result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to export DOCA sync event for RDMA: %s", doca_error_get_descr(result));
-			return result;
+/*
+ * Parse a batched negotiation message received into the control buffer, checking that it carries every descriptor
+ * selected by resources->negotiation_descs
+ *
+ * @resources [in/out]: DOCA RDMA resources
+ * @msg_len [in]: received length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_negotiation_msg(struct rdma_resources *resources, size_t msg_len)
+{
+	const struct negotiation_msg_hdr *msg = (const struct negotiation_msg_hdr *)resources->ctrl_buf;
+	const char *pos = (const char *)resources->ctrl_buf + sizeof(*msg);
+	const char *end = (const char *)resources->ctrl_buf + msg_len;
+	struct negotiation_desc_hdr desc_hdr;
+	uint32_t found = 0, i;
+	doca_error_t result;
+
+	if (msg_len < sizeof(*msg) || msg->magic != NEGOTIATION_MSG_MAGIC) {
+		DOCA_LOG_ERR("Received a malformed negotiation message of %zu bytes, does the peer batch it too?",
+			     msg_len);
+		return DOCA_ERROR_BAD_STATE;
+	}
+
+	for (i = 0; i < msg->num_descs; i++) {
+		if ((size_t)(end - pos) < sizeof(desc_hdr))
+			goto truncated;
+		memcpy(&desc_hdr, pos, sizeof(desc_hdr));
+		pos += sizeof(desc_hdr);
+		if ((size_t)(end - pos) < desc_hdr.len)
+			goto truncated;
+
+		switch (desc_hdr.type) {
+		case RDMA_NEGOTIATION_DESC_MMAP:
+			result = copy_negotiation_desc(pos,
+						       desc_hdr.len,
+						       &resources->remote_mmap_descriptor,
+						       &resources->remote_mmap_descriptor_size);
+			break;
+		case RDMA_NEGOTIATION_DESC_SYNC_EVENT:
+			result = copy_negotiation_desc(pos,
+						       desc_hdr.len,
+						       &resources->sync_event_descriptor,
+						       &resources->sync_event_descriptor_size);
+			break;
+		default:
+			/* Unknown descriptors of a newer peer are skipped */
+			result = DOCA_SUCCESS;
+			break;
 		}
-		send_descriptor = (void *)(resources->sync_event_descriptor);
-		send_descriptor_size = resources->sync_event_descriptor_size;
-	} else {
-		/* Export RDMA mmap */
-		result = doca_mmap_export_rdma(resources->mmap,
-					       resources->doca_device,
-					       (const void **)&(resources->mmap_descriptor),
-					       &(resources->mmap_descriptor_size));
-		if (result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to export DOCA mmap for RDMA: %s", doca_error_get_descr(result));
+		if (result != DOCA_SUCCESS)
 			return result;
-		}
-		send_descriptor = (void *)(resources->mmap_descriptor);
-		send_descriptor_size = resources->mmap_descriptor_size;
+		found |= desc_hdr.type;
+		pos += desc_hdr.len;
 	}
 
-	/* Create DOCA buffer inventory */
-	result = doca_buf_inventory_create(INVENTORY_NUM_INITIAL_ELEMENTS, &resources->buf_inventory);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
-		return result;
+	if ((found & resources->negotiation_descs) != resources->negotiation_descs) {
+		DOCA_LOG_ERR("Negotiation message carries descriptors 0x%x, expected 0x%x",
+			     found,
+			     resources->negotiation_descs);
+		return DOCA_ERROR_NOT_FOUND;
 	}
 
-	/* Start DOCA buffer inventory */
-	result = doca_buf_inventory_start(resources->buf_inventory);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
-		goto destroy_buf_inv;
-	}
+	return DOCA_SUCCESS;
 
-	/* Create local data descriptor's mmap  */
-	result = create_local_mmap(&send_descriptor_mmap,
-				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
-				   send_descriptor,
-				   send_descriptor_size,
-				   resources->doca_device);
+truncated:
+	DOCA_LOG_ERR("Negotiation message of %zu bytes is truncated", msg_len);
+	return DOCA_ERROR_BAD_STATE;
+}
+
+doca_error_t rdma_requester_recv_data_from_rdma_responder(struct rdma_resources *resources)
+{
+	struct mmap_cache_entry *ctrl_entry = NULL;
+	doca_error_t result;
+
+	DOCA_LOG_INFO("Start to exchange data resource between client and server");
+
+	/* Every descriptor arrives in one message on the pre-registered control buffer */
+	resources->negotiation_start_ns = bench_get_time_ns();
+	result = acquire_negotiation_ctrl(resources, &ctrl_entry);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = recv_msg(resources->rdma,
+			  mmap_cache_entry_get_mmap(ctrl_entry),
+			  resources->ctrl_inventory,
+			  resources->ctrl_buf,
+			  NEGOTIATION_CTRL_BUF_LEN,
+			  ctrl_entry,
+			  resources->latency);
 	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to create send mmap for local descriptor: %s", doca_error_get_descr(result));
-		goto destroy_buf_inv;
+		DOCA_LOG_ERR("Failed to recvd responder's data to requester: %s", doca_error_get_descr(result));
+		(void)mmap_cache_release(resources->descriptor_mmap_cache, ctrl_entry);
 	}
-	if (resources->recv_sync_event_desc == true)
-		resources->sync_event_descriptor_mmap = send_descriptor_mmap;
-	else
-		resources->mmap_descriptor_mmap = send_descriptor_mmap;
 
-	/* Wait for enter which means that the requester has finished posting receive */
+	return result;
+}
+
+/*
+ * Wait for the user to confirm that the requester has posted the receive task of the negotiation
+ */
+static void wait_for_requester_receive(void)
+{
 	DOCA_LOG_INFO(
 		"Wait till the requester has finished the submission of the receive task for negotiation and press enter");
 	wait_for_enter();
+}
+
+doca_error_t rdma_responder_send_data_to_rdma_requester(struct rdma_resources *resources)
+{
+	struct mmap_cache_entry *ctrl_entry = NULL;
+	struct doca_rdma_connection *connection = NULL;
+	doca_error_t result;
+
+	/* Debug level, a server in parallel mode logs this once per accepted connection */
+	DOCA_LOG_DBG("Start to exchange data resource between client and server");
+
+	/* The descriptor goes to the connection that was just established */
+	if (resources->num_connection_established > 0)
+		connection = resources->connections[resources->num_connection_established - 1];
+	else
+		connection = resources->connections[0];
+
+	/*
+	 * Every descriptor goes in one message on the pre-registered control buffer. The message is built once and
+	 * reused by the connections that follow in parallel mode.
+	 */
+	if (resources->ctrl_msg_len == 0) {
+		result = build_negotiation_msg(resources);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	/* In parallel mode the requester posts its receive before connecting */
+	if (resources->cfg->cm_parallel_connect == false)
+		wait_for_requester_receive();
+
+	result = acquire_negotiation_ctrl(resources, &ctrl_entry);
+	if (result != DOCA_SUCCESS)
+		return result;
 
 	result = send_msg(resources->rdma,
-			  resources->connections[0],
-			  send_descriptor_mmap,
-			  resources->buf_inventory,
-			  send_descriptor,
-			  send_descriptor_size,
-			  resources);
+			  connection,
+			  mmap_cache_entry_get_mmap(ctrl_entry),
+			  resources->ctrl_inventory,
+			  resources->ctrl_buf,
+			  resources->ctrl_msg_len,
+			  ctrl_entry,
+			  resources->latency);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to send responder's data to requester: %s", doca_error_get_descr(result));
-		goto destroy_send_descriptor_mmap;
+		(void)mmap_cache_release(resources->descriptor_mmap_cache, ctrl_entry);
 	}
 
-	return DOCA_SUCCESS;
-
-destroy_send_descriptor_mmap:
-	doca_mmap_destroy(send_descriptor_mmap);
-destroy_buf_inv:
-	doca_buf_inventory_destroy(resources->buf_inventory);
-	resources->buf_inventory = NULL;
 	return result;
 }
 
@@ -1478,7 +1900,6 @@ void receive_task_completion_cb(struct doca_rdma_task_receive *task,
 				union doca_data task_user_data,
 				union doca_data ctx_user_data)
 {
-	(void)task_user_data;
 	unsigned long int dst_buf_data_len = 0;
 	doca_error_t result = DOCA_SUCCESS;
 	struct doca_buf *dst_buf = doca_rdma_task_receive_get_dst_buf(task);
@@ -1491,14 +1912,24 @@ void receive_task_completion_cb(struct doca_rdma_task_receive *task,
 		cm_error_occur = true;
 	}
 
+	rdma_latency_task_completed(resource->latency,
+				    doca_rdma_task_receive_as_task(task),
+				    RDMA_LATENCY_TASK_RECEIVE,
+				    doca_rdma_task_receive_get_result_rdma_connection(task),
+				    dst_buf_data_len);
 	doca_task_free(doca_rdma_task_receive_as_task(task));
 	doca_buf_dec_refcount(dst_buf, NULL);
+	release_negotiation_ctrl(resource, task_user_data);
 	if (cm_error_occur == false) {
-		if (resource->recv_sync_event_desc == false)
-			resource->remote_mmap_descriptor_size = dst_buf_data_len;
+		result = parse_negotiation_msg(resource, dst_buf_data_len);
+		if (result != DOCA_SUCCESS)
+			cm_error_occur = true;
 		else
-			resource->sync_event_descriptor_size = dst_buf_data_len;
-
+			DOCA_LOG_INFO("Received %u negotiation bytes in one message, %.1f us after posting the receive",
+				      (unsigned int)dst_buf_data_len,
+				      (double)(bench_get_time_ns() - resource->negotiation_start_ns) / 1000.0);
+	}
+	if (cm_error_occur == false) {
 		result = resource->task_fn(resource);
 		if (result != DOCA_SUCCESS)
 			cm_error_occur = true;
@@ -1511,14 +1942,15 @@ void receive_task_error_cb(struct doca_rdma_task_receive *rdma_recv_task,
 			   union doca_data task_user_data,
 			   union doca_data ctx_user_data)
 {
-	(void)task_user_data;
 	struct rdma_resources *resource = (struct rdma_resources *)ctx_user_data.ptr;
 	struct doca_task *task = doca_rdma_task_receive_as_task(rdma_recv_task);
 
 	/* Get the result of the task */
 	DOCA_LOG_ERR("RDMA negotiation receive task failed: %s", doca_error_get_descr(doca_task_get_status(task)));
+	rdma_latency_task_failed(resource->latency, task);
 	doca_task_free(task);
 	doca_buf_dec_refcount(doca_rdma_task_receive_get_dst_buf(rdma_recv_task), NULL);
+	release_negotiation_ctrl(resource, task_user_data);
 	(void)doca_ctx_stop(resource->rdma_ctx);
 }
 
@@ -1526,12 +1958,17 @@ void send_task_completion_cb(struct doca_rdma_task_send *task,
 			     union doca_data task_user_data,
 			     union doca_data ctx_user_data)
 {
-	(void)task_user_data;
 	struct rdma_resources *resource = (struct rdma_resources *)ctx_user_data.ptr;
 	doca_error_t result;
 
+	rdma_latency_task_completed(resource->latency,
+				    doca_rdma_task_send_as_task(task),
+				    RDMA_LATENCY_TASK_SEND,
+				    doca_rdma_task_send_get_rdma_connection(task),
+				    rdma_latency_buf_len(doca_rdma_task_send_get_src_buf(task)));
 	doca_task_free(doca_rdma_task_send_as_task(task));
 	doca_buf_dec_refcount((struct doca_buf *)(doca_rdma_task_send_get_src_buf(task)), NULL);
+	release_negotiation_ctrl(resource, task_user_data);
 
 	result = resource->task_fn(resource);
 	if (result != DOCA_SUCCESS)
@@ -1542,14 +1979,15 @@ void send_task_error_cb(struct doca_rdma_task_send *rdma_send_task,
 			union doca_data task_user_data,
 			union doca_data ctx_user_data)
 {
-	(void)task_user_data;
 	struct rdma_resources *resource = (struct rdma_resources *)ctx_user_data.ptr;
 	struct doca_task *task = doca_rdma_task_send_as_task(rdma_send_task);
 
 	/* Get the result of the task */
 	DOCA_LOG_ERR("RDMA negotiation send task failed: %s", doca_error_get_descr(doca_task_get_status(task)));
+	rdma_latency_task_failed(resource->latency, task);
 	doca_task_free(task);
 	doca_buf_dec_refcount((struct doca_buf *)(doca_rdma_task_send_get_src_buf(rdma_send_task)), NULL);
+	release_negotiation_ctrl(resource, task_user_data);
 	(void)doca_ctx_stop(resource->rdma_ctx);
 }
 
@@ -1595,9 +2033,11 @@ void rdma_cm_connect_established_cb(struct doca_rdma_connection *connection,
 		return;
 	}
 
-	if (resource->is_requester == true)
-		rdma_requester_recv_data_from_rdma_responder(resource);
-	else
+	if (resource->is_requester == true) {
+		/* In parallel mode the receive was posted by rdma_cm_connect() */
+		if (resource->cfg->cm_parallel_connect == false)
+			rdma_requester_recv_data_from_rdma_responder(resource);
+	} else
 		rdma_responder_send_data_to_rdma_requester(resource);
 }
 
@@ -1652,12 +2092,14 @@ doca_error_t set_default_config_value(struct rdma_config *cfg)
 	cfg->is_gid_index_set = false;
 	cfg->num_connections = 1;
 	cfg->transport_type = DOCA_RDMA_TRANSPORT_TYPE_RC;
+	cfg->latency_json_path[0] = '\0';
 
 	/* Only related rdma cm */
 	cfg->use_rdma_cm = false;
 	cfg->cm_port = DEFAULT_RDMA_CM_PORT;
 	cfg->cm_addr_type = DOCA_RDMA_ADDR_TYPE_IPv4;
 	memset(cfg->cm_addr, 0, SERVER_ADDR_LEN);
+	cfg->cm_parallel_connect = false;
 
 	return DOCA_SUCCESS;
 }
@@ -1722,6 +2164,7 @@ doca_error_t config_rdma_cm_callback_and_negotiation_task(struct rdma_resources
 							  bool need_recv_task)
 {
 	doca_error_t result = DOCA_SUCCESS;
+	uint32_t num_negotiation_tasks = NUM_NEGOTIATION_RDMA_TASKS;
 
 	if (resources == NULL) {
 		result = DOCA_ERROR_INVALID_VALUE;
@@ -1729,6 +2172,10 @@ doca_error_t config_rdma_cm_callback_and_negotiation_task(struct rdma_resources
 		return result;
 	}
 
+	/* In parallel mode the negotiation sends of all connections may be in flight at once */
+	if (resources->cfg->cm_parallel_connect == true)
+		num_negotiation_tasks = MAX(resources->cfg->num_connections, NUM_NEGOTIATION_RDMA_TASKS);
+
 	/**
 	 * Set send&recv task configuration
 	 * they are used for transferring the mmap desc between client and server for non-sync-event task
@@ -1738,7 +2185,7 @@ doca_error_t config_rdma_cm_callback_and_negotiation_task(struct rdma_resources
 		result = doca_rdma_task_receive_set_conf(resources->rdma,
 							 receive_task_completion_cb,
 							 receive_task_error_cb,
-							 NUM_NEGOTIATION_RDMA_TASKS);
+							 num_negotiation_tasks);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to set task recv configuration, error: %s", doca_error_get_descr(result));
 			return result;
@@ -1748,12 +2195,23 @@ doca_error_t config_rdma_cm_callback_and_negotiation_task(struct rdma_resources
 		result = doca_rdma_task_send_set_conf(resources->rdma,
 						      send_task_completion_cb,
 						      send_task_error_cb,
-						      NUM_NEGOTIATION_RDMA_TASKS);
+						      num_negotiation_tasks);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to set task send configuration, error: %s", doca_error_get_descr(result));
 			return result;
 		}
 	}
+	/* Register the control buffer of the batched negotiation now, off the connection path */
+	if ((need_send_task == true || need_recv_task == true) && resources->ctrl_buf == NULL) {
+		if (resources->negotiation_descs == 0) {
+			DOCA_LOG_ERR("No descriptor selected for the negotiation, set negotiation_descs");
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		result = create_negotiation_ctrl(resources, num_negotiation_tasks);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
 	/* Set rdma cm connection configuration callbacks */
 	result = doca_rdma_set_connection_state_callbacks(resources->rdma,
 							  rdma_cm_connect_request_cb,
@@ -42,6 +42,8 @@
 #include <doca_sync_event.h>
 
 #include "common.h"
+#include "mmap_cache.h"
+#include "rdma_latency.h"
 
 #define MEM_RANGE_LEN (4096)		     /* DOCA mmap memory range length */
 #define INVENTORY_NUM_INITIAL_ELEMENTS (16)  /* Number of DOCA inventory initial elements */
@@ -65,6 +67,13 @@
 #define CLIENT_NAME "Client"
 #define DEFAULT_RDMA_CM_PORT (13579)
 #define MAX_NUM_CONNECTIONS (8)
+#define NEGOTIATION_CTRL_BUF_LEN (MEM_RANGE_LEN) /* Size of the pre-registered batched negotiation buffer */
+
+/* Descriptors that a batched negotiation message can carry, as bits of rdma_resources.negotiation_descs */
+enum rdma_negotiation_desc {
+	RDMA_NEGOTIATION_DESC_MMAP = (1 << 0),	     /* RDMA export of the responder's mmap */
+	RDMA_NEGOTIATION_DESC_SYNC_EVENT = (1 << 1), /* Remote net export of the responder's sync event */
+};
 
 /* Function to check if a given device is capable of executing some task */
 typedef doca_error_t (*task_check)(const struct doca_devinfo *);
@@ -87,8 +96,9 @@ struct rdma_config {
 	uint32_t gid_index;				/* GID index for DOCA RDMA */
 	uint32_t num_connections; /* The maximum number of allowed connections, only useful for server for multiple
 				    connection samples */
-	enum doca_rdma_transport_type transport_type; /* RC or DC, RC is the default, only useful for single connection
-							 out-of-band RDMA for now */
+	enum doca_rdma_transport_type transport_type; /* RC or DC, RC is the default, DC is only supported for
+							 out-of-band connections */
+	char latency_json_path[MAX_ARG_SIZE]; /* File to write the task latency histograms to, empty to not record */
 
 	/* The following fields are only related to rdma_cm */
 	bool use_rdma_cm;		       /* Whether test rdma-only or rdma-cm,
@@ -103,6 +113,9 @@ struct rdma_config {
 	enum doca_rdma_addr_type cm_addr_type; /* RDMA_CM server address type, IPv4, IPv6 or GID,
 						* Only useful for client
 						**/
+	bool cm_parallel_connect;	       /* Pipeline connection requests and negotiation sends instead of
+						* serializing them on user input, must be set on both sides
+						**/
 };
 
 struct rdma_resources {
@@ -132,18 +145,14 @@ struct rdma_resources {
 	doca_error_t first_encountered_error;	      /* Result of the first encountered error, if any */
 	bool run_pe_progress;			      /* Flag whether to keep progress the PE */
 	size_t num_remaining_tasks;		      /* Number of remaining tasks to submit */
+	struct rdma_latency_recorder *latency;	      /* Task latency recorder, NULL when not recording */
 
 	/* The following cmdline args are only related to rdma_cm */
-	struct doca_rdma_addr *cm_addr;				       /* Server address to connect by a client */
-	struct doca_rdma_connection *connections[MAX_NUM_CONNECTIONS]; /* The RDMA_CM connection instance */
-	bool connection_established[MAX_NUM_CONNECTIONS]; /* Indication whether the corresponding connection have been
-							     estableshed */
+	struct doca_rdma_addr *cm_addr;		   /* Server address to connect by a client */
+	struct doca_rdma_connection **connections; /* The RDMA_CM connection instances, one per allowed connection */
+	bool *connection_established; /* Indication whether the corresponding connection have been estableshed */
 	uint32_t num_connection_established;		  /* Indicate how many connections has been established */
-	struct doca_mmap *mmap_descriptor_mmap;		  /* Used to send local mmap descriptor to remote peer */
-	struct doca_mmap *remote_mmap_descriptor_mmap;	  /* Used to receive remote peer mmap descriptor */
-	struct doca_mmap *sync_event_descriptor_mmap;	  /* Used to send and receive sync_event descriptor */
-	bool recv_sync_event_desc; /* If true, indicate a remote sync event should be received or otherwise a remote
-				      mmap */
+	struct mmap_cache *descriptor_mmap_cache;	  /* Registrations of the negotiation buffers */
 	const char *self_name;	   /* Client or Server */
 	bool is_client;		   /* Client or Server */
 	bool is_requester;	   /* Responder or requester */
@@ -151,6 +160,11 @@ struct rdma_resources {
 					     */
 	bool require_remote_mmap;	    /* Indicate whether need remote mmap information, for example for
 						  rdma_task_read/write */
+	uint32_t negotiation_descs; /* Bitmask of enum rdma_negotiation_desc to exchange in one batched message */
+	void *ctrl_buf;		    /* Control buffer of the batched negotiation, registered before connecting */
+	size_t ctrl_msg_len;	    /* Length of the batched message in the control buffer, 0 until it is built */
+	struct doca_buf_inventory *ctrl_inventory; /* Inventory of the control buffer tasks */
+	uint64_t negotiation_start_ns;		   /* Time the requester posted the batched negotiation receive */
 };
 
 /*
@@ -169,6 +183,16 @@ doca_error_t allocate_rdma_resources(struct rdma_config *cfg,
 				     task_check func,
 				     struct rdma_resources *resources);
 
+/*
+ * Open DOCA device
+ *
+ * @device_name [in]: The name of the wanted IB device (could be empty string)
+ * @func [in]: Function to check if a given device is capable of executing some task
+ * @doca_device [out]: An allocated DOCA device on success and NULL otherwise
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t open_doca_device(const char *device_name, task_check func, struct doca_dev **doca_device);
+
 /*
  * Destroy DOCA RDMA resources
  *
@@ -243,6 +267,8 @@ doca_error_t delete_file(const char *file_path);
 
 /*
  * Using RDMA-CM to start a connection between RDMA server and client
+ * With cm_parallel_connect a requester posts its negotiation receive before connecting, so that the responder can
+ * send its descriptor as soon as each connection is established instead of waiting for user input
  *
  * @resources [in]: The resource context for the rdma-cm connection
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
@@ -267,6 +293,7 @@ doca_error_t rdma_cm_disconnect(struct rdma_resources *resources);
  * @msg [in]: The message address
  * @msg_len [in]: The message byte length
  * @user_data [in]: The doca_data instance to be embedded into the doca_rdma_task_send
+ * @latency [in]: Recorder to stamp the task in, NULL to not record its latency
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 doca_error_t send_msg(struct doca_rdma *rdma,
@@ -275,7 +302,8 @@ doca_error_t send_msg(struct doca_rdma *rdma,
 		      struct doca_buf_inventory *buf_inv,
 		      void *msg,
 		      uint32_t msg_len,
-		      void *user_data);
+		      void *user_data,
+		      struct rdma_latency_recorder *latency);
 
 /*
  * Receive a message from the peer using the RDMA receive task, used in negotiation for peers
@@ -286,6 +314,7 @@ doca_error_t send_msg(struct doca_rdma *rdma,
  * @msg [in]: The message buffer address
  * @msg_len [in]: The message buffer byte length
  * @user_data [in]: The doca_data instance to be embedded into the doca_rdma_task_receive
+ * @latency [in]: Recorder to stamp the task in, NULL to not record its latency
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 doca_error_t recv_msg(struct doca_rdma *rdma,
@@ -293,13 +322,14 @@ doca_error_t recv_msg(struct doca_rdma *rdma,
 		      struct doca_buf_inventory *buf_inv,
 		      void *msg,
 		      uint32_t msg_len,
-		      void *user_data);
+		      void *user_data,
+		      struct rdma_latency_recorder *latency);
 
 /*
  * Callback for the doca_rdma receive task successful completion used in recv_msg()
  *
  * @task [in]: The doca_rdma receive task
- * @task_user_data [in]: The preset user_data for this task
+ * @task_user_data [in]: Cached registration of the message buffer to release, NULL if there is none
  * @ctx_user_data [in]: The preset ctx_data for this task
  */
 void receive_task_completion_cb(struct doca_rdma_task_receive *task,
@@ -310,7 +340,7 @@ void receive_task_completion_cb(struct doca_rdma_task_receive *task,
  * Callback for the doca_rdma receive task unsuccessful completion used in recv_msg()
  *
  * @task [in]: The doca_rdma receive task
- * @task_user_data [in]: The preset user_data for this task
+ * @task_user_data [in]: Cached registration of the message buffer to release, NULL if there is none
  * @ctx_user_data [in]: The preset ctx_data for this task
  */
 void receive_task_error_cb(struct doca_rdma_task_receive *task,
@@ -321,7 +351,7 @@ void receive_task_error_cb(struct doca_rdma_task_receive *task,
  * Callback for the doca_rdma send task successful completion used in send_msg()
  *
  * @task [in]: The doca_rdma receive task
- * @task_user_data [in]: The preset user_data for this task
+ * @task_user_data [in]: Cached registration of the message buffer to release, NULL if there is none
  * @ctx_user_data [in]: The preset ctx_data for this task
  */
 void send_task_completion_cb(struct doca_rdma_task_send *task,
@@ -332,7 +362,7 @@ void send_task_completion_cb(struct doca_rdma_task_send *task,
  * Callback for the doca_rdma send task unsuccessful completion used in send_msg()
  *
  * @task [in]: The doca_rdma receive task
- * @task_user_data [in]: The preset user_data for this task
+ * @task_user_data [in]: Cached registration of the message buffer to release, NULL if there is none
  * @ctx_user_data [in]: The preset ctx_data for this task
  */
 void send_task_error_cb(struct doca_rdma_task_send *task,
@@ -406,6 +436,8 @@ doca_error_t create_local_mmap(struct doca_mmap **mmap,
 
 /*
  * Config callbacks needed for rdma cm connection setup, and config tasks used for negotiation between peers
+ * If resources->negotiation_descs is set, the control buffer of the batched negotiation is registered here as well,
+ * so that the session setup does not register or create anything on the connection path
  *
  * @resources [in]: The rdma test context
  * @need_send_task [in]: Indicate whether need to config rdma_task_send
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_CONNECT_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_connect_bench(struct rdma_bench_config *cfg, uint32_t window);
+
+#define DEFAULT_NUM_CONNECTIONS (256) /* Default number of connections of every run */
+#define DEFAULT_WINDOW (64)	      /* Default number of connection requests in flight in parallel mode */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct connect_bench_config {
+	struct rdma_bench_config bench; /* Benchmark configuration */
+	uint32_t window;		/* Connection requests in flight in parallel mode */
+};
+
+/*
+ * ARGP Callback - Handle connect window parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t window_callback(void *param, void *config)
+{
+	struct connect_bench_config *cfg = (struct connect_bench_config *)config;
+	const int window = *(int *)param;
+
+	if (window <= 0 || window > RDMA_BENCH_MAX_CONNECTIONS) {
+		DOCA_LOG_ERR("Connect window must be in the range [1, %d]", RDMA_BENCH_MAX_CONNECTIONS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->window = (uint32_t)window;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the connect benchmark parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_connect_bench_params(void)
+{
+	struct doca_argp_param *window_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(window_param, "cw");
+	doca_argp_param_set_long_name(window_param, "connect-window");
+	doca_argp_param_set_arguments(window_param, "<num>");
+	doca_argp_param_set_description(window_param,
+					"Connection requests in flight in parallel mode (optional)");
+	doca_argp_param_set_callback(window_param, window_callback);
+	doca_argp_param_set_type(window_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct connect_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.rdma.num_connections = DEFAULT_NUM_CONNECTIONS;
+	cfg.window = DEFAULT_WINDOW;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_connect_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark connections param */
+	result = register_rdma_bench_connections_param();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register connections parameter: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register connect benchmark params */
+	result = register_connect_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register connect benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_connect_bench(&cfg.bench, cfg.window);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_connect_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,708 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <infiniband/verbs.h>
+
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+#include <doca_rdma_bridge.h>
+
+#include "bench_common.h"
+#include "common.h"
+#include "rdma_bench_common.h"
+#include "rdma_recv_ring.h"
+
+DOCA_LOG_REGISTER(RDMA_CONNECT_BENCH::SAMPLE);
+
+#define STALL_TIMEOUT_NS (10 * BENCH_NSEC_PER_SEC) /* Time without any new connection before a run is aborted */
+#define TIME_CHECK_INTERVAL (1024)		       /* Number of PE progress calls between two timeout checks */
+
+/* How the client issues its connection requests */
+enum connect_mode {
+	CONNECT_MODE_SERIAL,   /* One connection at a time: connect, establish, negotiate, then the next one */
+	CONNECT_MODE_PARALLEL, /* Up to window connections between request and negotiation at any time */
+	CONNECT_MODE_NUM,
+};
+
+static const char *const connect_mode_names[CONNECT_MODE_NUM] = {"serial", "parallel"};
+
+/* Timestamps of one connection */
+struct connect_sample {
+	uint64_t issue_ns;	 /* Connection requested by the client */
+	uint64_t established_ns; /* Connection established on the client */
+	uint64_t first_byte_ns;	 /* Negotiation message of the server received by the client */
+};
+
+/* Results of one mode */
+struct connect_result {
+	uint32_t window;	/* Connections in flight */
+	uint64_t total_ns;	/* From the first request to the last negotiation message */
+	uint64_t establish_p50; /* Median of request to established */
+	uint64_t establish_p99; /* 99th percentile of request to established */
+	uint64_t ttfb_p50;	/* Median of request to the negotiation message on the client */
+	uint64_t ttfb_p99;	/* 99th percentile of request to the negotiation message on the client */
+	uint64_t ttfb_max;	/* Largest request to the negotiation message on the client */
+};
+
+/* Benchmark state */
+struct connect_bench {
+	struct rdma_bench_config *cfg;	      /* Benchmark configuration */
+	uint32_t num_connections;	      /* Connections opened by every run */
+	uint32_t window;		      /* Connections in flight of the current run */
+	uint32_t max_window;		      /* Connections in flight of the parallel run */
+	struct doca_dev *dev;		      /* DOCA device of the client */
+	struct doca_pe *pe;		      /* Progress engine of the client */
+	struct rdma_config server_cfg;	      /* Sample configuration of the server of the current run */
+	struct rdma_resources server;	      /* Listening side, an rdma-cm responder of the samples */
+	struct rdma_bench_endpoint client;    /* Connecting side */
+	struct rdma_recv_ring *ring;	      /* Client receives of the negotiation messages */
+	struct doca_rdma_addr *server_addr;   /* Address the client connects to */
+	struct connect_sample *samples;	      /* Timestamps of every connection */
+	uint64_t *sorted;		      /* Scratch array to compute percentiles */
+	uint32_t num_issued;		      /* Connections requested by the client */
+	uint32_t num_done;		      /* Negotiation messages received by the client */
+	doca_error_t first_encountered_error; /* First error of a client callback */
+};
+
+/*
+ * Get the number of connections the device can hold with both sides of every connection on it
+ *
+ * @dev [in]: DOCA device
+ * @max_connections [out]: largest number of loopback connections
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t get_max_loopback_connections(struct doca_dev *dev, uint32_t *max_connections)
+{
+	struct ibv_device_attr dev_attr;
+	struct ibv_pd *pd;
+	doca_error_t result;
+	int ret;
+
+	result = doca_rdma_bridge_get_dev_pd(dev, &pd);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get device protection domain: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	ret = ibv_query_device(pd->context, &dev_attr);
+	if (ret != 0) {
+		DOCA_LOG_ERR("Failed to query device attributes: %s", strerror(ret));
+		return DOCA_ERROR_DRIVER;
+	}
+
+	/* Every connection takes one QP on the server and one on the client */
+	*max_connections = (uint32_t)dev_attr.max_qp / 2;
+	if (*max_connections > RDMA_BENCH_MAX_CONNECTIONS)
+		*max_connections = RDMA_BENCH_MAX_CONNECTIONS;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Server task function, called by the samples' send completion callback once a negotiation message is sent
+ *
+ * @resources [in]: server resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t server_negotiation_sent(struct rdma_resources *resources)
+{
+	if (resources->num_remaining_tasks > 0)
+		resources->num_remaining_tasks--;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Client connection request callback, the client never accepts connections
+ *
+ * @connection [in]: requesting connection
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void client_request_callback(struct doca_rdma_connection *connection, union doca_data ctx_user_data)
+{
+	(void)ctx_user_data;
+
+	(void)doca_rdma_connection_reject(connection);
+}
+
+/*
+ * Client connection established callback, keeps the connection
+ *
+ * @connection [in]: established connection
+ * @connection_user_data [in]: connection index, given to doca_rdma_connect_to_addr()
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void client_established_callback(struct doca_rdma_connection *connection,
+					union doca_data connection_user_data,
+					union doca_data ctx_user_data)
+{
+	struct connect_bench *bench = (struct connect_bench *)ctx_user_data.ptr;
+	uint32_t index = (uint32_t)connection_user_data.u64;
+
+	bench->samples[index].established_ns = bench_get_time_ns();
+	bench->client.connections[index] = connection;
+	bench->client.num_connections++;
+}
+
+/*
+ * Client connection failure callback
+ *
+ * @connection [in]: failed connection
+ * @connection_user_data [in]: doca_data from the connection
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void client_failure_callback(struct doca_rdma_connection *connection,
+				    union doca_data connection_user_data,
+				    union doca_data ctx_user_data)
+{
+	struct connect_bench *bench = (struct connect_bench *)ctx_user_data.ptr;
+
+	(void)connection;
+
+	DOCA_LOG_ERR("rdma cm connection [%u] failed", (uint32_t)connection_user_data.u64);
+	DOCA_ERROR_PROPAGATE(bench->first_encountered_error, DOCA_ERROR_CONNECTION_ABORTED);
+}
+
+/*
+ * Client connection disconnect callback, connections are only torn down with their context
+ *
+ * @connection [in]: disconnected connection
+ * @connection_user_data [in]: doca_data from the connection
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void client_disconnect_callback(struct doca_rdma_connection *connection,
+				       union doca_data connection_user_data,
+				       union doca_data ctx_user_data)
+{
+	(void)connection;
+	(void)connection_user_data;
+	(void)ctx_user_data;
+}
+
+/*
+ * Create and start the server of a run with the rdma-cm code of the samples: a responder in parallel connect mode,
+ * which accepts every request and sends its batched negotiation message as soon as a connection is established
+ *
+ * @bench [in]: benchmark state
+ * @port [in]: port the server listens on
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t setup_server(struct connect_bench *bench, uint16_t port)
+{
+	struct rdma_config *cfg = &bench->server_cfg;
+	struct rdma_resources *server = &bench->server;
+	union doca_data ctx_user_data = {0};
+	enum doca_ctx_states ctx_state;
+	doca_error_t result;
+
+	/* Same device and transport as the benchmark, listening (no cm_addr) in parallel mode */
+	*cfg = bench->cfg->rdma;
+	memset(cfg->cm_addr, 0, sizeof(cfg->cm_addr));
+	cfg->use_rdma_cm = true;
+	cfg->cm_parallel_connect = true;
+	cfg->cm_port = port;
+	cfg->num_connections = bench->num_connections;
+	cfg->latency_json_path[0] = '\0';
+	/* The server writes no descriptor file, so it must not delete the ones of other samples on destroy */
+	cfg->local_connection_desc_path[0] = '\0';
+	cfg->remote_connection_desc_path[0] = '\0';
+	cfg->remote_resource_desc_path[0] = '\0';
+
+	memset(server, 0, sizeof(*server));
+	result = allocate_rdma_resources(cfg,
+					 DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ,
+					 DOCA_ACCESS_FLAG_RDMA_READ,
+					 doca_rdma_cap_task_send_is_supported,
+					 server);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate server RDMA resources: %s", doca_error_get_descr(result));
+		memset(server, 0, sizeof(*server));
+		return result;
+	}
+
+	server->is_requester = false;
+	server->require_remote_mmap = true;
+	server->negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP;
+	server->task_fn = server_negotiation_sent;
+	server->num_remaining_tasks = bench->num_connections;
+
+	result = config_rdma_cm_callback_and_negotiation_task(server,
+							      /* need_send_mmap_info */ true,
+							      /* need_recv_mmap_info */ false);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to config RDMA CM callbacks and negotiation functions: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	ctx_user_data.ptr = server;
+	result = doca_ctx_set_user_data(server->rdma_ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_ctx_start(server->rdma_ctx);
+	if (result != DOCA_SUCCESS && result != DOCA_ERROR_IN_PROGRESS) {
+		DOCA_LOG_ERR("Failed to start RDMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	do {
+		(void)doca_pe_progress(server->pe);
+		result = doca_ctx_get_state(server->rdma_ctx, &ctx_state);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to get RDMA context state: %s", doca_error_get_descr(result));
+			return result;
+		}
+		if (ctx_state == DOCA_CTX_STATE_IDLE) {
+			DOCA_LOG_ERR("RDMA context moved to idle state while starting");
+			return DOCA_ERROR_BAD_STATE;
+		}
+	} while (ctx_state != DOCA_CTX_STATE_RUNNING);
+
+	return rdma_cm_connect(server);
+}
+
+/*
+ * Create and start the client of a run, with its receives of the negotiation messages posted
+ *
+ * @bench [in]: benchmark state
+ * @port [in]: port the server listens on
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t setup_client(struct connect_bench *bench, uint16_t port)
+{
+	struct rdma_bench_endpoint_attr attr = {0};
+	struct rdma_recv_ring_attr ring_attr = {0};
+	union doca_data ctx_user_data = {0};
+	doca_error_t result;
+
+	attr.num_connections = bench->num_connections;
+	attr.transport_type = bench->cfg->rdma.transport_type;
+	attr.is_gid_index_set = bench->cfg->rdma.is_gid_index_set;
+	attr.gid_index = bench->cfg->rdma.gid_index;
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->client);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_set_connection_state_callbacks(bench->client.rdma,
+							  client_request_callback,
+							  client_established_callback,
+							  client_failure_callback,
+							  client_disconnect_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set rdma cm callback configuration: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	ctx_user_data.ptr = bench;
+	result = doca_ctx_set_user_data(bench->client.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/*
+	 * The server sends as soon as a connection is established, like a requester of the samples in parallel mode
+	 * the client keeps a receive posted for every connection in flight. Sized for the parallel run in both runs,
+	 * so that only the connection pattern differs.
+	 */
+	ring_attr.num_slots = 2 * bench->max_window;
+	ring_attr.num_posted = bench->max_window;
+	ring_attr.slot_size = NEGOTIATION_CTRL_BUF_LEN;
+	result = rdma_recv_ring_create(bench->dev, bench->client.rdma, &ring_attr, &bench->ring);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->client);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_recv_ring_start(bench->ring);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_addr_create(bench->cfg->rdma.cm_addr_type, bench->cfg->rdma.cm_addr, port, &bench->server_addr);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to create rdma cm connection address: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Stop and destroy both sides of a run
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t teardown_run(struct connect_bench *bench)
+{
+	uint64_t deadline_ns = bench_get_time_ns() + STALL_TIMEOUT_NS;
+	enum doca_ctx_states ctx_state = DOCA_CTX_STATE_IDLE;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (bench->server.rdma_ctx != NULL) {
+		(void)doca_ctx_get_state(bench->server.rdma_ctx, &ctx_state);
+
+		/* The negotiation sends of the established connections must complete before the server stops */
+		while (ctx_state == DOCA_CTX_STATE_RUNNING &&
+		       bench->server.num_connection_established + bench->server.num_remaining_tasks >
+			       bench->num_connections &&
+		       bench_get_time_ns() < deadline_ns) {
+			(void)doca_pe_progress(bench->server.pe);
+			(void)doca_ctx_get_state(bench->server.rdma_ctx, &ctx_state);
+		}
+
+		if (ctx_state != DOCA_CTX_STATE_IDLE) {
+			tmp_result = request_stop_ctx(bench->server.pe, bench->server.rdma_ctx);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+		tmp_result = destroy_rdma_resources(&bench->server, &bench->server_cfg);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		memset(&bench->server, 0, sizeof(bench->server));
+	}
+
+	if (bench->ring != NULL)
+		rdma_recv_ring_stop(bench->ring);
+	tmp_result = rdma_bench_endpoint_destroy(bench->pe, &bench->client);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_recv_ring_destroy(bench->ring);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	bench->ring = NULL;
+
+	if (bench->server_addr != NULL) {
+		tmp_result = doca_rdma_addr_destroy(bench->server_addr);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		bench->server_addr = NULL;
+	}
+
+	return result;
+}
+
+/*
+ * Compare two samples for qsort()
+ *
+ * @a [in]: first sample
+ * @b [in]: second sample
+ * @return: negative, zero or positive like memcmp()
+ */
+static int compare_samples(const void *a, const void *b)
+{
+	uint64_t first = *(const uint64_t *)a, second = *(const uint64_t *)b;
+
+	return (first > second) - (first < second);
+}
+
+/*
+ * Compute the percentiles of a run from the connection timestamps
+ *
+ * @bench [in]: benchmark state
+ * @result_out [in/out]: results of the run
+ */
+static void compute_percentiles(struct connect_bench *bench, struct connect_result *result_out)
+{
+	uint32_t i, n = bench->num_connections;
+
+	for (i = 0; i < n; i++)
+		bench->sorted[i] = bench->samples[i].established_ns - bench->samples[i].issue_ns;
+	qsort(bench->sorted, n, sizeof(*bench->sorted), compare_samples);
+	result_out->establish_p50 = bench->sorted[(uint64_t)(n - 1) * 50 / 100];
+	result_out->establish_p99 = bench->sorted[(uint64_t)(n - 1) * 99 / 100];
+
+	for (i = 0; i < n; i++)
+		bench->sorted[i] = bench->samples[i].first_byte_ns - bench->samples[i].issue_ns;
+	qsort(bench->sorted, n, sizeof(*bench->sorted), compare_samples);
+	result_out->ttfb_p50 = bench->sorted[(uint64_t)(n - 1) * 50 / 100];
+	result_out->ttfb_p99 = bench->sorted[(uint64_t)(n - 1) * 99 / 100];
+	result_out->ttfb_max = bench->sorted[n - 1];
+}
+/*
+ * Take the negotiation message of a connection off the client receive ring
+ *
+ * @bench [in]: benchmark state
+ * @msg [in]: received message, released by this function
+ * @now_ns [in]: receive time
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_negotiation_msg(struct connect_bench *bench, struct rdma_recv_msg *msg, uint64_t now_ns)
+{
+	union doca_data connection_user_data = {0};
+	uint32_t index;
+	doca_error_t result;
+
+	result = doca_rdma_connection_get_user_data(msg->connection, &connection_user_data);
+	index = (uint32_t)connection_user_data.u64;
+	if (result != DOCA_SUCCESS || msg->len == 0 || index >= bench->num_issued ||
+	    bench->samples[index].first_byte_ns != 0) {
+		DOCA_LOG_ERR("Received an unexpected message of %u bytes", msg->len);
+		rdma_recv_ring_release(bench->ring, msg);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	bench->samples[index].first_byte_ns = now_ns;
+	rdma_recv_ring_release(bench->ring, msg);
+	bench->num_done++;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Request connections until window of them are between request and negotiation message, then collect the
+ * negotiation messages the server sent, until every connection received its message
+ *
+ * @bench [in]: benchmark state
+ * @result_out [out]: results of the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t connect_all(struct connect_bench *bench, struct connect_result *result_out)
+{
+	union doca_data connection_user_data = {0};
+	uint64_t start_ns, now_ns, last_progress_ns, num_polls = 0;
+	enum doca_ctx_states server_state;
+	struct rdma_recv_msg msg;
+	doca_error_t result;
+
+	bench->num_issued = 0;
+	bench->num_done = 0;
+	bench->first_encountered_error = DOCA_SUCCESS;
+	memset(bench->samples, 0, (size_t)bench->num_connections * sizeof(*bench->samples));
+
+	start_ns = bench_get_time_ns();
+	last_progress_ns = start_ns;
+	now_ns = start_ns;
+
+	/* A negotiation message may be polled before the client handles the establishment of its connection */
+	while (bench->num_done < bench->num_connections || bench->client.num_connections < bench->num_connections) {
+		while (bench->num_issued < bench->num_connections &&
+		       bench->num_issued - bench->num_done < bench->window) {
+			connection_user_data.u64 = bench->num_issued;
+			bench->samples[bench->num_issued].issue_ns = bench_get_time_ns();
+			result = doca_rdma_connect_to_addr(bench->client.rdma, bench->server_addr, connection_user_data);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to request connection [%u]: %s",
+					     bench->num_issued,
+					     doca_error_get_descr(result));
+				return result;
+			}
+			bench->num_issued++;
+		}
+
+		(void)doca_pe_progress(bench->server.pe);
+		(void)doca_pe_progress(bench->pe);
+		result = rdma_recv_ring_replenish(bench->ring);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if (bench->first_encountered_error != DOCA_SUCCESS)
+			return bench->first_encountered_error;
+		if (bench->server.first_encountered_error != DOCA_SUCCESS)
+			return bench->server.first_encountered_error;
+
+		while (rdma_recv_ring_poll(bench->ring, &msg)) {
+			now_ns = bench_get_time_ns();
+			result = handle_negotiation_msg(bench, &msg, now_ns);
+			if (result != DOCA_SUCCESS)
+				return result;
+			last_progress_ns = now_ns;
+		}
+
+		if ((++num_polls % TIME_CHECK_INTERVAL) != 0)
+			continue;
+
+		/* The samples' callbacks stop the server context on any failure */
+		if (doca_ctx_get_state(bench->server.rdma_ctx, &server_state) != DOCA_SUCCESS ||
+		    server_state != DOCA_CTX_STATE_RUNNING) {
+			DOCA_LOG_ERR("The server stopped with %u of %u connections done",
+				     bench->num_done,
+				     bench->num_connections);
+			return DOCA_ERROR_BAD_STATE;
+		}
+		if (bench_get_time_ns() - last_progress_ns > STALL_TIMEOUT_NS) {
+			DOCA_LOG_ERR("Timed out with %u of %u connections done", bench->num_done, bench->num_connections);
+			return DOCA_ERROR_TIME_OUT;
+		}
+	}
+
+	result_out->window = bench->window;
+	result_out->total_ns = now_ns - start_ns;
+	compute_percentiles(bench, result_out);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Open all connections with one mode on a fresh server and client
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: connection mode
+ * @result_out [out]: results of the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_mode(struct connect_bench *bench, enum connect_mode mode, struct connect_result *result_out)
+{
+	/* Every run listens on its own port, the previous listener may still be lingering */
+	uint16_t port = (uint16_t)(bench->cfg->rdma.cm_port + mode);
+	doca_error_t result, tmp_result;
+
+	bench->window = (mode == CONNECT_MODE_SERIAL) ? 1 : bench->max_window;
+
+	/* The client posts its receives first, the server sends on every connection it establishes */
+	result = setup_client(bench, port);
+	if (result == DOCA_SUCCESS)
+		result = setup_server(bench, port);
+	if (result == DOCA_SUCCESS)
+		result = connect_all(bench, result_out);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("The %s run failed: %s", connect_mode_names[mode], doca_error_get_descr(result));
+
+	tmp_result = teardown_run(bench);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+/*
+ * Measure how fast the rdma-cm server of the samples accepts connections in parallel connect mode: the server is
+ * set up with allocate_rdma_resources(), config_rdma_cm_callback_and_negotiation_task() and rdma_cm_connect() like
+ * any responder sample run with --cm-parallel, and sends its batched negotiation message as soon as a connection is
+ * established. A client of the same process opens num_connections connections to it, first one at a time and then
+ * with up to window connection requests in flight, with the receives of the negotiation messages posted ahead.
+ * Reports connections per second and the time from the connection request to the negotiation message on the
+ * client. Both sides hold a QP per connection on the same device, which bounds num_connections.
+ *
+ * @cfg [in]: Configuration parameters, cm_addr must be an address of the device and cm_port a free port
+ * @window [in]: connection requests in flight in parallel mode
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_connect_bench(struct rdma_bench_config *cfg, uint32_t window)
+{
+	struct connect_result results[CONNECT_MODE_NUM] = {0};
+	struct connect_bench bench = {0};
+	uint32_t max_connections;
+	doca_error_t result, tmp_result;
+	enum connect_mode mode;
+
+	if (cfg->rdma.cm_addr[0] == '\0') {
+		DOCA_LOG_ERR("The server address of the device must be given");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	bench.cfg = cfg;
+	bench.num_connections = cfg->rdma.num_connections;
+	bench.max_window = (window < bench.num_connections) ? window : bench.num_connections;
+
+	bench.samples = calloc(bench.num_connections, sizeof(*bench.samples));
+	bench.sorted = calloc(bench.num_connections, sizeof(*bench.sorted));
+	if (bench.samples == NULL || bench.sorted == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the state of %u connections", bench.num_connections);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_arrays;
+	}
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_receive_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		goto free_arrays;
+	}
+
+	result = get_max_loopback_connections(bench.dev, &max_connections);
+	if (result != DOCA_SUCCESS)
+		goto close_dev;
+	if (bench.num_connections > max_connections) {
+		DOCA_LOG_ERR("The device holds at most %u connections with both sides on it, %u were requested",
+			     max_connections,
+			     bench.num_connections);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto close_dev;
+	}
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	for (mode = CONNECT_MODE_SERIAL; mode < CONNECT_MODE_NUM; mode++) {
+		result = run_mode(&bench, mode, &results[mode]);
+		if (result != DOCA_SUCCESS)
+			goto destroy_pe;
+	}
+
+	DOCA_LOG_INFO("Connection storm of %u rdma-cm connections to %s, times in microseconds",
+		      bench.num_connections,
+		      cfg->rdma.cm_addr);
+	DOCA_LOG_INFO("%8s | %6s | %10s | %9s | %9s %9s | %9s %9s %9s",
+		      "mode",
+		      "window",
+		      "conn/s",
+		      "total ms",
+		      "est p50",
+		      "est p99",
+		      "ttfb p50",
+		      "ttfb p99",
+		      "ttfb max");
+	for (mode = CONNECT_MODE_SERIAL; mode < CONNECT_MODE_NUM; mode++) {
+		const struct connect_result *res = &results[mode];
+
+		DOCA_LOG_INFO("%8s | %6u | %10.1f | %9.2f | %9.1f %9.1f | %9.1f %9.1f %9.1f",
+			      connect_mode_names[mode],
+			      res->window,
+			      res->total_ns == 0 ? 0.0 : (double)bench.num_connections * 1e9 / (double)res->total_ns,
+			      res->total_ns / 1e6,
+			      res->establish_p50 / 1000.0,
+			      res->establish_p99 / 1000.0,
+			      res->ttfb_p50 / 1000.0,
+			      res->ttfb_p99 / 1000.0,
+			      res->ttfb_max / 1000.0);
+	}
+	DOCA_LOG_INFO("parallel vs serial: %.2fx connection rate",
+		      results[CONNECT_MODE_PARALLEL].total_ns == 0 ?
+			      0.0 :
+			      (double)results[CONNECT_MODE_SERIAL].total_ns /
+				      (double)results[CONNECT_MODE_PARALLEL].total_ns);
+
+destroy_pe:
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_arrays:
+	free(bench.sorted);
+	free(bench.samples);
+	return result;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_DC_SCALING_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_dc_scaling_bench(struct rdma_bench_config *cfg, const uint32_t *peer_counts, uint32_t num_peer_counts);
+
+#define MAX_PEER_COUNTS (16)	     /* Maximum number of entries in the peer list */
+#define DEFAULT_PEER_LIST "8,64,512" /* Default numbers of peers */
+#define DEFAULT_MSG_SIZE (64)	     /* Default write size, small enough to be bound by the message rate */
+#define DEFAULT_QUEUE_DEPTH (128)    /* Default number of writes in flight over all the peers */
+#define DEFAULT_DURATION_SEC (2)     /* Default duration of every run */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct dc_scaling_bench_config {
+	struct rdma_bench_config bench;		 /* Benchmark configuration */
+	uint32_t peer_counts[MAX_PEER_COUNTS]; /* Numbers of peers to measure */
+	uint32_t num_peer_counts;		 /* Number of entries in peer_counts */
+};
+
+/*
+ * Parse a comma separated list of numbers of peers
+ *
+ * @peer_list [in]: list to parse
+ * @cfg [out]: sample configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_peer_list(const char *peer_list, struct dc_scaling_bench_config *cfg)
+{
+	const char *pos = peer_list;
+	unsigned long num_peers;
+	char *end;
+
+	cfg->num_peer_counts = 0;
+	while (*pos != '\0') {
+		if (!isdigit((unsigned char)*pos))
+			return DOCA_ERROR_INVALID_VALUE;
+		num_peers = strtoul(pos, &end, 10);
+		if (num_peers == 0 || num_peers > RDMA_BENCH_MAX_CONNECTIONS || cfg->num_peer_counts == MAX_PEER_COUNTS)
+			return DOCA_ERROR_INVALID_VALUE;
+		cfg->peer_counts[cfg->num_peer_counts++] = (uint32_t)num_peers;
+		if (*end == ',')
+			end++;
+		pos = end;
+	}
+
+	return cfg->num_peer_counts == 0 ? DOCA_ERROR_INVALID_VALUE : DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle peer list parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t peer_list_callback(void *param, void *config)
+{
+	struct dc_scaling_bench_config *cfg = (struct dc_scaling_bench_config *)config;
+
+	if (parse_peer_list((char *)param, cfg) != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Peer list must hold up to %d comma separated numbers between 1 and %d",
+			     MAX_PEER_COUNTS,
+			     RDMA_BENCH_MAX_CONNECTIONS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the DC scaling benchmark parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_dc_scaling_bench_params(void)
+{
+	struct doca_argp_param *peer_list_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&peer_list_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(peer_list_param, "pl");
+	doca_argp_param_set_long_name(peer_list_param, "peer-list");
+	doca_argp_param_set_arguments(peer_list_param, "<list>");
+	doca_argp_param_set_description(peer_list_param,
+					"Comma separated numbers of peers to measure, default " DEFAULT_PEER_LIST
+					" (optional)");
+	doca_argp_param_set_callback(peer_list_param, peer_list_callback);
+	doca_argp_param_set_type(peer_list_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(peer_list_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct dc_scaling_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = DEFAULT_MSG_SIZE;
+	cfg.bench.queue_depth = DEFAULT_QUEUE_DEPTH;
+	cfg.bench.duration_sec = DEFAULT_DURATION_SEC;
+	(void)parse_peer_list(DEFAULT_PEER_LIST, &cfg);
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_dc_scaling_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark params */
+	result = register_rdma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register DC scaling benchmark params */
+	result = register_dc_scaling_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DC scaling benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_dc_scaling_bench(&cfg.bench, cfg.peer_counts, cfg.num_peer_counts);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_dc_scaling_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,625 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_DC_SCALING_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024) /* Number of PE progress calls between two deadline checks */
+#define NUM_TRANSPORTS (2)	   /* RC and DC */
+
+static const enum doca_rdma_transport_type transport_types[NUM_TRANSPORTS] = {DOCA_RDMA_TRANSPORT_TYPE_RC,
+									      DOCA_RDMA_TRANSPORT_TYPE_DC};
+static const char *const transport_names[NUM_TRANSPORTS] = {"RC", "DC"};
+
+/* Footprint and message rate of one transport at one number of peers */
+struct scaling_result {
+	uint64_t ctx_rss_kb;	 /* Resident memory of the two started contexts, without connections */
+	uint64_t ctx_pinned_kb;	 /* Pinned memory of the two started contexts, without connections */
+	uint64_t hub_rss_kb;	 /* Resident memory of all the hub connections */
+	uint64_t hub_pinned_kb;	 /* Pinned memory of all the hub connections */
+	uint64_t peer_rss_kb;	 /* Resident memory of all the peer connections */
+	uint64_t peer_pinned_kb; /* Pinned memory of all the peer connections */
+	uint64_t connect_ns;	 /* Time to export and connect all the connections */
+	double mops;		 /* Million writes per second of the hub, round robin over the peers */
+};
+
+/* Benchmark state */
+struct scaling_bench {
+	struct rdma_bench_config *cfg;		/* Benchmark configuration */
+	struct doca_dev *dev;			/* DOCA device */
+	struct doca_pe *pe;			/* Progress engine driving both endpoints */
+	struct rdma_bench_endpoint hub;		/* Endpoint writing to every peer */
+	struct rdma_bench_endpoint peers;	/* Endpoint owning the peer side of every connection */
+	uint32_t num_peers;			/* Number of peers of the current run */
+	int numa_node;				/* NUMA node of the device */
+	size_t region_len;			/* Length of the source and of the target region */
+	char *src;				/* Sources of the writes, one slot per task */
+	char *dst;				/* Targets of the writes, one slot per task */
+	struct doca_mmap *src_mmap;		/* Registration of src */
+	struct doca_mmap *dst_mmap;		/* Registration of dst */
+	struct doca_mmap *dst_view_mmap;	/* dst as seen by the hub */
+	struct doca_buf_inventory *inventory;	/* Inventory for the task buffers */
+	struct doca_rdma_task_write **tasks;	/* Write tasks */
+	uint32_t num_inflight;			/* Number of submitted tasks that have not completed yet */
+	uint32_t next_connection;		/* Connection the next resubmitted write targets */
+	bool running;				/* Whether completed tasks should be resubmitted */
+	uint64_t completed_ops;			/* Number of completed writes */
+	void **hub_descs;			/* Copies of the hub connection descriptors */
+	size_t *hub_desc_sizes;			/* Sizes of the hub connection descriptors */
+	doca_error_t result;			/* First error encountered by the callbacks */
+};
+
+/*
+ * Release a write task and its buffers
+ *
+ * @bench [in]: benchmark state
+ * @task_idx [in]: task index
+ */
+static void release_write_task(struct scaling_bench *bench, uint32_t task_idx)
+{
+	struct doca_rdma_task_write *task = bench->tasks[task_idx];
+	struct doca_buf *src_buf, *dst_buf;
+
+	if (task == NULL)
+		return;
+
+	src_buf = (struct doca_buf *)doca_rdma_task_write_get_src_buf(task);
+	dst_buf = doca_rdma_task_write_get_dst_buf(task);
+	doca_task_free(doca_rdma_task_write_as_task(task));
+	if (src_buf != NULL)
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+	if (dst_buf != NULL)
+		(void)doca_buf_dec_refcount(dst_buf, NULL);
+	bench->tasks[task_idx] = NULL;
+}
+
+/*
+ * RDMA write task completed callback, moves the task to the next peer and resubmits it while the run is active
+ *
+ * @rdma_write_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void scaling_write_completed_callback(struct doca_rdma_task_write *rdma_write_task,
+					     union doca_data task_user_data,
+					     union doca_data ctx_user_data)
+{
+	struct scaling_bench *bench = (struct scaling_bench *)ctx_user_data.ptr;
+	doca_error_t result;
+
+	bench->completed_ops++;
+
+	if (bench->running) {
+		/* Round robin, so that with DC every write may need a different target than the previous one */
+		doca_rdma_task_write_set_rdma_connection(rdma_write_task, bench->hub.connections[bench->next_connection]);
+		if (++bench->next_connection == bench->num_peers)
+			bench->next_connection = 0;
+		result = doca_task_submit(doca_rdma_task_write_as_task(rdma_write_task));
+		if (result == DOCA_SUCCESS)
+			return;
+		DOCA_LOG_ERR("Failed to resubmit RDMA write task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(bench->result, result);
+		bench->running = false;
+	}
+
+	release_write_task(bench, (uint32_t)task_user_data.u64);
+	bench->num_inflight--;
+}
+
+/*
+ * RDMA write task error callback
+ *
+ * @rdma_write_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void scaling_write_error_callback(struct doca_rdma_task_write *rdma_write_task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct scaling_bench *bench = (struct scaling_bench *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_write_as_task(rdma_write_task));
+
+	DOCA_LOG_ERR("RDMA write task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(bench->result, result);
+	bench->running = false;
+
+	release_write_task(bench, (uint32_t)task_user_data.u64);
+	bench->num_inflight--;
+}
+
+/*
+ * Difference between two memory usage snapshots, clamped at zero
+ *
+ * @before [in]: first snapshot
+ * @after [in]: second snapshot
+ * @rss_kb [out]: resident memory difference
+ * @pinned_kb [out]: pinned memory difference
+ */
+static void mem_usage_delta(const struct bench_mem_usage *before,
+			    const struct bench_mem_usage *after,
+			    uint64_t *rss_kb,
+			    uint64_t *pinned_kb)
+{
+	*rss_kb = after->rss_kb > before->rss_kb ? after->rss_kb - before->rss_kb : 0;
+	*pinned_kb = after->pinned_kb > before->pinned_kb ? after->pinned_kb - before->pinned_kb : 0;
+}
+
+/*
+ * Export and connect all the connections, measuring the memory of the hub side and of the peer side separately.
+ * All the hub connections are exported first, so that their footprint is not mixed with the peer side. With RC both
+ * sides connect, with DC only the hub (the initiator) connects to the targets exported by the peers.
+ *
+ * @bench [in]: benchmark state
+ * @transport_type [in]: transport of the run
+ * @result_out [in/out]: footprint and connect time are filled
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t connect_peers(struct scaling_bench *bench,
+				  enum doca_rdma_transport_type transport_type,
+				  struct scaling_result *result_out)
+{
+	struct bench_mem_usage before, after_hub, after_peers;
+	const void *desc;
+	size_t desc_size;
+	uint64_t start_ns;
+	doca_error_t result;
+	uint32_t i;
+
+	(void)bench_get_mem_usage(&before);
+	start_ns = bench_get_time_ns();
+
+	for (i = 0; i < bench->num_peers; i++) {
+		result = doca_rdma_export(bench->hub.rdma, &desc, &desc_size, &bench->hub.connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to export hub connection [%u]: %s", i, doca_error_get_descr(result));
+			return result;
+		}
+		bench->hub.num_connections++;
+
+		/* The descriptor is only guaranteed to be valid until the next export on the same context */
+		bench->hub_descs[i] = malloc(desc_size);
+		if (bench->hub_descs[i] == NULL) {
+			DOCA_LOG_ERR("Failed to allocate memory for RDMA connection descriptor");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		memcpy(bench->hub_descs[i], desc, desc_size);
+		bench->hub_desc_sizes[i] = desc_size;
+	}
+	(void)bench_get_mem_usage(&after_hub);
+
+	for (i = 0; i < bench->num_peers; i++) {
+		result = doca_rdma_export(bench->peers.rdma, &desc, &desc_size, &bench->peers.connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to export peer connection [%u]: %s", i, doca_error_get_descr(result));
+			return result;
+		}
+		bench->peers.num_connections++;
+
+		result = doca_rdma_connect(bench->hub.rdma, desc, desc_size, bench->hub.connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to connect hub connection [%u]: %s", i, doca_error_get_descr(result));
+			return result;
+		}
+
+		if (transport_type == DOCA_RDMA_TRANSPORT_TYPE_DC)
+			continue;
+
+		result = doca_rdma_connect(bench->peers.rdma,
+					   bench->hub_descs[i],
+					   bench->hub_desc_sizes[i],
+					   bench->peers.connections[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to connect peer connection [%u]: %s", i, doca_error_get_descr(result));
+			return result;
+		}
+	}
+	result_out->connect_ns = bench_get_time_ns() - start_ns;
+	(void)bench_get_mem_usage(&after_peers);
+
+	mem_usage_delta(&before, &after_hub, &result_out->hub_rss_kb, &result_out->hub_pinned_kb);
+	mem_usage_delta(&after_hub, &after_peers, &result_out->peer_rss_kb, &result_out->peer_pinned_kb);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Keep queue_depth writes in flight from the hub, every completed write is resubmitted to the next peer
+ *
+ * @bench [in]: benchmark state
+ * @result_out [in/out]: message rate is filled
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_writes(struct scaling_bench *bench, struct scaling_result *result_out)
+{
+	const uint32_t msg_size = bench->cfg->msg_size;
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf, *dst_buf;
+	uint64_t start_ns, deadline_ns, elapsed_ns, num_polls = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	bench->completed_ops = 0;
+	bench->result = DOCA_SUCCESS;
+
+	for (i = 0; i < bench->cfg->queue_depth; i++) {
+		result = doca_buf_inventory_buf_get_by_data(bench->inventory,
+							    bench->src_mmap,
+							    bench->src + (size_t)i * msg_size,
+							    msg_size,
+							    &src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate source buffer: %s", doca_error_get_descr(result));
+			goto release_tasks;
+		}
+
+		result = doca_buf_inventory_buf_get_by_addr(bench->inventory,
+							    bench->dst_view_mmap,
+							    bench->dst + (size_t)i * msg_size,
+							    msg_size,
+							    &dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate target buffer: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(src_buf, NULL);
+			goto release_tasks;
+		}
+
+		task_user_data.u64 = i;
+		result = doca_rdma_task_write_allocate_init(bench->hub.rdma,
+							    bench->hub.connections[i % bench->num_peers],
+							    src_buf,
+							    dst_buf,
+							    task_user_data,
+							    &bench->tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA write task: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(dst_buf, NULL);
+			(void)doca_buf_dec_refcount(src_buf, NULL);
+			goto release_tasks;
+		}
+	}
+	bench->next_connection = bench->cfg->queue_depth % bench->num_peers;
+
+	bench->running = true;
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < bench->cfg->queue_depth; i++) {
+		result = doca_task_submit(doca_rdma_task_write_as_task(bench->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit RDMA write task: %s", doca_error_get_descr(result));
+			bench->running = false;
+			break;
+		}
+		bench->num_inflight++;
+	}
+
+	while (bench->running) {
+		(void)doca_pe_progress(bench->pe);
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && bench_get_time_ns() >= deadline_ns)
+			bench->running = false;
+	}
+	elapsed_ns = bench_get_time_ns() - start_ns;
+	result_out->mops = (double)bench->completed_ops * 1000.0 / (double)elapsed_ns;
+
+	/* Drain, the completion callbacks release the tasks */
+	while (bench->num_inflight > 0)
+		(void)doca_pe_progress(bench->pe);
+	DOCA_ERROR_PROPAGATE(result, bench->result);
+
+release_tasks:
+	for (i = 0; i < bench->cfg->queue_depth; i++)
+		release_write_task(bench, i);
+	return result;
+}
+
+/*
+ * Measure one transport at one number of peers on fresh endpoints
+ *
+ * @bench [in]: benchmark state
+ * @transport_idx [in]: index in transport_types
+ * @num_peers [in]: number of peers
+ * @result_out [out]: results of the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_scaling(struct scaling_bench *bench,
+				uint32_t transport_idx,
+				uint32_t num_peers,
+				struct scaling_result *result_out)
+{
+	struct rdma_bench_endpoint_attr attr = {0};
+	union doca_data ctx_user_data = {0};
+	struct bench_mem_usage before, after;
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	bench->num_peers = num_peers;
+	(void)bench_get_mem_usage(&before);
+
+	attr.num_connections = num_peers;
+	attr.send_queue_size = bench->cfg->queue_depth;
+	attr.transport_type = transport_types[transport_idx];
+	attr.is_gid_index_set = bench->cfg->rdma.is_gid_index_set;
+	attr.gid_index = bench->cfg->rdma.gid_index;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->hub);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->peers);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = doca_rdma_task_write_set_conf(bench->hub.rdma,
+					       scaling_write_completed_callback,
+					       scaling_write_error_callback,
+					       bench->cfg->queue_depth);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	ctx_user_data.ptr = bench;
+	result = doca_ctx_set_user_data(bench->hub.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->hub);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->peers);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	(void)bench_get_mem_usage(&after);
+	mem_usage_delta(&before, &after, &result_out->ctx_rss_kb, &result_out->ctx_pinned_kb);
+
+	result = connect_peers(bench, transport_types[transport_idx], result_out);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = run_writes(bench, result_out);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("%s writes to %u peers failed: %s",
+			     transport_names[transport_idx],
+			     num_peers,
+			     doca_error_get_descr(result));
+
+destroy_endpoints:
+	tmp_result = rdma_bench_endpoint_destroy(bench->pe, &bench->hub);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench->pe, &bench->peers);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	for (i = 0; i < num_peers; i++) {
+		free(bench->hub_descs[i]);
+		bench->hub_descs[i] = NULL;
+	}
+	return result;
+}
+
+/*
+ * Register the source and target regions of the writes, shared by all the runs
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_memory(struct scaling_bench *bench)
+{
+	doca_error_t result;
+
+	bench->region_len = (size_t)bench->cfg->queue_depth * bench->cfg->msg_size;
+	bench->src = bench_alloc_numa(bench->region_len, bench->numa_node);
+	bench->dst = bench_alloc_numa(bench->region_len, bench->numa_node);
+	if (bench->src == NULL || bench->dst == NULL) {
+		DOCA_LOG_ERR("Failed to allocate two regions of %zu bytes", bench->region_len);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(bench->src, 0xA5, bench->region_len);
+
+	result = create_local_mmap(&bench->src_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   bench->src,
+				   bench->region_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = create_local_mmap(&bench->dst_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE,
+				   bench->dst,
+				   bench->region_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_import_mmap(bench->dst_mmap, bench->dev, &bench->dst_view_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_create(2 * bench->cfg->queue_depth, &bench->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(bench->inventory);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Release the memory of prepare_memory()
+ *
+ * @bench [in]: benchmark state
+ */
+static void destroy_memory(struct scaling_bench *bench)
+{
+	if (bench->inventory != NULL) {
+		(void)doca_buf_inventory_stop(bench->inventory);
+		(void)doca_buf_inventory_destroy(bench->inventory);
+	}
+	if (bench->dst_view_mmap != NULL)
+		(void)doca_mmap_destroy(bench->dst_view_mmap);
+	if (bench->dst_mmap != NULL) {
+		(void)doca_mmap_stop(bench->dst_mmap);
+		(void)doca_mmap_destroy(bench->dst_mmap);
+	}
+	if (bench->src_mmap != NULL) {
+		(void)doca_mmap_stop(bench->src_mmap);
+		(void)doca_mmap_destroy(bench->src_mmap);
+	}
+	bench_free_numa(bench->dst, bench->region_len);
+	bench_free_numa(bench->src, bench->region_len);
+}
+
+/*
+ * Compare the memory footprint and the message rate of RC and DC as the number of peers of one context grows.
+ * A hub endpoint owns one connection per peer and writes round robin to all of them; with RC every connection is a
+ * queue pair on both ends, with DC the hub initiates to the targets exported by the peers.
+ *
+ * @cfg [in]: Configuration parameters, queue_depth is the number of writes the hub keeps in flight
+ * @peer_counts [in]: numbers of peers to measure
+ * @num_peer_counts [in]: number of entries in peer_counts
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_dc_scaling_bench(struct rdma_bench_config *cfg, const uint32_t *peer_counts, uint32_t num_peer_counts)
+{
+	struct scaling_result *results;
+	struct scaling_bench bench = {0};
+	doca_error_t result, tmp_result;
+	uint32_t i, t, max_peers = 0;
+
+	for (i = 0; i < num_peer_counts; i++)
+		max_peers = peer_counts[i] > max_peers ? peer_counts[i] : max_peers;
+
+	bench.cfg = cfg;
+	results = calloc((size_t)num_peer_counts * NUM_TRANSPORTS, sizeof(*results));
+	bench.tasks = calloc(cfg->queue_depth, sizeof(*bench.tasks));
+	bench.hub_descs = calloc(max_peers, sizeof(*bench.hub_descs));
+	bench.hub_desc_sizes = calloc(max_peers, sizeof(*bench.hub_desc_sizes));
+	if (results == NULL || bench.tasks == NULL || bench.hub_descs == NULL || bench.hub_desc_sizes == NULL) {
+		DOCA_LOG_ERR("Failed to allocate benchmark state");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_arrays;
+	}
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_write_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		goto free_arrays;
+	}
+	bench.numa_node = bench_get_ibdev_numa_node(cfg->rdma.device_name);
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	result = prepare_memory(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_memory;
+
+	for (i = 0; i < num_peer_counts; i++) {
+		for (t = 0; t < NUM_TRANSPORTS; t++) {
+			result = run_scaling(&bench, t, peer_counts[i], &results[i * NUM_TRANSPORTS + t]);
+			if (result != DOCA_SUCCESS)
+				goto destroy_memory;
+		}
+	}
+
+	DOCA_LOG_INFO("%u bytes writes, %u in flight, round robin over the peers; memory in KB (resident/pinned)",
+		      cfg->msg_size,
+		      cfg->queue_depth);
+	DOCA_LOG_INFO("transport | peers |   contexts  | hub per peer | peer per peer | connect ms |  Mwrite/s");
+	for (i = 0; i < num_peer_counts; i++) {
+		for (t = 0; t < NUM_TRANSPORTS; t++) {
+			const struct scaling_result *res = &results[i * NUM_TRANSPORTS + t];
+
+			DOCA_LOG_INFO("%9s | %5u | %5lu/%5lu | %5.1f/%6.1f | %6.1f/%6.1f | %10.2f | %9.3f",
+				      transport_names[t],
+				      peer_counts[i],
+				      res->ctx_rss_kb,
+				      res->ctx_pinned_kb,
+				      (double)res->hub_rss_kb / peer_counts[i],
+				      (double)res->hub_pinned_kb / peer_counts[i],
+				      (double)res->peer_rss_kb / peer_counts[i],
+				      (double)res->peer_pinned_kb / peer_counts[i],
+				      res->connect_ns / 1e6,
+				      res->mops);
+		}
+	}
+	for (i = 0; i < num_peer_counts; i++) {
+		const struct scaling_result *rc = &results[i * NUM_TRANSPORTS];
+		const struct scaling_result *dc = &results[i * NUM_TRANSPORTS + 1];
+		uint64_t rc_kb = rc->hub_rss_kb + rc->hub_pinned_kb, dc_kb = dc->hub_rss_kb + dc->hub_pinned_kb;
+
+		DOCA_LOG_INFO("%u peers: DC hub memory %.2fx of RC, DC message rate %.2fx of RC",
+			      peer_counts[i],
+			      rc_kb == 0 ? 0.0 : (double)dc_kb / (double)rc_kb,
+			      rc->mops == 0.0 ? 0.0 : dc->mops / rc->mops);
+	}
+
+destroy_memory:
+	destroy_memory(&bench);
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_arrays:
+	free(bench.hub_desc_sizes);
+	free(bench.hub_descs);
+	free(bench.tasks);
+	free(results);
+	return result;
+}
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_pe.h>
+
+#include "rdma_common.h"
+#include "rdma_inline_send.h"
+
+DOCA_LOG_REGISTER(RDMA::INLINE_SEND);
+
+#define SLOT_ALIGNMENT (64) /* Slots start on a cache line, so copying into one never touches a neighbour */
+
+/*
+ * Get the distance between two consecutive slots
+ *
+ * @sender [in]: the sender
+ * @return: slot stride in bytes
+ */
+static size_t inline_send_slot_stride(const struct rdma_inline_sender *sender)
+{
+	return ((size_t)sender->attr.threshold + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+}
+
+/*
+ * Return the slot of a completed send task to the free stack
+ *
+ * @sender [in]: the sender
+ * @rdma_send_task [in]: completed task
+ */
+static void inline_send_release_slot(struct rdma_inline_sender *sender, struct doca_rdma_task_send *rdma_send_task)
+{
+	void *addr = NULL;
+
+	(void)doca_buf_get_head(doca_rdma_task_send_get_src_buf(rdma_send_task), &addr);
+	sender->free_slots[sender->num_free++] = (uint32_t)(((char *)addr - sender->ring) /
+							     inline_send_slot_stride(sender));
+	sender->num_inflight--;
+}
+
+/*
+ * RDMA send task completed callback, the task stays allocated and its slot becomes free
+ *
+ * @rdma_send_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void inline_send_completed_callback(struct doca_rdma_task_send *rdma_send_task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data)
+{
+	struct rdma_inline_sender *sender = (struct rdma_inline_sender *)task_user_data.ptr;
+
+	(void)ctx_user_data;
+
+	sender->stats.num_sent++;
+	inline_send_release_slot(sender, rdma_send_task);
+}
+
+/*
+ * RDMA send task error callback
+ *
+ * @rdma_send_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void inline_send_error_callback(struct doca_rdma_task_send *rdma_send_task,
+				       union doca_data task_user_data,
+				       union doca_data ctx_user_data)
+{
+	struct rdma_inline_sender *sender = (struct rdma_inline_sender *)task_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_send_as_task(rdma_send_task));
+
+	(void)ctx_user_data;
+
+	DOCA_LOG_ERR("RDMA inline send task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(sender->first_encountered_error, result);
+	sender->stats.num_errors++;
+	inline_send_release_slot(sender, rdma_send_task);
+}
+
+doca_error_t rdma_inline_send_get_threshold(const struct doca_devinfo *devinfo,
+					    uint32_t requested,
+					    uint32_t *threshold)
+{
+	uint32_t max_message_size;
+	doca_error_t result;
+
+	if (requested == 0)
+		requested = RDMA_INLINE_SEND_DEFAULT_THRESHOLD;
+
+	result = doca_rdma_cap_get_max_message_size(devinfo, &max_message_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to query the maximal RDMA message size: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	if (requested > RDMA_INLINE_SEND_MAX_THRESHOLD)
+		requested = RDMA_INLINE_SEND_MAX_THRESHOLD;
+	if (requested > max_message_size)
+		requested = max_message_size;
+
+	*threshold = requested;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_inline_sender_create(struct doca_dev *dev,
+				       struct doca_rdma *rdma,
+				       const struct rdma_inline_send_attr *attr,
+				       struct rdma_inline_sender **sender)
+{
+	struct rdma_inline_sender *new_sender;
+	long page_size = sysconf(_SC_PAGESIZE);
+	doca_error_t result, tmp_result;
+	size_t stride;
+	uint32_t i;
+
+	if (attr->num_slots == 0 || attr->threshold == 0 || attr->threshold > RDMA_INLINE_SEND_MAX_THRESHOLD) {
+		DOCA_LOG_ERR("Invalid inline sender attributes: %u slots with threshold %u, up to %u bytes",
+			     attr->num_slots,
+			     attr->threshold,
+			     RDMA_INLINE_SEND_MAX_THRESHOLD);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_sender = calloc(1, sizeof(*new_sender));
+	if (new_sender == NULL) {
+		DOCA_LOG_ERR("Failed to allocate inline sender");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_sender->rdma = rdma;
+	new_sender->attr = *attr;
+	new_sender->first_encountered_error = DOCA_SUCCESS;
+
+	result = doca_rdma_set_send_queue_size(rdma, attr->num_slots);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set send queue size to %u: %s", attr->num_slots, doca_error_get_descr(result));
+		goto destroy_sender;
+	}
+
+	result = doca_rdma_task_send_set_conf(rdma,
+					      inline_send_completed_callback,
+					      inline_send_error_callback,
+					      attr->num_slots);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA send task: %s", doca_error_get_descr(result));
+		goto destroy_sender;
+	}
+
+	/* One registration covers all the slots, it is done once instead of once per message */
+	stride = inline_send_slot_stride(new_sender);
+	new_sender->ring_len = (size_t)attr->num_slots * stride;
+	new_sender->ring_len = (new_sender->ring_len + page_size - 1) / page_size * page_size;
+	new_sender->ring = aligned_alloc(page_size, new_sender->ring_len);
+	new_sender->bufs = calloc(attr->num_slots, sizeof(*new_sender->bufs));
+	new_sender->tasks = calloc(attr->num_slots, sizeof(*new_sender->tasks));
+	new_sender->free_slots = calloc(attr->num_slots, sizeof(*new_sender->free_slots));
+	if (new_sender->ring == NULL || new_sender->bufs == NULL || new_sender->tasks == NULL ||
+	    new_sender->free_slots == NULL) {
+		DOCA_LOG_ERR("Failed to allocate inline sender memory");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_sender;
+	}
+
+	result = create_local_mmap(&new_sender->mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   new_sender->ring,
+				   new_sender->ring_len,
+				   dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_sender;
+
+	result = doca_buf_inventory_create(attr->num_slots, &new_sender->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_sender;
+	}
+
+	result = doca_buf_inventory_start(new_sender->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_sender;
+	}
+
+	for (i = 0; i < attr->num_slots; i++) {
+		result = doca_buf_inventory_buf_get_by_addr(new_sender->inventory,
+							    new_sender->mmap,
+							    new_sender->ring + (size_t)i * stride,
+							    attr->threshold,
+							    &new_sender->bufs[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate slot buffer: %s", doca_error_get_descr(result));
+			goto destroy_sender;
+		}
+	}
+
+	*sender = new_sender;
+	return DOCA_SUCCESS;
+
+destroy_sender:
+	tmp_result = rdma_inline_sender_destroy(new_sender);
+	if (tmp_result != DOCA_SUCCESS)
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+doca_error_t rdma_inline_sender_start(struct rdma_inline_sender *sender, struct doca_rdma_connection *connection)
+{
+	union doca_data task_user_data = {0};
+	doca_error_t result;
+	uint32_t i;
+
+	task_user_data.ptr = sender;
+	for (i = 0; i < sender->attr.num_slots; i++) {
+		result = doca_rdma_task_send_allocate_init(sender->rdma,
+							   connection,
+							   sender->bufs[i],
+							   task_user_data,
+							   &sender->tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA send task: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	/* Push in reverse order so the first sends use the first slots */
+	for (i = sender->attr.num_slots; i > 0; i--)
+		sender->free_slots[sender->num_free++] = i - 1;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_inline_send(struct rdma_inline_sender *sender,
+			      struct doca_rdma_connection *connection,
+			      const void *msg,
+			      uint32_t msg_len)
+{
+	struct doca_rdma_task_send *task;
+	doca_error_t result;
+	uint32_t slot;
+	void *data;
+
+	if (msg_len > sender->attr.threshold)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	if (sender->num_free == 0) {
+		sender->stats.num_busy++;
+		return DOCA_ERROR_AGAIN;
+	}
+
+	slot = sender->free_slots[--sender->num_free];
+	task = sender->tasks[slot];
+	data = sender->ring + (size_t)slot * inline_send_slot_stride(sender);
+
+	memcpy(data, msg, msg_len);
+	(void)doca_buf_set_data(sender->bufs[slot], data, msg_len);
+	doca_rdma_task_send_set_rdma_connection(task, connection);
+
+	result = doca_task_submit(doca_rdma_task_send_as_task(task));
+	if (result != DOCA_SUCCESS) {
+		sender->free_slots[sender->num_free++] = slot;
+		return result;
+	}
+	sender->num_inflight++;
+
+	return DOCA_SUCCESS;
+}
+
+uint32_t rdma_inline_send_get_num_inflight(const struct rdma_inline_sender *sender)
+{
+	return sender->num_inflight;
+}
+
+doca_error_t rdma_inline_sender_destroy(struct rdma_inline_sender *sender)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint32_t i;
+
+	if (sender == NULL)
+		return DOCA_SUCCESS;
+
+	if (sender->num_inflight != 0) {
+		DOCA_LOG_ERR("Destroying inline sender with %u sends in flight", sender->num_inflight);
+		return DOCA_ERROR_IN_USE;
+	}
+
+	if (sender->tasks != NULL) {
+		for (i = 0; i < sender->attr.num_slots; i++)
+			if (sender->tasks[i] != NULL)
+				doca_task_free(doca_rdma_task_send_as_task(sender->tasks[i]));
+	}
+
+	if (sender->bufs != NULL) {
+		for (i = 0; i < sender->attr.num_slots; i++) {
+			if (sender->bufs[i] == NULL)
+				continue;
+			tmp_result = doca_buf_dec_refcount(sender->bufs[i], NULL);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to decrease slot buffer count: %s", doca_error_get_descr(tmp_result));
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+			}
+		}
+	}
+
+	if (sender->inventory != NULL) {
+		tmp_result = doca_buf_inventory_stop(sender->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_buf_inventory_destroy(sender->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (sender->mmap != NULL) {
+		tmp_result = doca_mmap_stop(sender->mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_mmap_destroy(sender->mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(sender->free_slots);
+	free(sender->tasks);
+	free(sender->bufs);
+	free(sender->ring);
+	free(sender);
+
+	return result;
+}
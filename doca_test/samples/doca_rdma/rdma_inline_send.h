@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_INLINE_SEND_H_
+#define RDMA_INLINE_SEND_H_
+
+#include <stdint.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_rdma.h>
+
+/*
+ * Small-message send path that copies the payload at post time, like verbs inline sends.
+ *
+ * DOCA RDMA has no inline data attribute: every send task needs a doca_buf from a registered mmap, and the
+ * negotiation path (send_msg()) gets a fresh doca_buf and allocates a fresh task for every message. For messages
+ * below the threshold this per-message setup costs more than the transfer itself. The inline sender instead owns a
+ * pre-registered bounce ring of slots, each with a doca_buf and a send task built once at start. A send copies the
+ * payload into a free slot, updates the buffer data length and resubmits the slot task, so the caller's buffer is
+ * reusable as soon as rdma_inline_send() returns and no registration, inventory or task allocation happens on the
+ * data path.
+ *
+ * Threading: all the functions and the completion callbacks run on the PE thread.
+ */
+
+#define RDMA_INLINE_SEND_DEFAULT_THRESHOLD (256) /* Default largest message copied into the bounce ring */
+#define RDMA_INLINE_SEND_MAX_THRESHOLD (1024)	 /* Largest supported threshold, beyond it copying stops paying off */
+#define RDMA_INLINE_SEND_DEFAULT_SLOTS (16)	 /* Default number of bounce slots, i.e. of sends in flight */
+
+/* Attributes of an inline sender */
+struct rdma_inline_send_attr {
+	uint32_t num_slots; /* Number of bounce slots, the maximal number of sends in flight */
+	uint32_t threshold; /* Largest message accepted, also the slot size */
+};
+
+/* Counters of an inline sender */
+struct rdma_inline_send_stats {
+	uint64_t num_sent;   /* Number of successfully completed sends */
+	uint64_t num_busy;   /* Number of sends rejected because all slots were in flight */
+	uint64_t num_errors; /* Number of send tasks completed with an error */
+};
+
+struct rdma_inline_sender {
+	struct doca_rdma *rdma;			  /* DOCA RDMA the send tasks are submitted on */
+	struct rdma_inline_send_attr attr;	  /* Sender attributes */
+	char *ring;				  /* Memory of all bounce slots */
+	size_t ring_len;			  /* Length of ring */
+	struct doca_mmap *mmap;			  /* Registration of ring */
+	struct doca_buf_inventory *inventory;	  /* Inventory for the slot buffers */
+	struct doca_buf **bufs;			  /* One DOCA buffer per slot */
+	struct doca_rdma_task_send **tasks;	  /* One send task per slot, allocated on start */
+	uint32_t *free_slots;			  /* Stack of free slots, the last released slot is reused first */
+	uint32_t num_free;			  /* Number of entries in free_slots */
+	uint32_t num_inflight;			  /* Number of submitted sends that did not complete yet */
+	struct rdma_inline_send_stats stats;	  /* Sender counters */
+	doca_error_t first_encountered_error;	  /* First error encountered by the sender */
+};
+
+/*
+ * Get the largest message the inline sender of a device can take
+ * DOCA does not report the NIC inline data size, so the requested threshold is bounded by the device message size
+ * limit and RDMA_INLINE_SEND_MAX_THRESHOLD
+ *
+ * @devinfo [in]: DOCA device information
+ * @requested [in]: requested threshold, 0 selects RDMA_INLINE_SEND_DEFAULT_THRESHOLD
+ * @threshold [out]: threshold to use
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_inline_send_get_threshold(const struct doca_devinfo *devinfo,
+					    uint32_t requested,
+					    uint32_t *threshold);
+
+/*
+ * Create an inline sender on a DOCA RDMA that was not started yet
+ * Sets the send task configuration and the send queue size of the DOCA RDMA, so the application must not configure
+ * send tasks itself
+ *
+ * @dev [in]: DOCA device the DOCA RDMA was created on
+ * @rdma [in]: DOCA RDMA, before doca_ctx_start()
+ * @attr [in]: sender attributes
+ * @sender [out]: the created sender
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_inline_sender_create(struct doca_dev *dev,
+				       struct doca_rdma *rdma,
+				       const struct rdma_inline_send_attr *attr,
+				       struct rdma_inline_sender **sender);
+
+/*
+ * Allocate the send task of every slot, must be called once the DOCA RDMA is running
+ *
+ * @sender [in]: the sender
+ * @connection [in]: connection the slot tasks are initialized with, rdma_inline_send() may override it
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_inline_sender_start(struct rdma_inline_sender *sender, struct doca_rdma_connection *connection);
+
+/*
+ * Copy a message into a free slot and send it
+ *
+ * @sender [in]: the sender
+ * @connection [in]: connection to send on
+ * @msg [in]: message, may be reused as soon as the function returns
+ * @msg_len [in]: message length, up to the sender threshold
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if all slots are in flight and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_inline_send(struct rdma_inline_sender *sender,
+			      struct doca_rdma_connection *connection,
+			      const void *msg,
+			      uint32_t msg_len);
+
+/*
+ * Get the number of sends in flight
+ *
+ * @sender [in]: the sender
+ * @return: number of submitted sends that did not complete yet
+ */
+uint32_t rdma_inline_send_get_num_inflight(const struct rdma_inline_sender *sender);
+
+/*
+ * Destroy an inline sender, must be called when no send is in flight and before the DOCA RDMA is stopped
+ *
+ * @sender [in]: the sender
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_inline_sender_destroy(struct rdma_inline_sender *sender);
+
+#endif /* RDMA_INLINE_SEND_H_ */
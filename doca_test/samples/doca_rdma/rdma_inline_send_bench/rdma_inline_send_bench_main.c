@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+#include "rdma_inline_send.h"
+
+DOCA_LOG_REGISTER(RDMA_INLINE_SEND_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_inline_send_bench(struct rdma_bench_config *cfg, uint32_t iterations);
+
+#define DEFAULT_ITERATIONS (100000) /* Default number of sampled round trips, enough samples for p99.9 */
+#define MIN_ITERATIONS (1000)	    /* Fewest round trips giving a meaningful p99.9 */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct inline_send_bench_config {
+	struct rdma_bench_config bench; /* Benchmark configuration, msg_size is the largest message of the sweep */
+	uint32_t iterations;		/* Sampled round trips per message size */
+};
+
+/*
+ * ARGP Callback - Handle largest message size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t max_size_callback(void *param, void *config)
+{
+	struct inline_send_bench_config *cfg = (struct inline_send_bench_config *)config;
+	const int max_size = *(int *)param;
+
+	if (max_size <= 0 || max_size > RDMA_INLINE_SEND_MAX_THRESHOLD) {
+		DOCA_LOG_ERR("Largest message size must be between 1 and %d bytes", RDMA_INLINE_SEND_MAX_THRESHOLD);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->bench.msg_size = (uint32_t)max_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle iterations parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t iterations_callback(void *param, void *config)
+{
+	struct inline_send_bench_config *cfg = (struct inline_send_bench_config *)config;
+	const int iterations = *(int *)param;
+
+	if (iterations < MIN_ITERATIONS) {
+		DOCA_LOG_ERR("Number of iterations must be at least %d", MIN_ITERATIONS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->iterations = (uint32_t)iterations;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the inline send benchmark parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_inline_send_params(void)
+{
+	struct doca_argp_param *max_size_param, *iterations_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&max_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(max_size_param, "mx");
+	doca_argp_param_set_long_name(max_size_param, "max-size");
+	doca_argp_param_set_arguments(max_size_param, "<bytes>");
+	doca_argp_param_set_description(max_size_param,
+					"Largest message of the sweep starting at 8 bytes, the inline threshold (optional)");
+	doca_argp_param_set_callback(max_size_param, max_size_callback);
+	doca_argp_param_set_type(max_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(max_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(iterations_param, "it");
+	doca_argp_param_set_long_name(iterations_param, "iterations");
+	doca_argp_param_set_arguments(iterations_param, "<num>");
+	doca_argp_param_set_description(iterations_param, "Sampled round trips per message size (optional)");
+	doca_argp_param_set_callback(iterations_param, iterations_callback);
+	doca_argp_param_set_type(iterations_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct inline_send_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = RDMA_INLINE_SEND_DEFAULT_THRESHOLD;
+	cfg.iterations = DEFAULT_ITERATIONS;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_inline_send_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register inline send params */
+	result = register_inline_send_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register inline send parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_inline_send_bench(&cfg.bench, cfg.iterations);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_inline_send_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,583 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+#include "rdma_inline_send.h"
+#include "rdma_recv_ring.h"
+
+DOCA_LOG_REGISTER(RDMA_INLINE_SEND_BENCH::SAMPLE);
+
+#define MIN_MSG_SIZE (8)			  /* Smallest message size of the sweep */
+#define WARMUP_ITERATIONS (1000)		  /* Round trips run before the samples are taken */
+#define NUM_SEND_TASKS (16)			  /* Send tasks, or inline slots, of every side */
+#define RING_NUM_SLOTS (32)			  /* Receive ring slots of every side */
+#define RING_NUM_POSTED (16)			  /* Receive tasks kept posted by every side */
+#define MAX_NUM_SIZES (16)			  /* Upper bound on the number of swept message sizes */
+#define WAIT_TIMEOUT_NS (BENCH_NSEC_PER_SEC)	  /* Time to wait for a single message before giving up */
+#define TIME_CHECK_INTERVAL (1024)		  /* Number of PE progress calls between two timeout checks */
+
+/* Send path measured by a run */
+enum send_mode {
+	SEND_MODE_REGISTERED, /* send_msg(): doca_buf and send task obtained per message from the caller's mmap */
+	SEND_MODE_INLINE,     /* rdma_inline_send(): copy into a pre-registered bounce slot with a pre-built task */
+	SEND_MODE_NUM,
+};
+
+static const char *const send_mode_names[SEND_MODE_NUM] = {"registered", "inline"};
+
+/* Latency percentiles of one message size, in nanoseconds */
+struct latency_result {
+	uint64_t p50;  /* Median */
+	uint64_t p99;  /* 99th percentile */
+	uint64_t p999; /* 99.9th percentile */
+};
+
+/* One side of the ping-pong */
+struct pingpong_side {
+	struct rdma_bench_endpoint endpoint;  /* Endpoint of this side */
+	struct rdma_recv_ring *ring;	      /* Receive ring of this side */
+	struct rdma_inline_sender *sender;    /* Inline sender, inline mode only */
+	char *msg;			      /* Message sent by this side, owned by the caller */
+	struct doca_mmap *msg_mmap;	      /* Registration of msg, registered mode only */
+	struct doca_buf_inventory *inventory; /* Inventory for the per-message buffers, registered mode only */
+	uint32_t num_inflight;		      /* Registered sends in flight */
+	doca_error_t first_encountered_error; /* First error of a send callback */
+};
+
+/* Benchmark state */
+struct inline_send_bench {
+	struct rdma_bench_config *cfg;	      /* Benchmark configuration */
+	uint32_t iterations;		      /* Sampled round trips per message size */
+	uint32_t max_msg_size;		      /* Largest message of the sweep, at most the inline threshold */
+	struct doca_dev *dev;		      /* DOCA device */
+	struct doca_pe *pe;		      /* Progress engine driving both sides */
+	enum send_mode mode;		      /* Send path of the current run */
+	struct pingpong_side sides[2];	      /* Pinging side and ponging side */
+	uint64_t *samples;		      /* Half round trip time of every sampled iteration */
+};
+
+/*
+ * RDMA send task completed callback of the registered path, releases the task and its per-message buffer
+ *
+ * @rdma_send_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void registered_send_completed_callback(struct doca_rdma_task_send *rdma_send_task,
+					       union doca_data task_user_data,
+					       union doca_data ctx_user_data)
+{
+	struct pingpong_side *side = (struct pingpong_side *)task_user_data.ptr;
+	struct doca_buf *src_buf = (struct doca_buf *)doca_rdma_task_send_get_src_buf(rdma_send_task);
+
+	(void)ctx_user_data;
+
+	doca_task_free(doca_rdma_task_send_as_task(rdma_send_task));
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	side->num_inflight--;
+}
+
+/*
+ * RDMA send task error callback of the registered path
+ *
+ * @rdma_send_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void registered_send_error_callback(struct doca_rdma_task_send *rdma_send_task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data)
+{
+	struct pingpong_side *side = (struct pingpong_side *)task_user_data.ptr;
+	struct doca_buf *src_buf = (struct doca_buf *)doca_rdma_task_send_get_src_buf(rdma_send_task);
+	doca_error_t result = doca_task_get_status(doca_rdma_task_send_as_task(rdma_send_task));
+
+	(void)ctx_user_data;
+
+	DOCA_LOG_ERR("RDMA send task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(side->first_encountered_error, result);
+	doca_task_free(doca_rdma_task_send_as_task(rdma_send_task));
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	side->num_inflight--;
+}
+
+/*
+ * Progress the PE once and repost parked receive tasks of both sides
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t progress(struct inline_send_bench *bench)
+{
+	doca_error_t result;
+
+	(void)doca_pe_progress(bench->pe);
+	result = rdma_recv_ring_replenish(bench->sides[0].ring);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return rdma_recv_ring_replenish(bench->sides[1].ring);
+}
+
+/*
+ * Send the message of a side to its peer with the send path of the current run
+ *
+ * @bench [in]: benchmark state
+ * @side [in]: sending side
+ * @msg_len [in]: message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t side_send(struct inline_send_bench *bench, struct pingpong_side *side, uint32_t msg_len)
+{
+	doca_error_t result;
+
+	if (bench->mode == SEND_MODE_INLINE) {
+		while ((result = rdma_inline_send(side->sender, side->endpoint.connections[0], side->msg, msg_len)) ==
+		       DOCA_ERROR_AGAIN)
+			(void)doca_pe_progress(bench->pe);
+		return result;
+	}
+
+	while (side->num_inflight == NUM_SEND_TASKS)
+		(void)doca_pe_progress(bench->pe);
+
+	result = send_msg(side->endpoint.rdma,
+			  side->endpoint.connections[0],
+			  side->msg_mmap,
+			  side->inventory,
+			  side->msg,
+			  msg_len,
+			  side,
+			  NULL);
+	if (result != DOCA_SUCCESS)
+		return result;
+	side->num_inflight++;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Wait for the next message on a side and release it
+ *
+ * @bench [in]: benchmark state
+ * @side [in]: receiving side
+ * @msg_len [in]: expected message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t side_receive(struct inline_send_bench *bench, struct pingpong_side *side, uint32_t msg_len)
+{
+	uint64_t deadline_ns = 0, num_polls = 0;
+	struct rdma_recv_msg msg;
+	doca_error_t result;
+
+	while (!rdma_recv_ring_poll(side->ring, &msg)) {
+		result = progress(bench);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if ((++num_polls % TIME_CHECK_INTERVAL) != 0)
+			continue;
+		if (deadline_ns == 0)
+			deadline_ns = bench_get_time_ns() + WAIT_TIMEOUT_NS;
+		else if (bench_get_time_ns() >= deadline_ns) {
+			DOCA_LOG_ERR("Timed out waiting for a %u bytes message", msg_len);
+			return DOCA_ERROR_TIME_OUT;
+		}
+	}
+
+	rdma_recv_ring_release(side->ring, &msg);
+	if (msg.len != msg_len) {
+		DOCA_LOG_ERR("Received %u bytes instead of %u", msg.len, msg_len);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Compare two samples for qsort()
+ *
+ * @a [in]: first sample
+ * @b [in]: second sample
+ * @return: negative, zero or positive like memcmp()
+ */
+static int compare_samples(const void *a, const void *b)
+{
+	uint64_t first = *(const uint64_t *)a, second = *(const uint64_t *)b;
+
+	return (first > second) - (first < second);
+}
+
+/*
+ * Ping-pong messages of one size and compute the percentiles of the half round trip time
+ *
+ * @bench [in]: benchmark state
+ * @msg_len [in]: message length
+ * @result_out [out]: latency percentiles
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_size(struct inline_send_bench *bench, uint32_t msg_len, struct latency_result *result_out)
+{
+	struct pingpong_side *ping = &bench->sides[0], *pong = &bench->sides[1];
+	uint32_t i, n = bench->iterations;
+	uint64_t start_ns;
+	doca_error_t result;
+
+	for (i = 0; i < WARMUP_ITERATIONS + n; i++) {
+		start_ns = bench_get_time_ns();
+
+		result = side_send(bench, ping, msg_len);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = side_receive(bench, pong, msg_len);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = side_send(bench, pong, msg_len);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = side_receive(bench, ping, msg_len);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		if (i >= WARMUP_ITERATIONS)
+			bench->samples[i - WARMUP_ITERATIONS] = (bench_get_time_ns() - start_ns) / 2;
+	}
+
+	if (ping->first_encountered_error != DOCA_SUCCESS)
+		return ping->first_encountered_error;
+	if (pong->first_encountered_error != DOCA_SUCCESS)
+		return pong->first_encountered_error;
+
+	qsort(bench->samples, n, sizeof(*bench->samples), compare_samples);
+	result_out->p50 = bench->samples[(uint64_t)(n - 1) * 500 / 1000];
+	result_out->p99 = bench->samples[(uint64_t)(n - 1) * 990 / 1000];
+	result_out->p999 = bench->samples[(uint64_t)(n - 1) * 999 / 1000];
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Create the endpoint, receive ring and send path of one side
+ *
+ * @bench [in]: benchmark state
+ * @side [in]: side to create
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t create_side(struct inline_send_bench *bench, struct pingpong_side *side)
+{
+	struct rdma_bench_endpoint_attr attr = {0};
+	struct rdma_recv_ring_attr ring_attr = {0};
+	struct rdma_inline_send_attr send_attr = {0};
+	doca_error_t result;
+
+	side->first_encountered_error = DOCA_SUCCESS;
+
+	attr.num_connections = 1;
+	attr.transport_type = bench->cfg->rdma.transport_type;
+	attr.is_gid_index_set = bench->cfg->rdma.is_gid_index_set;
+	attr.gid_index = bench->cfg->rdma.gid_index;
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	/* The inline sender sizes the send queue, the receive ring sizes the receive queue */
+	attr.send_queue_size = bench->mode == SEND_MODE_INLINE ? 0 : NUM_SEND_TASKS;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &side->endpoint);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	ring_attr.num_slots = RING_NUM_SLOTS;
+	ring_attr.num_posted = RING_NUM_POSTED;
+	ring_attr.slot_size = bench->max_msg_size;
+	result = rdma_recv_ring_create(bench->dev, side->endpoint.rdma, &ring_attr, &side->ring);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	side->msg = malloc(bench->max_msg_size);
+	if (side->msg == NULL) {
+		DOCA_LOG_ERR("Failed to allocate message buffer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(side->msg, 0x5A, bench->max_msg_size);
+
+	if (bench->mode == SEND_MODE_INLINE) {
+		send_attr.num_slots = NUM_SEND_TASKS;
+		send_attr.threshold = bench->max_msg_size;
+		return rdma_inline_sender_create(bench->dev, side->endpoint.rdma, &send_attr, &side->sender);
+	}
+
+	result = doca_rdma_task_send_set_conf(side->endpoint.rdma,
+					      registered_send_completed_callback,
+					      registered_send_error_callback,
+					      NUM_SEND_TASKS);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA send task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = create_local_mmap(&side->msg_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   side->msg,
+				   bench->max_msg_size,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_create(NUM_SEND_TASKS, &side->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(side->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Wait for the sends of a side to complete and destroy it
+ *
+ * @bench [in]: benchmark state
+ * @side [in]: side to destroy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_side(struct inline_send_bench *bench, struct pingpong_side *side)
+{
+	uint64_t deadline_ns = bench_get_time_ns() + WAIT_TIMEOUT_NS;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (side->endpoint.ctx != NULL) {
+		while ((side->num_inflight > 0 ||
+			(side->sender != NULL && rdma_inline_send_get_num_inflight(side->sender) > 0)) &&
+		       bench_get_time_ns() < deadline_ns)
+			(void)doca_pe_progress(bench->pe);
+	}
+
+	/* Send tasks must be freed before the context stops, posted receive tasks are flushed while it stops */
+	tmp_result = rdma_inline_sender_destroy(side->sender);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	if (side->ring != NULL)
+		rdma_recv_ring_stop(side->ring);
+	tmp_result = rdma_bench_endpoint_destroy(bench->pe, &side->endpoint);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_recv_ring_destroy(side->ring);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+
+	if (side->inventory != NULL) {
+		(void)doca_buf_inventory_stop(side->inventory);
+		(void)doca_buf_inventory_destroy(side->inventory);
+	}
+	if (side->msg_mmap != NULL) {
+		(void)doca_mmap_stop(side->msg_mmap);
+		(void)doca_mmap_destroy(side->msg_mmap);
+	}
+	free(side->msg);
+
+	memset(side, 0, sizeof(*side));
+	return result;
+}
+
+/*
+ * Connect two fresh sides with the given send path and measure every message size
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: send path to measure
+ * @sizes [in]: message sizes
+ * @num_sizes [in]: number of message sizes
+ * @results [out]: latency percentiles per message size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_mode(struct inline_send_bench *bench,
+			     enum send_mode mode,
+			     const uint32_t *sizes,
+			     uint32_t num_sizes,
+			     struct latency_result *results)
+{
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	bench->mode = mode;
+
+	for (i = 0; i < 2; i++) {
+		result = create_side(bench, &bench->sides[i]);
+		if (result != DOCA_SUCCESS)
+			goto destroy_sides;
+	}
+
+	for (i = 0; i < 2; i++) {
+		result = rdma_bench_endpoint_start(bench->pe, &bench->sides[i].endpoint);
+		if (result != DOCA_SUCCESS)
+			goto destroy_sides;
+	}
+
+	result = rdma_bench_connect_loopback(&bench->sides[0].endpoint, &bench->sides[1].endpoint, 1);
+	if (result != DOCA_SUCCESS)
+		goto destroy_sides;
+
+	for (i = 0; i < 2; i++) {
+		result = rdma_recv_ring_start(bench->sides[i].ring);
+		if (result != DOCA_SUCCESS)
+			goto destroy_sides;
+		if (mode == SEND_MODE_INLINE) {
+			result = rdma_inline_sender_start(bench->sides[i].sender,
+							  bench->sides[i].endpoint.connections[0]);
+			if (result != DOCA_SUCCESS)
+				goto destroy_sides;
+		}
+	}
+
+	for (i = 0; i < num_sizes; i++) {
+		result = run_size(bench, sizes[i], &results[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Ping-pong of %u bytes with the %s path failed: %s",
+				     sizes[i],
+				     send_mode_names[mode],
+				     doca_error_get_descr(result));
+			goto destroy_sides;
+		}
+	}
+
+destroy_sides:
+	for (i = 0; i < 2; i++) {
+		tmp_result = destroy_side(bench, &bench->sides[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
+
+/*
+ * Measure the send latency of small messages through send_msg() and through the inline sender, using ping-pong
+ * over a NIC loopback connection, and report p50/p99/p99.9 of the half round trip time
+ *
+ * @cfg [in]: Configuration parameters, msg_size is the largest message of the sweep
+ * @iterations [in]: number of sampled round trips per message size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_inline_send_bench(struct rdma_bench_config *cfg, uint32_t iterations)
+{
+	struct inline_send_bench bench = {0};
+	struct latency_result results[SEND_MODE_NUM][MAX_NUM_SIZES] = {0};
+	uint32_t sizes[MAX_NUM_SIZES], num_sizes = 0, size, i;
+	doca_error_t result, tmp_result;
+	enum send_mode mode;
+
+	bench.cfg = cfg;
+	bench.iterations = iterations;
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_send_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = rdma_inline_send_get_threshold(doca_dev_as_devinfo(bench.dev), cfg->msg_size, &bench.max_msg_size);
+	if (result != DOCA_SUCCESS)
+		goto close_dev;
+	if (bench.max_msg_size < cfg->msg_size)
+		DOCA_LOG_WARN("Largest message reduced from %u to the inline threshold of %u bytes",
+			      cfg->msg_size,
+			      bench.max_msg_size);
+
+	for (size = MIN_MSG_SIZE; size <= bench.max_msg_size && num_sizes < MAX_NUM_SIZES; size *= 2)
+		sizes[num_sizes++] = size;
+	if (num_sizes == 0) {
+		DOCA_LOG_ERR("Largest message must be at least %u bytes", MIN_MSG_SIZE);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto close_dev;
+	}
+
+	bench.samples = malloc((size_t)iterations * sizeof(*bench.samples));
+	if (bench.samples == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %u latency samples", iterations);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto close_dev;
+	}
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto free_samples;
+	}
+
+	for (mode = SEND_MODE_REGISTERED; mode < SEND_MODE_NUM; mode++) {
+		result = run_mode(&bench, mode, sizes, num_sizes, results[mode]);
+		if (result != DOCA_SUCCESS)
+			goto destroy_pe;
+	}
+
+	DOCA_LOG_INFO("Half round trip latency over %u ping-pongs per size, in microseconds", iterations);
+	DOCA_LOG_INFO("%8s | %27s | %27s | %8s", "", "registered (send_msg)", "inline (bounce ring)", "");
+	DOCA_LOG_INFO("%8s | %8s %8s %9s | %8s %8s %9s | %8s",
+		      "size",
+		      "p50",
+		      "p99",
+		      "p99.9",
+		      "p50",
+		      "p99",
+		      "p99.9",
+		      "p50 gain");
+	for (i = 0; i < num_sizes; i++) {
+		const struct latency_result *reg = &results[SEND_MODE_REGISTERED][i];
+		const struct latency_result *inl = &results[SEND_MODE_INLINE][i];
+
+		DOCA_LOG_INFO("%8u | %8.2f %8.2f %9.2f | %8.2f %8.2f %9.2f | %7.1f%%",
+			      sizes[i],
+			      reg->p50 / 1000.0,
+			      reg->p99 / 1000.0,
+			      reg->p999 / 1000.0,
+			      inl->p50 / 1000.0,
+			      inl->p99 / 1000.0,
+			      inl->p999 / 1000.0,
+			      reg->p50 == 0 ? 0.0 : 100.0 * ((double)reg->p50 - (double)inl->p50) / (double)reg->p50);
+	}
+
+destroy_pe:
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_samples:
+	free(bench.samples);
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
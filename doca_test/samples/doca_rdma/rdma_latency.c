@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <doca_log.h>
+
+#include "bench_common.h"
+#include "rdma_latency.h"
+
+DOCA_LOG_REGISTER(RDMA::LATENCY);
+
+#define HASH_MULTIPLIER (0x9E3779B97F4A7C15ULL) /* 2^64 / golden ratio, Fibonacci hashing */
+
+/* JSON names of the task types */
+static const char *const task_names[RDMA_LATENCY_TASK_NUM] = {
+	"send",
+	"send_imm",
+	"receive",
+	"write",
+	"write_imm",
+	"read",
+	"atomic_cmp_swp",
+	"atomic_fetch_add",
+	"sync_event_get",
+	"sync_event_set",
+	"sync_event_add",
+};
+
+/*
+ * Get the smallest power of two exponent covering twice a number of entries, so that tables stay half empty
+ *
+ * @num_entries [in]: number of entries
+ * @return: log2 of the table size
+ */
+static uint32_t table_bits(uint32_t num_entries)
+{
+	uint32_t bits = 1;
+
+	while ((1ULL << bits) < 2ULL * num_entries)
+		bits++;
+	return bits;
+}
+
+/*
+ * Get the home slot of a task in the stamps table
+ *
+ * @recorder [in]: the recorder
+ * @task [in]: the task
+ * @return: slot index
+ */
+static inline uint32_t stamp_slot(const struct rdma_latency_recorder *recorder, const struct doca_task *task)
+{
+	return (uint32_t)(((uint64_t)(uintptr_t)task * HASH_MULTIPLIER) >> (64 - recorder->stamp_bits));
+}
+
+/*
+ * Get the home slot of a series in the series index
+ *
+ * @recorder [in]: the recorder
+ * @type [in]: task type
+ * @connection [in]: connection index
+ * @bytes [in]: message size
+ * @return: slot index
+ */
+static inline uint32_t series_slot(const struct rdma_latency_recorder *recorder,
+				   enum rdma_latency_task_type type,
+				   uint32_t connection,
+				   uint64_t bytes)
+{
+	uint64_t key = (bytes * HASH_MULTIPLIER) ^ (((uint64_t)type << 32) | connection);
+
+	return (uint32_t)((key * HASH_MULTIPLIER) >> (64 - recorder->series_index_bits));
+}
+
+doca_error_t rdma_latency_recorder_create(uint32_t max_series,
+					  uint32_t max_inflight,
+					  struct rdma_latency_recorder **recorder)
+{
+	struct rdma_latency_recorder *rec;
+
+	if (max_series == 0 || max_inflight == 0) {
+		DOCA_LOG_ERR("Latency recorder needs at least one series and one task in flight");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	rec = calloc(1, sizeof(*rec));
+	if (rec == NULL) {
+		DOCA_LOG_ERR("Failed to allocate latency recorder");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	rec->stamp_bits = table_bits(max_inflight);
+	rec->max_stamps = max_inflight;
+	rec->series_index_bits = table_bits(max_series);
+	rec->max_series = max_series;
+	rec->stamps = calloc(1ULL << rec->stamp_bits, sizeof(*rec->stamps));
+	rec->series = calloc(max_series, sizeof(*rec->series));
+	rec->series_index = calloc(1ULL << rec->series_index_bits, sizeof(*rec->series_index));
+	if (rec->stamps == NULL || rec->series == NULL || rec->series_index == NULL) {
+		DOCA_LOG_ERR("Failed to allocate latency recorder tables for %u series and %u tasks",
+			     max_series,
+			     max_inflight);
+		rdma_latency_recorder_destroy(rec);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	*recorder = rec;
+	return DOCA_SUCCESS;
+}
+
+void rdma_latency_recorder_destroy(struct rdma_latency_recorder *recorder)
+{
+	if (recorder == NULL)
+		return;
+	free(recorder->series_index);
+	free(recorder->series);
+	free(recorder->stamps);
+	free(recorder);
+}
+
+void rdma_latency_task_submitted(struct rdma_latency_recorder *recorder, const struct doca_task *task)
+{
+	uint32_t mask, slot;
+
+	if (recorder == NULL)
+		return;
+
+	mask = (1U << recorder->stamp_bits) - 1;
+	for (slot = stamp_slot(recorder, task); recorder->stamps[slot].task != NULL; slot = (slot + 1) & mask) {
+		/* A task resubmitted from its completion callback before it was recorded */
+		if (recorder->stamps[slot].task == task) {
+			recorder->stamps[slot].submit_ns = bench_get_time_ns();
+			return;
+		}
+	}
+	if (recorder->num_stamps == recorder->max_stamps) {
+		recorder->num_dropped++;
+		return;
+	}
+
+	recorder->stamps[slot].task = task;
+	recorder->stamps[slot].submit_ns = bench_get_time_ns();
+	recorder->num_stamps++;
+}
+
+/*
+ * Remove the stamp of a task
+ *
+ * @recorder [in]: the recorder
+ * @task [in]: the task
+ * @submit_ns [out]: submit time of the task
+ * @return: true if the task was stamped
+ */
+static bool take_stamp(struct rdma_latency_recorder *recorder, const struct doca_task *task, uint64_t *submit_ns)
+{
+	const uint32_t mask = (1U << recorder->stamp_bits) - 1;
+	uint32_t hole, slot, home;
+
+	for (hole = stamp_slot(recorder, task); recorder->stamps[hole].task != task; hole = (hole + 1) & mask)
+		if (recorder->stamps[hole].task == NULL)
+			return false;
+	*submit_ns = recorder->stamps[hole].submit_ns;
+
+	/* Backward shift deletion: move back every following entry whose home slot is not between the hole and it */
+	for (slot = (hole + 1) & mask; recorder->stamps[slot].task != NULL; slot = (slot + 1) & mask) {
+		home = stamp_slot(recorder, recorder->stamps[slot].task);
+		if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+			recorder->stamps[hole] = recorder->stamps[slot];
+			hole = slot;
+		}
+	}
+	recorder->stamps[hole].task = NULL;
+	recorder->num_stamps--;
+
+	return true;
+}
+
+void rdma_latency_task_completed(struct rdma_latency_recorder *recorder,
+				 const struct doca_task *task,
+				 enum rdma_latency_task_type type,
+				 const struct doca_rdma_connection *connection,
+				 uint64_t bytes)
+{
+	uint64_t now_ns, submit_ns;
+
+	if (recorder == NULL)
+		return;
+
+	now_ns = bench_get_time_ns();
+	if (!take_stamp(recorder, task, &submit_ns)) {
+		recorder->num_dropped++;
+		return;
+	}
+	rdma_latency_record(recorder, type, rdma_latency_connection_id(connection), bytes, now_ns - submit_ns);
+}
+
+void rdma_latency_task_failed(struct rdma_latency_recorder *recorder, const struct doca_task *task)
+{
+	uint64_t submit_ns;
+
+	if (recorder == NULL)
+		return;
+	(void)take_stamp(recorder, task, &submit_ns);
+}
+
+void rdma_latency_record(struct rdma_latency_recorder *recorder,
+			 enum rdma_latency_task_type type,
+			 uint32_t connection,
+			 uint64_t bytes,
+			 uint64_t latency_ns)
+{
+	struct rdma_latency_series *series;
+	uint32_t mask, slot, index;
+
+	if (recorder == NULL)
+		return;
+
+	mask = (1U << recorder->series_index_bits) - 1;
+	for (slot = series_slot(recorder, type, connection, bytes); recorder->series_index[slot] != 0;
+	     slot = (slot + 1) & mask) {
+		series = &recorder->series[recorder->series_index[slot] - 1];
+		if (series->type == type && series->connection == connection && series->bytes == bytes) {
+			latency_hist_record(&series->hist, latency_ns);
+			return;
+		}
+	}
+	if (recorder->num_series == recorder->max_series) {
+		recorder->num_dropped++;
+		return;
+	}
+
+	index = recorder->num_series++;
+	series = &recorder->series[index];
+	series->type = type;
+	series->connection = connection;
+	series->bytes = bytes;
+	latency_hist_init(&series->hist);
+	latency_hist_record(&series->hist, latency_ns);
+	recorder->series_index[slot] = index + 1;
+}
+
+uint32_t rdma_latency_connection_id(const struct doca_rdma_connection *connection)
+{
+	uint32_t connection_id = 0;
+
+	if (connection == NULL || doca_rdma_connection_get_id(connection, &connection_id) != DOCA_SUCCESS)
+		return 0;
+	return connection_id;
+}
+
+uint64_t rdma_latency_buf_len(const struct doca_buf *buf)
+{
+	size_t data_len = 0;
+
+	if (buf == NULL || doca_buf_get_data_len(buf, &data_len) != DOCA_SUCCESS)
+		return 0;
+	return data_len;
+}
+
+void rdma_latency_report(const struct rdma_latency_recorder *recorder)
+{
+	const struct rdma_latency_series *series;
+	uint32_t i;
+
+	if (recorder == NULL)
+		return;
+
+	for (i = 0; i < recorder->num_series; i++) {
+		series = &recorder->series[i];
+		DOCA_LOG_INFO("%-16s conn %-3u %9lu B: %9lu tasks, p50 %.2f, p99 %.2f, p99.9 %.2f, max %.2f us",
+			      task_names[series->type],
+			      series->connection,
+			      series->bytes,
+			      series->hist.count,
+			      latency_hist_percentile(&series->hist, 50.0) / 1000.0,
+			      latency_hist_percentile(&series->hist, 99.0) / 1000.0,
+			      latency_hist_percentile(&series->hist, 99.9) / 1000.0,
+			      series->hist.max / 1000.0);
+	}
+	if (recorder->num_dropped > 0)
+		DOCA_LOG_WARN("%lu latencies were not recorded, the recorder tables were too small",
+			      recorder->num_dropped);
+}
+
+/*
+ * Write the entries of every (task type, message size) pair, all connections merged
+ *
+ * @recorder [in]: the recorder
+ * @fp [in]: file to write to
+ * @first [in/out]: true until the first entry of the array was written
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t write_merged_entries(const struct rdma_latency_recorder *recorder, FILE *fp, bool *first)
+{
+	const struct rdma_latency_series *series, *other;
+	struct latency_hist *merged;
+	char type[64];
+	uint32_t i, j;
+
+	merged = malloc(sizeof(*merged));
+	if (merged == NULL) {
+		DOCA_LOG_ERR("Failed to allocate latency histogram");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (i = 0; i < recorder->num_series; i++) {
+		series = &recorder->series[i];
+		/* Every pair is written at its first series */
+		for (j = 0; j < i; j++)
+			if (recorder->series[j].type == series->type && recorder->series[j].bytes == series->bytes)
+				break;
+		if (j < i)
+			continue;
+
+		latency_hist_init(merged);
+		for (j = i; j < recorder->num_series; j++) {
+			other = &recorder->series[j];
+			if (other->type == series->type && other->bytes == series->bytes)
+				latency_hist_merge(merged, &other->hist);
+		}
+		snprintf(type, sizeof(type), "doca_rdma_%s_lat", task_names[series->type]);
+		fprintf(fp, "%s", *first ? "" : ",\n");
+		latency_hist_write_json(fp, type, series->bytes, merged, 4);
+		*first = false;
+	}
+
+	free(merged);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_latency_export_json(const struct rdma_latency_recorder *recorder, const char *path)
+{
+	const struct rdma_latency_series *series;
+	bool first = true, multi_connection = false;
+	doca_error_t result;
+	char type[64];
+	uint32_t i;
+	FILE *fp;
+
+	if (recorder == NULL)
+		return DOCA_SUCCESS;
+
+	fp = fopen(path, "w");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s for writing", path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fprintf(fp, "{\n  \"bandwidth\": [],\n  \"latency\": [\n");
+	result = write_merged_entries(recorder, fp, &first);
+
+	for (i = 0; i < recorder->num_series; i++)
+		if (recorder->series[i].connection != 0)
+			multi_connection = true;
+	for (i = 0; i < recorder->num_series && multi_connection && result == DOCA_SUCCESS; i++) {
+		series = &recorder->series[i];
+		snprintf(type, sizeof(type), "doca_rdma_%s_lat_conn%u", task_names[series->type], series->connection);
+		fprintf(fp, "%s", first ? "" : ",\n");
+		latency_hist_write_json(fp, type, series->bytes, &series->hist, 4);
+		first = false;
+	}
+	fprintf(fp, "\n  ]\n}\n");
+
+	if (fclose(fp) != 0 && result == DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to write %s", path);
+		result = DOCA_ERROR_IO_FAILED;
+	}
+	if (result == DOCA_SUCCESS)
+		DOCA_LOG_INFO("Latency histograms of %u series written to %s", recorder->num_series, path);
+	return result;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_LATENCY_H_
+#define RDMA_LATENCY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_buf.h>
+#include <doca_error.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "latency_hist.h"
+
+/*
+ * Latency recorder of DOCA RDMA tasks.
+ *
+ * A task is stamped when it is submitted and its latency is recorded when its completion callback runs, into a
+ * histogram per (task type, connection, message size) series. Both tables are sized at creation: submit stamps are
+ * kept in an open addressing table keyed by the task pointer, and series in a hash table of at most max_series
+ * histograms, so stamping and recording cost O(1) and never allocate. Stamps or series that do not fit are counted
+ * as dropped instead of failing the data path.
+ *
+ * The latency of a receive is the time from posting it to its completion, which includes the wait for the peer.
+ *
+ * Every function accepts a NULL recorder and then does nothing, so that the samples call them unconditionally.
+ */
+
+#define RDMA_LATENCY_DEFAULT_MAX_SERIES (64)	/* Default number of series of a recorder */
+#define RDMA_LATENCY_DEFAULT_MAX_INFLIGHT (4096) /* Default number of tasks stamped at once */
+
+/* Recorded task types */
+enum rdma_latency_task_type {
+	RDMA_LATENCY_TASK_SEND,		      /* Send */
+	RDMA_LATENCY_TASK_SEND_IMM,	      /* Send with immediate */
+	RDMA_LATENCY_TASK_RECEIVE,	      /* Receive */
+	RDMA_LATENCY_TASK_WRITE,	      /* RDMA write */
+	RDMA_LATENCY_TASK_WRITE_IMM,	      /* RDMA write with immediate */
+	RDMA_LATENCY_TASK_READ,		      /* RDMA read */
+	RDMA_LATENCY_TASK_ATOMIC_CMP_SWP,     /* Atomic compare and swap */
+	RDMA_LATENCY_TASK_ATOMIC_FETCH_ADD,   /* Atomic fetch and add */
+	RDMA_LATENCY_TASK_SYNC_EVENT_GET,     /* Remote sync event get */
+	RDMA_LATENCY_TASK_SYNC_EVENT_SET,     /* Remote sync event notify set */
+	RDMA_LATENCY_TASK_SYNC_EVENT_ADD,     /* Remote sync event notify add */
+	RDMA_LATENCY_TASK_NUM,
+};
+
+/* Submit time of an outstanding task */
+struct rdma_latency_stamp {
+	const struct doca_task *task; /* Task, NULL for a free entry */
+	uint64_t submit_ns;	      /* Submit time */
+};
+
+/* Latencies of one task type, connection and message size */
+struct rdma_latency_series {
+	enum rdma_latency_task_type type; /* Task type */
+	uint32_t connection;		  /* Connection index */
+	uint64_t bytes;			  /* Message size */
+	struct latency_hist hist;	  /* Latencies */
+};
+
+struct rdma_latency_recorder {
+	struct rdma_latency_stamp *stamps;  /* Submit stamps, open addressing with linear probing */
+	uint32_t stamp_bits;		    /* log2 of the stamps table size */
+	uint32_t num_stamps;		    /* Number of outstanding stamps */
+	uint32_t max_stamps;		    /* Maximum number of outstanding stamps, half of the table */
+	struct rdma_latency_series *series; /* Series, in creation order */
+	uint32_t num_series;		    /* Number of series */
+	uint32_t max_series;		    /* Capacity of series */
+	uint32_t *series_index;		    /* Hash table of series index + 1, 0 for a free entry */
+	uint32_t series_index_bits;	    /* log2 of the series_index table size */
+	uint64_t num_dropped;		    /* Latencies lost to a full table or a missing stamp */
+};
+
+/*
+ * Create a latency recorder
+ *
+ * @max_series [in]: maximum number of (task type, connection, message size) series
+ * @max_inflight [in]: maximum number of tasks stamped at once
+ * @recorder [out]: the created recorder
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_latency_recorder_create(uint32_t max_series,
+					  uint32_t max_inflight,
+					  struct rdma_latency_recorder **recorder);
+
+/*
+ * Destroy a latency recorder
+ *
+ * @recorder [in]: the recorder, may be NULL
+ */
+void rdma_latency_recorder_destroy(struct rdma_latency_recorder *recorder);
+
+/*
+ * Stamp a task with the current time, call it right before doca_task_submit()
+ *
+ * @recorder [in]: the recorder, may be NULL
+ * @task [in]: the task
+ */
+void rdma_latency_task_submitted(struct rdma_latency_recorder *recorder, const struct doca_task *task);
+
+/*
+ * Record the latency of a completed task, call it from the completion callback before the task is freed
+ *
+ * @recorder [in]: the recorder, may be NULL
+ * @task [in]: the task, stamped by rdma_latency_task_submitted()
+ * @type [in]: task type
+ * @connection [in]: connection of the task, from its get_rdma_connection() getter, may be NULL
+ * @bytes [in]: message size
+ */
+void rdma_latency_task_completed(struct rdma_latency_recorder *recorder,
+				 const struct doca_task *task,
+				 enum rdma_latency_task_type type,
+				 const struct doca_rdma_connection *connection,
+				 uint64_t bytes);
+
+/*
+ * Forget the stamp of a failed task, call it from the error callback before the task is freed
+ *
+ * @recorder [in]: the recorder, may be NULL
+ * @task [in]: the task
+ */
+void rdma_latency_task_failed(struct rdma_latency_recorder *recorder, const struct doca_task *task);
+
+/*
+ * Record a latency measured by the caller
+ *
+ * @recorder [in]: the recorder, may be NULL
+ * @type [in]: task type
+ * @connection [in]: index of the connection
+ * @bytes [in]: message size
+ * @latency_ns [in]: latency
+ */
+void rdma_latency_record(struct rdma_latency_recorder *recorder,
+			 enum rdma_latency_task_type type,
+			 uint32_t connection,
+			 uint64_t bytes,
+			 uint64_t latency_ns);
+
+/*
+ * Get the index of a connection for the series
+ *
+ * @connection [in]: the connection, may be NULL
+ * @return: the DOCA connection ID, 0 if it is unknown
+ */
+uint32_t rdma_latency_connection_id(const struct doca_rdma_connection *connection);
+
+/*
+ * Get the size of a series, from the data length of the task's source or destination buffer
+ *
+ * @buf [in]: the buffer, may be NULL
+ * @return: the buffer data length, 0 if it is unknown
+ */
+uint64_t rdma_latency_buf_len(const struct doca_buf *buf);
+
+/*
+ * Log count, median, p99, p99.9 and maximum of every series
+ *
+ * @recorder [in]: the recorder, may be NULL
+ */
+void rdma_latency_report(const struct rdma_latency_recorder *recorder);
+
+/*
+ * Write the series as a JSON file in the schema of rdma_results.json, so that get_result.py plots them next to the
+ * perftest results. Every (task type, message size) gets an entry of type "doca_rdma_<task>_lat" merging all
+ * connections; when more than one connection was recorded, every connection also gets its own entry of type
+ * "doca_rdma_<task>_lat_conn<index>". The "bandwidth" array is left empty.
+ *
+ * @recorder [in]: the recorder, may be NULL
+ * @path [in]: file to write
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_latency_export_json(const struct rdma_latency_recorder *recorder, const char *path);
+
+#endif /* RDMA_LATENCY_H_ */
@@ -40,6 +40,7 @@ DOCA_LOG_REGISTER(RDMA_MULTI_CONN_RECEIVE::SAMPLE);
  * Write the connection details for the sender to read, and read the connection details of the sender
  * To differentiate each local and remote connection details, we append the connection_id so the file-name
  * follows the syntax <local/remote>_connection_desc_path.txt-<connection_id>
+ * In DC transport mode it is only needed to write the local connection details
  *
  * @cfg [in]: Configuration parameters
  * @resources [in/out]: RDMA resources
@@ -65,6 +66,9 @@ static doca_error_t write_read_connection(struct rdma_config *cfg,
 
 	DOCA_LOG_INFO("You can now copy %s to the sender", tmp_file_path);
 
+	if (cfg->transport_type == DOCA_RDMA_TRANSPORT_TYPE_DC)
+		return result;
+
 	memset(tmp_file_path, 0, sizeof(tmp_file_path));
 	sprintf(tmp_file_path, "%s-%04u", cfg->remote_connection_desc_path, connection_id);
 	DOCA_LOG_INFO("Please copy %s from the sender and then press enter", tmp_file_path);
@@ -100,6 +104,12 @@ static void rdma_multi_conn_receive_completed_callback(struct doca_rdma_task_rec
 	const struct doca_rdma_connection *rdma_connection;
 	struct doca_buf *dst_buf = NULL;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_receive_as_task(rdma_receive_task),
+				    RDMA_LATENCY_TASK_RECEIVE,
+				    doca_rdma_task_receive_get_result_rdma_connection(rdma_receive_task),
+				    rdma_latency_buf_len(doca_rdma_task_receive_get_dst_buf(rdma_receive_task)));
+
 	DOCA_LOG_INFO("RDMA receive task was done successfully");
 
 	/* Read the data that was received */
@@ -166,6 +176,7 @@ static void rdma_multi_conn_receive_error_callback(struct doca_rdma_task_receive
 	if (result != DOCA_SUCCESS)
 		DOCA_LOG_ERR("Failed to decrease dst_buf count: %s", doca_error_get_descr(result));
 
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 	resources->num_remaining_tasks--;
 	/* Stop context once all tasks are completed */
@@ -208,6 +219,12 @@ static doca_error_t rdma_multi_conn_receive_export_and_connect(struct rdma_resou
 			return result;
 		}
 
+		/* In DC transport mode only the sender connects, to the target exported here */
+		if (resources->cfg->transport_type == DOCA_RDMA_TRANSPORT_TYPE_DC) {
+			DOCA_LOG_INFO("RDMA DC target [%d] is exported", i);
+			continue;
+		}
+
 		/* Connect RDMA */
 		result = doca_rdma_connect(resources->rdma,
 					   resources->remote_rdma_conn_descriptor,
@@ -271,9 +288,12 @@ static doca_error_t rdma_multi_conn_receive_prepare_and_submit_task(struct rdma_
 		/* Submit RDMA receive task */
 		DOCA_LOG_INFO("Submitting RDMA receive task [%d]", i);
 		resources->num_remaining_tasks++;
+		rdma_latency_task_submitted(resources->latency, doca_rdma_task_receive_as_task(rdma_receive_tasks[i]));
 		result = doca_task_submit(doca_rdma_task_receive_as_task(rdma_receive_tasks[i]));
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to submit RDMA receive task [%d]: %s", i, doca_error_get_descr(result));
+			rdma_latency_task_failed(resources->latency,
+						 doca_rdma_task_receive_as_task(rdma_receive_tasks[i]));
 			goto free_task;
 		}
 		DOCA_LOG_INFO("RDMA receive task [%d] successfully submitted", i);
@@ -39,6 +39,7 @@ DOCA_LOG_REGISTER(RDMA_MULI_CONN_SEND::SAMPLE);
  * Write the connection details for the receiver to read, and read the connection details of the receiver
  * To differentiate each local and remote connection details, we append the connection_id so the file-name
  * follows the syntax <local/remote>_connection_desc_path.txt-<connection_id>
+ * In DC transport mode it is only needed to read the remote connection details
  *
  * @cfg [in]: Configuration parameters
  * @resources [in/out]: RDMA resources
@@ -51,18 +52,20 @@ static doca_error_t write_read_connection(struct rdma_config *cfg,
 	doca_error_t result = DOCA_SUCCESS;
 	char tmp_file_path[MAX_ARG_SIZE * 2];
 
-	/* Write the RDMA connection details */
-	memset(tmp_file_path, 0, MAX_ARG_SIZE + 4);
-	sprintf(tmp_file_path, "%s-%04u", cfg->local_connection_desc_path, connection_id);
-	result = write_file(tmp_file_path,
-			    (char *)resources->rdma_conn_descriptor,
-			    resources->rdma_conn_descriptor_size);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to write the RDMA connection details: %s", doca_error_get_descr(result));
-		return result;
-	}
+	if (cfg->transport_type == DOCA_RDMA_TRANSPORT_TYPE_RC) {
+		/* Write the RDMA connection details */
+		memset(tmp_file_path, 0, MAX_ARG_SIZE + 4);
+		sprintf(tmp_file_path, "%s-%04u", cfg->local_connection_desc_path, connection_id);
+		result = write_file(tmp_file_path,
+				    (char *)resources->rdma_conn_descriptor,
+				    resources->rdma_conn_descriptor_size);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to write the RDMA connection details: %s", doca_error_get_descr(result));
+			return result;
+		}
 
-	DOCA_LOG_INFO("You can now copy %s to the receiver", tmp_file_path);
+		DOCA_LOG_INFO("You can now copy %s to the receiver", tmp_file_path);
+	}
 
 	memset(tmp_file_path, 0, MAX_ARG_SIZE + 4);
 	sprintf(tmp_file_path, "%s-%04u", cfg->remote_connection_desc_path, connection_id);
@@ -98,6 +101,12 @@ static void rdma_multi_conn_send_completed_callback(struct doca_rdma_task_send *
 	struct doca_buf *src_buf = NULL;
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_send_as_task(rdma_send_task),
+				    RDMA_LATENCY_TASK_SEND,
+				    doca_rdma_task_send_get_rdma_connection(rdma_send_task),
+				    rdma_latency_buf_len(doca_rdma_task_send_get_src_buf(rdma_send_task)));
+
 	DOCA_LOG_INFO("RDMA send task was done successfully");
 
 	src_buf = (struct doca_buf *)doca_rdma_task_send_get_src_buf(rdma_send_task);
@@ -138,6 +147,7 @@ static void rdma_multi_conn_send_error_callback(struct doca_rdma_task_send *rdma
 	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA send task failed: %s", doca_error_get_descr(result));
 
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 	result = doca_buf_dec_refcount(resources->src_buf, NULL);
 	if (result != DOCA_SUCCESS)
@@ -267,9 +277,11 @@ static doca_error_t rdma_multi_conn_send_prepare_and_submit_task(struct rdma_res
 			resources->cfg->send_string,
 			resources->connections[i]);
 		resources->num_remaining_tasks++;
+		rdma_latency_task_submitted(resources->latency, doca_rdma_task_send_as_task(rdma_send_tasks[i]));
 		result = doca_task_submit(doca_rdma_task_send_as_task(rdma_send_tasks[i]));
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to submit RDMA send task [%d]: %s", i, doca_error_get_descr(result));
+			rdma_latency_task_failed(resources->latency, doca_rdma_task_send_as_task(rdma_send_tasks[i]));
 			goto free_task;
 		}
 	}
@@ -0,0 +1,688 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_MULTI_THREAD_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024)  /* Number of PE progress calls between two deadline checks */
+#define LINEAR_SCALING_RATIO (0.8)  /* Scaling efficiency above which the run is considered CPU (PE) bound */
+#define IDLE_POLL_RATIO_LIMIT (0.5) /* Idle poll ratio above which the workers are waiting for the NIC */
+
+/* State shared by all the workers of a single run */
+struct mt_bench_run {
+	struct rdma_bench_config *cfg; /* Benchmark configuration */
+	struct doca_dev *dev;	       /* DOCA device, shared by all workers */
+	int numa_node;		       /* NUMA node of the device, -1 if unknown */
+	pthread_mutex_t lock;	       /* Protects the start gate */
+	pthread_cond_t cond;	       /* Signals arrivals at the start gate and its opening */
+	uint32_t num_ready;	       /* Workers waiting at the start gate */
+	bool started;		       /* Whether the timed region started, all the workers are set up */
+	bool aborted;		       /* Whether the run was aborted before it started */
+};
+
+/* Per worker state, each worker owns a PE, a pair of RDMA contexts and a slice of the connections */
+struct mt_bench_worker {
+	uint32_t id;				  /* Worker index */
+	uint32_t cpu;				  /* CPU the worker is pinned to */
+	uint32_t num_connections;		  /* Number of connections owned by this worker */
+	struct mt_bench_run *run;		  /* Shared run state */
+	pthread_t thread;			  /* Worker thread */
+	struct doca_pe *pe;			  /* Progress engine of the worker */
+	struct rdma_bench_endpoint requester;	  /* Endpoint submitting the RDMA writes */
+	struct rdma_bench_endpoint responder;	  /* Endpoint the writes are targeted at */
+	char *buffer;				  /* Source and destination memory, allocated on the device NUMA node */
+	size_t buffer_len;			  /* Length of buffer */
+	struct doca_mmap *mmap;			  /* Local mmap of buffer */
+	struct doca_mmap *remote_mmap;		  /* buffer as seen by the requester through the responder */
+	struct doca_buf_inventory *inventory;	  /* Inventory for the task buffers */
+	struct doca_rdma_task_write **tasks;	  /* Write tasks, NULL entries were already released */
+	uint32_t num_tasks;			  /* Number of write tasks */
+	uint32_t num_inflight;			  /* Number of submitted tasks that have not completed yet */
+	bool running;				  /* Whether completed tasks should be resubmitted */
+	uint64_t completed_ops;			  /* Number of completed writes */
+	uint64_t num_polls;			  /* Number of doca_pe_progress() calls in the timed region */
+	uint64_t num_idle_polls;		  /* Number of doca_pe_progress() calls that returned 0 */
+	uint64_t elapsed_ns;			  /* Length of the timed region */
+	doca_error_t result;			  /* First error encountered by the worker */
+};
+
+/* Aggregated result of a run with a given number of workers */
+struct mt_bench_result {
+	uint32_t num_threads; /* Number of workers */
+	double mops;	      /* Aggregated million operations per second */
+	double gbps;	      /* Aggregated throughput in Gbit/s */
+	double idle_ratio;    /* Ratio of PE progress calls that found no completion */
+};
+
+/*
+ * Release a write task and its buffers
+ *
+ * @worker [in]: worker owning the task
+ * @task_idx [in]: task index
+ */
+static void release_write_task(struct mt_bench_worker *worker, uint32_t task_idx)
+{
+	struct doca_rdma_task_write *task = worker->tasks[task_idx];
+	struct doca_buf *src_buf, *dst_buf;
+
+	if (task == NULL)
+		return;
+
+	src_buf = (struct doca_buf *)doca_rdma_task_write_get_src_buf(task);
+	dst_buf = doca_rdma_task_write_get_dst_buf(task);
+	doca_task_free(doca_rdma_task_write_as_task(task));
+	if (src_buf != NULL)
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+	if (dst_buf != NULL)
+		(void)doca_buf_dec_refcount(dst_buf, NULL);
+	worker->tasks[task_idx] = NULL;
+}
+
+/*
+ * RDMA write task completed callback, resubmits the task as long as the run is active
+ *
+ * @rdma_write_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void mt_bench_write_completed_callback(struct doca_rdma_task_write *rdma_write_task,
+					      union doca_data task_user_data,
+					      union doca_data ctx_user_data)
+{
+	struct mt_bench_worker *worker = (struct mt_bench_worker *)ctx_user_data.ptr;
+	doca_error_t result;
+
+	(void)rdma_write_task;
+	worker->completed_ops++;
+
+	if (worker->running) {
+		result = doca_task_submit(doca_rdma_task_write_as_task(rdma_write_task));
+		if (result == DOCA_SUCCESS)
+			return;
+		DOCA_LOG_ERR("Worker %u failed to resubmit RDMA write task: %s",
+			     worker->id,
+			     doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(worker->result, result);
+		worker->running = false;
+	}
+
+	release_write_task(worker, (uint32_t)task_user_data.u64);
+	worker->num_inflight--;
+}
+
+/*
+ * RDMA write task error callback
+ *
+ * @rdma_write_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void mt_bench_write_error_callback(struct doca_rdma_task_write *rdma_write_task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	struct mt_bench_worker *worker = (struct mt_bench_worker *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_write_as_task(rdma_write_task));
+
+	DOCA_LOG_ERR("Worker %u RDMA write task failed: %s", worker->id, doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(worker->result, result);
+	worker->running = false;
+
+	release_write_task(worker, (uint32_t)task_user_data.u64);
+	worker->num_inflight--;
+}
+
+/*
+ * Create the PE, RDMA contexts, connections, memory and tasks of a worker
+ * Called from the worker thread after it has been pinned, so all allocations are local to its CPU
+ *
+ * @worker [in]: worker to set up
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t mt_bench_worker_setup(struct mt_bench_worker *worker)
+{
+	struct rdma_bench_config *cfg = worker->run->cfg;
+	struct rdma_bench_endpoint_attr attr = {0};
+	union doca_data ctx_user_data = {0};
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf, *dst_buf;
+	void *remote_addr;
+	size_t remote_len, slice_len;
+	doca_error_t result;
+	uint32_t i;
+
+	worker->num_tasks = worker->num_connections * cfg->queue_depth;
+	slice_len = (size_t)worker->num_tasks * cfg->msg_size;
+	worker->buffer_len = 2 * slice_len;
+
+	worker->buffer = bench_alloc_numa(worker->buffer_len, worker->run->numa_node);
+	if (worker->buffer == NULL) {
+		DOCA_LOG_ERR("Worker %u failed to allocate %zu bytes", worker->id, worker->buffer_len);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	worker->tasks = calloc(worker->num_tasks, sizeof(*worker->tasks));
+	if (worker->tasks == NULL) {
+		DOCA_LOG_ERR("Worker %u failed to allocate task array", worker->id);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = doca_pe_create(&worker->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %u failed to create PE: %s", worker->id, doca_error_get_descr(result));
+		return result;
+	}
+
+	attr.num_connections = worker->num_connections;
+	attr.send_queue_size = cfg->queue_depth;
+	attr.transport_type = cfg->rdma.transport_type;
+	attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	attr.gid_index = cfg->rdma.gid_index;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(worker->run->dev, worker->pe, &attr, &worker->requester);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	result = rdma_bench_endpoint_create(worker->run->dev, worker->pe, &attr, &worker->responder);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_task_write_set_conf(worker->requester.rdma,
+					       mt_bench_write_completed_callback,
+					       mt_bench_write_error_callback,
+					       worker->num_tasks);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	ctx_user_data.ptr = worker;
+	result = doca_ctx_set_user_data(worker->requester.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = rdma_bench_endpoint_start(worker->pe, &worker->requester);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_endpoint_start(worker->pe, &worker->responder);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_connect_loopback(&worker->requester, &worker->responder, worker->num_connections);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = create_local_mmap(&worker->mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE,
+				   worker->buffer,
+				   worker->buffer_len,
+				   worker->run->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_import_mmap(worker->mmap, worker->run->dev, &worker->remote_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_mmap_get_memrange(worker->remote_mmap, &remote_addr, &remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get remote mmap memory range: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_create(2 * worker->num_tasks, &worker->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(worker->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* The first half of the buffer is the source of the writes, the second half is their destination */
+	for (i = 0; i < worker->num_tasks; i++) {
+		result = doca_buf_inventory_buf_get_by_data(worker->inventory,
+							    worker->mmap,
+							    worker->buffer + (size_t)i * cfg->msg_size,
+							    cfg->msg_size,
+							    &src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate source buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_buf_inventory_buf_get_by_addr(worker->inventory,
+							    worker->remote_mmap,
+							    (char *)remote_addr + slice_len + (size_t)i * cfg->msg_size,
+							    cfg->msg_size,
+							    &dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate destination buffer: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(src_buf, NULL);
+			return result;
+		}
+
+		task_user_data.u64 = i;
+		result = doca_rdma_task_write_allocate_init(worker->requester.rdma,
+							    worker->requester.connections[i % worker->num_connections],
+							    src_buf,
+							    dst_buf,
+							    task_user_data,
+							    &worker->tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA write task: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(dst_buf, NULL);
+			(void)doca_buf_dec_refcount(src_buf, NULL);
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Destroy all the resources of a worker
+ *
+ * @worker [in]: worker to clean up
+ */
+static void mt_bench_worker_cleanup(struct mt_bench_worker *worker)
+{
+	uint32_t i;
+
+	if (worker->tasks != NULL) {
+		for (i = 0; i < worker->num_tasks; i++)
+			release_write_task(worker, i);
+		free(worker->tasks);
+		worker->tasks = NULL;
+	}
+
+	if (worker->inventory != NULL) {
+		(void)doca_buf_inventory_stop(worker->inventory);
+		(void)doca_buf_inventory_destroy(worker->inventory);
+	}
+
+	(void)rdma_bench_endpoint_destroy(worker->pe, &worker->requester);
+	(void)rdma_bench_endpoint_destroy(worker->pe, &worker->responder);
+
+	if (worker->remote_mmap != NULL) {
+		(void)doca_mmap_stop(worker->remote_mmap);
+		(void)doca_mmap_destroy(worker->remote_mmap);
+	}
+
+	if (worker->mmap != NULL) {
+		(void)doca_mmap_stop(worker->mmap);
+		(void)doca_mmap_destroy(worker->mmap);
+	}
+
+	if (worker->pe != NULL)
+		(void)doca_pe_destroy(worker->pe);
+
+	bench_free_numa(worker->buffer, worker->buffer_len);
+}
+
+/*
+ * Run the timed region of a worker: keep queue_depth writes in flight on every connection until the deadline
+ *
+ * @worker [in]: worker to run
+ */
+static void mt_bench_worker_run(struct mt_bench_worker *worker)
+{
+	uint64_t start_ns, deadline_ns;
+	doca_error_t result;
+	uint32_t i;
+
+	worker->running = true;
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)worker->run->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < worker->num_tasks; i++) {
+		result = doca_task_submit(doca_rdma_task_write_as_task(worker->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Worker %u failed to submit RDMA write task: %s",
+				     worker->id,
+				     doca_error_get_descr(result));
+			DOCA_ERROR_PROPAGATE(worker->result, result);
+			worker->running = false;
+			break;
+		}
+		worker->num_inflight++;
+	}
+
+	while (worker->running || worker->num_inflight > 0) {
+		if (doca_pe_progress(worker->pe) == 0)
+			worker->num_idle_polls++;
+		if ((++worker->num_polls % TIME_CHECK_INTERVAL) == 0 && worker->running &&
+		    bench_get_time_ns() >= deadline_ns)
+			worker->running = false;
+	}
+
+	worker->elapsed_ns = bench_get_time_ns() - start_ns;
+}
+
+/*
+ * Wait at the start gate until every worker is set up and the main thread opens it, or aborts the run
+ * Unlike a barrier the gate can be opened with fewer parties, so the main thread never waits on workers it failed
+ * to create.
+ *
+ * @run [in]: shared run state
+ * @return: true if the run started and false if it was aborted
+ */
+static bool mt_bench_wait_start(struct mt_bench_run *run)
+{
+	bool started;
+
+	pthread_mutex_lock(&run->lock);
+	run->num_ready++;
+	pthread_cond_broadcast(&run->cond);
+	while (!run->started && !run->aborted)
+		pthread_cond_wait(&run->cond, &run->lock);
+	started = run->started;
+	pthread_mutex_unlock(&run->lock);
+
+	return started;
+}
+
+/*
+ * Open the start gate once num_workers workers wait at it, or abort the run
+ *
+ * @run [in]: shared run state
+ * @num_workers [in]: number of workers to wait for before starting
+ * @abort [in]: whether to abort the run instead of starting it
+ */
+static void mt_bench_open_start(struct mt_bench_run *run, uint32_t num_workers, bool abort)
+{
+	pthread_mutex_lock(&run->lock);
+	if (abort)
+		run->aborted = true;
+	else {
+		while (run->num_ready < num_workers)
+			pthread_cond_wait(&run->cond, &run->lock);
+		run->started = true;
+	}
+	pthread_cond_broadcast(&run->cond);
+	pthread_mutex_unlock(&run->lock);
+}
+
+/*
+ * Worker thread entry point
+ *
+ * @arg [in]: the worker
+ * @return: NULL
+ */
+static void *mt_bench_worker_thread(void *arg)
+{
+	struct mt_bench_worker *worker = (struct mt_bench_worker *)arg;
+	doca_error_t result;
+
+	result = bench_pin_thread_to_cpu(worker->cpu);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_WARN("Worker %u runs unpinned", worker->id);
+
+	result = mt_bench_worker_setup(worker);
+	DOCA_ERROR_PROPAGATE(worker->result, result);
+
+	/* All the workers must reach the start gate, even the ones that failed */
+	if (mt_bench_wait_start(worker->run) && worker->result == DOCA_SUCCESS)
+		mt_bench_worker_run(worker);
+
+	mt_bench_worker_cleanup(worker);
+	return NULL;
+}
+
+/*
+ * Run the benchmark with a given number of workers, sharding the connections between them
+ *
+ * @run [in]: shared run state
+ * @cpus [in]: CPUs to pin the workers to
+ * @num_cpus [in]: number of CPUs in the cpus array
+ * @num_threads [in]: number of workers
+ * @bench_result [out]: aggregated result
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t mt_bench_run_threads(struct mt_bench_run *run,
+					 const uint32_t *cpus,
+					 uint32_t num_cpus,
+					 uint32_t num_threads,
+					 struct mt_bench_result *bench_result)
+{
+	struct mt_bench_worker *workers;
+	uint32_t total_connections = run->cfg->rdma.num_connections;
+	uint64_t total_ops = 0, total_polls = 0, total_idle_polls = 0, max_elapsed_ns = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i, num_started = 0;
+	int ret;
+
+	workers = calloc(num_threads, sizeof(*workers));
+	if (workers == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+
+	ret = pthread_mutex_init(&run->lock, NULL);
+	if (ret != 0) {
+		free(workers);
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+	ret = pthread_cond_init(&run->cond, NULL);
+	if (ret != 0) {
+		pthread_mutex_destroy(&run->lock);
+		free(workers);
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+	run->num_ready = 0;
+	run->started = false;
+	run->aborted = false;
+
+	for (i = 0; i < num_threads; i++) {
+		workers[i].id = i;
+		workers[i].cpu = cpus[i % num_cpus];
+		workers[i].run = run;
+		/* Shard the connections, the first workers get one more connection when they do not divide evenly */
+		workers[i].num_connections = total_connections / num_threads + (i < total_connections % num_threads);
+		workers[i].result = DOCA_SUCCESS;
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		ret = pthread_create(&workers[i].thread, NULL, mt_bench_worker_thread, &workers[i]);
+		if (ret != 0) {
+			DOCA_LOG_ERR("Failed to create worker thread %u", i);
+			result = DOCA_ERROR_OPERATING_SYSTEM;
+			break;
+		}
+		num_started++;
+	}
+
+	/* The started workers skip the timed region when the others could not be created */
+	mt_bench_open_start(run, num_threads, num_started != num_threads);
+
+	for (i = 0; i < num_started; i++) {
+		pthread_join(workers[i].thread, NULL);
+		DOCA_ERROR_PROPAGATE(result, workers[i].result);
+		total_ops += workers[i].completed_ops;
+		total_polls += workers[i].num_polls;
+		total_idle_polls += workers[i].num_idle_polls;
+		if (workers[i].elapsed_ns > max_elapsed_ns)
+			max_elapsed_ns = workers[i].elapsed_ns;
+		DOCA_LOG_DBG("Worker %u on CPU %u: %u connections, %lu ops, %lu/%lu idle polls",
+			     i,
+			     workers[i].cpu,
+			     workers[i].num_connections,
+			     workers[i].completed_ops,
+			     workers[i].num_idle_polls,
+			     workers[i].num_polls);
+	}
+
+	pthread_cond_destroy(&run->cond);
+	pthread_mutex_destroy(&run->lock);
+	free(workers);
+
+	if (result != DOCA_SUCCESS || max_elapsed_ns == 0)
+		return result != DOCA_SUCCESS ? result : DOCA_ERROR_UNEXPECTED;
+
+	bench_result->num_threads = num_threads;
+	bench_result->mops = (double)total_ops * 1000.0 / (double)max_elapsed_ns;
+	bench_result->gbps = (double)total_ops * run->cfg->msg_size * 8.0 / (double)max_elapsed_ns;
+	bench_result->idle_ratio = total_polls == 0 ? 0.0 : (double)total_idle_polls / (double)total_polls;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Log which resource limits the throughput, according to the scaling between the smallest and largest run
+ *
+ * @results [in]: results of all runs, ordered by number of threads
+ * @num_results [in]: number of results
+ */
+static void mt_bench_report_bottleneck(const struct mt_bench_result *results, uint32_t num_results)
+{
+	const struct mt_bench_result *first = &results[0];
+	const struct mt_bench_result *last = &results[num_results - 1];
+	double efficiency;
+
+	if (num_results < 2 || first->mops == 0.0) {
+		DOCA_LOG_INFO("Bottleneck: need at least two runs to analyze scaling");
+		return;
+	}
+
+	efficiency = (last->mops / first->mops) / ((double)last->num_threads / (double)first->num_threads);
+	DOCA_LOG_INFO("Scaling efficiency from %u to %u threads: %.1f%%",
+		      first->num_threads,
+		      last->num_threads,
+		      efficiency * 100.0);
+
+	if (efficiency >= LINEAR_SCALING_RATIO)
+		DOCA_LOG_INFO("Bottleneck: PE progress (CPU), throughput still scales with the number of cores");
+	else if (last->idle_ratio >= IDLE_POLL_RATIO_LIMIT)
+		DOCA_LOG_INFO("Bottleneck: NIC, workers spend %.1f%% of their polls waiting for completions",
+			      last->idle_ratio * 100.0);
+	else
+		DOCA_LOG_INFO("Bottleneck: PE progress with sub-linear scaling, workers are busy but contend on a shared resource");
+}
+
+/*
+ * Run the multi-threaded RDMA write benchmark with 1, 2, 4, ... threads, and with the configured number of threads
+ *
+ * @cfg [in]: Configuration parameters
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_multi_thread_bench(struct rdma_bench_config *cfg)
+{
+	struct mt_bench_run run = {0};
+	struct mt_bench_result results[RDMA_BENCH_MAX_THREADS];
+	uint32_t sweep[RDMA_BENCH_MAX_THREADS];
+	uint32_t cpus[BENCH_MAX_CPUS];
+	uint32_t num_cpus = 0, num_results = 0, num_runs = 0, num_threads;
+	doca_error_t result, tmp_result;
+
+	if (cfg->rdma.num_connections < cfg->num_threads) {
+		DOCA_LOG_WARN("Raising the number of connections to %u so every thread owns at least one",
+			      cfg->num_threads);
+		cfg->rdma.num_connections = cfg->num_threads;
+	}
+
+	run.cfg = cfg;
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_write_is_supported, &run.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	run.numa_node = bench_get_ibdev_numa_node(cfg->rdma.device_name);
+	if (cfg->cpu_list[0] != '\0')
+		result = bench_parse_cpu_list(cfg->cpu_list, cpus, BENCH_MAX_CPUS, &num_cpus);
+	else
+		result = bench_get_numa_node_cpus(run.numa_node, cpus, BENCH_MAX_CPUS, &num_cpus);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to select worker CPUs: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+	if (num_cpus < cfg->num_threads)
+		DOCA_LOG_WARN("Only %u CPUs available for %u threads, some CPUs will run several workers",
+			      num_cpus,
+			      cfg->num_threads);
+
+	DOCA_LOG_INFO("Device %s on NUMA node %d, %u connections, msg size %u, depth %u, %u sec per run",
+		      cfg->rdma.device_name,
+		      run.numa_node,
+		      cfg->rdma.num_connections,
+		      cfg->msg_size,
+		      cfg->queue_depth,
+		      cfg->duration_sec);
+
+	/* Powers of two below the configured number of threads, then the configured number itself */
+	for (num_threads = 1; num_threads < cfg->num_threads && num_runs < RDMA_BENCH_MAX_THREADS - 1; num_threads *= 2)
+		sweep[num_runs++] = num_threads;
+	sweep[num_runs++] = cfg->num_threads;
+
+	for (num_results = 0; num_results < num_runs; num_results++) {
+		result = mt_bench_run_threads(&run, cpus, num_cpus, sweep[num_results], &results[num_results]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Run with %u threads failed: %s",
+				     sweep[num_results],
+				     doca_error_get_descr(result));
+			goto close_dev;
+		}
+	}
+
+	DOCA_LOG_INFO("threads |    Mops/s |     Gbit/s | Mops/s per thread | idle polls");
+	for (num_threads = 0; num_threads < num_results; num_threads++)
+		DOCA_LOG_INFO("%7u | %9.3f | %10.3f | %17.3f | %9.1f%%",
+			      results[num_threads].num_threads,
+			      results[num_threads].mops,
+			      results[num_threads].gbps,
+			      results[num_threads].mops / results[num_threads].num_threads,
+			      results[num_threads].idle_ratio * 100.0);
+
+	mt_bench_report_bottleneck(results, num_results);
+
+close_dev:
+	tmp_result = doca_dev_close(run.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
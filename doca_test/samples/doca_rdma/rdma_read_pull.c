@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <infiniband/verbs.h>
+
+#include <doca_buf.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_rdma_bridge.h>
+
+#include "bench_common.h"
+#include "rdma_read_pull.h"
+
+DOCA_LOG_REGISTER(RDMA::READ_PULL);
+
+#define TRANSPORT_POLL_BATCH (32) /* Completions polled at once from a transport */
+
+/*
+ * Get the next chunk of the current fetch
+ *
+ * @engine [in]: the engine
+ * @remote_addr [out]: remote address of the chunk
+ * @local_addr [out]: local destination of the chunk
+ * @len [out]: chunk length
+ * @return: true if a chunk was returned, false if the fetch has no more chunks or failed
+ */
+static bool next_chunk(struct rdma_pull_engine *engine, uint64_t *remote_addr, char **local_addr, uint32_t *len)
+{
+	const struct rdma_pull_segment *segment;
+	uint64_t remaining;
+
+	if (engine->first_encountered_error != DOCA_SUCCESS)
+		return false;
+
+	while (engine->segment_idx < engine->num_segments) {
+		segment = &engine->segments[engine->segment_idx];
+		remaining = segment->len - engine->segment_offset;
+		if (remaining == 0) {
+			engine->segment_idx++;
+			engine->segment_offset = 0;
+			continue;
+		}
+
+		*len = remaining < engine->chunk_size ? (uint32_t)remaining : engine->chunk_size;
+		*remote_addr = segment->remote_addr + engine->segment_offset;
+		*local_addr = engine->local_cursor;
+		engine->segment_offset += *len;
+		engine->local_cursor += *len;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Get the source and destination buffers of a chunk
+ *
+ * @engine [in]: the engine
+ * @remote_addr [in]: remote address of the chunk
+ * @local_addr [in]: local destination of the chunk
+ * @len [in]: chunk length
+ * @src_buf [out]: remote source buffer
+ * @dst_buf [out]: local destination buffer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t get_chunk_bufs(struct rdma_pull_engine *engine,
+				   uint64_t remote_addr,
+				   char *local_addr,
+				   uint32_t len,
+				   struct doca_buf **src_buf,
+				   struct doca_buf **dst_buf)
+{
+	doca_error_t result;
+
+	result = doca_buf_inventory_buf_get_by_data(engine->inventory,
+						    engine->remote_mmap,
+						    (void *)(uintptr_t)remote_addr,
+						    len,
+						    src_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate remote chunk buffer: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_buf_get_by_addr(engine->inventory, engine->local_mmap, local_addr, len, dst_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate local chunk buffer: %s", doca_error_get_descr(result));
+		(void)doca_buf_dec_refcount(*src_buf, NULL);
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Free a read task and its buffers, and account for it as no longer outstanding
+ *
+ * @engine [in]: the engine
+ * @task [in]: read task
+ */
+static void release_read_task(struct rdma_pull_engine *engine, struct doca_rdma_task_read *task)
+{
+	const struct doca_buf *src_buf = doca_rdma_task_read_get_src_buf(task);
+	struct doca_buf *dst_buf = doca_rdma_task_read_get_dst_buf(task);
+
+	doca_task_free(doca_rdma_task_read_as_task(task));
+	(void)doca_buf_dec_refcount((struct doca_buf *)src_buf, NULL);
+	(void)doca_buf_dec_refcount(dst_buf, NULL);
+	engine->num_inflight--;
+}
+
+/*
+ * RDMA read task completed callback: reuse the task for the next chunk on the same connection
+ *
+ * @rdma_read_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void pull_read_completed_callback(struct doca_rdma_task_read *rdma_read_task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct rdma_pull_engine *engine = (struct rdma_pull_engine *)task_user_data.ptr;
+	const struct doca_buf *old_src = doca_rdma_task_read_get_src_buf(rdma_read_task);
+	struct doca_buf *old_dst = doca_rdma_task_read_get_dst_buf(rdma_read_task);
+	struct doca_buf *src_buf, *dst_buf;
+	uint64_t remote_addr;
+	char *local_addr;
+	size_t done_len = 0;
+	doca_error_t result;
+	uint32_t len;
+
+	(void)ctx_user_data;
+
+	(void)doca_buf_get_data_len(old_src, &done_len);
+	engine->stats.num_bytes += done_len;
+	engine->stats.num_reads++;
+
+	if (!next_chunk(engine, &remote_addr, &local_addr, &len)) {
+		release_read_task(engine, rdma_read_task);
+		return;
+	}
+
+	result = get_chunk_bufs(engine, remote_addr, local_addr, len, &src_buf, &dst_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(engine->first_encountered_error, result);
+		release_read_task(engine, rdma_read_task);
+		return;
+	}
+
+	(void)doca_buf_dec_refcount((struct doca_buf *)old_src, NULL);
+	(void)doca_buf_dec_refcount(old_dst, NULL);
+	doca_rdma_task_read_set_src_buf(rdma_read_task, src_buf);
+	doca_rdma_task_read_set_dst_buf(rdma_read_task, dst_buf);
+
+	result = doca_task_submit(doca_rdma_task_read_as_task(rdma_read_task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to resubmit RDMA read task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(engine->first_encountered_error, result);
+		release_read_task(engine, rdma_read_task);
+	}
+}
+
+/*
+ * RDMA read task error callback
+ *
+ * @rdma_read_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void pull_read_error_callback(struct doca_rdma_task_read *rdma_read_task,
+				     union doca_data task_user_data,
+				     union doca_data ctx_user_data)
+{
+	struct rdma_pull_engine *engine = (struct rdma_pull_engine *)task_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_read_as_task(rdma_read_task));
+
+	(void)ctx_user_data;
+
+	DOCA_LOG_ERR("RDMA read task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(engine->first_encountered_error, result);
+	release_read_task(engine, rdma_read_task);
+}
+
+/*
+ * Start a read of the next chunk on a connection
+ *
+ * @engine [in]: the engine
+ * @connection [in]: connection to read on
+ * @return: DOCA_SUCCESS on success or when there is nothing left to read, and DOCA_ERROR otherwise
+ */
+static doca_error_t start_read(struct rdma_pull_engine *engine, struct doca_rdma_connection *connection)
+{
+	struct doca_rdma_task_read *task;
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf, *dst_buf;
+	uint64_t remote_addr;
+	char *local_addr;
+	doca_error_t result;
+	uint32_t len;
+
+	if (!next_chunk(engine, &remote_addr, &local_addr, &len))
+		return DOCA_SUCCESS;
+
+	result = get_chunk_bufs(engine, remote_addr, local_addr, len, &src_buf, &dst_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	task_user_data.ptr = engine;
+	result = doca_rdma_task_read_allocate_init(engine->rdma, connection, src_buf, dst_buf, task_user_data, &task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate RDMA read task: %s", doca_error_get_descr(result));
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+		(void)doca_buf_dec_refcount(dst_buf, NULL);
+		return result;
+	}
+
+	engine->num_inflight++;
+	result = doca_task_submit(doca_rdma_task_read_as_task(task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit RDMA read task: %s", doca_error_get_descr(result));
+		release_read_task(engine, task);
+	}
+
+	return result;
+}
+
+/*
+ * Start a read of the next chunk on a transport, the transport index is the user data of the read
+ *
+ * @engine [in]: the engine
+ * @idx [in]: index of the transport to read on
+ * @return: DOCA_SUCCESS on success or when there is nothing left to read, and DOCA_ERROR otherwise
+ */
+static doca_error_t start_transport_read(struct rdma_pull_engine *engine, uint32_t idx)
+{
+	struct rdma_transport_sge sge = {.mr = engine->local_mrs[idx]};
+	uint64_t remote_addr;
+	char *local_addr;
+	doca_error_t result;
+
+	if (!next_chunk(engine, &remote_addr, &local_addr, &sge.len))
+		return DOCA_SUCCESS;
+	sge.addr = local_addr;
+
+	/* The send queue holds max_depth operations, so a full queue is an error here as well */
+	result = rdma_transport_post_read(engine->transports[idx], &sge, engine->rmrs[idx], remote_addr, idx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to post transport read: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	engine->num_inflight++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Poll every transport once, and reuse every completed read slot for the next chunk on the same transport
+ *
+ * @engine [in]: the engine
+ */
+static void progress_transports(struct rdma_pull_engine *engine)
+{
+	struct rdma_transport_completion comps[TRANSPORT_POLL_BATCH];
+	doca_error_t result;
+	uint32_t idx, num, i;
+
+	for (idx = 0; idx < engine->num_connections; idx++) {
+		num = rdma_transport_poll(engine->transports[idx], comps, TRANSPORT_POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			engine->num_inflight--;
+			if (comps[i].status != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Transport read failed: %s", doca_error_get_descr(comps[i].status));
+				DOCA_ERROR_PROPAGATE(engine->first_encountered_error, comps[i].status);
+				continue;
+			}
+			engine->stats.num_bytes += comps[i].len;
+			engine->stats.num_reads++;
+
+			result = start_transport_read(engine, (uint32_t)comps[i].user_data);
+			DOCA_ERROR_PROPAGATE(engine->first_encountered_error, result);
+		}
+	}
+}
+
+doca_error_t rdma_pull_get_max_outstanding_reads(struct doca_dev *dev, uint32_t *max_reads)
+{
+	struct ibv_device_attr dev_attr;
+	struct ibv_pd *pd;
+	doca_error_t result;
+	int ret;
+
+	result = doca_rdma_bridge_get_dev_pd(dev, &pd);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get device protection domain: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	ret = ibv_query_device(pd->context, &dev_attr);
+	if (ret != 0) {
+		DOCA_LOG_ERR("Failed to query device attributes: %s", strerror(ret));
+		return DOCA_ERROR_DRIVER;
+	}
+
+	/* The requester side is bounded by the initiator limit, the remote side by the responder limit */
+	*max_reads = (uint32_t)(dev_attr.max_qp_init_rd_atom < dev_attr.max_qp_rd_atom ? dev_attr.max_qp_init_rd_atom :
+											     dev_attr.max_qp_rd_atom);
+	if (*max_reads == 0)
+		*max_reads = 1;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_pull_configure(struct doca_rdma *rdma, uint32_t max_depth, uint32_t num_connections)
+{
+	doca_error_t result;
+
+	if (max_depth == 0 || num_connections == 0 || num_connections > RDMA_PULL_MAX_CONNECTIONS) {
+		DOCA_LOG_ERR("Invalid pull engine configuration: depth %u, %u connections", max_depth, num_connections);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = doca_rdma_set_send_queue_size(rdma, max_depth);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set RDMA send queue size: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_read_set_conf(rdma,
+					      pull_read_completed_callback,
+					      pull_read_error_callback,
+					      max_depth * num_connections);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Unable to set configurations for RDMA read task: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+doca_error_t rdma_pull_engine_create(struct doca_rdma *rdma,
+				     struct doca_pe *pe,
+				     struct doca_rdma_connection *const *connections,
+				     uint32_t num_connections,
+				     uint32_t max_depth,
+				     struct doca_mmap *local_mmap,
+				     struct doca_mmap *remote_mmap,
+				     struct rdma_pull_engine **engine)
+{
+	struct rdma_pull_engine *new_engine;
+	doca_error_t result;
+
+	if (max_depth == 0 || num_connections == 0 || num_connections > RDMA_PULL_MAX_CONNECTIONS)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	new_engine = calloc(1, sizeof(*new_engine));
+	if (new_engine == NULL) {
+		DOCA_LOG_ERR("Failed to allocate pull engine");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	new_engine->rdma = rdma;
+	new_engine->pe = pe;
+	memcpy(new_engine->connections, connections, num_connections * sizeof(*connections));
+	new_engine->num_connections = num_connections;
+	new_engine->max_depth = max_depth;
+	new_engine->local_mmap = local_mmap;
+	new_engine->remote_mmap = remote_mmap;
+
+	/* A pair per outstanding read, plus a spare pair, a completed read gets its next buffers before releasing */
+	result = doca_buf_inventory_create(2 * max_depth * num_connections + 2, &new_engine->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		free(new_engine);
+		return result;
+	}
+
+	result = doca_buf_inventory_start(new_engine->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		(void)doca_buf_inventory_destroy(new_engine->inventory);
+		free(new_engine);
+		return result;
+	}
+
+	*engine = new_engine;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_pull_engine_create_transport(struct rdma_transport *const *transports,
+					       struct rdma_transport_rmr *const *rmrs,
+					       struct rdma_transport_mr *const *local_mrs,
+					       uint32_t num_transports,
+					       uint32_t max_depth,
+					       struct rdma_pull_engine **engine)
+{
+	struct rdma_pull_engine *new_engine;
+
+	if (max_depth == 0 || num_transports == 0 || num_transports > RDMA_PULL_MAX_CONNECTIONS)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	new_engine = calloc(1, sizeof(*new_engine));
+	if (new_engine == NULL) {
+		DOCA_LOG_ERR("Failed to allocate pull engine");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	memcpy(new_engine->transports, transports, num_transports * sizeof(*transports));
+	memcpy(new_engine->rmrs, rmrs, num_transports * sizeof(*rmrs));
+	memcpy(new_engine->local_mrs, local_mrs, num_transports * sizeof(*local_mrs));
+	new_engine->num_connections = num_transports;
+	new_engine->max_depth = max_depth;
+
+	*engine = new_engine;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_pull_fetch(struct rdma_pull_engine *engine,
+			     const struct rdma_pull_segment *segments,
+			     uint32_t num_segments,
+			     void *local_addr,
+			     const struct rdma_pull_params *params,
+			     struct rdma_pull_stats *stats)
+{
+	uint32_t depth, i, conn;
+	uint64_t start_ns;
+	doca_error_t result;
+
+	if (params->chunk_size == 0 || params->depth == 0) {
+		DOCA_LOG_ERR("Chunk size and depth must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	depth = params->depth < engine->max_depth ? params->depth : engine->max_depth;
+
+	engine->segments = segments;
+	engine->num_segments = num_segments;
+	engine->segment_idx = 0;
+	engine->segment_offset = 0;
+	engine->local_cursor = local_addr;
+	engine->chunk_size = params->chunk_size;
+	engine->first_encountered_error = DOCA_SUCCESS;
+	memset(&engine->stats, 0, sizeof(engine->stats));
+
+	start_ns = bench_get_time_ns();
+
+	/* Fill the connections round robin, so a small fetch is still spread over all of them */
+	for (i = 0; i < depth; i++) {
+		for (conn = 0; conn < engine->num_connections; conn++) {
+			if (engine->rdma != NULL)
+				result = start_read(engine, engine->connections[conn]);
+			else
+				result = start_transport_read(engine, conn);
+			if (result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(engine->first_encountered_error, result);
+				break;
+			}
+		}
+	}
+
+	while (engine->num_inflight > 0) {
+		if (engine->rdma != NULL)
+			(void)doca_pe_progress(engine->pe);
+		else
+			progress_transports(engine);
+	}
+
+	engine->stats.elapsed_ns = bench_get_time_ns() - start_ns;
+	*stats = engine->stats;
+
+	return engine->first_encountered_error;
+}
+
+doca_error_t rdma_pull_engine_destroy(struct rdma_pull_engine *engine)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (engine == NULL)
+		return DOCA_SUCCESS;
+
+	/* A transport engine has no buffer inventory, the transports own the registrations */
+	if (engine->inventory == NULL) {
+		free(engine);
+		return DOCA_SUCCESS;
+	}
+
+	tmp_result = doca_buf_inventory_stop(engine->inventory);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to stop DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	tmp_result = doca_buf_inventory_destroy(engine->inventory);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	free(engine);
+	return result;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_READ_PULL_H_
+#define RDMA_READ_PULL_H_
+
+#include <stdint.h>
+
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "rdma_transport.h"
+
+/*
+ * Pull engine fetching remote memory with parallel chunked RDMA reads.
+ *
+ * A fetch takes a scatter list of remote (addr, len) segments and assembles them back to back into local memory.
+ * Segments are cut into chunks of at most chunk_size bytes, and every connection keeps up to depth reads
+ * outstanding: when a read completes its task is reused for the next chunk on the same connection, so the number
+ * of outstanding reads per QP never exceeds depth. depth is capped to the device limit of outstanding RDMA reads
+ * per QP, above which reads would just wait in the send queue.
+ *
+ * The engine runs either over a DOCA RDMA with several connections, or over the transport interface with one
+ * transport per connection, so that the same chunking and windowing logic can run on the shared-memory loopback.
+ */
+
+#define RDMA_PULL_MAX_CONNECTIONS (64) /* Maximum number of connections a pull engine spreads its reads over */
+
+/* A remote memory segment */
+struct rdma_pull_segment {
+	uint64_t remote_addr; /* Address of the segment, inside the remote mmap */
+	uint64_t len;	      /* Length of the segment */
+};
+
+/* Parameters of a fetch */
+struct rdma_pull_params {
+	uint32_t chunk_size; /* Largest RDMA read */
+	uint32_t depth;	     /* Outstanding reads per connection, capped to the engine max_depth */
+};
+
+/* Result of a fetch */
+struct rdma_pull_stats {
+	uint64_t num_bytes;  /* Number of bytes fetched */
+	uint64_t num_reads;  /* Number of RDMA reads */
+	uint64_t elapsed_ns; /* Duration of the fetch */
+};
+
+struct rdma_pull_engine {
+	struct doca_rdma *rdma;						  /* DOCA RDMA issuing the reads */
+	struct doca_pe *pe;						  /* PE the DOCA RDMA is connected to */
+	struct doca_rdma_connection *connections[RDMA_PULL_MAX_CONNECTIONS]; /* Connections to the remote */
+	uint32_t num_connections;					  /* Number of connections */
+	uint32_t max_depth;						  /* Maximum outstanding reads per connection */
+	struct doca_mmap *local_mmap;					  /* Local destination memory */
+	struct doca_mmap *remote_mmap;					  /* Remote source memory */
+	struct doca_buf_inventory *inventory;				  /* Inventory for the chunk buffers */
+	/* Transport engine, rdma is NULL */
+	struct rdma_transport *transports[RDMA_PULL_MAX_CONNECTIONS];	/* One transport per connection */
+	struct rdma_transport_rmr *rmrs[RDMA_PULL_MAX_CONNECTIONS];	/* Remote source memory */
+	struct rdma_transport_mr *local_mrs[RDMA_PULL_MAX_CONNECTIONS];	/* Local destination memory */
+	/* State of the current fetch */
+	const struct rdma_pull_segment *segments; /* Segments to fetch */
+	uint32_t num_segments;			  /* Number of segments */
+	uint32_t segment_idx;			  /* Segment of the next chunk */
+	uint64_t segment_offset;		  /* Offset of the next chunk inside its segment */
+	char *local_cursor;			  /* Destination of the next chunk */
+	uint32_t chunk_size;			  /* Chunk size of the current fetch */
+	uint32_t num_inflight;			  /* Number of outstanding reads */
+	struct rdma_pull_stats stats;		  /* Statistics of the current fetch */
+	doca_error_t first_encountered_error;	  /* First error encountered by the current fetch */
+};
+
+/*
+ * Get the maximum number of outstanding RDMA reads per QP supported by a device
+ *
+ * @dev [in]: DOCA device
+ * @max_reads [out]: maximum outstanding reads per QP
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_pull_get_max_outstanding_reads(struct doca_dev *dev, uint32_t *max_reads);
+
+/*
+ * Configure a DOCA RDMA that was not started yet for a pull engine
+ *
+ * @rdma [in]: DOCA RDMA, before doca_ctx_start()
+ * @max_depth [in]: maximum outstanding reads per connection
+ * @num_connections [in]: number of connections the engine will use
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_pull_configure(struct doca_rdma *rdma, uint32_t max_depth, uint32_t num_connections);
+
+/*
+ * Create a pull engine over a running and connected DOCA RDMA that was configured with rdma_pull_configure()
+ *
+ * @rdma [in]: DOCA RDMA
+ * @pe [in]: PE the DOCA RDMA is connected to
+ * @connections [in]: connections to the remote
+ * @num_connections [in]: number of connections
+ * @max_depth [in]: maximum outstanding reads per connection, as given to rdma_pull_configure()
+ * @local_mmap [in]: started mmap of the local destination memory
+ * @remote_mmap [in]: remote mmap created from the remote export
+ * @engine [out]: the created engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_pull_engine_create(struct doca_rdma *rdma,
+				     struct doca_pe *pe,
+				     struct doca_rdma_connection *const *connections,
+				     uint32_t num_connections,
+				     uint32_t max_depth,
+				     struct doca_mmap *local_mmap,
+				     struct doca_mmap *remote_mmap,
+				     struct rdma_pull_engine **engine);
+
+/*
+ * Create a pull engine over connected transports, one per connection
+ *
+ * @transports [in]: transports to the remote, their send queue holds at least max_depth operations
+ * @rmrs [in]: remote source memory imported by every transport
+ * @local_mrs [in]: local destination memory registered with every transport
+ * @num_transports [in]: number of transports
+ * @max_depth [in]: maximum outstanding reads per transport
+ * @engine [out]: the created engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_pull_engine_create_transport(struct rdma_transport *const *transports,
+					       struct rdma_transport_rmr *const *rmrs,
+					       struct rdma_transport_mr *const *local_mrs,
+					       uint32_t num_transports,
+					       uint32_t max_depth,
+					       struct rdma_pull_engine **engine);
+
+/*
+ * Fetch a scatter list of remote segments into contiguous local memory, progressing until it completes
+ *
+ * @engine [in]: the engine
+ * @segments [in]: remote segments, fetched in order
+ * @num_segments [in]: number of segments
+ * @local_addr [in]: local destination, inside the local mmap, large enough for the sum of the segment lengths
+ * @params [in]: chunk size and depth
+ * @stats [out]: fetch statistics
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_pull_fetch(struct rdma_pull_engine *engine,
+			     const struct rdma_pull_segment *segments,
+			     uint32_t num_segments,
+			     void *local_addr,
+			     const struct rdma_pull_params *params,
+			     struct rdma_pull_stats *stats);
+
+/*
+ * Destroy a pull engine
+ *
+ * @engine [in]: the engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_pull_engine_destroy(struct rdma_pull_engine *engine);
+
+#endif /* RDMA_READ_PULL_H_ */
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA_READ_PULL_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_read_pull_bench(struct rdma_bench_config *cfg, uint64_t region_size);
+doca_error_t rdma_read_pull_bench_transport(struct rdma_bench_config *cfg,
+					    uint64_t region_size,
+					    enum rdma_transport_type type);
+
+#define DEFAULT_REGION_SIZE_MB (256)   /* Default size of the pulled region in MB */
+#define DEFAULT_MAX_CHUNK_SIZE (1U << 20) /* Default largest chunk of the sweep */
+#define DEFAULT_MAX_DEPTH (16)	       /* Default largest number of outstanding reads per connection */
+#define MAX_REGION_SIZE_MB (16384)     /* Largest region the benchmark allocates, twice */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct read_pull_bench_config {
+	struct rdma_bench_config bench;	    /* Benchmark configuration */
+	uint64_t region_size;		    /* Size of the pulled region in bytes */
+	bool use_transport;		    /* Run the engine through the transport interface */
+	enum rdma_transport_type transport; /* Transport backend, when use_transport is set */
+};
+
+/*
+ * ARGP Callback - Handle region size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t region_size_callback(void *param, void *config)
+{
+	struct read_pull_bench_config *cfg = (struct read_pull_bench_config *)config;
+	const int region_size_mb = *(int *)param;
+
+	if (region_size_mb <= 0 || region_size_mb > MAX_REGION_SIZE_MB) {
+		DOCA_LOG_ERR("Region size must be between 1 and %d MB", MAX_REGION_SIZE_MB);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->region_size = (uint64_t)region_size_mb << 20;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle transport parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t transport_callback(void *param, void *config)
+{
+	struct read_pull_bench_config *cfg = (struct read_pull_bench_config *)config;
+
+	cfg->use_transport = true;
+	return rdma_transport_parse_type((const char *)param, &cfg->transport);
+}
+
+/*
+ * Register the read pull parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_read_pull_params(void)
+{
+	struct doca_argp_param *region_size_param, *transport_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&region_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(region_size_param, "rz");
+	doca_argp_param_set_long_name(region_size_param, "region-mb");
+	doca_argp_param_set_arguments(region_size_param, "<MB>");
+	doca_argp_param_set_description(region_size_param, "Size of the pulled region in MB (optional)");
+	doca_argp_param_set_callback(region_size_param, region_size_callback);
+	doca_argp_param_set_type(region_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(region_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&transport_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(transport_param, "tr");
+	doca_argp_param_set_long_name(transport_param, "transport");
+	doca_argp_param_set_arguments(transport_param, "<doca|shm>");
+	doca_argp_param_set_description(
+		transport_param,
+		"Pull through the transport interface with one transport pair per connection, \"shm\" runs without "
+		"a device (optional, DOCA RDMA is used directly by default)");
+	doca_argp_param_set_callback(transport_param, transport_callback);
+	doca_argp_param_set_type(transport_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(transport_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct read_pull_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = DEFAULT_MAX_CHUNK_SIZE;
+	cfg.bench.queue_depth = DEFAULT_MAX_DEPTH;
+	cfg.region_size = (uint64_t)DEFAULT_REGION_SIZE_MB << 20;
+	cfg.use_transport = false;
+	cfg.transport = RDMA_TRANSPORT_DOCA;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_read_pull_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark connections param */
+	result = register_rdma_bench_connections_param();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register connections parameter: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark params */
+	result = register_rdma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register read pull params */
+	result = register_read_pull_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register read pull parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	if (cfg.use_transport)
+		result = rdma_read_pull_bench_transport(&cfg.bench, cfg.region_size, cfg.transport);
+	else
+		result = rdma_read_pull_bench(&cfg.bench, cfg.region_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_read_pull_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
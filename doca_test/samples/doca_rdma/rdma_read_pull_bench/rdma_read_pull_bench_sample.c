@@ -0,0 +1,606 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+#include "rdma_read_pull.h"
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA_READ_PULL_BENCH::SAMPLE);
+
+#define MIN_CHUNK_SIZE (4096)		 /* Smallest chunk size of the sweep */
+#define CHUNK_SIZE_STEP (4)		 /* Chunk size multiplier between two sweep points */
+#define MAX_SWEEP_POINTS (128)		 /* Maximum number of (chunk size, depth) sweep points */
+#define SCATTER_MAX_SEGMENT_LEN (65536) /* Largest segment of the scatter list test */
+
+/* Benchmark state */
+struct read_pull_bench {
+	struct rdma_bench_config *cfg;		   /* Benchmark configuration */
+	struct doca_dev *dev;			   /* DOCA device */
+	struct doca_pe *pe;			   /* Progress engine driving both endpoints */
+	struct rdma_bench_endpoint puller;	   /* Endpoint issuing the reads */
+	struct rdma_bench_endpoint remote;	   /* Endpoint exposing the remote region */
+	uint64_t region_size;			   /* Size of the remote region */
+	int numa_node;				   /* NUMA node of the device */
+	char *remote_region;			   /* Memory behind the remote endpoint */
+	char *local_region;			   /* Destination of the fetches */
+	struct doca_mmap *remote_region_mmap;	   /* Registration of remote_region, with remote read access */
+	struct doca_mmap *remote_view_mmap;	   /* remote_region as seen by the puller */
+	struct doca_mmap *local_region_mmap;	   /* Registration of local_region */
+	struct rdma_pull_engine *engine;	   /* The pull engine */
+	/* Transport mode, one transport pair per connection */
+	uint32_t num_transports;					 /* Number of transport pairs */
+	struct rdma_transport *pullers[RDMA_PULL_MAX_CONNECTIONS];	 /* Transports issuing the reads */
+	struct rdma_transport *remotes[RDMA_PULL_MAX_CONNECTIONS];	 /* Transports exposing the remote region */
+	struct rdma_transport_mr *local_mrs[RDMA_PULL_MAX_CONNECTIONS];	 /* Registrations of local_region */
+	struct rdma_transport_mr *remote_mrs[RDMA_PULL_MAX_CONNECTIONS]; /* Registrations of remote_region */
+	struct rdma_transport_rmr *rmrs[RDMA_PULL_MAX_CONNECTIONS];	 /* remote_region as seen by the pullers */
+};
+
+/* Result of one sweep point */
+struct sweep_point {
+	struct rdma_pull_params params; /* Chunk size and depth */
+	double gbps;			/* Achieved bandwidth in Gbit/s */
+};
+
+/*
+ * Fetch the whole region repeatedly until the time budget is used, and compute the achieved bandwidth
+ *
+ * @bench [in]: benchmark state
+ * @params [in]: chunk size and depth
+ * @budget_ns [in]: time budget, at least one fetch is always done
+ * @gbps [out]: achieved bandwidth in Gbit/s
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t measure_point(struct read_pull_bench *bench,
+				  const struct rdma_pull_params *params,
+				  uint64_t budget_ns,
+				  double *gbps)
+{
+	struct rdma_pull_segment segment = {
+		.remote_addr = (uintptr_t)bench->remote_region,
+		.len = bench->region_size,
+	};
+	struct rdma_pull_stats stats;
+	uint64_t total_bytes = 0, total_ns = 0;
+	doca_error_t result;
+
+	do {
+		result = rdma_pull_fetch(bench->engine, &segment, 1, bench->local_region, params, &stats);
+		if (result != DOCA_SUCCESS)
+			return result;
+		total_bytes += stats.num_bytes;
+		total_ns += stats.elapsed_ns;
+	} while (total_ns < budget_ns);
+
+	*gbps = (double)total_bytes * 8.0 / (double)total_ns;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Build a shuffled scatter list of random sized segments covering the whole region
+ *
+ * @bench [in]: benchmark state
+ * @segments [out]: allocated scatter list, to be freed by the caller
+ * @num_segments [out]: number of segments
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t build_scatter_list(struct read_pull_bench *bench,
+				       struct rdma_pull_segment **segments,
+				       uint32_t *num_segments)
+{
+	uint64_t offset = 0, rng = 0x2545F4914F6CDD1DULL, len;
+	struct rdma_pull_segment *list = NULL, *new_list, tmp;
+	uint32_t count = 0, capacity = 0, i, j;
+
+	while (offset < bench->region_size) {
+		if (count == capacity) {
+			capacity = capacity == 0 ? 1024 : 2 * capacity;
+			new_list = realloc(list, capacity * sizeof(*list));
+			if (new_list == NULL) {
+				free(list);
+				return DOCA_ERROR_NO_MEMORY;
+			}
+			list = new_list;
+		}
+
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+		len = 1 + rng % SCATTER_MAX_SEGMENT_LEN;
+		if (len > bench->region_size - offset)
+			len = bench->region_size - offset;
+		list[count].remote_addr = (uintptr_t)bench->remote_region + offset;
+		list[count].len = len;
+		offset += len;
+		count++;
+	}
+
+	/* Shuffle, so consecutive local chunks come from unrelated remote addresses */
+	for (i = count - 1; i > 0; i--) {
+		rng ^= rng << 13;
+		rng ^= rng >> 7;
+		rng ^= rng << 17;
+		j = rng % (i + 1);
+		tmp = list[i];
+		list[i] = list[j];
+		list[j] = tmp;
+	}
+
+	*segments = list;
+	*num_segments = count;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Fetch a shuffled scatter list with the given parameters and verify the assembled local memory
+ *
+ * @bench [in]: benchmark state
+ * @params [in]: chunk size and depth
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_scatter_test(struct read_pull_bench *bench, const struct rdma_pull_params *params)
+{
+	struct rdma_pull_segment *segments;
+	struct rdma_pull_stats stats;
+	uint32_t num_segments, i;
+	const char *local;
+	doca_error_t result;
+
+	result = build_scatter_list(bench, &segments, &num_segments);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to build scatter list: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	memset(bench->local_region, 0, bench->region_size);
+	result = rdma_pull_fetch(bench->engine, segments, num_segments, bench->local_region, params, &stats);
+	if (result != DOCA_SUCCESS)
+		goto free_segments;
+
+	local = bench->local_region;
+	for (i = 0; i < num_segments; i++) {
+		if (memcmp(local, (const void *)(uintptr_t)segments[i].remote_addr, segments[i].len) != 0) {
+			DOCA_LOG_ERR("Scatter fetch mismatch in segment %u", i);
+			result = DOCA_ERROR_UNEXPECTED;
+			goto free_segments;
+		}
+		local += segments[i].len;
+	}
+
+	DOCA_LOG_INFO("Scatter list of %u segments (1-%u bytes): %lu reads, %.3f Gbit/s, data verified",
+		      num_segments,
+		      SCATTER_MAX_SEGMENT_LEN,
+		      stats.num_reads,
+		      (double)stats.num_bytes * 8.0 / (double)stats.elapsed_ns);
+
+free_segments:
+	free(segments);
+	return result;
+}
+
+/*
+ * Sweep chunk sizes and depths, report the bandwidth table and the best setting, then run the scatter test
+ *
+ * @bench [in]: benchmark state
+ * @max_depth [in]: largest depth of the sweep
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_sweep(struct read_pull_bench *bench, uint32_t max_depth)
+{
+	struct sweep_point points[MAX_SWEEP_POINTS];
+	uint32_t num_points = 0, chunk_size, depth, i, best = 0;
+	uint64_t budget_ns;
+	doca_error_t result;
+
+	for (chunk_size = MIN_CHUNK_SIZE; chunk_size <= bench->cfg->msg_size; chunk_size *= CHUNK_SIZE_STEP)
+		for (depth = 1; depth <= max_depth && num_points < MAX_SWEEP_POINTS; depth *= 2) {
+			points[num_points].params.chunk_size = chunk_size;
+			points[num_points].params.depth = depth;
+			num_points++;
+		}
+	if (num_points == 0) {
+		DOCA_LOG_ERR("Maximum chunk size must be at least %u", MIN_CHUNK_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	budget_ns = (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC / num_points;
+	for (i = 0; i < num_points; i++) {
+		result = measure_point(bench, &points[i].params, budget_ns, &points[i].gbps);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Fetch with chunk size %u and depth %u failed: %s",
+				     points[i].params.chunk_size,
+				     points[i].params.depth,
+				     doca_error_get_descr(result));
+			return result;
+		}
+		if (points[i].gbps > points[best].gbps)
+			best = i;
+	}
+
+	DOCA_LOG_INFO("chunk size | depth |     Gbit/s");
+	for (i = 0; i < num_points; i++)
+		DOCA_LOG_INFO("%10u | %5u | %10.3f",
+			      points[i].params.chunk_size,
+			      points[i].params.depth,
+			      points[i].gbps);
+	DOCA_LOG_INFO("Best: chunk size %u, depth %u per connection over %u connections, %.3f Gbit/s",
+		      points[best].params.chunk_size,
+		      points[best].params.depth,
+		      bench->engine->num_connections,
+		      points[best].gbps);
+
+	return run_scatter_test(bench, &points[best].params);
+}
+
+/*
+ * Allocate and fill the remote and local regions
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t alloc_regions(struct read_pull_bench *bench)
+{
+	uint64_t *words, i;
+
+	bench->remote_region = bench_alloc_numa(bench->region_size, bench->numa_node);
+	bench->local_region = bench_alloc_numa(bench->region_size, bench->numa_node);
+	if (bench->remote_region == NULL || bench->local_region == NULL) {
+		DOCA_LOG_ERR("Failed to allocate two regions of %lu bytes", bench->region_size);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	words = (uint64_t *)bench->remote_region;
+	for (i = 0; i < bench->region_size / sizeof(*words); i++)
+		words[i] = i;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Allocate, fill and register the remote and local regions with the DOCA device
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_regions(struct read_pull_bench *bench)
+{
+	doca_error_t result;
+
+	result = alloc_regions(bench);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = create_local_mmap(&bench->remote_region_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ,
+				   bench->remote_region,
+				   bench->region_size,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_import_mmap(bench->remote_region_mmap, bench->dev, &bench->remote_view_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return create_local_mmap(&bench->local_region_mmap,
+				 DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				 bench->local_region,
+				 bench->region_size,
+				 bench->dev);
+}
+
+/*
+ * Destroy the regions and their registrations
+ *
+ * @bench [in]: benchmark state
+ */
+static void destroy_regions(struct read_pull_bench *bench)
+{
+	if (bench->local_region_mmap != NULL) {
+		(void)doca_mmap_stop(bench->local_region_mmap);
+		(void)doca_mmap_destroy(bench->local_region_mmap);
+	}
+	if (bench->remote_view_mmap != NULL) {
+		(void)doca_mmap_stop(bench->remote_view_mmap);
+		(void)doca_mmap_destroy(bench->remote_view_mmap);
+	}
+	if (bench->remote_region_mmap != NULL) {
+		(void)doca_mmap_stop(bench->remote_region_mmap);
+		(void)doca_mmap_destroy(bench->remote_region_mmap);
+	}
+	bench_free_numa(bench->local_region, bench->region_size);
+	bench_free_numa(bench->remote_region, bench->region_size);
+}
+
+/*
+ * Fetch a remote region with the RDMA read pull engine over NIC loopback connections, sweeping the chunk size and
+ * the number of outstanding reads per connection
+ *
+ * @cfg [in]: Configuration parameters, msg_size is the largest chunk and queue_depth the largest depth
+ * @region_size [in]: size of the remote region
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_read_pull_bench(struct rdma_bench_config *cfg, uint64_t region_size)
+{
+	struct read_pull_bench bench = {0};
+	struct rdma_bench_endpoint_attr attr = {0};
+	uint32_t max_reads, max_depth;
+	doca_error_t result, tmp_result;
+
+	bench.cfg = cfg;
+	bench.region_size = region_size;
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_read_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+	bench.numa_node = bench_get_ibdev_numa_node(cfg->rdma.device_name);
+
+	result = rdma_pull_get_max_outstanding_reads(bench.dev, &max_reads);
+	if (result != DOCA_SUCCESS)
+		goto close_dev;
+	max_depth = cfg->queue_depth < max_reads ? cfg->queue_depth : max_reads;
+	DOCA_LOG_INFO("Device allows %u outstanding reads per QP, sweeping depth up to %u", max_reads, max_depth);
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	attr.num_connections = cfg->rdma.num_connections;
+	attr.transport_type = cfg->rdma.transport_type;
+	attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	attr.gid_index = cfg->rdma.gid_index;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &attr, &bench.puller);
+	if (result != DOCA_SUCCESS)
+		goto destroy_pe;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &attr, &bench.remote);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_pull_configure(bench.puller.rdma, max_depth, cfg->rdma.num_connections);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.puller);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.remote);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_connect_loopback(&bench.puller, &bench.remote, cfg->rdma.num_connections);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = prepare_regions(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_regions;
+
+	result = rdma_pull_engine_create(bench.puller.rdma,
+					 bench.pe,
+					 bench.puller.connections,
+					 bench.puller.num_connections,
+					 max_depth,
+					 bench.local_region_mmap,
+					 bench.remote_view_mmap,
+					 &bench.engine);
+	if (result != DOCA_SUCCESS)
+		goto destroy_regions;
+
+	result = run_sweep(&bench, max_depth);
+
+	tmp_result = rdma_pull_engine_destroy(bench.engine);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_regions:
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.puller);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.remote);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	destroy_regions(&bench);
+destroy_endpoints:
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.puller);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.remote);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_pe:
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
+
+/*
+ * Create the transport pairs, connect them and register the regions, the pullers import the remote region
+ *
+ * @bench [in]: benchmark state
+ * @type [in]: transport backend
+ * @max_depth [in]: send queue size of the pullers
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t create_transports(struct read_pull_bench *bench, enum rdma_transport_type type, uint32_t max_depth)
+{
+	struct rdma_transport_attr attr = {0};
+	const void *desc;
+	size_t desc_len;
+	doca_error_t result;
+	uint32_t i;
+
+	attr.rdma_cfg = &bench->cfg->rdma;
+	attr.send_queue_size = max_depth;
+	/* Nothing is received, but the interface takes a non-empty receive queue */
+	attr.recv_queue_size = 1;
+
+	for (i = 0; i < bench->num_transports; i++) {
+		result = rdma_transport_create(type, &attr, &bench->pullers[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = rdma_transport_create(type, &attr, &bench->remotes[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = rdma_transport_connect(bench->pullers[i], bench->remotes[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		result = rdma_transport_reg_mr(bench->pullers[i],
+					       bench->local_region,
+					       bench->region_size,
+					       &bench->local_mrs[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = rdma_transport_reg_mr(bench->remotes[i],
+					       bench->remote_region,
+					       bench->region_size,
+					       &bench->remote_mrs[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		result = rdma_transport_export_mr(bench->remotes[i], bench->remote_mrs[i], &desc, &desc_len);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = rdma_transport_import_mr(bench->pullers[i], desc, desc_len, &bench->rmrs[i]);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stop the transport pairs, release their registrations and destroy them
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_transports(struct read_pull_bench *bench)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint32_t i;
+
+	for (i = 0; i < bench->num_transports; i++) {
+		tmp_result = rdma_transport_stop(bench->remotes[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = rdma_transport_stop(bench->pullers[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+
+		if (bench->rmrs[i] != NULL)
+			(void)rdma_transport_release_rmr(bench->pullers[i], bench->rmrs[i]);
+		if (bench->remote_mrs[i] != NULL)
+			(void)rdma_transport_dereg_mr(bench->remotes[i], bench->remote_mrs[i]);
+		if (bench->local_mrs[i] != NULL)
+			(void)rdma_transport_dereg_mr(bench->pullers[i], bench->local_mrs[i]);
+
+		tmp_result = rdma_transport_destroy(bench->remotes[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = rdma_transport_destroy(bench->pullers[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	return result;
+}
+
+/*
+ * Run the same sweep and scatter test as rdma_read_pull_bench() through the transport interface, with one transport
+ * pair per connection, so the pull engine can be exercised on the shared-memory loopback without a device
+ *
+ * @cfg [in]: Configuration parameters, the device is used by the DOCA backend only
+ * @region_size [in]: size of the remote region
+ * @type [in]: transport backend
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_read_pull_bench_transport(struct rdma_bench_config *cfg,
+					    uint64_t region_size,
+					    enum rdma_transport_type type)
+{
+	struct read_pull_bench bench = {0};
+	uint32_t max_depth = cfg->queue_depth;
+	doca_error_t result, tmp_result;
+
+	if (cfg->rdma.num_connections == 0 || cfg->rdma.num_connections > RDMA_PULL_MAX_CONNECTIONS) {
+		DOCA_LOG_ERR("Number of connections must be between 1 and %d", RDMA_PULL_MAX_CONNECTIONS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	bench.cfg = cfg;
+	bench.region_size = region_size;
+	bench.num_transports = cfg->rdma.num_connections;
+	bench.numa_node = type == RDMA_TRANSPORT_DOCA ? bench_get_ibdev_numa_node(cfg->rdma.device_name) : -1;
+
+	result = alloc_regions(&bench);
+	if (result != DOCA_SUCCESS)
+		goto free_regions;
+
+	result = create_transports(&bench, type, max_depth);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transports;
+
+	result = rdma_pull_engine_create_transport(bench.pullers,
+						   bench.rmrs,
+						   bench.local_mrs,
+						   bench.num_transports,
+						   max_depth,
+						   &bench.engine);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transports;
+
+	/* The transport does not expose the device read limit, deeper reads just wait in the send queue */
+	DOCA_LOG_INFO("Transport %s, sweeping depth up to %u", bench.pullers[0]->ops->name, max_depth);
+	result = run_sweep(&bench, max_depth);
+
+	tmp_result = rdma_pull_engine_destroy(bench.engine);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_transports:
+	tmp_result = destroy_transports(&bench);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+free_regions:
+	destroy_regions(&bench);
+	return result;
+}
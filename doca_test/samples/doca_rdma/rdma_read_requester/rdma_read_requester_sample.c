@@ -107,6 +107,12 @@ static void rdma_read_completed_callback(struct doca_rdma_task_read *rdma_read_t
 	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_read_as_task(rdma_read_task),
+				    RDMA_LATENCY_TASK_READ,
+				    doca_rdma_task_read_get_rdma_connection(rdma_read_task),
+				    rdma_latency_buf_len(doca_rdma_task_read_get_dst_buf(rdma_read_task)));
+
 	DOCA_LOG_INFO("RDMA read task was done Successfully");
 
 	/* Read the data that was read */
@@ -171,6 +177,7 @@ static void rdma_read_error_callback(struct doca_rdma_task_read *rdma_read_task,
 	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA read task failed: %s", doca_error_get_descr(result));
 
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 	result = doca_buf_dec_refcount(resources->dst_buf, NULL);
 	if (result != DOCA_SUCCESS)
@@ -305,9 +312,11 @@ static doca_error_t rdma_read_prepare_and_submit_task(struct rdma_resources *res
 	/* Submit RDMA read task */
 	DOCA_LOG_INFO("Submitting RDMA read task");
 	resources->num_remaining_tasks++;
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_read_as_task(rdma_read_task));
 	result = doca_task_submit(doca_rdma_task_read_as_task(rdma_read_task));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA read task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_read_as_task(rdma_read_task));
 		goto free_task;
 	}
 
@@ -468,6 +477,8 @@ doca_error_t rdma_read_requester(struct rdma_config *cfg)
 	if (cfg->use_rdma_cm == true) {
 		resources.is_requester = true;
 		resources.require_remote_mmap = true;
+		/* Exchange the descriptors in one message on a control buffer registered before connecting */
+		resources.negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP;
 		resources.task_fn = rdma_read_prepare_and_submit_task;
 		result = config_rdma_cm_callback_and_negotiation_task(&resources,
 								      /* need_send_mmap_info */ false,
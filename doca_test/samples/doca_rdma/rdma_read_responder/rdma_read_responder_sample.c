@@ -286,6 +286,8 @@ doca_error_t rdma_read_responder(struct rdma_config *cfg)
 	if (cfg->use_rdma_cm == true) {
 		resources.is_requester = false;
 		resources.require_remote_mmap = true;
+		/* Exchange the descriptors in one message on a control buffer registered before connecting */
+		resources.negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP;
 		resources.task_fn = responder_wait_for_requester_finish;
 		/* Copy the read string to the mmap memory range */
 		memset(resources.mmap_memrange, 0, strlen(resources.cfg->read_string) + 1);
@@ -93,6 +93,12 @@ static void rdma_receive_completed_callback(struct doca_rdma_task_receive *rdma_
 	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_receive_as_task(rdma_receive_task),
+				    RDMA_LATENCY_TASK_RECEIVE,
+				    doca_rdma_task_receive_get_result_rdma_connection(rdma_receive_task),
+				    rdma_latency_buf_len(doca_rdma_task_receive_get_dst_buf(rdma_receive_task)));
+
 	DOCA_LOG_INFO("RDMA receive task was done Successfully");
 
 	/* Read the data that was received */
@@ -152,6 +158,7 @@ static void rdma_receive_error_callback(struct doca_rdma_task_receive *rdma_rece
 	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA receive task failed: %s", doca_error_get_descr(result));
 
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 	result = doca_buf_dec_refcount(resources->dst_buf, NULL);
 	if (result != DOCA_SUCCESS)
@@ -251,9 +258,11 @@ static doca_error_t rdma_receive_prepare_and_submit_task(struct rdma_resources *
 	/* Submit RDMA receive task */
 	DOCA_LOG_INFO("Submitting RDMA receive task");
 	resources->num_remaining_tasks++;
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_receive_as_task(rdma_receive_task));
 	result = doca_task_submit(doca_rdma_task_receive_as_task(rdma_receive_task));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA receive task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_receive_as_task(rdma_receive_task));
 		goto free_task;
 	}
 
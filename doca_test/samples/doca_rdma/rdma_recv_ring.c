@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_pe.h>
+
+#include "rdma_common.h"
+#include "rdma_recv_ring.h"
+
+DOCA_LOG_REGISTER(RDMA::RECV_RING);
+
+/*
+ * Get the slot index of a DOCA buffer that belongs to the ring
+ *
+ * @ring [in]: the ring
+ * @buf [in]: slot buffer
+ * @return: slot index
+ */
+static uint32_t recv_ring_buf_to_slot(struct rdma_recv_ring *ring, const struct doca_buf *buf)
+{
+	void *addr = NULL;
+
+	(void)doca_buf_get_head(buf, &addr);
+	return (uint32_t)(((char *)addr - ring->slab) / ring->attr.slot_size);
+}
+
+/*
+ * Post a receive task on a slot
+ *
+ * @ring [in]: the ring
+ * @task [in]: receive task to post
+ * @slot [in]: slot the task should receive into
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t recv_ring_post(struct rdma_recv_ring *ring, struct doca_rdma_task_receive *task, uint32_t slot)
+{
+	struct doca_buf *buf = ring->bufs[slot];
+
+	(void)doca_buf_reset_data_len(buf);
+	doca_rdma_task_receive_set_dst_buf(task, buf);
+	return doca_task_submit(doca_rdma_task_receive_as_task(task));
+}
+
+/*
+ * Take a free slot, the slots a post failed on come first
+ *
+ * @ring [in]: the ring
+ * @slot [out]: free slot
+ * @return: true if a slot was taken and false if the consumer holds all the free slots
+ */
+static bool recv_ring_take_slot(struct rdma_recv_ring *ring, uint32_t *slot)
+{
+	uint64_t free_slot;
+
+	if (ring->num_stashed > 0) {
+		*slot = ring->stashed[--ring->num_stashed];
+		return true;
+	}
+	if (!spsc_queue_dequeue(ring->free_queue, &free_slot))
+		return false;
+	*slot = (uint32_t)free_slot;
+	return true;
+}
+
+/*
+ * Repost a task on the next free slot, or park it if the consumer holds all the free slots
+ * If the post fails the slot is stashed, the PE thread owns it and takes it again on the next repost
+ *
+ * @ring [in]: the ring
+ * @task [in]: receive task to repost
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t recv_ring_repost(struct rdma_recv_ring *ring, struct doca_rdma_task_receive *task)
+{
+	uint32_t slot;
+	doca_error_t result;
+
+	if (!recv_ring_take_slot(ring, &slot)) {
+		ring->parked[ring->num_parked++] = task;
+		ring->stats.num_parked++;
+		return DOCA_SUCCESS;
+	}
+
+	result = recv_ring_post(ring, task, slot);
+	if (result != DOCA_SUCCESS)
+		ring->stashed[ring->num_stashed++] = slot;
+	return result;
+}
+
+/*
+ * RDMA receive task completed callback: hand the slot to the consumer and repost the task right away
+ *
+ * @rdma_receive_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void recv_ring_completed_callback(struct doca_rdma_task_receive *rdma_receive_task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct rdma_recv_ring *ring = (struct rdma_recv_ring *)task_user_data.ptr;
+	uint32_t slot = recv_ring_buf_to_slot(ring, doca_rdma_task_receive_get_dst_buf(rdma_receive_task));
+	struct rdma_recv_slot *slot_info = &ring->slots[slot];
+	doca_error_t result;
+
+	(void)ctx_user_data;
+
+	slot_info->len = doca_rdma_task_receive_get_result_len(rdma_receive_task);
+	slot_info->opcode = doca_rdma_task_receive_get_result_opcode(rdma_receive_task);
+	if (slot_info->opcode != DOCA_RDMA_OPCODE_RECV_SEND)
+		slot_info->immediate_data = doca_rdma_task_receive_get_result_immediate_data(rdma_receive_task);
+	slot_info->connection = doca_rdma_task_receive_get_result_rdma_connection(rdma_receive_task);
+	ring->stats.num_received++;
+
+	/* The rx queue can hold all the slots, so it is never full */
+	(void)spsc_queue_enqueue(ring->rx_queue, slot);
+
+	if (ring->stopping) {
+		ring->parked[ring->num_parked++] = rdma_receive_task;
+		return;
+	}
+
+	result = recv_ring_repost(ring, rdma_receive_task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to repost RDMA receive task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(ring->first_encountered_error, result);
+		doca_task_free(doca_rdma_task_receive_as_task(rdma_receive_task));
+		ring->num_tasks--;
+		return;
+	}
+	ring->stats.num_reposted++;
+}
+
+/*
+ * RDMA receive task error callback, tasks flushed while the ring is stopping are not considered errors
+ *
+ * @rdma_receive_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void recv_ring_error_callback(struct doca_rdma_task_receive *rdma_receive_task,
+				     union doca_data task_user_data,
+				     union doca_data ctx_user_data)
+{
+	struct rdma_recv_ring *ring = (struct rdma_recv_ring *)task_user_data.ptr;
+	struct doca_task *task = doca_rdma_task_receive_as_task(rdma_receive_task);
+	doca_error_t result = doca_task_get_status(task);
+
+	(void)ctx_user_data;
+
+	if (!ring->stopping) {
+		DOCA_LOG_ERR("RDMA receive task failed: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(ring->first_encountered_error, result);
+		ring->stats.num_errors++;
+	}
+
+	doca_task_free(task);
+	ring->num_tasks--;
+}
+
+doca_error_t rdma_recv_ring_create(struct doca_dev *dev,
+				   struct doca_rdma *rdma,
+				   const struct rdma_recv_ring_attr *attr,
+				   struct rdma_recv_ring **ring)
+{
+	struct rdma_recv_ring *new_ring;
+	long page_size = sysconf(_SC_PAGESIZE);
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	if (attr->num_posted == 0 || attr->num_posted >= attr->num_slots || attr->slot_size == 0) {
+		DOCA_LOG_ERR("Invalid receive ring attributes: %u posted tasks must be less than %u slots",
+			     attr->num_posted,
+			     attr->num_slots);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_ring = calloc(1, sizeof(*new_ring));
+	if (new_ring == NULL) {
+		DOCA_LOG_ERR("Failed to allocate receive ring");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_ring->rdma = rdma;
+	new_ring->attr = *attr;
+	new_ring->first_encountered_error = DOCA_SUCCESS;
+
+	result = doca_rdma_set_recv_queue_size(rdma, attr->num_posted);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set receive queue size to %u: %s",
+			     attr->num_posted,
+			     doca_error_get_descr(result));
+		goto destroy_ring;
+	}
+
+	result = doca_rdma_task_receive_set_conf(rdma,
+						 recv_ring_completed_callback,
+						 recv_ring_error_callback,
+						 attr->num_posted);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA receive task: %s", doca_error_get_descr(result));
+		goto destroy_ring;
+	}
+
+	/* One slab for all slots, so a single registration covers the whole ring */
+	new_ring->slab_len = (size_t)attr->num_slots * attr->slot_size;
+	new_ring->slab_len = (new_ring->slab_len + page_size - 1) / page_size * page_size;
+	new_ring->slab = aligned_alloc(page_size, new_ring->slab_len);
+	new_ring->bufs = calloc(attr->num_slots, sizeof(*new_ring->bufs));
+	new_ring->slots = calloc(attr->num_slots, sizeof(*new_ring->slots));
+	new_ring->parked = calloc(attr->num_posted, sizeof(*new_ring->parked));
+	new_ring->stashed = calloc(attr->num_slots, sizeof(*new_ring->stashed));
+	if (new_ring->slab == NULL || new_ring->bufs == NULL || new_ring->slots == NULL || new_ring->parked == NULL ||
+	    new_ring->stashed == NULL) {
+		DOCA_LOG_ERR("Failed to allocate receive ring memory");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_ring;
+	}
+
+	result = create_local_mmap(&new_ring->mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   new_ring->slab,
+				   new_ring->slab_len,
+				   dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	result = doca_buf_inventory_create(attr->num_slots, &new_ring->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_ring;
+	}
+
+	result = doca_buf_inventory_start(new_ring->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_ring;
+	}
+
+	for (i = 0; i < attr->num_slots; i++) {
+		result = doca_buf_inventory_buf_get_by_addr(new_ring->inventory,
+							    new_ring->mmap,
+							    new_ring->slab + (size_t)i * attr->slot_size,
+							    attr->slot_size,
+							    &new_ring->bufs[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate slot buffer: %s", doca_error_get_descr(result));
+			goto destroy_ring;
+		}
+	}
+
+	result = spsc_queue_create(attr->num_slots, &new_ring->rx_queue);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	result = spsc_queue_create(attr->num_slots, &new_ring->free_queue);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	/* The first num_posted slots are posted on start, the rest are free */
+	for (i = attr->num_posted; i < attr->num_slots; i++)
+		(void)spsc_queue_enqueue(new_ring->free_queue, i);
+
+	*ring = new_ring;
+	return DOCA_SUCCESS;
+
+destroy_ring:
+	tmp_result = rdma_recv_ring_destroy(new_ring);
+	if (tmp_result != DOCA_SUCCESS)
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+doca_error_t rdma_recv_ring_start(struct rdma_recv_ring *ring)
+{
+	struct doca_rdma_task_receive *task;
+	union doca_data task_user_data = {0};
+	doca_error_t result;
+	uint32_t i;
+
+	task_user_data.ptr = ring;
+	for (i = 0; i < ring->attr.num_posted; i++) {
+		result = doca_rdma_task_receive_allocate_init(ring->rdma, ring->bufs[i], task_user_data, &task);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA receive task: %s", doca_error_get_descr(result));
+			return result;
+		}
+		ring->num_tasks++;
+
+		result = recv_ring_post(ring, task, i);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit RDMA receive task: %s", doca_error_get_descr(result));
+			doca_task_free(doca_rdma_task_receive_as_task(task));
+			ring->num_tasks--;
+			return result;
+		}
+	}
+
+	DOCA_LOG_INFO("Receive ring posted %u tasks over %u slots of %u bytes",
+		      ring->attr.num_posted,
+		      ring->attr.num_slots,
+		      ring->attr.slot_size);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_recv_ring_replenish(struct rdma_recv_ring *ring)
+{
+	uint32_t slot;
+	doca_error_t result;
+
+	while (!ring->stopping && ring->num_parked > 0 && recv_ring_take_slot(ring, &slot)) {
+		result = recv_ring_post(ring, ring->parked[ring->num_parked - 1], slot);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to repost parked RDMA receive task: %s", doca_error_get_descr(result));
+			/* Keep the slot for the next replenish, only the consumer enqueues to the free queue */
+			ring->stashed[ring->num_stashed++] = slot;
+			return result;
+		}
+		ring->num_parked--;
+		ring->stats.num_reposted++;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+bool rdma_recv_ring_poll(struct rdma_recv_ring *ring, struct rdma_recv_msg *msg)
+{
+	struct rdma_recv_slot *slot_info;
+	uint64_t slot;
+
+	if (!spsc_queue_dequeue(ring->rx_queue, &slot))
+		return false;
+
+	slot_info = &ring->slots[slot];
+	msg->data = ring->slab + slot * ring->attr.slot_size;
+	msg->len = slot_info->len;
+	msg->slot = (uint32_t)slot;
+	msg->opcode = slot_info->opcode;
+	msg->immediate_data = slot_info->immediate_data;
+	msg->connection = slot_info->connection;
+	return true;
+}
+
+void rdma_recv_ring_release(struct rdma_recv_ring *ring, const struct rdma_recv_msg *msg)
+{
+	/* The free queue can hold all the slots, so it is never full */
+	(void)spsc_queue_enqueue(ring->free_queue, msg->slot);
+}
+
+void rdma_recv_ring_stop(struct rdma_recv_ring *ring)
+{
+	ring->stopping = true;
+}
+
+doca_error_t rdma_recv_ring_destroy(struct rdma_recv_ring *ring)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint32_t i;
+
+	if (ring == NULL)
+		return DOCA_SUCCESS;
+
+	for (i = 0; i < ring->num_parked; i++) {
+		doca_task_free(doca_rdma_task_receive_as_task(ring->parked[i]));
+		ring->num_tasks--;
+	}
+	ring->num_parked = 0;
+
+	if (ring->num_tasks != 0) {
+		DOCA_LOG_ERR("Destroying receive ring with %u tasks still posted", ring->num_tasks);
+		DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_IN_USE);
+	}
+
+	spsc_queue_destroy(ring->free_queue);
+	spsc_queue_destroy(ring->rx_queue);
+
+	if (ring->bufs != NULL) {
+		for (i = 0; i < ring->attr.num_slots; i++) {
+			if (ring->bufs[i] == NULL)
+				continue;
+			tmp_result = doca_buf_dec_refcount(ring->bufs[i], NULL);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to decrease slot buffer count: %s", doca_error_get_descr(tmp_result));
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+			}
+		}
+	}
+
+	if (ring->inventory != NULL) {
+		tmp_result = doca_buf_inventory_stop(ring->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_buf_inventory_destroy(ring->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (ring->mmap != NULL) {
+		tmp_result = doca_mmap_stop(ring->mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_mmap_destroy(ring->mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(ring->stashed);
+	free(ring->parked);
+	free(ring->slots);
+	free(ring->bufs);
+	free(ring->slab);
+	free(ring);
+
+	return result;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_RECV_RING_H_
+#define RDMA_RECV_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_rdma.h>
+
+#include "spsc_queue.h"
+
+/*
+ * Receive engine that keeps a ring of receive tasks posted at all times.
+ *
+ * All receive buffers ("slots") are carved from a single registered slab. num_posted receive tasks are posted when
+ * the ring starts; when one completes, its slot is handed to the application through a lock-free SPSC queue and
+ * the task is immediately reposted on a free slot taken from a second SPSC queue, which the application refills by
+ * releasing the slots it has consumed. The num_slots - num_posted extra slots are the budget of messages the
+ * application may hold before the ring runs out of free slots; only then a task is parked until a slot is released.
+ *
+ * Threading: the completion callbacks, rdma_recv_ring_start(), rdma_recv_ring_replenish() and
+ * rdma_recv_ring_destroy() run on the PE thread. rdma_recv_ring_poll() and rdma_recv_ring_release() may run on a
+ * different (single) consumer thread.
+ */
+
+/* Attributes of a receive ring */
+struct rdma_recv_ring_attr {
+	uint32_t num_slots;  /* Number of receive buffers carved from the slab */
+	uint32_t num_posted; /* Number of receive tasks kept posted, must be smaller than num_slots */
+	uint32_t slot_size;  /* Size of every receive buffer, the largest message that can be received */
+};
+
+/* A received message, valid until it is released */
+struct rdma_recv_msg {
+	void *data;				       /* Received data */
+	uint32_t len;				       /* Length of the received data */
+	uint32_t slot;				       /* Slot index, used to release the message */
+	enum doca_rdma_opcode opcode;		       /* Opcode of the received message */
+	doca_be32_t immediate_data;		       /* Immediate data, only for opcodes that carry it */
+	const struct doca_rdma_connection *connection; /* Connection the message was received on */
+};
+
+/* Metadata of a slot, written by the PE thread before the slot is handed to the consumer */
+struct rdma_recv_slot {
+	uint32_t len;				       /* Length of the received data */
+	enum doca_rdma_opcode opcode;		       /* Opcode of the received message */
+	doca_be32_t immediate_data;		       /* Immediate data, if any */
+	const struct doca_rdma_connection *connection; /* Connection the message was received on */
+};
+
+/* Counters of a receive ring, updated by the PE thread */
+struct rdma_recv_ring_stats {
+	uint64_t num_received; /* Number of successfully received messages */
+	uint64_t num_reposted; /* Number of receive tasks reposted from the completion callback */
+	uint64_t num_parked;   /* Number of times a task had to wait for a free slot */
+	uint64_t num_errors;   /* Number of receive tasks completed with an error, excluding flushes on stop */
+};
+
+struct rdma_recv_ring {
+	struct doca_rdma *rdma;			   /* DOCA RDMA the receive tasks are posted on */
+	struct rdma_recv_ring_attr attr;	   /* Ring attributes */
+	char *slab;				   /* Memory of all slots */
+	size_t slab_len;			   /* Length of slab */
+	struct doca_mmap *mmap;			   /* Registration of slab */
+	struct doca_buf_inventory *inventory;	   /* Inventory for the slot buffers */
+	struct doca_buf **bufs;			   /* One DOCA buffer per slot */
+	struct rdma_recv_slot *slots;		   /* Metadata per slot */
+	struct doca_rdma_task_receive **parked;	   /* Tasks waiting for a free slot */
+	uint32_t num_parked;			   /* Number of entries in parked */
+	uint32_t *stashed;			   /* Free slots a post failed on, owned by the PE thread */
+	uint32_t num_stashed;			   /* Number of entries in stashed */
+	uint32_t num_tasks;			   /* Number of receive tasks that are allocated (posted or parked) */
+	struct spsc_queue *rx_queue;		   /* Received slots, PE thread to consumer */
+	struct spsc_queue *free_queue;		   /* Released slots, consumer to PE thread */
+	bool stopping;				   /* Set once the ring should not repost anymore */
+	struct rdma_recv_ring_stats stats;	   /* Ring counters */
+	doca_error_t first_encountered_error;	   /* First error encountered by the ring */
+};
+
+/*
+ * Create a receive ring on a DOCA RDMA that was not started yet
+ * Sets the receive task configuration and the receive queue size of the DOCA RDMA, so the application must not
+ * configure receive tasks itself
+ *
+ * @dev [in]: DOCA device the DOCA RDMA was created on
+ * @rdma [in]: DOCA RDMA, before doca_ctx_start()
+ * @attr [in]: ring attributes
+ * @ring [out]: the created ring
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_recv_ring_create(struct doca_dev *dev,
+				   struct doca_rdma *rdma,
+				   const struct rdma_recv_ring_attr *attr,
+				   struct rdma_recv_ring **ring);
+
+/*
+ * Post all the receive tasks of the ring, must be called once the DOCA RDMA is running and before the peer starts
+ * sending
+ *
+ * @ring [in]: the ring
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_recv_ring_start(struct rdma_recv_ring *ring);
+
+/*
+ * Repost parked tasks on slots released since they were parked, called from the PE thread progress loop
+ *
+ * @ring [in]: the ring
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_recv_ring_replenish(struct rdma_recv_ring *ring);
+
+/*
+ * Get the next received message, called by the consumer
+ *
+ * @ring [in]: the ring
+ * @msg [out]: the received message
+ * @return: true if a message was received, false otherwise
+ */
+bool rdma_recv_ring_poll(struct rdma_recv_ring *ring, struct rdma_recv_msg *msg);
+
+/*
+ * Return the slot of a consumed message to the ring, called by the consumer
+ *
+ * @ring [in]: the ring
+ * @msg [in]: a message returned by rdma_recv_ring_poll()
+ */
+void rdma_recv_ring_release(struct rdma_recv_ring *ring, const struct rdma_recv_msg *msg);
+
+/*
+ * Stop reposting receive tasks, must be called before the DOCA RDMA is stopped so flushed tasks are not reposted
+ *
+ * @ring [in]: the ring
+ */
+void rdma_recv_ring_stop(struct rdma_recv_ring *ring);
+
+/*
+ * Destroy a receive ring, must be called after the DOCA RDMA was stopped
+ *
+ * @ring [in]: the ring
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_recv_ring_destroy(struct rdma_recv_ring *ring);
+
+#endif /* RDMA_RECV_RING_H_ */
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+#include "rdma_recv_ring.h"
+
+DOCA_LOG_REGISTER(RDMA_RECV_RING_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_recv_ring_bench(struct rdma_bench_config *cfg, struct rdma_recv_ring_attr *ring_attr);
+
+#define DEFAULT_RING_SLOTS (1024) /* Default number of receive buffers */
+#define DEFAULT_RING_POSTED (512) /* Default number of receive tasks kept posted */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct recv_ring_bench_config {
+	struct rdma_bench_config bench;	      /* Benchmark configuration */
+	struct rdma_recv_ring_attr ring_attr; /* Receive ring attributes, slot size follows the message size */
+};
+
+/*
+ * ARGP Callback - Handle number of ring slots parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ring_slots_callback(void *param, void *config)
+{
+	struct recv_ring_bench_config *cfg = (struct recv_ring_bench_config *)config;
+	const int num_slots = *(int *)param;
+
+	if (num_slots <= 1) {
+		DOCA_LOG_ERR("Number of ring slots must be greater than 1");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->ring_attr.num_slots = (uint32_t)num_slots;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of posted receive tasks parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ring_posted_callback(void *param, void *config)
+{
+	struct recv_ring_bench_config *cfg = (struct recv_ring_bench_config *)config;
+	const int num_posted = *(int *)param;
+
+	if (num_posted <= 0) {
+		DOCA_LOG_ERR("Number of posted receive tasks must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->ring_attr.num_posted = (uint32_t)num_posted;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the receive ring parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_ring_params(void)
+{
+	struct doca_argp_param *slots_param, *posted_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&slots_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(slots_param, "rs");
+	doca_argp_param_set_long_name(slots_param, "ring-slots");
+	doca_argp_param_set_arguments(slots_param, "<num>");
+	doca_argp_param_set_description(slots_param, "Number of receive buffers carved from the slab (optional)");
+	doca_argp_param_set_callback(slots_param, ring_slots_callback);
+	doca_argp_param_set_type(slots_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(slots_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&posted_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(posted_param, "rp");
+	doca_argp_param_set_long_name(posted_param, "ring-posted");
+	doca_argp_param_set_arguments(posted_param, "<num>");
+	doca_argp_param_set_description(posted_param,
+					"Number of receive tasks kept posted, must be less than ring-slots (optional)");
+	doca_argp_param_set_callback(posted_param, ring_posted_callback);
+	doca_argp_param_set_type(posted_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(posted_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct recv_ring_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.ring_attr.num_slots = DEFAULT_RING_SLOTS;
+	cfg.ring_attr.num_posted = DEFAULT_RING_POSTED;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_recv_ring_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark params */
+	result = register_rdma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register receive ring params */
+	result = register_ring_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register receive ring parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_recv_ring_bench(&cfg.bench, &cfg.ring_attr);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_recv_ring_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
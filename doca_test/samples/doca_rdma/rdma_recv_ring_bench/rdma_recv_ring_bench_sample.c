@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+#include "rdma_recv_ring.h"
+
+DOCA_LOG_REGISTER(RDMA_RECV_RING_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024)	     /* Number of PE progress calls between two deadline checks */
+#define DRAIN_TIMEOUT_NS (BENCH_NSEC_PER_SEC) /* Time to wait for in-flight messages after the sender stopped */
+
+/* Benchmark state */
+struct recv_ring_bench {
+	struct rdma_bench_config *cfg;		/* Benchmark configuration */
+	struct doca_dev *dev;			/* DOCA device */
+	struct doca_pe *pe;			/* Progress engine driving both endpoints */
+	struct rdma_bench_endpoint sender;	/* Endpoint submitting the send tasks */
+	struct rdma_bench_endpoint receiver;	/* Endpoint owning the receive ring */
+	struct rdma_recv_ring *ring;		/* Receive ring of the receiver */
+	char *send_buffer;			/* Source memory of the send tasks */
+	size_t send_buffer_len;			/* Length of send_buffer */
+	struct doca_mmap *send_mmap;		/* Registration of send_buffer */
+	struct doca_buf_inventory *inventory;	/* Inventory for the send buffers */
+	struct doca_rdma_task_send **tasks;	/* Send tasks, NULL entries were already released */
+	uint32_t num_inflight;			/* Number of submitted send tasks that have not completed yet */
+	bool running;				/* Whether completed send tasks should be resubmitted */
+	uint64_t num_sent;			/* Number of successfully sent messages */
+	uint64_t num_send_errors;		/* Number of send tasks that failed, i.e. messages the receiver lost */
+	pthread_t consumer;			/* Consumer thread */
+	atomic_bool consumer_stop;		/* Set by the PE thread to stop the consumer */
+	_Atomic uint64_t num_consumed;		/* Number of messages processed by the consumer */
+	_Atomic uint64_t num_bad_messages;	/* Number of messages with unexpected length */
+	doca_error_t first_encountered_error;	/* First error encountered by the benchmark */
+};
+
+/*
+ * Release a send task and its buffer
+ *
+ * @bench [in]: benchmark state
+ * @task_idx [in]: task index
+ */
+static void release_send_task(struct recv_ring_bench *bench, uint32_t task_idx)
+{
+	struct doca_rdma_task_send *task = bench->tasks[task_idx];
+	struct doca_buf *src_buf;
+
+	if (task == NULL)
+		return;
+
+	src_buf = (struct doca_buf *)doca_rdma_task_send_get_src_buf(task);
+	doca_task_free(doca_rdma_task_send_as_task(task));
+	if (src_buf != NULL)
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+	bench->tasks[task_idx] = NULL;
+}
+
+/*
+ * RDMA send task completed callback, resubmits the task as long as the benchmark is running
+ *
+ * @rdma_send_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void send_completed_callback(struct doca_rdma_task_send *rdma_send_task,
+				    union doca_data task_user_data,
+				    union doca_data ctx_user_data)
+{
+	struct recv_ring_bench *bench = (struct recv_ring_bench *)ctx_user_data.ptr;
+	doca_error_t result;
+
+	bench->num_sent++;
+
+	if (bench->running) {
+		result = doca_task_submit(doca_rdma_task_send_as_task(rdma_send_task));
+		if (result == DOCA_SUCCESS)
+			return;
+		DOCA_LOG_ERR("Failed to resubmit RDMA send task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(bench->first_encountered_error, result);
+		bench->running = false;
+	}
+
+	release_send_task(bench, (uint32_t)task_user_data.u64);
+	bench->num_inflight--;
+}
+
+/*
+ * RDMA send task error callback, a failed send means the receiver did not have a buffer posted in time
+ *
+ * @rdma_send_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void send_error_callback(struct doca_rdma_task_send *rdma_send_task,
+				union doca_data task_user_data,
+				union doca_data ctx_user_data)
+{
+	struct recv_ring_bench *bench = (struct recv_ring_bench *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_send_as_task(rdma_send_task));
+
+	DOCA_LOG_ERR("RDMA send task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(bench->first_encountered_error, result);
+	bench->num_send_errors++;
+	bench->running = false;
+
+	release_send_task(bench, (uint32_t)task_user_data.u64);
+	bench->num_inflight--;
+}
+
+/*
+ * Consumer thread: drain the receive ring, touch every message and release its slot
+ *
+ * @arg [in]: benchmark state
+ * @return: NULL
+ */
+static void *consumer_thread(void *arg)
+{
+	struct recv_ring_bench *bench = (struct recv_ring_bench *)arg;
+	struct rdma_recv_msg msg;
+	volatile char sink;
+
+	while (!atomic_load_explicit(&bench->consumer_stop, memory_order_acquire)) {
+		if (!rdma_recv_ring_poll(bench->ring, &msg))
+			continue;
+
+		if (msg.len != bench->cfg->msg_size)
+			atomic_fetch_add_explicit(&bench->num_bad_messages, 1, memory_order_relaxed);
+		else
+			sink = ((char *)msg.data)[0] ^ ((char *)msg.data)[msg.len - 1];
+
+		rdma_recv_ring_release(bench->ring, &msg);
+		atomic_fetch_add_explicit(&bench->num_consumed, 1, memory_order_relaxed);
+	}
+	(void)sink;
+
+	return NULL;
+}
+
+/*
+ * Register the send buffer and allocate one send task per outstanding message
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_send_tasks(struct recv_ring_bench *bench)
+{
+	struct rdma_bench_config *cfg = bench->cfg;
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf;
+	doca_error_t result;
+	uint32_t i;
+
+	bench->send_buffer_len = (size_t)cfg->queue_depth * cfg->msg_size;
+	bench->send_buffer = malloc(bench->send_buffer_len);
+	bench->tasks = calloc(cfg->queue_depth, sizeof(*bench->tasks));
+	if (bench->send_buffer == NULL || bench->tasks == NULL) {
+		DOCA_LOG_ERR("Failed to allocate send resources");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(bench->send_buffer, 0xA5, bench->send_buffer_len);
+
+	result = create_local_mmap(&bench->send_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   bench->send_buffer,
+				   bench->send_buffer_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_create(cfg->queue_depth, &bench->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(bench->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (i = 0; i < cfg->queue_depth; i++) {
+		result = doca_buf_inventory_buf_get_by_data(bench->inventory,
+							    bench->send_mmap,
+							    bench->send_buffer + (size_t)i * cfg->msg_size,
+							    cfg->msg_size,
+							    &src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate source buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		task_user_data.u64 = i;
+		result = doca_rdma_task_send_allocate_init(bench->sender.rdma,
+							   bench->sender.connections[0],
+							   src_buf,
+							   task_user_data,
+							   &bench->tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA send task: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(src_buf, NULL);
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Destroy the send tasks, buffers and registration
+ *
+ * @bench [in]: benchmark state
+ */
+static void destroy_send_tasks(struct recv_ring_bench *bench)
+{
+	uint32_t i;
+
+	if (bench->tasks != NULL) {
+		for (i = 0; i < bench->cfg->queue_depth; i++)
+			release_send_task(bench, i);
+		free(bench->tasks);
+	}
+
+	if (bench->inventory != NULL) {
+		(void)doca_buf_inventory_stop(bench->inventory);
+		(void)doca_buf_inventory_destroy(bench->inventory);
+	}
+
+	if (bench->send_mmap != NULL) {
+		(void)doca_mmap_stop(bench->send_mmap);
+		(void)doca_mmap_destroy(bench->send_mmap);
+	}
+
+	free(bench->send_buffer);
+}
+
+/*
+ * Stream messages to the receive ring until the deadline and wait for the consumer to process all of them
+ *
+ * @bench [in]: benchmark state
+ * @elapsed_ns [out]: length of the timed region
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_stream(struct recv_ring_bench *bench, uint64_t *elapsed_ns)
+{
+	uint64_t start_ns, deadline_ns, num_polls = 0;
+	doca_error_t result;
+	uint32_t i;
+
+	bench->running = true;
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < bench->cfg->queue_depth; i++) {
+		result = doca_task_submit(doca_rdma_task_send_as_task(bench->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit RDMA send task: %s", doca_error_get_descr(result));
+			DOCA_ERROR_PROPAGATE(bench->first_encountered_error, result);
+			bench->running = false;
+			break;
+		}
+		bench->num_inflight++;
+	}
+
+	while (bench->running || bench->num_inflight > 0) {
+		(void)doca_pe_progress(bench->pe);
+		result = rdma_recv_ring_replenish(bench->ring);
+		if (result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(bench->first_encountered_error, result);
+			bench->running = false;
+		}
+		if ((++num_polls % TIME_CHECK_INTERVAL) == 0 && bench->running && bench_get_time_ns() >= deadline_ns)
+			bench->running = false;
+	}
+
+	/* Every completed send has a matching receive, wait for the consumer to catch up */
+	deadline_ns = bench_get_time_ns() + DRAIN_TIMEOUT_NS;
+	while (atomic_load_explicit(&bench->num_consumed, memory_order_relaxed) < bench->num_sent &&
+	       bench_get_time_ns() < deadline_ns) {
+		(void)doca_pe_progress(bench->pe);
+		(void)rdma_recv_ring_replenish(bench->ring);
+	}
+
+	*elapsed_ns = bench_get_time_ns() - start_ns;
+	return bench->first_encountered_error;
+}
+
+/*
+ * Stream messages from a sender to a receive ring over a NIC loopback connection and report the sustained rate
+ *
+ * @cfg [in]: Configuration parameters
+ * @ring_attr [in]: Receive ring attributes
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_recv_ring_bench(struct rdma_bench_config *cfg, struct rdma_recv_ring_attr *ring_attr)
+{
+	struct recv_ring_bench bench = {0};
+	struct rdma_bench_endpoint_attr attr = {0};
+	union doca_data ctx_user_data = {0};
+	uint64_t elapsed_ns = 0, num_consumed;
+	bool consumer_started = false;
+	doca_error_t result, tmp_result;
+
+	bench.cfg = cfg;
+	bench.first_encountered_error = DOCA_SUCCESS;
+	atomic_init(&bench.consumer_stop, false);
+	atomic_init(&bench.num_consumed, 0);
+	atomic_init(&bench.num_bad_messages, 0);
+	ring_attr->slot_size = cfg->msg_size;
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_receive_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	attr.num_connections = 1;
+	attr.transport_type = cfg->rdma.transport_type;
+	attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	attr.gid_index = cfg->rdma.gid_index;
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+
+	attr.send_queue_size = cfg->queue_depth;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &attr, &bench.sender);
+	if (result != DOCA_SUCCESS)
+		goto destroy_pe;
+
+	/* The receive queue size of the receiver is set by the ring */
+	attr.send_queue_size = 0;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &attr, &bench.receiver);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = doca_rdma_task_send_set_conf(bench.sender.rdma,
+					      send_completed_callback,
+					      send_error_callback,
+					      cfg->queue_depth);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA send task: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	ctx_user_data.ptr = &bench;
+	result = doca_ctx_set_user_data(bench.sender.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	result = rdma_recv_ring_create(bench.dev, bench.receiver.rdma, ring_attr, &bench.ring);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.sender);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.receiver);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	result = rdma_bench_connect_loopback(&bench.sender, &bench.receiver, 1);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	/* Pre-post the whole ring before the first message can arrive, no sequencing with the sender is needed */
+	result = rdma_recv_ring_start(bench.ring);
+	if (result != DOCA_SUCCESS)
+		goto destroy_ring;
+
+	result = prepare_send_tasks(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_send_tasks;
+
+	if (pthread_create(&bench.consumer, NULL, consumer_thread, &bench) != 0) {
+		DOCA_LOG_ERR("Failed to create consumer thread");
+		result = DOCA_ERROR_OPERATING_SYSTEM;
+		goto destroy_send_tasks;
+	}
+	consumer_started = true;
+
+	result = run_stream(&bench, &elapsed_ns);
+
+	atomic_store_explicit(&bench.consumer_stop, true, memory_order_release);
+	pthread_join(bench.consumer, NULL);
+	consumer_started = false;
+
+	num_consumed = atomic_load(&bench.num_consumed);
+	DOCA_LOG_INFO("Message size %u, send depth %u, ring of %u slots with %u posted",
+		      cfg->msg_size,
+		      cfg->queue_depth,
+		      ring_attr->num_slots,
+		      ring_attr->num_posted);
+	DOCA_LOG_INFO("Sent %lu, received %lu, consumed %lu, lost %lu, bad length %lu",
+		      bench.num_sent,
+		      bench.ring->stats.num_received,
+		      num_consumed,
+		      bench.num_send_errors + (bench.num_sent - bench.ring->stats.num_received),
+		      atomic_load(&bench.num_bad_messages));
+	DOCA_LOG_INFO("Reposted from completion %lu, parked waiting for the consumer %lu",
+		      bench.ring->stats.num_reposted,
+		      bench.ring->stats.num_parked);
+	if (elapsed_ns != 0)
+		DOCA_LOG_INFO("Receive rate: %.3f Mmsg/s, %.3f Gbit/s",
+			      (double)num_consumed * 1000.0 / (double)elapsed_ns,
+			      (double)num_consumed * cfg->msg_size * 8.0 / (double)elapsed_ns);
+
+	if (result == DOCA_SUCCESS && (num_consumed != bench.num_sent || atomic_load(&bench.num_bad_messages) != 0))
+		result = DOCA_ERROR_UNEXPECTED;
+
+destroy_send_tasks:
+	if (consumer_started) {
+		atomic_store_explicit(&bench.consumer_stop, true, memory_order_release);
+		pthread_join(bench.consumer, NULL);
+	}
+	destroy_send_tasks(&bench);
+destroy_ring:
+	/* Posted receive tasks are flushed to the ring error callback while the receiver stops */
+	rdma_recv_ring_stop(bench.ring);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.receiver);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_recv_ring_destroy(bench.ring);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_endpoints:
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.sender);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.receiver);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_pe:
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
@@ -91,6 +91,12 @@ static void rdma_send_completed_callback(struct doca_rdma_task_send *rdma_send_t
 	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_send_as_task(rdma_send_task),
+				    RDMA_LATENCY_TASK_SEND,
+				    doca_rdma_task_send_get_rdma_connection(rdma_send_task),
+				    rdma_latency_buf_len(doca_rdma_task_send_get_src_buf(rdma_send_task)));
+
 	DOCA_LOG_INFO("RDMA send task was done successfully");
 
 	doca_task_free(doca_rdma_task_send_as_task(rdma_send_task));
@@ -133,6 +139,7 @@ static void rdma_send_error_callback(struct doca_rdma_task_send *rdma_send_task,
 	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA send task failed: %s", doca_error_get_descr(result));
 
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 	result = doca_buf_dec_refcount(resources->src_buf, NULL);
 	if (result != DOCA_SUCCESS)
@@ -247,9 +254,11 @@ static doca_error_t rdma_send_prepare_and_submit_task(struct rdma_resources *res
 	/* Submit RDMA send task */
 	DOCA_LOG_INFO("Submitting RDMA send task that sends \"%s\" to receiver", resources->cfg->send_string);
 	resources->num_remaining_tasks++;
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_send_as_task(rdma_send_task));
 	result = doca_task_submit(doca_rdma_task_send_as_task(rdma_send_task));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA send task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_send_as_task(rdma_send_task));
 		goto free_task;
 	}
 
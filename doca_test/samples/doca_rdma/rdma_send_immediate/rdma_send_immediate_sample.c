@@ -92,6 +92,12 @@ static void rdma_send_imm_completed_callback(struct doca_rdma_task_send_imm *rdm
 	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_send_imm_as_task(rdma_send_imm_task),
+				    RDMA_LATENCY_TASK_SEND_IMM,
+				    doca_rdma_task_send_imm_get_rdma_connection(rdma_send_imm_task),
+				    rdma_latency_buf_len(doca_rdma_task_send_imm_get_src_buf(rdma_send_imm_task)));
+
 	DOCA_LOG_INFO("RDMA send with immediate task was done successfully");
 
 	doca_task_free(doca_rdma_task_send_imm_as_task(rdma_send_imm_task));
@@ -134,6 +140,7 @@ static void rdma_send_imm_error_callback(struct doca_rdma_task_send_imm *rdma_se
 	DOCA_ERROR_PROPAGATE(*first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA send with immediate task failed: %s", doca_error_get_descr(result));
 
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 	result = doca_buf_dec_refcount(resources->src_buf, NULL);
 	if (result != DOCA_SUCCESS)
@@ -251,9 +258,11 @@ static doca_error_t rdma_send_immediate_prepare_and_submit_task(struct rdma_reso
 		      resources->cfg->send_string,
 		      EXAMPLE_IMMEDIATE_VALUE);
 	resources->num_remaining_tasks++;
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_send_imm_as_task(rdma_send_imm_task));
 	result = doca_task_submit(doca_rdma_task_send_imm_as_task(rdma_send_imm_task));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA send with immediate task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_send_imm_as_task(rdma_send_imm_task));
 		goto free_task;
 	}
 
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_pe.h>
+
+#include "bench_common.h"
+#include "rdma_common.h"
+#include "rdma_signal.h"
+
+DOCA_LOG_REGISTER(RDMA::SIGNAL);
+
+#define TIME_CHECK_INTERVAL (1024) /* Number of event reads between two deadline checks */
+
+/*
+ * Return a completed notify task to the free stack
+ *
+ * @producer [in]: the producer
+ * @task [in]: completed task
+ */
+static void signal_release_task(struct rdma_signal_producer *producer,
+				struct doca_rdma_task_remote_net_sync_event_notify_add *task)
+{
+	void *addr = NULL;
+
+	(void)doca_buf_get_head(doca_rdma_task_remote_net_sync_event_notify_add_get_result_buf(task), &addr);
+	producer->free_tasks[producer->num_free++] = (uint32_t)((uint64_t *)addr - producer->results);
+	producer->num_inflight--;
+}
+
+/*
+ * RDMA remote net sync event notify add task completed callback, the task stays allocated and becomes free
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void signal_completed_callback(struct doca_rdma_task_remote_net_sync_event_notify_add *task,
+				      union doca_data task_user_data,
+				      union doca_data ctx_user_data)
+{
+	struct rdma_signal_producer *producer = (struct rdma_signal_producer *)task_user_data.ptr;
+
+	(void)ctx_user_data;
+
+	producer->stats.num_signals++;
+	producer->stats.num_items += doca_rdma_task_remote_net_sync_event_notify_add_get_add_data(task);
+	signal_release_task(producer, task);
+}
+
+/*
+ * RDMA remote net sync event notify add task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void signal_error_callback(struct doca_rdma_task_remote_net_sync_event_notify_add *task,
+				  union doca_data task_user_data,
+				  union doca_data ctx_user_data)
+{
+	struct rdma_signal_producer *producer = (struct rdma_signal_producer *)task_user_data.ptr;
+	doca_error_t result =
+		doca_task_get_status(doca_rdma_task_remote_net_sync_event_notify_add_as_task(task));
+
+	(void)ctx_user_data;
+
+	DOCA_LOG_ERR("RDMA remote net sync event notify add task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(producer->first_encountered_error, result);
+	producer->stats.num_errors++;
+	signal_release_task(producer, task);
+}
+
+doca_error_t rdma_signal_cap_is_supported(const struct doca_devinfo *devinfo)
+{
+	doca_error_t result;
+
+	result = doca_rdma_cap_task_remote_net_sync_event_notify_add_is_supported(devinfo);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Device does not support remote net sync event notify add task: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_sync_event_cap_is_export_to_remote_net_supported(devinfo);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Device does not support exporting a sync event to a remote net: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_sync_event_cap_remote_net_is_create_from_export_supported(devinfo);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Device does not support creating a remote net sync event from an export: %s",
+			     doca_error_get_descr(result));
+
+	return result;
+}
+
+doca_error_t rdma_signal_consumer_create(struct doca_dev *dev, struct rdma_signal_consumer **consumer)
+{
+	struct rdma_signal_consumer *new_consumer;
+	doca_error_t result, tmp_result;
+
+	new_consumer = calloc(1, sizeof(*new_consumer));
+	if (new_consumer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate signal consumer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = doca_sync_event_create(&new_consumer->event);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA sync event: %s", doca_error_get_descr(result));
+		free(new_consumer);
+		return result;
+	}
+
+	result = doca_sync_event_add_publisher_location_remote_net(new_consumer->event);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DOCA sync event publisher: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	result = doca_sync_event_add_subscriber_location_cpu(new_consumer->event, dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DOCA sync event subscriber: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	result = doca_sync_event_start(new_consumer->event);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA sync event: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	result = doca_sync_event_export_to_remote_net(new_consumer->event,
+						      &new_consumer->export_desc,
+						      &new_consumer->export_desc_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to export DOCA sync event: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	/* A started event starts at 0, which no signal has consumed yet */
+	*consumer = new_consumer;
+	return DOCA_SUCCESS;
+
+destroy_consumer:
+	tmp_result = rdma_signal_consumer_destroy(new_consumer);
+	if (tmp_result != DOCA_SUCCESS)
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+doca_error_t rdma_signal_consumer_poll(struct rdma_signal_consumer *consumer, uint64_t *num_items)
+{
+	uint64_t value;
+	doca_error_t result;
+
+	result = doca_sync_event_get(consumer->event, &value);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read DOCA sync event: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	*num_items = value - consumer->consumed;
+	consumer->consumed = value;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_signal_consumer_wait(struct rdma_signal_consumer *consumer, uint64_t timeout_ns, uint64_t *num_items)
+{
+	uint64_t deadline_ns = 0, num_polls = 0;
+	doca_error_t result;
+
+	if (timeout_ns == 0) {
+		result = doca_sync_event_wait_gt(consumer->event, consumer->consumed, UINT64_MAX);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to wait for DOCA sync event: %s", doca_error_get_descr(result));
+			return result;
+		}
+		return rdma_signal_consumer_poll(consumer, num_items);
+	}
+
+	for (;;) {
+		result = rdma_signal_consumer_poll(consumer, num_items);
+		if (result != DOCA_SUCCESS || *num_items != 0)
+			return result;
+		if ((++num_polls % TIME_CHECK_INTERVAL) != 0)
+			continue;
+		/* The clock is only read once the wait did not end within the first interval */
+		if (deadline_ns == 0)
+			deadline_ns = bench_get_time_ns() + timeout_ns;
+		else if (bench_get_time_ns() >= deadline_ns)
+			return DOCA_ERROR_TIME_OUT;
+	}
+}
+
+doca_error_t rdma_signal_consumer_destroy(struct rdma_signal_consumer *consumer)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (consumer == NULL)
+		return DOCA_SUCCESS;
+
+	/* Stopping a sync event that was not started fails harmlessly */
+	(void)doca_sync_event_stop(consumer->event);
+
+	tmp_result = doca_sync_event_destroy(consumer->event);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA sync event: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	free(consumer);
+	return result;
+}
+
+doca_error_t rdma_signal_producer_create(struct doca_dev *dev,
+					 struct doca_rdma *rdma,
+					 uint32_t num_tasks,
+					 struct rdma_signal_producer **producer)
+{
+	struct rdma_signal_producer *new_producer;
+	long page_size = sysconf(_SC_PAGESIZE);
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	if (num_tasks == 0) {
+		DOCA_LOG_ERR("Signal producer needs at least one notify task");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_producer = calloc(1, sizeof(*new_producer));
+	if (new_producer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate signal producer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_producer->dev = dev;
+	new_producer->rdma = rdma;
+	new_producer->num_tasks = num_tasks;
+	new_producer->first_encountered_error = DOCA_SUCCESS;
+
+	result = doca_rdma_task_remote_net_sync_event_notify_add_set_conf(rdma,
+									  signal_completed_callback,
+									  signal_error_callback,
+									  num_tasks);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA remote net sync event notify add task: %s",
+			     doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	/* Every task gets its own result word, the value before the add is written there on completion */
+	new_producer->results_len = (size_t)num_tasks * sizeof(*new_producer->results);
+	new_producer->results_len = (new_producer->results_len + page_size - 1) / page_size * page_size;
+	new_producer->results = aligned_alloc(page_size, new_producer->results_len);
+	new_producer->bufs = calloc(num_tasks, sizeof(*new_producer->bufs));
+	new_producer->tasks = calloc(num_tasks, sizeof(*new_producer->tasks));
+	new_producer->free_tasks = calloc(num_tasks, sizeof(*new_producer->free_tasks));
+	if (new_producer->results == NULL || new_producer->bufs == NULL || new_producer->tasks == NULL ||
+	    new_producer->free_tasks == NULL) {
+		DOCA_LOG_ERR("Failed to allocate signal producer memory");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_producer;
+	}
+
+	result = create_local_mmap(&new_producer->mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   new_producer->results,
+				   new_producer->results_len,
+				   dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_producer;
+
+	result = doca_buf_inventory_create(num_tasks, &new_producer->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	result = doca_buf_inventory_start(new_producer->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	for (i = 0; i < num_tasks; i++) {
+		result = doca_buf_inventory_buf_get_by_addr(new_producer->inventory,
+							    new_producer->mmap,
+							    &new_producer->results[i],
+							    sizeof(*new_producer->results),
+							    &new_producer->bufs[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate result buffer: %s", doca_error_get_descr(result));
+			goto destroy_producer;
+		}
+	}
+
+	*producer = new_producer;
+	return DOCA_SUCCESS;
+
+destroy_producer:
+	tmp_result = rdma_signal_producer_destroy(new_producer);
+	if (tmp_result != DOCA_SUCCESS)
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+doca_error_t rdma_signal_producer_start(struct rdma_signal_producer *producer,
+					struct doca_rdma_connection *connection,
+					const uint8_t *export_desc,
+					size_t export_desc_len)
+{
+	union doca_data task_user_data = {0};
+	doca_error_t result;
+	uint32_t i;
+
+	result = doca_sync_event_remote_net_create_from_export(producer->dev,
+							       export_desc,
+							       export_desc_len,
+							       &producer->remote_event);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create remote sync event from export: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	task_user_data.ptr = producer;
+	for (i = 0; i < producer->num_tasks; i++) {
+		result = doca_rdma_task_remote_net_sync_event_notify_add_allocate_init(producer->rdma,
+										       connection,
+										       producer->remote_event,
+										       producer->bufs[i],
+										       1,
+										       task_user_data,
+										       &producer->tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA remote net sync event notify add task: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	/* Push in reverse order so the first signals use the first tasks */
+	for (i = producer->num_tasks; i > 0; i--)
+		producer->free_tasks[producer->num_free++] = i - 1;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_signal(struct rdma_signal_producer *producer,
+			 struct doca_rdma_connection *connection,
+			 uint64_t count)
+{
+	struct doca_rdma_task_remote_net_sync_event_notify_add *task;
+	doca_error_t result;
+	uint32_t idx;
+
+	if (producer->num_free == 0) {
+		producer->stats.num_busy++;
+		return DOCA_ERROR_AGAIN;
+	}
+
+	idx = producer->free_tasks[--producer->num_free];
+	task = producer->tasks[idx];
+
+	/* The previous completion filled the result buffer */
+	(void)doca_buf_reset_data_len(producer->bufs[idx]);
+	doca_rdma_task_remote_net_sync_event_notify_add_set_add_data(task, count);
+	doca_rdma_task_remote_net_sync_event_notify_add_set_rdma_connection(task, connection);
+
+	result = doca_task_submit(doca_rdma_task_remote_net_sync_event_notify_add_as_task(task));
+	if (result != DOCA_SUCCESS) {
+		producer->free_tasks[producer->num_free++] = idx;
+		return result;
+	}
+	producer->num_inflight++;
+
+	return DOCA_SUCCESS;
+}
+
+uint32_t rdma_signal_get_num_inflight(const struct rdma_signal_producer *producer)
+{
+	return producer->num_inflight;
+}
+
+doca_error_t rdma_signal_producer_destroy(struct rdma_signal_producer *producer)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint32_t i;
+
+	if (producer == NULL)
+		return DOCA_SUCCESS;
+
+	if (producer->num_inflight != 0) {
+		DOCA_LOG_ERR("Destroying signal producer with %u signals in flight", producer->num_inflight);
+		return DOCA_ERROR_IN_USE;
+	}
+
+	if (producer->tasks != NULL) {
+		for (i = 0; i < producer->num_tasks; i++) {
+			if (producer->tasks[i] == NULL)
+				continue;
+			doca_task_free(doca_rdma_task_remote_net_sync_event_notify_add_as_task(producer->tasks[i]));
+		}
+	}
+
+	if (producer->remote_event != NULL) {
+		tmp_result = doca_sync_event_remote_net_destroy(producer->remote_event);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA remote sync event: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (producer->bufs != NULL) {
+		for (i = 0; i < producer->num_tasks; i++) {
+			if (producer->bufs[i] == NULL)
+				continue;
+			tmp_result = doca_buf_dec_refcount(producer->bufs[i], NULL);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to decrease result buffer count: %s",
+					     doca_error_get_descr(tmp_result));
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+			}
+		}
+	}
+
+	if (producer->inventory != NULL) {
+		tmp_result = doca_buf_inventory_stop(producer->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_buf_inventory_destroy(producer->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (producer->mmap != NULL) {
+		tmp_result = doca_mmap_stop(producer->mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_mmap_destroy(producer->mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(producer->free_tasks);
+	free(producer->tasks);
+	free(producer->bufs);
+	free(producer->results);
+	free(producer);
+
+	return result;
+}
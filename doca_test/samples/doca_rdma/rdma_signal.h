@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_SIGNAL_H_
+#define RDMA_SIGNAL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_rdma.h>
+#include <doca_sync_event.h>
+
+/*
+ * Completion signaling through a remote sync event, instead of a flag the consumer polls in the payload memory.
+ *
+ * The consumer owns a sync event published by the remote network and subscribed by its CPU, and hands its export to
+ * the producer during negotiation. After posting a batch of RDMA writes the producer posts one
+ * remote_net_sync_event_notify_add task on the same connection, adding the number of items the batch published.
+ * The responder of a reliable connection executes requests in order, so the increment lands after the payload of
+ * every write posted before it on that connection, and the event value is a running count of published items. The
+ * consumer waits for the value to move past the count it has already consumed: it never reads the payload to
+ * detect completion and does not need receive tasks or PE progress to be woken up, unlike write with immediate.
+ *
+ * Threading: producer functions and completion callbacks run on the PE thread of the producer DOCA RDMA. Consumer
+ * functions may run on any single thread.
+ */
+
+#define RDMA_SIGNAL_DEFAULT_NUM_TASKS (16) /* Default number of notify tasks, i.e. of signals in flight */
+
+/* Counters of a signal producer */
+struct rdma_signal_stats {
+	uint64_t num_signals; /* Number of successfully completed notify tasks */
+	uint64_t num_items;   /* Sum of the counts of the completed notify tasks */
+	uint64_t num_busy;    /* Number of signals rejected because all notify tasks were in flight */
+	uint64_t num_errors;  /* Number of notify tasks completed with an error */
+};
+
+struct rdma_signal_producer {
+	struct doca_dev *dev;						/* DOCA device of the DOCA RDMA */
+	struct doca_rdma *rdma;						/* DOCA RDMA the notify tasks run on */
+	uint32_t num_tasks;						/* Number of notify tasks */
+	struct doca_sync_event_remote_net *remote_event;		/* Consumer sync event */
+	uint64_t *results;						/* Value before the add, per task */
+	size_t results_len;						/* Length of results */
+	struct doca_mmap *mmap;						/* Registration of results */
+	struct doca_buf_inventory *inventory;				/* Inventory for the result buffers */
+	struct doca_buf **bufs;						/* One result buffer per task */
+	struct doca_rdma_task_remote_net_sync_event_notify_add **tasks;	/* Notify tasks, allocated on start */
+	uint32_t *free_tasks;						/* Stack of free tasks */
+	uint32_t num_free;						/* Number of entries in free_tasks */
+	uint32_t num_inflight;						/* Submitted signals not completed yet */
+	struct rdma_signal_stats stats;					/* Producer counters */
+	doca_error_t first_encountered_error;				/* First error of the producer */
+};
+
+struct rdma_signal_consumer {
+	struct doca_sync_event *event; /* Local sync event the producer adds to */
+	const uint8_t *export_desc;    /* Export of the event, to send to the producer */
+	size_t export_desc_len;	       /* Length of export_desc */
+	uint64_t consumed;	       /* Event value up to which items were consumed */
+};
+
+/*
+ * Check that a device can produce and consume remote sync event signals
+ *
+ * @devinfo [in]: DOCA device information
+ * @return: DOCA_SUCCESS if supported and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_cap_is_supported(const struct doca_devinfo *devinfo);
+
+/*
+ * Create a signal consumer: a started sync event published by the remote network and its export
+ *
+ * @dev [in]: DOCA device the producer reaches the consumer through
+ * @consumer [out]: the created consumer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_consumer_create(struct doca_dev *dev, struct rdma_signal_consumer **consumer);
+
+/*
+ * Consume the items signaled since the last call, without waiting
+ *
+ * @consumer [in]: the consumer
+ * @num_items [out]: number of items signaled since the last call, 0 if none
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_consumer_poll(struct rdma_signal_consumer *consumer, uint64_t *num_items);
+
+/*
+ * Wait until at least one item is signaled and consume all the items signaled since the last call
+ * A zero timeout blocks in doca_sync_event_wait_gt(), otherwise the event value is read until the deadline
+ *
+ * @consumer [in]: the consumer
+ * @timeout_ns [in]: time to wait before giving up, 0 to wait forever
+ * @num_items [out]: number of items signaled since the last call
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_TIME_OUT if nothing was signaled in time and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_consumer_wait(struct rdma_signal_consumer *consumer, uint64_t timeout_ns, uint64_t *num_items);
+
+/*
+ * Destroy a signal consumer, the producer must not signal it anymore
+ *
+ * @consumer [in]: the consumer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_consumer_destroy(struct rdma_signal_consumer *consumer);
+
+/*
+ * Create a signal producer on a DOCA RDMA that was not started yet
+ * Sets the remote_net_sync_event_notify_add task configuration of the DOCA RDMA
+ *
+ * @dev [in]: DOCA device the DOCA RDMA was created on
+ * @rdma [in]: DOCA RDMA, before doca_ctx_start()
+ * @num_tasks [in]: number of notify tasks, the maximal number of signals in flight
+ * @producer [out]: the created producer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_producer_create(struct doca_dev *dev,
+					 struct doca_rdma *rdma,
+					 uint32_t num_tasks,
+					 struct rdma_signal_producer **producer);
+
+/*
+ * Import the consumer sync event and allocate the notify tasks, must be called once the DOCA RDMA is running
+ *
+ * @producer [in]: the producer
+ * @connection [in]: connection the tasks are initialized with, rdma_signal() may override it
+ * @export_desc [in]: export of the consumer sync event
+ * @export_desc_len [in]: length of export_desc
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_producer_start(struct rdma_signal_producer *producer,
+					struct doca_rdma_connection *connection,
+					const uint8_t *export_desc,
+					size_t export_desc_len);
+
+/*
+ * Signal the consumer that count more items are published
+ * Must be posted on the connection the payload writes were posted on, after them
+ *
+ * @producer [in]: the producer
+ * @connection [in]: connection of the payload writes
+ * @count [in]: number of items the signal publishes, added to the consumer event
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if all notify tasks are in flight and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal(struct rdma_signal_producer *producer,
+			 struct doca_rdma_connection *connection,
+			 uint64_t count);
+
+/*
+ * Get the number of signals in flight
+ *
+ * @producer [in]: the producer
+ * @return: number of submitted signals that did not complete yet
+ */
+uint32_t rdma_signal_get_num_inflight(const struct rdma_signal_producer *producer);
+
+/*
+ * Destroy a signal producer, must be called when no signal is in flight and before the DOCA RDMA is stopped
+ *
+ * @producer [in]: the producer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_producer_destroy(struct rdma_signal_producer *producer);
+
+#endif /* RDMA_SIGNAL_H_ */
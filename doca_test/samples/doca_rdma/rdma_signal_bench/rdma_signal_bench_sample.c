@@ -0,0 +1,916 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <endian.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+#include "rdma_recv_ring.h"
+#include "rdma_signal.h"
+
+DOCA_LOG_REGISTER(RDMA_SIGNAL_BENCH::SAMPLE);
+
+#define WARMUP_ITERATIONS (1000)	       /* Batches run before the latency samples are taken */
+#define BATCH_FACTOR (4)		       /* Ratio between two consecutive batch sizes of the sweep */
+#define MAX_NUM_BATCHES (8)		       /* Upper bound on the number of swept batch sizes */
+#define RING_SLOT_SIZE (64)		       /* Receive buffer size, writes with immediate bring no payload */
+#define WAIT_TIMEOUT_NS (BENCH_NSEC_PER_SEC) /* Time to wait for a single signal before giving up */
+#define TIME_CHECK_INTERVAL (1024)	       /* Number of PE progress calls between two deadline checks */
+
+/* How the consumer learns that a batch of writes landed */
+enum signal_mode {
+	SIGNAL_MODE_SYNC_EVENT, /* N writes then one remote sync event notify add, the consumer waits on the event */
+	SIGNAL_MODE_WRITE_IMM,	/* N - 1 writes then one write with immediate, the consumer polls its receives */
+	SIGNAL_MODE_NUM,
+};
+
+static const char *const signal_mode_names[SIGNAL_MODE_NUM] = {"sync event", "write imm"};
+
+/* Latency percentiles, in nanoseconds */
+struct latency_result {
+	uint64_t p50;  /* Median */
+	uint64_t p99;  /* 99th percentile */
+	uint64_t p999; /* 99.9th percentile */
+};
+
+/* Result of one mode at one batch size */
+struct signal_result {
+	struct latency_result wakeup; /* From the submit of the batch to the consumer wakeup */
+	uint64_t num_stale;	      /* Wakeups that did not see the last payload of their batch yet */
+	double msignals;	      /* Million batches signaled and consumed per second, pipelined */
+};
+
+/* One payload write, reused by every batch it is picked for */
+struct signal_slot {
+	struct doca_buf *src_buf;		    /* Local payload */
+	struct doca_buf *dst_buf;		    /* Consumer payload */
+	struct doca_rdma_task_write *write;	    /* Plain write of the payload */
+	struct doca_rdma_task_write_imm *write_imm; /* Write of the payload that signals its batch */
+};
+
+/* Benchmark state */
+struct signal_bench {
+	struct rdma_bench_config *cfg;		      /* Benchmark configuration */
+	uint32_t iterations;			      /* Sampled batches per batch size */
+	struct doca_dev *dev;			      /* DOCA device */
+	struct doca_pe *pe;			      /* Progress engine driving both endpoints */
+	int numa_node;				      /* NUMA node of the device */
+	struct rdma_bench_endpoint producer;	      /* Endpoint posting the writes and the signals */
+	struct rdma_bench_endpoint consumer;	      /* Endpoint owning the payload */
+	struct rdma_signal_producer *signal_producer; /* Sync event signals of the producer */
+	struct rdma_signal_consumer *signal_consumer; /* Sync event of the consumer */
+	struct rdma_recv_ring *ring;		      /* Receive ring of the consumer, for write with immediate */
+	size_t region_len;			      /* Length of the source and of the payload region */
+	char *src;				      /* Payload source, one message per slot */
+	char *payload;				      /* Payload destination, one message per slot */
+	struct doca_mmap *src_mmap;		      /* Registration of src */
+	struct doca_mmap *payload_mmap;		      /* Registration of payload */
+	struct doca_mmap *payload_view_mmap;	      /* payload as seen by the producer */
+	struct doca_buf_inventory *inventory;	      /* Inventory for the slot buffers */
+	struct signal_slot *slots;		      /* Payload writes, queue_depth of them */
+	uint32_t *free_slots;			      /* Stack of slots with no write in flight */
+	uint32_t num_free;			      /* Number of entries in free_slots */
+	enum signal_mode mode;			      /* Mode of the current run */
+	uint64_t *samples;			      /* Wakeup latency of every sampled batch */
+	doca_error_t result;			      /* First error encountered by the callbacks */
+};
+
+/*
+ * Return the slot of a completed write to the free stack
+ *
+ * @bench [in]: benchmark state
+ * @slot [in]: slot of the write
+ */
+static void slot_release(struct signal_bench *bench, struct signal_slot *slot)
+{
+	bench->free_slots[bench->num_free++] = (uint32_t)(slot - bench->slots);
+}
+
+/*
+ * RDMA write task completed callback
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void write_completed_callback(struct doca_rdma_task_write *task,
+				     union doca_data task_user_data,
+				     union doca_data ctx_user_data)
+{
+	(void)task;
+	slot_release((struct signal_bench *)ctx_user_data.ptr, (struct signal_slot *)task_user_data.ptr);
+}
+
+/*
+ * RDMA write task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void write_error_callback(struct doca_rdma_task_write *task,
+				 union doca_data task_user_data,
+				 union doca_data ctx_user_data)
+{
+	struct signal_bench *bench = (struct signal_bench *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_write_as_task(task));
+
+	DOCA_LOG_ERR("RDMA write task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(bench->result, result);
+	slot_release(bench, (struct signal_slot *)task_user_data.ptr);
+}
+
+/*
+ * RDMA write with immediate task completed callback
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void write_imm_completed_callback(struct doca_rdma_task_write_imm *task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	(void)task;
+	slot_release((struct signal_bench *)ctx_user_data.ptr, (struct signal_slot *)task_user_data.ptr);
+}
+
+/*
+ * RDMA write with immediate task error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void write_imm_error_callback(struct doca_rdma_task_write_imm *task,
+				     union doca_data task_user_data,
+				     union doca_data ctx_user_data)
+{
+	struct signal_bench *bench = (struct signal_bench *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_write_imm_as_task(task));
+
+	DOCA_LOG_ERR("RDMA write with immediate task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(bench->result, result);
+	slot_release(bench, (struct signal_slot *)task_user_data.ptr);
+}
+
+/*
+ * Progress the PE once and repost parked receive tasks
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t progress(struct signal_bench *bench)
+{
+	(void)doca_pe_progress(bench->pe);
+	return rdma_recv_ring_replenish(bench->ring);
+}
+
+/*
+ * Post a batch of payload writes followed by its signal, the caller makes sure enough slots are free
+ *
+ * @bench [in]: benchmark state
+ * @batch [in]: number of payload writes
+ * @stamp [in]: value written in the first 8 bytes of the last payload of the batch
+ * @last_slot [out]: slot of the last payload
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t post_batch(struct signal_bench *bench, uint32_t batch, uint64_t stamp, uint32_t *last_slot)
+{
+	struct doca_rdma_connection *connection = bench->producer.connections[0];
+	struct signal_slot *slot;
+	struct doca_task *task;
+	doca_error_t result;
+	uint32_t i, idx = 0;
+
+	for (i = 0; i < batch; i++) {
+		idx = bench->free_slots[--bench->num_free];
+		slot = &bench->slots[idx];
+		if (i < batch - 1)
+			task = doca_rdma_task_write_as_task(slot->write);
+		else {
+			memcpy(bench->src + (size_t)idx * bench->cfg->msg_size, &stamp, sizeof(stamp));
+			if (bench->mode == SIGNAL_MODE_WRITE_IMM) {
+				doca_rdma_task_write_imm_set_immediate_data(slot->write_imm, htobe32(batch));
+				task = doca_rdma_task_write_imm_as_task(slot->write_imm);
+			} else
+				task = doca_rdma_task_write_as_task(slot->write);
+		}
+
+		result = doca_task_submit(task);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit RDMA write task: %s", doca_error_get_descr(result));
+			slot_release(bench, slot);
+			return result;
+		}
+	}
+	*last_slot = idx;
+
+	if (bench->mode != SIGNAL_MODE_SYNC_EVENT)
+		return DOCA_SUCCESS;
+
+	/* Posted after the writes on the same connection, so it lands after their payload */
+	while ((result = rdma_signal(bench->signal_producer, connection, batch)) == DOCA_ERROR_AGAIN)
+		(void)doca_pe_progress(bench->pe);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to submit signal: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Consume the signaled items without waiting
+ *
+ * @bench [in]: benchmark state
+ * @num_items [out]: number of payloads signaled since the last call
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t consumer_poll(struct signal_bench *bench, uint64_t *num_items)
+{
+	struct rdma_recv_msg msg;
+
+	if (bench->mode == SIGNAL_MODE_SYNC_EVENT)
+		return rdma_signal_consumer_poll(bench->signal_consumer, num_items);
+
+	*num_items = 0;
+	while (rdma_recv_ring_poll(bench->ring, &msg)) {
+		*num_items += be32toh(msg.immediate_data);
+		rdma_recv_ring_release(bench->ring, &msg);
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Wait until at least one batch is signaled to the consumer
+ * The sync event is waited on without progressing the PE, the receive ring needs the PE to see the immediate
+ *
+ * @bench [in]: benchmark state
+ * @num_items [out]: number of payloads signaled since the last call
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t consumer_wait(struct signal_bench *bench, uint64_t *num_items)
+{
+	uint64_t deadline_ns = 0, num_polls = 0;
+	doca_error_t result;
+
+	if (bench->mode == SIGNAL_MODE_SYNC_EVENT) {
+		result = rdma_signal_consumer_wait(bench->signal_consumer, WAIT_TIMEOUT_NS, num_items);
+		if (result == DOCA_ERROR_TIME_OUT)
+			DOCA_LOG_ERR("Timed out waiting for the sync event signal");
+		return result;
+	}
+
+	for (;;) {
+		result = progress(bench);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = consumer_poll(bench, num_items);
+		if (result != DOCA_SUCCESS || *num_items != 0)
+			return result;
+		if ((++num_polls % TIME_CHECK_INTERVAL) != 0)
+			continue;
+		if (deadline_ns == 0)
+			deadline_ns = bench_get_time_ns() + WAIT_TIMEOUT_NS;
+		else if (bench_get_time_ns() >= deadline_ns) {
+			DOCA_LOG_ERR("Timed out waiting for the write with immediate signal");
+			return DOCA_ERROR_TIME_OUT;
+		}
+	}
+}
+
+/*
+ * Progress the PE until every write and signal completed
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t drain(struct signal_bench *bench)
+{
+	uint64_t deadline_ns = bench_get_time_ns() + WAIT_TIMEOUT_NS;
+	doca_error_t result;
+
+	while (bench->num_free < bench->cfg->queue_depth || rdma_signal_get_num_inflight(bench->signal_producer) > 0) {
+		result = progress(bench);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if (bench_get_time_ns() >= deadline_ns) {
+			DOCA_LOG_ERR("Timed out draining the producer");
+			return DOCA_ERROR_TIME_OUT;
+		}
+	}
+
+	DOCA_ERROR_PROPAGATE(bench->result, bench->signal_producer->first_encountered_error);
+	return bench->result;
+}
+
+/*
+ * Compare two samples for qsort()
+ *
+ * @a [in]: first sample
+ * @b [in]: second sample
+ * @return: negative, zero or positive like memcmp()
+ */
+static int compare_samples(const void *a, const void *b)
+{
+	uint64_t first = *(const uint64_t *)a, second = *(const uint64_t *)b;
+
+	return (first > second) - (first < second);
+}
+
+/*
+ * Post one batch at a time and measure the time until the consumer wakes up, then check that the last payload of
+ * the batch is visible to it
+ *
+ * @bench [in]: benchmark state
+ * @batch [in]: number of payload writes per batch
+ * @res [out]: latency percentiles and stale wakeups
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_latency(struct signal_bench *bench, uint32_t batch, struct signal_result *res)
+{
+	uint32_t i, n = bench->iterations, last_slot;
+	uint64_t start_ns, elapsed_ns, num_items, stamp;
+	doca_error_t result;
+
+	res->num_stale = 0;
+	for (i = 0; i < WARMUP_ITERATIONS + n; i++) {
+		stamp = ((uint64_t)bench->mode << 32) | (i + 1);
+		start_ns = bench_get_time_ns();
+
+		result = post_batch(bench, batch, stamp, &last_slot);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = consumer_wait(bench, &num_items);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		elapsed_ns = bench_get_time_ns() - start_ns;
+		if (num_items != batch) {
+			DOCA_LOG_ERR("Consumer was signaled %lu payloads instead of %u", num_items, batch);
+			return DOCA_ERROR_UNEXPECTED;
+		}
+		if (*(volatile uint64_t *)(bench->payload + (size_t)last_slot * bench->cfg->msg_size) != stamp)
+			res->num_stale++;
+		if (i >= WARMUP_ITERATIONS)
+			bench->samples[i - WARMUP_ITERATIONS] = elapsed_ns;
+
+		result = drain(bench);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	qsort(bench->samples, n, sizeof(*bench->samples), compare_samples);
+	res->wakeup.p50 = bench->samples[(uint64_t)(n - 1) * 500 / 1000];
+	res->wakeup.p99 = bench->samples[(uint64_t)(n - 1) * 990 / 1000];
+	res->wakeup.p999 = bench->samples[(uint64_t)(n - 1) * 999 / 1000];
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Keep as many batches in flight as the queue depth allows for the configured duration, counting the batches the
+ * consumer sees
+ *
+ * @bench [in]: benchmark state
+ * @batch [in]: number of payload writes per batch
+ * @res [out]: signal rate
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_rate(struct signal_bench *bench, uint32_t batch, struct signal_result *res)
+{
+	uint64_t start_ns, deadline_ns, elapsed_ns, num_polls = 0, num_items, consumed = 0, posted = 0;
+	uint32_t last_slot;
+	doca_error_t result;
+
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (;;) {
+		while (bench->num_free >= batch) {
+			result = post_batch(bench, batch, 0, &last_slot);
+			if (result != DOCA_SUCCESS)
+				return result;
+			posted += batch;
+		}
+
+		result = progress(bench);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = consumer_poll(bench, &num_items);
+		if (result != DOCA_SUCCESS)
+			return result;
+		consumed += num_items;
+
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && bench_get_time_ns() >= deadline_ns)
+			break;
+	}
+	elapsed_ns = bench_get_time_ns() - start_ns;
+	res->msignals = (double)(consumed / batch) * 1000.0 / (double)elapsed_ns;
+
+	/* Leave nothing behind for the next run */
+	result = drain(bench);
+	while (result == DOCA_SUCCESS && consumed < posted) {
+		result = consumer_wait(bench, &num_items);
+		consumed += num_items;
+	}
+
+	return result;
+}
+
+/*
+ * Prepare the buffers and tasks of every payload slot
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_slots(struct signal_bench *bench)
+{
+	const uint32_t msg_size = bench->cfg->msg_size;
+	struct doca_rdma_connection *connection = bench->producer.connections[0];
+	union doca_data task_user_data;
+	struct signal_slot *slot;
+	doca_error_t result;
+	uint32_t i;
+
+	for (i = 0; i < bench->cfg->queue_depth; i++) {
+		slot = &bench->slots[i];
+		task_user_data.ptr = slot;
+
+		result = doca_buf_inventory_buf_get_by_data(bench->inventory,
+							    bench->src_mmap,
+							    bench->src + (size_t)i * msg_size,
+							    msg_size,
+							    &slot->src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DOCA buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_buf_inventory_buf_get_by_addr(bench->inventory,
+							    bench->payload_view_mmap,
+							    bench->payload + (size_t)i * msg_size,
+							    msg_size,
+							    &slot->dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DOCA buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_rdma_task_write_allocate_init(bench->producer.rdma,
+							    connection,
+							    slot->src_buf,
+							    slot->dst_buf,
+							    task_user_data,
+							    &slot->write);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA write task: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_rdma_task_write_imm_allocate_init(bench->producer.rdma,
+								connection,
+								slot->src_buf,
+								slot->dst_buf,
+								0,
+								task_user_data,
+								&slot->write_imm);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA write with immediate task: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	/* Push in reverse order so the first batches use the first slots */
+	for (i = bench->cfg->queue_depth; i > 0; i--)
+		bench->free_slots[bench->num_free++] = i - 1;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Release the tasks and buffers of every payload slot, no write may be in flight
+ *
+ * @bench [in]: benchmark state
+ */
+static void destroy_slots(struct signal_bench *bench)
+{
+	struct signal_slot *slot;
+	uint32_t i;
+
+	if (bench->slots == NULL)
+		return;
+
+	for (i = 0; i < bench->cfg->queue_depth; i++) {
+		slot = &bench->slots[i];
+		if (slot->write != NULL)
+			doca_task_free(doca_rdma_task_write_as_task(slot->write));
+		if (slot->write_imm != NULL)
+			doca_task_free(doca_rdma_task_write_imm_as_task(slot->write_imm));
+		if (slot->src_buf != NULL)
+			(void)doca_buf_dec_refcount(slot->src_buf, NULL);
+		if (slot->dst_buf != NULL)
+			(void)doca_buf_dec_refcount(slot->dst_buf, NULL);
+	}
+}
+
+/*
+ * Register the source and payload regions
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_memory(struct signal_bench *bench)
+{
+	doca_error_t result;
+
+	bench->region_len = (size_t)bench->cfg->queue_depth * bench->cfg->msg_size;
+	bench->src = bench_alloc_numa(bench->region_len, bench->numa_node);
+	bench->payload = bench_alloc_numa(bench->region_len, bench->numa_node);
+	bench->slots = calloc(bench->cfg->queue_depth, sizeof(*bench->slots));
+	bench->free_slots = calloc(bench->cfg->queue_depth, sizeof(*bench->free_slots));
+	if (bench->src == NULL || bench->payload == NULL || bench->slots == NULL || bench->free_slots == NULL) {
+		DOCA_LOG_ERR("Failed to allocate benchmark memory");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = create_local_mmap(&bench->src_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   bench->src,
+				   bench->region_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = create_local_mmap(&bench->payload_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE,
+				   bench->payload,
+				   bench->region_len,
+				   bench->dev);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_import_mmap(bench->payload_mmap, bench->dev, &bench->payload_view_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_create(2 * bench->cfg->queue_depth, &bench->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_start(bench->inventory);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Release the memory of prepare_memory()
+ *
+ * @bench [in]: benchmark state
+ */
+static void destroy_memory(struct signal_bench *bench)
+{
+	if (bench->inventory != NULL) {
+		(void)doca_buf_inventory_stop(bench->inventory);
+		(void)doca_buf_inventory_destroy(bench->inventory);
+	}
+	if (bench->payload_view_mmap != NULL)
+		(void)doca_mmap_destroy(bench->payload_view_mmap);
+	if (bench->payload_mmap != NULL) {
+		(void)doca_mmap_stop(bench->payload_mmap);
+		(void)doca_mmap_destroy(bench->payload_mmap);
+	}
+	if (bench->src_mmap != NULL) {
+		(void)doca_mmap_stop(bench->src_mmap);
+		(void)doca_mmap_destroy(bench->src_mmap);
+	}
+	free(bench->free_slots);
+	free(bench->slots);
+	bench_free_numa(bench->payload, bench->region_len);
+	bench_free_numa(bench->src, bench->region_len);
+}
+
+/*
+ * Create, start and connect the two endpoints with both signaling paths
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_endpoints(struct signal_bench *bench)
+{
+	struct rdma_bench_config *cfg = bench->cfg;
+	struct rdma_bench_endpoint_attr attr = {0};
+	struct rdma_recv_ring_attr ring_attr = {0};
+	union doca_data ctx_user_data = {0};
+	doca_error_t result;
+
+	attr.num_connections = 1;
+	attr.transport_type = cfg->rdma.transport_type;
+	attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	attr.gid_index = cfg->rdma.gid_index;
+
+	/* Every payload write may be followed by its own signal */
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	attr.send_queue_size = 2 * cfg->queue_depth;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->producer);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* The receive ring sizes the receive queue, sync event increments are remote atomics */
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE |
+			   DOCA_ACCESS_FLAG_RDMA_ATOMIC;
+	attr.send_queue_size = 0;
+	result = rdma_bench_endpoint_create(bench->dev, bench->pe, &attr, &bench->consumer);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_task_write_set_conf(bench->producer.rdma,
+					       write_completed_callback,
+					       write_error_callback,
+					       cfg->queue_depth);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_write_imm_set_conf(bench->producer.rdma,
+						   write_imm_completed_callback,
+						   write_imm_error_callback,
+						   cfg->queue_depth);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write with immediate task: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	result = rdma_signal_producer_create(bench->dev,
+					     bench->producer.rdma,
+					     cfg->queue_depth,
+					     &bench->signal_producer);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* Every in flight batch may end with a write with immediate */
+	ring_attr.num_slots = 2 * cfg->queue_depth;
+	ring_attr.num_posted = cfg->queue_depth;
+	ring_attr.slot_size = RING_SLOT_SIZE;
+	result = rdma_recv_ring_create(bench->dev, bench->consumer.rdma, &ring_attr, &bench->ring);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	ctx_user_data.ptr = bench;
+	result = doca_ctx_set_user_data(bench->producer.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->producer);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_endpoint_start(bench->pe, &bench->consumer);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_bench_connect_loopback(&bench->producer, &bench->consumer, 1);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_recv_ring_start(bench->ring);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* The export stands in for the descriptor a remote consumer would send during negotiation */
+	result = rdma_signal_consumer_create(bench->dev, &bench->signal_consumer);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return rdma_signal_producer_start(bench->signal_producer,
+					  bench->producer.connections[0],
+					  bench->signal_consumer->export_desc,
+					  bench->signal_consumer->export_desc_len);
+}
+
+/*
+ * Destroy the endpoints and the signaling paths, no write or signal may be in flight
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_endpoints(struct signal_bench *bench)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	/* Tasks must be freed before the context stops, posted receive tasks are flushed while it stops */
+	destroy_slots(bench);
+	tmp_result = rdma_signal_producer_destroy(bench->signal_producer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	if (bench->ring != NULL)
+		rdma_recv_ring_stop(bench->ring);
+	tmp_result = rdma_bench_endpoint_destroy(bench->pe, &bench->producer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench->pe, &bench->consumer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_recv_ring_destroy(bench->ring);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_signal_consumer_destroy(bench->signal_consumer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+
+	return result;
+}
+
+/*
+ * Compare completion signaling through a remote sync event (N writes then one notify add, the consumer waits on its
+ * local event) with write with immediate (N - 1 writes then one write with immediate, the consumer polls its
+ * receive queue), sweeping the batch size N. Reports the wakeup latency of single batches, whether the last payload
+ * was visible on wakeup, and the pipelined signal rate with up to queue_depth payload writes in flight.
+ *
+ * @cfg [in]: Configuration parameters
+ * @iterations [in]: number of sampled batches per batch size
+ * @max_batch [in]: largest batch of the sweep, at most queue_depth
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_signal_bench(struct rdma_bench_config *cfg, uint32_t iterations, uint32_t max_batch)
+{
+	struct signal_result results[SIGNAL_MODE_NUM][MAX_NUM_BATCHES] = {0};
+	uint32_t batches[MAX_NUM_BATCHES], num_batches = 0, batch, i;
+	struct signal_bench bench = {0};
+	doca_error_t result, tmp_result;
+	enum signal_mode mode;
+
+	if (cfg->msg_size < sizeof(uint64_t)) {
+		DOCA_LOG_ERR("Message size must be at least %zu bytes to hold the payload stamp", sizeof(uint64_t));
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (max_batch > cfg->queue_depth) {
+		DOCA_LOG_ERR("Largest batch %u exceeds the queue depth %u", max_batch, cfg->queue_depth);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (batch = 1; batch < max_batch && num_batches < MAX_NUM_BATCHES - 1; batch *= BATCH_FACTOR)
+		batches[num_batches++] = batch;
+	batches[num_batches++] = max_batch;
+
+	bench.cfg = cfg;
+	bench.iterations = iterations;
+
+	result = open_doca_device(cfg->rdma.device_name,
+				  doca_rdma_cap_task_remote_net_sync_event_notify_add_is_supported,
+				  &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+	bench.numa_node = bench_get_ibdev_numa_node(cfg->rdma.device_name);
+
+	result = rdma_signal_cap_is_supported(doca_dev_as_devinfo(bench.dev));
+	if (result != DOCA_SUCCESS)
+		goto close_dev;
+
+	result = doca_rdma_cap_task_write_imm_is_supported(doca_dev_as_devinfo(bench.dev));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Device does not support RDMA write with immediate task: %s",
+			     doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	bench.samples = malloc((size_t)iterations * sizeof(*bench.samples));
+	if (bench.samples == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %u latency samples", iterations);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto close_dev;
+	}
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto free_samples;
+	}
+
+	result = prepare_endpoints(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = prepare_memory(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = prepare_slots(&bench);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	for (mode = SIGNAL_MODE_SYNC_EVENT; mode < SIGNAL_MODE_NUM; mode++) {
+		bench.mode = mode;
+		for (i = 0; i < num_batches; i++) {
+			result = run_latency(&bench, batches[i], &results[mode][i]);
+			if (result == DOCA_SUCCESS)
+				result = run_rate(&bench, batches[i], &results[mode][i]);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Batches of %u writes signaled by %s failed: %s",
+					     batches[i],
+					     signal_mode_names[mode],
+					     doca_error_get_descr(result));
+				(void)drain(&bench);
+				goto destroy_endpoints;
+			}
+		}
+	}
+
+	DOCA_LOG_INFO("Batches of %u bytes writes, wakeup latency from submit over %u batches, in microseconds",
+		      cfg->msg_size,
+		      iterations);
+	DOCA_LOG_INFO("%5s | %26s | %26s | %21s",
+		      "",
+		      "sync event (wait on event)",
+		      "write imm (poll recv ring)",
+		      "Msignals/s pipelined");
+	DOCA_LOG_INFO("%5s | %8s %8s %8s | %8s %8s %8s | %10s %10s",
+		      "batch",
+		      "p50",
+		      "p99",
+		      "p99.9",
+		      "p50",
+		      "p99",
+		      "p99.9",
+		      "sync event",
+		      "write imm");
+	for (i = 0; i < num_batches; i++) {
+		const struct signal_result *se = &results[SIGNAL_MODE_SYNC_EVENT][i];
+		const struct signal_result *imm = &results[SIGNAL_MODE_WRITE_IMM][i];
+
+		DOCA_LOG_INFO("%5u | %8.2f %8.2f %8.2f | %8.2f %8.2f %8.2f | %10.3f %10.3f",
+			      batches[i],
+			      se->wakeup.p50 / 1000.0,
+			      se->wakeup.p99 / 1000.0,
+			      se->wakeup.p999 / 1000.0,
+			      imm->wakeup.p50 / 1000.0,
+			      imm->wakeup.p99 / 1000.0,
+			      imm->wakeup.p999 / 1000.0,
+			      se->msignals,
+			      imm->msignals);
+		for (mode = SIGNAL_MODE_SYNC_EVENT; mode < SIGNAL_MODE_NUM; mode++)
+			if (results[mode][i].num_stale != 0)
+				DOCA_LOG_WARN("%s, batch %u: %lu wakeups did not see the last payload yet",
+					      signal_mode_names[mode],
+					      batches[i],
+					      results[mode][i].num_stale);
+	}
+
+destroy_endpoints:
+	tmp_result = destroy_endpoints(&bench);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	destroy_memory(&bench);
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_samples:
+	free(bench.samples);
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "hugepage_slab.h"
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_SLAB_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_slab_bench(struct rdma_bench_config *cfg, uint64_t region_size, enum hugepage_slab_page_size page_size);
+
+#define DEFAULT_REGION_SIZE_MB (1024) /* Default size of the source and of the destination region in MB */
+#define DEFAULT_MSG_SIZE (65536)      /* Default buffer size */
+#define MAX_REGION_SIZE_MB (16384)    /* Largest region the benchmark allocates, four times */
+#define MAX_PAGE_SIZE_NAME_LEN (8)    /* Longest page size name */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct slab_bench_config {
+	struct rdma_bench_config bench;	       /* Benchmark configuration */
+	uint64_t region_size;		       /* Size of the source and of the destination region in bytes */
+	enum hugepage_slab_page_size page_size; /* Largest page size of the slabs */
+};
+
+/*
+ * ARGP Callback - Handle region size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t region_size_callback(void *param, void *config)
+{
+	struct slab_bench_config *cfg = (struct slab_bench_config *)config;
+	const int region_size_mb = *(int *)param;
+
+	if (region_size_mb <= 0 || region_size_mb > MAX_REGION_SIZE_MB) {
+		DOCA_LOG_ERR("Region size must be between 1 and %d MB", MAX_REGION_SIZE_MB);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->region_size = (uint64_t)region_size_mb << 20;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle page size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t page_size_callback(void *param, void *config)
+{
+	struct slab_bench_config *cfg = (struct slab_bench_config *)config;
+	const char *page_size = (char *)param;
+
+	if (strnlen(page_size, MAX_PAGE_SIZE_NAME_LEN) == MAX_PAGE_SIZE_NAME_LEN ||
+	    hugepage_slab_parse_page_size(page_size, &cfg->page_size) != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Page size must be one of auto, 1g, 2m or 4k");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the slab benchmark parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_slab_bench_params(void)
+{
+	struct doca_argp_param *region_size_param, *page_size_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&region_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(region_size_param, "rz");
+	doca_argp_param_set_long_name(region_size_param, "region-mb");
+	doca_argp_param_set_arguments(region_size_param, "<MB>");
+	doca_argp_param_set_description(region_size_param,
+					"Size of the source and of the destination region in MB (optional)");
+	doca_argp_param_set_callback(region_size_param, region_size_callback);
+	doca_argp_param_set_type(region_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(region_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&page_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(page_size_param, "pg");
+	doca_argp_param_set_long_name(page_size_param, "page-size");
+	doca_argp_param_set_arguments(page_size_param, "<auto|1g|2m|4k>");
+	doca_argp_param_set_description(page_size_param,
+					"Largest page size of the slabs, smaller ones are used when unavailable (optional)");
+	doca_argp_param_set_callback(page_size_param, page_size_callback);
+	doca_argp_param_set_type(page_size_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(page_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct slab_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = DEFAULT_MSG_SIZE;
+	cfg.region_size = (uint64_t)DEFAULT_REGION_SIZE_MB << 20;
+	cfg.page_size = HUGEPAGE_SLAB_PAGE_AUTO;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_slab_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark connections param */
+	result = register_rdma_bench_connections_param();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register connections parameter: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark params */
+	result = register_rdma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register slab benchmark params */
+	result = register_slab_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register slab benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_slab_bench(&cfg.bench, cfg.region_size, cfg.page_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_slab_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,605 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "hugepage_slab.h"
+#include "rdma_bench_common.h"
+
+DOCA_LOG_REGISTER(RDMA_SLAB_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024) /* Number of PE progress calls between two deadline checks */
+#define NUM_ALLOCATORS (2)	   /* malloc and slab */
+
+/* Source and destination buffers of one allocator */
+struct slab_bench_memory {
+	const char *name;		   /* Allocator name */
+	bool use_slab;			   /* Whether the buffers come from hugepage slabs */
+	char **src_bufs;		   /* Sources of the writes */
+	char **dst_bufs;		   /* Targets of the writes */
+	char *src_region;		   /* malloc allocator source memory */
+	char *dst_region;		   /* malloc allocator destination memory */
+	struct hugepage_slab *src_slab;	   /* Slab allocator source memory */
+	struct hugepage_slab *dst_slab;	   /* Slab allocator destination memory */
+	struct doca_mmap *src_mmap;	   /* Registration of the sources */
+	struct doca_mmap *dst_mmap;	   /* Registration of the targets */
+	struct doca_mmap *dst_view_mmap;   /* Targets as seen by the requester */
+	size_t page_size;		   /* Size of the pages backing the buffers */
+	uint64_t setup_ns;		   /* Time to allocate, fault in and register the buffers */
+	double gbps;			   /* Achieved bandwidth in Gbit/s */
+	double mops;			   /* Achieved million writes per second */
+};
+
+/* Benchmark state */
+struct slab_bench {
+	struct rdma_bench_config *cfg;		 /* Benchmark configuration */
+	enum hugepage_slab_page_size page_size;	 /* Largest page size of the slabs */
+	struct doca_dev *dev;			 /* DOCA device */
+	struct doca_pe *pe;			 /* Progress engine driving both endpoints */
+	struct rdma_bench_endpoint requester;	 /* Endpoint submitting the writes */
+	struct rdma_bench_endpoint responder;	 /* Endpoint the writes are targeted at */
+	int numa_node;				 /* NUMA node of the device */
+	uint32_t num_bufs;			 /* Number of buffers on each side */
+	struct slab_bench_memory *mem;		 /* Buffers of the running allocator */
+	struct doca_buf_inventory *inventory;	 /* Inventory for the task buffers */
+	struct doca_rdma_task_write **tasks;	 /* Write tasks */
+	uint32_t num_tasks;			 /* Number of write tasks */
+	uint32_t num_inflight;			 /* Number of submitted tasks that have not completed yet */
+	bool running;				 /* Whether completed tasks should be resubmitted */
+	uint64_t rng;				 /* Buffer index generator state */
+	uint64_t completed_ops;			 /* Number of completed writes */
+	doca_error_t result;			 /* First error encountered by the callbacks */
+};
+
+/*
+ * Pick the buffer the next write uses, uniformly over the whole region so that the device keeps walking new pages
+ *
+ * @bench [in]: benchmark state
+ * @return: buffer index
+ */
+static uint32_t next_buf_index(struct slab_bench *bench)
+{
+	bench->rng ^= bench->rng << 13;
+	bench->rng ^= bench->rng >> 7;
+	bench->rng ^= bench->rng << 17;
+	return (uint32_t)(bench->rng % bench->num_bufs);
+}
+
+/*
+ * Get the source and destination DOCA buffers of a write
+ *
+ * @bench [in]: benchmark state
+ * @index [in]: buffer index
+ * @src_buf [out]: source buffer
+ * @dst_buf [out]: destination buffer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t get_write_bufs(struct slab_bench *bench,
+				   uint32_t index,
+				   struct doca_buf **src_buf,
+				   struct doca_buf **dst_buf)
+{
+	doca_error_t result;
+
+	result = doca_buf_inventory_buf_get_by_data(bench->inventory,
+						    bench->mem->src_mmap,
+						    bench->mem->src_bufs[index],
+						    bench->cfg->msg_size,
+						    src_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_buf_get_by_addr(bench->inventory,
+						    bench->mem->dst_view_mmap,
+						    bench->mem->dst_bufs[index],
+						    bench->cfg->msg_size,
+						    dst_buf);
+	if (result != DOCA_SUCCESS)
+		(void)doca_buf_dec_refcount(*src_buf, NULL);
+
+	return result;
+}
+
+/*
+ * Release a write task and its buffers
+ *
+ * @bench [in]: benchmark state
+ * @task_idx [in]: task index
+ */
+static void release_write_task(struct slab_bench *bench, uint32_t task_idx)
+{
+	struct doca_rdma_task_write *task = bench->tasks[task_idx];
+	struct doca_buf *src_buf, *dst_buf;
+
+	if (task == NULL)
+		return;
+
+	src_buf = (struct doca_buf *)doca_rdma_task_write_get_src_buf(task);
+	dst_buf = doca_rdma_task_write_get_dst_buf(task);
+	doca_task_free(doca_rdma_task_write_as_task(task));
+	if (src_buf != NULL)
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+	if (dst_buf != NULL)
+		(void)doca_buf_dec_refcount(dst_buf, NULL);
+	bench->tasks[task_idx] = NULL;
+}
+
+/*
+ * RDMA write task completed callback, moves the task to another random buffer and resubmits it while the run is
+ * active
+ *
+ * @rdma_write_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void slab_bench_write_completed_callback(struct doca_rdma_task_write *rdma_write_task,
+						union doca_data task_user_data,
+						union doca_data ctx_user_data)
+{
+	struct slab_bench *bench = (struct slab_bench *)ctx_user_data.ptr;
+	struct doca_buf *src_buf, *dst_buf;
+	doca_error_t result;
+
+	bench->completed_ops++;
+
+	if (bench->running) {
+		result = get_write_bufs(bench, next_buf_index(bench), &src_buf, &dst_buf);
+		if (result == DOCA_SUCCESS) {
+			(void)doca_buf_dec_refcount((struct doca_buf *)doca_rdma_task_write_get_src_buf(rdma_write_task),
+						    NULL);
+			(void)doca_buf_dec_refcount(doca_rdma_task_write_get_dst_buf(rdma_write_task), NULL);
+			doca_rdma_task_write_set_src_buf(rdma_write_task, src_buf);
+			doca_rdma_task_write_set_dst_buf(rdma_write_task, dst_buf);
+			result = doca_task_submit(doca_rdma_task_write_as_task(rdma_write_task));
+			if (result == DOCA_SUCCESS)
+				return;
+		}
+		DOCA_LOG_ERR("Failed to resubmit RDMA write task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(bench->result, result);
+		bench->running = false;
+	}
+
+	release_write_task(bench, (uint32_t)task_user_data.u64);
+	bench->num_inflight--;
+}
+
+/*
+ * RDMA write task error callback
+ *
+ * @rdma_write_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void slab_bench_write_error_callback(struct doca_rdma_task_write *rdma_write_task,
+					    union doca_data task_user_data,
+					    union doca_data ctx_user_data)
+{
+	struct slab_bench *bench = (struct slab_bench *)ctx_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_write_as_task(rdma_write_task));
+
+	DOCA_LOG_ERR("RDMA write task failed: %s", doca_error_get_descr(result));
+	DOCA_ERROR_PROPAGATE(bench->result, result);
+	bench->running = false;
+
+	release_write_task(bench, (uint32_t)task_user_data.u64);
+	bench->num_inflight--;
+}
+
+/*
+ * Allocate and register the buffers of one allocator, timing the whole setup
+ *
+ * @bench [in]: benchmark state
+ * @mem [in/out]: allocator memory, name and use_slab set
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t prepare_memory(struct slab_bench *bench, struct slab_bench_memory *mem)
+{
+	const uint32_t src_permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	const uint32_t dst_permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	struct hugepage_slab_attr attr = {
+		.dev = bench->dev,
+		.buf_size = bench->cfg->msg_size,
+		.num_bufs = bench->num_bufs,
+		.page_size = bench->page_size,
+		.numa_node = bench->numa_node,
+	};
+	size_t region_size = (size_t)bench->num_bufs * bench->cfg->msg_size;
+	uint64_t start_ns;
+	doca_error_t result;
+	uint32_t i;
+
+	mem->src_bufs = calloc(bench->num_bufs, sizeof(*mem->src_bufs));
+	mem->dst_bufs = calloc(bench->num_bufs, sizeof(*mem->dst_bufs));
+	if (mem->src_bufs == NULL || mem->dst_bufs == NULL) {
+		DOCA_LOG_ERR("Failed to allocate buffer arrays of %u entries", bench->num_bufs);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	start_ns = bench_get_time_ns();
+
+	if (mem->use_slab) {
+		attr.permissions = src_permissions;
+		result = hugepage_slab_create(&attr, &mem->src_slab);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		attr.permissions = dst_permissions;
+		result = hugepage_slab_create(&attr, &mem->dst_slab);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		for (i = 0; i < bench->num_bufs; i++) {
+			mem->src_bufs[i] = hugepage_slab_alloc(mem->src_slab);
+			mem->dst_bufs[i] = hugepage_slab_alloc(mem->dst_slab);
+		}
+		mem->src_mmap = hugepage_slab_get_mmap(mem->src_slab);
+		mem->dst_mmap = hugepage_slab_get_mmap(mem->dst_slab);
+		mem->page_size = hugepage_slab_get_page_size(mem->src_slab);
+	} else {
+		/* The way the samples get their memory: one heap allocation registered as a whole */
+		mem->src_region = calloc(1, region_size);
+		mem->dst_region = calloc(1, region_size);
+		if (mem->src_region == NULL || mem->dst_region == NULL) {
+			DOCA_LOG_ERR("Failed to allocate two regions of %zu bytes", region_size);
+			return DOCA_ERROR_NO_MEMORY;
+		}
+
+		result = create_local_mmap(&mem->src_mmap, src_permissions, mem->src_region, region_size, bench->dev);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		result = create_local_mmap(&mem->dst_mmap, dst_permissions, mem->dst_region, region_size, bench->dev);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		for (i = 0; i < bench->num_bufs; i++) {
+			mem->src_bufs[i] = mem->src_region + (size_t)i * bench->cfg->msg_size;
+			mem->dst_bufs[i] = mem->dst_region + (size_t)i * bench->cfg->msg_size;
+		}
+		mem->page_size = (size_t)sysconf(_SC_PAGESIZE);
+	}
+
+	result = rdma_bench_import_mmap(mem->dst_mmap, bench->dev, &mem->dst_view_mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	mem->setup_ns = bench_get_time_ns() - start_ns;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Deregister and free the buffers of one allocator
+ *
+ * @bench [in]: benchmark state
+ * @mem [in]: allocator memory
+ */
+static void destroy_memory(struct slab_bench *bench, struct slab_bench_memory *mem)
+{
+	uint32_t i;
+
+	if (mem->dst_view_mmap != NULL) {
+		(void)doca_mmap_stop(mem->dst_view_mmap);
+		(void)doca_mmap_destroy(mem->dst_view_mmap);
+		mem->dst_view_mmap = NULL;
+	}
+
+	if (mem->use_slab) {
+		for (i = 0; i < bench->num_bufs && mem->src_bufs != NULL && mem->dst_bufs != NULL; i++) {
+			if (mem->src_bufs[i] != NULL)
+				hugepage_slab_free(mem->src_slab, mem->src_bufs[i]);
+			if (mem->dst_bufs[i] != NULL)
+				hugepage_slab_free(mem->dst_slab, mem->dst_bufs[i]);
+		}
+		(void)hugepage_slab_destroy(mem->dst_slab);
+		(void)hugepage_slab_destroy(mem->src_slab);
+	} else {
+		if (mem->dst_mmap != NULL) {
+			(void)doca_mmap_stop(mem->dst_mmap);
+			(void)doca_mmap_destroy(mem->dst_mmap);
+		}
+		if (mem->src_mmap != NULL) {
+			(void)doca_mmap_stop(mem->src_mmap);
+			(void)doca_mmap_destroy(mem->src_mmap);
+		}
+		free(mem->dst_region);
+		free(mem->src_region);
+	}
+	mem->src_mmap = NULL;
+	mem->dst_mmap = NULL;
+
+	free(mem->dst_bufs);
+	free(mem->src_bufs);
+	mem->dst_bufs = NULL;
+	mem->src_bufs = NULL;
+}
+
+/*
+ * Keep queue_depth writes per connection in flight over random buffers of an allocator for the configured duration
+ *
+ * @bench [in]: benchmark state
+ * @mem [in/out]: allocator memory, gbps and mops are filled
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_writes(struct slab_bench *bench, struct slab_bench_memory *mem)
+{
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf, *dst_buf;
+	uint64_t start_ns, deadline_ns, elapsed_ns, num_polls = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	bench->mem = mem;
+	bench->completed_ops = 0;
+	bench->result = DOCA_SUCCESS;
+	bench->rng = 0x2545F4914F6CDD1DULL;
+
+	for (i = 0; i < bench->num_tasks; i++) {
+		result = get_write_bufs(bench, next_buf_index(bench), &src_buf, &dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate task buffers: %s", doca_error_get_descr(result));
+			goto release_tasks;
+		}
+
+		task_user_data.u64 = i;
+		result = doca_rdma_task_write_allocate_init(bench->requester.rdma,
+							    bench->requester.connections[i % bench->requester.num_connections],
+							    src_buf,
+							    dst_buf,
+							    task_user_data,
+							    &bench->tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate RDMA write task: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(dst_buf, NULL);
+			(void)doca_buf_dec_refcount(src_buf, NULL);
+			goto release_tasks;
+		}
+	}
+
+	bench->running = true;
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)bench->cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	for (i = 0; i < bench->num_tasks; i++) {
+		result = doca_task_submit(doca_rdma_task_write_as_task(bench->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit RDMA write task: %s", doca_error_get_descr(result));
+			bench->running = false;
+			break;
+		}
+		bench->num_inflight++;
+	}
+
+	while (bench->running) {
+		(void)doca_pe_progress(bench->pe);
+		if (++num_polls % TIME_CHECK_INTERVAL == 0 && bench_get_time_ns() >= deadline_ns)
+			bench->running = false;
+	}
+	elapsed_ns = bench_get_time_ns() - start_ns;
+	mem->mops = (double)bench->completed_ops * 1000.0 / (double)elapsed_ns;
+	mem->gbps = (double)bench->completed_ops * bench->cfg->msg_size * 8.0 / (double)elapsed_ns;
+
+	/* Drain, the completion callbacks release the tasks */
+	while (bench->num_inflight > 0)
+		(void)doca_pe_progress(bench->pe);
+	DOCA_ERROR_PROPAGATE(result, bench->result);
+
+release_tasks:
+	for (i = 0; i < bench->num_tasks; i++)
+		release_write_task(bench, i);
+	return result;
+}
+
+/*
+ * Measure one allocator: set up its memory, run the writes and tear it down
+ *
+ * @bench [in]: benchmark state
+ * @mem [in/out]: allocator memory
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_allocator(struct slab_bench *bench, struct slab_bench_memory *mem)
+{
+	doca_error_t result;
+
+	result = prepare_memory(bench, mem);
+	if (result == DOCA_SUCCESS)
+		result = run_writes(bench, mem);
+	else
+		DOCA_LOG_ERR("Failed to prepare %s memory: %s", mem->name, doca_error_get_descr(result));
+
+	destroy_memory(bench, mem);
+	return result;
+}
+
+/*
+ * Compare RDMA write bandwidth over NIC loopback between buffers carved from a malloc'ed region and buffers handed
+ * out by hugepage slabs. Every write targets a random buffer of the region, so that the device translation caches
+ * see the whole registration.
+ *
+ * @cfg [in]: Configuration parameters, msg_size is the buffer size
+ * @region_size [in]: size of the source and of the destination region
+ * @page_size [in]: largest page size of the slabs
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_slab_bench(struct rdma_bench_config *cfg, uint64_t region_size, enum hugepage_slab_page_size page_size)
+{
+	struct slab_bench_memory mems[NUM_ALLOCATORS] = {
+		{.name = "malloc", .use_slab = false},
+		{.name = "slab", .use_slab = true},
+	};
+	struct slab_bench bench = {0};
+	struct rdma_bench_endpoint_attr attr = {0};
+	union doca_data ctx_user_data = {0};
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	bench.cfg = cfg;
+	bench.page_size = page_size;
+	bench.num_bufs = (uint32_t)(region_size / cfg->msg_size);
+	bench.num_tasks = cfg->rdma.num_connections * cfg->queue_depth;
+	if (bench.num_bufs < bench.num_tasks) {
+		DOCA_LOG_ERR("Region of %lu bytes holds %u buffers, at least %u are needed for the outstanding writes",
+			     region_size,
+			     bench.num_bufs,
+			     bench.num_tasks);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	bench.tasks = calloc(bench.num_tasks, sizeof(*bench.tasks));
+	if (bench.tasks == NULL) {
+		DOCA_LOG_ERR("Failed to allocate task array");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_write_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		goto free_tasks;
+	}
+	bench.numa_node = bench_get_ibdev_numa_node(cfg->rdma.device_name);
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	attr.num_connections = cfg->rdma.num_connections;
+	attr.send_queue_size = cfg->queue_depth;
+	attr.transport_type = cfg->rdma.transport_type;
+	attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	attr.gid_index = cfg->rdma.gid_index;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &attr, &bench.requester);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &attr, &bench.responder);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = doca_rdma_task_write_set_conf(bench.requester.rdma,
+					       slab_bench_write_completed_callback,
+					       slab_bench_write_error_callback,
+					       bench.num_tasks);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	ctx_user_data.ptr = &bench;
+	result = doca_ctx_set_user_data(bench.requester.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.requester);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.responder);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_bench_connect_loopback(&bench.requester, &bench.responder, cfg->rdma.num_connections);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	/* One spare pair, a completed task gets its next buffers before releasing the previous ones */
+	result = doca_buf_inventory_create(2 * bench.num_tasks + 2, &bench.inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_endpoints;
+	}
+
+	result = doca_buf_inventory_start(bench.inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_inventory;
+	}
+
+	for (i = 0; i < NUM_ALLOCATORS; i++) {
+		result = run_allocator(&bench, &mems[i]);
+		if (result != DOCA_SUCCESS)
+			goto stop_inventory;
+	}
+
+	DOCA_LOG_INFO("Random %u bytes writes over %lu MB, %u connections x %u outstanding",
+		      cfg->msg_size,
+		      region_size >> 20,
+		      cfg->rdma.num_connections,
+		      cfg->queue_depth);
+	DOCA_LOG_INFO("allocator | page size | setup ms |     Gbit/s |   Mwrite/s");
+	for (i = 0; i < NUM_ALLOCATORS; i++)
+		DOCA_LOG_INFO("%9s | %6zu KB | %8.1f | %10.3f | %10.3f",
+			      mems[i].name,
+			      mems[i].page_size >> 10,
+			      (double)mems[i].setup_ns / 1e6,
+			      mems[i].gbps,
+			      mems[i].mops);
+	DOCA_LOG_INFO("slab vs malloc: %.2fx bandwidth, %.2fx setup time",
+		      mems[0].gbps == 0.0 ? 0.0 : mems[1].gbps / mems[0].gbps,
+		      mems[0].setup_ns == 0 ? 0.0 : (double)mems[1].setup_ns / (double)mems[0].setup_ns);
+
+stop_inventory:
+	tmp_result = doca_buf_inventory_stop(bench.inventory);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_inventory:
+	tmp_result = doca_buf_inventory_destroy(bench.inventory);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_endpoints:
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.requester);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.responder);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+free_tasks:
+	free(bench.tasks);
+	return result;
+}
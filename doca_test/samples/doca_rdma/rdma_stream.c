@@ -0,0 +1,915 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <endian.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <doca_buf.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_pe.h>
+
+#include "common.h"
+#include "rdma_common.h"
+#include "rdma_stream.h"
+
+DOCA_LOG_REGISTER(RDMA::STREAM);
+
+#define IMM_LEN_MASK ((1U << RDMA_STREAM_IMM_LEN_BITS) - 1) /* Length part of the immediate */
+
+/*
+ * Check the channel attributes
+ *
+ * @attr [in]: channel attributes
+ * @return: DOCA_SUCCESS if the attributes are valid and DOCA_ERROR_INVALID_VALUE otherwise
+ */
+static doca_error_t check_stream_attr(const struct rdma_stream_attr *attr)
+{
+	if (attr->ring_size < 4 * RDMA_STREAM_RECORD_ALIGN || attr->ring_size > RDMA_STREAM_MAX_RING_SIZE ||
+	    (attr->ring_size & (attr->ring_size - 1)) != 0) {
+		DOCA_LOG_ERR("Stream ring size must be a power of 2 in the range [%u, %llu]",
+			     4 * RDMA_STREAM_RECORD_ALIGN,
+			     RDMA_STREAM_MAX_RING_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	if (attr->max_inflight == 0) {
+		DOCA_LOG_ERR("Stream max in-flight records must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	if (attr->credit_interval == 0 || attr->credit_interval > attr->ring_size / 4) {
+		DOCA_LOG_ERR("Stream credit interval must be in the range [1, %u]", attr->ring_size / 4);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Get the index of a credit slot from its DOCA buffer
+ *
+ * @slots [in]: credit slots array
+ * @buf [in]: buffer of one of the slots
+ * @return: slot index
+ */
+static uint32_t credit_buf_to_slot(const struct rdma_stream_credit *slots, const struct doca_buf *buf)
+{
+	void *addr = NULL;
+
+	(void)doca_buf_get_head(buf, &addr);
+	return (uint32_t)((struct rdma_stream_credit *)addr - slots);
+}
+
+/*
+ * Free a task together with its source and destination buffers
+ *
+ * @task [in]: task to free, may be NULL
+ * @src_buf [in]: source buffer, may be NULL
+ * @dst_buf [in]: destination buffer, may be NULL
+ */
+static void free_task_and_bufs(struct doca_task *task, const struct doca_buf *src_buf, struct doca_buf *dst_buf)
+{
+	if (task != NULL)
+		doca_task_free(task);
+	if (src_buf != NULL)
+		(void)doca_buf_dec_refcount((struct doca_buf *)src_buf, NULL);
+	if (dst_buf != NULL)
+		(void)doca_buf_dec_refcount(dst_buf, NULL);
+}
+
+/*
+ * Write with immediate completed callback
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void producer_write_completed_callback(struct doca_rdma_task_write_imm *task,
+					      union doca_data task_user_data,
+					      union doca_data ctx_user_data)
+{
+	struct rdma_stream_producer *producer = (struct rdma_stream_producer *)task_user_data.ptr;
+
+	(void)ctx_user_data;
+
+	free_task_and_bufs(doca_rdma_task_write_imm_as_task(task),
+			   doca_rdma_task_write_imm_get_src_buf(task),
+			   doca_rdma_task_write_imm_get_dst_buf(task));
+	producer->num_inflight--;
+}
+
+/*
+ * Write with immediate error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void producer_write_error_callback(struct doca_rdma_task_write_imm *task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	struct rdma_stream_producer *producer = (struct rdma_stream_producer *)task_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_write_imm_as_task(task));
+
+	(void)ctx_user_data;
+
+	if (!producer->stopping) {
+		DOCA_LOG_ERR("Stream record write failed: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(producer->first_encountered_error, result);
+	}
+
+	free_task_and_bufs(doca_rdma_task_write_imm_as_task(task),
+			   doca_rdma_task_write_imm_get_src_buf(task),
+			   doca_rdma_task_write_imm_get_dst_buf(task));
+	producer->num_inflight--;
+}
+
+/*
+ * Credit receive completed callback: update the released position and the posted receives and repost the receive
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void producer_credit_completed_callback(struct doca_rdma_task_receive *task,
+					       union doca_data task_user_data,
+					       union doca_data ctx_user_data)
+{
+	struct rdma_stream_producer *producer = (struct rdma_stream_producer *)task_user_data.ptr;
+	struct doca_buf *buf = doca_rdma_task_receive_get_dst_buf(task);
+	uint32_t slot = credit_buf_to_slot(producer->credit_slots, buf);
+	const struct rdma_stream_credit *credit = &producer->credit_slots[slot];
+	doca_error_t result;
+
+	(void)ctx_user_data;
+
+	/* Credits are cumulative, an older credit may complete after a newer one */
+	if (credit->released > producer->released)
+		producer->released = credit->released;
+	if (credit->num_recvs > producer->num_recvs)
+		producer->num_recvs = credit->num_recvs;
+	producer->stats.num_credits++;
+
+	if (!producer->stopping) {
+		(void)doca_buf_reset_data_len(buf);
+		result = doca_task_submit(doca_rdma_task_receive_as_task(task));
+		if (result == DOCA_SUCCESS)
+			return;
+		DOCA_LOG_ERR("Failed to repost credit receive task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(producer->first_encountered_error, result);
+	}
+
+	free_task_and_bufs(doca_rdma_task_receive_as_task(task), NULL, buf);
+	producer->num_recv_tasks--;
+}
+
+/*
+ * Credit receive error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void producer_credit_error_callback(struct doca_rdma_task_receive *task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data)
+{
+	struct rdma_stream_producer *producer = (struct rdma_stream_producer *)task_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_receive_as_task(task));
+
+	(void)ctx_user_data;
+
+	if (!producer->stopping) {
+		DOCA_LOG_ERR("Credit receive task failed: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(producer->first_encountered_error, result);
+	}
+
+	free_task_and_bufs(doca_rdma_task_receive_as_task(task), NULL, doca_rdma_task_receive_get_dst_buf(task));
+	producer->num_recv_tasks--;
+}
+
+doca_error_t rdma_stream_producer_create(struct doca_dev *dev,
+					 struct doca_rdma *rdma,
+					 const struct rdma_stream_attr *attr,
+					 struct rdma_stream_producer **producer)
+{
+	struct rdma_stream_producer *new_producer;
+	doca_error_t result, tmp_result;
+
+	result = check_stream_attr(attr);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	new_producer = calloc(1, sizeof(*new_producer));
+	if (new_producer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate stream producer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_producer->rdma = rdma;
+	new_producer->attr = *attr;
+	/* The consumer posts max_inflight receives before the first record is written */
+	new_producer->num_recvs = attr->max_inflight;
+	new_producer->first_encountered_error = DOCA_SUCCESS;
+
+	result = doca_rdma_task_write_imm_set_conf(rdma,
+						   producer_write_completed_callback,
+						   producer_write_error_callback,
+						   attr->max_inflight);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write with immediate task: %s",
+			     doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	result = doca_rdma_task_receive_set_conf(rdma,
+						 producer_credit_completed_callback,
+						 producer_credit_error_callback,
+						 RDMA_STREAM_CREDIT_SLOTS);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA receive task: %s", doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	result = create_local_mmap(&new_producer->credit_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   new_producer->credit_slots,
+				   sizeof(new_producer->credit_slots),
+				   dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_producer;
+
+	result = doca_buf_inventory_create(2 * attr->max_inflight + RDMA_STREAM_CREDIT_SLOTS, &new_producer->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	result = doca_buf_inventory_start(new_producer->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_producer;
+	}
+
+	*producer = new_producer;
+	return DOCA_SUCCESS;
+
+destroy_producer:
+	tmp_result = rdma_stream_producer_destroy(new_producer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+doca_error_t rdma_stream_producer_start(struct rdma_stream_producer *producer,
+					struct doca_dev *dev,
+					struct doca_rdma_connection *connection,
+					const void *ring_desc,
+					size_t ring_desc_len)
+{
+	struct doca_rdma_task_receive *task;
+	union doca_data task_user_data = {0};
+	struct doca_buf *buf;
+	void *ring_addr;
+	size_t ring_len;
+	doca_error_t result;
+	uint32_t i;
+
+	producer->connection = connection;
+
+	result = doca_mmap_create_from_export(NULL, ring_desc, ring_desc_len, dev, &producer->remote_ring_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from the stream ring export: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_get_memrange(producer->remote_ring_mmap, &ring_addr, &ring_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get stream ring memory range: %s", doca_error_get_descr(result));
+		return result;
+	}
+	if (ring_len < producer->attr.ring_size) {
+		DOCA_LOG_ERR("Remote stream ring of %zu bytes is smaller than the ring size %u",
+			     ring_len,
+			     producer->attr.ring_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	producer->remote_ring = ring_addr;
+
+	task_user_data.ptr = producer;
+	for (i = 0; i < RDMA_STREAM_CREDIT_SLOTS; i++) {
+		result = doca_buf_inventory_buf_get_by_addr(producer->inventory,
+							    producer->credit_mmap,
+							    &producer->credit_slots[i],
+							    sizeof(producer->credit_slots[i]),
+							    &buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate credit buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_rdma_task_receive_allocate_init(producer->rdma, buf, task_user_data, &task);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate credit receive task: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(buf, NULL);
+			return result;
+		}
+
+		result = doca_task_submit(doca_rdma_task_receive_as_task(task));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit credit receive task: %s", doca_error_get_descr(result));
+			free_task_and_bufs(doca_rdma_task_receive_as_task(task), NULL, buf);
+			return result;
+		}
+		producer->num_recv_tasks++;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_stream_producer_write(struct rdma_stream_producer *producer,
+					struct doca_mmap *src_mmap,
+					void *data,
+					uint32_t len)
+{
+	struct doca_rdma_task_write_imm *task;
+	union doca_data task_user_data = {0};
+	struct doca_buf *src_buf, *dst_buf;
+	uint64_t aligned_len, pos, pad = 0;
+	uint32_t offset, immediate;
+	doca_error_t result;
+
+	if (producer->first_encountered_error != DOCA_SUCCESS)
+		return producer->first_encountered_error;
+
+	if (len == 0 || len > RDMA_STREAM_MAX_RECORD_LEN || len > producer->attr.ring_size / 4) {
+		DOCA_LOG_ERR("Stream record length %u is out of range", len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	if (producer->num_inflight == producer->attr.max_inflight)
+		return DOCA_ERROR_AGAIN;
+
+	/* Every record consumes a receive of the consumer, writing without one would hit RNR */
+	if (producer->stats.num_records == producer->num_recvs) {
+		producer->stats.num_no_recv++;
+		return DOCA_ERROR_AGAIN;
+	}
+
+	/* Records never wrap, a record that does not fit before the end of the ring starts at offset 0 */
+	aligned_len = align_up_uint64(len, RDMA_STREAM_RECORD_ALIGN);
+	pos = producer->head & (producer->attr.ring_size - 1);
+	if (pos + aligned_len > producer->attr.ring_size)
+		pad = producer->attr.ring_size - pos;
+
+	if (producer->head + pad + aligned_len - producer->released > producer->attr.ring_size) {
+		producer->stats.num_no_credit++;
+		return DOCA_ERROR_AGAIN;
+	}
+	offset = pad != 0 ? 0 : (uint32_t)pos;
+
+	result = doca_buf_inventory_buf_get_by_data(producer->inventory, src_mmap, data, len, &src_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate record source buffer: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_buf_get_by_addr(producer->inventory,
+						    producer->remote_ring_mmap,
+						    producer->remote_ring + offset,
+						    len,
+						    &dst_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate record destination buffer: %s", doca_error_get_descr(result));
+		(void)doca_buf_dec_refcount(src_buf, NULL);
+		return result;
+	}
+
+	immediate = ((offset / RDMA_STREAM_RECORD_ALIGN) << RDMA_STREAM_IMM_LEN_BITS) | len;
+	task_user_data.ptr = producer;
+	result = doca_rdma_task_write_imm_allocate_init(producer->rdma,
+							producer->connection,
+							src_buf,
+							dst_buf,
+							htobe32(immediate),
+							task_user_data,
+							&task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate RDMA write with immediate task: %s", doca_error_get_descr(result));
+		free_task_and_bufs(NULL, src_buf, dst_buf);
+		return result;
+	}
+
+	result = doca_task_submit(doca_rdma_task_write_imm_as_task(task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit RDMA write with immediate task: %s", doca_error_get_descr(result));
+		free_task_and_bufs(doca_rdma_task_write_imm_as_task(task), src_buf, dst_buf);
+		return result;
+	}
+
+	producer->head += pad + aligned_len;
+	producer->num_inflight++;
+	producer->stats.num_records++;
+	producer->stats.num_bytes += len;
+	producer->stats.num_pad_bytes += pad;
+
+	return DOCA_SUCCESS;
+}
+
+void rdma_stream_producer_stop(struct rdma_stream_producer *producer)
+{
+	producer->stopping = true;
+}
+
+doca_error_t rdma_stream_producer_destroy(struct rdma_stream_producer *producer)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (producer == NULL)
+		return DOCA_SUCCESS;
+
+	if (producer->num_inflight != 0 || producer->num_recv_tasks != 0) {
+		DOCA_LOG_ERR("Destroying stream producer with tasks in flight");
+		DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_IN_USE);
+	}
+
+	if (producer->remote_ring_mmap != NULL) {
+		(void)doca_mmap_stop(producer->remote_ring_mmap);
+		tmp_result = doca_mmap_destroy(producer->remote_ring_mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy remote stream ring mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (producer->inventory != NULL) {
+		(void)doca_buf_inventory_stop(producer->inventory);
+		tmp_result = doca_buf_inventory_destroy(producer->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (producer->credit_mmap != NULL) {
+		(void)doca_mmap_stop(producer->credit_mmap);
+		tmp_result = doca_mmap_destroy(producer->credit_mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy credit mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(producer);
+	return result;
+}
+
+/*
+ * Send the current released position and posted receives as credit, if a credit slot is available
+ *
+ * @consumer [in]: the consumer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t consumer_send_credit(struct rdma_stream_consumer *consumer)
+{
+	doca_error_t result;
+	uint32_t slot;
+
+	for (slot = 0; slot < RDMA_STREAM_CREDIT_SLOTS; slot++) {
+		if (!consumer->credit_slot_busy[slot] && consumer->credit_tasks[slot] != NULL)
+			break;
+	}
+	if (slot == RDMA_STREAM_CREDIT_SLOTS) {
+		consumer->stats.num_credits_skipped++;
+		return DOCA_SUCCESS;
+	}
+
+	consumer->credit_slots[slot].released = consumer->released;
+	consumer->credit_slots[slot].num_recvs = consumer->num_recvs;
+	result = doca_task_submit(doca_rdma_task_send_as_task(consumer->credit_tasks[slot]));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit credit send task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	consumer->credit_slot_busy[slot] = true;
+	consumer->credited = consumer->released;
+	consumer->credited_recvs = consumer->num_recvs;
+	consumer->stats.num_credits++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Credit send completed callback, sends the credits that were held back while all slots were busy
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void consumer_credit_completed_callback(struct doca_rdma_task_send *task,
+					       union doca_data task_user_data,
+					       union doca_data ctx_user_data)
+{
+	struct rdma_stream_consumer *consumer = (struct rdma_stream_consumer *)task_user_data.ptr;
+	uint32_t slot = credit_buf_to_slot(consumer->credit_slots, doca_rdma_task_send_get_src_buf(task));
+	doca_error_t result;
+
+	(void)ctx_user_data;
+
+	consumer->credit_slot_busy[slot] = false;
+	if (consumer->stopping ||
+	    (consumer->released == consumer->credited && consumer->num_recvs == consumer->credited_recvs))
+		return;
+
+	result = consumer_send_credit(consumer);
+	DOCA_ERROR_PROPAGATE(consumer->first_encountered_error, result);
+}
+
+/*
+ * Credit send error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void consumer_credit_error_callback(struct doca_rdma_task_send *task,
+					   union doca_data task_user_data,
+					   union doca_data ctx_user_data)
+{
+	struct rdma_stream_consumer *consumer = (struct rdma_stream_consumer *)task_user_data.ptr;
+	const struct doca_buf *buf = doca_rdma_task_send_get_src_buf(task);
+	uint32_t slot = credit_buf_to_slot(consumer->credit_slots, buf);
+	doca_error_t result = doca_task_get_status(doca_rdma_task_send_as_task(task));
+
+	(void)ctx_user_data;
+
+	if (!consumer->stopping) {
+		DOCA_LOG_ERR("Credit send task failed: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(consumer->first_encountered_error, result);
+	}
+
+	/* The connection is broken or stopping, the slot is not reused */
+	free_task_and_bufs(doca_rdma_task_send_as_task(task), buf, NULL);
+	consumer->credit_tasks[slot] = NULL;
+	consumer->credit_slot_busy[slot] = false;
+}
+
+/*
+ * Record receive completed callback: queue the record and repost the receive, returning receive credits when due
+ *
+ * @task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void consumer_recv_completed_callback(struct doca_rdma_task_receive *task,
+					     union doca_data task_user_data,
+					     union doca_data ctx_user_data)
+{
+	struct rdma_stream_consumer *consumer = (struct rdma_stream_consumer *)task_user_data.ptr;
+	doca_error_t result = DOCA_SUCCESS;
+
+	(void)ctx_user_data;
+
+	if (doca_rdma_task_receive_get_result_opcode(task) != DOCA_RDMA_OPCODE_RECV_WRITE_WITH_IMM) {
+		DOCA_LOG_ERR("Stream consumer received an unexpected opcode");
+		result = DOCA_ERROR_UNEXPECTED;
+	} else if (!spsc_queue_enqueue(consumer->records,
+				       be32toh(doca_rdma_task_receive_get_result_immediate_data(task)))) {
+		/* Can't happen as long as the producer respects the credits */
+		DOCA_LOG_ERR("Stream consumer record queue overflow");
+		result = DOCA_ERROR_FULL;
+	}
+	DOCA_ERROR_PROPAGATE(consumer->first_encountered_error, result);
+
+	if (!consumer->stopping) {
+		result = doca_task_submit(doca_rdma_task_receive_as_task(task));
+		if (result == DOCA_SUCCESS) {
+			/* Half of the receives is enough for the producer to keep going while the credit travels */
+			consumer->num_recvs++;
+			if (consumer->num_recvs - consumer->credited_recvs < (consumer->attr.max_inflight + 1) / 2)
+				return;
+			result = consumer_send_credit(consumer);
+			DOCA_ERROR_PROPAGATE(consumer->first_encountered_error, result);
+			return;
+		}
+		DOCA_LOG_ERR("Failed to repost stream receive task: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(consumer->first_encountered_error, result);
+	}
+
+	doca_task_free(doca_rdma_task_receive_as_task(task));
+	consumer->num_recv_tasks--;
+}
+
+/*
+ * Record receive error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void consumer_recv_error_callback(struct doca_rdma_task_receive *task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct rdma_stream_consumer *consumer = (struct rdma_stream_consumer *)task_user_data.ptr;
+	doca_error_t result = doca_task_get_status(doca_rdma_task_receive_as_task(task));
+
+	(void)ctx_user_data;
+
+	if (!consumer->stopping) {
+		DOCA_LOG_ERR("Stream receive task failed: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(consumer->first_encountered_error, result);
+	}
+
+	doca_task_free(doca_rdma_task_receive_as_task(task));
+	consumer->num_recv_tasks--;
+}
+
+doca_error_t rdma_stream_consumer_create(struct doca_dev *dev,
+					 struct doca_rdma *rdma,
+					 const struct rdma_stream_attr *attr,
+					 struct rdma_stream_consumer **consumer)
+{
+	struct rdma_stream_consumer *new_consumer;
+	long page_size = sysconf(_SC_PAGESIZE);
+	size_t ring_alloc_len;
+	doca_error_t result, tmp_result;
+
+	result = check_stream_attr(attr);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	new_consumer = calloc(1, sizeof(*new_consumer));
+	if (new_consumer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate stream consumer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_consumer->rdma = rdma;
+	new_consumer->attr = *attr;
+	new_consumer->first_encountered_error = DOCA_SUCCESS;
+
+	/* Every record consumes one receive, reposted as soon as it completes */
+	result = doca_rdma_set_recv_queue_size(rdma, attr->max_inflight);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set receive queue size to %u: %s",
+			     attr->max_inflight,
+			     doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	result = doca_rdma_task_receive_set_conf(rdma,
+						 consumer_recv_completed_callback,
+						 consumer_recv_error_callback,
+						 attr->max_inflight);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA receive task: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	result = doca_rdma_task_send_set_conf(rdma,
+					      consumer_credit_completed_callback,
+					      consumer_credit_error_callback,
+					      RDMA_STREAM_CREDIT_SLOTS);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA send task: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	ring_alloc_len = align_up_uint64(attr->ring_size, page_size);
+	new_consumer->ring = aligned_alloc(page_size, ring_alloc_len);
+	if (new_consumer->ring == NULL) {
+		DOCA_LOG_ERR("Failed to allocate stream ring of %u bytes", attr->ring_size);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_consumer;
+	}
+
+	result = create_local_mmap(&new_consumer->ring_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE,
+				   new_consumer->ring,
+				   attr->ring_size,
+				   dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_consumer;
+
+	result = create_local_mmap(&new_consumer->credit_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   new_consumer->credit_slots,
+				   sizeof(new_consumer->credit_slots),
+				   dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_consumer;
+
+	result = doca_buf_inventory_create(RDMA_STREAM_CREDIT_SLOTS, &new_consumer->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	result = doca_buf_inventory_start(new_consumer->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_consumer;
+	}
+
+	/* The ring can't hold more records than this, so neither can the queue */
+	result = spsc_queue_create(attr->ring_size / RDMA_STREAM_RECORD_ALIGN, &new_consumer->records);
+	if (result != DOCA_SUCCESS)
+		goto destroy_consumer;
+
+	*consumer = new_consumer;
+	return DOCA_SUCCESS;
+
+destroy_consumer:
+	tmp_result = rdma_stream_consumer_destroy(new_consumer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+doca_error_t rdma_stream_consumer_export(struct rdma_stream_consumer *consumer,
+					 struct doca_dev *dev,
+					 const void **ring_desc,
+					 size_t *ring_desc_len)
+{
+	doca_error_t result;
+
+	result = doca_mmap_export_rdma(consumer->ring_mmap, dev, ring_desc, ring_desc_len);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to export stream ring: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+doca_error_t rdma_stream_consumer_start(struct rdma_stream_consumer *consumer, struct doca_rdma_connection *connection)
+{
+	struct doca_rdma_task_receive *recv_task;
+	union doca_data task_user_data = {0};
+	struct doca_buf *buf;
+	doca_error_t result;
+	uint32_t i;
+
+	consumer->connection = connection;
+	task_user_data.ptr = consumer;
+
+	for (i = 0; i < RDMA_STREAM_CREDIT_SLOTS; i++) {
+		result = doca_buf_inventory_buf_get_by_data(consumer->inventory,
+							    consumer->credit_mmap,
+							    &consumer->credit_slots[i],
+							    sizeof(consumer->credit_slots[i]),
+							    &buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate credit buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_rdma_task_send_allocate_init(consumer->rdma,
+							   connection,
+							   buf,
+							   task_user_data,
+							   &consumer->credit_tasks[i]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate credit send task: %s", doca_error_get_descr(result));
+			(void)doca_buf_dec_refcount(buf, NULL);
+			return result;
+		}
+	}
+
+	/* Receives of write with immediate need no buffer, the data lands in the ring */
+	for (i = 0; i < consumer->attr.max_inflight; i++) {
+		result = doca_rdma_task_receive_allocate_init(consumer->rdma, NULL, task_user_data, &recv_task);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate stream receive task: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		result = doca_task_submit(doca_rdma_task_receive_as_task(recv_task));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit stream receive task: %s", doca_error_get_descr(result));
+			doca_task_free(doca_rdma_task_receive_as_task(recv_task));
+			return result;
+		}
+		consumer->num_recv_tasks++;
+	}
+	/* The producer starts with credit for these receives */
+	consumer->num_recvs = consumer->attr.max_inflight;
+	consumer->credited_recvs = consumer->attr.max_inflight;
+
+	return DOCA_SUCCESS;
+}
+
+bool rdma_stream_consumer_poll(struct rdma_stream_consumer *consumer, struct rdma_stream_record *record)
+{
+	uint64_t immediate, pos;
+	uint32_t offset;
+
+	if (!spsc_queue_dequeue(consumer->records, &immediate))
+		return false;
+
+	offset = (uint32_t)(immediate >> RDMA_STREAM_IMM_LEN_BITS) * RDMA_STREAM_RECORD_ALIGN;
+	record->len = (uint32_t)(immediate & IMM_LEN_MASK);
+	record->data = consumer->ring + offset;
+
+	/* A record written somewhere else than the expected position means the producer skipped the ring tail */
+	pos = consumer->next & (consumer->attr.ring_size - 1);
+	if (offset != pos)
+		consumer->next += consumer->attr.ring_size - pos;
+	consumer->next += align_up_uint64(record->len, RDMA_STREAM_RECORD_ALIGN);
+	record->end = consumer->next;
+
+	consumer->stats.num_records++;
+	consumer->stats.num_bytes += record->len;
+	return true;
+}
+
+doca_error_t rdma_stream_consumer_release(struct rdma_stream_consumer *consumer,
+					  const struct rdma_stream_record *record)
+{
+	consumer->released = record->end;
+	if (consumer->released - consumer->credited < consumer->attr.credit_interval)
+		return DOCA_SUCCESS;
+
+	return consumer_send_credit(consumer);
+}
+
+void rdma_stream_consumer_stop(struct rdma_stream_consumer *consumer)
+{
+	consumer->stopping = true;
+}
+
+doca_error_t rdma_stream_consumer_destroy(struct rdma_stream_consumer *consumer)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint32_t i;
+
+	if (consumer == NULL)
+		return DOCA_SUCCESS;
+
+	for (i = 0; i < RDMA_STREAM_CREDIT_SLOTS; i++) {
+		if (consumer->credit_tasks[i] == NULL)
+			continue;
+		free_task_and_bufs(doca_rdma_task_send_as_task(consumer->credit_tasks[i]),
+				   doca_rdma_task_send_get_src_buf(consumer->credit_tasks[i]),
+				   NULL);
+	}
+
+	if (consumer->num_recv_tasks != 0) {
+		DOCA_LOG_ERR("Destroying stream consumer with %u receive tasks posted", consumer->num_recv_tasks);
+		DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_IN_USE);
+	}
+
+	spsc_queue_destroy(consumer->records);
+
+	if (consumer->inventory != NULL) {
+		(void)doca_buf_inventory_stop(consumer->inventory);
+		tmp_result = doca_buf_inventory_destroy(consumer->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (consumer->credit_mmap != NULL) {
+		(void)doca_mmap_stop(consumer->credit_mmap);
+		tmp_result = doca_mmap_destroy(consumer->credit_mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy credit mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (consumer->ring_mmap != NULL) {
+		(void)doca_mmap_stop(consumer->ring_mmap);
+		tmp_result = doca_mmap_destroy(consumer->ring_mmap);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy stream ring mmap: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(consumer->ring);
+	free(consumer);
+	return result;
+}
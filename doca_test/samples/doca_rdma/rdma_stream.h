@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_STREAM_H_
+#define RDMA_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_rdma.h>
+
+#include "spsc_queue.h"
+
+/*
+ * Streaming channel over RDMA write with immediate.
+ *
+ * The consumer owns a circular buffer that the producer writes variable sized records into, one RDMA write with
+ * immediate per record. Records are aligned to RDMA_STREAM_RECORD_ALIGN inside the buffer and never wrap: a
+ * record that does not fit before the end of the buffer is written at offset 0 and the tail is skipped. The 32-bit
+ * immediate carries the record offset (in RDMA_STREAM_RECORD_ALIGN units) and its length in bytes, so the consumer
+ * reads records in place, without copying and without sizing receive buffers (its receive tasks have no buffer).
+ *
+ * Flow control uses credits of two kinds, carried by the same message: ring bytes and receives. Once the consumer
+ * has released credit_interval bytes, or reposted half of its max_inflight receives, it sends the total number of
+ * released bytes and of receives it posted to the producer. The producer never has more than ring_size bytes that
+ * were not released yet, and never writes more records than the consumer posted receives for, so a write always
+ * finds a posted receive even when the consumer is slow to progress its PE. Credits are cumulative, so a credit
+ * message that could not be sent because all credit slots were busy is covered by the next one, which is sent as
+ * soon as a slot completes. Records and credit_interval are limited to a quarter of the ring, so the producer can
+ * always make progress once everything was released.
+ *
+ * Both sides are single threaded and must only be used from the thread progressing their PE.
+ */
+
+#define RDMA_STREAM_RECORD_ALIGN (64)					/* Alignment of records in the ring */
+#define RDMA_STREAM_IMM_LEN_BITS (16)					/* Immediate bits carrying the length */
+#define RDMA_STREAM_MAX_RECORD_LEN ((1U << RDMA_STREAM_IMM_LEN_BITS) - 1) /* Largest record */
+#define RDMA_STREAM_MAX_RING_SIZE ((1ULL << (32 - RDMA_STREAM_IMM_LEN_BITS)) * RDMA_STREAM_RECORD_ALIGN) /* 4MB */
+#define RDMA_STREAM_CREDIT_SLOTS (8) /* Number of credit messages that can be in flight at once */
+
+/* Credit message, both counts are cumulative since the start of the stream */
+struct rdma_stream_credit {
+	uint64_t released;  /* Stream position released by the consumer */
+	uint64_t num_recvs; /* Number of receives posted by the consumer */
+};
+
+/* Attributes of a stream channel, must be identical on both sides */
+struct rdma_stream_attr {
+	uint32_t ring_size;	  /* Size of the consumer ring, power of 2 and <= RDMA_STREAM_MAX_RING_SIZE */
+	uint32_t max_inflight;	  /* Maximum records in flight, and receives posted by the consumer */
+	uint32_t credit_interval; /* Number of released bytes after which the consumer returns credits, <= ring_size/4 */
+};
+
+/* A record received by the consumer, valid until it is released */
+struct rdma_stream_record {
+	void *data;   /* Record data, inside the consumer ring */
+	uint32_t len; /* Record length */
+	uint64_t end; /* Stream position right after the record, used on release */
+};
+
+/* Producer statistics */
+struct rdma_stream_producer_stats {
+	uint64_t num_records;	  /* Number of records written */
+	uint64_t num_bytes;	  /* Number of payload bytes written */
+	uint64_t num_no_credit;	  /* Number of writes refused because the ring was full */
+	uint64_t num_no_recv;	  /* Number of writes refused because the consumer had no receive posted */
+	uint64_t num_credits;	  /* Number of credit messages received */
+	uint64_t num_pad_bytes;	  /* Number of bytes skipped at the end of the ring */
+};
+
+/* Consumer statistics */
+struct rdma_stream_consumer_stats {
+	uint64_t num_records;	     /* Number of records received */
+	uint64_t num_bytes;	     /* Number of payload bytes received */
+	uint64_t num_credits;	     /* Number of credit messages sent */
+	uint64_t num_credits_skipped; /* Number of credit messages not sent because all credit slots were busy */
+};
+
+struct rdma_stream_producer {
+	struct doca_rdma *rdma;			     /* DOCA RDMA of the producer */
+	struct doca_rdma_connection *connection;     /* Connection to the consumer */
+	struct rdma_stream_attr attr;		     /* Channel attributes */
+	struct doca_mmap *remote_ring_mmap;	     /* Consumer ring, imported from the consumer export */
+	char *remote_ring;			     /* Address of the consumer ring */
+	struct doca_buf_inventory *inventory;	     /* Inventory for write and credit buffers */
+	struct rdma_stream_credit credit_slots[RDMA_STREAM_CREDIT_SLOTS]; /* Credit messages are received here */
+	struct doca_mmap *credit_mmap;		     /* Registration of credit_slots */
+	uint32_t num_recv_tasks;		     /* Number of allocated credit receive tasks */
+	uint64_t head;				     /* Stream position of the next record, including padding */
+	uint64_t released;			     /* Stream position released by the consumer (last credit) */
+	uint64_t num_recvs;			     /* Receives posted by the consumer (last credit) */
+	uint32_t num_inflight;			     /* Number of written records not completed yet */
+	bool stopping;				     /* Set once tasks should not be reposted anymore */
+	struct rdma_stream_producer_stats stats;     /* Producer statistics */
+	doca_error_t first_encountered_error;	     /* First error encountered by the producer */
+};
+
+struct rdma_stream_consumer {
+	struct doca_rdma *rdma;			     /* DOCA RDMA of the consumer */
+	struct doca_rdma_connection *connection;     /* Connection to the producer */
+	struct rdma_stream_attr attr;		     /* Channel attributes */
+	char *ring;				     /* The circular buffer records are written into */
+	struct doca_mmap *ring_mmap;		     /* Registration of ring, with remote write permission */
+	struct doca_buf_inventory *inventory;	     /* Inventory for the credit buffers */
+	struct rdma_stream_credit credit_slots[RDMA_STREAM_CREDIT_SLOTS]; /* Credit messages are sent from here */
+	bool credit_slot_busy[RDMA_STREAM_CREDIT_SLOTS]; /* Whether a credit send from the slot is in flight */
+	struct doca_mmap *credit_mmap;		     /* Registration of credit_slots */
+	struct spsc_queue *records;		     /* Immediate values of received records, in arrival order */
+	uint32_t num_recv_tasks;		     /* Number of allocated receive tasks */
+	struct doca_rdma_task_send *credit_tasks[RDMA_STREAM_CREDIT_SLOTS]; /* Credit send task per slot */
+	uint64_t next;				     /* Stream position where the next record is expected */
+	uint64_t released;			     /* Stream position released by the application */
+	uint64_t credited;			     /* Stream position last sent as credit */
+	uint64_t num_recvs;			     /* Receives posted since the start */
+	uint64_t credited_recvs;		     /* Receives last sent as credit */
+	bool stopping;				     /* Set once tasks should not be reposted anymore */
+	struct rdma_stream_consumer_stats stats;     /* Consumer statistics */
+	doca_error_t first_encountered_error;	     /* First error encountered by the consumer */
+};
+
+/*
+ * Create the producer side of a channel on a DOCA RDMA that was not started yet
+ * Configures the write with immediate and receive tasks of the DOCA RDMA
+ *
+ * @dev [in]: DOCA device the DOCA RDMA was created on
+ * @rdma [in]: DOCA RDMA, before doca_ctx_start()
+ * @attr [in]: channel attributes
+ * @producer [out]: the created producer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_producer_create(struct doca_dev *dev,
+					 struct doca_rdma *rdma,
+					 const struct rdma_stream_attr *attr,
+					 struct rdma_stream_producer **producer);
+
+/*
+ * Start the producer once the DOCA RDMA is running and connected: import the consumer ring and post the credit
+ * receive tasks
+ *
+ * @producer [in]: the producer
+ * @dev [in]: DOCA device
+ * @connection [in]: connection to the consumer
+ * @ring_desc [in]: consumer ring export descriptor, see rdma_stream_consumer_export()
+ * @ring_desc_len [in]: length of ring_desc
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_producer_start(struct rdma_stream_producer *producer,
+					struct doca_dev *dev,
+					struct doca_rdma_connection *connection,
+					const void *ring_desc,
+					size_t ring_desc_len);
+
+/*
+ * Write a record to the consumer ring
+ *
+ * @producer [in]: the producer
+ * @src_mmap [in]: started mmap containing the record
+ * @data [in]: record data, must stay unchanged until the write completes
+ * @len [in]: record length, in the range [1, min(RDMA_STREAM_MAX_RECORD_LEN, ring_size / 4)]
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the ring is full, the consumer has no receive posted or
+ * max_inflight records are in flight, and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_producer_write(struct rdma_stream_producer *producer,
+					struct doca_mmap *src_mmap,
+					void *data,
+					uint32_t len);
+
+/*
+ * Stop reposting credit receive tasks, must be called before the DOCA RDMA is stopped
+ *
+ * @producer [in]: the producer
+ */
+void rdma_stream_producer_stop(struct rdma_stream_producer *producer);
+
+/*
+ * Destroy the producer, must be called after the DOCA RDMA was stopped
+ *
+ * @producer [in]: the producer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_producer_destroy(struct rdma_stream_producer *producer);
+
+/*
+ * Create the consumer side of a channel on a DOCA RDMA that was not started yet
+ * Allocates and registers the ring and configures the receive and send tasks of the DOCA RDMA
+ * The DOCA RDMA must have been created with DOCA_ACCESS_FLAG_RDMA_WRITE permission
+ *
+ * @dev [in]: DOCA device the DOCA RDMA was created on
+ * @rdma [in]: DOCA RDMA, before doca_ctx_start()
+ * @attr [in]: channel attributes
+ * @consumer [out]: the created consumer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_consumer_create(struct doca_dev *dev,
+					 struct doca_rdma *rdma,
+					 const struct rdma_stream_attr *attr,
+					 struct rdma_stream_consumer **consumer);
+
+/*
+ * Export the consumer ring, the descriptor should be passed to rdma_stream_producer_start() on the producer
+ *
+ * @consumer [in]: the consumer
+ * @dev [in]: DOCA device
+ * @ring_desc [out]: export descriptor, valid as long as the consumer exists
+ * @ring_desc_len [out]: length of ring_desc
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_consumer_export(struct rdma_stream_consumer *consumer,
+					 struct doca_dev *dev,
+					 const void **ring_desc,
+					 size_t *ring_desc_len);
+
+/*
+ * Start the consumer once the DOCA RDMA is running and connected: post the receive tasks
+ * Must be called before the producer writes its first record
+ *
+ * @consumer [in]: the consumer
+ * @connection [in]: connection to the producer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_consumer_start(struct rdma_stream_consumer *consumer, struct doca_rdma_connection *connection);
+
+/*
+ * Get the next record, in place in the ring
+ *
+ * @consumer [in]: the consumer
+ * @record [out]: the record
+ * @return: true if a record was available, false otherwise
+ */
+bool rdma_stream_consumer_poll(struct rdma_stream_consumer *consumer, struct rdma_stream_record *record);
+
+/*
+ * Release a record and all the records before it, returning credits to the producer when due
+ * Records must be released in the order they were polled
+ *
+ * @consumer [in]: the consumer
+ * @record [in]: the record
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_consumer_release(struct rdma_stream_consumer *consumer,
+					  const struct rdma_stream_record *record);
+
+/*
+ * Stop reposting receive tasks, must be called before the DOCA RDMA is stopped
+ *
+ * @consumer [in]: the consumer
+ */
+void rdma_stream_consumer_stop(struct rdma_stream_consumer *consumer);
+
+/*
+ * Destroy the consumer, must be called after the DOCA RDMA was stopped
+ *
+ * @consumer [in]: the consumer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_consumer_destroy(struct rdma_stream_consumer *consumer);
+
+#endif /* RDMA_STREAM_H_ */
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+#include "rdma_stream.h"
+
+DOCA_LOG_REGISTER(RDMA_STREAM_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_stream_bench(struct rdma_bench_config *cfg, struct rdma_stream_attr *attr);
+
+#define DEFAULT_RING_SIZE (1U << 20)	  /* Default size of the consumer ring */
+#define DEFAULT_CREDIT_INTERVAL (1U << 17) /* Default number of released bytes between two credit messages */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct stream_bench_config {
+	struct rdma_bench_config bench;	     /* Benchmark configuration */
+	struct rdma_stream_attr stream_attr; /* Stream attributes, max_inflight follows the queue depth */
+};
+
+/*
+ * ARGP Callback - Handle ring size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ring_size_callback(void *param, void *config)
+{
+	struct stream_bench_config *cfg = (struct stream_bench_config *)config;
+	const int ring_size = *(int *)param;
+
+	if (ring_size <= 0 || (ring_size & (ring_size - 1)) != 0 || (uint64_t)ring_size > RDMA_STREAM_MAX_RING_SIZE) {
+		DOCA_LOG_ERR("Ring size must be a power of 2 and <= %llu", RDMA_STREAM_MAX_RING_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->stream_attr.ring_size = (uint32_t)ring_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle credit interval parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t credit_interval_callback(void *param, void *config)
+{
+	struct stream_bench_config *cfg = (struct stream_bench_config *)config;
+	const int credit_interval = *(int *)param;
+
+	if (credit_interval <= 0) {
+		DOCA_LOG_ERR("Credit interval must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->stream_attr.credit_interval = (uint32_t)credit_interval;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the stream parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_stream_params(void)
+{
+	struct doca_argp_param *ring_size_param, *credit_interval_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&ring_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(ring_size_param, "rg");
+	doca_argp_param_set_long_name(ring_size_param, "ring-size");
+	doca_argp_param_set_arguments(ring_size_param, "<bytes>");
+	doca_argp_param_set_description(ring_size_param, "Size of the consumer ring, a power of 2 (optional)");
+	doca_argp_param_set_callback(ring_size_param, ring_size_callback);
+	doca_argp_param_set_type(ring_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(ring_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&credit_interval_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(credit_interval_param, "ci");
+	doca_argp_param_set_long_name(credit_interval_param, "credit-interval");
+	doca_argp_param_set_arguments(credit_interval_param, "<bytes>");
+	doca_argp_param_set_description(credit_interval_param,
+					"Released bytes between two credit messages, <= ring-size / 4 (optional)");
+	doca_argp_param_set_callback(credit_interval_param, credit_interval_callback);
+	doca_argp_param_set_type(credit_interval_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(credit_interval_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct stream_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.stream_attr.ring_size = DEFAULT_RING_SIZE;
+	cfg.stream_attr.credit_interval = DEFAULT_CREDIT_INTERVAL;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_stream_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark params */
+	result = register_rdma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register stream params */
+	result = register_stream_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register stream parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_stream_bench(&cfg.bench, &cfg.stream_attr);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_stream_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+#include "rdma_stream.h"
+
+DOCA_LOG_REGISTER(RDMA_STREAM_BENCH::SAMPLE);
+
+#define TIME_CHECK_INTERVAL (1024)	     /* Number of loop iterations between two deadline checks */
+#define DRAIN_TIMEOUT_NS (BENCH_NSEC_PER_SEC) /* Time to wait for in-flight records after the producer stopped */
+#define RECORD_SEQ_SIZE (sizeof(uint64_t))    /* Records of at least this size start with their sequence number */
+
+/* Benchmark state */
+struct stream_bench {
+	struct rdma_bench_config *cfg;		/* Benchmark configuration */
+	struct doca_dev *dev;			/* DOCA device */
+	struct doca_pe *pe;			/* Progress engine driving both endpoints */
+	struct rdma_bench_endpoint producer_ep; /* Endpoint writing the records */
+	struct rdma_bench_endpoint consumer_ep; /* Endpoint owning the ring */
+	struct rdma_stream_producer *producer;	/* Stream producer */
+	struct rdma_stream_consumer *consumer;	/* Stream consumer */
+	char *src;				/* Source memory of the records, one slot per in-flight record */
+	size_t src_len;				/* Length of src */
+	struct doca_mmap *src_mmap;		/* Registration of src */
+	uint64_t rng_state;			/* State of the record size generator */
+	uint64_t num_bad_records;		/* Number of records received out of order or corrupted */
+};
+
+/*
+ * Get the size of the next record, uniformly distributed in [1, max_len]
+ *
+ * @bench [in]: benchmark state
+ * @max_len [in]: largest record size
+ * @return: record size
+ */
+static uint32_t next_record_len(struct stream_bench *bench, uint32_t max_len)
+{
+	/* xorshift64 */
+	bench->rng_state ^= bench->rng_state << 13;
+	bench->rng_state ^= bench->rng_state >> 7;
+	bench->rng_state ^= bench->rng_state << 17;
+	return 1 + (uint32_t)(bench->rng_state % max_len);
+}
+
+/*
+ * Fill a record with its sequence number and a trailing check byte
+ *
+ * @data [in]: record memory
+ * @len [in]: record length
+ * @seq [in]: record sequence number
+ */
+static void fill_record(char *data, uint32_t len, uint64_t seq)
+{
+	if (len >= RECORD_SEQ_SIZE)
+		memcpy(data, &seq, RECORD_SEQ_SIZE);
+	data[len - 1] = (char)seq;
+}
+
+/*
+ * Check that a record carries the expected sequence number, in place in the ring
+ *
+ * @record [in]: received record
+ * @seq [in]: expected sequence number
+ * @return: true if the record is valid
+ */
+static bool check_record(const struct rdma_stream_record *record, uint64_t seq)
+{
+	const char *data = (const char *)record->data;
+	uint64_t record_seq;
+
+	if (record->len >= RECORD_SEQ_SIZE) {
+		memcpy(&record_seq, data, RECORD_SEQ_SIZE);
+		if (record_seq != seq)
+			return false;
+	}
+	return data[record->len - 1] == (char)seq;
+}
+
+/*
+ * Consume all the records available in the ring
+ *
+ * @bench [in]: benchmark state
+ * @seq [in/out]: sequence number of the next expected record
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t consume_records(struct stream_bench *bench, uint64_t *seq)
+{
+	struct rdma_stream_record record;
+	doca_error_t result;
+
+	while (rdma_stream_consumer_poll(bench->consumer, &record)) {
+		if (!check_record(&record, *seq))
+			bench->num_bad_records++;
+		(*seq)++;
+
+		result = rdma_stream_consumer_release(bench->consumer, &record);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	return bench->consumer->first_encountered_error;
+}
+
+/*
+ * Stream records until the deadline, then wait for the consumer to receive all of them
+ *
+ * @bench [in]: benchmark state
+ * @elapsed_ns [out]: length of the timed region
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_stream(struct stream_bench *bench, uint64_t *elapsed_ns)
+{
+	struct rdma_bench_config *cfg = bench->cfg;
+	uint64_t start_ns, deadline_ns, iterations = 0, write_seq = 0, read_seq = 0;
+	bool running = true;
+	doca_error_t result;
+	uint32_t len;
+	char *slot;
+
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + (uint64_t)cfg->duration_sec * BENCH_NSEC_PER_SEC;
+
+	while (running) {
+		/*
+		 * Write as many records as the credits and the in-flight limit allow. Completions are in order, so
+		 * below the in-flight limit the source slot of the next record is no longer in use.
+		 */
+		while (bench->producer->num_inflight < cfg->queue_depth) {
+			slot = bench->src + (write_seq % cfg->queue_depth) * cfg->msg_size;
+			len = next_record_len(bench, cfg->msg_size);
+			fill_record(slot, len, write_seq);
+			result = rdma_stream_producer_write(bench->producer, bench->src_mmap, slot, len);
+			if (result == DOCA_ERROR_AGAIN)
+				break;
+			if (result != DOCA_SUCCESS)
+				return result;
+			write_seq++;
+		}
+
+		(void)doca_pe_progress(bench->pe);
+
+		result = consume_records(bench, &read_seq);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		if ((++iterations % TIME_CHECK_INTERVAL) == 0 && bench_get_time_ns() >= deadline_ns)
+			running = false;
+	}
+
+	deadline_ns = bench_get_time_ns() + DRAIN_TIMEOUT_NS;
+	while ((bench->producer->num_inflight > 0 || read_seq < write_seq) && bench_get_time_ns() < deadline_ns) {
+		(void)doca_pe_progress(bench->pe);
+		result = consume_records(bench, &read_seq);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	*elapsed_ns = bench_get_time_ns() - start_ns;
+
+	if (read_seq != write_seq) {
+		DOCA_LOG_ERR("Consumer received %lu records out of %lu", read_seq, write_seq);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	return bench->producer->first_encountered_error;
+}
+
+/*
+ * Log the benchmark results
+ *
+ * @bench [in]: benchmark state
+ * @attr [in]: stream attributes
+ * @elapsed_ns [in]: length of the timed region
+ */
+static void report_results(struct stream_bench *bench, const struct rdma_stream_attr *attr, uint64_t elapsed_ns)
+{
+	const struct rdma_stream_producer_stats *pstats = &bench->producer->stats;
+	const struct rdma_stream_consumer_stats *cstats = &bench->consumer->stats;
+
+	DOCA_LOG_INFO("Ring %u bytes, records of 1-%u bytes, %u in flight, credit every %u bytes",
+		      attr->ring_size,
+		      bench->cfg->msg_size,
+		      attr->max_inflight,
+		      attr->credit_interval);
+	DOCA_LOG_INFO("Records: written %lu, received %lu, corrupted %lu, average size %.1f bytes",
+		      pstats->num_records,
+		      cstats->num_records,
+		      bench->num_bad_records,
+		      cstats->num_records == 0 ? 0.0 : (double)cstats->num_bytes / (double)cstats->num_records);
+	DOCA_LOG_INFO("Credits: sent %lu, coalesced %lu, received %lu, writer stalls on ring %lu, on receives %lu",
+		      cstats->num_credits,
+		      cstats->num_credits_skipped,
+		      pstats->num_credits,
+		      pstats->num_no_credit,
+		      pstats->num_no_recv);
+	DOCA_LOG_INFO("Ring tail padding: %lu bytes (%.2f%% of the written bytes)",
+		      pstats->num_pad_bytes,
+		      pstats->num_bytes == 0 ? 0.0 : (double)pstats->num_pad_bytes * 100.0 / (double)pstats->num_bytes);
+	if (elapsed_ns != 0)
+		DOCA_LOG_INFO("Stream rate: %.3f Mrecords/s, %.3f Gbit/s payload",
+			      (double)cstats->num_records * 1000.0 / (double)elapsed_ns,
+			      (double)cstats->num_bytes * 8.0 / (double)elapsed_ns);
+}
+
+/*
+ * Stream variable sized records through an RDMA write with immediate ring over a NIC loopback connection
+ *
+ * @cfg [in]: Configuration parameters, msg_size is the largest record and queue_depth the records in flight
+ * @attr [in]: Stream attributes, max_inflight is taken from queue_depth
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_stream_bench(struct rdma_bench_config *cfg, struct rdma_stream_attr *attr)
+{
+	struct stream_bench bench = {0};
+	struct rdma_bench_endpoint_attr ep_attr = {0};
+	const void *ring_desc;
+	size_t ring_desc_len;
+	uint64_t elapsed_ns = 0;
+	doca_error_t result, tmp_result;
+
+	if (cfg->msg_size > RDMA_STREAM_MAX_RECORD_LEN || cfg->msg_size > attr->ring_size / 4) {
+		DOCA_LOG_ERR("Record size %u must be <= %u and <= ring size / 4",
+			     cfg->msg_size,
+			     RDMA_STREAM_MAX_RECORD_LEN);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	bench.cfg = cfg;
+	bench.rng_state = 0x9E3779B97F4A7C15ULL;
+	attr->max_inflight = cfg->queue_depth;
+
+	result = open_doca_device(cfg->rdma.device_name, doca_rdma_cap_task_write_imm_is_supported, &bench.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_pe_create(&bench.pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto close_dev;
+	}
+
+	ep_attr.num_connections = 1;
+	ep_attr.transport_type = cfg->rdma.transport_type;
+	ep_attr.is_gid_index_set = cfg->rdma.is_gid_index_set;
+	ep_attr.gid_index = cfg->rdma.gid_index;
+	ep_attr.send_queue_size = cfg->queue_depth;
+
+	ep_attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &ep_attr, &bench.producer_ep);
+	if (result != DOCA_SUCCESS)
+		goto destroy_pe;
+
+	ep_attr.permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_WRITE;
+	result = rdma_bench_endpoint_create(bench.dev, bench.pe, &ep_attr, &bench.consumer_ep);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_stream_producer_create(bench.dev, bench.producer_ep.rdma, attr, &bench.producer);
+	if (result != DOCA_SUCCESS)
+		goto destroy_endpoints;
+
+	result = rdma_stream_consumer_create(bench.dev, bench.consumer_ep.rdma, attr, &bench.consumer);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.producer_ep);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = rdma_bench_endpoint_start(bench.pe, &bench.consumer_ep);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = rdma_bench_connect_loopback(&bench.producer_ep, &bench.consumer_ep, 1);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = rdma_stream_consumer_start(bench.consumer, bench.consumer_ep.connections[0]);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = rdma_stream_consumer_export(bench.consumer, bench.dev, &ring_desc, &ring_desc_len);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = rdma_stream_producer_start(bench.producer,
+					    bench.dev,
+					    bench.producer_ep.connections[0],
+					    ring_desc,
+					    ring_desc_len);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	bench.src_len = (size_t)cfg->queue_depth * cfg->msg_size;
+	bench.src = malloc(bench.src_len);
+	if (bench.src == NULL) {
+		DOCA_LOG_ERR("Failed to allocate record source memory");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_stream;
+	}
+
+	result = create_local_mmap(&bench.src_mmap,
+				   DOCA_ACCESS_FLAG_LOCAL_READ_WRITE,
+				   bench.src,
+				   bench.src_len,
+				   bench.dev);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = run_stream(&bench, &elapsed_ns);
+	report_results(&bench, attr, elapsed_ns);
+	if (result == DOCA_SUCCESS && bench.num_bad_records != 0)
+		result = DOCA_ERROR_UNEXPECTED;
+
+destroy_stream:
+	/* In-flight tasks are flushed to the stream error callbacks while the endpoints stop */
+	if (bench.producer != NULL)
+		rdma_stream_producer_stop(bench.producer);
+	if (bench.consumer != NULL)
+		rdma_stream_consumer_stop(bench.consumer);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.producer_ep);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.consumer_ep);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_stream_consumer_destroy(bench.consumer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_stream_producer_destroy(bench.producer);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	/* The source memory is released once no write can reference it anymore */
+	if (bench.src_mmap != NULL) {
+		(void)doca_mmap_stop(bench.src_mmap);
+		(void)doca_mmap_destroy(bench.src_mmap);
+	}
+	free(bench.src);
+destroy_endpoints:
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.producer_ep);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_bench_endpoint_destroy(bench.pe, &bench.consumer_ep);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+destroy_pe:
+	tmp_result = doca_pe_destroy(bench.pe);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+close_dev:
+	tmp_result = doca_dev_close(bench.dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
@@ -83,6 +83,13 @@ int main(int argc, char **argv)
 		goto argp_cleanup;
 	}
 
+	/* Register RDMA write_string param, the payload written ahead of the signal in RDMA-CM mode */
+	result = register_rdma_write_string_param();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register write_string parameter: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
 	/* Start argparser */
 	result = doca_argp_start(argc, argv);
 	if (result != DOCA_SUCCESS) {
@@ -34,6 +34,7 @@
 DOCA_LOG_REGISTER(RDMA_SYNC_EVENT_REQUESTER::SAMPLE);
 
 #define EXAMPLE_SET_VALUE (0xD0CA) /* Example value to use for setting sync event */
+#define EXAMPLE_PAYLOAD_OFFSET (64) /* Offset of the RDMA-CM payload in the memory range, past the sync event value */
 
 /*
  * DOCA device with rdma remote sync event tasks capability filter callback
@@ -49,7 +50,12 @@ static doca_error_t sync_event_tasks_supported(const struct doca_devinfo *devinf
 	if (status != DOCA_SUCCESS)
 		return status;
 
-	return doca_rdma_cap_task_remote_net_sync_event_get_is_supported(devinfo);
+	status = doca_rdma_cap_task_remote_net_sync_event_get_is_supported(devinfo);
+	if (status != DOCA_SUCCESS)
+		return status;
+
+	/* The RDMA-CM flow also writes a payload ahead of the signal */
+	return doca_rdma_cap_task_write_is_supported(devinfo);
 }
 
 /*
@@ -153,6 +159,12 @@ static void rdma_remote_net_sync_event_notify_set_completed_callback(
 	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
 	char *successful_task_message = (char *)task_user_data.ptr;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_remote_net_sync_event_notify_set_as_task(se_set_task),
+				    RDMA_LATENCY_TASK_SYNC_EVENT_SET,
+				    doca_rdma_task_remote_net_sync_event_notify_set_get_rdma_connection(se_set_task),
+				    sizeof(uint64_t));
+
 	DOCA_LOG_INFO("RDMA remote net sync event notify set was done successfully");
 	DOCA_LOG_INFO("%s", successful_task_message);
 
@@ -204,6 +216,7 @@ static void rdma_remote_net_sync_event_notify_set_error_callback(
 	result = doca_task_get_status(task);
 	DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA remote net sync event notify set task failed: %s", doca_error_get_descr(result));
+	rdma_latency_task_failed(resources->latency, task);
 
 	/* Release task resources only if there are no remaining tasks */
 	if (resources->num_remaining_tasks == 0) {
@@ -246,6 +259,11 @@ static void rdma_remote_net_sync_event_get_completed_callback(
 	DOCA_LOG_INFO("RDMA remote net sync event get was done successfully");
 
 	task = doca_rdma_task_remote_net_sync_event_get_as_task(se_get_task);
+	rdma_latency_task_completed(resources->latency,
+				    task,
+				    RDMA_LATENCY_TASK_SYNC_EVENT_GET,
+				    doca_rdma_task_remote_net_sync_event_get_get_rdma_connection(se_get_task),
+				    sizeof(uint64_t));
 
 	get_buf = doca_rdma_task_remote_net_sync_event_get_get_dst_buf(se_get_task);
 
@@ -264,9 +282,11 @@ static void rdma_remote_net_sync_event_get_completed_callback(
 			goto propagate_error;
 		}
 
+		rdma_latency_task_submitted(resources->latency, task);
 		result = doca_task_submit(task);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to submit RDMA sync event get task: %s", doca_error_get_descr(result));
+			rdma_latency_task_failed(resources->latency, task);
 			goto propagate_error;
 		}
 
@@ -291,9 +311,11 @@ static void rdma_remote_net_sync_event_get_completed_callback(
 		"Remote sync event has been notified for completion successfully",
 		MAX_ARG_SIZE - 1);
 
+	rdma_latency_task_submitted(resources->latency, set_task);
 	result = doca_task_submit(set_task);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA remote sync event set task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, set_task);
 		goto propagate_error;
 	}
 	resources->num_remaining_tasks++;
@@ -353,6 +375,7 @@ static void rdma_remote_net_sync_event_get_error_callback(struct doca_rdma_task_
 	result = doca_task_get_status(task);
 	DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
 	DOCA_LOG_ERR("RDMA remote net sync event get task failed: %s", doca_error_get_descr(result));
+	rdma_latency_task_failed(resources->latency, task);
 
 	/* Release task resources and stop the ctx */
 	result = rdma_remote_net_sync_event_notify_set_free_task_resources(se_set_task, ctx_user_data);
@@ -375,6 +398,185 @@ static void rdma_remote_net_sync_event_get_error_callback(struct doca_rdma_task_
 		DOCA_LOG_ERR("Failed to stop DOCA RDMA context: %s", doca_error_get_descr(result));
 }
 
+/*
+ * Free RDMA write task resources and task
+ *
+ * @rdma_write_task [in]: the task that should be freed along with it's resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rdma_write_free_task_resources(struct doca_rdma_task_write *rdma_write_task)
+{
+	doca_error_t result, return_value = DOCA_SUCCESS;
+
+	result = doca_buf_dec_refcount(doca_rdma_task_write_get_dst_buf(rdma_write_task), NULL);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decrease dst_buf count: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(return_value, result);
+	}
+	result = doca_buf_dec_refcount((struct doca_buf *)doca_rdma_task_write_get_src_buf(rdma_write_task), NULL);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decrease src_buf count: %s", doca_error_get_descr(result));
+		DOCA_ERROR_PROPAGATE(return_value, result);
+	}
+
+	doca_task_free(doca_rdma_task_write_as_task(rdma_write_task));
+
+	return return_value;
+}
+
+/*
+ * RDMA write task completed callback
+ *
+ * @rdma_write_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void rdma_write_completed_callback(struct doca_rdma_task_write *rdma_write_task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
+	doca_error_t result;
+	(void)task_user_data;
+
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_write_as_task(rdma_write_task),
+				    RDMA_LATENCY_TASK_WRITE,
+				    doca_rdma_task_write_get_rdma_connection(rdma_write_task),
+				    rdma_latency_buf_len(doca_rdma_task_write_get_src_buf(rdma_write_task)));
+
+	DOCA_LOG_INFO("Written to responder \"%s\"", resources->cfg->write_string);
+
+	result = rdma_write_free_task_resources(rdma_write_task);
+	DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
+}
+
+/*
+ * RDMA write task error callback
+ *
+ * @rdma_write_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void rdma_write_error_callback(struct doca_rdma_task_write *rdma_write_task,
+				      union doca_data task_user_data,
+				      union doca_data ctx_user_data)
+{
+	struct rdma_resources *resources = (struct rdma_resources *)ctx_user_data.ptr;
+	struct doca_task *task = doca_rdma_task_write_as_task(rdma_write_task);
+	doca_error_t result;
+	(void)task_user_data;
+
+	/* Update that an error was encountered, the sync event tasks behind it are flushed by the stop */
+	result = doca_task_get_status(task);
+	DOCA_ERROR_PROPAGATE(resources->first_encountered_error, result);
+	DOCA_LOG_ERR("RDMA write task failed: %s", doca_error_get_descr(result));
+	rdma_latency_task_failed(resources->latency, task);
+
+	(void)rdma_write_free_task_resources(rdma_write_task);
+
+	(void)doca_ctx_stop(resources->rdma_ctx);
+}
+
+/*
+ * Write the payload the responder reads once the sync event is signaled. The write task is submitted ahead of the
+ * set task on the same connection, so the payload lands before the signal.
+ *
+ * @resources [in]: RDMA resources
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rdma_sync_event_requestor_submit_payload(struct rdma_resources *resources)
+{
+	struct doca_rdma_task_write *rdma_write_task = NULL;
+	struct doca_buf *src_buf = NULL, *dst_buf = NULL;
+	union doca_data task_user_data = {0};
+	char *payload = resources->mmap_memrange + EXAMPLE_PAYLOAD_OFFSET;
+	size_t payload_len = strlen(resources->cfg->write_string) + 1;
+	char *remote_mmap_range;
+	size_t remote_mmap_range_len;
+	doca_error_t result, tmp_result;
+
+	/* Create remote mmap */
+	result = doca_mmap_create_from_export(NULL,
+					      resources->remote_mmap_descriptor,
+					      resources->remote_mmap_descriptor_size,
+					      resources->doca_device,
+					      &(resources->remote_mmap));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Get the remote mmap memory range */
+	result = doca_mmap_get_memrange(resources->remote_mmap, (void **)&remote_mmap_range, &remote_mmap_range_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get DOCA memory map range: %s", doca_error_get_descr(result));
+		return result;
+	}
+	if (payload_len > remote_mmap_range_len) {
+		DOCA_LOG_ERR("Payload of %zu bytes exceeds the remote memory range of %zu bytes",
+			     payload_len,
+			     remote_mmap_range_len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	memcpy(payload, resources->cfg->write_string, payload_len);
+	result = doca_buf_inventory_buf_get_by_data(resources->buf_inventory,
+						    resources->mmap,
+						    payload,
+						    payload_len,
+						    &src_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DOCA buffer to DOCA buffer inventory: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_buf_get_by_addr(resources->buf_inventory,
+						    resources->remote_mmap,
+						    remote_mmap_range,
+						    payload_len,
+						    &dst_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DOCA buffer to DOCA buffer inventory: %s",
+			     doca_error_get_descr(result));
+		goto destroy_src_buf;
+	}
+
+	result = doca_rdma_task_write_allocate_init(resources->rdma,
+						    resources->connections[0],
+						    src_buf,
+						    dst_buf,
+						    task_user_data,
+						    &rdma_write_task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate RDMA write task: %s", doca_error_get_descr(result));
+		goto destroy_dst_buf;
+	}
+
+	DOCA_LOG_INFO("Submitting RDMA write task that writes \"%s\" to the responder", resources->cfg->write_string);
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_write_as_task(rdma_write_task));
+	result = doca_task_submit(doca_rdma_task_write_as_task(rdma_write_task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit RDMA write task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_write_as_task(rdma_write_task));
+		doca_task_free(doca_rdma_task_write_as_task(rdma_write_task));
+		goto destroy_dst_buf;
+	}
+
+	return DOCA_SUCCESS;
+
+destroy_dst_buf:
+	tmp_result = doca_buf_dec_refcount(dst_buf, NULL);
+	if (tmp_result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to decrease dst_buf count: %s", doca_error_get_descr(tmp_result));
+destroy_src_buf:
+	tmp_result = doca_buf_dec_refcount(src_buf, NULL);
+	if (tmp_result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to decrease src_buf count: %s", doca_error_get_descr(tmp_result));
+	return result;
+}
+
 /*
  * Prepare and submit RDMA sync event tasks
  *
@@ -403,6 +605,10 @@ static doca_error_t rdma_sync_event_requestor_prepare_and_submit_tasks(struct rd
 				     doca_error_get_descr(result));
 			return result;
 		}
+
+		result = rdma_sync_event_requestor_submit_payload(resources);
+		if (result != DOCA_SUCCESS)
+			return result;
 	}
 
 	successful_task_message = calloc(1, MAX_ARG_SIZE);
@@ -454,9 +660,11 @@ static doca_error_t rdma_sync_event_requestor_prepare_and_submit_tasks(struct rd
 	strncpy(successful_task_message,
 		"Remote sync event has been signaled successfully, now waiting for remote sync event to be signaled",
 		MAX_ARG_SIZE - 1);
+	rdma_latency_task_submitted(resources->latency, task);
 	result = doca_task_submit(task);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA remote sync event set task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, task);
 		goto free_set_task;
 	}
 	resources->num_remaining_tasks++;
@@ -494,9 +702,11 @@ static doca_error_t rdma_sync_event_requestor_prepare_and_submit_tasks(struct rd
 	/* Submit RDMA sync event get task */
 	task = doca_rdma_task_remote_net_sync_event_get_as_task(se_get_task);
 
+	rdma_latency_task_submitted(resources->latency, task);
 	result = doca_task_submit(task);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA remote sync event get task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, task);
 		doca_task_free(task);
 		goto destroy_get_buf;
 	}
@@ -727,6 +937,18 @@ doca_error_t rdma_sync_event_requester(struct rdma_config *cfg)
 		goto destroy_resources;
 	}
 
+	if (cfg->use_rdma_cm == true) {
+		result = doca_rdma_task_write_set_conf(resources.rdma,
+						       rdma_write_completed_callback,
+						       rdma_write_error_callback,
+						       NUM_RDMA_TASKS);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s",
+				     doca_error_get_descr(result));
+			goto destroy_resources;
+		}
+	}
+
 	result = doca_ctx_set_state_changed_cb(resources.rdma_ctx, rdma_sync_event_requestor_state_change_callback);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Unable to set state change callback for RDMA context: %s", doca_error_get_descr(result));
@@ -756,9 +978,13 @@ doca_error_t rdma_sync_event_requester(struct rdma_config *cfg)
 	}
 
 	if (cfg->use_rdma_cm == true) {
-		resources.recv_sync_event_desc = true;
 		resources.is_requester = true;
 		resources.require_remote_mmap = true;
+		/*
+		 * The sync event and the mmap the payload is written to arrive in one message, on a control buffer
+		 * registered before connecting
+		 */
+		resources.negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP | RDMA_NEGOTIATION_DESC_SYNC_EVENT;
 		resources.task_fn = rdma_sync_event_requestor_prepare_and_submit_tasks;
 		result = config_rdma_cm_callback_and_negotiation_task(&resources,
 								      /* need_send_mmap_info */ false,
@@ -221,12 +221,14 @@ static doca_error_t rdma_sync_event_responder_export_and_connect(struct rdma_res
 
 /*
  * Handle the event - wait for a signal, update the sync even and wait for completion.
+ * In RDMA-CM mode the requester writes a payload to the memory range ahead of the signal.
  *
- * @sync_event [in]: DOCA sync event
+ * @resources [in]: RDMA resources, including the DOCA sync event
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static doca_error_t rdma_sync_event_responder_handle_event(struct doca_sync_event *sync_event)
+static doca_error_t rdma_sync_event_responder_handle_event(struct rdma_resources *resources)
 {
+	struct doca_sync_event *sync_event = resources->sync_event;
 	doca_error_t result;
 
 	DOCA_LOG_INFO("Waiting for sync event to be signaled from remote");
@@ -236,6 +238,9 @@ static doca_error_t rdma_sync_event_responder_handle_event(struct doca_sync_even
 		return result;
 	}
 
+	if (resources->cfg->use_rdma_cm == true)
+		DOCA_LOG_INFO("Requester has written \"%.*s\"", MEM_RANGE_LEN, resources->mmap_memrange);
+
 	DOCA_LOG_INFO("Signaling sync event");
 	result = doca_sync_event_update_set(sync_event, EXAMPLE_SET_VALUE + 1);
 	if (result != DOCA_SUCCESS) {
@@ -263,7 +268,7 @@ static doca_error_t responder_wait_for_requester_finish(struct rdma_resources *r
 {
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
-	tmp_result = rdma_sync_event_responder_handle_event(resources->sync_event);
+	tmp_result = rdma_sync_event_responder_handle_event(resources);
 	if (tmp_result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Rdma_sync_event_responder_handle_event() failed: %s", doca_error_get_descr(tmp_result));
 		DOCA_ERROR_PROPAGATE(result, tmp_result);
@@ -403,9 +408,13 @@ doca_error_t rdma_sync_event_responder(struct rdma_config *cfg)
 	}
 
 	if (cfg->use_rdma_cm == true) {
-		resources.recv_sync_event_desc = true;
 		resources.is_requester = false;
 		resources.require_remote_mmap = true;
+		/*
+		 * The sync event and the mmap the requester writes its payload to go in one message, on a control
+		 * buffer registered before connecting
+		 */
+		resources.negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP | RDMA_NEGOTIATION_DESC_SYNC_EVENT;
 		resources.task_fn = responder_wait_for_requester_finish;
 		result = config_rdma_cm_callback_and_negotiation_task(&resources,
 								      /* need_send_mmap_info */ true,
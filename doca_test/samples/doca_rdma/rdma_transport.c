@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_log.h>
+
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA::TRANSPORT);
+
+doca_error_t rdma_transport_parse_type(const char *name, enum rdma_transport_type *type)
+{
+	if (strcmp(name, "doca") == 0)
+		*type = RDMA_TRANSPORT_DOCA;
+	else if (strcmp(name, "shm") == 0)
+		*type = RDMA_TRANSPORT_SHM;
+	else {
+		DOCA_LOG_ERR("Unknown transport \"%s\", expected \"doca\" or \"shm\"", name);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_transport_create(enum rdma_transport_type type,
+				   const struct rdma_transport_attr *attr,
+				   struct rdma_transport **transport)
+{
+	const struct rdma_transport_ops *ops;
+	doca_error_t result;
+
+	switch (type) {
+	case RDMA_TRANSPORT_DOCA:
+		ops = &rdma_transport_doca_ops;
+		break;
+	case RDMA_TRANSPORT_SHM:
+		ops = &rdma_transport_shm_ops;
+		break;
+	default:
+		DOCA_LOG_ERR("Unknown transport type %d", type);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	if (attr->send_queue_size == 0 || attr->recv_queue_size == 0) {
+		DOCA_LOG_ERR("Transport queue sizes must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = ops->create(attr, transport);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create %s transport: %s", ops->name, doca_error_get_descr(result));
+		return result;
+	}
+	(*transport)->ops = ops;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t rdma_transport_connect(struct rdma_transport *first, struct rdma_transport *second)
+{
+	if (first->ops != second->ops || first == second) {
+		DOCA_LOG_ERR("Only two distinct transports of the same backend can be connected");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return first->ops->connect(first, second);
+}
+
+doca_error_t rdma_transport_stop(struct rdma_transport *transport)
+{
+	if (transport == NULL)
+		return DOCA_SUCCESS;
+
+	return transport->ops->stop(transport);
+}
+
+doca_error_t rdma_transport_destroy(struct rdma_transport *transport)
+{
+	if (transport == NULL)
+		return DOCA_SUCCESS;
+
+	return transport->ops->destroy(transport);
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_TRANSPORT_H_
+#define RDMA_TRANSPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#include "rdma_common.h"
+
+/*
+ * Thin transport interface for the RDMA data-path engines.
+ *
+ * A transport is one endpoint of a point to point connection with verbs-like semantics: memory is registered once,
+ * send/receive/write/read operations are posted with a 64-bit user data, and their completions are polled in
+ * batches. Two backends implement it:
+ *  - RDMA_TRANSPORT_DOCA: DOCA RDMA, one context and progress engine per transport, polling progresses the PE.
+ *  - RDMA_TRANSPORT_SHM: in-process loopback over shared memory, no device needed. The queues of a connected pair
+ *    live in a memfd mapping, writes and reads are memcpy() into the registered remote region.
+ *
+ * Completion semantics common to both backends:
+ *  - Every post returns DOCA_ERROR_AGAIN when its queue is full, and is otherwise completed exactly once.
+ *  - Posted receives are consumed in order, a send waits until the peer posts a receive (infinite RNR retry).
+ *  - A send larger than the receive buffer completes with an error on both sides.
+ *  - Local memory outside its registration, or remote memory outside the imported region, is rejected by the post
+ *    with DOCA_ERROR_INVALID_VALUE.
+ *  - The completion of a receive reports the received length, other completions report the posted length.
+ *
+ * Lifecycle: create, connect, register memory, post and poll, stop, deregister memory, destroy. Stopping flushes
+ * the posted receives, so that their memory can be deregistered while the backend resources are still alive.
+ *
+ * Threading: a transport is driven by a single thread; the two transports of a pair may run on different threads.
+ *
+ * Users: the read pull engine runs over a transport as well as over DOCA RDMA directly. The receive ring, stream and
+ * inline send engines stay on DOCA RDMA: they depend on immediate data (receive ring, stream), on the device inline
+ * threshold (inline send) and on many connections sharing one context and task pool, which this interface does not
+ * model.
+ */
+
+/* Available transport backends */
+enum rdma_transport_type {
+	RDMA_TRANSPORT_DOCA, /* DOCA RDMA */
+	RDMA_TRANSPORT_SHM,  /* Shared-memory loopback */
+};
+
+/* Operation of a completion */
+enum rdma_transport_opcode {
+	RDMA_TRANSPORT_OP_SEND,	 /* Send */
+	RDMA_TRANSPORT_OP_RECV,	 /* Receive */
+	RDMA_TRANSPORT_OP_WRITE, /* RDMA write */
+	RDMA_TRANSPORT_OP_READ,	 /* RDMA read */
+};
+
+struct rdma_transport;
+struct rdma_transport_mr;
+struct rdma_transport_rmr;
+
+/* Attributes of a transport */
+struct rdma_transport_attr {
+	const struct rdma_config *rdma_cfg; /* Device name, transport type and GID index, DOCA backend only */
+	uint32_t send_queue_size;	    /* Maximal number of sends, writes and reads in flight */
+	uint32_t recv_queue_size;	    /* Maximal number of posted receives */
+};
+
+/* Local memory of an operation */
+struct rdma_transport_sge {
+	struct rdma_transport_mr *mr; /* Registration containing the memory */
+	void *addr;		      /* Start address */
+	uint32_t len;		      /* Length in bytes */
+};
+
+/* A completed operation */
+struct rdma_transport_completion {
+	uint64_t user_data;		  /* User data of the post */
+	enum rdma_transport_opcode opcode; /* Operation */
+	doca_error_t status;		  /* DOCA_SUCCESS or the reason of the failure */
+	uint32_t len;			  /* Received length for receives, posted length otherwise */
+};
+
+/* Backend operations, see the rdma_transport_*() wrappers for their semantics */
+struct rdma_transport_ops {
+	const char *name; /* Backend name */
+	doca_error_t (*create)(const struct rdma_transport_attr *attr, struct rdma_transport **transport);
+	doca_error_t (*connect)(struct rdma_transport *first, struct rdma_transport *second);
+	doca_error_t (*reg_mr)(struct rdma_transport *transport, void *addr, size_t len, struct rdma_transport_mr **mr);
+	doca_error_t (*dereg_mr)(struct rdma_transport *transport, struct rdma_transport_mr *mr);
+	doca_error_t (*export_mr)(struct rdma_transport *transport,
+				  struct rdma_transport_mr *mr,
+				  const void **desc,
+				  size_t *desc_len);
+	doca_error_t (*import_mr)(struct rdma_transport *transport,
+				  const void *desc,
+				  size_t desc_len,
+				  struct rdma_transport_rmr **rmr);
+	doca_error_t (*release_rmr)(struct rdma_transport *transport, struct rdma_transport_rmr *rmr);
+	doca_error_t (*post_send)(struct rdma_transport *transport,
+				  const struct rdma_transport_sge *sge,
+				  uint64_t user_data);
+	doca_error_t (*post_recv)(struct rdma_transport *transport,
+				  const struct rdma_transport_sge *sge,
+				  uint64_t user_data);
+	doca_error_t (*post_write)(struct rdma_transport *transport,
+				   const struct rdma_transport_sge *sge,
+				   struct rdma_transport_rmr *rmr,
+				   uint64_t remote_addr,
+				   uint64_t user_data);
+	doca_error_t (*post_read)(struct rdma_transport *transport,
+				  const struct rdma_transport_sge *sge,
+				  struct rdma_transport_rmr *rmr,
+				  uint64_t remote_addr,
+				  uint64_t user_data);
+	uint32_t (*poll)(struct rdma_transport *transport,
+			 struct rdma_transport_completion *completions,
+			 uint32_t max_completions);
+	doca_error_t (*stop)(struct rdma_transport *transport);
+	doca_error_t (*destroy)(struct rdma_transport *transport);
+};
+
+/* Common part of every backend transport, backends embed it as their first member */
+struct rdma_transport {
+	const struct rdma_transport_ops *ops; /* Backend operations */
+};
+
+/* Backend operation tables */
+extern const struct rdma_transport_ops rdma_transport_doca_ops;
+extern const struct rdma_transport_ops rdma_transport_shm_ops;
+
+/*
+ * Parse a transport backend name
+ *
+ * @name [in]: "doca" or "shm"
+ * @type [out]: the backend
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_transport_parse_type(const char *name, enum rdma_transport_type *type);
+
+/*
+ * Create a transport, it must be connected before anything is posted on it
+ *
+ * @type [in]: backend
+ * @attr [in]: transport attributes
+ * @transport [out]: the created transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_transport_create(enum rdma_transport_type type,
+				   const struct rdma_transport_attr *attr,
+				   struct rdma_transport **transport);
+
+/*
+ * Connect two transports of the same backend to each other
+ *
+ * @first [in]: first transport
+ * @second [in]: second transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_transport_connect(struct rdma_transport *first, struct rdma_transport *second);
+
+/*
+ * Register local memory, with local and remote read and write access
+ *
+ * @transport [in]: the transport
+ * @addr [in]: start address
+ * @len [in]: length in bytes
+ * @mr [out]: the registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_reg_mr(struct rdma_transport *transport,
+						 void *addr,
+						 size_t len,
+						 struct rdma_transport_mr **mr)
+{
+	return transport->ops->reg_mr(transport, addr, len, mr);
+}
+
+/*
+ * Deregister local memory, no operation using it may be in flight
+ *
+ * @transport [in]: the transport
+ * @mr [in]: the registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_dereg_mr(struct rdma_transport *transport, struct rdma_transport_mr *mr)
+{
+	return transport->ops->dereg_mr(transport, mr);
+}
+
+/*
+ * Export a registration for the peer, the descriptor is valid as long as the registration
+ *
+ * @transport [in]: the transport
+ * @mr [in]: the registration
+ * @desc [out]: descriptor to pass to rdma_transport_import_mr() of the peer
+ * @desc_len [out]: descriptor length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_export_mr(struct rdma_transport *transport,
+						    struct rdma_transport_mr *mr,
+						    const void **desc,
+						    size_t *desc_len)
+{
+	return transport->ops->export_mr(transport, mr, desc, desc_len);
+}
+
+/*
+ * Import a registration exported by the peer, the target of writes and reads
+ *
+ * @transport [in]: the transport
+ * @desc [in]: descriptor from rdma_transport_export_mr()
+ * @desc_len [in]: descriptor length
+ * @rmr [out]: the remote registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_import_mr(struct rdma_transport *transport,
+						    const void *desc,
+						    size_t desc_len,
+						    struct rdma_transport_rmr **rmr)
+{
+	return transport->ops->import_mr(transport, desc, desc_len, rmr);
+}
+
+/*
+ * Release an imported registration, no operation using it may be in flight
+ *
+ * @transport [in]: the transport
+ * @rmr [in]: the remote registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_release_rmr(struct rdma_transport *transport,
+						      struct rdma_transport_rmr *rmr)
+{
+	return transport->ops->release_rmr(transport, rmr);
+}
+
+/*
+ * Post a send of local memory to the next posted receive of the peer
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the send queue is full and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_post_send(struct rdma_transport *transport,
+						    const struct rdma_transport_sge *sge,
+						    uint64_t user_data)
+{
+	return transport->ops->post_send(transport, sge, user_data);
+}
+
+/*
+ * Post a receive buffer
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the receive queue is full and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_post_recv(struct rdma_transport *transport,
+						    const struct rdma_transport_sge *sge,
+						    uint64_t user_data)
+{
+	return transport->ops->post_recv(transport, sge, user_data);
+}
+
+/*
+ * Post an RDMA write of local memory to a remote address
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration containing the destination
+ * @remote_addr [in]: destination address
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the send queue is full and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_post_write(struct rdma_transport *transport,
+						     const struct rdma_transport_sge *sge,
+						     struct rdma_transport_rmr *rmr,
+						     uint64_t remote_addr,
+						     uint64_t user_data)
+{
+	return transport->ops->post_write(transport, sge, rmr, remote_addr, user_data);
+}
+
+/*
+ * Post an RDMA read of a remote address into local memory
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration containing the source
+ * @remote_addr [in]: source address
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the send queue is full and DOCA_ERROR otherwise
+ */
+static inline doca_error_t rdma_transport_post_read(struct rdma_transport *transport,
+						    const struct rdma_transport_sge *sge,
+						    struct rdma_transport_rmr *rmr,
+						    uint64_t remote_addr,
+						    uint64_t user_data)
+{
+	return transport->ops->post_read(transport, sge, rmr, remote_addr, user_data);
+}
+
+/*
+ * Poll completions
+ *
+ * @transport [in]: the transport
+ * @completions [out]: completed operations
+ * @max_completions [in]: size of completions
+ * @return: number of completions written
+ */
+static inline uint32_t rdma_transport_poll(struct rdma_transport *transport,
+					   struct rdma_transport_completion *completions,
+					   uint32_t max_completions)
+{
+	return transport->ops->poll(transport, completions, max_completions);
+}
+
+/*
+ * Stop a transport: nothing can be posted anymore and the posted receives are flushed without completions
+ * No send, write or read may be in flight
+ *
+ * @transport [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_transport_stop(struct rdma_transport *transport);
+
+/*
+ * Destroy a transport, stopping it first if needed; its registrations must be released before
+ *
+ * @transport [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_transport_destroy(struct rdma_transport *transport);
+
+#endif /* RDMA_TRANSPORT_H_ */
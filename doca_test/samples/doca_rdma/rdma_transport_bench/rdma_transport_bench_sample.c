@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "bench_common.h"
+#include "rdma_bench_common.h"
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA_TRANSPORT_BENCH::SAMPLE);
+
+#define POLL_BATCH (32)			     /* Completions polled at once */
+#define DRAIN_TIMEOUT_NS (BENCH_NSEC_PER_SEC) /* Time to wait for the operations in flight at the end of a phase */
+#define TIME_CHECK_INTERVAL (1024)	     /* Number of polls between two deadline checks */
+#define NUM_PHASES (3)			     /* Write, send and read back phases share the duration */
+
+/* Benchmark state, the requester posts sends, writes and reads and the responder owns the target memory */
+struct transport_bench {
+	struct rdma_bench_config *cfg;		  /* Benchmark configuration */
+	struct rdma_transport *requester;	  /* Transport posting the operations */
+	struct rdma_transport *responder;	  /* Transport receiving the sends and exposing its region */
+	size_t region_len;			  /* Length of every region, one message slot per queue entry */
+	char *src;				  /* Requester source region */
+	char *check;				  /* Requester region the responder region is read back into */
+	char *dst;				  /* Responder region, target of writes and reads */
+	char *recv_bufs;			  /* Responder receive buffers */
+	struct rdma_transport_mr *src_mr;	  /* Registration of src */
+	struct rdma_transport_mr *check_mr;	  /* Registration of check */
+	struct rdma_transport_mr *dst_mr;	  /* Registration of dst */
+	struct rdma_transport_mr *recv_mr;	  /* Registration of recv_bufs */
+	struct rdma_transport_rmr *dst_rmr;	  /* Import of dst by the requester */
+	struct rdma_transport_completion comps[POLL_BATCH]; /* Polled completions */
+};
+
+/*
+ * Get the local memory of a message slot
+ *
+ * @mr [in]: registration of the region
+ * @region [in]: region start
+ * @msg_size [in]: message size
+ * @slot [in]: slot index
+ * @return: the slot memory
+ */
+static struct rdma_transport_sge slot_sge(struct rdma_transport_mr *mr, char *region, uint32_t msg_size, uint64_t slot)
+{
+	struct rdma_transport_sge sge = {.mr = mr, .addr = region + slot * msg_size, .len = msg_size};
+
+	return sge;
+}
+
+/*
+ * Poll the requester until all its operations completed, checking every status
+ *
+ * @bench [in]: benchmark state
+ * @num_inflight [in/out]: number of operations in flight
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t drain_requester(struct transport_bench *bench, uint32_t *num_inflight)
+{
+	uint64_t deadline_ns = bench_get_time_ns() + DRAIN_TIMEOUT_NS;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t num, i;
+
+	while (*num_inflight > 0) {
+		if (bench_get_time_ns() >= deadline_ns) {
+			DOCA_LOG_ERR("Timed out with %u operations in flight", *num_inflight);
+			return DOCA_ERROR_TIME_OUT;
+		}
+		num = rdma_transport_poll(bench->requester, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++)
+			DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+		*num_inflight -= num;
+	}
+
+	return result;
+}
+
+/*
+ * Keep queue_depth writes in flight from the source slots to the same responder slots
+ *
+ * @bench [in]: benchmark state
+ * @duration_ns [in]: length of the phase
+ * @num_ops [out]: number of completed writes
+ * @elapsed_ns [out]: length of the timed region
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_writes(struct transport_bench *bench,
+			       uint64_t duration_ns,
+			       uint64_t *num_ops,
+			       uint64_t *elapsed_ns)
+{
+	const uint32_t depth = bench->cfg->queue_depth, msg_size = bench->cfg->msg_size;
+	uint64_t start_ns = bench_get_time_ns(), deadline_ns = start_ns + duration_ns, num_polls = 0;
+	struct rdma_transport_sge sge;
+	uint32_t num_inflight = 0, num, i;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	bool running = true;
+	uint64_t slot;
+
+	*num_ops = 0;
+	for (slot = 0; slot < depth; slot++) {
+		sge = slot_sge(bench->src_mr, bench->src, msg_size, slot);
+		result = rdma_transport_post_write(bench->requester,
+						   &sge,
+						   bench->dst_rmr,
+						   (uintptr_t)(bench->dst + slot * msg_size),
+						   slot);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to post write: %s", doca_error_get_descr(result));
+			running = false;
+			break;
+		}
+		num_inflight++;
+	}
+
+	while (running) {
+		num = rdma_transport_poll(bench->requester, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			num_inflight--;
+			if (bench->comps[i].status != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+				running = false;
+				continue;
+			}
+			(*num_ops)++;
+			slot = bench->comps[i].user_data;
+			sge = slot_sge(bench->src_mr, bench->src, msg_size, slot);
+			tmp_result = rdma_transport_post_write(bench->requester,
+							       &sge,
+							       bench->dst_rmr,
+							       (uintptr_t)(bench->dst + slot * msg_size),
+							       slot);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+				running = false;
+				continue;
+			}
+			num_inflight++;
+		}
+		if ((++num_polls % TIME_CHECK_INTERVAL) == 0 && bench_get_time_ns() >= deadline_ns)
+			running = false;
+	}
+
+	tmp_result = drain_requester(bench, &num_inflight);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	*elapsed_ns = bench_get_time_ns() - start_ns;
+	return result;
+}
+
+/*
+ * Keep queue_depth sends in flight to the responder, which reposts every receive after checking the message order
+ *
+ * @bench [in]: benchmark state
+ * @duration_ns [in]: length of the phase
+ * @num_ops [out]: number of messages received in order
+ * @elapsed_ns [out]: length of the timed region
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_sends(struct transport_bench *bench,
+			      uint64_t duration_ns,
+			      uint64_t *num_ops,
+			      uint64_t *elapsed_ns)
+{
+	const uint32_t depth = bench->cfg->queue_depth, msg_size = bench->cfg->msg_size;
+	uint64_t start_ns = bench_get_time_ns(), deadline_ns = start_ns + duration_ns, num_polls = 0;
+	uint64_t next_seq = 0, expected_seq = 0, seq, slot;
+	uint32_t num_sends = 0, num_recvs = 0, num, i;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	struct rdma_transport_sge sge;
+	bool running = true;
+
+	*num_ops = 0;
+	for (slot = 0; slot < depth && result == DOCA_SUCCESS; slot++) {
+		sge = slot_sge(bench->recv_mr, bench->recv_bufs, msg_size, slot);
+		result = rdma_transport_post_recv(bench->responder, &sge, slot);
+		if (result == DOCA_SUCCESS)
+			num_recvs++;
+	}
+
+	/* Every send carries its sequence number in the first bytes of its slot */
+	for (slot = 0; slot < depth && result == DOCA_SUCCESS; slot++) {
+		memcpy(bench->src + slot * msg_size, &next_seq, sizeof(next_seq));
+		sge = slot_sge(bench->src_mr, bench->src, msg_size, slot);
+		result = rdma_transport_post_send(bench->requester, &sge, slot);
+		if (result == DOCA_SUCCESS) {
+			num_sends++;
+			next_seq++;
+		}
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to post the initial operations: %s", doca_error_get_descr(result));
+		running = false;
+	}
+
+	while (running || num_sends > 0) {
+		num = rdma_transport_poll(bench->responder, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			num_recvs--;
+			slot = bench->comps[i].user_data;
+			if (bench->comps[i].status != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+				running = false;
+				continue;
+			}
+			memcpy(&seq, bench->recv_bufs + slot * msg_size, sizeof(seq));
+			if (seq != expected_seq++ || bench->comps[i].len != msg_size) {
+				DOCA_LOG_ERR("Received message %lu of %u bytes, expected message %lu",
+					     seq,
+					     bench->comps[i].len,
+					     expected_seq - 1);
+				DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_UNEXPECTED);
+				running = false;
+			}
+			(*num_ops)++;
+			sge = slot_sge(bench->recv_mr, bench->recv_bufs, msg_size, slot);
+			tmp_result = rdma_transport_post_recv(bench->responder, &sge, slot);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+				running = false;
+				continue;
+			}
+			num_recvs++;
+		}
+
+		num = rdma_transport_poll(bench->requester, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			num_sends--;
+			if (bench->comps[i].status != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+				running = false;
+				continue;
+			}
+			if (!running)
+				continue;
+			slot = bench->comps[i].user_data;
+			memcpy(bench->src + slot * msg_size, &next_seq, sizeof(next_seq));
+			sge = slot_sge(bench->src_mr, bench->src, msg_size, slot);
+			tmp_result = rdma_transport_post_send(bench->requester, &sge, slot);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+				running = false;
+				continue;
+			}
+			num_sends++;
+			next_seq++;
+		}
+
+		if ((++num_polls % TIME_CHECK_INTERVAL) == 0 && bench_get_time_ns() >= deadline_ns) {
+			if (!running) {
+				DOCA_LOG_ERR("Timed out with %u sends in flight", num_sends);
+				DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_TIME_OUT);
+				break;
+			}
+			running = false;
+			deadline_ns += DRAIN_TIMEOUT_NS;
+		}
+	}
+
+	*elapsed_ns = bench_get_time_ns() - start_ns;
+	if (result == DOCA_SUCCESS && num_sends == 0 && *num_ops != next_seq) {
+		DOCA_LOG_ERR("Sent %lu messages but received %lu", next_seq, *num_ops);
+		result = DOCA_ERROR_UNEXPECTED;
+	}
+	/* The remaining posted receives are flushed when the responder is destroyed */
+	return result;
+}
+
+/*
+ * Read the responder region back and compare it with the source region written by run_writes()
+ *
+ * @bench [in]: benchmark state
+ * @num_ops [out]: number of completed reads
+ * @elapsed_ns [out]: length of the timed region
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_read_back(struct transport_bench *bench, uint64_t *num_ops, uint64_t *elapsed_ns)
+{
+	const uint32_t depth = bench->cfg->queue_depth, msg_size = bench->cfg->msg_size;
+	uint64_t start_ns = bench_get_time_ns();
+	struct rdma_transport_sge sge;
+	uint32_t num_inflight = 0;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	uint64_t slot;
+
+	memset(bench->check, 0, bench->region_len);
+	for (slot = 0; slot < depth; slot++) {
+		sge = slot_sge(bench->check_mr, bench->check, msg_size, slot);
+		result = rdma_transport_post_read(bench->requester,
+						  &sge,
+						  bench->dst_rmr,
+						  (uintptr_t)(bench->dst + slot * msg_size),
+						  slot);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to post read: %s", doca_error_get_descr(result));
+			break;
+		}
+		num_inflight++;
+	}
+	*num_ops = num_inflight;
+
+	tmp_result = drain_requester(bench, &num_inflight);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	*elapsed_ns = bench_get_time_ns() - start_ns;
+
+	if (result == DOCA_SUCCESS && memcmp(bench->check, bench->dst, bench->region_len) != 0) {
+		DOCA_LOG_ERR("Data read back differs from the responder region");
+		result = DOCA_ERROR_UNEXPECTED;
+	}
+	return result;
+}
+
+/*
+ * Log the rate of a phase
+ *
+ * @name [in]: phase name
+ * @num_ops [in]: number of completed operations
+ * @msg_size [in]: size of every operation
+ * @elapsed_ns [in]: length of the phase
+ */
+static void report_phase(const char *name, uint64_t num_ops, uint32_t msg_size, uint64_t elapsed_ns)
+{
+	if (elapsed_ns == 0)
+		return;
+	DOCA_LOG_INFO("%-10s %12lu ops %10.3f Mops/s %10.3f Gbit/s",
+		      name,
+		      num_ops,
+		      (double)num_ops * 1000.0 / (double)elapsed_ns,
+		      (double)num_ops * msg_size * 8.0 / (double)elapsed_ns);
+}
+
+/*
+ * Register the regions of the benchmark and import the responder region on the requester
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_regions(struct transport_bench *bench)
+{
+	const void *desc;
+	size_t desc_len;
+	doca_error_t result;
+
+	result = rdma_transport_reg_mr(bench->requester, bench->src, bench->region_len, &bench->src_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_reg_mr(bench->requester, bench->check, bench->region_len, &bench->check_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_reg_mr(bench->responder, bench->dst, bench->region_len, &bench->dst_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_reg_mr(bench->responder, bench->recv_bufs, bench->region_len, &bench->recv_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_transport_export_mr(bench->responder, bench->dst_mr, &desc, &desc_len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return rdma_transport_import_mr(bench->requester, desc, desc_len, &bench->dst_rmr);
+}
+
+/*
+ * Release the registrations of the benchmark
+ *
+ * @bench [in]: benchmark state
+ */
+static void deregister_regions(struct transport_bench *bench)
+{
+	if (bench->dst_rmr != NULL)
+		(void)rdma_transport_release_rmr(bench->requester, bench->dst_rmr);
+	if (bench->recv_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->responder, bench->recv_mr);
+	if (bench->dst_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->responder, bench->dst_mr);
+	if (bench->check_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->requester, bench->check_mr);
+	if (bench->src_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->requester, bench->src_mr);
+}
+
+/*
+ * Run writes, sends and a verified read back through the transport interface, with the selected backend
+ *
+ * @cfg [in]: Configuration parameters, the device is used by the DOCA backend only
+ * @type [in]: transport backend
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_transport_bench(struct rdma_bench_config *cfg, enum rdma_transport_type type)
+{
+	struct transport_bench bench = {0};
+	struct rdma_transport_attr attr = {0};
+	uint64_t phase_ns, num_ops, elapsed_ns;
+	doca_error_t result, tmp_result;
+	size_t i;
+
+	bench.cfg = cfg;
+	bench.region_len = (size_t)cfg->queue_depth * cfg->msg_size;
+	phase_ns = (uint64_t)cfg->duration_sec * BENCH_NSEC_PER_SEC / NUM_PHASES;
+
+	bench.src = malloc(bench.region_len);
+	bench.check = malloc(bench.region_len);
+	bench.dst = calloc(1, bench.region_len);
+	bench.recv_bufs = calloc(1, bench.region_len);
+	if (bench.src == NULL || bench.check == NULL || bench.dst == NULL || bench.recv_bufs == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %zu bytes regions", bench.region_len);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_regions;
+	}
+	for (i = 0; i < bench.region_len; i++)
+		bench.src[i] = (char)(i * 131 + 7);
+
+	attr.rdma_cfg = &cfg->rdma;
+	attr.send_queue_size = cfg->queue_depth;
+	attr.recv_queue_size = cfg->queue_depth;
+	result = rdma_transport_create(type, &attr, &bench.requester);
+	if (result != DOCA_SUCCESS)
+		goto free_regions;
+	result = rdma_transport_create(type, &attr, &bench.responder);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transports;
+
+	result = rdma_transport_connect(bench.requester, bench.responder);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transports;
+
+	result = register_regions(&bench);
+	if (result != DOCA_SUCCESS)
+		goto deregister_regions;
+
+	DOCA_LOG_INFO("Transport %s, message size %u, queue depth %u",
+		      bench.requester->ops->name,
+		      cfg->msg_size,
+		      cfg->queue_depth);
+
+	result = run_writes(&bench, phase_ns, &num_ops, &elapsed_ns);
+	if (result != DOCA_SUCCESS)
+		goto deregister_regions;
+	report_phase("write", num_ops, cfg->msg_size, elapsed_ns);
+
+	result = run_read_back(&bench, &num_ops, &elapsed_ns);
+	if (result != DOCA_SUCCESS)
+		goto deregister_regions;
+	if (memcmp(bench.check, bench.src, bench.region_len) != 0) {
+		DOCA_LOG_ERR("Responder region differs from the written source region");
+		result = DOCA_ERROR_UNEXPECTED;
+		goto deregister_regions;
+	}
+	report_phase("read back", num_ops, cfg->msg_size, elapsed_ns);
+
+	result = run_sends(&bench, phase_ns, &num_ops, &elapsed_ns);
+	if (result != DOCA_SUCCESS)
+		goto deregister_regions;
+	report_phase("send", num_ops, cfg->msg_size, elapsed_ns);
+
+deregister_regions:
+	/* Stopping flushes the receives still posted on the responder, so their memory can be deregistered */
+	tmp_result = rdma_transport_stop(bench.responder);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_transport_stop(bench.requester);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	deregister_regions(&bench);
+destroy_transports:
+	tmp_result = rdma_transport_destroy(bench.responder);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_transport_destroy(bench.requester);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+free_regions:
+	free(bench.recv_bufs);
+	free(bench.dst);
+	free(bench.check);
+	free(bench.src);
+	return result;
+}
@@ -0,0 +1,896 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+
+#include "rdma_bench_common.h"
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA::TRANSPORT_DOCA);
+
+#define DOCA_TRANSPORT_MR_PERMISSIONS \
+	(DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ | DOCA_ACCESS_FLAG_RDMA_WRITE)
+#define DOCA_TRANSPORT_RNR_RETRY_INFINITE (7) /* RNR retry count the verbs spec reserves for retrying forever */
+
+/* DOCA RDMA transport */
+struct doca_transport {
+	struct rdma_transport base;		    /* Common part, must be the first member */
+	struct doca_dev *dev;			    /* DOCA device */
+	struct doca_pe *pe;			    /* Progress engine of this transport only */
+	struct rdma_bench_endpoint endpoint;	    /* DOCA RDMA context and its single connection */
+	struct doca_buf_inventory *inventory;	    /* Inventory for the buffers of posted operations */
+	uint32_t send_queue_size;		    /* Maximal number of sends, writes and reads in flight */
+	uint32_t recv_queue_size;		    /* Maximal number of posted receives */
+	uint32_t num_sends;			    /* Sends, writes and reads posted and not polled yet */
+	uint32_t num_recvs;			    /* Receives posted and not polled yet */
+	struct rdma_transport_completion *cq;	    /* Completions reported by the task callbacks, not polled yet */
+	uint32_t cq_size;			    /* Capacity of cq, all the operations that can be in flight */
+	uint32_t cq_head;			    /* Index of the oldest completion in cq */
+	uint32_t cq_count;			    /* Number of completions in cq */
+};
+
+/* Registration of local memory */
+struct rdma_transport_mr {
+	struct doca_mmap *mmap; /* Local mmap */
+};
+
+/* Imported registration of the peer */
+struct rdma_transport_rmr {
+	struct doca_mmap *mmap; /* Mmap created from the export descriptor of the peer */
+};
+
+/*
+ * Queue the completion of a task and release its resources
+ *
+ * @transport [in]: the transport
+ * @task [in]: completed task
+ * @opcode [in]: operation of the task
+ * @status [in]: task status
+ * @len [in]: length to report
+ * @bufs [in]: buffers of the task, NULL entries are ignored
+ * @num_bufs [in]: number of entries in bufs
+ */
+static void doca_transport_complete(struct doca_transport *transport,
+				    struct doca_task *task,
+				    enum rdma_transport_opcode opcode,
+				    doca_error_t status,
+				    uint32_t len,
+				    struct doca_buf **bufs,
+				    uint32_t num_bufs)
+{
+	struct rdma_transport_completion *completion;
+	uint32_t i;
+
+	/* The queue holds every operation that can be in flight, so it is never full */
+	completion = &transport->cq[(transport->cq_head + transport->cq_count) % transport->cq_size];
+	completion->user_data = doca_task_get_user_data(task).u64;
+	completion->opcode = opcode;
+	completion->status = status;
+	completion->len = len;
+	transport->cq_count++;
+
+	doca_task_free(task);
+	for (i = 0; i < num_bufs; i++)
+		if (bufs[i] != NULL)
+			(void)doca_buf_dec_refcount(bufs[i], NULL);
+}
+
+/*
+ * RDMA send task callback, for both successful and failed tasks
+ *
+ * @task [in]: finished task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: the transport
+ */
+static void doca_transport_send_callback(struct doca_rdma_task_send *task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct doca_buf *bufs[] = {(struct doca_buf *)doca_rdma_task_send_get_src_buf(task)};
+	struct doca_task *base_task = doca_rdma_task_send_as_task(task);
+	size_t len = 0;
+
+	(void)task_user_data;
+
+	(void)doca_buf_get_data_len(bufs[0], &len);
+	doca_transport_complete((struct doca_transport *)ctx_user_data.ptr,
+				base_task,
+				RDMA_TRANSPORT_OP_SEND,
+				doca_task_get_status(base_task),
+				(uint32_t)len,
+				bufs,
+				1);
+}
+
+/*
+ * RDMA receive task callback, for both successful and failed tasks
+ *
+ * @task [in]: finished task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: the transport
+ */
+static void doca_transport_recv_callback(struct doca_rdma_task_receive *task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct doca_buf *bufs[] = {doca_rdma_task_receive_get_dst_buf(task)};
+	struct doca_task *base_task = doca_rdma_task_receive_as_task(task);
+	doca_error_t status = doca_task_get_status(base_task);
+
+	(void)task_user_data;
+
+	doca_transport_complete((struct doca_transport *)ctx_user_data.ptr,
+				base_task,
+				RDMA_TRANSPORT_OP_RECV,
+				status,
+				status == DOCA_SUCCESS ? doca_rdma_task_receive_get_result_len(task) : 0,
+				bufs,
+				1);
+}
+
+/*
+ * RDMA write task callback, for both successful and failed tasks
+ *
+ * @task [in]: finished task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: the transport
+ */
+static void doca_transport_write_callback(struct doca_rdma_task_write *task,
+					  union doca_data task_user_data,
+					  union doca_data ctx_user_data)
+{
+	struct doca_buf *bufs[] = {(struct doca_buf *)doca_rdma_task_write_get_src_buf(task),
+				   doca_rdma_task_write_get_dst_buf(task)};
+	struct doca_task *base_task = doca_rdma_task_write_as_task(task);
+	size_t len = 0;
+
+	(void)task_user_data;
+
+	(void)doca_buf_get_data_len(bufs[0], &len);
+	doca_transport_complete((struct doca_transport *)ctx_user_data.ptr,
+				base_task,
+				RDMA_TRANSPORT_OP_WRITE,
+				doca_task_get_status(base_task),
+				(uint32_t)len,
+				bufs,
+				2);
+}
+
+/*
+ * RDMA read task callback, for both successful and failed tasks
+ *
+ * @task [in]: finished task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: the transport
+ */
+static void doca_transport_read_callback(struct doca_rdma_task_read *task,
+					 union doca_data task_user_data,
+					 union doca_data ctx_user_data)
+{
+	struct doca_buf *bufs[] = {(struct doca_buf *)doca_rdma_task_read_get_src_buf(task),
+				   doca_rdma_task_read_get_dst_buf(task)};
+	struct doca_task *base_task = doca_rdma_task_read_as_task(task);
+	size_t len = 0;
+
+	(void)task_user_data;
+
+	(void)doca_buf_get_data_len(bufs[0], &len);
+	doca_transport_complete((struct doca_transport *)ctx_user_data.ptr,
+				base_task,
+				RDMA_TRANSPORT_OP_READ,
+				doca_task_get_status(base_task),
+				(uint32_t)len,
+				bufs,
+				2);
+}
+
+/*
+ * Set the configuration of the four task types, the same callback handles completions and errors
+ *
+ * @transport [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_set_task_confs(struct doca_transport *transport)
+{
+	struct doca_rdma *rdma = transport->endpoint.rdma;
+	doca_error_t result;
+
+	result = doca_rdma_task_send_set_conf(rdma,
+					      doca_transport_send_callback,
+					      doca_transport_send_callback,
+					      transport->send_queue_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA send task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_receive_set_conf(rdma,
+						 doca_transport_recv_callback,
+						 doca_transport_recv_callback,
+						 transport->recv_queue_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA receive task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_write_set_conf(rdma,
+					       doca_transport_write_callback,
+					       doca_transport_write_callback,
+					       transport->send_queue_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA write task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_rdma_task_read_set_conf(rdma,
+					      doca_transport_read_callback,
+					      doca_transport_read_callback,
+					      transport->send_queue_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for RDMA read task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stop a DOCA transport by destroying its DOCA RDMA context
+ *
+ * @base [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_stop(struct rdma_transport *base)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (transport->num_sends != 0) {
+		DOCA_LOG_ERR("Stopping transport with %u operations in flight", transport->num_sends);
+		DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_IN_USE);
+	}
+
+	/* Posted receives are flushed to the receive callback while the context stops, their buffers are released */
+	if (transport->pe != NULL) {
+		tmp_result = rdma_bench_endpoint_destroy(transport->pe, &transport->endpoint);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	transport->cq_count = 0;
+	transport->num_sends = 0;
+	transport->num_recvs = 0;
+
+	return result;
+}
+
+/*
+ * Destroy a DOCA transport
+ *
+ * @base [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_destroy(struct rdma_transport *base)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	doca_error_t result, tmp_result;
+
+	result = doca_transport_stop(base);
+
+	if (transport->inventory != NULL) {
+		tmp_result = doca_buf_inventory_stop(transport->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to stop DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		tmp_result = doca_buf_inventory_destroy(transport->inventory);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy DOCA buffer inventory: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (transport->pe != NULL) {
+		tmp_result = doca_pe_destroy(transport->pe);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to destroy PE: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (transport->dev != NULL) {
+		tmp_result = doca_dev_close(transport->dev);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	free(transport->cq);
+	free(transport);
+
+	return result;
+}
+
+/*
+ * Create a DOCA transport and start its DOCA RDMA context
+ *
+ * @attr [in]: transport attributes
+ * @base [out]: the created transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_create(const struct rdma_transport_attr *attr, struct rdma_transport **base)
+{
+	struct rdma_bench_endpoint_attr endpoint_attr = {0};
+	union doca_data ctx_user_data = {0};
+	struct doca_transport *transport;
+	doca_error_t result;
+
+	if (attr->rdma_cfg == NULL) {
+		DOCA_LOG_ERR("The DOCA transport needs an RDMA configuration");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	transport = calloc(1, sizeof(*transport));
+	if (transport == NULL) {
+		DOCA_LOG_ERR("Failed to allocate DOCA transport");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	transport->send_queue_size = attr->send_queue_size;
+	transport->recv_queue_size = attr->recv_queue_size;
+	transport->cq_size = attr->send_queue_size + attr->recv_queue_size;
+
+	transport->cq = calloc(transport->cq_size, sizeof(*transport->cq));
+	if (transport->cq == NULL) {
+		DOCA_LOG_ERR("Failed to allocate completion queue");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_transport;
+	}
+
+	result = open_doca_device(attr->rdma_cfg->device_name, doca_rdma_cap_task_send_is_supported, &transport->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		goto destroy_transport;
+	}
+
+	result = doca_pe_create(&transport->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create PE: %s", doca_error_get_descr(result));
+		goto destroy_transport;
+	}
+
+	endpoint_attr.permissions = DOCA_TRANSPORT_MR_PERMISSIONS;
+	endpoint_attr.num_connections = 1;
+	endpoint_attr.send_queue_size = attr->send_queue_size;
+	endpoint_attr.recv_queue_size = attr->recv_queue_size;
+	endpoint_attr.transport_type = attr->rdma_cfg->transport_type;
+	endpoint_attr.is_gid_index_set = attr->rdma_cfg->is_gid_index_set;
+	endpoint_attr.gid_index = attr->rdma_cfg->gid_index;
+	result = rdma_bench_endpoint_create(transport->dev, transport->pe, &endpoint_attr, &transport->endpoint);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transport;
+
+	/* A send waits until the peer posts a receive, like on the shm backend */
+	result = doca_rdma_set_rnr_retry_count(transport->endpoint.rdma, DOCA_TRANSPORT_RNR_RETRY_INFINITE);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set RNR retry count: %s", doca_error_get_descr(result));
+		goto destroy_transport;
+	}
+
+	result = doca_transport_set_task_confs(transport);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transport;
+
+	ctx_user_data.ptr = transport;
+	result = doca_ctx_set_user_data(transport->endpoint.ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set context user data: %s", doca_error_get_descr(result));
+		goto destroy_transport;
+	}
+
+	result = rdma_bench_endpoint_start(transport->pe, &transport->endpoint);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transport;
+
+	/* Writes and reads hold two buffers, sends and receives one */
+	result = doca_buf_inventory_create(2 * attr->send_queue_size + attr->recv_queue_size, &transport->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_transport;
+	}
+
+	result = doca_buf_inventory_start(transport->inventory);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_transport;
+	}
+
+	*base = &transport->base;
+	return DOCA_SUCCESS;
+
+destroy_transport:
+	(void)doca_transport_destroy(&transport->base);
+	return result;
+}
+
+/*
+ * Connect two DOCA transports over a NIC loopback connection
+ *
+ * @first [in]: first transport
+ * @second [in]: second transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_connect(struct rdma_transport *first, struct rdma_transport *second)
+{
+	return rdma_bench_connect_loopback(&((struct doca_transport *)first)->endpoint,
+					   &((struct doca_transport *)second)->endpoint,
+					   1);
+}
+
+/*
+ * Register local memory as a DOCA mmap
+ *
+ * @base [in]: the transport
+ * @addr [in]: start address
+ * @len [in]: length in bytes
+ * @mr [out]: the registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_reg_mr(struct rdma_transport *base,
+					  void *addr,
+					  size_t len,
+					  struct rdma_transport_mr **mr)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	struct rdma_transport_mr *new_mr;
+	doca_error_t result;
+
+	new_mr = calloc(1, sizeof(*new_mr));
+	if (new_mr == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+
+	result = create_local_mmap(&new_mr->mmap, DOCA_TRANSPORT_MR_PERMISSIONS, addr, len, transport->dev);
+	if (result != DOCA_SUCCESS) {
+		free(new_mr);
+		return result;
+	}
+
+	*mr = new_mr;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stop and destroy a DOCA mmap
+ *
+ * @mmap [in]: the mmap
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_destroy_mmap(struct doca_mmap *mmap)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	tmp_result = doca_mmap_stop(mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to stop DOCA mmap: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	tmp_result = doca_mmap_destroy(mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy DOCA mmap: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	return result;
+}
+
+/*
+ * Deregister local memory
+ *
+ * @base [in]: the transport
+ * @mr [in]: the registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_dereg_mr(struct rdma_transport *base, struct rdma_transport_mr *mr)
+{
+	doca_error_t result;
+
+	(void)base;
+
+	result = doca_transport_destroy_mmap(mr->mmap);
+	free(mr);
+	return result;
+}
+
+/*
+ * Export a registration for RDMA
+ *
+ * @base [in]: the transport
+ * @mr [in]: the registration
+ * @desc [out]: export descriptor
+ * @desc_len [out]: descriptor length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_export_mr(struct rdma_transport *base,
+					     struct rdma_transport_mr *mr,
+					     const void **desc,
+					     size_t *desc_len)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	doca_error_t result;
+
+	result = doca_mmap_export_rdma(mr->mmap, transport->dev, desc, desc_len);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to export DOCA mmap for RDMA: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Import a registration of the peer
+ *
+ * @base [in]: the transport
+ * @desc [in]: export descriptor of the peer
+ * @desc_len [in]: descriptor length
+ * @rmr [out]: the remote registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_import_mr(struct rdma_transport *base,
+					     const void *desc,
+					     size_t desc_len,
+					     struct rdma_transport_rmr **rmr)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	struct rdma_transport_rmr *new_rmr;
+	doca_error_t result;
+
+	new_rmr = calloc(1, sizeof(*new_rmr));
+	if (new_rmr == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+
+	result = doca_mmap_create_from_export(NULL, desc, desc_len, transport->dev, &new_rmr->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		free(new_rmr);
+		return result;
+	}
+
+	*rmr = new_rmr;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Release an imported registration
+ *
+ * @base [in]: the transport
+ * @rmr [in]: the remote registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_release_rmr(struct rdma_transport *base, struct rdma_transport_rmr *rmr)
+{
+	doca_error_t result;
+
+	(void)base;
+
+	result = doca_transport_destroy_mmap(rmr->mmap);
+	free(rmr);
+	return result;
+}
+
+/*
+ * Get a DOCA buffer holding local data to transmit
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @buf [out]: the buffer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_get_src_buf(struct doca_transport *transport,
+					       const struct rdma_transport_sge *sge,
+					       struct doca_buf **buf)
+{
+	return doca_buf_inventory_buf_get_by_data(transport->inventory, sge->mr->mmap, sge->addr, sge->len, buf);
+}
+
+/*
+ * Post a send
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_post_send(struct rdma_transport *base,
+					     const struct rdma_transport_sge *sge,
+					     uint64_t user_data)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	union doca_data task_user_data = {.u64 = user_data};
+	struct doca_rdma_task_send *task;
+	struct doca_buf *src_buf;
+	doca_error_t result;
+
+	if (transport->endpoint.rdma == NULL)
+		return DOCA_ERROR_BAD_STATE;
+	if (transport->num_sends == transport->send_queue_size)
+		return DOCA_ERROR_AGAIN;
+
+	result = doca_transport_get_src_buf(transport, sge, &src_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_task_send_allocate_init(transport->endpoint.rdma,
+						   transport->endpoint.connections[0],
+						   src_buf,
+						   task_user_data,
+						   &task);
+	if (result != DOCA_SUCCESS)
+		goto dec_src_buf;
+
+	result = doca_task_submit(doca_rdma_task_send_as_task(task));
+	if (result != DOCA_SUCCESS)
+		goto free_task;
+
+	transport->num_sends++;
+	return DOCA_SUCCESS;
+
+free_task:
+	doca_task_free(doca_rdma_task_send_as_task(task));
+dec_src_buf:
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	return result;
+}
+
+/*
+ * Post a receive
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_post_recv(struct rdma_transport *base,
+					     const struct rdma_transport_sge *sge,
+					     uint64_t user_data)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	union doca_data task_user_data = {.u64 = user_data};
+	struct doca_rdma_task_receive *task;
+	struct doca_buf *dst_buf;
+	doca_error_t result;
+
+	if (transport->endpoint.rdma == NULL)
+		return DOCA_ERROR_BAD_STATE;
+	if (transport->num_recvs == transport->recv_queue_size)
+		return DOCA_ERROR_AGAIN;
+
+	result = doca_buf_inventory_buf_get_by_addr(transport->inventory, sge->mr->mmap, sge->addr, sge->len, &dst_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_rdma_task_receive_allocate_init(transport->endpoint.rdma, dst_buf, task_user_data, &task);
+	if (result != DOCA_SUCCESS)
+		goto dec_dst_buf;
+
+	result = doca_task_submit(doca_rdma_task_receive_as_task(task));
+	if (result != DOCA_SUCCESS)
+		goto free_task;
+
+	transport->num_recvs++;
+	return DOCA_SUCCESS;
+
+free_task:
+	doca_task_free(doca_rdma_task_receive_as_task(task));
+dec_dst_buf:
+	(void)doca_buf_dec_refcount(dst_buf, NULL);
+	return result;
+}
+
+/*
+ * Post an RDMA write
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration
+ * @remote_addr [in]: destination address
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_post_write(struct rdma_transport *base,
+					      const struct rdma_transport_sge *sge,
+					      struct rdma_transport_rmr *rmr,
+					      uint64_t remote_addr,
+					      uint64_t user_data)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	union doca_data task_user_data = {.u64 = user_data};
+	struct doca_rdma_task_write *task;
+	struct doca_buf *src_buf, *dst_buf;
+	doca_error_t result;
+
+	if (transport->endpoint.rdma == NULL)
+		return DOCA_ERROR_BAD_STATE;
+	if (transport->num_sends == transport->send_queue_size)
+		return DOCA_ERROR_AGAIN;
+
+	result = doca_transport_get_src_buf(transport, sge, &src_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_buf_get_by_addr(transport->inventory,
+						    rmr->mmap,
+						    (void *)(uintptr_t)remote_addr,
+						    sge->len,
+						    &dst_buf);
+	if (result != DOCA_SUCCESS)
+		goto dec_src_buf;
+
+	result = doca_rdma_task_write_allocate_init(transport->endpoint.rdma,
+						    transport->endpoint.connections[0],
+						    src_buf,
+						    dst_buf,
+						    task_user_data,
+						    &task);
+	if (result != DOCA_SUCCESS)
+		goto dec_dst_buf;
+
+	result = doca_task_submit(doca_rdma_task_write_as_task(task));
+	if (result != DOCA_SUCCESS)
+		goto free_task;
+
+	transport->num_sends++;
+	return DOCA_SUCCESS;
+
+free_task:
+	doca_task_free(doca_rdma_task_write_as_task(task));
+dec_dst_buf:
+	(void)doca_buf_dec_refcount(dst_buf, NULL);
+dec_src_buf:
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	return result;
+}
+
+/*
+ * Post an RDMA read
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration
+ * @remote_addr [in]: source address
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t doca_transport_post_read(struct rdma_transport *base,
+					     const struct rdma_transport_sge *sge,
+					     struct rdma_transport_rmr *rmr,
+					     uint64_t remote_addr,
+					     uint64_t user_data)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	union doca_data task_user_data = {.u64 = user_data};
+	struct doca_rdma_task_read *task;
+	struct doca_buf *src_buf, *dst_buf;
+	doca_error_t result;
+
+	if (transport->endpoint.rdma == NULL)
+		return DOCA_ERROR_BAD_STATE;
+	if (transport->num_sends == transport->send_queue_size)
+		return DOCA_ERROR_AGAIN;
+
+	result = doca_buf_inventory_buf_get_by_data(transport->inventory,
+						    rmr->mmap,
+						    (void *)(uintptr_t)remote_addr,
+						    sge->len,
+						    &src_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = doca_buf_inventory_buf_get_by_addr(transport->inventory, sge->mr->mmap, sge->addr, sge->len, &dst_buf);
+	if (result != DOCA_SUCCESS)
+		goto dec_src_buf;
+
+	result = doca_rdma_task_read_allocate_init(transport->endpoint.rdma,
+						   transport->endpoint.connections[0],
+						   src_buf,
+						   dst_buf,
+						   task_user_data,
+						   &task);
+	if (result != DOCA_SUCCESS)
+		goto dec_dst_buf;
+
+	result = doca_task_submit(doca_rdma_task_read_as_task(task));
+	if (result != DOCA_SUCCESS)
+		goto free_task;
+
+	transport->num_sends++;
+	return DOCA_SUCCESS;
+
+free_task:
+	doca_task_free(doca_rdma_task_read_as_task(task));
+dec_dst_buf:
+	(void)doca_buf_dec_refcount(dst_buf, NULL);
+dec_src_buf:
+	(void)doca_buf_dec_refcount(src_buf, NULL);
+	return result;
+}
+
+/*
+ * Progress the PE and return the completions its callbacks queued
+ *
+ * @base [in]: the transport
+ * @completions [out]: completed operations
+ * @max_completions [in]: size of completions
+ * @return: number of completions written
+ */
+static uint32_t doca_transport_poll(struct rdma_transport *base,
+				    struct rdma_transport_completion *completions,
+				    uint32_t max_completions)
+{
+	struct doca_transport *transport = (struct doca_transport *)base;
+	uint32_t num = 0;
+
+	while (transport->endpoint.rdma != NULL && transport->cq_count < max_completions &&
+	       doca_pe_progress(transport->pe) != 0)
+		;
+
+	while (num < max_completions && transport->cq_count > 0) {
+		completions[num] = transport->cq[transport->cq_head];
+		transport->cq_head = (transport->cq_head + 1) % transport->cq_size;
+		transport->cq_count--;
+		if (completions[num].opcode == RDMA_TRANSPORT_OP_RECV)
+			transport->num_recvs--;
+		else
+			transport->num_sends--;
+		num++;
+	}
+
+	return num;
+}
+
+const struct rdma_transport_ops rdma_transport_doca_ops = {
+	.name = "doca",
+	.create = doca_transport_create,
+	.connect = doca_transport_connect,
+	.reg_mr = doca_transport_reg_mr,
+	.dereg_mr = doca_transport_dereg_mr,
+	.export_mr = doca_transport_export_mr,
+	.import_mr = doca_transport_import_mr,
+	.release_rmr = doca_transport_release_rmr,
+	.post_send = doca_transport_post_send,
+	.post_recv = doca_transport_post_recv,
+	.post_write = doca_transport_post_write,
+	.post_read = doca_transport_post_read,
+	.poll = doca_transport_poll,
+	.stop = doca_transport_stop,
+	.destroy = doca_transport_destroy,
+};
@@ -0,0 +1,715 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <doca_log.h>
+
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA::TRANSPORT_SHM);
+
+/* A posted send or receive */
+struct shm_wqe {
+	void *addr;	    /* Local memory */
+	uint32_t len;	    /* Length of the local memory */
+	uint64_t user_data; /* User data of the post */
+};
+
+/* FIFO of work requests */
+struct shm_wqe_queue {
+	uint32_t head;		 /* Index of the oldest entry */
+	uint32_t count;		 /* Number of entries */
+	uint32_t capacity;	 /* Number of entries the queue can hold */
+	struct shm_wqe *entries; /* Entries, inside the shared area */
+};
+
+/* FIFO of completions */
+struct shm_cq {
+	uint32_t head;				   /* Index of the oldest entry */
+	uint32_t count;				   /* Number of entries */
+	uint32_t capacity;			   /* Number of entries the queue can hold */
+	struct rdma_transport_completion *entries; /* Entries, inside the shared area */
+};
+
+/* Queues of one side of a connected pair */
+struct shm_side {
+	bool alive;		      /* Cleared when the transport of this side is destroyed */
+	struct shm_wqe_queue recvs;   /* Posted receives */
+	struct shm_wqe_queue inbound; /* Sends of the peer waiting for a posted receive */
+	struct shm_cq cq;	      /* Completions not polled yet */
+};
+
+/* Shared area of a connected pair, the start of a memfd mapping holding all the queues */
+struct shm_pair {
+	pthread_mutex_t lock;	   /* Protects everything in the area */
+	size_t area_len;	   /* Length of the mapping */
+	uint32_t num_destroyed;	   /* Number of destroyed sides, the last one unmaps the area */
+	struct shm_side sides[2];  /* Both sides, indexed by shm_transport.side */
+};
+
+/* Shared-memory loopback transport */
+struct shm_transport {
+	struct rdma_transport base; /* Common part, must be the first member */
+	uint32_t send_queue_size;   /* Maximal number of sends, writes and reads in flight */
+	uint32_t recv_queue_size;   /* Maximal number of posted receives */
+	uint32_t num_sends;	    /* Sends, writes and reads posted and not polled yet */
+	uint32_t num_recvs;	    /* Receives posted and not polled yet */
+	struct shm_pair *pair;	    /* Shared area, NULL until connected */
+	uint32_t side;		    /* Index of this transport in the pair */
+	bool stopped;		    /* Set once the transport was stopped */
+};
+
+/* Registration of local memory, also its export descriptor */
+struct rdma_transport_mr {
+	void *addr; /* Start address */
+	size_t len; /* Length in bytes */
+};
+
+/* Imported registration of the peer */
+struct rdma_transport_rmr {
+	void *addr; /* Start address */
+	size_t len; /* Length in bytes */
+};
+
+/*
+ * Check that a range lies within a region
+ *
+ * @addr [in]: start of the range
+ * @len [in]: length of the range
+ * @region [in]: start of the region
+ * @region_len [in]: length of the region
+ * @return: true if the range is inside the region
+ */
+static bool shm_range_is_valid(const void *addr, size_t len, const void *region, size_t region_len)
+{
+	uintptr_t start = (uintptr_t)addr, region_start = (uintptr_t)region;
+
+	return start >= region_start && len <= region_len && start - region_start <= region_len - len;
+}
+
+/*
+ * Append a work request to a queue, the caller checked that it has room
+ *
+ * @queue [in]: the queue
+ * @wqe [in]: the work request
+ */
+static void shm_wqe_queue_push(struct shm_wqe_queue *queue, const struct shm_wqe *wqe)
+{
+	queue->entries[(queue->head + queue->count) % queue->capacity] = *wqe;
+	queue->count++;
+}
+
+/*
+ * Remove the oldest work request of a non empty queue
+ *
+ * @queue [in]: the queue
+ * @wqe [out]: the work request
+ */
+static void shm_wqe_queue_pop(struct shm_wqe_queue *queue, struct shm_wqe *wqe)
+{
+	*wqe = queue->entries[queue->head];
+	queue->head = (queue->head + 1) % queue->capacity;
+	queue->count--;
+}
+
+/*
+ * Append a completion, the queue holds every operation that can be in flight so it is never full
+ *
+ * @cq [in]: the completion queue
+ * @user_data [in]: user data of the post
+ * @opcode [in]: operation
+ * @status [in]: status
+ * @len [in]: length to report
+ */
+static void shm_cq_push(struct shm_cq *cq,
+			uint64_t user_data,
+			enum rdma_transport_opcode opcode,
+			doca_error_t status,
+			uint32_t len)
+{
+	struct rdma_transport_completion *completion = &cq->entries[(cq->head + cq->count) % cq->capacity];
+
+	completion->user_data = user_data;
+	completion->opcode = opcode;
+	completion->status = status;
+	completion->len = len;
+	cq->count++;
+}
+
+/*
+ * Deliver the inbound sends of a side to its posted receives, in order, with the pair lock held
+ *
+ * @pair [in]: the pair
+ * @side [in]: index of the receiving side
+ */
+static void shm_match(struct shm_pair *pair, uint32_t side)
+{
+	struct shm_side *receiver = &pair->sides[side], *sender = &pair->sides[1 - side];
+	struct shm_wqe recv, send;
+	doca_error_t status;
+
+	while (receiver->recvs.count > 0 && receiver->inbound.count > 0) {
+		shm_wqe_queue_pop(&receiver->recvs, &recv);
+		shm_wqe_queue_pop(&receiver->inbound, &send);
+
+		if (send.len > recv.len) {
+			status = DOCA_ERROR_INVALID_VALUE;
+		} else {
+			memcpy(recv.addr, send.addr, send.len);
+			status = DOCA_SUCCESS;
+		}
+
+		shm_cq_push(&receiver->cq,
+			    recv.user_data,
+			    RDMA_TRANSPORT_OP_RECV,
+			    status,
+			    status == DOCA_SUCCESS ? send.len : 0);
+		shm_cq_push(&sender->cq, send.user_data, RDMA_TRANSPORT_OP_SEND, status, send.len);
+	}
+}
+
+/*
+ * Create a shared-memory transport, its queues are allocated when it is connected
+ *
+ * @attr [in]: transport attributes
+ * @base [out]: the created transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_create(const struct rdma_transport_attr *attr, struct rdma_transport **base)
+{
+	struct shm_transport *transport;
+
+	transport = calloc(1, sizeof(*transport));
+	if (transport == NULL) {
+		DOCA_LOG_ERR("Failed to allocate shared-memory transport");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	transport->send_queue_size = attr->send_queue_size;
+	transport->recv_queue_size = attr->recv_queue_size;
+
+	*base = &transport->base;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Connect two shared-memory transports: map the shared area and carve the queues of both sides from it
+ *
+ * @first_base [in]: first transport
+ * @second_base [in]: second transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_connect(struct rdma_transport *first_base, struct rdma_transport *second_base)
+{
+	struct shm_transport *transports[2] = {(struct shm_transport *)first_base, (struct shm_transport *)second_base};
+	size_t area_len = sizeof(struct shm_pair);
+	struct shm_transport *transport, *peer;
+	struct shm_pair *pair;
+	struct shm_side *side;
+	char *cursor;
+	uint32_t i;
+	int fd;
+
+	if (transports[0]->pair != NULL || transports[1]->pair != NULL) {
+		DOCA_LOG_ERR("Shared-memory transport is already connected");
+		return DOCA_ERROR_BAD_STATE;
+	}
+
+	for (i = 0; i < 2; i++) {
+		transport = transports[i];
+		peer = transports[1 - i];
+		area_len += (size_t)(transport->recv_queue_size + peer->send_queue_size) * sizeof(struct shm_wqe);
+		area_len += (size_t)(transport->send_queue_size + transport->recv_queue_size) *
+			    sizeof(struct rdma_transport_completion);
+	}
+
+	/* A named memfd mapping, the queues of the pair show up in /proc/<pid>/maps */
+	fd = memfd_create("rdma_transport_shm", MFD_CLOEXEC);
+	if (fd < 0) {
+		DOCA_LOG_ERR("Failed to create memfd for the shared-memory transport");
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+	if (ftruncate(fd, area_len) != 0) {
+		DOCA_LOG_ERR("Failed to size memfd to %zu bytes", area_len);
+		close(fd);
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+	pair = mmap(NULL, area_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (pair == MAP_FAILED) {
+		DOCA_LOG_ERR("Failed to map the shared-memory transport area");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	/* The mapping is zero filled, only the lock and the queue capacities need to be set */
+	pthread_mutex_init(&pair->lock, NULL);
+	pair->area_len = area_len;
+	cursor = (char *)(pair + 1);
+	for (i = 0; i < 2; i++) {
+		transport = transports[i];
+		peer = transports[1 - i];
+		side = &pair->sides[i];
+
+		side->alive = true;
+		side->recvs.capacity = transport->recv_queue_size;
+		side->recvs.entries = (struct shm_wqe *)cursor;
+		cursor += (size_t)side->recvs.capacity * sizeof(struct shm_wqe);
+		side->inbound.capacity = peer->send_queue_size;
+		side->inbound.entries = (struct shm_wqe *)cursor;
+		cursor += (size_t)side->inbound.capacity * sizeof(struct shm_wqe);
+		side->cq.capacity = transport->send_queue_size + transport->recv_queue_size;
+		side->cq.entries = (struct rdma_transport_completion *)cursor;
+		cursor += (size_t)side->cq.capacity * sizeof(struct rdma_transport_completion);
+
+		transport->pair = pair;
+		transport->side = i;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register local memory, nothing to pin for a loopback
+ *
+ * @base [in]: the transport
+ * @addr [in]: start address
+ * @len [in]: length in bytes
+ * @mr [out]: the registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_reg_mr(struct rdma_transport *base,
+					 void *addr,
+					 size_t len,
+					 struct rdma_transport_mr **mr)
+{
+	struct rdma_transport_mr *new_mr;
+
+	(void)base;
+
+	new_mr = calloc(1, sizeof(*new_mr));
+	if (new_mr == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	new_mr->addr = addr;
+	new_mr->len = len;
+
+	*mr = new_mr;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Deregister local memory
+ *
+ * @base [in]: the transport
+ * @mr [in]: the registration
+ * @return: DOCA_SUCCESS
+ */
+static doca_error_t shm_transport_dereg_mr(struct rdma_transport *base, struct rdma_transport_mr *mr)
+{
+	(void)base;
+
+	free(mr);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Export a registration, the descriptor is the registration itself
+ *
+ * @base [in]: the transport
+ * @mr [in]: the registration
+ * @desc [out]: export descriptor
+ * @desc_len [out]: descriptor length
+ * @return: DOCA_SUCCESS
+ */
+static doca_error_t shm_transport_export_mr(struct rdma_transport *base,
+					    struct rdma_transport_mr *mr,
+					    const void **desc,
+					    size_t *desc_len)
+{
+	(void)base;
+
+	*desc = mr;
+	*desc_len = sizeof(*mr);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Import a registration of the peer
+ *
+ * @base [in]: the transport
+ * @desc [in]: export descriptor of the peer
+ * @desc_len [in]: descriptor length
+ * @rmr [out]: the remote registration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_import_mr(struct rdma_transport *base,
+					    const void *desc,
+					    size_t desc_len,
+					    struct rdma_transport_rmr **rmr)
+{
+	const struct rdma_transport_mr *exported = (const struct rdma_transport_mr *)desc;
+	struct rdma_transport_rmr *new_rmr;
+
+	(void)base;
+
+	if (desc_len != sizeof(*exported)) {
+		DOCA_LOG_ERR("Invalid shared-memory export descriptor of %zu bytes", desc_len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_rmr = calloc(1, sizeof(*new_rmr));
+	if (new_rmr == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	new_rmr->addr = exported->addr;
+	new_rmr->len = exported->len;
+
+	*rmr = new_rmr;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Release an imported registration
+ *
+ * @base [in]: the transport
+ * @rmr [in]: the remote registration
+ * @return: DOCA_SUCCESS
+ */
+static doca_error_t shm_transport_release_rmr(struct rdma_transport *base, struct rdma_transport_rmr *rmr)
+{
+	(void)base;
+
+	free(rmr);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Check the common preconditions of a post on the send queue
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @return: DOCA_SUCCESS if the post may proceed, DOCA_ERROR_AGAIN if the send queue is full and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_check_send(struct shm_transport *transport, const struct rdma_transport_sge *sge)
+{
+	if (transport->pair == NULL)
+		return DOCA_ERROR_NOT_CONNECTED;
+	if (transport->stopped)
+		return DOCA_ERROR_BAD_STATE;
+	if (transport->num_sends == transport->send_queue_size)
+		return DOCA_ERROR_AGAIN;
+	if (!shm_range_is_valid(sge->addr, sge->len, sge->mr->addr, sge->mr->len))
+		return DOCA_ERROR_INVALID_VALUE;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Post a send, it waits in the inbound queue of the peer until a receive is posted there
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_post_send(struct rdma_transport *base,
+					    const struct rdma_transport_sge *sge,
+					    uint64_t user_data)
+{
+	struct shm_transport *transport = (struct shm_transport *)base;
+	struct shm_wqe wqe = {.addr = sge->addr, .len = sge->len, .user_data = user_data};
+	struct shm_pair *pair = transport->pair;
+	uint32_t peer = 1 - transport->side;
+	doca_error_t result;
+
+	result = shm_transport_check_send(transport, sge);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	pthread_mutex_lock(&pair->lock);
+	if (!pair->sides[peer].alive) {
+		pthread_mutex_unlock(&pair->lock);
+		return DOCA_ERROR_NOT_CONNECTED;
+	}
+	/* Sends waiting in the inbound queue are a subset of the sends in flight, so it has room */
+	shm_wqe_queue_push(&pair->sides[peer].inbound, &wqe);
+	shm_match(pair, peer);
+	pthread_mutex_unlock(&pair->lock);
+
+	transport->num_sends++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Post a receive and deliver the sends already waiting for it
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_post_recv(struct rdma_transport *base,
+					    const struct rdma_transport_sge *sge,
+					    uint64_t user_data)
+{
+	struct shm_transport *transport = (struct shm_transport *)base;
+	struct shm_wqe wqe = {.addr = sge->addr, .len = sge->len, .user_data = user_data};
+	struct shm_pair *pair = transport->pair;
+
+	if (pair == NULL)
+		return DOCA_ERROR_NOT_CONNECTED;
+	if (transport->stopped)
+		return DOCA_ERROR_BAD_STATE;
+	if (transport->num_recvs == transport->recv_queue_size)
+		return DOCA_ERROR_AGAIN;
+	if (!shm_range_is_valid(sge->addr, sge->len, sge->mr->addr, sge->mr->len))
+		return DOCA_ERROR_INVALID_VALUE;
+
+	pthread_mutex_lock(&pair->lock);
+	shm_wqe_queue_push(&pair->sides[transport->side].recvs, &wqe);
+	shm_match(pair, transport->side);
+	pthread_mutex_unlock(&pair->lock);
+
+	transport->num_recvs++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Copy between local memory and an imported registration and queue the completion
+ *
+ * @transport [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration
+ * @remote_addr [in]: remote address
+ * @user_data [in]: returned with the completion
+ * @opcode [in]: RDMA_TRANSPORT_OP_WRITE or RDMA_TRANSPORT_OP_READ
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_copy(struct shm_transport *transport,
+				       const struct rdma_transport_sge *sge,
+				       struct rdma_transport_rmr *rmr,
+				       uint64_t remote_addr,
+				       uint64_t user_data,
+				       enum rdma_transport_opcode opcode)
+{
+	void *remote = (void *)(uintptr_t)remote_addr;
+	struct shm_pair *pair = transport->pair;
+	doca_error_t result;
+
+	result = shm_transport_check_send(transport, sge);
+	if (result != DOCA_SUCCESS)
+		return result;
+	if (!shm_range_is_valid(remote, sge->len, rmr->addr, rmr->len))
+		return DOCA_ERROR_INVALID_VALUE;
+
+	if (opcode == RDMA_TRANSPORT_OP_WRITE)
+		memcpy(remote, sge->addr, sge->len);
+	else
+		memcpy(sge->addr, remote, sge->len);
+
+	pthread_mutex_lock(&pair->lock);
+	shm_cq_push(&pair->sides[transport->side].cq, user_data, opcode, DOCA_SUCCESS, sge->len);
+	pthread_mutex_unlock(&pair->lock);
+
+	transport->num_sends++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Post an RDMA write
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration
+ * @remote_addr [in]: destination address
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_post_write(struct rdma_transport *base,
+					     const struct rdma_transport_sge *sge,
+					     struct rdma_transport_rmr *rmr,
+					     uint64_t remote_addr,
+					     uint64_t user_data)
+{
+	return shm_transport_copy((struct shm_transport *)base,
+				  sge,
+				  rmr,
+				  remote_addr,
+				  user_data,
+				  RDMA_TRANSPORT_OP_WRITE);
+}
+
+/*
+ * Post an RDMA read
+ *
+ * @base [in]: the transport
+ * @sge [in]: local memory
+ * @rmr [in]: remote registration
+ * @remote_addr [in]: source address
+ * @user_data [in]: returned with the completion
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_post_read(struct rdma_transport *base,
+					    const struct rdma_transport_sge *sge,
+					    struct rdma_transport_rmr *rmr,
+					    uint64_t remote_addr,
+					    uint64_t user_data)
+{
+	return shm_transport_copy((struct shm_transport *)base,
+				  sge,
+				  rmr,
+				  remote_addr,
+				  user_data,
+				  RDMA_TRANSPORT_OP_READ);
+}
+
+/*
+ * Return the queued completions
+ *
+ * @base [in]: the transport
+ * @completions [out]: completed operations
+ * @max_completions [in]: size of completions
+ * @return: number of completions written
+ */
+static uint32_t shm_transport_poll(struct rdma_transport *base,
+				   struct rdma_transport_completion *completions,
+				   uint32_t max_completions)
+{
+	struct shm_transport *transport = (struct shm_transport *)base;
+	struct shm_cq *cq;
+	uint32_t num = 0, i;
+
+	if (transport->pair == NULL || transport->stopped)
+		return 0;
+
+	cq = &transport->pair->sides[transport->side].cq;
+	pthread_mutex_lock(&transport->pair->lock);
+	while (num < max_completions && cq->count > 0) {
+		completions[num++] = cq->entries[cq->head];
+		cq->head = (cq->head + 1) % cq->capacity;
+		cq->count--;
+	}
+	pthread_mutex_unlock(&transport->pair->lock);
+
+	for (i = 0; i < num; i++) {
+		if (completions[i].opcode == RDMA_TRANSPORT_OP_RECV)
+			transport->num_recvs--;
+		else
+			transport->num_sends--;
+	}
+
+	return num;
+}
+
+/*
+ * Stop a shared-memory transport: drop its posted receives and fail the sends of the peer waiting for them
+ *
+ * @base [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_stop(struct rdma_transport *base)
+{
+	struct shm_transport *transport = (struct shm_transport *)base;
+	struct shm_pair *pair = transport->pair;
+	doca_error_t result = DOCA_SUCCESS;
+	struct shm_side *side, *peer;
+	struct shm_wqe wqe;
+
+	if (transport->num_sends != 0) {
+		DOCA_LOG_ERR("Stopping transport with %u operations in flight", transport->num_sends);
+		result = DOCA_ERROR_IN_USE;
+	}
+
+	if (pair == NULL || transport->stopped)
+		return result;
+
+	side = &pair->sides[transport->side];
+	peer = &pair->sides[1 - transport->side];
+
+	pthread_mutex_lock(&pair->lock);
+	side->alive = false;
+	side->recvs.count = 0;
+	side->cq.count = 0;
+	while (side->inbound.count > 0) {
+		shm_wqe_queue_pop(&side->inbound, &wqe);
+		shm_cq_push(&peer->cq, wqe.user_data, RDMA_TRANSPORT_OP_SEND, DOCA_ERROR_NOT_CONNECTED, wqe.len);
+	}
+	pthread_mutex_unlock(&pair->lock);
+
+	transport->stopped = true;
+	transport->num_recvs = 0;
+	return result;
+}
+
+/*
+ * Destroy a shared-memory transport, the shared area is unmapped once both sides are gone
+ *
+ * @base [in]: the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t shm_transport_destroy(struct rdma_transport *base)
+{
+	struct shm_transport *transport = (struct shm_transport *)base;
+	struct shm_pair *pair = transport->pair;
+	doca_error_t result;
+	bool unmap;
+
+	result = shm_transport_stop(base);
+
+	if (pair != NULL) {
+		pthread_mutex_lock(&pair->lock);
+		unmap = ++pair->num_destroyed == 2;
+		pthread_mutex_unlock(&pair->lock);
+
+		if (unmap) {
+			pthread_mutex_destroy(&pair->lock);
+			munmap(pair, pair->area_len);
+		}
+	}
+
+	free(transport);
+	return result;
+}
+
+const struct rdma_transport_ops rdma_transport_shm_ops = {
+	.name = "shm",
+	.create = shm_transport_create,
+	.connect = shm_transport_connect,
+	.reg_mr = shm_transport_reg_mr,
+	.dereg_mr = shm_transport_dereg_mr,
+	.export_mr = shm_transport_export_mr,
+	.import_mr = shm_transport_import_mr,
+	.release_rmr = shm_transport_release_rmr,
+	.post_send = shm_transport_post_send,
+	.post_recv = shm_transport_post_recv,
+	.post_write = shm_transport_post_write,
+	.post_read = shm_transport_post_read,
+	.poll = shm_transport_poll,
+	.stop = shm_transport_stop,
+	.destroy = shm_transport_destroy,
+};
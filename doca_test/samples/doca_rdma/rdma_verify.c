@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string.h>
+
+#include <doca_log.h>
+
+#include "bench_common.h"
+#include "rdma_verify.h"
+
+DOCA_LOG_REGISTER(RDMA::VERIFY);
+
+void rdma_verify_stage_init(struct rdma_verify_stage *stage, enum checksum_algo algo)
+{
+	memset(stage, 0, sizeof(*stage));
+	stage->algo = algo;
+	stage->stats.first_mismatch = UINT64_MAX;
+}
+
+uint64_t rdma_verify_digest(struct rdma_verify_stage *stage, const void *data, size_t len)
+{
+	uint64_t start_ns = bench_get_time_ns();
+	uint64_t digest;
+
+	digest = checksum_compute(stage->algo, data, len);
+	stage->stats.hash_ns += bench_get_time_ns() - start_ns;
+	stage->stats.num_chunks++;
+	stage->stats.num_bytes += len;
+
+	return digest;
+}
+
+bool rdma_verify_chunk(struct rdma_verify_stage *stage,
+		       uint64_t chunk,
+		       const void *data,
+		       size_t len,
+		       uint64_t expected)
+{
+	uint64_t digest = rdma_verify_digest(stage, data, len);
+
+	if (digest == expected)
+		return true;
+
+	if (stage->stats.num_mismatches++ == 0) {
+		stage->stats.first_mismatch = chunk;
+		DOCA_LOG_ERR("Chunk %lu of %zu bytes failed verification: %s 0x%lx, expected 0x%lx",
+			     chunk,
+			     len,
+			     checksum_algo_name(stage->algo),
+			     digest,
+			     expected);
+	}
+	return false;
+}
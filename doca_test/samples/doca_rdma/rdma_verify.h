@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef RDMA_VERIFY_H_
+#define RDMA_VERIFY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "checksum.h"
+
+/*
+ * Streaming verification stage for chunked RDMA transfers.
+ *
+ * The side that owns the data hashes every chunk and sends the digest out-of-band, e.g. as a small send posted on
+ * the same queue right after the RDMA write of the chunk, or as a digest table exchanged before a read transfer.
+ * The receiving side checks every chunk as soon as both the data and its digest are there, while later chunks are
+ * still in flight, so that the hashing overlaps the transfer instead of running after it. A stage accumulates the
+ * time spent hashing, which is the CPU cost of the verification.
+ */
+
+/* Digest of one chunk */
+struct rdma_verify_digest_msg {
+	uint64_t chunk;	 /* Sequence number of the chunk */
+	uint64_t digest; /* Checksum of the chunk */
+};
+
+/* Statistics of a stage */
+struct rdma_verify_stats {
+	uint64_t num_chunks;	 /* Number of chunks hashed */
+	uint64_t num_bytes;	 /* Number of bytes hashed */
+	uint64_t num_mismatches; /* Number of chunks that did not match their digest */
+	uint64_t first_mismatch; /* Sequence number of the first mismatching chunk, UINT64_MAX if none */
+	uint64_t hash_ns;	 /* Time spent hashing */
+};
+
+/* One side of a verified transfer */
+struct rdma_verify_stage {
+	enum checksum_algo algo;	/* Checksum algorithm */
+	struct rdma_verify_stats stats;	/* Statistics since the stage was initialized */
+};
+
+/*
+ * Initialize a stage, resetting its statistics
+ *
+ * @stage [out]: the stage
+ * @algo [in]: checksum algorithm, must be the same on both sides of the transfer
+ */
+void rdma_verify_stage_init(struct rdma_verify_stage *stage, enum checksum_algo algo);
+
+/*
+ * Compute the digest of a chunk on the sending side
+ *
+ * @stage [in]: the stage
+ * @data [in]: chunk data
+ * @len [in]: chunk length
+ * @return: the digest to send to the receiving side
+ */
+uint64_t rdma_verify_digest(struct rdma_verify_stage *stage, const void *data, size_t len);
+
+/*
+ * Check a received chunk against the digest computed by the sending side
+ * The first mismatch is logged, every mismatch is counted
+ *
+ * @stage [in]: the stage
+ * @chunk [in]: sequence number of the chunk
+ * @data [in]: received chunk data
+ * @len [in]: chunk length
+ * @expected [in]: digest from the sending side
+ * @return: true if the chunk matches its digest
+ */
+bool rdma_verify_chunk(struct rdma_verify_stage *stage,
+		       uint64_t chunk,
+		       const void *data,
+		       size_t len,
+		       uint64_t expected);
+
+#endif /* RDMA_VERIFY_H_ */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_log.h>
+#include <doca_argp.h>
+
+#include "rdma_bench_common.h"
+#include "rdma_transport.h"
+
+DOCA_LOG_REGISTER(RDMA_VERIFY_BENCH::MAIN);
+
+/* Sample's Logic */
+doca_error_t rdma_verify_bench(struct rdma_bench_config *cfg,
+			       enum rdma_transport_type type,
+			       bool write_mode,
+			       bool read_mode);
+
+#define DEFAULT_CHUNK_SIZE (64 * 1024) /* Default size of every verified chunk */
+#define DEFAULT_QUEUE_DEPTH (16)	/* Default number of chunks in flight */
+
+/* Sample configuration, the benchmark configuration must be the first member for the common ARGP callbacks */
+struct verify_bench_config {
+	struct rdma_bench_config bench;	    /* Benchmark configuration */
+	enum rdma_transport_type transport; /* Transport backend */
+	bool write_mode;		    /* Run the RDMA write transfer */
+	bool read_mode;			    /* Run the RDMA read transfer */
+};
+
+/*
+ * ARGP Callback - Handle transport parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t transport_callback(void *param, void *config)
+{
+	struct verify_bench_config *cfg = (struct verify_bench_config *)config;
+
+	return rdma_transport_parse_type((const char *)param, &cfg->transport);
+}
+
+/*
+ * ARGP Callback - Handle direction parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t direction_callback(void *param, void *config)
+{
+	struct verify_bench_config *cfg = (struct verify_bench_config *)config;
+	const char *direction = (const char *)param;
+
+	if (strcmp(direction, "write") == 0) {
+		cfg->write_mode = true;
+		cfg->read_mode = false;
+	} else if (strcmp(direction, "read") == 0) {
+		cfg->write_mode = false;
+		cfg->read_mode = true;
+	} else if (strcmp(direction, "both") == 0) {
+		cfg->write_mode = true;
+		cfg->read_mode = true;
+	} else {
+		DOCA_LOG_ERR("Unknown direction \"%s\", expected write, read or both", direction);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the transport and direction parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_verify_params(void)
+{
+	struct doca_argp_param *transport_param, *direction_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&transport_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(transport_param, "tr");
+	doca_argp_param_set_long_name(transport_param, "transport");
+	doca_argp_param_set_arguments(transport_param, "<doca|shm>");
+	doca_argp_param_set_description(
+		transport_param,
+		"Transport backend, \"shm\" runs without a device and ignores the device parameter (optional)");
+	doca_argp_param_set_callback(transport_param, transport_callback);
+	doca_argp_param_set_type(transport_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(transport_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&direction_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(direction_param, "dir");
+	doca_argp_param_set_long_name(direction_param, "direction");
+	doca_argp_param_set_arguments(direction_param, "<write|read|both>");
+	doca_argp_param_set_description(direction_param, "Verified transfers to run, both by default (optional)");
+	doca_argp_param_set_callback(direction_param, direction_callback);
+	doca_argp_param_set_type(direction_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(direction_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct verify_bench_config cfg;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	result = set_default_rdma_bench_config(&cfg.bench);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	cfg.bench.msg_size = DEFAULT_CHUNK_SIZE;
+	cfg.bench.queue_depth = DEFAULT_QUEUE_DEPTH;
+	cfg.transport = RDMA_TRANSPORT_DOCA;
+	cfg.write_mode = true;
+	cfg.read_mode = true;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	DOCA_LOG_INFO("Starting the sample");
+
+	/* Initialize argparser */
+	result = doca_argp_init("doca_rdma_verify_bench", &cfg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+
+	/* Register RDMA common params */
+	result = register_rdma_common_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register benchmark params */
+	result = register_rdma_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register benchmark parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Register verification params */
+	result = register_verify_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register verification parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start argparser */
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	/* Start sample */
+	result = rdma_verify_bench(&cfg.bench, cfg.transport, cfg.write_mode, cfg.read_mode);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("rdma_verify_bench() failed: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,783 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "bench_common.h"
+#include "checksum.h"
+#include "rdma_bench_common.h"
+#include "rdma_transport.h"
+#include "rdma_verify.h"
+
+DOCA_LOG_REGISTER(RDMA_VERIFY_BENCH::SAMPLE);
+
+#define POLL_BATCH (32)			       /* Completions polled at once */
+#define DRAIN_TIMEOUT_NS (BENCH_NSEC_PER_SEC)  /* Time to wait for the chunks in flight at the end of a run */
+#define TIME_CHECK_INTERVAL (1024)	       /* Number of polls between two deadline checks */
+#define SLOTS_PER_DEPTH (4)		       /* Chunk slots per outstanding chunk, so the sink can lag behind */
+#define HASH_RATE_NS (BENCH_NSEC_PER_SEC / 10) /* Length of the standalone hash rate measurement */
+#define NO_CORRUPTION (UINT64_MAX)	       /* Corrupt chunk of the runs that corrupt nothing */
+#define MIN_CHUNK_SIZE (64)		       /* Smallest chunk, large enough for the sequence stamp */
+
+/* Transfer direction of a run */
+enum verify_mode {
+	VERIFY_MODE_WRITE, /* The source writes the chunks into the sink and sends their digests */
+	VERIFY_MODE_READ,  /* The sink reads the chunks from the source, digests are exchanged before the run */
+};
+
+/* Benchmark state, the source owns the data and the sink receives and verifies it */
+struct verify_bench {
+	struct rdma_bench_config *cfg;			    /* Benchmark configuration */
+	uint32_t num_slots;				    /* Chunk slots of the source and sink regions */
+	uint32_t num_recvs;				    /* Digest receives kept posted on the sink */
+	size_t region_len;				    /* Length of the source and sink regions */
+	struct rdma_transport *source;			    /* Transport of the data owner */
+	struct rdma_transport *sink;			    /* Transport of the verifying side */
+	char *src;					    /* Source chunk slots */
+	char *dst;					    /* Sink chunk slots */
+	struct rdma_verify_digest_msg *msgs;		    /* Source digest messages, one per slot */
+	struct rdma_verify_digest_msg *recv_msgs;	    /* Sink digest receive buffers */
+	uint64_t *table;				    /* Digest of every source slot, as received by the sink */
+	struct rdma_transport_mr *src_mr;		    /* Registration of src */
+	struct rdma_transport_mr *dst_mr;		    /* Registration of dst */
+	struct rdma_transport_mr *msgs_mr;		    /* Registration of msgs */
+	struct rdma_transport_mr *recv_msgs_mr;		    /* Registration of recv_msgs */
+	struct rdma_transport_rmr *dst_rmr;		    /* Import of dst by the source, target of writes */
+	struct rdma_transport_rmr *src_rmr;		    /* Import of src by the sink, source of reads */
+	struct rdma_transport_completion comps[POLL_BATCH]; /* Polled completions */
+};
+
+/* One timed run */
+struct verify_run {
+	bool verify;			       /* Hash and check every chunk, false for the baseline */
+	enum checksum_algo algo;	       /* Checksum algorithm of a verified run */
+	uint64_t duration_ns;		       /* Length of the run */
+	uint64_t max_chunks;		       /* Stop after this many chunks, UINT64_MAX for the duration only */
+	uint64_t corrupt_chunk;		       /* Chunk to corrupt after it was hashed, or NO_CORRUPTION */
+	uint64_t num_chunks;		       /* Number of chunks transferred, and verified in a verified run */
+	uint64_t elapsed_ns;		       /* Length of the timed region */
+	struct rdma_verify_stage source_stage; /* Hashing on the source */
+	struct rdma_verify_stage sink_stage;   /* Hashing on the sink */
+};
+
+/*
+ * Get the local memory of a slot
+ *
+ * @mr [in]: registration of the region
+ * @region [in]: region start
+ * @slot_size [in]: slot size
+ * @slot [in]: slot index
+ * @return: the slot memory
+ */
+static struct rdma_transport_sge slot_sge(struct rdma_transport_mr *mr, void *region, uint32_t slot_size, uint64_t slot)
+{
+	struct rdma_transport_sge sge = {.mr = mr, .addr = (char *)region + slot * slot_size, .len = slot_size};
+
+	return sge;
+}
+
+/*
+ * Post the write of a chunk and, in a verified run, the send of its digest right behind it on the same queue
+ * The receive completion of the digest then implies that the chunk data was placed
+ *
+ * @bench [in]: benchmark state
+ * @run [in/out]: the run
+ * @chunk [in]: chunk sequence number
+ * @num_inflight [in/out]: number of source operations in flight
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t post_chunk_write(struct verify_bench *bench,
+				     struct verify_run *run,
+				     uint64_t chunk,
+				     uint32_t *num_inflight)
+{
+	const uint32_t chunk_size = bench->cfg->msg_size;
+	const uint64_t slot = chunk % bench->num_slots;
+	char *data = bench->src + slot * chunk_size;
+	struct rdma_verify_digest_msg *msg = &bench->msgs[slot];
+	struct rdma_transport_sge sge;
+	doca_error_t result;
+
+	/* Every chunk carries different data */
+	memcpy(data, &chunk, sizeof(chunk));
+	if (run->verify) {
+		msg->chunk = chunk;
+		msg->digest = rdma_verify_digest(&run->source_stage, data, chunk_size);
+		if (chunk == run->corrupt_chunk)
+			data[chunk_size / 2] ^= 0xFF;
+	}
+
+	sge = slot_sge(bench->src_mr, bench->src, chunk_size, slot);
+	result = rdma_transport_post_write(bench->source,
+					   &sge,
+					   bench->dst_rmr,
+					   (uintptr_t)(bench->dst + slot * chunk_size),
+					   chunk);
+	if (result != DOCA_SUCCESS)
+		return result;
+	(*num_inflight)++;
+	if (!run->verify)
+		return DOCA_SUCCESS;
+
+	sge = slot_sge(bench->msgs_mr, bench->msgs, sizeof(*msg), slot);
+	result = rdma_transport_post_send(bench->source, &sge, chunk);
+	if (result != DOCA_SUCCESS)
+		return result;
+	(*num_inflight)++;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Write chunks from the source to the sink, the sink verifies every chunk when its digest arrives while the
+ * following chunks are still in flight. The source never runs more than num_slots chunks ahead of the sink, so a
+ * slot is not rewritten before it was verified.
+ *
+ * @bench [in]: benchmark state
+ * @run [in/out]: the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_write_mode(struct verify_bench *bench, struct verify_run *run)
+{
+	const uint32_t depth = bench->cfg->queue_depth, chunk_size = bench->cfg->msg_size;
+	const uint32_t ops_per_chunk = run->verify ? 2 : 1, max_inflight = depth * ops_per_chunk;
+	uint64_t next_chunk = 0, expected_chunk = 0, num_polls = 0, start_ns, deadline_ns, slot;
+	uint32_t num_inflight = 0, num, i;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	struct rdma_verify_digest_msg *msg;
+	struct rdma_transport_sge sge;
+	bool running = true;
+
+	run->num_chunks = 0;
+	rdma_verify_stage_init(&run->source_stage, run->algo);
+	rdma_verify_stage_init(&run->sink_stage, run->algo);
+
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + run->duration_ns;
+	while (running || num_inflight > 0 || (run->verify && expected_chunk < next_chunk)) {
+		while (running && num_inflight + ops_per_chunk <= max_inflight &&
+		       next_chunk < run->num_chunks + bench->num_slots) {
+			if (next_chunk == run->max_chunks) {
+				running = false;
+				break;
+			}
+			tmp_result = post_chunk_write(bench, run, next_chunk, &num_inflight);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to post chunk: %s", doca_error_get_descr(tmp_result));
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+				running = false;
+				break;
+			}
+			next_chunk++;
+		}
+
+		num = run->verify ? rdma_transport_poll(bench->sink, bench->comps, POLL_BATCH) : 0;
+		for (i = 0; i < num; i++) {
+			if (bench->comps[i].status != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+				running = false;
+				continue;
+			}
+			slot = bench->comps[i].user_data;
+			msg = &bench->recv_msgs[slot];
+			if (bench->comps[i].len != sizeof(*msg) || msg->chunk != expected_chunk) {
+				DOCA_LOG_ERR("Received digest of chunk %lu, expected %lu", msg->chunk, expected_chunk);
+				DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_UNEXPECTED);
+				running = false;
+				expected_chunk = next_chunk;
+				continue;
+			}
+			(void)rdma_verify_chunk(&run->sink_stage,
+						msg->chunk,
+						bench->dst + (msg->chunk % bench->num_slots) * chunk_size,
+						chunk_size,
+						msg->digest);
+			expected_chunk++;
+			run->num_chunks++;
+			sge = slot_sge(bench->recv_msgs_mr, bench->recv_msgs, sizeof(*msg), slot);
+			tmp_result = rdma_transport_post_recv(bench->sink, &sge, slot);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+				running = false;
+			}
+		}
+
+		num = rdma_transport_poll(bench->source, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			num_inflight--;
+			if (bench->comps[i].status != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+				running = false;
+				/* A failed operation means its digest may never arrive */
+				expected_chunk = next_chunk;
+				continue;
+			}
+			if (!run->verify)
+				run->num_chunks++;
+		}
+
+		if ((++num_polls % TIME_CHECK_INTERVAL) == 0 && bench_get_time_ns() >= deadline_ns) {
+			if (!running) {
+				DOCA_LOG_ERR("Timed out with %u operations in flight", num_inflight);
+				DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_TIME_OUT);
+				break;
+			}
+			running = false;
+			deadline_ns = bench_get_time_ns() + DRAIN_TIMEOUT_NS;
+		}
+	}
+
+	run->elapsed_ns = bench_get_time_ns() - start_ns;
+	return result;
+}
+
+/*
+ * Post the digest receives of the sink, they stay posted for all runs: every completed receive is reposted
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t post_digest_recvs(struct verify_bench *bench)
+{
+	struct rdma_transport_sge sge;
+	doca_error_t result;
+	uint64_t slot;
+
+	for (slot = 0; slot < bench->num_recvs; slot++) {
+		sge = slot_sge(bench->recv_msgs_mr, bench->recv_msgs, sizeof(*bench->recv_msgs), slot);
+		result = rdma_transport_post_recv(bench->sink, &sge, slot);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to post digest receive: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stamp every source slot with its index and send the digest of every slot to the sink, which stores them in its
+ * digest table. This happens before a read run is timed, the digests travel out-of-band of the reads.
+ *
+ * @bench [in]: benchmark state
+ * @algo [in]: checksum algorithm
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t exchange_digest_table(struct verify_bench *bench, enum checksum_algo algo)
+{
+	const uint32_t chunk_size = bench->cfg->msg_size, max_inflight = 2 * bench->cfg->queue_depth;
+	uint64_t deadline_ns = bench_get_time_ns() + DRAIN_TIMEOUT_NS;
+	uint64_t num_sent = 0, num_received = 0, slot;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	struct rdma_verify_digest_msg *msg;
+	struct rdma_transport_sge sge;
+	struct rdma_verify_stage stage;
+	uint32_t num_inflight = 0, num, i;
+
+	rdma_verify_stage_init(&stage, algo);
+	for (slot = 0; slot < bench->num_slots; slot++) {
+		memcpy(bench->src + slot * chunk_size, &slot, sizeof(slot));
+		bench->msgs[slot].chunk = slot;
+		bench->msgs[slot].digest = rdma_verify_digest(&stage, bench->src + slot * chunk_size, chunk_size);
+	}
+
+	while (num_received < bench->num_slots || num_inflight > 0) {
+		if (bench_get_time_ns() >= deadline_ns) {
+			DOCA_LOG_ERR("Timed out exchanging the digest table");
+			return DOCA_ERROR_TIME_OUT;
+		}
+		while (result == DOCA_SUCCESS && num_sent < bench->num_slots && num_inflight < max_inflight) {
+			sge = slot_sge(bench->msgs_mr, bench->msgs, sizeof(*bench->msgs), num_sent);
+			result = rdma_transport_post_send(bench->source, &sge, num_sent);
+			if (result != DOCA_SUCCESS)
+				return result;
+			num_inflight++;
+			num_sent++;
+		}
+
+		num = rdma_transport_poll(bench->sink, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+			slot = bench->comps[i].user_data;
+			msg = &bench->recv_msgs[slot];
+			if (bench->comps[i].status == DOCA_SUCCESS && msg->chunk < bench->num_slots)
+				bench->table[msg->chunk] = msg->digest;
+			num_received++;
+			sge = slot_sge(bench->recv_msgs_mr, bench->recv_msgs, sizeof(*msg), slot);
+			tmp_result = rdma_transport_post_recv(bench->sink, &sge, slot);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+
+		num = rdma_transport_poll(bench->source, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+			num_inflight--;
+		}
+		if (result != DOCA_SUCCESS && num_inflight == 0)
+			return result;
+	}
+
+	return result;
+}
+
+/*
+ * Read chunks from the source into depth sink slots, the sink verifies every chunk on its read completion against
+ * the digest table, then reuses the slot for the next read while the other reads are in flight
+ *
+ * @bench [in]: benchmark state
+ * @run [in/out]: the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_read_mode(struct verify_bench *bench, struct verify_run *run)
+{
+	const uint32_t depth = bench->cfg->queue_depth, chunk_size = bench->cfg->msg_size;
+	uint64_t next_chunk = 0, num_polls = 0, start_ns, deadline_ns, chunk, slot, remote_slot;
+	uint32_t num_inflight = 0, num, i;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	struct rdma_transport_sge sge;
+	bool running = true;
+	char *data;
+
+	run->num_chunks = 0;
+	rdma_verify_stage_init(&run->source_stage, run->algo);
+	rdma_verify_stage_init(&run->sink_stage, run->algo);
+
+	start_ns = bench_get_time_ns();
+	deadline_ns = start_ns + run->duration_ns;
+	/* The user data of a read carries its chunk and sink slot: chunk * depth + slot */
+	for (slot = 0; slot < depth && next_chunk < run->max_chunks; slot++) {
+		sge = slot_sge(bench->dst_mr, bench->dst, chunk_size, slot);
+		remote_slot = next_chunk % bench->num_slots;
+		result = rdma_transport_post_read(bench->sink,
+						  &sge,
+						  bench->src_rmr,
+						  (uintptr_t)(bench->src + remote_slot * chunk_size),
+						  next_chunk * depth + slot);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to post read: %s", doca_error_get_descr(result));
+			running = false;
+			break;
+		}
+		num_inflight++;
+		next_chunk++;
+	}
+
+	while (running || num_inflight > 0) {
+		num = rdma_transport_poll(bench->sink, bench->comps, POLL_BATCH);
+		for (i = 0; i < num; i++) {
+			num_inflight--;
+			if (bench->comps[i].status != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, bench->comps[i].status);
+				running = false;
+				continue;
+			}
+			chunk = bench->comps[i].user_data / depth;
+			slot = bench->comps[i].user_data % depth;
+			data = bench->dst + slot * chunk_size;
+			if (run->verify) {
+				/* Corruption of the landed data, after the source computed the digest */
+				if (chunk == run->corrupt_chunk)
+					data[chunk_size / 2] ^= 0xFF;
+				(void)rdma_verify_chunk(&run->sink_stage,
+							chunk,
+							data,
+							chunk_size,
+							bench->table[chunk % bench->num_slots]);
+			}
+			run->num_chunks++;
+
+			if (!running || next_chunk == run->max_chunks) {
+				running = false;
+				continue;
+			}
+			sge = slot_sge(bench->dst_mr, bench->dst, chunk_size, slot);
+			remote_slot = next_chunk % bench->num_slots;
+			tmp_result = rdma_transport_post_read(bench->sink,
+							      &sge,
+							      bench->src_rmr,
+							      (uintptr_t)(bench->src + remote_slot * chunk_size),
+							      next_chunk * depth + slot);
+			if (tmp_result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, tmp_result);
+				running = false;
+				continue;
+			}
+			num_inflight++;
+			next_chunk++;
+		}
+
+		if ((++num_polls % TIME_CHECK_INTERVAL) == 0 && bench_get_time_ns() >= deadline_ns) {
+			if (!running) {
+				DOCA_LOG_ERR("Timed out with %u reads in flight", num_inflight);
+				DOCA_ERROR_PROPAGATE(result, DOCA_ERROR_TIME_OUT);
+				break;
+			}
+			running = false;
+			deadline_ns = bench_get_time_ns() + DRAIN_TIMEOUT_NS;
+		}
+	}
+
+	run->elapsed_ns = bench_get_time_ns() - start_ns;
+	return result;
+}
+
+/*
+ * Run one transfer in a mode
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: transfer direction
+ * @run [in/out]: the run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t run_mode(struct verify_bench *bench, enum verify_mode mode, struct verify_run *run)
+{
+	doca_error_t result;
+
+	if (mode == VERIFY_MODE_WRITE)
+		return run_write_mode(bench, run);
+
+	if (run->verify) {
+		result = exchange_digest_table(bench, run->algo);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	return run_read_mode(bench, run);
+}
+
+/*
+ * Get the throughput of a run
+ *
+ * @bench [in]: benchmark state
+ * @run [in]: the run
+ * @return: throughput in GB/s
+ */
+static double run_gbps(const struct verify_bench *bench, const struct verify_run *run)
+{
+	if (run->elapsed_ns == 0)
+		return 0.0;
+	return (double)run->num_chunks * bench->cfg->msg_size / (double)run->elapsed_ns;
+}
+
+/*
+ * Corrupt one chunk of a short verified run and check that exactly this chunk is reported
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: transfer direction
+ * @algo [in]: checksum algorithm
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t check_corruption(struct verify_bench *bench, enum verify_mode mode, enum checksum_algo algo)
+{
+	struct verify_run run = {
+		.verify = true,
+		.algo = algo,
+		.duration_ns = DRAIN_TIMEOUT_NS,
+		.max_chunks = 2 * (uint64_t)bench->num_slots,
+		/* Past the first round of slots, so that slot reuse is covered too */
+		.corrupt_chunk = bench->num_slots + 1,
+	};
+	const uint32_t chunk_size = bench->cfg->msg_size;
+	doca_error_t result;
+
+	result = run_mode(bench, mode, &run);
+	/* Restore the source slot, the corrupted chunk is the last user of its slot in this run */
+	if (mode == VERIFY_MODE_WRITE)
+		bench->src[(run.corrupt_chunk % bench->num_slots) * chunk_size + chunk_size / 2] ^= 0xFF;
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	if (run.num_chunks != run.max_chunks || run.sink_stage.stats.num_mismatches != 1 ||
+	    run.sink_stage.stats.first_mismatch != run.corrupt_chunk) {
+		DOCA_LOG_ERR("Corruption of chunk %lu not detected: %lu of %lu chunks verified, %lu mismatches",
+			     run.corrupt_chunk,
+			     run.num_chunks,
+			     run.max_chunks,
+			     run.sink_stage.stats.num_mismatches);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	DOCA_LOG_INFO("  %-7s corrupted chunk %lu detected", checksum_algo_name(algo), run.corrupt_chunk);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the baseline and a verified run of every algorithm in a mode, and report the verification overhead
+ *
+ * @bench [in]: benchmark state
+ * @mode [in]: transfer direction
+ * @duration_ns [in]: length of every run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_mode(struct verify_bench *bench, enum verify_mode mode, uint64_t duration_ns)
+{
+	struct verify_run run = {.duration_ns = duration_ns, .max_chunks = UINT64_MAX, .corrupt_chunk = NO_CORRUPTION};
+	double line_gbps, gbps, hash_ns;
+	doca_error_t result;
+	int algo;
+
+	result = run_mode(bench, mode, &run);
+	if (result != DOCA_SUCCESS)
+		return result;
+	line_gbps = run_gbps(bench, &run);
+	DOCA_LOG_INFO("%s, baseline without verification: %.3f GB/s",
+		      mode == VERIFY_MODE_WRITE ? "RDMA write" : "RDMA read",
+		      line_gbps);
+
+	for (algo = 0; algo < CHECKSUM_ALGO_NUM; algo++) {
+		run.verify = true;
+		run.algo = (enum checksum_algo)algo;
+		result = run_mode(bench, mode, &run);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if (run.sink_stage.stats.num_mismatches != 0) {
+			DOCA_LOG_ERR("%lu chunks failed verification", run.sink_stage.stats.num_mismatches);
+			return DOCA_ERROR_UNEXPECTED;
+		}
+		gbps = run_gbps(bench, &run);
+		hash_ns = (double)(run.source_stage.stats.hash_ns + run.sink_stage.stats.hash_ns);
+		DOCA_LOG_INFO("  %-7s %8.3f GB/s, overhead %5.1f%% of line rate, hashing %5.1f%% of the run time",
+			      checksum_algo_name(run.algo),
+			      gbps,
+			      line_gbps > 0.0 ? (line_gbps - gbps) * 100.0 / line_gbps : 0.0,
+			      run.elapsed_ns > 0 ? hash_ns * 100.0 / (double)run.elapsed_ns : 0.0);
+	}
+
+	for (algo = 0; algo < CHECKSUM_ALGO_NUM; algo++) {
+		result = check_corruption(bench, mode, (enum checksum_algo)algo);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Measure the single core hashing rate of every algorithm on one chunk, the upper bound of a verified transfer
+ *
+ * @bench [in]: benchmark state
+ */
+static void report_hash_rates(struct verify_bench *bench)
+{
+	uint64_t start_ns, elapsed_ns, num_chunks, sink = 0;
+	int algo;
+
+	for (algo = 0; algo < CHECKSUM_ALGO_NUM; algo++) {
+		num_chunks = 0;
+		start_ns = bench_get_time_ns();
+		do {
+			sink ^= checksum_compute((enum checksum_algo)algo, bench->src, bench->cfg->msg_size);
+			num_chunks++;
+			elapsed_ns = bench_get_time_ns() - start_ns;
+		} while (elapsed_ns < HASH_RATE_NS);
+		DOCA_LOG_INFO("%-7s single core: %.3f GB/s%s%s%s",
+			      checksum_algo_name((enum checksum_algo)algo),
+			      (double)num_chunks * bench->cfg->msg_size / (double)elapsed_ns,
+			      algo == CHECKSUM_ALGO_CRC32C ? " (" : "",
+			      algo == CHECKSUM_ALGO_CRC32C ? checksum_crc32c_impl_name() : "",
+			      algo == CHECKSUM_ALGO_CRC32C ? ")" : "");
+	}
+	/* Keep the hashing from being optimized away */
+	DOCA_LOG_DBG("Hash rate sink 0x%lx", sink);
+}
+
+/*
+ * Register the regions of the benchmark, import the sink region on the source and the source region on the sink
+ *
+ * @bench [in]: benchmark state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_regions(struct verify_bench *bench)
+{
+	const void *desc;
+	size_t desc_len;
+	doca_error_t result;
+
+	result = rdma_transport_reg_mr(bench->source, bench->src, bench->region_len, &bench->src_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_reg_mr(bench->source,
+				       bench->msgs,
+				       bench->num_slots * sizeof(*bench->msgs),
+				       &bench->msgs_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_reg_mr(bench->sink, bench->dst, bench->region_len, &bench->dst_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_reg_mr(bench->sink,
+				       bench->recv_msgs,
+				       bench->num_recvs * sizeof(*bench->recv_msgs),
+				       &bench->recv_msgs_mr);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = rdma_transport_export_mr(bench->sink, bench->dst_mr, &desc, &desc_len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_import_mr(bench->source, desc, desc_len, &bench->dst_rmr);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = rdma_transport_export_mr(bench->source, bench->src_mr, &desc, &desc_len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return rdma_transport_import_mr(bench->sink, desc, desc_len, &bench->src_rmr);
+}
+
+/*
+ * Release the registrations of the benchmark
+ *
+ * @bench [in]: benchmark state
+ */
+static void deregister_regions(struct verify_bench *bench)
+{
+	if (bench->src_rmr != NULL)
+		(void)rdma_transport_release_rmr(bench->sink, bench->src_rmr);
+	if (bench->dst_rmr != NULL)
+		(void)rdma_transport_release_rmr(bench->source, bench->dst_rmr);
+	if (bench->recv_msgs_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->sink, bench->recv_msgs_mr);
+	if (bench->dst_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->sink, bench->dst_mr);
+	if (bench->msgs_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->source, bench->msgs_mr);
+	if (bench->src_mr != NULL)
+		(void)rdma_transport_dereg_mr(bench->source, bench->src_mr);
+}
+
+/*
+ * Measure the cost of verifying RDMA write and read transfers with a streaming checksum stage
+ *
+ * @cfg [in]: Configuration parameters, the message size is the chunk size
+ * @type [in]: transport backend
+ * @write_mode [in]: run the RDMA write transfer
+ * @read_mode [in]: run the RDMA read transfer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t rdma_verify_bench(struct rdma_bench_config *cfg,
+			       enum rdma_transport_type type,
+			       bool write_mode,
+			       bool read_mode)
+{
+	struct verify_bench bench = {0};
+	struct rdma_transport_attr attr = {0};
+	uint64_t duration_ns;
+	doca_error_t result, tmp_result;
+	size_t i;
+
+	if (cfg->msg_size < MIN_CHUNK_SIZE) {
+		DOCA_LOG_ERR("Chunk size must be at least %d bytes", MIN_CHUNK_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = checksum_self_test();
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	bench.cfg = cfg;
+	bench.num_slots = SLOTS_PER_DEPTH * cfg->queue_depth;
+	/* A digest per chunk in flight, and as many again so that the source does not wait for reposts */
+	bench.num_recvs = 2 * cfg->queue_depth;
+	bench.region_len = (size_t)bench.num_slots * cfg->msg_size;
+	/* Baseline and one verified run per algorithm */
+	duration_ns = (uint64_t)cfg->duration_sec * BENCH_NSEC_PER_SEC / (1 + CHECKSUM_ALGO_NUM);
+
+	bench.src = bench_alloc_numa(bench.region_len, bench_get_ibdev_numa_node(cfg->rdma.device_name));
+	bench.dst = bench_alloc_numa(bench.region_len, bench_get_ibdev_numa_node(cfg->rdma.device_name));
+	bench.msgs = calloc(bench.num_slots, sizeof(*bench.msgs));
+	bench.recv_msgs = calloc(bench.num_recvs, sizeof(*bench.recv_msgs));
+	bench.table = calloc(bench.num_slots, sizeof(*bench.table));
+	if (bench.src == NULL || bench.dst == NULL || bench.msgs == NULL || bench.recv_msgs == NULL ||
+	    bench.table == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %zu bytes regions", bench.region_len);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_regions;
+	}
+	for (i = 0; i < bench.region_len; i++)
+		bench.src[i] = (char)(i * 131 + 7);
+
+	attr.rdma_cfg = &cfg->rdma;
+	/* A chunk write and its digest send */
+	attr.send_queue_size = 2 * cfg->queue_depth;
+	attr.recv_queue_size = bench.num_recvs;
+	result = rdma_transport_create(type, &attr, &bench.source);
+	if (result != DOCA_SUCCESS)
+		goto free_regions;
+	result = rdma_transport_create(type, &attr, &bench.sink);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transports;
+
+	result = rdma_transport_connect(bench.source, bench.sink);
+	if (result != DOCA_SUCCESS)
+		goto destroy_transports;
+
+	result = register_regions(&bench);
+	if (result != DOCA_SUCCESS)
+		goto deregister_regions;
+	result = post_digest_recvs(&bench);
+	if (result != DOCA_SUCCESS)
+		goto deregister_regions;
+
+	DOCA_LOG_INFO("Transport %s, chunk size %u, queue depth %u, %u slots",
+		      bench.source->ops->name,
+		      cfg->msg_size,
+		      cfg->queue_depth,
+		      bench.num_slots);
+	report_hash_rates(&bench);
+
+	if (write_mode) {
+		result = bench_mode(&bench, VERIFY_MODE_WRITE, duration_ns);
+		if (result != DOCA_SUCCESS)
+			goto deregister_regions;
+	}
+	if (read_mode) {
+		result = bench_mode(&bench, VERIFY_MODE_READ, duration_ns);
+		if (result != DOCA_SUCCESS)
+			goto deregister_regions;
+	}
+
+deregister_regions:
+	/* Stopping flushes the digest receives still posted on the sink, so their memory can be deregistered */
+	tmp_result = rdma_transport_stop(bench.sink);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_transport_stop(bench.source);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	deregister_regions(&bench);
+destroy_transports:
+	tmp_result = rdma_transport_destroy(bench.sink);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = rdma_transport_destroy(bench.source);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+free_regions:
+	free(bench.table);
+	free(bench.recv_msgs);
+	free(bench.msgs);
+	bench_free_numa(bench.dst, bench.region_len);
+	bench_free_numa(bench.src, bench.region_len);
+	return result;
+}
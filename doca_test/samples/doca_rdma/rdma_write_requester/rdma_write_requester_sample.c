@@ -104,6 +104,12 @@ static void rdma_write_completed_callback(struct doca_rdma_task_write *rdma_writ
 	doca_error_t *first_encountered_error = (doca_error_t *)task_user_data.ptr;
 	doca_error_t result = DOCA_SUCCESS, tmp_result;
 
+	rdma_latency_task_completed(resources->latency,
+				    doca_rdma_task_write_as_task(rdma_write_task),
+				    RDMA_LATENCY_TASK_WRITE,
+				    doca_rdma_task_write_get_rdma_connection(rdma_write_task),
+				    rdma_latency_buf_len(doca_rdma_task_write_get_src_buf(rdma_write_task)));
+
 	DOCA_LOG_INFO("RDMA write task was done Successfully");
 	DOCA_LOG_INFO("Written to responder \"%s\"", resources->cfg->write_string);
 
@@ -158,6 +164,7 @@ static void rdma_write_error_callback(struct doca_rdma_task_write *rdma_write_ta
 	result = doca_buf_dec_refcount(resources->src_buf, NULL);
 	if (result != DOCA_SUCCESS)
 		DOCA_LOG_ERR("Failed to decrease src_buf count: %s", doca_error_get_descr(result));
+	rdma_latency_task_failed(resources->latency, task);
 	doca_task_free(task);
 
 	resources->num_remaining_tasks--;
@@ -295,9 +302,11 @@ static doca_error_t rdma_write_prepare_and_submit_task(struct rdma_resources *re
 	/* Submit RDMA write task */
 	DOCA_LOG_INFO("Submitting RDMA write task that writes \"%s\" to the responder", resources->cfg->write_string);
 	resources->num_remaining_tasks++;
+	rdma_latency_task_submitted(resources->latency, doca_rdma_task_write_as_task(rdma_write_task));
 	result = doca_task_submit(doca_rdma_task_write_as_task(rdma_write_task));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to submit RDMA write task: %s", doca_error_get_descr(result));
+		rdma_latency_task_failed(resources->latency, doca_rdma_task_write_as_task(rdma_write_task));
 		goto free_task;
 	}
 
@@ -450,6 +459,8 @@ doca_error_t rdma_write_requester(struct rdma_config *cfg)
 	if (cfg->use_rdma_cm == true) {
 		resources.is_requester = true;
 		resources.require_remote_mmap = true;
+		/* Exchange the descriptors in one message on a control buffer registered before connecting */
+		resources.negotiation_descs = RDMA_NEGOTIATION_DESC_MMAP;
 		resources.task_fn = rdma_write_prepare_and_submit_task;
 		result = config_rdma_cm_callback_and_negotiation_task(&resources,
 								      /* need_send_mmap_info */ false,
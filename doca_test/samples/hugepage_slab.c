@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include <doca_log.h>
+
+#include "hugepage_slab.h"
+
+DOCA_LOG_REGISTER(HUGEPAGE_SLAB);
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT (26) /* Position of the log2 page size in the mmap() flags, see mmap(2) */
+#endif
+
+#define SLAB_PAGE_SIZE_1G (1ULL << 30)		   /* 1 GB hugepage */
+#define SLAB_PAGE_SIZE_2M (1ULL << 21)		   /* 2 MB hugepage */
+#define SLAB_AUTO_1G_THRESHOLD (512ULL << 20)	   /* Smallest area backed with 1 GB pages in auto mode */
+#define SLAB_FREELIST_EMPTY (UINT32_MAX)	   /* Freelist index terminating the list */
+#define SLAB_CACHE_LINE_SIZE (64)		   /* Keeps the freelist head away from the read-mostly fields */
+#define SLAB_MAX_PAGE_SIZES (3)			   /* Number of page sizes a slab may try */
+
+struct hugepage_slab {
+	_Alignas(SLAB_CACHE_LINE_SIZE) _Atomic uint64_t free_head; /* ABA tag in the high half, buffer index in the low
+								      half */
+	_Alignas(SLAB_CACHE_LINE_SIZE) _Atomic uint32_t num_allocated; /* Buffers currently handed out */
+	_Alignas(SLAB_CACHE_LINE_SIZE) _Atomic uint32_t *next;	       /* Freelist link of every buffer */
+	char *area;						       /* Mapped area */
+	size_t area_len;					       /* Mapped length, a multiple of page_size */
+	size_t page_size;					       /* Size of the pages backing the area */
+	size_t stride;						       /* Distance between two buffers */
+	uint32_t num_bufs;					       /* Number of buffers */
+	struct doca_mmap *mmap;					       /* Registration of the whole area */
+};
+
+/*
+ * Round a length up to a multiple of a power of 2
+ *
+ * @len [in]: length
+ * @align [in]: power of 2
+ * @return: rounded length
+ */
+static size_t align_up(size_t len, size_t align)
+{
+	return (len + align - 1) & ~(align - 1);
+}
+
+/*
+ * Map an anonymous area with a given page size
+ *
+ * @len [in]: length, a multiple of page_size
+ * @page_size [in]: hugetlbfs page size, or 0 for regular pages
+ * @return: mapped area, or NULL if the mapping failed
+ */
+static char *map_area(size_t len, size_t page_size)
+{
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+	void *addr;
+
+	if (page_size != 0)
+		flags |= MAP_HUGETLB | ((__builtin_ctzll(page_size)) << MAP_HUGE_SHIFT);
+
+	addr = mmap(NULL, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (addr == MAP_FAILED)
+		return NULL;
+
+	/* Regular pages may still be merged into transparent hugepages, ask for it and ignore the answer */
+	if (page_size == 0 && madvise(addr, len, MADV_HUGEPAGE) != 0)
+		DOCA_LOG_DBG("Transparent hugepages are not available for the slab area");
+
+	return addr;
+}
+
+/*
+ * Map the slab area with the largest available page size, place it on the requested node and fault it in
+ *
+ * @slab [in]: slab with num_bufs and stride set
+ * @attr [in]: slab configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t allocate_area(struct hugepage_slab *slab, const struct hugepage_slab_attr *attr)
+{
+	size_t page_sizes[SLAB_MAX_PAGE_SIZES], len = (size_t)slab->num_bufs * slab->stride;
+	unsigned long nodemask;
+	uint32_t num_page_sizes = 0, i;
+
+	switch (attr->page_size) {
+	case HUGEPAGE_SLAB_PAGE_AUTO:
+		if (len >= SLAB_AUTO_1G_THRESHOLD)
+			page_sizes[num_page_sizes++] = SLAB_PAGE_SIZE_1G;
+		page_sizes[num_page_sizes++] = SLAB_PAGE_SIZE_2M;
+		break;
+	case HUGEPAGE_SLAB_PAGE_1G:
+		page_sizes[num_page_sizes++] = SLAB_PAGE_SIZE_1G;
+		page_sizes[num_page_sizes++] = SLAB_PAGE_SIZE_2M;
+		break;
+	case HUGEPAGE_SLAB_PAGE_2M:
+		page_sizes[num_page_sizes++] = SLAB_PAGE_SIZE_2M;
+		break;
+	case HUGEPAGE_SLAB_PAGE_4K:
+		break;
+	default:
+		DOCA_LOG_ERR("Invalid slab page size %d", attr->page_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (i = 0; i < num_page_sizes; i++) {
+		slab->area_len = align_up(len, page_sizes[i]);
+		slab->area = map_area(slab->area_len, page_sizes[i]);
+		if (slab->area != NULL) {
+			slab->page_size = page_sizes[i];
+			break;
+		}
+		DOCA_LOG_DBG("No %zu MB hugepages available for a %zu bytes slab", page_sizes[i] >> 20, len);
+	}
+
+	if (slab->area == NULL) {
+		if (num_page_sizes != 0)
+			DOCA_LOG_WARN("Hugepages are not available, the slab falls back to regular pages");
+		slab->page_size = (size_t)sysconf(_SC_PAGESIZE);
+		slab->area_len = align_up(len, slab->page_size);
+		slab->area = map_area(slab->area_len, 0);
+		if (slab->area == NULL) {
+			DOCA_LOG_ERR("Failed to map a slab area of %zu bytes", slab->area_len);
+			return DOCA_ERROR_NO_MEMORY;
+		}
+	}
+
+	/* Best effort, if the policy can't be applied first-touch below places the pages on the local node */
+	if (attr->numa_node >= 0 && attr->numa_node < (int)(8 * sizeof(nodemask))) {
+		nodemask = 1UL << attr->numa_node;
+		if (syscall(SYS_mbind, slab->area, slab->area_len, MPOL_PREFERRED, &nodemask, 8 * sizeof(nodemask), 0) !=
+		    0)
+			DOCA_LOG_DBG("mbind() to NUMA node %d failed, relying on first-touch placement", attr->numa_node);
+	}
+
+	/* Fault the pages in now, so that registration pins them once and no buffer user pays for it */
+	memset(slab->area, 0, slab->area_len);
+
+	DOCA_LOG_INFO("Slab of %u x %zu bytes buffers backed by %zu KB pages (%zu pages)",
+		      slab->num_bufs,
+		      slab->stride,
+		      slab->page_size >> 10,
+		      slab->area_len / slab->page_size);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the whole slab area with a single mmap
+ *
+ * @slab [in]: slab with a mapped area
+ * @attr [in]: slab configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_area(struct hugepage_slab *slab, const struct hugepage_slab_attr *attr)
+{
+	doca_error_t result, tmp_result;
+
+	result = doca_mmap_create(&slab->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create slab mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_set_permissions(slab->mmap, attr->permissions);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set slab mmap permissions: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	result = doca_mmap_set_memrange(slab->mmap, slab->area, slab->area_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set slab mmap memory range: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	result = doca_mmap_add_dev(slab->mmap, attr->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to add device to slab mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	result = doca_mmap_start(slab->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start slab mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	return DOCA_SUCCESS;
+
+destroy_mmap:
+	tmp_result = doca_mmap_destroy(slab->mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy slab mmap: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	slab->mmap = NULL;
+	return result;
+}
+
+doca_error_t hugepage_slab_parse_page_size(const char *str, enum hugepage_slab_page_size *page_size)
+{
+	if (strcasecmp(str, "auto") == 0)
+		*page_size = HUGEPAGE_SLAB_PAGE_AUTO;
+	else if (strcasecmp(str, "1g") == 0)
+		*page_size = HUGEPAGE_SLAB_PAGE_1G;
+	else if (strcasecmp(str, "2m") == 0)
+		*page_size = HUGEPAGE_SLAB_PAGE_2M;
+	else if (strcasecmp(str, "4k") == 0)
+		*page_size = HUGEPAGE_SLAB_PAGE_4K;
+	else
+		return DOCA_ERROR_INVALID_VALUE;
+
+	return DOCA_SUCCESS;
+}
+
+doca_error_t hugepage_slab_create(const struct hugepage_slab_attr *attr, struct hugepage_slab **slab)
+{
+	struct hugepage_slab *new_slab;
+	size_t align;
+	doca_error_t result;
+	uint32_t i;
+
+	if (attr == NULL || slab == NULL || attr->dev == NULL || attr->buf_size == 0 || attr->num_bufs == 0 ||
+	    attr->num_bufs == SLAB_FREELIST_EMPTY)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	align = attr->buf_align == 0 ? HUGEPAGE_SLAB_DEFAULT_ALIGN : attr->buf_align;
+	if ((align & (align - 1)) != 0) {
+		DOCA_LOG_ERR("Slab buffer alignment %zu is not a power of 2", align);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (attr->buf_size > SIZE_MAX / 2 || align_up(attr->buf_size, align) > SIZE_MAX / attr->num_bufs) {
+		DOCA_LOG_ERR("Slab of %u x %zu bytes buffers is too large", attr->num_bufs, attr->buf_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_slab = aligned_alloc(SLAB_CACHE_LINE_SIZE, sizeof(*new_slab));
+	if (new_slab == NULL) {
+		DOCA_LOG_ERR("Failed to allocate slab");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(new_slab, 0, sizeof(*new_slab));
+	new_slab->num_bufs = attr->num_bufs;
+	new_slab->stride = align_up(attr->buf_size, align);
+
+	new_slab->next = calloc(attr->num_bufs, sizeof(*new_slab->next));
+	if (new_slab->next == NULL) {
+		DOCA_LOG_ERR("Failed to allocate slab freelist of %u entries", attr->num_bufs);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_slab;
+	}
+
+	result = allocate_area(new_slab, attr);
+	if (result != DOCA_SUCCESS)
+		goto free_next;
+
+	result = register_area(new_slab, attr);
+	if (result != DOCA_SUCCESS)
+		goto unmap_area;
+
+	for (i = 0; i < attr->num_bufs; i++)
+		atomic_init(&new_slab->next[i], i + 1 == attr->num_bufs ? SLAB_FREELIST_EMPTY : i + 1);
+	atomic_init(&new_slab->free_head, 0);
+	atomic_init(&new_slab->num_allocated, 0);
+
+	*slab = new_slab;
+	return DOCA_SUCCESS;
+
+unmap_area:
+	munmap(new_slab->area, new_slab->area_len);
+free_next:
+	free(new_slab->next);
+free_slab:
+	free(new_slab);
+	return result;
+}
+
+doca_error_t hugepage_slab_destroy(struct hugepage_slab *slab)
+{
+	doca_error_t result, tmp_result;
+	uint32_t num_allocated;
+
+	if (slab == NULL)
+		return DOCA_SUCCESS;
+
+	num_allocated = atomic_load(&slab->num_allocated);
+	if (num_allocated != 0) {
+		DOCA_LOG_ERR("Failed to destroy slab: %u buffers are still allocated", num_allocated);
+		return DOCA_ERROR_IN_USE;
+	}
+
+	result = doca_mmap_stop(slab->mmap);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to stop slab mmap: %s", doca_error_get_descr(result));
+
+	tmp_result = doca_mmap_destroy(slab->mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy slab mmap: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	munmap(slab->area, slab->area_len);
+	free(slab->next);
+	free(slab);
+	return result;
+}
+
+void *hugepage_slab_alloc(struct hugepage_slab *slab)
+{
+	uint64_t head = atomic_load_explicit(&slab->free_head, memory_order_acquire), new_head;
+	uint32_t index;
+
+	do {
+		index = (uint32_t)head;
+		if (index == SLAB_FREELIST_EMPTY)
+			return NULL;
+		/* The tag makes the exchange fail if index was popped and pushed back in between */
+		new_head = (((head >> 32) + 1) << 32) | atomic_load_explicit(&slab->next[index], memory_order_relaxed);
+	} while (!atomic_compare_exchange_weak_explicit(&slab->free_head,
+							&head,
+							new_head,
+							memory_order_acquire,
+							memory_order_acquire));
+
+	atomic_fetch_add_explicit(&slab->num_allocated, 1, memory_order_relaxed);
+	return slab->area + (size_t)index * slab->stride;
+}
+
+void hugepage_slab_free(struct hugepage_slab *slab, void *buf)
+{
+	uint32_t index = (uint32_t)(((char *)buf - slab->area) / slab->stride);
+	uint64_t head = atomic_load_explicit(&slab->free_head, memory_order_relaxed), new_head;
+
+	do {
+		atomic_store_explicit(&slab->next[index], (uint32_t)head, memory_order_relaxed);
+		new_head = (((head >> 32) + 1) << 32) | index;
+	} while (!atomic_compare_exchange_weak_explicit(&slab->free_head,
+							&head,
+							new_head,
+							memory_order_release,
+							memory_order_relaxed));
+
+	atomic_fetch_sub_explicit(&slab->num_allocated, 1, memory_order_relaxed);
+}
+
+struct doca_mmap *hugepage_slab_get_mmap(const struct hugepage_slab *slab)
+{
+	return slab->mmap;
+}
+
+size_t hugepage_slab_get_page_size(const struct hugepage_slab *slab)
+{
+	return slab->page_size;
+}
+
+uint32_t hugepage_slab_get_num_allocated(const struct hugepage_slab *slab)
+{
+	return atomic_load_explicit(&slab->num_allocated, memory_order_relaxed);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef HUGEPAGE_SLAB_H_
+#define HUGEPAGE_SLAB_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HUGEPAGE_SLAB_DEFAULT_ALIGN (64) /* Default alignment of the handed out buffers */
+
+/* Largest page size a slab tries to back its memory with, smaller sizes are tried when it is unavailable */
+enum hugepage_slab_page_size {
+	HUGEPAGE_SLAB_PAGE_AUTO, /* 1 GB pages for areas of at least 512 MB, 2 MB pages otherwise */
+	HUGEPAGE_SLAB_PAGE_1G,	 /* 1 GB hugetlbfs pages */
+	HUGEPAGE_SLAB_PAGE_2M,	 /* 2 MB hugetlbfs pages */
+	HUGEPAGE_SLAB_PAGE_4K,	 /* Regular pages, with transparent hugepages requested */
+};
+
+/* Slab configuration */
+struct hugepage_slab_attr {
+	struct doca_dev *dev;			 /* Device the slab memory is registered with */
+	uint32_t permissions;			 /* DOCA access flags of the slab mmap */
+	size_t buf_size;			 /* Size of every buffer */
+	uint32_t num_bufs;			 /* Number of buffers */
+	size_t buf_align;			 /* Buffer alignment, a power of 2, 0 for HUGEPAGE_SLAB_DEFAULT_ALIGN */
+	enum hugepage_slab_page_size page_size; /* Largest page size to try */
+	int numa_node;				 /* NUMA node to place the memory on, negative for the local node */
+};
+
+/*
+ * Fixed size buffer allocator over a single registered area
+ *
+ * The area is mapped once, with hugetlbfs pages when possible so that the device needs few translation entries for
+ * it, faulted in, and registered with a single started doca_mmap. Buffers are handed out from a lock-free LIFO
+ * freelist, so any thread may allocate and free concurrently and every buffer is already covered by the mmap.
+ */
+struct hugepage_slab;
+
+/*
+ * Parse a page size name: "auto", "1g", "2m" or "4k"
+ *
+ * @str [in]: page size name
+ * @page_size [out]: parsed page size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR_INVALID_VALUE if the name is unknown
+ */
+doca_error_t hugepage_slab_parse_page_size(const char *str, enum hugepage_slab_page_size *page_size);
+
+/*
+ * Map, fault in and register the slab area
+ *
+ * @attr [in]: slab configuration
+ * @slab [out]: the created slab
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t hugepage_slab_create(const struct hugepage_slab_attr *attr, struct hugepage_slab **slab);
+
+/*
+ * Deregister and unmap the slab area
+ *
+ * @slab [in]: slab to destroy, may be NULL
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_IN_USE if some buffers were not freed (the slab is not destroyed)
+ * and DOCA_ERROR otherwise
+ */
+doca_error_t hugepage_slab_destroy(struct hugepage_slab *slab);
+
+/*
+ * Take a buffer from the slab
+ *
+ * @slab [in]: the slab
+ * @return: buffer of buf_size bytes covered by the slab mmap, or NULL if all the buffers are in use
+ */
+void *hugepage_slab_alloc(struct hugepage_slab *slab);
+
+/*
+ * Return a buffer to the slab
+ *
+ * @slab [in]: the slab
+ * @buf [in]: buffer returned by hugepage_slab_alloc()
+ */
+void hugepage_slab_free(struct hugepage_slab *slab, void *buf);
+
+/*
+ * Get the started mmap covering every buffer of the slab
+ *
+ * @slab [in]: the slab
+ * @return: the slab mmap
+ */
+struct doca_mmap *hugepage_slab_get_mmap(const struct hugepage_slab *slab);
+
+/*
+ * Get the size of the pages backing the slab
+ *
+ * @slab [in]: the slab
+ * @return: page size in bytes
+ */
+size_t hugepage_slab_get_page_size(const struct hugepage_slab *slab);
+
+/*
+ * Get the number of buffers currently taken from the slab
+ *
+ * @slab [in]: the slab
+ * @return: number of allocated buffers, only a snapshot when called concurrently
+ */
+uint32_t hugepage_slab_get_num_allocated(const struct hugepage_slab *slab);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HUGEPAGE_SLAB_H_ */
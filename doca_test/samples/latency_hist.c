@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "latency_hist.h"
+
+#define NSEC_PER_USEC (1000.0) /* Nanoseconds in one microsecond */
+
+/*
+ * Get the range of values of a bucket
+ *
+ * @bucket [in]: bucket index
+ * @lowest [out]: smallest value of the bucket
+ * @width [out]: number of values in the bucket
+ */
+static void bucket_range(uint32_t bucket, uint64_t *lowest, uint64_t *width)
+{
+	const uint32_t half = LATENCY_HIST_SUB_BUCKETS / 2;
+	uint32_t shift;
+
+	if (bucket < LATENCY_HIST_SUB_BUCKETS) {
+		*lowest = bucket;
+		*width = 1;
+		return;
+	}
+	shift = bucket / half - 1;
+	*lowest = (uint64_t)(bucket % half + half) << shift;
+	*width = 1ULL << shift;
+}
+
+void latency_hist_init(struct latency_hist *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+	hist->min = UINT64_MAX;
+}
+
+void latency_hist_merge(struct latency_hist *dst, const struct latency_hist *src)
+{
+	uint32_t i;
+
+	for (i = 0; i < LATENCY_HIST_NUM_BUCKETS; i++)
+		dst->counts[i] += src->counts[i];
+	dst->count += src->count;
+	if (src->min < dst->min)
+		dst->min = src->min;
+	if (src->max > dst->max)
+		dst->max = src->max;
+	dst->sum += src->sum;
+	dst->sum_sq += src->sum_sq;
+}
+
+uint64_t latency_hist_percentile(const struct latency_hist *hist, double percentile)
+{
+	uint64_t rank, seen = 0, lowest, width, value;
+	uint32_t i;
+
+	if (hist->count == 0)
+		return 0;
+
+	/* Rank of the value, 1 based, so that the 100th percentile is the largest value */
+	rank = (uint64_t)ceil(percentile / 100.0 * (double)hist->count);
+	if (rank == 0)
+		rank = 1;
+	if (rank > hist->count)
+		rank = hist->count;
+
+	for (i = 0; i < LATENCY_HIST_NUM_BUCKETS; i++) {
+		seen += hist->counts[i];
+		if (seen >= rank)
+			break;
+	}
+	bucket_range(i, &lowest, &width);
+	value = lowest + width / 2;
+
+	if (value < hist->min)
+		return hist->min;
+	if (value > hist->max)
+		return hist->max;
+	return value;
+}
+
+double latency_hist_mean(const struct latency_hist *hist)
+{
+	if (hist->count == 0)
+		return 0.0;
+	return hist->sum / (double)hist->count;
+}
+
+double latency_hist_stdev(const struct latency_hist *hist)
+{
+	double mean, variance;
+
+	if (hist->count == 0)
+		return 0.0;
+	mean = latency_hist_mean(hist);
+	variance = hist->sum_sq / (double)hist->count - mean * mean;
+	return variance > 0.0 ? sqrt(variance) : 0.0;
+}
+
+void latency_hist_write_json(FILE *fp, const char *type, uint64_t bytes, const struct latency_hist *hist, int indent)
+{
+	fprintf(fp, "%*s{\n", indent, "");
+	fprintf(fp, "%*s\"type\": \"%s\",\n", indent + 2, "", type);
+	fprintf(fp, "%*s\"bytes\": %lu,\n", indent + 2, "", bytes);
+	fprintf(fp, "%*s\"iterations\": %lu,\n", indent + 2, "", hist->count);
+	fprintf(fp, "%*s\"t_min\": %.2f,\n", indent + 2, "", hist->count ? hist->min / NSEC_PER_USEC : 0.0);
+	fprintf(fp, "%*s\"t_max\": %.2f,\n", indent + 2, "", hist->max / NSEC_PER_USEC);
+	fprintf(fp, "%*s\"t_typical\": %.2f,\n", indent + 2, "", latency_hist_percentile(hist, 50.0) / NSEC_PER_USEC);
+	fprintf(fp, "%*s\"t_avg\": %.2f,\n", indent + 2, "", latency_hist_mean(hist) / NSEC_PER_USEC);
+	fprintf(fp, "%*s\"t_stdev\": %.2f,\n", indent + 2, "", latency_hist_stdev(hist) / NSEC_PER_USEC);
+	fprintf(fp, "%*s\"t_99\": %.2f,\n", indent + 2, "", latency_hist_percentile(hist, 99.0) / NSEC_PER_USEC);
+	fprintf(fp, "%*s\"t_999\": %.2f\n", indent + 2, "", latency_hist_percentile(hist, 99.9) / NSEC_PER_USEC);
+	fprintf(fp, "%*s}", indent, "");
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef LATENCY_HIST_H_
+#define LATENCY_HIST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Log-linear latency histogram, in the style of HdrHistogram.
+ *
+ * Values below LATENCY_HIST_SUB_BUCKETS nanoseconds get a bucket each. Above that every power of two is split into
+ * LATENCY_HIST_SUB_BUCKETS / 2 linear buckets, so the relative error of a reported value stays below
+ * 2 / LATENCY_HIST_SUB_BUCKETS at every scale. The memory is fixed and recording is a count leading zeros, two shifts
+ * and an increment.
+ */
+
+#define LATENCY_HIST_SUB_BUCKET_BITS (7)			      /* log2 of LATENCY_HIST_SUB_BUCKETS */
+#define LATENCY_HIST_SUB_BUCKETS (1U << LATENCY_HIST_SUB_BUCKET_BITS) /* Number of exactly recorded values */
+#define LATENCY_HIST_MAX_BITS (40)				      /* Values are clamped below 2^40 ns (18 min) */
+/* Number of buckets: the exact range, then half of LATENCY_HIST_SUB_BUCKETS per power of two up to the clamp */
+#define LATENCY_HIST_NUM_BUCKETS \
+	((LATENCY_HIST_MAX_BITS - LATENCY_HIST_SUB_BUCKET_BITS + 2) * (LATENCY_HIST_SUB_BUCKETS / 2))
+
+/* Latency histogram, all values in nanoseconds */
+struct latency_hist {
+	uint64_t counts[LATENCY_HIST_NUM_BUCKETS]; /* Number of values in every bucket */
+	uint64_t count;				   /* Number of recorded values */
+	uint64_t min;				   /* Smallest recorded value, UINT64_MAX when empty */
+	uint64_t max;				   /* Largest recorded value */
+	double sum;				   /* Sum of the recorded values */
+	double sum_sq;				   /* Sum of the squares of the recorded values */
+};
+
+/*
+ * Get the bucket of a value
+ *
+ * @value [in]: value in nanoseconds
+ * @return: bucket index
+ */
+static inline uint32_t latency_hist_bucket(uint64_t value)
+{
+	uint32_t msb, shift;
+
+	if (value < LATENCY_HIST_SUB_BUCKETS)
+		return (uint32_t)value;
+	if (value >> LATENCY_HIST_MAX_BITS)
+		value = (1ULL << LATENCY_HIST_MAX_BITS) - 1;
+
+	msb = 63 - (uint32_t)__builtin_clzll(value);
+	shift = msb - (LATENCY_HIST_SUB_BUCKET_BITS - 1);
+	/* The top LATENCY_HIST_SUB_BUCKET_BITS bits of the value, at least LATENCY_HIST_SUB_BUCKETS / 2 */
+	return shift * (LATENCY_HIST_SUB_BUCKETS / 2) + (uint32_t)(value >> shift);
+}
+
+/*
+ * Record a value
+ *
+ * @hist [in]: the histogram
+ * @value [in]: value in nanoseconds
+ */
+static inline void latency_hist_record(struct latency_hist *hist, uint64_t value)
+{
+	hist->counts[latency_hist_bucket(value)]++;
+	hist->count++;
+	if (value < hist->min)
+		hist->min = value;
+	if (value > hist->max)
+		hist->max = value;
+	hist->sum += (double)value;
+	hist->sum_sq += (double)value * (double)value;
+}
+
+/*
+ * Reset a histogram
+ *
+ * @hist [out]: the histogram
+ */
+void latency_hist_init(struct latency_hist *hist);
+
+/*
+ * Add the values of a histogram to another
+ *
+ * @dst [in/out]: histogram to add to
+ * @src [in]: histogram to add
+ */
+void latency_hist_merge(struct latency_hist *dst, const struct latency_hist *src);
+
+/*
+ * Get a percentile, the middle of the bucket it falls in clamped to the recorded range
+ *
+ * @hist [in]: the histogram
+ * @percentile [in]: percentile between 0 and 100
+ * @return: value in nanoseconds, 0 when the histogram is empty
+ */
+uint64_t latency_hist_percentile(const struct latency_hist *hist, double percentile);
+
+/*
+ * Get the mean of the recorded values
+ *
+ * @hist [in]: the histogram
+ * @return: mean in nanoseconds, 0 when the histogram is empty
+ */
+double latency_hist_mean(const struct latency_hist *hist);
+
+/*
+ * Get the standard deviation of the recorded values
+ *
+ * @hist [in]: the histogram
+ * @return: standard deviation in nanoseconds, 0 when the histogram is empty
+ */
+double latency_hist_stdev(const struct latency_hist *hist);
+
+/*
+ * Write a histogram as an entry of the "latency" array of rdma_results.json, the file written from perftest output
+ * by nic_mode_test/workspace/get_result.py: type, bytes and iterations, then t_min, t_max, t_typical (median),
+ * t_avg, t_stdev, t_99 and t_999 in microseconds
+ *
+ * @fp [in]: file to write to
+ * @type [in]: test type, e.g. "doca_rdma_send_lat"
+ * @bytes [in]: message size
+ * @hist [in]: the histogram
+ * @indent [in]: indentation of the object, in spaces
+ */
+void latency_hist_write_json(FILE *fp, const char *type, uint64_t bytes, const struct latency_hist *hist, int indent);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LATENCY_HIST_H_ */
@@ -0,0 +1,684 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <doca_log.h>
+
+#include "mmap_cache.h"
+
+DOCA_LOG_REGISTER(MMAP_CACHE);
+
+#define MMAP_CACHE_INITIAL_SCRATCH_LEN (16) /* Initial capacity of the overlapping entries array */
+
+struct mmap_cache_entry {
+	uintptr_t start;		     /* Registered range start, page aligned */
+	uintptr_t end;			     /* Registered range end (exclusive), page aligned */
+	struct doca_mmap *mmap;		     /* Started mmap of the range */
+	uint32_t refcount;		     /* Number of users that acquired the entry */
+	bool in_tree;			     /* False once replaced or invalidated, destroyed on the last release */
+	uint32_t priority;		     /* Treap heap priority */
+	uintptr_t max_end;		     /* Largest end in the subtree, used to prune interval queries */
+	struct mmap_cache_entry *left;	     /* Subtree of lower start addresses */
+	struct mmap_cache_entry *right;	     /* Subtree of higher start addresses */
+	struct mmap_cache_entry *idle_prev;  /* Towards the most recently released idle entry */
+	struct mmap_cache_entry *idle_next;  /* Towards the least recently released idle entry */
+};
+
+struct mmap_cache {
+	struct mmap_cache_attr attr;	     /* Cache configuration */
+	struct mmap_cache_entry *root;	     /* Interval tree of the registered ranges */
+	struct mmap_cache_entry *idle_head;  /* Most recently released idle entry */
+	struct mmap_cache_entry *idle_tail;  /* Least recently released idle entry, evicted first */
+	struct mmap_cache_entry **scratch;   /* Entries found by the last interval query */
+	uint32_t scratch_len;		     /* Capacity of scratch */
+	uint32_t num_scratch;		     /* Number of entries in scratch */
+	uint32_t rand_state;		     /* Treap priority generator state */
+	uintptr_t page_size;		     /* Registration granularity */
+	struct mmap_cache_stats stats;	     /* Counters */
+};
+
+/*
+ * Get a monotonic timestamp
+ *
+ * @return: CLOCK_MONOTONIC time in nanoseconds
+ */
+static uint64_t mmap_cache_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Get the next treap priority
+ *
+ * @cache [in]: the cache
+ * @return: pseudo random priority
+ */
+static uint32_t next_priority(struct mmap_cache *cache)
+{
+	uint32_t x = cache->rand_state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	cache->rand_state = x;
+	return x;
+}
+
+/*
+ * Recompute the subtree max end of a node from its children
+ *
+ * @node [in]: tree node
+ */
+static void tree_update(struct mmap_cache_entry *node)
+{
+	node->max_end = node->end;
+	if (node->left != NULL && node->left->max_end > node->max_end)
+		node->max_end = node->left->max_end;
+	if (node->right != NULL && node->right->max_end > node->max_end)
+		node->max_end = node->right->max_end;
+}
+
+/*
+ * Rotate a subtree so that its left child becomes the root
+ *
+ * @node [in]: subtree root
+ * @return: new subtree root
+ */
+static struct mmap_cache_entry *tree_rotate_right(struct mmap_cache_entry *node)
+{
+	struct mmap_cache_entry *pivot = node->left;
+
+	node->left = pivot->right;
+	pivot->right = node;
+	tree_update(node);
+	tree_update(pivot);
+	return pivot;
+}
+
+/*
+ * Rotate a subtree so that its right child becomes the root
+ *
+ * @node [in]: subtree root
+ * @return: new subtree root
+ */
+static struct mmap_cache_entry *tree_rotate_left(struct mmap_cache_entry *node)
+{
+	struct mmap_cache_entry *pivot = node->right;
+
+	node->right = pivot->left;
+	pivot->left = node;
+	tree_update(node);
+	tree_update(pivot);
+	return pivot;
+}
+
+/*
+ * Insert a node into a subtree
+ *
+ * @root [in]: subtree root, may be NULL
+ * @node [in]: node to insert
+ * @return: new subtree root
+ */
+static struct mmap_cache_entry *tree_insert(struct mmap_cache_entry *root, struct mmap_cache_entry *node)
+{
+	if (root == NULL) {
+		node->left = NULL;
+		node->right = NULL;
+		tree_update(node);
+		return node;
+	}
+
+	if (node->start < root->start) {
+		root->left = tree_insert(root->left, node);
+		if (root->left->priority > root->priority)
+			return tree_rotate_right(root);
+	} else {
+		root->right = tree_insert(root->right, node);
+		if (root->right->priority > root->priority)
+			return tree_rotate_left(root);
+	}
+
+	tree_update(root);
+	return root;
+}
+
+/*
+ * Remove a node from a subtree
+ *
+ * @root [in]: subtree root
+ * @node [in]: node to remove, must be in the subtree
+ * @return: new subtree root
+ */
+static struct mmap_cache_entry *tree_remove(struct mmap_cache_entry *root, struct mmap_cache_entry *node)
+{
+	if (root == NULL)
+		return NULL;
+
+	if (root == node) {
+		if (root->left == NULL)
+			return root->right;
+		if (root->right == NULL)
+			return root->left;
+
+		/* Push the node down towards the child with the higher priority until it has a single child */
+		if (root->left->priority > root->right->priority) {
+			root = tree_rotate_right(root);
+			root->right = tree_remove(root->right, node);
+		} else {
+			root = tree_rotate_left(root);
+			root->left = tree_remove(root->left, node);
+		}
+	} else if (node->start < root->start) {
+		root->left = tree_remove(root->left, node);
+	} else {
+		root->right = tree_remove(root->right, node);
+	}
+
+	tree_update(root);
+	return root;
+}
+
+/*
+ * Find a node whose range contains [start, end)
+ *
+ * @root [in]: subtree root
+ * @start [in]: range start
+ * @end [in]: range end (exclusive)
+ * @return: covering node, or NULL if there is none
+ */
+static struct mmap_cache_entry *tree_find_covering(struct mmap_cache_entry *root, uintptr_t start, uintptr_t end)
+{
+	struct mmap_cache_entry *found;
+
+	if (root == NULL || root->max_end < end)
+		return NULL;
+
+	if (root->start <= start && root->end >= end)
+		return root;
+
+	found = tree_find_covering(root->left, start, end);
+	if (found != NULL || root->start > start)
+		return found;
+
+	return tree_find_covering(root->right, start, end);
+}
+
+/*
+ * Collect into the cache scratch array every node whose range overlaps or touches [start, end]
+ *
+ * @cache [in]: the cache
+ * @root [in]: subtree root
+ * @start [in]: range start
+ * @end [in]: range end (inclusive, so that adjacent ranges are collected too)
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t tree_collect(struct mmap_cache *cache, struct mmap_cache_entry *root, uintptr_t start, uintptr_t end)
+{
+	struct mmap_cache_entry **scratch;
+	doca_error_t result;
+
+	if (root == NULL || root->max_end < start)
+		return DOCA_SUCCESS;
+
+	result = tree_collect(cache, root->left, start, end);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	if (root->start > end)
+		return DOCA_SUCCESS;
+
+	if (root->end >= start) {
+		if (cache->num_scratch == cache->scratch_len) {
+			scratch = realloc(cache->scratch, 2 * cache->scratch_len * sizeof(*scratch));
+			if (scratch == NULL) {
+				DOCA_LOG_ERR("Failed to grow the registration cache query array");
+				return DOCA_ERROR_NO_MEMORY;
+			}
+			cache->scratch = scratch;
+			cache->scratch_len *= 2;
+		}
+		cache->scratch[cache->num_scratch++] = root;
+	}
+
+	return tree_collect(cache, root->right, start, end);
+}
+
+/*
+ * Add an entry at the head of the idle list
+ *
+ * @cache [in]: the cache
+ * @entry [in]: entry whose last reference was released
+ */
+static void idle_push(struct mmap_cache *cache, struct mmap_cache_entry *entry)
+{
+	entry->idle_prev = NULL;
+	entry->idle_next = cache->idle_head;
+	if (cache->idle_head != NULL)
+		cache->idle_head->idle_prev = entry;
+	else
+		cache->idle_tail = entry;
+	cache->idle_head = entry;
+
+	cache->stats.num_idle++;
+	cache->stats.idle_bytes += entry->end - entry->start;
+}
+
+/*
+ * Remove an entry from the idle list
+ *
+ * @cache [in]: the cache
+ * @entry [in]: idle entry
+ */
+static void idle_unlink(struct mmap_cache *cache, struct mmap_cache_entry *entry)
+{
+	if (entry->idle_prev != NULL)
+		entry->idle_prev->idle_next = entry->idle_next;
+	else
+		cache->idle_head = entry->idle_next;
+	if (entry->idle_next != NULL)
+		entry->idle_next->idle_prev = entry->idle_prev;
+	else
+		cache->idle_tail = entry->idle_prev;
+	entry->idle_prev = NULL;
+	entry->idle_next = NULL;
+
+	cache->stats.num_idle--;
+	cache->stats.idle_bytes -= entry->end - entry->start;
+}
+
+/*
+ * Remove an entry from the interval tree so that it is no longer returned by lookups
+ *
+ * @cache [in]: the cache
+ * @entry [in]: entry in the tree
+ */
+static void detach_entry(struct mmap_cache *cache, struct mmap_cache_entry *entry)
+{
+	cache->root = tree_remove(cache->root, entry);
+	entry->in_tree = false;
+	entry->left = NULL;
+	entry->right = NULL;
+}
+
+/*
+ * Create and start an mmap over a range
+ *
+ * @cache [in]: the cache
+ * @start [in]: range start
+ * @end [in]: range end (exclusive)
+ * @mmap [out]: started mmap
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_range(struct mmap_cache *cache, uintptr_t start, uintptr_t end, struct doca_mmap **mmap)
+{
+	uint64_t begin_ns = mmap_cache_time_ns();
+	doca_error_t result, tmp_result;
+
+	result = doca_mmap_create(mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_set_permissions(*mmap, cache->attr.permissions);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set mmap permissions: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	result = doca_mmap_set_memrange(*mmap, (void *)start, end - start);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set mmap memory range: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	result = doca_mmap_add_dev(*mmap, cache->attr.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to add device to mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	result = doca_mmap_start(*mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+
+	cache->stats.registrations++;
+	cache->stats.registration_ns += mmap_cache_time_ns() - begin_ns;
+	return DOCA_SUCCESS;
+
+destroy_mmap:
+	tmp_result = doca_mmap_destroy(*mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy mmap: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	*mmap = NULL;
+	return result;
+}
+
+/*
+ * Deregister the mmap of an entry that is neither in the tree nor in the idle list, and free the entry
+ *
+ * @cache [in]: the cache
+ * @entry [in]: entry to destroy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t destroy_entry(struct mmap_cache *cache, struct mmap_cache_entry *entry)
+{
+	uint64_t begin_ns = mmap_cache_time_ns();
+	doca_error_t result, tmp_result;
+
+	result = doca_mmap_stop(entry->mmap);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to stop mmap: %s", doca_error_get_descr(result));
+
+	tmp_result = doca_mmap_destroy(entry->mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to destroy mmap: %s", doca_error_get_descr(tmp_result));
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	cache->stats.deregistrations++;
+	cache->stats.deregistration_ns += mmap_cache_time_ns() - begin_ns;
+	cache->stats.registered_bytes -= entry->end - entry->start;
+	cache->stats.num_entries--;
+	free(entry);
+	return result;
+}
+
+/*
+ * Deregister idle entries, least recently released first, until the idle limits are met
+ *
+ * @cache [in]: the cache
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t evict_idle(struct mmap_cache *cache)
+{
+	struct mmap_cache_entry *victim;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	while (cache->stats.num_idle > cache->attr.max_idle_entries ||
+	       cache->stats.idle_bytes > cache->attr.max_idle_bytes) {
+		victim = cache->idle_tail;
+		idle_unlink(cache, victim);
+		detach_entry(cache, victim);
+		cache->stats.evictions++;
+		tmp_result = destroy_entry(cache, victim);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	return result;
+}
+
+doca_error_t mmap_cache_create(const struct mmap_cache_attr *attr, struct mmap_cache **cache)
+{
+	struct mmap_cache *new_cache;
+	long page_size;
+
+	if (attr == NULL || attr->dev == NULL || cache == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	page_size = sysconf(_SC_PAGESIZE);
+	if (page_size <= 0 || (page_size & (page_size - 1)) != 0) {
+		DOCA_LOG_ERR("Failed to get the system page size");
+		return DOCA_ERROR_UNEXPECTED;
+	}
+
+	new_cache = calloc(1, sizeof(*new_cache));
+	if (new_cache == NULL) {
+		DOCA_LOG_ERR("Failed to allocate registration cache");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	new_cache->scratch = calloc(MMAP_CACHE_INITIAL_SCRATCH_LEN, sizeof(*new_cache->scratch));
+	if (new_cache->scratch == NULL) {
+		DOCA_LOG_ERR("Failed to allocate registration cache query array");
+		free(new_cache);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	new_cache->attr = *attr;
+	new_cache->scratch_len = MMAP_CACHE_INITIAL_SCRATCH_LEN;
+	new_cache->rand_state = 0x9e3779b9;
+	new_cache->page_size = (uintptr_t)page_size;
+
+	*cache = new_cache;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t mmap_cache_destroy(struct mmap_cache *cache)
+{
+	doca_error_t result;
+
+	if (cache == NULL)
+		return DOCA_SUCCESS;
+
+	result = mmap_cache_flush(cache);
+
+	if (cache->stats.num_entries != 0) {
+		DOCA_LOG_ERR("Failed to destroy registration cache: %u entries are still acquired",
+			     cache->stats.num_entries);
+		return DOCA_ERROR_IN_USE;
+	}
+
+	free(cache->scratch);
+	free(cache);
+	return result;
+}
+
+doca_error_t mmap_cache_acquire(struct mmap_cache *cache, void *addr, size_t len, struct mmap_cache_entry **entry)
+{
+	struct mmap_cache_entry *found, *new_entry, *merged;
+	uintptr_t buf_start = (uintptr_t)addr, buf_end = buf_start + len, start, end;
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	if (cache == NULL || addr == NULL || len == 0 || entry == NULL || buf_end < buf_start)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	found = tree_find_covering(cache->root, buf_start, buf_end);
+	if (found != NULL) {
+		if (found->refcount == 0)
+			idle_unlink(cache, found);
+		found->refcount++;
+		cache->stats.hits++;
+		*entry = found;
+		return DOCA_SUCCESS;
+	}
+
+	cache->stats.misses++;
+
+	/* Register whole pages, and grow the range over every cached range it overlaps or touches */
+	start = buf_start & ~(cache->page_size - 1);
+	end = (buf_end + cache->page_size - 1) & ~(cache->page_size - 1);
+
+	cache->num_scratch = 0;
+	result = tree_collect(cache, cache->root, start, end);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	for (i = 0; i < cache->num_scratch; i++) {
+		if (cache->scratch[i]->start < start)
+			start = cache->scratch[i]->start;
+		if (cache->scratch[i]->end > end)
+			end = cache->scratch[i]->end;
+	}
+
+	new_entry = calloc(1, sizeof(*new_entry));
+	if (new_entry == NULL) {
+		DOCA_LOG_ERR("Failed to allocate registration cache entry");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = register_range(cache, start, end, &new_entry->mmap);
+	if (result != DOCA_SUCCESS) {
+		free(new_entry);
+		return result;
+	}
+
+	/* The merged ranges are superseded, the ones still acquired go away on their last release */
+	for (i = 0; i < cache->num_scratch; i++) {
+		merged = cache->scratch[i];
+		detach_entry(cache, merged);
+		cache->stats.merges++;
+		if (merged->refcount == 0) {
+			idle_unlink(cache, merged);
+			tmp_result = destroy_entry(cache, merged);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	new_entry->start = start;
+	new_entry->end = end;
+	new_entry->refcount = 1;
+	new_entry->in_tree = true;
+	new_entry->priority = next_priority(cache);
+	cache->root = tree_insert(cache->root, new_entry);
+
+	cache->stats.num_entries++;
+	cache->stats.registered_bytes += end - start;
+
+	*entry = new_entry;
+	return result;
+}
+
+doca_error_t mmap_cache_release(struct mmap_cache *cache, struct mmap_cache_entry *entry)
+{
+	if (cache == NULL || entry == NULL || entry->refcount == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	entry->refcount--;
+	if (entry->refcount != 0)
+		return DOCA_SUCCESS;
+
+	if (!entry->in_tree)
+		return destroy_entry(cache, entry);
+
+	idle_push(cache, entry);
+	return evict_idle(cache);
+}
+
+struct doca_mmap *mmap_cache_entry_get_mmap(const struct mmap_cache_entry *entry)
+{
+	return entry->mmap;
+}
+
+doca_error_t mmap_cache_invalidate(struct mmap_cache *cache, void *addr, size_t len)
+{
+	uintptr_t start = (uintptr_t)addr, end = start + len;
+	struct mmap_cache_entry *victim;
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	if (cache == NULL || end < start)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	if (len == 0)
+		return DOCA_SUCCESS;
+
+	cache->num_scratch = 0;
+	result = tree_collect(cache, cache->root, start, end);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	for (i = 0; i < cache->num_scratch; i++) {
+		victim = cache->scratch[i];
+		/* Collected ranges may only touch the invalidated one */
+		if (victim->end <= start || victim->start >= end)
+			continue;
+
+		detach_entry(cache, victim);
+		cache->stats.invalidations++;
+		if (victim->refcount == 0) {
+			idle_unlink(cache, victim);
+			tmp_result = destroy_entry(cache, victim);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	return result;
+}
+
+doca_error_t mmap_cache_flush(struct mmap_cache *cache)
+{
+	struct mmap_cache_entry *victim;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (cache == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	while (cache->idle_tail != NULL) {
+		victim = cache->idle_tail;
+		idle_unlink(cache, victim);
+		detach_entry(cache, victim);
+		tmp_result = destroy_entry(cache, victim);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	return result;
+}
+
+void mmap_cache_get_stats(const struct mmap_cache *cache, struct mmap_cache_stats *stats)
+{
+	*stats = cache->stats;
+}
+
+void mmap_cache_log_stats(const struct mmap_cache *cache, const char *name)
+{
+	const struct mmap_cache_stats *stats = &cache->stats;
+	uint64_t lookups = stats->hits + stats->misses;
+
+	DOCA_LOG_INFO("%s registration cache: %" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate), %" PRIu64
+		      " merges, %" PRIu64 " evictions, %" PRIu64 " invalidations",
+		      name,
+		      stats->hits,
+		      stats->misses,
+		      lookups == 0 ? 0.0 : 100.0 * (double)stats->hits / (double)lookups,
+		      stats->merges,
+		      stats->evictions,
+		      stats->invalidations);
+	DOCA_LOG_INFO("%s registration cache: %" PRIu64 " registrations (%.1f us avg), %" PRIu64
+		      " deregistrations (%.1f us avg), %u entries / %" PRIu64 " bytes alive, %u / %" PRIu64 " idle",
+		      name,
+		      stats->registrations,
+		      stats->registrations == 0 ? 0.0 : (double)stats->registration_ns / stats->registrations / 1000.0,
+		      stats->deregistrations,
+		      stats->deregistrations == 0 ? 0.0 :
+						    (double)stats->deregistration_ns / stats->deregistrations / 1000.0,
+		      stats->num_entries,
+		      stats->registered_bytes,
+		      stats->num_idle,
+		      stats->idle_bytes);
+}
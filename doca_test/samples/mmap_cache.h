@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef MMAP_CACHE_H_
+#define MMAP_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MMAP_CACHE_DEFAULT_MAX_IDLE_ENTRIES (64)	  /* Default number of unused registrations kept alive */
+#define MMAP_CACHE_DEFAULT_MAX_IDLE_BYTES (1ULL << 30) /* Default amount of unused registered memory kept alive */
+
+/*
+ * Memory registration cache
+ *
+ * Registered ranges are kept in an interval tree keyed by start address. A request that falls inside a cached range
+ * is a hit and only takes a reference. On a miss the range is rounded out to whole pages, merged with every cached
+ * range it overlaps or touches and registered as a single mmap; the ranges it replaces are deregistered as soon as
+ * their last user releases them. Ranges whose reference count drops to zero are not deregistered right away, they
+ * stay in the tree on an LRU idle list until the idle limits are exceeded, the range is invalidated or the cache is
+ * flushed.
+ *
+ * Every mmap in a cache has the same device and permissions. Because ranges are rounded to pages, a cached mmap may
+ * cover a few bytes around the requested buffer, which matters only if the mmap is exported to a remote peer.
+ * Memory that is returned to the system (free of a large allocation, munmap) must be invalidated first, otherwise a
+ * later allocation at the same address would hit a registration of the old pages.
+ *
+ * The cache is not thread safe, callers sharing a cache between threads must serialize the calls.
+ */
+struct mmap_cache;
+
+/* A reference to a cached registration */
+struct mmap_cache_entry;
+
+/* Cache configuration */
+struct mmap_cache_attr {
+	struct doca_dev *dev;	   /* Device every mmap is added to */
+	uint32_t permissions;	   /* DOCA access flags of every mmap */
+	uint32_t max_idle_entries; /* Unused registrations kept alive, 0 deregisters on the last release */
+	uint64_t max_idle_bytes;   /* Unused registered bytes kept alive */
+};
+
+/* Cache counters */
+struct mmap_cache_stats {
+	uint64_t hits;		    /* Requests served by an existing registration */
+	uint64_t misses;	    /* Requests that needed a new registration */
+	uint64_t merges;	    /* Cached ranges folded into a larger registration on a miss */
+	uint64_t registrations;	    /* mmaps created and started */
+	uint64_t deregistrations;   /* mmaps stopped and destroyed */
+	uint64_t evictions;	    /* Idle registrations dropped because of the idle limits */
+	uint64_t invalidations;	    /* Registrations dropped by mmap_cache_invalidate() */
+	uint64_t registration_ns;   /* Total time spent registering */
+	uint64_t deregistration_ns; /* Total time spent deregistering */
+	uint64_t registered_bytes;  /* Bytes currently registered */
+	uint64_t idle_bytes;	    /* Bytes currently registered but unused */
+	uint32_t num_entries;	    /* Registrations currently alive */
+	uint32_t num_idle;	    /* Registrations currently alive but unused */
+};
+
+/*
+ * Create a registration cache
+ *
+ * @attr [in]: cache configuration
+ * @cache [out]: the created cache
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t mmap_cache_create(const struct mmap_cache_attr *attr, struct mmap_cache **cache);
+
+/*
+ * Destroy a registration cache, deregistering every idle range
+ *
+ * @cache [in]: cache to destroy, may be NULL
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_IN_USE if some entries are still acquired (the cache is not
+ * destroyed) and DOCA_ERROR otherwise
+ */
+doca_error_t mmap_cache_destroy(struct mmap_cache *cache);
+
+/*
+ * Get a started mmap covering a buffer, registering it if needed
+ *
+ * @cache [in]: the cache
+ * @addr [in]: buffer start address
+ * @len [in]: buffer length in bytes
+ * @entry [out]: reference to release with mmap_cache_release() once the mmap is no longer used
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t mmap_cache_acquire(struct mmap_cache *cache, void *addr, size_t len, struct mmap_cache_entry **entry);
+
+/*
+ * Release a reference taken by mmap_cache_acquire()
+ * The mmap must not be used afterwards, the registration itself may stay cached
+ *
+ * @cache [in]: the cache
+ * @entry [in]: reference to release
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t mmap_cache_release(struct mmap_cache *cache, struct mmap_cache_entry *entry);
+
+/*
+ * Get the mmap of an acquired entry
+ *
+ * @entry [in]: acquired entry
+ * @return: started DOCA mmap covering the acquired buffer
+ */
+struct doca_mmap *mmap_cache_entry_get_mmap(const struct mmap_cache_entry *entry);
+
+/*
+ * Drop every registration overlapping a range, to be called before the range is returned to the system
+ * Idle registrations are deregistered immediately, acquired ones on their last release
+ *
+ * @cache [in]: the cache
+ * @addr [in]: range start address
+ * @len [in]: range length in bytes
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t mmap_cache_invalidate(struct mmap_cache *cache, void *addr, size_t len);
+
+/*
+ * Deregister every idle range
+ *
+ * @cache [in]: the cache
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t mmap_cache_flush(struct mmap_cache *cache);
+
+/*
+ * Get a snapshot of the cache counters
+ *
+ * @cache [in]: the cache
+ * @stats [out]: counters
+ */
+void mmap_cache_get_stats(const struct mmap_cache *cache, struct mmap_cache_stats *stats);
+
+/*
+ * Log the cache counters
+ *
+ * @cache [in]: the cache
+ * @name [in]: name printed with the counters
+ */
+void mmap_cache_log_stats(const struct mmap_cache *cache, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MMAP_CACHE_H_ */
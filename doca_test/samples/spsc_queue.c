@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <doca_log.h>
+
+#include "spsc_queue.h"
+
+DOCA_LOG_REGISTER(SPSC_QUEUE);
+
+#define SPSC_QUEUE_MAX_CAPACITY (1U << 31) /* Capacity must fit in uint32_t once rounded up */
+
+doca_error_t spsc_queue_create(uint32_t capacity, struct spsc_queue **queue)
+{
+	struct spsc_queue *new_queue;
+	uint32_t size = 1;
+
+	if (capacity == 0 || capacity > SPSC_QUEUE_MAX_CAPACITY || queue == NULL)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	while (size < capacity)
+		size <<= 1;
+
+	new_queue = aligned_alloc(SPSC_QUEUE_CACHE_LINE_SIZE, sizeof(*new_queue));
+	if (new_queue == NULL) {
+		DOCA_LOG_ERR("Failed to allocate SPSC queue");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	new_queue->entries = calloc(size, sizeof(*new_queue->entries));
+	if (new_queue->entries == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %u SPSC queue entries", size);
+		free(new_queue);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	atomic_init(&new_queue->head, 0);
+	atomic_init(&new_queue->tail, 0);
+	new_queue->cached_head = 0;
+	new_queue->cached_tail = 0;
+	new_queue->mask = size - 1;
+
+	*queue = new_queue;
+	return DOCA_SUCCESS;
+}
+
+void spsc_queue_destroy(struct spsc_queue *queue)
+{
+	if (queue == NULL)
+		return;
+
+	free(queue->entries);
+	free(queue);
+}
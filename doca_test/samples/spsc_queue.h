@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPSC_QUEUE_CACHE_LINE_SIZE (64) /* Producer and consumer indexes are kept on separate cache lines */
+
+/*
+ * Bounded lock-free single-producer single-consumer queue of 64-bit values
+ * The producer only writes tail and the consumer only writes head, each side keeps a cached copy of the other
+ * side's index so that the shared cache line is only read when the queue looks full (producer) or empty (consumer).
+ */
+struct spsc_queue {
+	_Alignas(SPSC_QUEUE_CACHE_LINE_SIZE) _Atomic uint32_t head; /* Next entry to dequeue, written by the consumer */
+	uint32_t cached_tail;					    /* Consumer copy of tail */
+	_Alignas(SPSC_QUEUE_CACHE_LINE_SIZE) _Atomic uint32_t tail; /* Next entry to enqueue, written by the producer */
+	uint32_t cached_head;					    /* Producer copy of head */
+	_Alignas(SPSC_QUEUE_CACHE_LINE_SIZE) uint32_t mask;	    /* Capacity - 1, capacity is a power of 2 */
+	uint64_t *entries;					    /* Queue storage */
+};
+
+/*
+ * Create a queue
+ *
+ * @capacity [in]: minimal number of entries the queue can hold, rounded up to a power of 2
+ * @queue [out]: the created queue
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t spsc_queue_create(uint32_t capacity, struct spsc_queue **queue);
+
+/*
+ * Destroy a queue
+ *
+ * @queue [in]: queue to destroy, may be NULL
+ */
+void spsc_queue_destroy(struct spsc_queue *queue);
+
+/*
+ * Enqueue a value, must only be called by the producer
+ *
+ * @queue [in]: the queue
+ * @value [in]: value to enqueue
+ * @return: true on success, false if the queue is full
+ */
+static inline bool spsc_queue_enqueue(struct spsc_queue *queue, uint64_t value)
+{
+	uint32_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+	if (tail - queue->cached_head > queue->mask) {
+		queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+		if (tail - queue->cached_head > queue->mask)
+			return false;
+	}
+
+	queue->entries[tail & queue->mask] = value;
+	atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+	return true;
+}
+
+/*
+ * Dequeue a value, must only be called by the consumer
+ *
+ * @queue [in]: the queue
+ * @value [out]: dequeued value
+ * @return: true on success, false if the queue is empty
+ */
+static inline bool spsc_queue_dequeue(struct spsc_queue *queue, uint64_t *value)
+{
+	uint32_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+	if (head == queue->cached_tail) {
+		queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+		if (head == queue->cached_tail)
+			return false;
+	}
+
+	*value = queue->entries[head & queue->mask];
+	atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+	return true;
+}
+
+/*
+ * Get the number of entries in the queue, the result is only a snapshot when called concurrently
+ *
+ * @queue [in]: the queue
+ * @return: number of entries
+ */
+static inline uint32_t spsc_queue_count(struct spsc_queue *queue)
+{
+	return atomic_load_explicit(&queue->tail, memory_order_acquire) -
+	       atomic_load_explicit(&queue->head, memory_order_acquire);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSC_QUEUE_H_ */
@@ -1,3 +1,4 @@
+import os
 import re
 import json
 import matplotlib.pyplot as plt
@@ -61,6 +62,15 @@ with open("./rdma_results.json", "w") as f:
 bw_df = pd.DataFrame(results["bandwidth"])
 lat_df = pd.DataFrame(results["latency"])
 
+# Task latency histograms of the DOCA RDMA samples (--latency-json), in the same schema as rdma_results.json.
+# A DOCA series such as doca_rdma_send_lat is drawn over its perftest counterpart ib_send_lat.
+doca_lat_df = pd.DataFrame()
+if os.path.exists("doca_results.json"):
+    with open("doca_results.json", "r") as f:
+        doca_lat_df = pd.DataFrame(json.load(f)["latency"])
+    doca_lat_df = doca_lat_df[doca_lat_df["bytes"] > 0].copy()
+    doca_lat_df["perftest_type"] = doca_lat_df["type"].str.replace("doca_rdma_", "ib_", regex=False)
+
 sns.set(style="whitegrid")
 
 for name, group in bw_df.groupby("type"):
@@ -80,14 +90,24 @@ for name, group in bw_df.groupby("type"):
     plt.savefig(f"{name}_bw_avg.png")
     plt.close()
 
+plotted_doca_types = set()
 for name, group in lat_df.groupby("type"):
     group = group.sort_values("bytes")
     plt.figure(figsize=(10, 6))
-    plt.plot(group["bytes"], group["t_99"], marker='o')
+    plt.plot(group["bytes"], group["t_99"], marker='o', label=name)
     font = {'family': 'serif', 'weight': 'bold', 'size': 14}
 
+    ticks = group["bytes"]
+    if not doca_lat_df.empty:
+        for doca_name, doca_group in doca_lat_df[doca_lat_df["perftest_type"] == name].groupby("type"):
+            doca_group = doca_group.sort_values("bytes")
+            plt.plot(doca_group["bytes"], doca_group["t_99"], marker='s', linestyle='--', label=doca_name)
+            ticks = pd.concat([ticks, doca_group["bytes"]]).drop_duplicates().sort_values()
+            plotted_doca_types.add(doca_name)
+        plt.legend()
+
     plt.xscale("log", base=2)
-    plt.xticks(group["bytes"], [f"2^{int(np.log2(b))}" for b in group["bytes"]], fontweight="bold", fontsize=10, fontfamily="serif")
+    plt.xticks(ticks, [f"2^{int(np.log2(b))}" for b in ticks], fontweight="bold", fontsize=10, fontfamily="serif")
     plt.xlabel("Message Size (Bytes)", fontdict=font)
     plt.yticks(fontweight="bold", fontsize=10)
     plt.ylabel("99th Percentile Latency (µs)", fontdict=font)
@@ -96,3 +116,22 @@ for name, group in lat_df.groupby("type"):
     plt.tight_layout()
     plt.savefig(f"{name}_p99_latency.png")
     plt.close()
+
+# DOCA task types without a perftest counterpart (receive, atomics, sync events, per connection series)
+if not doca_lat_df.empty:
+    for name, group in doca_lat_df[~doca_lat_df["type"].isin(plotted_doca_types)].groupby("type"):
+        group = group.sort_values("bytes")
+        plt.figure(figsize=(10, 6))
+        plt.plot(group["bytes"], group["t_99"], marker='s')
+        font = {'family': 'serif', 'weight': 'bold', 'size': 14}
+
+        plt.xscale("log", base=2)
+        plt.xticks(group["bytes"], [f"2^{int(np.log2(b))}" for b in group["bytes"]], fontweight="bold", fontsize=10, fontfamily="serif")
+        plt.xlabel("Message Size (Bytes)", fontdict=font)
+        plt.yticks(fontweight="bold", fontsize=10)
+        plt.ylabel("99th Percentile Latency (µs)", fontdict=font)
+        plt.title(f"{name} - P99 Latency vs Message Size", fontdict=font)
+        plt.grid(True)
+        plt.tight_layout()
+        plt.savefig(f"{name}_p99_latency.png")
+        plt.close()